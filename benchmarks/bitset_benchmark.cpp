@@ -3,7 +3,9 @@
 #include "mclo/container/bitset.hpp"
 #include "mclo/container/dynamic_bitset.hpp"
 
+#include <bit>
 #include <bitset>
+#include <random>
 
 namespace
 {
@@ -161,4 +163,227 @@ namespace
 		}
 	}
 	BENCHMARK_STD_BITSET( Bitset_StdForEachSet, for_each_set_setup );
+
+	// --- Bulk operations on large filters ---
+
+	using large_bitset = mclo::dynamic_bitset<std::uint64_t>;
+
+	void large_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 16 )->Range( 1 << 16, 1 << 28 );
+	}
+
+	large_bitset make_random_bitset( const std::size_t size, const std::uint64_t seed )
+	{
+		std::mt19937_64 rng( seed );
+		large_bitset set( size );
+		for ( std::uint64_t& value : set.underlying() )
+		{
+			value = rng();
+		}
+		// Re-apply the size to clear any bits past the end
+		return large_bitset( size, std::vector<std::uint64_t>( set.underlying().begin(), set.underlying().end() ) );
+	}
+
+	large_bitset make_sparse_bitset( const std::size_t size, const std::size_t mean_gap, const std::uint64_t seed )
+	{
+		std::mt19937_64 rng( seed );
+		std::geometric_distribution<std::size_t> gap( 1.0 / static_cast<double>( mean_gap ) );
+		large_bitset set( size );
+		for ( std::size_t index = gap( rng ); index < size; index += gap( rng ) + 1 )
+		{
+			set.set( index );
+		}
+		return set;
+	}
+
+	void set_bytes_processed( benchmark::State& state, const std::int64_t num_sets )
+	{
+		state.SetBytesProcessed( state.iterations() * num_sets * ( state.range( 0 ) / CHAR_BIT ) );
+	}
+
+	template <typename Op>
+	void scalar_binary_op( large_bitset& lhs, const large_bitset& rhs, Op op )
+	{
+		const auto lhs_values = lhs.underlying();
+		const auto rhs_values = rhs.underlying();
+		for ( std::size_t index = 0; index < lhs_values.size(); ++index )
+		{
+			lhs_values[ index ] = op( lhs_values[ index ], rhs_values[ index ] );
+		}
+	}
+
+	void Bitset_LargeAnd( benchmark::State& state )
+	{
+		large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			lhs &= rhs;
+			benchmark::DoNotOptimize( lhs );
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeAnd )->Apply( large_setup );
+
+	void Bitset_LargeAndScalar( benchmark::State& state )
+	{
+		large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			scalar_binary_op( lhs, rhs, std::bit_and<>{} );
+			benchmark::DoNotOptimize( lhs );
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeAndScalar )->Apply( large_setup );
+
+	void Bitset_LargeOr( benchmark::State& state )
+	{
+		large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			lhs |= rhs;
+			benchmark::DoNotOptimize( lhs );
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeOr )->Apply( large_setup );
+
+	void Bitset_LargeXor( benchmark::State& state )
+	{
+		large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			lhs ^= rhs;
+			benchmark::DoNotOptimize( lhs );
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeXor )->Apply( large_setup );
+
+	void Bitset_LargeAndNot( benchmark::State& state )
+	{
+		large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			lhs.and_not( rhs );
+			benchmark::DoNotOptimize( lhs );
+			benchmark::ClobberMemory();
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeAndNot )->Apply( large_setup );
+
+	void Bitset_LargeCount( benchmark::State& state )
+	{
+		const large_bitset set = make_random_bitset( state.range( 0 ), 1 );
+		for ( auto _ : state )
+		{
+			std::size_t count = set.count();
+			benchmark::DoNotOptimize( count );
+		}
+		set_bytes_processed( state, 1 );
+	}
+	BENCHMARK( Bitset_LargeCount )->Apply( large_setup );
+
+	void Bitset_LargeCountScalar( benchmark::State& state )
+	{
+		const large_bitset set = make_random_bitset( state.range( 0 ), 1 );
+		for ( auto _ : state )
+		{
+			std::size_t count = 0;
+			for ( const std::uint64_t value : set.underlying() )
+			{
+				count += std::popcount( value );
+			}
+			benchmark::DoNotOptimize( count );
+		}
+		set_bytes_processed( state, 1 );
+	}
+	BENCHMARK( Bitset_LargeCountScalar )->Apply( large_setup );
+
+	void Bitset_LargeAndCount( benchmark::State& state )
+	{
+		const large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			std::size_t count = and_count( lhs, rhs );
+			benchmark::DoNotOptimize( count );
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeAndCount )->Apply( large_setup );
+
+	void Bitset_LargeAndThenCount( benchmark::State& state )
+	{
+		const large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			std::size_t count = ( lhs & rhs ).count();
+			benchmark::DoNotOptimize( count );
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeAndThenCount )->Apply( large_setup );
+
+	void Bitset_LargeOrCount( benchmark::State& state )
+	{
+		const large_bitset lhs = make_random_bitset( state.range( 0 ), 1 );
+		const large_bitset rhs = make_random_bitset( state.range( 0 ), 2 );
+		for ( auto _ : state )
+		{
+			std::size_t count = or_count( lhs, rhs );
+			benchmark::DoNotOptimize( count );
+		}
+		set_bytes_processed( state, 2 );
+	}
+	BENCHMARK( Bitset_LargeOrCount )->Apply( large_setup );
+
+	void large_iteration_setup( benchmark::Benchmark* const b )
+	{
+		// Size in bits and mean gap between set bits
+		b->ArgsProduct( { { 1 << 20, 1 << 24 }, { 2, 64, 4096 } } );
+	}
+
+	void Bitset_LargeForEachSet( benchmark::State& state )
+	{
+		const large_bitset set = make_sparse_bitset( state.range( 0 ), state.range( 1 ), 1 );
+		for ( auto _ : state )
+		{
+			std::size_t sum = 0;
+			set.for_each_set( [ &sum ]( const std::size_t i ) { sum += i; } );
+			benchmark::DoNotOptimize( sum );
+		}
+		set_bytes_processed( state, 1 );
+	}
+	BENCHMARK( Bitset_LargeForEachSet )->Apply( large_iteration_setup );
+
+	void Bitset_LargeForEachSetBatch( benchmark::State& state )
+	{
+		const large_bitset set = make_sparse_bitset( state.range( 0 ), state.range( 1 ), 1 );
+		for ( auto _ : state )
+		{
+			std::size_t sum = 0;
+			set.for_each_set_batch( [ &sum ]( const mclo::span<const std::size_t> positions ) {
+				for ( const std::size_t i : positions )
+				{
+					sum += i;
+				}
+			} );
+			benchmark::DoNotOptimize( sum );
+		}
+		set_bytes_processed( state, 1 );
+	}
+	BENCHMARK( Bitset_LargeForEachSetBatch )->Apply( large_iteration_setup );
 }
@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/circular_buffer.hpp"
+#include "mclo/container/mirrored_circular_buffer.hpp"
+#include "mclo/container/spsc_circular_buffer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr std::size_t transfer_count = 1 << 20;
+	constexpr std::size_t ring_capacity = 1024;
+	constexpr std::size_t batch_size = 64;
+
+	// Baseline of guarding the single threaded ring with a mutex, bulk operations still amortize the lock
+	class locked_ring
+	{
+	public:
+		std::size_t push_back_n( const mclo::span<const std::uint64_t> values )
+		{
+			std::scoped_lock lock( m_mutex );
+			const std::size_t count = std::min( values.size(), m_buffer.capacity() - m_buffer.size() );
+			m_buffer.push_back_n( values.first( count ) );
+			return count;
+		}
+
+		std::size_t pop_front_n( const mclo::span<std::uint64_t> out )
+		{
+			std::scoped_lock lock( m_mutex );
+			return m_buffer.pop_front_n( out );
+		}
+
+	private:
+		std::mutex m_mutex;
+		mclo::circular_buffer<std::uint64_t> m_buffer{ ring_capacity };
+	};
+
+	// Moves transfer_count values from a producer thread to this thread in batches of up to Batch, yielding when the
+	// ring is full or empty so the benchmark still makes progress with fewer cores than threads
+	template <typename Ring, std::size_t Batch>
+	void transfer( benchmark::State& state )
+	{
+		for ( auto _ : state )
+		{
+			Ring ring;
+			std::thread producer( [ &ring ] {
+				std::array<std::uint64_t, Batch> batch;
+				std::uint64_t next = 0;
+				while ( next < transfer_count )
+				{
+					for ( std::uint64_t& value : batch )
+					{
+						value = next++;
+					}
+					mclo::span<const std::uint64_t> remaining( batch );
+					while ( !remaining.empty() )
+					{
+						const std::size_t count = ring.push_back_n( remaining );
+						if ( count == 0 )
+						{
+							std::this_thread::yield();
+						}
+						remaining = remaining.subspan( count );
+					}
+				}
+			} );
+
+			std::array<std::uint64_t, Batch> batch;
+			std::uint64_t sum = 0;
+			std::size_t received = 0;
+			while ( received < transfer_count )
+			{
+				const std::size_t count = ring.pop_front_n( batch );
+				if ( count == 0 )
+				{
+					std::this_thread::yield();
+				}
+				for ( std::size_t index = 0; index < count; ++index )
+				{
+					sum += batch[ index ];
+				}
+				received += count;
+			}
+			producer.join();
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( transfer_count ) );
+	}
+
+	struct spsc_ring : mclo::spsc_circular_buffer<std::uint64_t>
+	{
+		spsc_ring()
+			: spsc_circular_buffer( ring_capacity )
+		{
+		}
+	};
+
+	void BM_TransferLockedCircularBuffer( benchmark::State& state )
+	{
+		transfer<locked_ring, 1>( state );
+	}
+	BENCHMARK( BM_TransferLockedCircularBuffer )->UseRealTime()->Unit( benchmark::kMillisecond );
+
+	void BM_TransferLockedCircularBufferBatched( benchmark::State& state )
+	{
+		transfer<locked_ring, batch_size>( state );
+	}
+	BENCHMARK( BM_TransferLockedCircularBufferBatched )->UseRealTime()->Unit( benchmark::kMillisecond );
+
+	void BM_TransferSpscCircularBuffer( benchmark::State& state )
+	{
+		transfer<spsc_ring, 1>( state );
+	}
+	BENCHMARK( BM_TransferSpscCircularBuffer )->UseRealTime()->Unit( benchmark::kMillisecond );
+
+	void BM_TransferSpscCircularBufferBatched( benchmark::State& state )
+	{
+		transfer<spsc_ring, batch_size>( state );
+	}
+	BENCHMARK( BM_TransferSpscCircularBufferBatched )->UseRealTime()->Unit( benchmark::kMillisecond );
+
+	// A stream of records each a length byte then that many payload bytes, arriving in chunks that split records
+	constexpr std::size_t stream_size = 1 << 22;
+	constexpr std::size_t chunk_size = 1500;
+	constexpr std::size_t stream_capacity = 1 << 16;
+
+	std::vector<std::uint8_t> make_stream()
+	{
+		std::mt19937 rng( 1 );
+		std::vector<std::uint8_t> result;
+		while ( result.size() < stream_size )
+		{
+			const std::uint8_t length = static_cast<std::uint8_t>( rng() % 255 + 1 );
+			result.push_back( length );
+			for ( std::uint8_t index = 0; index < length; ++index )
+			{
+				result.push_back( static_cast<std::uint8_t>( rng() ) );
+			}
+		}
+		return result;
+	}
+
+	mclo::span<const std::uint8_t> chunk_at( const std::vector<std::uint8_t>& stream, const std::size_t first ) noexcept
+	{
+		return mclo::span( stream ).subspan( first, std::min( chunk_size, stream.size() - first ) );
+	}
+
+	// Frames whole records from the front of bytes, only reading each header and first payload byte as a zero copy
+	// parser handing out views of the payloads would, returning how many bytes the records took
+	std::size_t parse_records( const mclo::span<const std::uint8_t> bytes, std::uint64_t& sum ) noexcept
+	{
+		std::size_t position = 0;
+		std::uint64_t local = 0;
+		while ( position < bytes.size() && position + 1 + bytes[ position ] <= bytes.size() )
+		{
+			local += bytes[ position + 1 ];
+			position += 1 + bytes[ position ];
+		}
+		sum += local;
+		return position;
+	}
+
+	// Baseline of copying out of the ring into a linear buffer so records that wrap around are contiguous to parse
+	void BM_ParseStreamCircularBuffer( benchmark::State& state )
+	{
+		const std::vector<std::uint8_t> stream = make_stream();
+		mclo::circular_buffer<std::uint8_t> ring( stream_capacity );
+		std::vector<std::uint8_t> linear( stream_capacity );
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			std::size_t pending = 0;
+			for ( std::size_t first = 0; first < stream.size(); first += chunk_size )
+			{
+				ring.push_back_n( chunk_at( stream, first ) );
+				pending += ring.pop_front_n( mclo::span( linear ).subspan( pending ) );
+				const std::size_t consumed = parse_records( mclo::span( linear ).first( pending ), sum );
+				std::memmove( linear.data(), linear.data() + consumed, pending - consumed );
+				pending -= consumed;
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetBytesProcessed( state.iterations() * static_cast<std::int64_t>( stream_size ) );
+	}
+	BENCHMARK( BM_ParseStreamCircularBuffer );
+
+	// Records that wrap around are parsed in place as the mirror makes them contiguous
+	void BM_ParseStreamMirroredCircularBuffer( benchmark::State& state )
+	{
+		const std::vector<std::uint8_t> stream = make_stream();
+		mclo::mirrored_circular_buffer<std::uint8_t> ring( stream_capacity );
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			for ( std::size_t first = 0; first < stream.size(); first += chunk_size )
+			{
+				ring.push_back_n( chunk_at( stream, first ) );
+				ring.commit_read( parse_records( ring.peek(), sum ) );
+			}
+			ring.clear();
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetBytesProcessed( state.iterations() * static_cast<std::int64_t>( stream_size ) );
+	}
+	BENCHMARK( BM_ParseStreamMirroredCircularBuffer );
+}
@@ -0,0 +1,218 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/compressed_bitset.hpp"
+#include "mclo/container/dynamic_bitset.hpp"
+
+#include <random>
+
+namespace
+{
+	// Both bitsets cover the same range, the argument is the average gap between set bits so density is 1 / gap
+	constexpr std::uint32_t universe_bits = 1 << 24;
+
+	void density_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 8 )->Range( 2, 1 << 17 );
+	}
+
+	std::vector<std::uint32_t> make_positions( const std::int64_t gap, const std::uint32_t seed )
+	{
+		std::mt19937 rng( seed );
+		std::uniform_int_distribution<std::uint32_t> step_dist( 1, static_cast<std::uint32_t>( gap * 2 - 1 ) );
+		std::vector<std::uint32_t> result;
+		for ( std::uint32_t pos = step_dist( rng ); pos < universe_bits; pos += step_dist( rng ) )
+		{
+			result.push_back( pos );
+		}
+		return result;
+	}
+
+	mclo::compressed_bitset make_compressed( const std::vector<std::uint32_t>& positions )
+	{
+		mclo::compressed_bitset result;
+		for ( const std::uint32_t pos : positions )
+		{
+			result.set( pos );
+		}
+		return result;
+	}
+
+	mclo::dynamic_bitset<std::uint64_t> make_dynamic( const std::vector<std::uint32_t>& positions )
+	{
+		mclo::dynamic_bitset<std::uint64_t> result( universe_bits );
+		for ( const std::uint32_t pos : positions )
+		{
+			result.set( pos );
+		}
+		return result;
+	}
+
+	void set_memory_counter( benchmark::State& state, const std::size_t bytes )
+	{
+		state.counters[ "bytes" ] = static_cast<double>( bytes );
+	}
+
+	template <typename Make>
+	void bitset_build( benchmark::State& state, Make make )
+	{
+		const std::vector<std::uint32_t> positions = make_positions( state.range( 0 ), 1 );
+		for ( auto _ : state )
+		{
+			auto set = make( positions );
+			benchmark::DoNotOptimize( set );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( positions.size() ) );
+	}
+
+	void CompressedBitset_Build( benchmark::State& state )
+	{
+		bitset_build( state, make_compressed );
+		set_memory_counter( state, make_compressed( make_positions( state.range( 0 ), 1 ) ).serialized_size() );
+	}
+	BENCHMARK( CompressedBitset_Build )->Apply( density_setup );
+
+	void DynamicBitset_Build( benchmark::State& state )
+	{
+		bitset_build( state, make_dynamic );
+		set_memory_counter( state, universe_bits / 8 );
+	}
+	BENCHMARK( DynamicBitset_Build )->Apply( density_setup );
+
+	template <typename Make>
+	void bitset_test( benchmark::State& state, Make make )
+	{
+		const auto set = make( make_positions( state.range( 0 ), 1 ) );
+		std::mt19937 rng( 2 );
+		std::uniform_int_distribution<std::uint32_t> pos_dist( 0, universe_bits - 1 );
+		std::vector<std::uint32_t> queries( 1024 );
+		std::ranges::generate( queries, [ & ] { return pos_dist( rng ); } );
+		for ( auto _ : state )
+		{
+			std::size_t hits = 0;
+			for ( const std::uint32_t pos : queries )
+			{
+				hits += set.test( pos );
+			}
+			benchmark::DoNotOptimize( hits );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( queries.size() ) );
+	}
+
+	void CompressedBitset_Test( benchmark::State& state )
+	{
+		bitset_test( state, make_compressed );
+	}
+	BENCHMARK( CompressedBitset_Test )->Apply( density_setup );
+
+	void DynamicBitset_Test( benchmark::State& state )
+	{
+		bitset_test( state, make_dynamic );
+	}
+	BENCHMARK( DynamicBitset_Test )->Apply( density_setup );
+
+	template <typename Make>
+	void bitset_count( benchmark::State& state, Make make )
+	{
+		const auto set = make( make_positions( state.range( 0 ), 1 ) );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( set.count() );
+		}
+	}
+
+	void CompressedBitset_Count( benchmark::State& state )
+	{
+		bitset_count( state, make_compressed );
+	}
+	BENCHMARK( CompressedBitset_Count )->Apply( density_setup );
+
+	void DynamicBitset_Count( benchmark::State& state )
+	{
+		bitset_count( state, make_dynamic );
+	}
+	BENCHMARK( DynamicBitset_Count )->Apply( density_setup );
+
+	template <typename Make>
+	void bitset_for_each_set( benchmark::State& state, Make make )
+	{
+		const auto set = make( make_positions( state.range( 0 ), 1 ) );
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			set.for_each_set( [ &sum ]( const auto pos ) { sum += pos; } );
+			benchmark::DoNotOptimize( sum );
+		}
+	}
+
+	void CompressedBitset_ForEachSet( benchmark::State& state )
+	{
+		bitset_for_each_set( state, make_compressed );
+	}
+	BENCHMARK( CompressedBitset_ForEachSet )->Apply( density_setup );
+
+	void DynamicBitset_ForEachSet( benchmark::State& state )
+	{
+		bitset_for_each_set( state, make_dynamic );
+	}
+	BENCHMARK( DynamicBitset_ForEachSet )->Apply( density_setup );
+
+	template <typename Make, typename Op>
+	void bitset_binary_op( benchmark::State& state, Make make, Op op )
+	{
+		const auto lhs = make( make_positions( state.range( 0 ), 1 ) );
+		const auto rhs = make( make_positions( state.range( 0 ), 2 ) );
+		for ( auto _ : state )
+		{
+			auto result = op( lhs, rhs );
+			benchmark::DoNotOptimize( result );
+		}
+	}
+
+	constexpr auto union_op = []( const auto& lhs, const auto& rhs ) {
+		auto result = lhs;
+		result |= rhs;
+		return result;
+	};
+	constexpr auto intersection_op = []( const auto& lhs, const auto& rhs ) {
+		auto result = lhs;
+		result &= rhs;
+		return result;
+	};
+
+	void CompressedBitset_Union( benchmark::State& state )
+	{
+		bitset_binary_op( state, make_compressed, union_op );
+	}
+	BENCHMARK( CompressedBitset_Union )->Apply( density_setup );
+
+	void DynamicBitset_Union( benchmark::State& state )
+	{
+		bitset_binary_op( state, make_dynamic, union_op );
+	}
+	BENCHMARK( DynamicBitset_Union )->Apply( density_setup );
+
+	void CompressedBitset_Intersection( benchmark::State& state )
+	{
+		bitset_binary_op( state, make_compressed, intersection_op );
+	}
+	BENCHMARK( CompressedBitset_Intersection )->Apply( density_setup );
+
+	void DynamicBitset_Intersection( benchmark::State& state )
+	{
+		bitset_binary_op( state, make_dynamic, intersection_op );
+	}
+	BENCHMARK( DynamicBitset_Intersection )->Apply( density_setup );
+
+	void CompressedBitset_Serialize( benchmark::State& state )
+	{
+		mclo::compressed_bitset set = make_compressed( make_positions( state.range( 0 ), 1 ) );
+		set.run_optimize();
+		std::vector<std::byte> buffer( set.serialized_size() );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( set.serialize( buffer ) );
+		}
+		state.SetBytesProcessed( state.iterations() * static_cast<std::int64_t>( buffer.size() ) );
+	}
+	BENCHMARK( CompressedBitset_Serialize )->Apply( density_setup );
+}
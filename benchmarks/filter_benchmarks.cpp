@@ -0,0 +1,189 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/blocked_bloom_filter.hpp"
+#include "mclo/container/bloom_filter.hpp"
+#include "mclo/container/cuckoo_filter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Sizes go past the last level cache, where a key's bits in one block and batched prefetching pay off most
+	void lookup_size_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 16 )->Range( 1 << 12, 1 << 24 );
+	}
+
+	// 64 bit random keys, distinct for all practical purposes
+	std::vector<std::uint64_t> make_keys( const std::int64_t count, const std::uint64_t seed )
+	{
+		std::mt19937_64 rng( seed );
+		std::vector<std::uint64_t> result( static_cast<std::size_t>( count ) );
+		std::generate( result.begin(), result.end(), rng );
+		return result;
+	}
+
+	// Half the lookups are inserted keys and half are keys that never were
+	std::vector<std::uint64_t> make_lookups( const std::vector<std::uint64_t>& keys )
+	{
+		std::vector<std::uint64_t> result = make_keys( static_cast<std::int64_t>( keys.size() ), 2 );
+		std::copy( keys.begin(), keys.begin() + keys.size() / 2, result.begin() );
+		std::shuffle( result.begin(), result.end(), std::mt19937_64( 3 ) );
+		return result;
+	}
+
+	constexpr std::int64_t fpr_keys = 1 << 16;
+	constexpr std::int64_t fpr_probes = 1 << 20;
+
+	template <typename Filter>
+	void report_false_positive_rate( benchmark::State& state, const Filter& filter )
+	{
+		const std::vector<std::uint64_t> absent = make_keys( fpr_probes, 4 );
+		const auto false_positives = std::count_if(
+			absent.begin(), absent.end(), [ &filter ]( const std::uint64_t key ) { return filter.contains( key ); } );
+		state.counters[ "false_positive_rate" ] =
+			static_cast<double>( false_positives ) / static_cast<double>( absent.size() );
+	}
+
+	// False positive rate for a number of bits per key, timing the inserts
+	void BloomFilter_FalsePositiveRate( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( fpr_keys, 1 );
+		const auto bits_per_key = static_cast<std::size_t>( state.range( 0 ) );
+		const std::size_t num_hashes =
+			mclo::bloom_filter<std::uint64_t>::optimal_num_hashes( static_cast<double>( bits_per_key ) );
+		mclo::bloom_filter<std::uint64_t> filter( keys.size() * bits_per_key, num_hashes );
+		for ( auto _ : state )
+		{
+			filter.clear();
+			for ( const std::uint64_t key : keys )
+			{
+				filter.insert( key );
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * fpr_keys );
+		report_false_positive_rate( state, filter );
+		state.counters[ "num_hashes" ] = static_cast<double>( num_hashes );
+	}
+	BENCHMARK( BloomFilter_FalsePositiveRate )->DenseRange( 8, 24, 4 );
+
+	void BlockedBloomFilter_FalsePositiveRate( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( fpr_keys, 1 );
+		const auto bits_per_key = static_cast<std::size_t>( state.range( 0 ) );
+		mclo::blocked_bloom_filter<std::uint64_t> filter( keys.size() * bits_per_key );
+		for ( auto _ : state )
+		{
+			filter.clear();
+			filter.insert_many( keys );
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * fpr_keys );
+		report_false_positive_rate( state, filter );
+		state.counters[ "estimate" ] =
+			mclo::blocked_bloom_filter<std::uint64_t>::estimated_false_positive_rate( keys.size(), filter.num_bits() );
+	}
+	BENCHMARK( BlockedBloomFilter_FalsePositiveRate )->DenseRange( 8, 24, 4 );
+
+	// Bits per key is set by the fingerprint size and the load factor, so report it instead
+	template <typename Fingerprint>
+	void CuckooFilter_FalsePositiveRate( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( fpr_keys, 1 );
+		mclo::cuckoo_filter<std::uint64_t, mclo::rapidhash, Fingerprint> filter( keys.size() );
+		for ( auto _ : state )
+		{
+			filter.clear();
+			for ( const std::uint64_t key : keys )
+			{
+				benchmark::DoNotOptimize( filter.insert( key ) );
+			}
+		}
+		state.SetItemsProcessed( state.iterations() * fpr_keys );
+		report_false_positive_rate( state, filter );
+		state.counters[ "bits_per_key" ] =
+			static_cast<double>( filter.capacity() * sizeof( Fingerprint ) * 8 ) / static_cast<double>( keys.size() );
+	}
+	BENCHMARK( CuckooFilter_FalsePositiveRate<std::uint8_t> );
+	BENCHMARK( CuckooFilter_FalsePositiveRate<std::uint16_t> );
+
+	template <typename Filter, typename Contains>
+	void filter_contains( benchmark::State& state,
+						  const Filter& filter,
+						  const std::vector<std::uint64_t>& keys,
+						  Contains contains )
+	{
+		for ( auto _ : state )
+		{
+			std::size_t found = 0;
+			for ( const std::uint64_t key : keys )
+			{
+				found += contains( filter, key );
+			}
+			benchmark::DoNotOptimize( found );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+
+	// Lookup throughput at 10 bits per key for the Bloom filters, about 1% false positives for both
+	void BloomFilter_Contains( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( state.range( 0 ), 1 );
+		auto filter = mclo::bloom_filter<std::uint64_t>::with_false_positive_rate( keys.size(), 0.01 );
+		for ( const std::uint64_t key : keys )
+		{
+			filter.insert( key );
+		}
+		filter_contains( state, filter, make_lookups( keys ), []( const auto& filter, const std::uint64_t key ) {
+			return filter.contains( key );
+		} );
+	}
+	BENCHMARK( BloomFilter_Contains )->Apply( lookup_size_setup );
+
+	void BlockedBloomFilter_Contains( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( state.range( 0 ), 1 );
+		auto filter = mclo::blocked_bloom_filter<std::uint64_t>::with_false_positive_rate( keys.size(), 0.01 );
+		filter.insert_many( keys );
+		filter_contains( state, filter, make_lookups( keys ), []( const auto& filter, const std::uint64_t key ) {
+			return filter.contains( key );
+		} );
+	}
+	BENCHMARK( BlockedBloomFilter_Contains )->Apply( lookup_size_setup );
+
+	void BlockedBloomFilter_ContainsMany( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( state.range( 0 ), 1 );
+		auto filter = mclo::blocked_bloom_filter<std::uint64_t>::with_false_positive_rate( keys.size(), 0.01 );
+		filter.insert_many( keys );
+		const std::vector<std::uint64_t> lookups = make_lookups( keys );
+		const auto results = std::make_unique<bool[]>( lookups.size() );
+		for ( auto _ : state )
+		{
+			filter.contains_many( lookups, { results.get(), lookups.size() } );
+			benchmark::DoNotOptimize( results.get() );
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( lookups.size() ) );
+	}
+	BENCHMARK( BlockedBloomFilter_ContainsMany )->Apply( lookup_size_setup );
+
+	void CuckooFilter_Contains( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( state.range( 0 ), 1 );
+		mclo::cuckoo_filter<std::uint64_t> filter( keys.size() );
+		for ( const std::uint64_t key : keys )
+		{
+			benchmark::DoNotOptimize( filter.insert( key ) );
+		}
+		filter_contains( state, filter, make_lookups( keys ), []( const auto& filter, const std::uint64_t key ) {
+			return filter.contains( key );
+		} );
+	}
+	BENCHMARK( CuckooFilter_Contains )->Apply( lookup_size_setup );
+}
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/flat_map.hpp"
+#include "mclo/container/flat_set.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+	void size_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 16 )->Range( 1 << 8, 1 << 22 );
+	}
+
+	std::vector<std::uint64_t> make_keys( const std::int64_t count, const std::uint64_t seed = 1 )
+	{
+		std::mt19937_64 rng( seed );
+		std::vector<std::uint64_t> result( static_cast<std::size_t>( count ) );
+		for ( std::uint64_t& key : result )
+		{
+			key = rng();
+		}
+		return result;
+	}
+
+	// Looks up keys in a different order to how they were inserted, all present
+	std::vector<std::uint64_t> make_lookups( std::vector<std::uint64_t> keys )
+	{
+		std::shuffle( keys.begin(), keys.end(), std::mt19937_64( 2 ) );
+		keys.resize( std::min<std::size_t>( keys.size(), 1 << 16 ) );
+		return keys;
+	}
+
+	template <typename Set>
+	void set_contains( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( state.range( 0 ) );
+		const Set set( keys.begin(), keys.end() );
+		const std::vector<std::uint64_t> lookups = make_lookups( keys );
+		for ( auto _ : state )
+		{
+			std::size_t found = 0;
+			for ( const std::uint64_t key : lookups )
+			{
+				found += set.contains( key );
+			}
+			benchmark::DoNotOptimize( found );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( lookups.size() ) );
+	}
+
+	void FlatSet_Contains( benchmark::State& state )
+	{
+		set_contains<mclo::flat_set<std::uint64_t>>( state );
+	}
+	BENCHMARK( FlatSet_Contains )->Apply( size_setup );
+
+	void FlatSetEytzinger_Contains( benchmark::State& state )
+	{
+		set_contains<mclo::flat_set<std::uint64_t, std::less<std::uint64_t>, mclo::eytzinger_layout>>( state );
+	}
+	BENCHMARK( FlatSetEytzinger_Contains )->Apply( size_setup );
+
+	void StdSet_Contains( benchmark::State& state )
+	{
+		set_contains<std::set<std::uint64_t>>( state );
+	}
+	BENCHMARK( StdSet_Contains )->Apply( size_setup );
+
+	// Builds the map with a bulk insert into half the keys, so both the sort and the merge are measured
+	template <typename Map>
+	void map_insert_range( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( state.range( 0 ) );
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> first_half;
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> second_half;
+		for ( std::size_t index = 0; index < keys.size(); ++index )
+		{
+			( index % 2 ? second_half : first_half ).emplace_back( keys[ index ], static_cast<std::uint32_t>( index ) );
+		}
+		for ( auto _ : state )
+		{
+			Map map( first_half.begin(), first_half.end() );
+			if constexpr ( requires { map.insert_range( second_half ); } )
+			{
+				map.insert_range( second_half );
+			}
+			else
+			{
+				map.insert( second_half.begin(), second_half.end() );
+			}
+			benchmark::DoNotOptimize( map );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+
+	void FlatMap_InsertRange( benchmark::State& state )
+	{
+		map_insert_range<mclo::flat_map<std::uint64_t, std::uint32_t>>( state );
+	}
+	BENCHMARK( FlatMap_InsertRange )->Apply( size_setup )->Unit( benchmark::kMicrosecond );
+
+	void StdMap_InsertRange( benchmark::State& state )
+	{
+		map_insert_range<std::map<std::uint64_t, std::uint32_t>>( state );
+	}
+	BENCHMARK( StdMap_InsertRange )->Apply( size_setup )->Unit( benchmark::kMicrosecond );
+}
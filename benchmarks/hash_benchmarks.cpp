@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 
+#include "mclo/hash/buffered_hasher.hpp"
+#include "mclo/hash/hash.hpp"
 #include "mclo/hash/hash_append.hpp"
 #include "mclo/hash/hash_append_range.hpp"
 
@@ -11,9 +13,16 @@
 
 #include "mclo/hash/std_types.hpp"
 
+#include "mclo/platform/cpu_features.hpp"
+
 #include "mclo/random/random_generator.hpp"
 #include "mclo/random/xoshiro256plusplus.hpp"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
 namespace
 {
 	template <typename T>
@@ -123,4 +132,205 @@ namespace
 	BENCHMARK( hash_benchmark<hash_helper<mclo::xxhash_64>> );
 	BENCHMARK( hash_benchmark<hash_helper<mclo::xxhash_3>> );
 	BENCHMARK( hash_benchmark<std_hash_helper> );
+
+	using key_4 = std::uint32_t;
+	using key_8 = std::uint64_t;
+	using key_16 = std::array<std::uint64_t, 2>;
+
+	template <typename Key>
+	std::vector<Key> make_keys( const std::int64_t count )
+	{
+		mclo::random_generator<mclo::xoshiro256plusplus> random;
+		std::vector<std::uint32_t> words( static_cast<std::size_t>( count ) * sizeof( Key ) / sizeof( std::uint32_t ) );
+		random.generate( words );
+		std::vector<Key> keys( static_cast<std::size_t>( count ) );
+		std::memcpy( keys.data(), words.data(), keys.size() * sizeof( Key ) );
+		return keys;
+	}
+
+	// Hashing each key by itself, paying for a fresh hasher per key
+	template <typename Hasher, typename Key>
+	void hash_object_keys( benchmark::State& state )
+	{
+		const std::vector<Key> keys = make_keys<Key>( state.range( 0 ) );
+		std::vector<std::size_t> hashes( keys.size() );
+		for ( auto _ : state )
+		{
+			for ( std::size_t index = 0; index < keys.size(); ++index )
+			{
+				hashes[ index ] = mclo::hash_object<Hasher>( keys[ index ] );
+			}
+			benchmark::DoNotOptimize( hashes.data() );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+		state.SetBytesProcessed( state.iterations() * state.range( 0 ) * static_cast<std::int64_t>( sizeof( Key ) ) );
+	}
+
+	template <typename Hasher, typename Key>
+	void hash_many_keys( benchmark::State& state )
+	{
+		const std::vector<Key> keys = make_keys<Key>( state.range( 0 ) );
+		std::vector<std::size_t> hashes( keys.size() );
+		for ( auto _ : state )
+		{
+			mclo::hash_many<Hasher>( keys, hashes );
+			benchmark::DoNotOptimize( hashes.data() );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+		state.SetBytesProcessed( state.iterations() * state.range( 0 ) * static_cast<std::int64_t>( sizeof( Key ) ) );
+	}
+
+#define MCLO_HASH_KEYS_BENCHMARKS( HASHER )                                                                            \
+	BENCHMARK( hash_object_keys<HASHER, key_4> )->Arg( 1 << 16 );                                                      \
+	BENCHMARK( hash_many_keys<HASHER, key_4> )->Arg( 1 << 16 );                                                        \
+	BENCHMARK( hash_object_keys<HASHER, key_8> )->Arg( 1 << 16 );                                                      \
+	BENCHMARK( hash_many_keys<HASHER, key_8> )->Arg( 1 << 16 );                                                        \
+	BENCHMARK( hash_object_keys<HASHER, key_16> )->Arg( 1 << 16 );                                                     \
+	BENCHMARK( hash_many_keys<HASHER, key_16> )->Arg( 1 << 16 );
+
+	MCLO_HASH_KEYS_BENCHMARKS( mclo::murmur_hash_3 )
+	MCLO_HASH_KEYS_BENCHMARKS( mclo::rapidhash )
+	MCLO_HASH_KEYS_BENCHMARKS( mclo::xxhash_64 )
+	MCLO_HASH_KEYS_BENCHMARKS( mclo::xxhash_3 )
+
+#undef MCLO_HASH_KEYS_BENCHMARKS
+
+	// murmur_hash_3::hash_many with the lane kernels of one SIMD target, skipped if the CPU does not support it
+	template <mclo::simd_target Target, typename Key>
+	void murmur_hash_many_target( benchmark::State& state )
+	{
+		if ( !mclo::is_simd_target_supported( Target ) )
+		{
+			state.SkipWithError( "SIMD target not supported" );
+			return;
+		}
+		const mclo::simd_target previous = mclo::set_active_simd_target( Target );
+		hash_many_keys<mclo::murmur_hash_3, Key>( state );
+		mclo::set_active_simd_target( previous );
+	}
+
+#define MCLO_HASH_TARGET_BENCHMARKS( TARGET )                                                                          \
+	BENCHMARK( murmur_hash_many_target<TARGET, key_4> )->Arg( 1 << 16 );                                               \
+	BENCHMARK( murmur_hash_many_target<TARGET, key_16> )->Arg( 1 << 16 );
+
+	MCLO_HASH_TARGET_BENCHMARKS( mclo::simd_target::baseline )
+	MCLO_HASH_TARGET_BENCHMARKS( mclo::simd_target::avx2 )
+	MCLO_HASH_TARGET_BENCHMARKS( mclo::simd_target::avx512 )
+
+#undef MCLO_HASH_TARGET_BENCHMARKS
+
+	enum class field_hashing
+	{
+		per_field,
+		fused,
+	};
+
+	// A composite key of many small members with no padding between them
+	template <field_hashing Hashing>
+	struct composite_key
+	{
+		std::uint64_t id;
+		std::uint32_t region;
+		std::uint32_t shard;
+		std::uint16_t year;
+		std::uint16_t day;
+		std::uint16_t kind;
+		std::uint16_t version;
+		std::uint8_t flags;
+		std::uint8_t priority;
+		std::uint8_t source;
+		std::uint8_t format;
+		std::uint8_t channel;
+		std::uint8_t level;
+		std::uint8_t mode;
+		std::uint8_t tier;
+
+		template <mclo::hasher Hasher>
+		friend void hash_append( Hasher& hasher, const composite_key& key ) noexcept
+		{
+			const auto append = [ & ]( const auto&... fields ) {
+				if constexpr ( Hashing == field_hashing::fused )
+				{
+					mclo::hash_append_fields( hasher, fields... );
+				}
+				else
+				{
+					( hash_append( hasher, fields ), ... );
+				}
+			};
+			append( key.id,
+					key.region,
+					key.shard,
+					key.year,
+					key.day,
+					key.kind,
+					key.version,
+					key.flags,
+					key.priority,
+					key.source,
+					key.format,
+					key.channel,
+					key.level,
+					key.mode,
+					key.tier );
+		}
+	};
+
+	template <typename Key>
+	std::vector<Key> make_composite_keys()
+	{
+		mclo::random_generator<mclo::xoshiro256plusplus> random;
+		std::vector<std::uint64_t> words( 4096 * sizeof( Key ) / sizeof( std::uint64_t ) );
+		random.generate( words );
+		std::vector<Key> keys( 4096 );
+		std::memcpy( keys.data(), words.data(), keys.size() * sizeof( Key ) );
+		return keys;
+	}
+
+	template <typename Hasher, typename Key>
+	void composite_key_benchmark( benchmark::State& state )
+	{
+		const std::vector<Key> keys = make_composite_keys<Key>();
+		for ( auto _ : state )
+		{
+			for ( const Key& key : keys )
+			{
+				benchmark::DoNotOptimize( mclo::hash_object<Hasher>( key ) );
+			}
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+
+	// The bound for the others, every key hashed as its bytes in a single write
+	template <typename Hasher>
+	void composite_key_one_write_benchmark( benchmark::State& state )
+	{
+		using key_type = composite_key<field_hashing::per_field>;
+		const std::vector<key_type> keys = make_composite_keys<key_type>();
+		for ( auto _ : state )
+		{
+			for ( const key_type& key : keys )
+			{
+				Hasher hasher;
+				hasher.write( { reinterpret_cast<const std::byte*>( &key ), sizeof( key ) } );
+				benchmark::DoNotOptimize( hasher.finish() );
+			}
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+
+	using per_field_key = composite_key<field_hashing::per_field>;
+	using fused_key = composite_key<field_hashing::fused>;
+
+#define MCLO_COMPOSITE_KEY_BENCHMARKS( HASHER )                                                                        \
+	BENCHMARK( composite_key_benchmark<HASHER, per_field_key> );                                                       \
+	BENCHMARK( composite_key_benchmark<mclo::buffered_hasher<HASHER>, per_field_key> );                                \
+	BENCHMARK( composite_key_benchmark<HASHER, fused_key> );                                                           \
+	BENCHMARK( composite_key_one_write_benchmark<HASHER> );
+
+	MCLO_COMPOSITE_KEY_BENCHMARKS( mclo::murmur_hash_3 )
+	MCLO_COMPOSITE_KEY_BENCHMARKS( mclo::rapidhash )
+	MCLO_COMPOSITE_KEY_BENCHMARKS( mclo::xxhash_64 )
+
+#undef MCLO_COMPOSITE_KEY_BENCHMARKS
 }
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/intrusive_lru.hpp"
+#include "mclo/hash/hash.hpp"
+
+#include <cstdint>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	void capacity_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 8 )->Range( 1 << 6, 1 << 18 );
+	}
+
+	// Keys drawn from twice the capacity so roughly half the lookups miss and evict
+	std::vector<std::uint64_t> make_accesses( const std::int64_t capacity )
+	{
+		std::mt19937_64 rng( 1 );
+		std::uniform_int_distribution<std::uint64_t> dist( 0, static_cast<std::uint64_t>( capacity ) * 2 - 1 );
+		std::vector<std::uint64_t> result( 1 << 20 );
+		for ( std::uint64_t& key : result )
+		{
+			key = dist( rng );
+		}
+		return result;
+	}
+
+	struct lru_node : mclo::intrusive_list_hook<>, mclo::intrusive_hash_table_hook<>
+	{
+		std::uint64_t key = 0;
+		std::uint64_t value = 0;
+	};
+
+	struct key_of_node
+	{
+		std::uint64_t operator()( const lru_node& node ) const noexcept
+		{
+			return node.key;
+		}
+	};
+
+	using key_hash = mclo::hash<std::uint64_t>;
+
+	// Nodes come from a pool sized for the capacity, evicted nodes are reused so nothing allocates while running
+	void IntrusiveLru_Access( benchmark::State& state )
+	{
+		const std::size_t capacity = static_cast<std::size_t>( state.range( 0 ) );
+		const std::vector<std::uint64_t> accesses = make_accesses( state.range( 0 ) );
+		std::vector<lru_node> pool( capacity );
+		mclo::intrusive_lru<lru_node, key_of_node, key_hash> cache( capacity );
+		std::size_t next_free = 0;
+
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			for ( const std::uint64_t key : accesses )
+			{
+				if ( const lru_node* const node = cache.find( key ) )
+				{
+					sum += node->value;
+					continue;
+				}
+				lru_node* const node = cache.full() ? cache.pop_least_recent() : &pool[ next_free++ ];
+				node->key = key;
+				node->value = key * 3;
+				(void)cache.insert( *node );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( accesses.size() ) );
+	}
+	BENCHMARK( IntrusiveLru_Access )->Apply( capacity_setup );
+
+	// The usual node based LRU, a list for the order and a map from key to list position
+	void StdListUnorderedMapLru_Access( benchmark::State& state )
+	{
+		using list_type = std::list<std::pair<std::uint64_t, std::uint64_t>>;
+		const std::size_t capacity = static_cast<std::size_t>( state.range( 0 ) );
+		const std::vector<std::uint64_t> accesses = make_accesses( state.range( 0 ) );
+		list_type order;
+		std::unordered_map<std::uint64_t, list_type::iterator, key_hash> map;
+		map.reserve( capacity );
+
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			for ( const std::uint64_t key : accesses )
+			{
+				if ( const auto it = map.find( key ); it != map.end() )
+				{
+					order.splice( order.begin(), order, it->second );
+					sum += it->second->second;
+					continue;
+				}
+				if ( map.size() == capacity )
+				{
+					map.erase( order.back().first );
+					order.pop_back();
+				}
+				order.emplace_front( key, key * 3 );
+				map.emplace( key, order.begin() );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( accesses.size() ) );
+	}
+	BENCHMARK( StdListUnorderedMapLru_Access )->Apply( capacity_setup );
+}
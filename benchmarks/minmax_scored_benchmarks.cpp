@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/algorithm/minmax_scored.hpp"
+#include "mclo/algorithm/parallel_top_k_scored.hpp"
+#include "mclo/algorithm/top_k_scored.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	std::vector<float> make_scores( const std::int64_t count )
+	{
+		std::mt19937_64 rng( 1 );
+		std::uniform_real_distribution<float> distribution( 0.0f, 1.0f );
+		std::vector<float> result( static_cast<std::size_t>( count ) );
+		for ( float& score : result )
+		{
+			score = distribution( rng );
+		}
+		return result;
+	}
+
+	// A ranking candidate scored by a weighted sum of its features, a scorer simple enough to vectorize
+	struct candidate
+	{
+		float relevance;
+		float freshness;
+		float popularity;
+		std::uint32_t id;
+	};
+
+	std::vector<candidate> make_candidates( const std::int64_t count )
+	{
+		std::mt19937_64 rng( 2 );
+		std::uniform_real_distribution<float> distribution( 0.0f, 1.0f );
+		std::vector<candidate> result( static_cast<std::size_t>( count ) );
+		std::uint32_t id = 0;
+		for ( candidate& entry : result )
+		{
+			entry = { distribution( rng ), distribution( rng ), distribution( rng ), id++ };
+		}
+		return result;
+	}
+
+	constexpr auto score_candidate = []( const candidate& entry ) noexcept {
+		return entry.relevance * 0.6f + entry.freshness * 0.3f + entry.popularity * 0.1f;
+	};
+
+	void top_k_setup( benchmark::Benchmark* const b )
+	{
+		b->ArgsProduct( { { 1 << 16, 1 << 20, 1 << 24 }, { 10, 100, 1000 } } );
+	}
+
+	template <typename T, typename Scorer, typename TopK>
+	void top_k_benchmark( benchmark::State& state, const std::vector<T>& values, Scorer score, TopK top_k )
+	{
+		const auto k = static_cast<std::size_t>( state.range( 1 ) );
+		std::vector<typename std::vector<T>::const_iterator> result;
+		result.reserve( k );
+		for ( auto _ : state )
+		{
+			result.clear();
+			top_k( values, k, std::back_inserter( result ), score );
+			benchmark::DoNotOptimize( result.data() );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( values.size() ) );
+	}
+
+	constexpr auto mclo_top_k = []( const auto& values, const std::size_t k, auto out, auto score ) {
+		mclo::top_k_scored( values.begin(), values.end(), k, out, score );
+	};
+
+	// The standard library way, score into pairs then partially sort them
+	constexpr auto partial_sort_top_k = []( const auto& values, const std::size_t k, auto out, auto score ) {
+		using score_type = decltype( score( values.front() ) );
+		std::vector<std::pair<score_type, std::size_t>> scored( values.size() );
+		for ( std::size_t index = 0; index < values.size(); ++index )
+		{
+			scored[ index ] = { score( values[ index ] ), index };
+		}
+		const auto middle = scored.begin() + static_cast<std::ptrdiff_t>( std::min( k, scored.size() ) );
+		std::partial_sort( scored.begin(), middle, scored.end(), []( const auto& lhs, const auto& rhs ) {
+			return lhs.first > rhs.first || ( lhs.first == rhs.first && lhs.second < rhs.second );
+		} );
+		std::transform( scored.begin(), middle, out, [ & ]( const auto& entry ) {
+			return values.begin() + static_cast<std::ptrdiff_t>( entry.second );
+		} );
+	};
+
+	// Scores are the elements, so the SIMD scan reads them in place
+	void TopKScored_Identity( benchmark::State& state )
+	{
+		top_k_benchmark( state, make_scores( state.range( 0 ) ), std::identity{}, mclo_top_k );
+	}
+	BENCHMARK( TopKScored_Identity )->Apply( top_k_setup );
+
+	void TopKScored_Candidates( benchmark::State& state )
+	{
+		top_k_benchmark( state, make_candidates( state.range( 0 ) ), score_candidate, mclo_top_k );
+	}
+	BENCHMARK( TopKScored_Candidates )->Apply( top_k_setup );
+
+	// Comparing with anything but std::less keeps the same scores off the SIMD path, measuring the scalar heap scan
+	void TopKScored_CandidatesScalar( benchmark::State& state )
+	{
+		const auto less_score = []( const float lhs, const float rhs ) { return lhs < rhs; };
+		top_k_benchmark( state,
+						 make_candidates( state.range( 0 ) ),
+						 score_candidate,
+						 [ & ]( const auto& values, const std::size_t k, auto out, auto score ) {
+							 mclo::top_k_scored( values.begin(), values.end(), k, out, score, less_score );
+						 } );
+	}
+	BENCHMARK( TopKScored_CandidatesScalar )->Apply( top_k_setup );
+
+	void PartialSort_Candidates( benchmark::State& state )
+	{
+		top_k_benchmark( state, make_candidates( state.range( 0 ) ), score_candidate, partial_sort_top_k );
+	}
+	BENCHMARK( PartialSort_Candidates )->Apply( top_k_setup );
+
+	void ParallelTopKScored_Candidates( benchmark::State& state )
+	{
+		const mclo::thread_executor executor{ static_cast<std::size_t>( state.range( 2 ) ) };
+		top_k_benchmark( state,
+						 make_candidates( state.range( 0 ) ),
+						 score_candidate,
+						 [ & ]( const auto& values, const std::size_t k, auto out, auto score ) {
+							 mclo::parallel_top_k_scored(
+								 values.begin(), values.end(), k, out, score, std::less<>{}, executor );
+						 } );
+	}
+	BENCHMARK( ParallelTopKScored_Candidates )
+		->ArgsProduct( { { 1 << 20, 1 << 24 }, { 100 }, { 1, 2, 4, 8, 0 } } )
+		->UseRealTime();
+
+	void minmax_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 16 )->Range( 1 << 8, 1 << 24 );
+	}
+
+	void MinScored_Identity( benchmark::State& state )
+	{
+		const std::vector<float> values = make_scores( state.range( 0 ) );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( mclo::min_scored( values.begin(), values.end(), std::identity{} ) );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+	BENCHMARK( MinScored_Identity )->Apply( minmax_setup );
+
+	void MinElement( benchmark::State& state )
+	{
+		const std::vector<float> values = make_scores( state.range( 0 ) );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( std::min_element( values.begin(), values.end() ) );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+	BENCHMARK( MinElement )->Apply( minmax_setup );
+
+	void MinmaxScored_Candidates( benchmark::State& state )
+	{
+		const std::vector<candidate> values = make_candidates( state.range( 0 ) );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( mclo::minmax_scored( values.begin(), values.end(), score_candidate ) );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+	BENCHMARK( MinmaxScored_Candidates )->Apply( minmax_setup );
+}
@@ -0,0 +1,239 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/dynamic_mph_map.hpp"
+#include "mclo/container/mph_set.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+	void size_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 16 )->Range( 1 << 10, 1 << 22 );
+	}
+
+	void lookup_size_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 16 )->Range( 1 << 10, 1 << 24 );
+	}
+
+	using key_value = std::pair<std::uint64_t, std::uint32_t>;
+
+	std::vector<key_value> make_pairs( const std::int64_t count )
+	{
+		std::mt19937_64 rng( 1 );
+		std::unordered_set<std::uint64_t> seen;
+		std::vector<key_value> result;
+		while ( result.size() < static_cast<std::size_t>( count ) )
+		{
+			const std::uint64_t key = rng();
+			if ( seen.insert( key ).second )
+			{
+				result.emplace_back( key, static_cast<std::uint32_t>( result.size() ) );
+			}
+		}
+		return result;
+	}
+
+	// Look keys up in a different order to how they were inserted
+	std::vector<std::uint64_t> make_lookups( const std::vector<key_value>& pairs )
+	{
+		std::vector<std::uint64_t> result;
+		for ( const auto& [ key, value ] : pairs )
+		{
+			result.push_back( key );
+		}
+		std::shuffle( result.begin(), result.end(), std::mt19937_64( 2 ) );
+		return result;
+	}
+
+	mclo::mph_build_options threaded_options( const std::size_t num_threads )
+	{
+		mclo::mph_build_options options;
+		options.num_threads = num_threads;
+		return options;
+	}
+
+	void DynamicMphMap_Build( benchmark::State& state )
+	{
+		const std::vector<key_value> pairs = make_pairs( state.range( 0 ) );
+		const mclo::mph_build_options options = threaded_options( static_cast<std::size_t>( state.range( 1 ) ) );
+		for ( auto _ : state )
+		{
+			mclo::dynamic_mph_map<std::uint64_t, std::uint32_t> map( pairs, options );
+			benchmark::DoNotOptimize( map );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+
+		const mclo::dynamic_mph_map<std::uint64_t, std::uint32_t> map( pairs );
+		state.counters[ "bits_per_key" ] = map.hash_function().bits_per_key();
+	}
+	BENCHMARK( DynamicMphMap_Build )
+		->ArgsProduct( { benchmark::CreateRange( 1 << 10, 1 << 22, 16 ), { 1, 0 } } )
+		->Unit( benchmark::kMillisecond );
+
+	void UnorderedMap_Build( benchmark::State& state )
+	{
+		const std::vector<key_value> pairs = make_pairs( state.range( 0 ) );
+		for ( auto _ : state )
+		{
+			std::unordered_map<std::uint64_t, std::uint32_t> map( pairs.begin(), pairs.end() );
+			benchmark::DoNotOptimize( map );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+	BENCHMARK( UnorderedMap_Build )->Apply( size_setup )->Unit( benchmark::kMillisecond );
+
+	template <typename Map, typename Lookup>
+	void map_lookup( benchmark::State& state, const Map& map, const std::vector<std::uint64_t>& keys, Lookup lookup )
+	{
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			for ( const std::uint64_t key : keys )
+			{
+				sum += lookup( map, key );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+
+	void DynamicMphMap_Lookup( benchmark::State& state )
+	{
+		const std::vector<key_value> pairs = make_pairs( state.range( 0 ) );
+		const mclo::dynamic_mph_map<std::uint64_t, std::uint32_t> map( pairs );
+		map_lookup( state, map, make_lookups( pairs ), []( const auto& map, const std::uint64_t key ) {
+			return *map.lookup( key );
+		} );
+	}
+	BENCHMARK( DynamicMphMap_Lookup )->Apply( lookup_size_setup );
+
+	// Looks keys up in batches, sizes go past the last level cache where prefetching the batch pays off most
+	void DynamicMphMap_LookupMany( benchmark::State& state )
+	{
+		const std::vector<key_value> pairs = make_pairs( state.range( 0 ) );
+		const mclo::dynamic_mph_map<std::uint64_t, std::uint32_t> map( pairs );
+		const std::vector<std::uint64_t> keys = make_lookups( pairs );
+		const std::size_t batch_size = static_cast<std::size_t>( state.range( 1 ) );
+		std::vector<const std::uint32_t*> values( batch_size );
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			for ( std::size_t first = 0; first + batch_size <= keys.size(); first += batch_size )
+			{
+				map.lookup_many( mclo::span<const std::uint64_t>( keys.data() + first, batch_size ), values );
+				for ( const std::uint32_t* const value : values )
+				{
+					sum += *value;
+				}
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+	BENCHMARK( DynamicMphMap_LookupMany )
+		->ArgsProduct( { benchmark::CreateRange( 1 << 10, 1 << 24, 16 ), { 64, 1024 } } );
+
+	void UnorderedMap_Lookup( benchmark::State& state )
+	{
+		const std::vector<key_value> pairs = make_pairs( state.range( 0 ) );
+		const std::unordered_map<std::uint64_t, std::uint32_t> map( pairs.begin(), pairs.end() );
+		map_lookup( state, map, make_lookups( pairs ), []( const auto& map, const std::uint64_t key ) {
+			return map.find( key )->second;
+		} );
+	}
+	BENCHMARK( UnorderedMap_Lookup )->Apply( lookup_size_setup );
+
+	// Full period LCG so the keys are distinct and can be made in a constant expression
+	template <std::size_t Size>
+	constexpr std::array<std::uint32_t, Size> make_constexpr_keys()
+	{
+		std::array<std::uint32_t, Size> result{};
+		std::uint32_t state = 1;
+		for ( std::uint32_t& key : result )
+		{
+			state = state * 1664525u + 1013904223u;
+			key = state;
+		}
+		return result;
+	}
+
+	// Built at compile time, so building this file also measures constant evaluation of a large table
+	constexpr auto constexpr_keys = make_constexpr_keys<4096>();
+	constexpr mclo::mph_set<std::uint32_t, constexpr_keys.size()> constexpr_set( constexpr_keys );
+
+	// Runtime construction runs the same code as constant evaluation so tracks how compile time scales with Size
+	template <std::size_t Size>
+	void MphSet_Build( benchmark::State& state )
+	{
+		static constexpr auto keys = make_constexpr_keys<Size>();
+		for ( auto _ : state )
+		{
+			auto set = std::make_unique<mclo::mph_set<std::uint32_t, Size>>( keys );
+			benchmark::DoNotOptimize( set );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( Size ) );
+	}
+	BENCHMARK( MphSet_Build<64> );
+	BENCHMARK( MphSet_Build<256> );
+	BENCHMARK( MphSet_Build<1024> );
+	BENCHMARK( MphSet_Build<4096> );
+
+	// Half the lookups are keys in the set, half are random and almost always absent
+	std::vector<std::uint32_t> make_mixed_lookups()
+	{
+		std::mt19937 rng( 3 );
+		std::vector<std::uint32_t> result;
+		for ( std::size_t index = 0; index < 4096; ++index )
+		{
+			result.push_back( index % 2 ? constexpr_keys[ rng() % constexpr_keys.size() ] : rng() );
+		}
+		return result;
+	}
+
+	template <typename Set>
+	void set_contains( benchmark::State& state, const Set& set )
+	{
+		const std::vector<std::uint32_t> lookups = make_mixed_lookups();
+		for ( auto _ : state )
+		{
+			std::size_t found = 0;
+			for ( const std::uint32_t key : lookups )
+			{
+				found += set.contains( key );
+			}
+			benchmark::DoNotOptimize( found );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( lookups.size() ) );
+	}
+
+	void MphSet_Contains( benchmark::State& state )
+	{
+		set_contains( state, constexpr_set );
+	}
+	BENCHMARK( MphSet_Contains );
+
+	void MphSet_FindMany( benchmark::State& state )
+	{
+		const std::vector<std::uint32_t> lookups = make_mixed_lookups();
+		std::vector<decltype( constexpr_set )::const_iterator> found( lookups.size() );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( constexpr_set.find_many( lookups, found ) );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( lookups.size() ) );
+	}
+	BENCHMARK( MphSet_FindMany );
+
+	void UnorderedSet_Contains( benchmark::State& state )
+	{
+		const std::unordered_set<std::uint32_t> set( constexpr_keys.begin(), constexpr_keys.end() );
+		set_contains( state, set );
+	}
+	BENCHMARK( UnorderedSet_Contains );
+}
@@ -1,12 +1,16 @@
 #include <benchmark/benchmark.h>
 
+#include "mclo/algorithm/parallel_radix_sort.hpp"
 #include "mclo/algorithm/radix_sort.hpp"
 
 #include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <numeric>
 #include <random>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace
@@ -38,6 +42,29 @@ namespace
 		}
 	};
 
+	struct radix_sort_in_place_algo
+	{
+		template <typename T, typename KeyExtractor>
+		static mclo::radix_sort_result sort( std::vector<T>& source,
+											 std::vector<T>& /*output*/,
+											 KeyExtractor key_extractor )
+		{
+			mclo::radix_sort_in_place( source.begin(), source.end(), key_extractor );
+			return mclo::radix_sort_result::in_source;
+		}
+	};
+
+	struct radix_sort_by_cached_key_algo
+	{
+		template <typename T, typename KeyExtractor>
+		static mclo::radix_sort_result sort( std::vector<T>& source,
+											 std::vector<T>& output,
+											 KeyExtractor key_extractor )
+		{
+			return mclo::radix_sort_by_cached_key( source.begin(), source.end(), output.begin(), key_extractor );
+		}
+	};
+
 	// --- Element types ---
 
 	template <typename KeyT>
@@ -134,6 +161,7 @@ namespace
 		const auto items_processed = state.iterations() * n;
 		state.SetItemsProcessed( items_processed );
 		state.SetBytesProcessed( static_cast<std::int64_t>( items_processed * sizeof( T ) ) );
+		state.SetComplexityN( static_cast<std::int64_t>( n ) );
 	}
 
 	void sizes( benchmark::Benchmark* b )
@@ -145,10 +173,16 @@ namespace
 	BENCHMARK( sort_benchmark<std_sort_algo, type, key_extractor> )->Apply( sizes )->Complexity( benchmark::oNLogN );  \
 	BENCHMARK( sort_benchmark<radix_sort_algo, type, key_extractor> )->Apply( sizes )->Complexity( benchmark::oN )
 
+#define BENCHMARK_GROUP_IN_PLACE( type, key_extractor )                                                                \
+	BENCHMARK_GROUP( type, key_extractor );                                                                            \
+	BENCHMARK( sort_benchmark<radix_sort_in_place_algo, type, key_extractor> )                                         \
+		->Apply( sizes )                                                                                               \
+		->Complexity( benchmark::oN )
+
 #define BENCHMARK_GROUP_TYPED( type )                                                                                  \
-	BENCHMARK_GROUP( type, std::identity );                                                                            \
-	BENCHMARK_GROUP( keyed_element<type>, extract_key );                                                               \
-	BENCHMARK_GROUP( large_keyed_element<type>, extract_key );
+	BENCHMARK_GROUP_IN_PLACE( type, std::identity );                                                                   \
+	BENCHMARK_GROUP_IN_PLACE( keyed_element<type>, extract_key );                                                      \
+	BENCHMARK_GROUP_IN_PLACE( large_keyed_element<type>, extract_key );
 
 	BENCHMARK_GROUP( keyed_element<bool>, extract_key );
 	BENCHMARK_GROUP( large_keyed_element<bool>, extract_key );
@@ -162,4 +196,159 @@ namespace
 	BENCHMARK_GROUP_TYPED( std::int64_t );
 	BENCHMARK_GROUP_TYPED( float );
 	BENCHMARK_GROUP_TYPED( double );
+
+	// Moving strings every pass costs more than extracting the keys once and moving each element once
+	BENCHMARK( sort_benchmark<radix_sort_by_cached_key_algo, large_keyed_element<std::uint32_t>, extract_key> )
+		->Apply( sizes )
+		->Complexity( benchmark::oN );
+	BENCHMARK( sort_benchmark<radix_sort_by_cached_key_algo, large_keyed_element<std::uint64_t>, extract_key> )
+		->Apply( sizes )
+		->Complexity( benchmark::oN );
+
+	// --- Strings, composite keys and argsort ---
+
+	BENCHMARK_GROUP( std::string, std::identity );
+	BENCHMARK_GROUP( keyed_element<std::string>, extract_key );
+
+	struct tenant_event
+	{
+		std::uint32_t tenant_id;
+		std::uint64_t timestamp;
+		std::uint32_t payload;
+	};
+
+	void fill_data( tenant_event& out, std::mt19937& rng )
+	{
+		out.tenant_id = std::uniform_int_distribution<std::uint32_t>{ 0, 99 }( rng );
+		fill_data( out.timestamp, rng );
+		fill_data( out.payload, rng );
+	}
+
+	// Sorted by tenant then timestamp
+	template <bool Radix>
+	void composite_sort_benchmark( benchmark::State& state )
+	{
+		const auto n = static_cast<std::size_t>( state.range( 0 ) );
+		const auto original = generate_random_data<tenant_event>( n );
+		std::vector<tenant_event> source( n );
+		std::vector<tenant_event> output( n );
+
+		for ( auto _ : state )
+		{
+			source = original;
+			if constexpr ( Radix )
+			{
+				const auto key_extractors = std::tuple( &tenant_event::tenant_id, &tenant_event::timestamp );
+				benchmark::DoNotOptimize(
+					mclo::radix_sort( source.begin(), source.end(), output.begin(), key_extractors ) );
+			}
+			else
+			{
+				std::sort( source.begin(), source.end(), []( const tenant_event& lhs, const tenant_event& rhs ) {
+					return std::tie( lhs.tenant_id, lhs.timestamp ) < std::tie( rhs.tenant_id, rhs.timestamp );
+				} );
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( n ) );
+	}
+	BENCHMARK( composite_sort_benchmark<false> )->Apply( sizes );
+	BENCHMARK( composite_sort_benchmark<true> )->Apply( sizes );
+
+	// Computes the sorting permutation of heavy records without moving them
+	template <bool Radix, typename T>
+	void argsort_benchmark( benchmark::State& state )
+	{
+		const auto n = static_cast<std::size_t>( state.range( 0 ) );
+		const auto data = generate_random_data<T>( n );
+		std::vector<std::uint32_t> indices( n );
+
+		for ( auto _ : state )
+		{
+			if constexpr ( Radix )
+			{
+				mclo::radix_argsort( data.begin(), data.end(), indices.begin(), extract_key{} );
+			}
+			else
+			{
+				std::iota( indices.begin(), indices.end(), 0u );
+				std::sort( indices.begin(), indices.end(), [ & ]( const std::uint32_t lhs, const std::uint32_t rhs ) {
+					return data[ lhs ].first < data[ rhs ].first;
+				} );
+			}
+			benchmark::DoNotOptimize( indices );
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( n ) );
+	}
+	BENCHMARK( argsort_benchmark<false, large_keyed_element<std::uint64_t>> )->Apply( sizes );
+	BENCHMARK( argsort_benchmark<true, large_keyed_element<std::uint64_t>> )->Apply( sizes );
+	BENCHMARK( argsort_benchmark<false, large_keyed_element<std::string>> )->Apply( sizes );
+	BENCHMARK( argsort_benchmark<true, large_keyed_element<std::string>> )->Apply( sizes );
+
+	// --- Large inputs ---
+
+	// Past the last level cache, where digit width, skipped passes and write combining matter most. The largest
+	// sizes need several gigabytes of memory
+	void large_sizes( benchmark::Benchmark* b )
+	{
+		b->RangeMultiplier( 32 )->Range( 1 << 10, 1 << 30 )->Unit( benchmark::kMillisecond );
+	}
+
+	// Keys below 2^20 where the high byte passes are skipped
+	template <typename T>
+	struct small_key
+	{
+		[[nodiscard]] T operator()( const T value ) const noexcept
+		{
+			return value & 0xFFFFF;
+		}
+	};
+
+	BENCHMARK( sort_benchmark<radix_sort_algo, std::uint32_t, std::identity> )->Apply( large_sizes );
+	BENCHMARK( sort_benchmark<radix_sort_algo, std::uint64_t, std::identity> )->Apply( large_sizes );
+	BENCHMARK( sort_benchmark<radix_sort_algo, std::uint64_t, small_key<std::uint64_t>> )->Apply( large_sizes );
+	BENCHMARK( sort_benchmark<radix_sort_algo, keyed_element<std::uint64_t>, extract_key> )->Apply( large_sizes );
+	BENCHMARK( sort_benchmark<radix_sort_in_place_algo, std::uint32_t, std::identity> )->Apply( large_sizes );
+	BENCHMARK( sort_benchmark<radix_sort_in_place_algo, std::uint64_t, std::identity> )->Apply( large_sizes );
+	BENCHMARK( sort_benchmark<radix_sort_in_place_algo, keyed_element<std::uint64_t>, extract_key> )
+		->Apply( large_sizes );
+	BENCHMARK( sort_benchmark<std_sort_algo, std::uint64_t, std::identity> )->Apply( large_sizes );
+
+	// --- Parallel scaling ---
+
+	// Sizes past the last level cache, argument 1 is the thread count with 0 for every hardware thread
+	template <typename T, typename KeyExtractor>
+	void parallel_sort_benchmark( benchmark::State& state )
+	{
+		const auto n = static_cast<std::size_t>( state.range( 0 ) );
+		const mclo::thread_executor executor{ static_cast<std::size_t>( state.range( 1 ) ) };
+		const auto original = generate_random_data<T>( n );
+		std::vector<T> source( n );
+		std::vector<T> output( n );
+
+		for ( auto _ : state )
+		{
+			source = original;
+			benchmark::DoNotOptimize(
+				mclo::parallel_radix_sort( source.begin(), source.end(), output.begin(), KeyExtractor{}, executor ) );
+			benchmark::ClobberMemory();
+		}
+
+		const auto items_processed = state.iterations() * n;
+		state.SetItemsProcessed( items_processed );
+		state.SetBytesProcessed( static_cast<std::int64_t>( items_processed * sizeof( T ) ) );
+		state.counters[ "threads" ] = static_cast<double>( executor.concurrency() );
+	}
+
+	void parallel_sizes( benchmark::Benchmark* b )
+	{
+		b->ArgsProduct( { { 1 << 20, 1 << 23, 1 << 26 }, { 1, 2, 4, 8, 16, 0 } } )
+			->Unit( benchmark::kMillisecond )
+			->UseRealTime();
+	}
+
+	BENCHMARK( parallel_sort_benchmark<std::uint32_t, std::identity> )->Apply( parallel_sizes );
+	BENCHMARK( parallel_sort_benchmark<std::uint64_t, std::identity> )->Apply( parallel_sizes );
+	BENCHMARK( parallel_sort_benchmark<keyed_element<std::uint64_t>, extract_key> )->Apply( parallel_sizes );
 }
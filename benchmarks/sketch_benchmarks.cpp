@@ -0,0 +1,236 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/count_min_sketch.hpp"
+#include "mclo/container/hyperloglog.hpp"
+#include "mclo/container/space_saving_sketch.hpp"
+#include "mclo/threading/parallel_for.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr std::size_t stream_length = 1 << 20;
+
+	std::vector<std::uint64_t> make_keys( const std::size_t count )
+	{
+		std::mt19937_64 rng( 1 );
+		std::vector<std::uint64_t> result( count );
+		std::generate( result.begin(), result.end(), rng );
+		return result;
+	}
+
+	// Skewed stream over a million distinct keys, key i occurs roughly in proportion to 1 / (i + 1)
+	const std::vector<std::uint64_t>& zipf_stream()
+	{
+		static const std::vector<std::uint64_t> stream = [] {
+			constexpr std::size_t num_keys = 1 << 20;
+			std::vector<double> weights( num_keys );
+			for ( std::size_t key = 0; key < num_keys; ++key )
+			{
+				weights[ key ] = 1.0 / static_cast<double>( key + 1 );
+			}
+			std::discrete_distribution<std::uint64_t> distribution( weights.begin(), weights.end() );
+			std::mt19937 rng( 2 );
+			std::vector<std::uint64_t> result( stream_length );
+			std::generate( result.begin(), result.end(), [ & ] { return distribution( rng ); } );
+			return result;
+		}();
+		return stream;
+	}
+
+	// Update throughput of one sketch fed a stream one key at a time
+	template <typename Sketch, typename Insert>
+	void sketch_insert( benchmark::State& state, Sketch sketch, const std::vector<std::uint64_t>& keys, Insert insert )
+	{
+		for ( auto _ : state )
+		{
+			sketch.clear();
+			for ( const std::uint64_t key : keys )
+			{
+				insert( sketch, key );
+			}
+			benchmark::DoNotOptimize( sketch );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+
+	// Parallel ingestion, a sketch per thread over its chunk of the stream merged into one at the end
+	template <typename Sketch, typename Insert>
+	void sketch_parallel_insert( benchmark::State& state,
+								 const Sketch& prototype,
+								 const std::vector<std::uint64_t>& keys,
+								 Insert insert )
+	{
+		const std::size_t num_threads = mclo::resolve_thread_count( static_cast<std::size_t>( state.range( 0 ) ) );
+		for ( auto _ : state )
+		{
+			std::vector<Sketch> sketches( num_threads, prototype );
+			const auto ingest_chunk = [ & ]( const std::size_t chunk, const std::size_t begin, const std::size_t end ) {
+				insert( sketches[ chunk ], mclo::span<const std::uint64_t>( keys ).subspan( begin, end - begin ) );
+			};
+			const std::size_t num_chunks = mclo::parallel_for_chunks( num_threads, keys.size(), ingest_chunk );
+			for ( std::size_t chunk = 1; chunk < num_chunks; ++chunk )
+			{
+				sketches.front().merge( sketches[ chunk ] );
+			}
+			benchmark::DoNotOptimize( sketches.front() );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+		state.counters[ "threads" ] = static_cast<double>( num_threads );
+	}
+
+	void HyperLogLog_Insert( benchmark::State& state )
+	{
+		const mclo::hyperloglog<std::uint64_t> sketch( static_cast<unsigned>( state.range( 0 ) ) );
+		sketch_insert( state, sketch, make_keys( stream_length ), []( auto& sketch, const std::uint64_t key ) {
+			sketch.insert( key );
+		} );
+	}
+	BENCHMARK( HyperLogLog_Insert )->Arg( 10 )->Arg( 14 )->Arg( 18 );
+
+	void HyperLogLog_InsertMany( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( stream_length );
+		mclo::hyperloglog<std::uint64_t> sketch( static_cast<unsigned>( state.range( 0 ) ) );
+		for ( auto _ : state )
+		{
+			sketch.clear();
+			sketch.insert_many( keys );
+			benchmark::DoNotOptimize( sketch );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+	BENCHMARK( HyperLogLog_InsertMany )->Arg( 10 )->Arg( 14 )->Arg( 18 );
+
+	// Small streams stay sparse, measures the sorted list and its buffer
+	void HyperLogLog_InsertSparse( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( 2048 );
+		sketch_insert( state,
+					   mclo::hyperloglog<std::uint64_t>( 14 ),
+					   keys,
+					   []( auto& sketch, const std::uint64_t key ) { sketch.insert( key ); } );
+	}
+	BENCHMARK( HyperLogLog_InsertSparse );
+
+	void HyperLogLog_ParallelInsert( benchmark::State& state )
+	{
+		sketch_parallel_insert( state,
+								mclo::hyperloglog<std::uint64_t>( 14 ),
+								make_keys( stream_length ),
+								[]( auto& sketch, const mclo::span<const std::uint64_t> keys ) {
+									sketch.insert_many( keys );
+								} );
+	}
+	BENCHMARK( HyperLogLog_ParallelInsert )->Arg( 1 )->Arg( 0 )->UseRealTime();
+
+	void HyperLogLog_Merge( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t> keys = make_keys( stream_length );
+		mclo::hyperloglog<std::uint64_t> lhs( static_cast<unsigned>( state.range( 0 ) ) );
+		mclo::hyperloglog<std::uint64_t> rhs( static_cast<unsigned>( state.range( 0 ) ) );
+		lhs.insert_many( mclo::span<const std::uint64_t>( keys ).first( keys.size() / 2 ) );
+		rhs.insert_many( mclo::span<const std::uint64_t>( keys ).subspan( keys.size() / 2 ) );
+		for ( auto _ : state )
+		{
+			lhs.merge( rhs );
+			benchmark::DoNotOptimize( lhs );
+		}
+		state.SetBytesProcessed( state.iterations() * ( std::int64_t{ 1 } << state.range( 0 ) ) );
+	}
+	BENCHMARK( HyperLogLog_Merge )->Arg( 10 )->Arg( 14 )->Arg( 18 );
+
+	void HyperLogLog_Estimate( benchmark::State& state )
+	{
+		mclo::hyperloglog<std::uint64_t> sketch( static_cast<unsigned>( state.range( 0 ) ) );
+		sketch.insert_many( make_keys( stream_length ) );
+		for ( auto _ : state )
+		{
+			benchmark::DoNotOptimize( sketch.estimate() );
+		}
+	}
+	BENCHMARK( HyperLogLog_Estimate )->Arg( 10 )->Arg( 14 )->Arg( 18 );
+
+	// 0.01% error with 99% probability is about 27 thousand counters per row by 5 rows
+	mclo::count_min_sketch<std::uint64_t> make_count_min()
+	{
+		return mclo::count_min_sketch<std::uint64_t>::with_error( 0.0001, 0.01 );
+	}
+
+	void CountMinSketch_Insert( benchmark::State& state )
+	{
+		sketch_insert( state, make_count_min(), zipf_stream(), []( auto& sketch, const std::uint64_t key ) {
+			sketch.insert( key );
+		} );
+	}
+	BENCHMARK( CountMinSketch_Insert );
+
+	void CountMinSketch_InsertMany( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t>& keys = zipf_stream();
+		auto sketch = make_count_min();
+		for ( auto _ : state )
+		{
+			sketch.clear();
+			sketch.insert_many( keys );
+			benchmark::DoNotOptimize( sketch );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+	BENCHMARK( CountMinSketch_InsertMany );
+
+	void CountMinSketch_ParallelInsert( benchmark::State& state )
+	{
+		sketch_parallel_insert( state,
+								make_count_min(),
+								zipf_stream(),
+								[]( auto& sketch, const mclo::span<const std::uint64_t> keys ) {
+									sketch.insert_many( keys );
+								} );
+	}
+	BENCHMARK( CountMinSketch_ParallelInsert )->Arg( 1 )->Arg( 0 )->UseRealTime();
+
+	void CountMinSketch_Estimate( benchmark::State& state )
+	{
+		const std::vector<std::uint64_t>& keys = zipf_stream();
+		auto sketch = make_count_min();
+		sketch.insert_many( keys );
+		for ( auto _ : state )
+		{
+			std::uint64_t sum = 0;
+			for ( const std::uint64_t key : keys )
+			{
+				sum += sketch.estimate( key );
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * static_cast<std::int64_t>( keys.size() ) );
+	}
+	BENCHMARK( CountMinSketch_Estimate );
+
+	void SpaceSavingSketch_Insert( benchmark::State& state )
+	{
+		const mclo::space_saving_sketch<std::uint64_t> sketch( static_cast<std::size_t>( state.range( 0 ) ) );
+		sketch_insert( state, sketch, zipf_stream(), []( auto& sketch, const std::uint64_t key ) {
+			sketch.insert( key );
+		} );
+	}
+	BENCHMARK( SpaceSavingSketch_Insert )->Arg( 100 )->Arg( 1000 )->Arg( 10000 );
+
+	void SpaceSavingSketch_ParallelInsert( benchmark::State& state )
+	{
+		sketch_parallel_insert( state,
+								mclo::space_saving_sketch<std::uint64_t>( 1000 ),
+								zipf_stream(),
+								[]( auto& sketch, const mclo::span<const std::uint64_t> keys ) {
+									for ( const std::uint64_t key : keys )
+									{
+										sketch.insert( key );
+									}
+								} );
+	}
+	BENCHMARK( SpaceSavingSketch_ParallelInsert )->Arg( 1 )->Arg( 0 )->UseRealTime();
+}
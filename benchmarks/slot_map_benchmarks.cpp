@@ -1,10 +1,19 @@
 #include <benchmark/benchmark.h>
 
+#include "mclo/container/concurrent_slot_map.hpp"
 #include "mclo/container/dense_slot_map.hpp"
+#include "mclo/container/dense_soa_slot_map.hpp"
+#include "mclo/container/paged_slot_map.hpp"
 #include "mclo/random/random_generator.hpp"
 #include "mclo/random/xoshiro256plusplus.hpp"
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -46,4 +55,348 @@ namespace
 		}
 	}
 	BENCHMARK( BM_IterateDenseSlotMap );
+
+	// A particle with one hot field updated every frame and cold data only touched occasionally
+	struct particle_position
+	{
+		float x = 0;
+		float y = 0;
+		float z = 0;
+	};
+
+	struct particle_cold
+	{
+		std::array<float, 13> data{};
+	};
+
+	struct particle
+	{
+		particle_position position;
+		particle_cold cold;
+	};
+
+	void slot_map_size_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 8 )->Range( 64, 1 << 18 );
+	}
+
+	void BM_IterateOneFieldDenseSlotMap( benchmark::State& state )
+	{
+		mclo::dense_slot_map<particle> map;
+		for ( std::int64_t i = 0; i < state.range( 0 ); ++i )
+		{
+			( void )map.insert( particle{} );
+		}
+
+		for ( auto _ : state )
+		{
+			for ( particle& data : map )
+			{
+				data.position.x += 1.0f;
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+	BENCHMARK( BM_IterateOneFieldDenseSlotMap )->Apply( slot_map_size_setup );
+
+	void BM_IterateOneFieldDenseSoaSlotMap( benchmark::State& state )
+	{
+		mclo::dense_soa_slot_map<std::tuple<particle_position, particle_cold>> map;
+		for ( std::int64_t i = 0; i < state.range( 0 ); ++i )
+		{
+			( void )map.emplace( particle_position{}, particle_cold{} );
+		}
+
+		for ( auto _ : state )
+		{
+			for ( particle_position& position : map.column<particle_position>() )
+			{
+				position.x += 1.0f;
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+	BENCHMARK( BM_IterateOneFieldDenseSoaSlotMap )->Apply( slot_map_size_setup );
+
+	// What sharing a dense_slot_map between threads needs, every operation behind one reader writer lock
+	class shared_mutex_dense_slot_map
+	{
+	public:
+		using handle_type = mclo::dense_slot_map<int>::handle_type;
+
+		[[nodiscard]] handle_type insert( const int value )
+		{
+			std::scoped_lock lock( m_mutex );
+			return m_map.insert( value );
+		}
+
+		void erase( const handle_type handle )
+		{
+			std::scoped_lock lock( m_mutex );
+			m_map.erase( handle );
+		}
+
+		[[nodiscard]] int lookup_or_zero( const handle_type handle ) const
+		{
+			std::shared_lock lock( m_mutex );
+			const int* const value = m_map.lookup( handle );
+			return value ? *value : 0;
+		}
+
+	private:
+		mutable std::shared_mutex m_mutex;
+		mclo::dense_slot_map<int> m_map;
+	};
+
+	class concurrent_slot_map_adaptor
+	{
+	public:
+		using handle_type = mclo::concurrent_slot_map<int>::handle_type;
+
+		[[nodiscard]] handle_type insert( const int value )
+		{
+			return m_map.insert( value );
+		}
+
+		void erase( const handle_type handle )
+		{
+			m_map.erase( handle );
+		}
+
+		[[nodiscard]] int lookup_or_zero( const handle_type handle ) const
+		{
+			const int* const value = m_map.lookup( handle );
+			return value ? *value : 0;
+		}
+
+	private:
+		mclo::concurrent_slot_map<int> m_map;
+	};
+
+	constexpr int concurrent_entries = 1 << 14;
+	constexpr int concurrent_batch_size = 256;
+
+	// Argument is the percentage of operations that are lookups, the rest insert then erase an entry
+	void concurrent_setup( benchmark::Benchmark* const b )
+	{
+		b->Arg( 90 )->Arg( 99 )->ThreadRange( 1, 16 )->UseRealTime();
+	}
+
+	template <typename Map>
+	void read_heavy_mix( benchmark::State& state )
+	{
+		static std::unique_ptr<Map> map;
+		static std::vector<typename Map::handle_type> handles;
+		if ( state.thread_index() == 0 )
+		{
+			map = std::make_unique<Map>();
+			handles.clear();
+			for ( int i = 0; i < concurrent_entries; ++i )
+			{
+				handles.push_back( map->insert( i ) );
+			}
+		}
+
+		mclo::random_generator<mclo::xoshiro256plusplus> generator( std::in_place, state.thread_index() + 1 );
+		const std::int64_t read_percent = state.range( 0 );
+		for ( auto _ : state )
+		{
+			int sum = 0;
+			for ( int op = 0; op < concurrent_batch_size; ++op )
+			{
+				if ( generator.uniform<std::int64_t>( 0, 99 ) < read_percent )
+				{
+					sum += map->lookup_or_zero( handles[ generator.uniform<std::size_t>( 0, handles.size() - 1 ) ] );
+				}
+				else
+				{
+					map->erase( map->insert( op ) );
+				}
+			}
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * concurrent_batch_size );
+
+		if ( state.thread_index() == 0 )
+		{
+			map.reset();
+		}
+	}
+
+	void BM_ReadHeavySharedMutexDenseSlotMap( benchmark::State& state )
+	{
+		read_heavy_mix<shared_mutex_dense_slot_map>( state );
+	}
+	BENCHMARK( BM_ReadHeavySharedMutexDenseSlotMap )->Apply( concurrent_setup );
+
+	void BM_ReadHeavyConcurrentSlotMap( benchmark::State& state )
+	{
+		read_heavy_mix<concurrent_slot_map_adaptor>( state );
+	}
+	BENCHMARK( BM_ReadHeavyConcurrentSlotMap )->Apply( concurrent_setup );
+
+	// Large enough that moving the last value into an erased gap is a noticeable cost
+	struct large_object
+	{
+		std::array<std::uint64_t, 32> data{};
+	};
+
+	template <typename Map>
+	void erase_and_insert_random( benchmark::State& state )
+	{
+		Map map;
+		std::vector<typename Map::handle_type> handles;
+		for ( std::int64_t i = 0; i < state.range( 0 ); ++i )
+		{
+			handles.push_back( map.insert( large_object{} ) );
+		}
+
+		mclo::random_generator<mclo::xoshiro256plusplus> generator;
+		for ( auto _ : state )
+		{
+			const std::size_t index = generator.uniform<std::size_t>( 0, handles.size() - 1 );
+			map.erase( handles[ index ] );
+			handles[ index ] = map.insert( large_object{} );
+			benchmark::DoNotOptimize( handles[ index ] );
+		}
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	void BM_EraseInsertLargeDenseSlotMap( benchmark::State& state )
+	{
+		erase_and_insert_random<mclo::dense_slot_map<large_object>>( state );
+	}
+	BENCHMARK( BM_EraseInsertLargeDenseSlotMap )->Apply( slot_map_size_setup );
+
+	void BM_EraseInsertLargePagedSlotMap( benchmark::State& state )
+	{
+		erase_and_insert_random<mclo::paged_slot_map<large_object>>( state );
+	}
+	BENCHMARK( BM_EraseInsertLargePagedSlotMap )->Apply( slot_map_size_setup );
+
+	// Fill then erase a random half, dense compacts so only the paged map has holes to skip
+	template <typename Map>
+	void iterate_after_random_erase( benchmark::State& state )
+	{
+		Map map;
+		std::vector<typename Map::handle_type> handles;
+		for ( std::int64_t i = 0; i < state.range( 0 ) * 2; ++i )
+		{
+			handles.push_back( map.insert( particle{} ) );
+		}
+		mclo::random_generator<mclo::xoshiro256plusplus> generator;
+		std::shuffle( handles.begin(), handles.end(), generator.get_engine() );
+		handles.resize( handles.size() / 2 );
+		for ( const auto handle : handles )
+		{
+			map.erase( handle );
+		}
+
+		for ( auto _ : state )
+		{
+			if constexpr ( requires { map.for_each( []( particle& ) {} ); } )
+			{
+				map.for_each( []( particle& data ) { data.position.x += 1.0f; } );
+			}
+			else
+			{
+				for ( particle& data : map )
+				{
+					data.position.x += 1.0f;
+				}
+			}
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+
+	void BM_IterateWithHolesDenseSlotMap( benchmark::State& state )
+	{
+		iterate_after_random_erase<mclo::dense_slot_map<particle>>( state );
+	}
+	BENCHMARK( BM_IterateWithHolesDenseSlotMap )->Apply( slot_map_size_setup );
+
+	void BM_IterateWithHolesPagedSlotMap( benchmark::State& state )
+	{
+		iterate_after_random_erase<mclo::paged_slot_map<particle>>( state );
+	}
+	BENCHMARK( BM_IterateWithHolesPagedSlotMap )->Apply( slot_map_size_setup );
+
+	constexpr std::size_t lookup_batch_size = 64;
+
+	// Goes past the last level cache where prefetching the batch pays off most
+	void lookup_size_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 8 )->Range( 64, 1 << 21 );
+	}
+
+	// Random handles in batches, returning the sum of a field so both versions do the same work per found value
+	template <typename Map, bool Batched>
+	void lookup_random_handles( benchmark::State& state )
+	{
+		Map map;
+		std::vector<typename Map::handle_type> handles;
+		for ( std::int64_t i = 0; i < state.range( 0 ); ++i )
+		{
+			handles.push_back( map.insert( particle{} ) );
+		}
+		mclo::random_generator<mclo::xoshiro256plusplus> generator;
+		std::shuffle( handles.begin(), handles.end(), generator.get_engine() );
+		const std::size_t num_batches = ( handles.size() + lookup_batch_size - 1 ) / lookup_batch_size;
+		handles.resize( num_batches * lookup_batch_size, handles.front() );
+
+		std::array<typename Map::const_pointer, lookup_batch_size> found;
+		const Map& const_map = map;
+		std::size_t batch = 0;
+		for ( auto _ : state )
+		{
+			const mclo::span<const typename Map::handle_type> batch_handles(
+				handles.data() + batch * lookup_batch_size, lookup_batch_size );
+			if constexpr ( Batched )
+			{
+				const_map.lookup_many( batch_handles, found );
+			}
+			else
+			{
+				for ( std::size_t index = 0; index < lookup_batch_size; ++index )
+				{
+					found[ index ] = const_map.lookup( batch_handles[ index ] );
+				}
+			}
+			float sum = 0;
+			for ( const auto ptr : found )
+			{
+				sum += ptr->position.x;
+			}
+			benchmark::DoNotOptimize( sum );
+			batch = batch + 1 == num_batches ? 0 : batch + 1;
+		}
+		state.SetItemsProcessed( state.iterations() * lookup_batch_size );
+	}
+
+	void BM_LookupLoopDenseSlotMap( benchmark::State& state )
+	{
+		lookup_random_handles<mclo::dense_slot_map<particle>, false>( state );
+	}
+	BENCHMARK( BM_LookupLoopDenseSlotMap )->Apply( lookup_size_setup );
+
+	void BM_LookupManyDenseSlotMap( benchmark::State& state )
+	{
+		lookup_random_handles<mclo::dense_slot_map<particle>, true>( state );
+	}
+	BENCHMARK( BM_LookupManyDenseSlotMap )->Apply( lookup_size_setup );
+
+	void BM_LookupLoopPagedSlotMap( benchmark::State& state )
+	{
+		lookup_random_handles<mclo::paged_slot_map<particle>, false>( state );
+	}
+	BENCHMARK( BM_LookupLoopPagedSlotMap )->Apply( lookup_size_setup );
+
+	void BM_LookupManyPagedSlotMap( benchmark::State& state )
+	{
+		lookup_random_handles<mclo::paged_slot_map<particle>, true>( state );
+	}
+	BENCHMARK( BM_LookupManyPagedSlotMap )->Apply( lookup_size_setup );
 }
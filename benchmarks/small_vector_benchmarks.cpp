@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/allocator/arena_allocator.hpp"
+#include "mclo/container/small_vector.hpp"
+#include "mclo/memory/intrusive_ptr.hpp"
+#include "mclo/memory/intrusive_ref_counter.hpp"
+
+#include <vector>
+
+namespace
+{
+	struct ref_counted : mclo::intrusive_ref_counter<ref_counted>
+	{
+		int m_value = 1;
+	};
+
+	// Trivially relocatable but with a non trivial copy and destructor, so std::vector moves it one at a time
+	using ref_ptr = mclo::intrusive_ptr<ref_counted>;
+
+	void size_setup( benchmark::Benchmark* const b )
+	{
+		b->RangeMultiplier( 8 )->Range( 8, 1 << 12 );
+	}
+
+	template <typename Vector, typename Value>
+	void push_back( benchmark::State& state, const Value& value )
+	{
+		const std::size_t count = static_cast<std::size_t>( state.range( 0 ) );
+		for ( auto _ : state )
+		{
+			Vector vec;
+			for ( std::size_t index = 0; index < count; ++index )
+			{
+				vec.push_back( value );
+			}
+			benchmark::DoNotOptimize( vec.data() );
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+
+	void BM_SmallVectorPushBackInt( benchmark::State& state )
+	{
+		push_back<mclo::small_vector<int>>( state, 1 );
+	}
+	BENCHMARK( BM_SmallVectorPushBackInt )->Apply( size_setup );
+
+	void BM_SmallVectorDoublingPushBackInt( benchmark::State& state )
+	{
+		push_back<mclo::small_vector<int, 16, std::allocator<int>, mclo::geometric_growth<2>>>( state, 1 );
+	}
+	BENCHMARK( BM_SmallVectorDoublingPushBackInt )->Apply( size_setup );
+
+	void BM_StdVectorPushBackInt( benchmark::State& state )
+	{
+		push_back<std::vector<int>>( state, 1 );
+	}
+	BENCHMARK( BM_StdVectorPushBackInt )->Apply( size_setup );
+
+	void BM_SmallVectorPushBackRelocatable( benchmark::State& state )
+	{
+		push_back<mclo::small_vector<ref_ptr>>( state, ref_ptr( new ref_counted ) );
+	}
+	BENCHMARK( BM_SmallVectorPushBackRelocatable )->Apply( size_setup );
+
+	void BM_StdVectorPushBackRelocatable( benchmark::State& state )
+	{
+		push_back<std::vector<ref_ptr>>( state, ref_ptr( new ref_counted ) );
+	}
+	BENCHMARK( BM_StdVectorPushBackRelocatable )->Apply( size_setup );
+
+	// Inserting and erasing at the front shifts every value, relocating them as bytes instead of move assigning
+	template <typename Vector>
+	void insert_erase_front( benchmark::State& state )
+	{
+		const ref_ptr value( new ref_counted );
+		Vector vec( static_cast<typename Vector::size_type>( state.range( 0 ) ), value );
+		for ( auto _ : state )
+		{
+			vec.insert( vec.begin(), value );
+			vec.erase( vec.begin() );
+			benchmark::DoNotOptimize( vec.data() );
+		}
+		state.SetItemsProcessed( state.iterations() );
+	}
+
+	void BM_SmallVectorInsertEraseFrontRelocatable( benchmark::State& state )
+	{
+		insert_erase_front<mclo::small_vector<ref_ptr>>( state );
+	}
+	BENCHMARK( BM_SmallVectorInsertEraseFrontRelocatable )->Apply( size_setup );
+
+	void BM_StdVectorInsertEraseFrontRelocatable( benchmark::State& state )
+	{
+		insert_erase_front<std::vector<ref_ptr>>( state );
+	}
+	BENCHMARK( BM_StdVectorInsertEraseFrontRelocatable )->Apply( size_setup );
+
+	// Growing the most recent arena allocation extends it in place instead of copying and abandoning the old storage
+	template <typename Vector>
+	void arena_push_back( benchmark::State& state )
+	{
+		const std::size_t count = static_cast<std::size_t>( state.range( 0 ) );
+		mclo::memory_arena arena( 1 << 20 );
+		for ( auto _ : state )
+		{
+			{
+				Vector vec( arena );
+				for ( std::size_t index = 0; index < count; ++index )
+				{
+					vec.push_back( static_cast<int>( index ) );
+				}
+				benchmark::DoNotOptimize( vec.data() );
+			}
+			arena.reset();
+		}
+		state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+	}
+
+	void BM_SmallVectorArenaPushBackInt( benchmark::State& state )
+	{
+		arena_push_back<mclo::small_vector<int,
+											mclo::small_vector_cache_line_capacity<int, mclo::arena_allocator<int>>,
+											mclo::arena_allocator<int>>>( state );
+	}
+	BENCHMARK( BM_SmallVectorArenaPushBackInt )->Apply( size_setup );
+
+	void BM_StdVectorArenaPushBackInt( benchmark::State& state )
+	{
+		arena_push_back<std::vector<int, mclo::arena_allocator<int>>>( state );
+	}
+	BENCHMARK( BM_StdVectorArenaPushBackInt )->Apply( size_setup );
+}
@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include "mclo/platform/cpu_features.hpp"
 #include "mclo/string/compare_ignore_case.hpp"
 #include "mclo/string/concatenate.hpp"
 
@@ -149,6 +150,42 @@ Maecenas a tellus congue, luctus nisi in, efficitur urna. Donec tellus massa, ph
 	}
 	BENCHMARK( BM_ToLowerSimd )->Apply( StringSimdRange );
 
+	// The SIMD kernels of one target, skipped if the CPU does not support it
+	template <mclo::simd_target Target, typename Func>
+	void run_simd_target( benchmark::State& state, Func func )
+	{
+		if ( !mclo::is_simd_target_supported( Target ) )
+		{
+			state.SkipWithError( "SIMD target not supported" );
+			return;
+		}
+		const mclo::simd_target previous = mclo::set_active_simd_target( Target );
+		func();
+		mclo::set_active_simd_target( previous );
+	}
+
+	template <mclo::simd_target Target>
+	void BM_CompareIgnoreCaseTarget_Same( benchmark::State& state )
+	{
+		run_simd_target<Target>( state, [ & ] { BM_CompareIgnoreCaseSimd_Same( state ); } );
+	}
+
+	template <mclo::simd_target Target>
+	void BM_ToUpperTarget( benchmark::State& state )
+	{
+		run_simd_target<Target>( state, [ & ] { BM_ToUpperSimd( state ); } );
+	}
+
+#define MCLO_STRING_TARGET_BENCHMARKS( TARGET )                                                                        \
+	BENCHMARK( BM_CompareIgnoreCaseTarget_Same<TARGET> )->Apply( StringSimdRange );                                    \
+	BENCHMARK( BM_ToUpperTarget<TARGET> )->Apply( StringSimdRange );
+
+	MCLO_STRING_TARGET_BENCHMARKS( mclo::simd_target::baseline )
+	MCLO_STRING_TARGET_BENCHMARKS( mclo::simd_target::avx2 )
+	MCLO_STRING_TARGET_BENCHMARKS( mclo::simd_target::avx512 )
+
+#undef MCLO_STRING_TARGET_BENCHMARKS
+
 	void BM_ConcatStringOperatorPlus( benchmark::State& state )
 	{
 		for ( auto _ : state )
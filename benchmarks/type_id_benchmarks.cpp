@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include "mclo/container/flat_type_id_set.hpp"
+#include "mclo/container/type_id_map.hpp"
+#include "mclo/container/type_id_set.hpp"
+
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+	template <int N>
+	struct component;
+
+	// Registers every even numbered component out of 64, so half the queried components are missing
+	template <typename Set, int... Ns>
+	void register_components( Set& set, std::integer_sequence<int, Ns...> )
+	{
+		( ( Ns % 2 == 0 ? (void)set.template insert<component<Ns>>() : (void)0 ), ... );
+	}
+
+	template <typename Set>
+	Set make_set()
+	{
+		Set set;
+		register_components( set, std::make_integer_sequence<int, 64>() );
+		return set;
+	}
+
+	// A dispatch loop checking whether systems' required components are all registered
+	template <typename Set>
+	void TypeIdSet_ContainsAll( benchmark::State& state )
+	{
+		const Set set = make_set<Set>();
+		for ( auto _ : state )
+		{
+			int matched = 0;
+			matched += set.template contains<component<2>, component<10>, component<30>, component<62>>();
+			matched += set.template contains<component<60>, component<4>, component<16>>();
+			matched += set.template contains<component<0>, component<8>, component<3>>();
+			matched += set.template contains<component<40>, component<20>, component<12>, component<6>>();
+			benchmark::DoNotOptimize( matched );
+		}
+		state.SetItemsProcessed( state.iterations() * 4 );
+	}
+	BENCHMARK( TypeIdSet_ContainsAll<mclo::type_id_set<>> );
+	BENCHMARK( TypeIdSet_ContainsAll<mclo::flat_type_id_set> );
+
+	template <typename Set>
+	void TypeIdSet_Contains( benchmark::State& state )
+	{
+		const Set set = make_set<Set>();
+		for ( auto _ : state )
+		{
+			int matched = 0;
+			matched += set.template contains<component<2>>();
+			matched += set.template contains<component<33>>();
+			matched += set.template contains<component<48>>();
+			matched += set.template contains<component<63>>();
+			benchmark::DoNotOptimize( matched );
+		}
+		state.SetItemsProcessed( state.iterations() * 4 );
+	}
+	BENCHMARK( TypeIdSet_Contains<mclo::type_id_set<>> );
+	BENCHMARK( TypeIdSet_Contains<mclo::flat_type_id_set> );
+
+	template <int... Ns>
+	mclo::type_id_map<int> make_map( std::integer_sequence<int, Ns...> )
+	{
+		mclo::type_id_map<int> map;
+		( map.try_emplace<component<Ns>>( Ns ), ... );
+		return map;
+	}
+
+	template <int... Ns>
+	std::unordered_map<mclo::meta::type_id_t, int> make_unordered_map( std::integer_sequence<int, Ns...> )
+	{
+		return { { mclo::meta::type_id<component<Ns>>, Ns }... };
+	}
+
+	void TypeIdMap_Find( benchmark::State& state )
+	{
+		const mclo::type_id_map<int> map = make_map( std::make_integer_sequence<int, 64>() );
+		for ( auto _ : state )
+		{
+			int sum = 0;
+			sum += *map.find<component<2>>();
+			sum += *map.find<component<33>>();
+			sum += *map.find<component<48>>();
+			sum += *map.find<component<63>>();
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * 4 );
+	}
+	BENCHMARK( TypeIdMap_Find );
+
+	void UnorderedMap_Find( benchmark::State& state )
+	{
+		const auto map = make_unordered_map( std::make_integer_sequence<int, 64>() );
+		for ( auto _ : state )
+		{
+			int sum = 0;
+			sum += map.find( mclo::meta::type_id<component<2>> )->second;
+			sum += map.find( mclo::meta::type_id<component<33>> )->second;
+			sum += map.find( mclo::meta::type_id<component<48>> )->second;
+			sum += map.find( mclo::meta::type_id<component<63>> )->second;
+			benchmark::DoNotOptimize( sum );
+		}
+		state.SetItemsProcessed( state.iterations() * 4 );
+	}
+	BENCHMARK( UnorderedMap_Find );
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mclo::detail
+{
+	// Bulk kernels for the scored algorithms, implemented with xsimd in the compiled library for each of the score
+	// types below. They compare with operator< so they match std::less, a NaN never compares better than anything and
+	// a NaN bound is never beaten, the same as the scalar loops.
+
+	template <typename T>
+	concept scored_simd_value = std::same_as<T, std::int32_t> || std::same_as<T, std::uint32_t> ||
+								std::same_as<T, std::int64_t> || std::same_as<T, std::uint64_t> ||
+								std::same_as<T, float> || std::same_as<T, double>;
+
+	// Returns the offset of the first element greater than threshold, or size if there is none
+	template <scored_simd_value T>
+	[[nodiscard]] std::size_t find_greater_simd( const T* data, std::size_t size, T threshold ) noexcept;
+
+	// Returns the offset of the first smallest element that is less than bound, or size if there is none
+	template <scored_simd_value T>
+	[[nodiscard]] std::size_t min_below_simd( const T* data, std::size_t size, T bound ) noexcept;
+
+	// Returns the offset of the first largest element that is greater than bound, or size if there is none
+	template <scored_simd_value T>
+	[[nodiscard]] std::size_t max_above_simd( const T* data, std::size_t size, T bound ) noexcept;
+
+	// min_below_simd and max_above_simd in a single pass
+	template <scored_simd_value T>
+	[[nodiscard]] std::pair<std::size_t, std::size_t> minmax_beyond_simd( const T* data,
+																		 std::size_t size,
+																		 T low_bound,
+																		 T high_bound ) noexcept;
+
+	template <typename Scorer, typename It>
+	using score_t = std::remove_cvref_t<std::invoke_result_t<Scorer&, std::iter_reference_t<It>>>;
+
+	/// @brief Ranges the kernels can handle, arithmetic scores of contiguous elements compared with std::less
+	template <typename It, typename Sentinel, typename Scorer, typename Compare>
+	concept scored_simd_range = std::contiguous_iterator<It> && std::sized_sentinel_for<Sentinel, It> &&
+								scored_simd_value<score_t<Scorer, It>> &&
+								( std::same_as<Compare, std::less<>> ||
+								  std::same_as<Compare, std::less<score_t<Scorer, It>>> );
+
+	/// @brief Scores are buffered this many at a time so the kernels can scan them
+	inline constexpr std::size_t scored_simd_block_size = 256;
+
+	/// @brief Invoke func( scores, offset, count ) on consecutive blocks of the scores of [first, first + size)
+	/// @details Elements are scored once each, in a loop separate from the comparisons so simple scorers vectorize.
+	/// Scoring with std::identity reads the elements in place as a single block.
+	template <std::contiguous_iterator It, typename Scorer, typename Func>
+	void for_each_score_block( const It first, const std::size_t size, Scorer& score, Func&& func )
+	{
+		if constexpr ( std::same_as<Scorer, std::identity> )
+		{
+			func( std::to_address( first ), std::size_t{ 0 }, size );
+		}
+		else
+		{
+			std::array<score_t<Scorer, It>, scored_simd_block_size> scores;
+			for ( std::size_t offset = 0; offset < size; offset += scored_simd_block_size )
+			{
+				const std::size_t count = std::min( size - offset, scored_simd_block_size );
+				const auto block = first + static_cast<std::iter_difference_t<It>>( offset );
+				for ( std::size_t index = 0; index < count; ++index )
+				{
+					scores[ index ] = std::invoke( score, block[ static_cast<std::iter_difference_t<It>>( index ) ] );
+				}
+				func( scores.data(), offset, count );
+			}
+		}
+	}
+}
@@ -1,13 +1,81 @@
 #pragma once
 
+#include "mclo/algorithm/detail/scored_simd.hpp"
+
 #include <concepts>
+#include <cstddef>
+#include <functional>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 
 namespace mclo
 {
+	namespace detail
+	{
+		/// @brief Offset of the first element with the smallest, or largest if Max, score of a non empty range
+		template <bool Max, std::contiguous_iterator It, typename Scorer>
+		[[nodiscard]] std::size_t extreme_scored_simd( const It first, const std::size_t size, Scorer& score )
+		{
+			using score_type = score_t<Scorer, It>;
+			std::size_t best = 0;
+			score_type best_score{};
+			for_each_score_block(
+				first, size, score, [ & ]( const score_type* scores, const std::size_t offset, std::size_t count ) {
+					// The first element is the best until beaten, even if it is a NaN that nothing can beat
+					if ( offset == 0 )
+					{
+						best_score = *scores++;
+						--count;
+					}
+					const std::size_t index =
+						Max ? max_above_simd( scores, count, best_score ) : min_below_simd( scores, count, best_score );
+					if ( index != count )
+					{
+						best = offset + ( offset == 0 ) + index;
+						best_score = scores[ index ];
+					}
+				} );
+			return best;
+		}
+
+		/// @brief Offsets of the first elements with the smallest and largest scores of a non empty range
+		template <std::contiguous_iterator It, typename Scorer>
+		[[nodiscard]] std::pair<std::size_t, std::size_t> minmax_scored_simd( const It first,
+																			 const std::size_t size,
+																			 Scorer& score )
+		{
+			using score_type = score_t<Scorer, It>;
+			std::pair<std::size_t, std::size_t> best{ 0, 0 };
+			score_type min_score{};
+			score_type max_score{};
+			for_each_score_block(
+				first, size, score, [ & ]( const score_type* scores, const std::size_t offset, std::size_t count ) {
+					if ( offset == 0 )
+					{
+						min_score = max_score = *scores++;
+						--count;
+					}
+					const auto [ min_index, max_index ] = minmax_beyond_simd( scores, count, min_score, max_score );
+					if ( min_index != count )
+					{
+						best.first = offset + ( offset == 0 ) + min_index;
+						min_score = scores[ min_index ];
+					}
+					if ( max_index != count )
+					{
+						best.second = offset + ( offset == 0 ) + max_index;
+						max_score = scores[ max_index ];
+					}
+				} );
+			return best;
+		}
+	}
+
 	/// @brief Finds the element with the smallest score, as produced by a scoring function.
 	/// @details Each element is scored once via @p score and the scores compared with @p compare.
+	/// At runtime contiguous ranges with arithmetic scores compared by std::less are scored a block at a time and
+	/// scanned with SIMD.
 	/// @tparam It Forward iterator type for the input range.
 	/// @tparam Sentinel Sentinel type for @p It.
 	/// @tparam Scorer Invocable mapping an element to a comparable score.
@@ -24,6 +92,16 @@ namespace mclo
 			  typename Compare = std::less<>>
 	[[nodiscard]] constexpr It min_scored( It first, Sentinel last, Scorer score, Compare compare = {} )
 	{
+		if constexpr ( detail::scored_simd_range<It, Sentinel, Scorer, Compare> )
+		{
+			if ( !std::is_constant_evaluated() && first != last )
+			{
+				const std::size_t offset =
+					detail::extreme_scored_simd<false>( first, static_cast<std::size_t>( last - first ), score );
+				return first + static_cast<std::iter_difference_t<It>>( offset );
+			}
+		}
+
 		if ( first == last )
 		{
 			return first;
@@ -49,6 +127,8 @@ namespace mclo
 
 	/// @brief Finds the element with the largest score, as produced by a scoring function.
 	/// @details Each element is scored once via @p score and the scores compared with @p compare.
+	/// At runtime contiguous ranges with arithmetic scores compared by std::less are scored a block at a time and
+	/// scanned with SIMD.
 	/// @tparam It Forward iterator type for the input range.
 	/// @tparam Sentinel Sentinel type for @p It.
 	/// @tparam Scorer Invocable mapping an element to a comparable score.
@@ -65,6 +145,16 @@ namespace mclo
 			  typename Compare = std::less<>>
 	[[nodiscard]] constexpr It max_scored( It first, Sentinel last, Scorer score, Compare compare = {} )
 	{
+		if constexpr ( detail::scored_simd_range<It, Sentinel, Scorer, Compare> )
+		{
+			if ( !std::is_constant_evaluated() && first != last )
+			{
+				const std::size_t offset =
+					detail::extreme_scored_simd<true>( first, static_cast<std::size_t>( last - first ), score );
+				return first + static_cast<std::iter_difference_t<It>>( offset );
+			}
+		}
+
 		if ( first == last )
 		{
 			return first;
@@ -90,6 +180,8 @@ namespace mclo
 
 	/// @brief Finds the elements with the smallest and largest scores in a single pass.
 	/// @details Each element is scored once via @p score and the scores compared with @p compare.
+	/// At runtime contiguous ranges with arithmetic scores compared by std::less are scored a block at a time and
+	/// scanned with SIMD.
 	/// @tparam It Forward iterator type for the input range.
 	/// @tparam Sentinel Sentinel type for @p It.
 	/// @tparam Scorer Invocable mapping an element to a comparable score.
@@ -109,6 +201,17 @@ namespace mclo
 															 Scorer score,
 															 Compare compare = {} )
 	{
+		if constexpr ( detail::scored_simd_range<It, Sentinel, Scorer, Compare> )
+		{
+			if ( !std::is_constant_evaluated() && first != last )
+			{
+				const auto size = static_cast<std::size_t>( last - first );
+				const auto [ min_offset, max_offset ] = detail::minmax_scored_simd( first, size, score );
+				return { first + static_cast<std::iter_difference_t<It>>( min_offset ),
+						 first + static_cast<std::iter_difference_t<It>>( max_offset ) };
+			}
+		}
+
 		if ( first == last )
 		{
 			return { first, first };
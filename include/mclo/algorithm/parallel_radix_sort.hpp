@@ -0,0 +1,152 @@
+#pragma once
+
+#include "mclo/algorithm/radix_sort.hpp"
+#include "mclo/threading/parallel_for.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace mclo
+{
+	namespace detail
+	{
+		/// @brief Minimum elements per task, below this thread start up and the serial prefix sum cost more than the
+		/// passes they split
+		inline constexpr std::size_t parallel_radix_sort_min_task_size = std::size_t{ 1 } << 16;
+
+		template <std::random_access_iterator It,
+				  std::random_access_iterator OutIt,
+				  std::indirectly_unary_invocable<It> KeyExtractor,
+				  bulk_executor Executor>
+		[[nodiscard]] radix_sort_result parallel_radix_sort_impl( const It first,
+																  const OutIt out,
+																  const std::size_t size,
+																  const std::size_t num_tasks,
+																  KeyExtractor& key_extractor,
+																  const Executor& executor )
+		{
+			using key_type = extracted_key_t<KeyExtractor, It>;
+			constexpr std::size_t key_bytes = sizeof( decltype( to_radix_key( std::declval<key_type>() ) ) );
+
+			// Every pass splits its source into the same contiguous chunks. Each task counts its chunk, then the
+			// counts are prefix summed bucket major and task minor so each task scatters into its own slice of every
+			// bucket, keeping the sort stable without synchronising the scatter
+			std::vector<std::array<std::size_t, 256>> counts( num_tasks );
+			const auto chunk_begin = [ & ]( const std::size_t task_index ) { return size * task_index / num_tasks; };
+
+			const auto run_pass = [ & ]( auto source, auto destination, const unsigned shift ) {
+				const auto bucket_of = [ & ]( const auto& value ) {
+					return ( to_radix_key( std::invoke( key_extractor, value ) ) >> shift ) & 0xFF;
+				};
+
+				executor.bulk_execute( num_tasks, [ & ]( const std::size_t task_index ) {
+					std::array<std::size_t, 256>& task_counts = counts[ task_index ];
+					task_counts.fill( 0 );
+					const auto chunk_end = source + chunk_begin( task_index + 1 );
+					for ( auto it = source + chunk_begin( task_index ); it != chunk_end; ++it )
+					{
+						++task_counts[ bucket_of( *it ) ];
+					}
+				} );
+
+				std::size_t total = 0;
+				bool trivial = false;
+				for ( std::size_t bucket = 0; bucket < 256; ++bucket )
+				{
+					const std::size_t bucket_start = total;
+					for ( std::array<std::size_t, 256>& task_counts : counts )
+					{
+						const std::size_t old_count = task_counts[ bucket ];
+						task_counts[ bucket ] = total;
+						total += old_count;
+					}
+					trivial |= total - bucket_start == size;
+				}
+
+				// Every key has the same digit so the scatter would leave the order unchanged
+				if ( trivial )
+				{
+					return false;
+				}
+
+				executor.bulk_execute( num_tasks, [ & ]( const std::size_t task_index ) {
+					std::array<std::size_t, 256>& offsets = counts[ task_index ];
+					const auto chunk_end = source + chunk_begin( task_index + 1 );
+					for ( auto it = source + chunk_begin( task_index ); it != chunk_end; ++it )
+					{
+						destination[ offsets[ bucket_of( *it ) ]++ ] = std::move( *it );
+					}
+				} );
+				return true;
+			};
+
+			// Same ping-pong between source and out as the serial sort, skipping passes that would not move anything
+			bool in_output = false;
+			for ( std::size_t byte_idx = 0; byte_idx < key_bytes; ++byte_idx )
+			{
+				const auto shift = static_cast<unsigned>( byte_idx * 8 );
+				if ( in_output ? run_pass( out, first, shift ) : run_pass( first, out, shift ) )
+				{
+					in_output = !in_output;
+				}
+			}
+
+			return in_output ? radix_sort_result::in_output : radix_sort_result::in_source;
+		}
+	}
+
+	/// @brief Sorts elements by key using an LSB radix sort split across the tasks of an executor.
+	/// @details Each pass splits the source into one contiguous chunk per task. Tasks build a histogram of their
+	/// chunk, the histograms are prefix summed across tasks on the calling thread, then each task scatters its chunk
+	/// into the slices of the output buckets reserved for it. Like @ref radix_sort the sort is stable, ping-pongs
+	/// between the source and output buffers, skips passes where every key has the same byte and returns which
+	/// buffer holds the sorted data.
+	/// @note Falls back to @ref radix_sort when the range is too small to give each task at least 64K elements, or
+	/// for boolean and string keys. Each pass reads the source twice, so the parallel sort is only a win with several
+	/// tasks.
+	/// @tparam It Random access iterator to the source range.
+	/// @tparam Sentinel Sentinel type for @p It.
+	/// @tparam OutIt Random access iterator to the destination range.
+	/// @tparam KeyExtractor Unary invocable that extracts a sortable key from each element, called concurrently.
+	/// @tparam Executor The @ref bulk_executor that runs the tasks.
+	/// @param first Iterator to the first element of the source range.
+	/// @param last Sentinel denoting the end of the source range.
+	/// @param out Iterator to the first element of the destination range.
+	/// @param key_extractor Functor that extracts the sort key from each element.
+	/// @param executor The executor to run tasks on, by default a thread per hardware thread.
+	/// @return @ref radix_sort_result::in_output if the sorted data is in the output range,
+	/// @ref radix_sort_result::in_source if it remains in the source range.
+	/// @pre The destination range must be at least as large as the source range.
+	/// @pre The source and destination ranges must not overlap.
+	/// @warning The source range is modified regardless of the returned result.
+	template <std::random_access_iterator It,
+			  std::sentinel_for<It> Sentinel,
+			  std::random_access_iterator OutIt,
+			  std::indirectly_unary_invocable<It> KeyExtractor = std::identity,
+			  bulk_executor Executor = thread_executor>
+	[[nodiscard]] radix_sort_result parallel_radix_sort(
+		It first, Sentinel last, OutIt out, KeyExtractor key_extractor = {}, const Executor& executor = {} )
+	{
+		using key_type = detail::extracted_key_t<KeyExtractor, It>;
+
+		const auto size = static_cast<std::size_t>( last - first );
+		const std::size_t num_tasks =
+			std::min<std::size_t>( executor.concurrency(), size / detail::parallel_radix_sort_min_task_size );
+		if constexpr ( std::same_as<key_type, bool> || detail::radix_string_key<key_type> )
+		{
+			return radix_sort( first, last, out, key_extractor );
+		}
+		else
+		{
+			if ( num_tasks <= 1 )
+			{
+				return radix_sort( first, last, out, key_extractor );
+			}
+			return detail::parallel_radix_sort_impl( first, out, size, num_tasks, key_extractor, executor );
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "mclo/algorithm/top_k_scored.hpp"
+#include "mclo/threading/parallel_for.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace mclo
+{
+	namespace detail
+	{
+		/// @brief Minimum elements per task, below this starting a task costs more than scanning its chunk
+		inline constexpr std::size_t parallel_top_k_min_task_size = std::size_t{ 1 } << 15;
+	}
+
+	/// @brief Finds the k elements with the largest scores, splitting the range across the tasks of an executor.
+	/// @details Each task finds the best k of its own contiguous chunk as @ref top_k_scored does, then the calling
+	/// thread merges the per task results into the best k overall. The result is the same as @ref top_k_scored,
+	/// including which elements win ties. Ranges too small to give every task
+	/// @ref detail::parallel_top_k_min_task_size elements use fewer tasks, down to running serially.
+	/// @tparam It Random access iterator type for the input range.
+	/// @tparam Sentinel Sized sentinel type for @p It.
+	/// @tparam OutIt Output iterator type for iterators of the input range.
+	/// @tparam Scorer Invocable mapping an element to a comparable score.
+	/// @tparam Compare Binary predicate establishing a strict ordering of scores.
+	/// @tparam Executor The @ref bulk_executor that runs the tasks.
+	/// @param first Iterator to the first element of the range.
+	/// @param last Sentinel denoting the end of the range.
+	/// @param k The maximum number of elements to find.
+	/// @param out Where to write iterators to the found elements, highest-scored first.
+	/// @param score Functor producing the score for each element, called concurrently from every task.
+	/// @param compare Comparator returning true when the first score orders before the second, copied per task.
+	/// @param executor The executor to run tasks on, by default a thread per hardware thread.
+	/// @return Iterator past the last iterator written, min( k, size ) are written.
+	template <std::random_access_iterator It,
+			  std::sized_sentinel_for<It> Sentinel,
+			  std::weakly_incrementable OutIt,
+			  std::invocable<std::iter_reference_t<It>> Scorer,
+			  typename Compare = std::less<>,
+			  bulk_executor Executor = thread_executor>
+		requires std::indirectly_writable<OutIt, It>
+	OutIt parallel_top_k_scored( It first,
+								 Sentinel last,
+								 const std::size_t k,
+								 OutIt out,
+								 Scorer score,
+								 Compare compare = {},
+								 const Executor& executor = {} )
+	{
+		const auto size = static_cast<std::size_t>( last - first );
+		const std::size_t num_tasks =
+			std::min<std::size_t>( executor.concurrency(), size / detail::parallel_top_k_min_task_size );
+		if ( num_tasks <= 1 || k == 0 )
+		{
+			return top_k_scored( first, last, k, out, score, compare );
+		}
+
+		using heap_type = detail::top_k_heap<detail::score_t<Scorer, It>, It, Compare>;
+		std::vector<heap_type> task_heaps( num_tasks, heap_type( k, compare ) );
+		executor.bulk_execute( num_tasks, [ & ]( const std::size_t task_index ) {
+			const std::size_t begin = size * task_index / num_tasks;
+			const std::size_t end = size * ( task_index + 1 ) / num_tasks;
+			const It chunk_first = first + static_cast<std::iter_difference_t<It>>( begin );
+			const It chunk_last = first + static_cast<std::iter_difference_t<It>>( end );
+			detail::top_k_scored_into<It, It, Scorer, Compare>(
+				chunk_first, chunk_last, begin, score, task_heaps[ task_index ] );
+		} );
+
+		// Candidates carry their position in the whole range, so ties resolve the same as a serial scan
+		heap_type merged( k, compare );
+		merged.reserve( size );
+		for ( heap_type& task_heap : task_heaps )
+		{
+			for ( auto& candidate : task_heap.candidates() )
+			{
+				merged.merge( std::move( candidate ) );
+			}
+		}
+		return merged.write_sorted( std::move( out ) );
+	}
+}
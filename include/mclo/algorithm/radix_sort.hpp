@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <climits>
@@ -8,8 +9,13 @@
 #include <functional>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace mclo
 {
@@ -115,7 +121,39 @@ namespace mclo
 			}
 		}
 
+		template <typename KeyExtractor, typename It>
+		using radix_key_t = decltype( to_radix_key( std::declval<extracted_key_t<KeyExtractor, It>>() ) );
+
+		/// @brief Digit histograms for every pass, on the stack for byte digits and on the heap for wider digits whose
+		/// histograms are too large for small thread stacks
+		template <typename CountT, std::size_t NumBuckets, std::size_t NumPasses>
+		[[nodiscard]] auto make_radix_histograms()
+		{
+			if constexpr ( NumBuckets <= 256 )
+			{
+				return std::array<std::array<CountT, NumBuckets>, NumPasses>{};
+			}
+			else
+			{
+				return std::make_unique<std::array<CountT, NumBuckets>[]>( NumPasses );
+			}
+		}
+
+		template <typename SourceIt, typename DestIt, typename CountT, std::size_t NumBuckets, typename DigitOf>
+		void radix_scatter( SourceIt source,
+							const SourceIt source_end,
+							const DestIt destination,
+							std::array<CountT, NumBuckets>& offsets,
+							DigitOf digit_of )
+		{
+			for ( ; source != source_end; ++source )
+			{
+				destination[ offsets[ digit_of( *source ) ]++ ] = std::move( *source );
+			}
+		}
+
 		template <std::unsigned_integral CountT,
+				  std::size_t DigitBits,
 				  std::random_access_iterator It,
 				  std::sentinel_for<It> Sentinel,
 				  std::random_access_iterator OutIt,
@@ -125,28 +163,44 @@ namespace mclo
 														 OutIt out,
 														 KeyExtractor key_extractor )
 		{
-			using key_type = extracted_key_t<KeyExtractor, It>;
-			constexpr std::size_t key_bytes = sizeof( decltype( to_radix_key( std::declval<key_type>() ) ) );
+			using value_type = std::iter_value_t<It>;
+			using radix_key_type = radix_key_t<KeyExtractor, It>;
+			constexpr std::size_t key_bits = sizeof( radix_key_type ) * CHAR_BIT;
+			constexpr std::size_t num_passes = ( key_bits + DigitBits - 1 ) / DigitBits;
+			constexpr std::size_t num_buckets = std::size_t{ 1 } << DigitBits;
+			constexpr radix_key_type digit_mask = static_cast<radix_key_type>( num_buckets - 1 );
 
 			const auto size = last - first;
+			if ( size == 0 )
+			{
+				return radix_sort_result::in_source;
+			}
 
-			// Build all byte-level histograms in a single pass
-			std::array<std::array<CountT, 256>, key_bytes> counts{};
+			// Build the histograms of every digit in a single pass
+			auto counts = make_radix_histograms<CountT, num_buckets, num_passes>();
 			for ( It it = first; it != last; ++it )
 			{
 				auto key = to_radix_key( std::invoke( key_extractor, *it ) );
-				for ( std::size_t byte_idx = 0; byte_idx < key_bytes; ++byte_idx )
+				for ( std::size_t pass = 0; pass < num_passes; ++pass )
 				{
-					++counts[ byte_idx ][ key & 0xFF ];
-					key >>= 8;
+					++counts[ pass ][ key & digit_mask ];
+					key = static_cast<radix_key_type>( key >> DigitBits );
 				}
 			}
 
-			// Convert each histogram to prefix sums
-			for ( auto& byte_counts : counts )
+			// A pass where every key has the same digit would move every value to where it already is, such as the
+			// high digits of small integers, so skip it
+			std::array<bool, num_passes> trivial_pass{};
+			const radix_key_type first_key = to_radix_key( std::invoke( key_extractor, *first ) );
+			for ( std::size_t pass = 0; pass < num_passes; ++pass )
 			{
+				auto& pass_counts = counts[ pass ];
+				trivial_pass[ pass ] =
+					pass_counts[ ( first_key >> ( pass * DigitBits ) ) & digit_mask ] == static_cast<CountT>( size );
+
+				// Convert the histogram to prefix sums
 				CountT total = 0;
-				for ( CountT& c : byte_counts )
+				for ( CountT& c : pass_counts )
 				{
 					const CountT old_count = c;
 					c = total;
@@ -154,41 +208,183 @@ namespace mclo
 				}
 			}
 
-			// Scatter passes, LSB first, ping-ponging between source and out
-			// Even passes: [first, last) -> [out, out + size)
-			// Odd passes:  [out, out + size) -> [first, last)
-			for ( std::size_t byte_idx = 0; byte_idx < key_bytes; ++byte_idx )
-			{
-				auto& byte_counts = counts[ byte_idx ];
-				const auto shift = static_cast<unsigned>( byte_idx * 8 );
+			// Scatter passes, least significant digit first, ping-ponging between source and out
+			const auto scatter = [ & ]( const auto source, const auto destination, const std::size_t pass ) {
+				const auto shift = static_cast<unsigned>( pass * DigitBits );
+				const auto digit_of = [ & ]( const value_type& value ) {
+					return ( to_radix_key( std::invoke( key_extractor, value ) ) >> shift ) & digit_mask;
+				};
+				radix_scatter( source, source + size, destination, counts[ pass ], digit_of );
+			};
 
-				if ( ( byte_idx & 1 ) == 0 )
+			bool in_output = false;
+			for ( std::size_t pass = 0; pass < num_passes; ++pass )
+			{
+				if ( trivial_pass[ pass ] )
 				{
-					for ( auto it = first; it != last; ++it )
-					{
-						const auto key = to_radix_key( std::invoke( key_extractor, *it ) );
-						const auto bucket = ( key >> shift ) & 0xFF;
-						out[ byte_counts[ bucket ]++ ] = std::move( *it );
-					}
+					continue;
+				}
+				if ( in_output )
+				{
+					scatter( out, first, pass );
 				}
 				else
 				{
-					for ( auto it = out; it != out + size; ++it )
-					{
-						const auto key = to_radix_key( std::invoke( key_extractor, *it ) );
-						const auto bucket = ( key >> shift ) & 0xFF;
-						first[ byte_counts[ bucket ]++ ] = std::move( *it );
-					}
+					scatter( first, out, pass );
+				}
+				in_output = !in_output;
+			}
+
+			return in_output ? radix_sort_result::in_output : radix_sort_result::in_source;
+		}
+
+		/// @brief Inputs at least this large sort 64-bit keys with 11-bit digits, six passes instead of eight, once the
+		/// 2048 bucket histograms are cheap next to the passes they save. Smaller keys save at most one pass, which
+		/// does not pay for scattering to eight times as many buckets
+		inline constexpr std::size_t radix_sort_wide_digit_threshold = std::size_t{ 1 } << 15;
+
+		template <std::unsigned_integral CountT,
+				  std::random_access_iterator It,
+				  std::sentinel_for<It> Sentinel,
+				  std::random_access_iterator OutIt,
+				  std::indirectly_unary_invocable<It> KeyExtractor>
+		[[nodiscard]] radix_sort_result radix_sort_adaptive( It first,
+															 Sentinel last,
+															 OutIt out,
+															 KeyExtractor key_extractor )
+		{
+			const auto size = static_cast<std::size_t>( last - first );
+			// Inputs below the threshold use 8-bit counts, so only instantiate wide digits where reachable
+			if constexpr ( sizeof( radix_key_t<KeyExtractor, It> ) >= 8 && sizeof( CountT ) >= 2 )
+			{
+				if ( size >= radix_sort_wide_digit_threshold )
+				{
+					return radix_sort_impl<CountT, 11>( first, last, out, key_extractor );
 				}
 			}
+			return radix_sort_impl<CountT, 8>( first, last, out, key_extractor );
+		}
 
-			if constexpr ( key_bytes % 2 == 0 )
+		/// @brief Keys sorted byte by byte with an MSD radix sort instead of mapped with @c to_radix_key
+		template <typename Key>
+		concept radix_string_key = std::convertible_to<const Key&, std::string_view>;
+
+		/// @brief String buckets at most this large are finished with an insertion sort, below this counting and
+		/// scattering 257 buckets costs more than comparing the keys
+		inline constexpr std::size_t radix_string_insertion_threshold = 32;
+
+		/// @brief Stable insertion sort of values whose keys all share their first depth bytes
+		template <std::random_access_iterator It, typename KeyExtractor>
+		void radix_string_insertion_sort( const It first,
+										  const std::size_t size,
+										  const std::size_t depth,
+										  KeyExtractor& key_extractor )
+		{
+			const auto suffix_less = [ & ]( const auto& lhs, const auto& rhs ) {
+				const auto& lhs_key = std::invoke( key_extractor, lhs );
+				const auto& rhs_key = std::invoke( key_extractor, rhs );
+				return std::string_view( lhs_key ).substr( depth ) < std::string_view( rhs_key ).substr( depth );
+			};
+
+			for ( std::size_t index = 1; index < size; ++index )
 			{
-				return radix_sort_result::in_source;
+				if ( !suffix_less( first[ index ], first[ index - 1 ] ) )
+				{
+					continue;
+				}
+				std::iter_value_t<It> value = std::move( first[ index ] );
+				std::size_t position = index;
+				do
+				{
+					first[ position ] = std::move( first[ position - 1 ] );
+					--position;
+				}
+				while ( position > 0 && suffix_less( value, first[ position - 1 ] ) );
+				first[ position ] = std::move( value );
 			}
-			else
+		}
+
+		/// @brief Stable MSD radix sort of values by a string key, one byte per level
+		/// @details Each bucket is scattered into out and moved back, so the sorted values end up in the source.
+		template <std::random_access_iterator It, std::random_access_iterator OutIt, typename KeyExtractor>
+		void msd_string_radix_sort( const It first,
+									const std::size_t size,
+									const OutIt out,
+									KeyExtractor& key_extractor )
+		{
+			// Digit 0 is for keys that end before the byte, so shorter keys sort before longer ones they prefix
+			constexpr std::size_t num_buckets = 257;
+			const auto digit_of = [ & ]( const auto& value, const std::size_t depth ) -> std::size_t {
+				const auto& key = std::invoke( key_extractor, value );
+				const std::string_view view( key );
+				return depth < view.size() ? static_cast<unsigned char>( view[ depth ] ) + std::size_t{ 1 } : 0;
+			};
+
+			struct bucket
+			{
+				std::size_t begin;
+				std::size_t size;
+				std::size_t depth;
+			};
+
+			// Pending buckets are kept on the heap, recursing per byte of a long shared prefix could overflow the stack
+			std::vector<bucket> pending;
+			pending.push_back( { 0, size, 0 } );
+			std::array<std::size_t, num_buckets> counts;
+			while ( !pending.empty() )
 			{
-				return radix_sort_result::in_output;
+				const auto [ begin, count, depth ] = pending.back();
+				pending.pop_back();
+				const It bucket_first = first + begin;
+				if ( count <= radix_string_insertion_threshold )
+				{
+					radix_string_insertion_sort( bucket_first, count, depth, key_extractor );
+					continue;
+				}
+
+				counts.fill( 0 );
+				for ( std::size_t index = 0; index < count; ++index )
+				{
+					++counts[ digit_of( bucket_first[ index ], depth ) ];
+				}
+
+				// Every key shares this byte, move straight on to the next one
+				const std::size_t first_digit = digit_of( *bucket_first, depth );
+				if ( counts[ first_digit ] == count )
+				{
+					if ( first_digit != 0 )
+					{
+						pending.push_back( { begin, count, depth + 1 } );
+					}
+					continue;
+				}
+
+				std::size_t total = 0;
+				for ( std::size_t& c : counts )
+				{
+					const std::size_t old_count = c;
+					c = total;
+					total += old_count;
+				}
+
+				const OutIt bucket_out = out + begin;
+				for ( std::size_t index = 0; index < count; ++index )
+				{
+					bucket_out[ counts[ digit_of( bucket_first[ index ], depth ) ]++ ] =
+						std::move( bucket_first[ index ] );
+				}
+				std::move( bucket_out, bucket_out + count, bucket_first );
+
+				// Each count is now the end of its bucket and so the start of the next, keys in bucket 0 are equal
+				for ( std::size_t digit = 1; digit < num_buckets; ++digit )
+				{
+					const std::size_t bucket_begin = counts[ digit - 1 ];
+					const std::size_t bucket_size = counts[ digit ] - bucket_begin;
+					if ( bucket_size > 1 )
+					{
+						pending.push_back( { begin + bucket_begin, bucket_size, depth + 1 } );
+					}
+				}
 			}
 		}
 	}
@@ -262,13 +458,23 @@ namespace mclo
 	}
 
 	/// @brief Sorts elements by key using an LSB radix sort.
-	/// @details Performs a least-significant-byte-first radix sort, scattering elements between
+	/// @details Performs a least-significant-digit-first radix sort, scattering elements between
 	/// the source and output buffers on alternating passes. For 1-byte keys this delegates to
 	/// @ref counting_sort. The returned @ref radix_sort_result indicates which buffer holds the
-	/// sorted data after the final pass.
+	/// sorted data after the final pass, which depends on the keys as well as their type.
+	///
+	/// Keys convertible to @c std::string_view, such as strings, are instead sorted bytewise
+	/// with an MSD radix sort that finishes small buckets with an insertion sort, using the
+	/// output range as scratch space and leaving the sorted data in the source range.
+	///
+	/// Digits are a byte, or 11 bits for 64-bit keys once there are enough elements to amortize
+	/// the larger histograms. Passes where every key has the same digit, such as the high bytes
+	/// of small integers, are skipped.
 	/// @note Profile before committing to this over a comparison sort. Performance relative
 	/// to std::sort improves with smaller element types, smaller key types, and larger ranges.
-	/// The number of scatter passes scales linearly with the key size in bytes.
+	/// The number of scatter passes scales linearly with the key size. The key is extracted
+	/// again on every pass, use @ref radix_sort_by_cached_key when that is expensive or the
+	/// elements are expensive to move.
 	/// @tparam It Random access iterator to the source range.
 	/// @tparam Sentinel Sentinel type for @p It.
 	/// @tparam OutIt Random access iterator to the destination range.
@@ -290,7 +496,12 @@ namespace mclo
 	{
 		using key_type = detail::extracted_key_t<KeyExtractor, It>;
 
-		if constexpr ( sizeof( key_type ) == 1 )
+		if constexpr ( detail::radix_string_key<key_type> )
+		{
+			detail::msd_string_radix_sort( first, static_cast<std::size_t>( last - first ), out, key_extractor );
+			return radix_sort_result::in_source;
+		}
+		else if constexpr ( sizeof( key_type ) == 1 )
 		{
 			counting_sort( first, last, out, key_extractor );
 			return radix_sort_result::in_output;
@@ -301,20 +512,406 @@ namespace mclo
 
 			if ( size <= std::numeric_limits<std::uint8_t>::max() )
 			{
-				return detail::radix_sort_impl<std::uint8_t>( first, last, out, key_extractor );
+				return detail::radix_sort_adaptive<std::uint8_t>( first, last, out, key_extractor );
 			}
 			else if ( size <= std::numeric_limits<std::uint16_t>::max() )
 			{
-				return detail::radix_sort_impl<std::uint16_t>( first, last, out, key_extractor );
+				return detail::radix_sort_adaptive<std::uint16_t>( first, last, out, key_extractor );
 			}
 			else if ( size <= std::numeric_limits<std::uint32_t>::max() )
 			{
-				return detail::radix_sort_impl<std::uint32_t>( first, last, out, key_extractor );
+				return detail::radix_sort_adaptive<std::uint32_t>( first, last, out, key_extractor );
+			}
+			else
+			{
+				return detail::radix_sort_adaptive<std::uint64_t>( first, last, out, key_extractor );
+			}
+		}
+	}
+
+	/// @brief Sorts elements lexicographically by several keys, one radix sort per key.
+	/// @details Sorts stably by each key from the last to the first, so elements are ordered by the first key, ties
+	/// by the second and so on. Each key can be any key @ref radix_sort accepts, such as a tenant id then a
+	/// timestamp, and passes that would not reorder anything are skipped as usual.
+	/// @tparam It Random access iterator to the source range.
+	/// @tparam Sentinel Sentinel type for @p It.
+	/// @tparam OutIt Random access iterator to the destination range.
+	/// @tparam KeyExtractors Unary invocables that each extract a sortable key from an element, most significant
+	/// first.
+	/// @param first Iterator to the first element of the source range.
+	/// @param last Sentinel denoting the end of the source range.
+	/// @param out Iterator to the first element of the destination range.
+	/// @param key_extractors The key extractors, most significant first.
+	/// @return @ref radix_sort_result::in_output if the sorted data is in the output range,
+	/// @ref radix_sort_result::in_source if it remains in the source range.
+	/// @pre The destination range must be at least as large as the source range.
+	/// @pre The source and destination ranges must not overlap.
+	/// @warning The source range is modified regardless of the returned result.
+	template <std::random_access_iterator It,
+			  std::sentinel_for<It> Sentinel,
+			  std::random_access_iterator OutIt,
+			  std::indirectly_unary_invocable<It>... KeyExtractors>
+	[[nodiscard]] radix_sort_result radix_sort( It first,
+												Sentinel last,
+												OutIt out,
+												const std::tuple<KeyExtractors...>& key_extractors )
+	{
+		const auto size = last - first;
+		bool in_output = false;
+		const auto sort_by = [ & ]( const auto& key_extractor ) {
+			if ( in_output )
+			{
+				in_output = radix_sort( out, out + size, first, key_extractor ) == radix_sort_result::in_source;
 			}
 			else
 			{
-				return detail::radix_sort_impl<std::uint64_t>( first, last, out, key_extractor );
+				in_output = radix_sort( first, last, out, key_extractor ) == radix_sort_result::in_output;
 			}
+		};
+		[ & ]<std::size_t... Indices>( std::index_sequence<Indices...> ) {
+			( sort_by( std::get<sizeof...( KeyExtractors ) - 1 - Indices>( key_extractors ) ), ... );
+		}( std::index_sequence_for<KeyExtractors...>{} );
+		return in_output ? radix_sort_result::in_output : radix_sort_result::in_source;
+	}
+
+	namespace detail
+	{
+		template <typename RadixKey, typename IndexT>
+		struct radix_keyed_index
+		{
+			RadixKey key;
+			IndexT index;
+		};
+
+		/// @brief Extract every key once and radix sort them paired with the index of their element
+		template <typename IndexT, std::random_access_iterator It, typename KeyExtractor>
+		[[nodiscard]] std::vector<radix_keyed_index<radix_key_t<KeyExtractor, It>, IndexT>> radix_sort_keyed_indices(
+			const It first, const std::size_t size, KeyExtractor& key_extractor )
+		{
+			using keyed_index = radix_keyed_index<radix_key_t<KeyExtractor, It>, IndexT>;
+			std::vector<keyed_index> keys( size );
+			for ( std::size_t index = 0; index < size; ++index )
+			{
+				keys[ index ] = { to_radix_key( std::invoke( key_extractor, first[ index ] ) ),
+								  static_cast<IndexT>( index ) };
+			}
+
+			std::vector<keyed_index> buffer( size );
+			if ( radix_sort( keys.begin(), keys.end(), buffer.begin(), &keyed_index::key ) ==
+				 radix_sort_result::in_output )
+			{
+				return buffer;
+			}
+			return keys;
+		}
+
+		/// @brief Extracts the key of the element at an index, to sort indices by the keys of their elements
+		template <typename It, typename KeyExtractor>
+		struct indexed_key_extractor
+		{
+			It first;
+			KeyExtractor key_extractor;
+
+			[[nodiscard]] decltype( auto ) operator()( const std::size_t index ) const
+			{
+				return std::invoke( key_extractor, first[ index ] );
+			}
+		};
+
+		/// @brief Sort the indices [0, size) by key with index key extractors that look up the element they refer to
+		template <std::random_access_iterator IndexIt, typename KeyExtractors>
+		void radix_argsort_indirect( const std::size_t size,
+									 const IndexIt indices,
+									 const KeyExtractors& index_key_extractors )
+		{
+			using index_type = std::iter_value_t<IndexIt>;
+			std::iota( indices, indices + size, index_type{ 0 } );
+			std::vector<index_type> buffer( size );
+			if ( radix_sort( indices, indices + size, buffer.begin(), index_key_extractors ) ==
+				 radix_sort_result::in_output )
+			{
+				std::copy( buffer.begin(), buffer.end(), indices );
+			}
+		}
+	}
+
+	/// @brief Computes the permutation that stably sorts elements by key, leaving the elements untouched.
+	/// @details Writes indices such that @c first[ indices[ 0 ] ], @c first[ indices[ 1 ] ], ... are sorted by key.
+	/// Keys with a @c to_radix_key mapping are extracted once into (key, index) pairs which are radix sorted, other
+	/// keys such as strings sort the indices by the key of the element they refer to. Allocates buffers for the
+	/// sort.
+	/// @tparam It Random access iterator to the source range.
+	/// @tparam Sentinel Sentinel type for @p It.
+	/// @tparam IndexIt Random access iterator to the destination range of integral indices.
+	/// @tparam KeyExtractor Unary invocable that extracts a sortable key from each element.
+	/// @param first Iterator to the first element of the source range.
+	/// @param last Sentinel denoting the end of the source range.
+	/// @param indices Iterator to the first element of the destination range for the indices.
+	/// @param key_extractor Functor that extracts the sort key from each element.
+	/// @pre The destination range must be at least as large as the source range.
+	/// @pre The index type must be able to represent the size of the source range.
+	template <std::random_access_iterator It,
+			  std::sentinel_for<It> Sentinel,
+			  std::random_access_iterator IndexIt,
+			  std::indirectly_unary_invocable<It> KeyExtractor = std::identity>
+		requires std::integral<std::iter_value_t<IndexIt>>
+	void radix_argsort( It first, Sentinel last, IndexIt indices, KeyExtractor key_extractor = {} )
+	{
+		using key_type = detail::extracted_key_t<KeyExtractor, It>;
+		using index_type = std::iter_value_t<IndexIt>;
+
+		const auto size = static_cast<std::size_t>( last - first );
+		if constexpr ( sizeof( key_type ) > 1 && !detail::radix_string_key<key_type> )
+		{
+			for ( const auto& key : detail::radix_sort_keyed_indices<index_type>( first, size, key_extractor ) )
+			{
+				*indices++ = key.index;
+			}
+		}
+		else
+		{
+			detail::radix_argsort_indirect(
+				size, indices, detail::indexed_key_extractor<It, KeyExtractor>{ first, key_extractor } );
+		}
+	}
+
+	/// @brief Computes the permutation that stably sorts elements lexicographically by several keys.
+	/// @details As @ref radix_argsort with the keys of the tuple overload of @ref radix_sort, sorting the indices by
+	/// the keys of the elements they refer to.
+	/// @tparam It Random access iterator to the source range.
+	/// @tparam Sentinel Sentinel type for @p It.
+	/// @tparam IndexIt Random access iterator to the destination range of integral indices.
+	/// @tparam KeyExtractors Unary invocables that each extract a sortable key from an element, most significant
+	/// first.
+	/// @param first Iterator to the first element of the source range.
+	/// @param last Sentinel denoting the end of the source range.
+	/// @param indices Iterator to the first element of the destination range for the indices.
+	/// @param key_extractors The key extractors, most significant first.
+	/// @pre The destination range must be at least as large as the source range.
+	/// @pre The index type must be able to represent the size of the source range.
+	template <std::random_access_iterator It,
+			  std::sentinel_for<It> Sentinel,
+			  std::random_access_iterator IndexIt,
+			  std::indirectly_unary_invocable<It>... KeyExtractors>
+		requires std::integral<std::iter_value_t<IndexIt>>
+	void radix_argsort( It first, Sentinel last, IndexIt indices, const std::tuple<KeyExtractors...>& key_extractors )
+	{
+		const auto index_key_extractors = std::apply(
+			[ & ]( const KeyExtractors&... key_extractor ) {
+				return std::tuple( detail::indexed_key_extractor<It, KeyExtractors>{ first, key_extractor }... );
+			},
+			key_extractors );
+		detail::radix_argsort_indirect( static_cast<std::size_t>( last - first ), indices, index_key_extractors );
+	}
+
+	/// @brief Sorts elements by key using an LSB radix sort of their keys, moving each element only once.
+	/// @details Extracts each key once into an array of (key, index) pairs, radix sorts the pairs then moves every
+	/// element to its sorted position in the output range. Worth it over @ref radix_sort when the key extractor is
+	/// expensive, such as when it follows a pointer, or when elements are large or expensive to move, as
+	/// @ref radix_sort extracts every key and moves every element once per pass. Allocates the pairs and a buffer
+	/// for sorting them. For 1-byte and boolean keys this is @ref radix_sort, whose counting sort has only one pass,
+	/// and string keys are sorted through @ref radix_argsort.
+	/// @tparam It Random access iterator to the source range.
+	/// @tparam Sentinel Sentinel type for @p It.
+	/// @tparam OutIt Random access iterator to the destination range.
+	/// @tparam KeyExtractor Unary invocable that extracts a sortable key from each element.
+	/// @param first Iterator to the first element of the source range.
+	/// @param last Sentinel denoting the end of the source range.
+	/// @param out Iterator to the first element of the destination range.
+	/// @param key_extractor Functor that extracts the sort key from each element, called once per element.
+	/// @return Always @ref radix_sort_result::in_output, returned so this can replace @ref radix_sort.
+	/// @pre The destination range must be at least as large as the source range.
+	/// @pre The source and destination ranges must not overlap.
+	/// @warning The source range is left with moved from elements.
+	template <std::random_access_iterator It,
+			  std::sentinel_for<It> Sentinel,
+			  std::random_access_iterator OutIt,
+			  std::indirectly_unary_invocable<It> KeyExtractor = std::identity>
+	[[nodiscard]] radix_sort_result radix_sort_by_cached_key( It first,
+															  Sentinel last,
+															  OutIt out,
+															  KeyExtractor key_extractor = {} )
+	{
+		using key_type = detail::extracted_key_t<KeyExtractor, It>;
+
+		if constexpr ( sizeof( key_type ) == 1 )
+		{
+			counting_sort( first, last, out, key_extractor );
+		}
+		else if constexpr ( detail::radix_string_key<key_type> )
+		{
+			std::vector<std::size_t> order( static_cast<std::size_t>( last - first ) );
+			radix_argsort( first, last, order.begin(), key_extractor );
+			for ( const std::size_t index : order )
+			{
+				*out++ = std::move( first[ index ] );
+			}
+		}
+		else
+		{
+			const auto size = static_cast<std::size_t>( last - first );
+			const auto move_sorted = [ & ]( const auto& sorted ) {
+				for ( const auto& key : sorted )
+				{
+					*out++ = std::move( first[ key.index ] );
+				}
+			};
+			if ( size <= std::numeric_limits<std::uint32_t>::max() )
+			{
+				move_sorted( detail::radix_sort_keyed_indices<std::uint32_t>( first, size, key_extractor ) );
+			}
+			else
+			{
+				move_sorted( detail::radix_sort_keyed_indices<std::uint64_t>( first, size, key_extractor ) );
+			}
+		}
+		return radix_sort_result::in_output;
+	}
+
+	namespace detail
+	{
+		/// @brief In place partitions at most this large are finished with an insertion sort, below this counting
+		/// 256 buckets costs more than comparing the keys
+		inline constexpr std::size_t radix_in_place_insertion_threshold = 64;
+
+		template <std::random_access_iterator It, typename RadixKeyOf>
+		void radix_insertion_sort( const It first, const std::size_t size, RadixKeyOf& radix_key_of )
+		{
+			for ( std::size_t index = 1; index < size; ++index )
+			{
+				const auto key = radix_key_of( first[ index ] );
+				if ( !( key < radix_key_of( first[ index - 1 ] ) ) )
+				{
+					continue;
+				}
+				std::iter_value_t<It> value = std::move( first[ index ] );
+				std::size_t position = index;
+				do
+				{
+					first[ position ] = std::move( first[ position - 1 ] );
+					--position;
+				}
+				while ( position > 0 && key < radix_key_of( first[ position - 1 ] ) );
+				first[ position ] = std::move( value );
+			}
+		}
+
+		/// @brief American flag sort of [first, first + size) by the byte at shift and then every lower byte
+		template <std::random_access_iterator It, typename RadixKeyOf>
+		void american_flag_sort( const It first, const std::size_t size, unsigned shift, RadixKeyOf& radix_key_of )
+		{
+			const auto digit_of = [ & ]( const auto& value ) {
+				return static_cast<std::size_t>( ( radix_key_of( value ) >> shift ) & 0xFF );
+			};
+
+			std::array<std::size_t, 256> heads;
+			std::array<std::size_t, 256> tails;
+			for ( ;; )
+			{
+				if ( size <= radix_in_place_insertion_threshold )
+				{
+					radix_insertion_sort( first, size, radix_key_of );
+					return;
+				}
+
+				heads.fill( 0 );
+				for ( std::size_t index = 0; index < size; ++index )
+				{
+					++heads[ digit_of( first[ index ] ) ];
+				}
+
+				// Every key shares this byte, move straight on to the next one
+				if ( heads[ digit_of( *first ) ] != size )
+				{
+					break;
+				}
+				if ( shift == 0 )
+				{
+					return;
+				}
+				shift -= 8;
+			}
+
+			std::size_t total = 0;
+			for ( std::size_t digit = 0; digit < 256; ++digit )
+			{
+				const std::size_t count = heads[ digit ];
+				heads[ digit ] = total;
+				total += count;
+				tails[ digit ] = total;
+			}
+
+			// Swap each value into the next free slot of its bucket until every bucket is full of its own values
+			for ( std::size_t digit = 0; digit < 256; ++digit )
+			{
+				while ( heads[ digit ] != tails[ digit ] )
+				{
+					const std::size_t value_digit = digit_of( first[ heads[ digit ] ] );
+					if ( value_digit == digit )
+					{
+						++heads[ digit ];
+					}
+					else
+					{
+						std::iter_swap( first + heads[ digit ], first + heads[ value_digit ]++ );
+					}
+				}
+			}
+
+			if ( shift == 0 )
+			{
+				return;
+			}
+			// Heads are now the ends of their buckets, so each bucket starts where the previous one ended
+			std::size_t bucket_begin = 0;
+			for ( std::size_t digit = 0; digit < 256; ++digit )
+			{
+				const std::size_t bucket_size = tails[ digit ] - bucket_begin;
+				if ( bucket_size > 1 )
+				{
+					american_flag_sort( first + bucket_begin, bucket_size, shift - 8, radix_key_of );
+				}
+				bucket_begin = tails[ digit ];
+			}
+		}
+	}
+
+	/// @brief Sorts elements by key in place using an MSD radix sort, without an output buffer.
+	/// @details An American flag sort: counts the most significant byte of every key, swaps each element directly
+	/// into its bucket, then sorts each bucket by the next byte. Bytes every key in a partition shares are skipped
+	/// and partitions of up to 64 elements are finished with an insertion sort. Keys are mapped with the same
+	/// @c to_radix_key as @ref radix_sort, boolean keys are partitioned.
+	/// @note Unlike @ref radix_sort this is not stable, equal keys may be reordered. Needs no memory beyond a few
+	/// kilobytes of stack per key byte, where @ref radix_sort needs a second buffer as large as the input, but it
+	/// is usually slower as every swap is a random access to a value that is then read again.
+	/// @tparam It Random access iterator to the range.
+	/// @tparam Sentinel Sentinel type for @p It.
+	/// @tparam KeyExtractor Unary invocable that extracts a sortable key from each element.
+	/// @param first Iterator to the first element of the range.
+	/// @param last Sentinel denoting the end of the range.
+	/// @param key_extractor Functor that extracts the sort key from each element.
+	template <std::random_access_iterator It,
+			  std::sentinel_for<It> Sentinel,
+			  std::indirectly_unary_invocable<It> KeyExtractor = std::identity>
+		requires std::permutable<It>
+	void radix_sort_in_place( It first, Sentinel last, KeyExtractor key_extractor = {} )
+	{
+		using key_type = detail::extracted_key_t<KeyExtractor, It>;
+
+		if constexpr ( std::same_as<key_type, bool> )
+		{
+			std::partition( first, last, [ & ]( const auto& value ) { return !std::invoke( key_extractor, value ); } );
+		}
+		else
+		{
+			using radix_key_type = detail::radix_key_t<KeyExtractor, It>;
+			auto radix_key_of = [ & ]( const auto& value ) {
+				return detail::to_radix_key( std::invoke( key_extractor, value ) );
+			};
+			detail::american_flag_sort( first,
+										static_cast<std::size_t>( last - first ),
+										static_cast<unsigned>( ( sizeof( radix_key_type ) - 1 ) * 8 ),
+										radix_key_of );
 		}
 	}
 }
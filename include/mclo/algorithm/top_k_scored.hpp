@@ -0,0 +1,227 @@
+#pragma once
+
+#include "mclo/algorithm/detail/scored_simd.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	namespace detail
+	{
+		/// @brief The best k scored elements seen so far, kept as a heap with the worst of them at the front
+		/// @details Elements are ordered by score then by position, so on ties the earlier element is better.
+		template <typename Score, typename It, typename Compare>
+		class top_k_heap
+		{
+		public:
+			struct candidate
+			{
+				Score score;
+				std::size_t position;
+				It it;
+			};
+
+			constexpr top_k_heap( const std::size_t k, const Compare& compare )
+				: m_k( k )
+				, m_compare( compare )
+			{
+			}
+
+			constexpr void reserve( const std::size_t size )
+			{
+				m_candidates.reserve( std::min( m_k, size ) );
+			}
+
+			[[nodiscard]] constexpr bool full() const noexcept
+			{
+				return m_candidates.size() == m_k;
+			}
+
+			/// @brief The score an element must beat to be offered once the heap is full
+			[[nodiscard]] constexpr const Score& threshold() const noexcept
+			{
+				return m_candidates.front().score;
+			}
+
+			/// @brief Offer an element positioned after every element offered before it
+			constexpr void offer( Score score, const std::size_t position, const It it )
+			{
+				if ( !full() )
+				{
+					push( { std::move( score ), position, it } );
+				}
+				else if ( std::invoke( m_compare, threshold(), score ) )
+				{
+					replace_worst( { std::move( score ), position, it } );
+				}
+			}
+
+			/// @brief Offer a candidate from another heap, positioned anywhere
+			constexpr void merge( candidate&& other )
+			{
+				if ( !full() )
+				{
+					push( std::move( other ) );
+				}
+				else if ( better( other, m_candidates.front() ) )
+				{
+					replace_worst( std::move( other ) );
+				}
+			}
+
+			[[nodiscard]] constexpr std::vector<candidate>& candidates() noexcept
+			{
+				return m_candidates;
+			}
+
+			/// @brief Write the iterators of the candidates to out best first, leaving the heap empty
+			template <typename OutIt>
+			constexpr OutIt write_sorted( OutIt out )
+			{
+				std::sort_heap( m_candidates.begin(), m_candidates.end(), better_fn() );
+				for ( candidate& entry : m_candidates )
+				{
+					*out = std::move( entry.it );
+					++out;
+				}
+				m_candidates.clear();
+				return out;
+			}
+
+		private:
+			[[nodiscard]] constexpr bool better( const candidate& lhs, const candidate& rhs ) const
+			{
+				if ( std::invoke( m_compare, rhs.score, lhs.score ) )
+				{
+					return true;
+				}
+				if ( std::invoke( m_compare, lhs.score, rhs.score ) )
+				{
+					return false;
+				}
+				return lhs.position < rhs.position;
+			}
+
+			// Heaps put the greatest element first, so ordering by better puts the worst first
+			[[nodiscard]] constexpr auto better_fn() const noexcept
+			{
+				return [ this ]( const candidate& lhs, const candidate& rhs ) { return better( lhs, rhs ); };
+			}
+
+			constexpr void push( candidate&& entry )
+			{
+				m_candidates.push_back( std::move( entry ) );
+				std::push_heap( m_candidates.begin(), m_candidates.end(), better_fn() );
+			}
+
+			constexpr void replace_worst( candidate&& entry )
+			{
+				std::pop_heap( m_candidates.begin(), m_candidates.end(), better_fn() );
+				m_candidates.back() = std::move( entry );
+				std::push_heap( m_candidates.begin(), m_candidates.end(), better_fn() );
+			}
+
+			std::size_t m_k;
+			Compare m_compare;
+			std::vector<candidate> m_candidates;
+		};
+
+		/// @brief Offer every element of a contiguous range to heap, the first at position
+		/// @details Once the heap is full SIMD skips ahead to the next score that beats its threshold.
+		template <std::contiguous_iterator It, typename Scorer, typename Heap>
+		void top_k_scored_simd(
+			const It first, const std::size_t size, const std::size_t position, Scorer& score, Heap& heap )
+		{
+			const auto scan_block = [ & ]( const auto* scores, const std::size_t offset, const std::size_t count ) {
+				const auto offer = [ & ]( const std::size_t index ) {
+					const auto element = static_cast<std::iter_difference_t<It>>( offset + index );
+					heap.offer( scores[ index ], position + offset + index, first + element );
+				};
+
+				std::size_t index = 0;
+				for ( ; index < count && !heap.full(); ++index )
+				{
+					offer( index );
+				}
+				while ( index < count )
+				{
+					index += find_greater_simd( scores + index, count - index, heap.threshold() );
+					if ( index == count )
+					{
+						break;
+					}
+					offer( index++ );
+				}
+			};
+			for_each_score_block( first, size, score, scan_block );
+		}
+
+		/// @brief Offer every element of [first, last) to heap, the first at position
+		template <typename It, typename Sentinel, typename Scorer, typename Compare, typename Heap>
+		constexpr void top_k_scored_into(
+			It first, const Sentinel last, std::size_t position, Scorer& score, Heap& heap )
+		{
+			if constexpr ( std::sized_sentinel_for<Sentinel, It> )
+			{
+				heap.reserve( static_cast<std::size_t>( last - first ) );
+			}
+
+			if constexpr ( scored_simd_range<It, Sentinel, Scorer, Compare> )
+			{
+				if ( !std::is_constant_evaluated() )
+				{
+					top_k_scored_simd( first, static_cast<std::size_t>( last - first ), position, score, heap );
+					return;
+				}
+			}
+
+			for ( ; first != last; ++first, ++position )
+			{
+				heap.offer( std::invoke( score, *first ), position, first );
+			}
+		}
+	}
+
+	/// @brief Finds the k elements with the largest scores, as produced by a scoring function.
+	/// @details Each element is scored once via @p score and offered to a bounded heap of the best k so far, an
+	/// element only costs a heap update when it beats the worst of them. At runtime contiguous ranges with arithmetic
+	/// scores compared by std::less are scored a block at a time and scanned with SIMD for the scores that do.
+	/// @tparam It Forward iterator type for the input range.
+	/// @tparam Sentinel Sentinel type for @p It.
+	/// @tparam OutIt Output iterator type for iterators of the input range.
+	/// @tparam Scorer Invocable mapping an element to a comparable score.
+	/// @tparam Compare Binary predicate establishing a strict ordering of scores.
+	/// @param first Iterator to the first element of the range.
+	/// @param last Sentinel denoting the end of the range.
+	/// @param k The maximum number of elements to find.
+	/// @param out Where to write iterators to the found elements, highest-scored first.
+	/// @param score Functor producing the score for each element.
+	/// @param compare Comparator returning true when the first score orders before the second.
+	/// @return Iterator past the last iterator written, min( k, size ) are written. Earlier elements are preferred
+	/// and ordered first on ties.
+	template <std::forward_iterator It,
+			  std::sentinel_for<It> Sentinel,
+			  std::weakly_incrementable OutIt,
+			  std::invocable<std::iter_reference_t<It>> Scorer,
+			  typename Compare = std::less<>>
+		requires std::indirectly_writable<OutIt, It>
+	constexpr OutIt top_k_scored(
+		It first, Sentinel last, const std::size_t k, OutIt out, Scorer score, Compare compare = {} )
+	{
+		if ( k == 0 )
+		{
+			return out;
+		}
+
+		detail::top_k_heap<detail::score_t<Scorer, It>, It, Compare> heap( k, compare );
+		detail::top_k_scored_into<It, Sentinel, Scorer, Compare>( std::move( first ), last, 0, score, heap );
+		return heap.write_sorted( std::move( out ) );
+	}
+}
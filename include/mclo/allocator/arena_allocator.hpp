@@ -42,6 +42,15 @@ namespace mclo
 		/// @return A pointer to the allocated memory.
 		void* allocate( const std::size_t size, std::size_t alignment = alignof( std::max_align_t ) );
 
+		/// @brief Extends an allocation in place if it is the most recent one and the current chunk has space after it.
+		/// @details Lets a growing container keep its storage instead of copying to a new allocation and abandoning
+		/// the old one in the arena.
+		/// @param ptr The allocation to extend.
+		/// @param old_size The current size in bytes of the allocation.
+		/// @param new_size The size in bytes to extend the allocation to.
+		/// @return True if the allocation is now new_size bytes, false if it is unchanged.
+		[[nodiscard]] bool try_extend( void* ptr, std::size_t old_size, std::size_t new_size ) noexcept;
+
 		/// @brief Resets the arena so all chunks can be reused, keeping the allocated chunks for future allocations.
 		/// @details Does not return memory to the system; subsequent allocations reuse the existing chunks.
 		void reset() noexcept;
@@ -134,6 +143,13 @@ namespace mclo
 			return static_cast<T*>( m_arena->allocate( n * sizeof( T ), alignof( T ) ) );
 		}
 
+		/// @brief Extends storage for @p old_count objects to @p new_count objects in place if the arena can.
+		/// @return True if the storage now holds @p new_count objects, false if it is unchanged.
+		[[nodiscard]] bool try_extend( T* const ptr, const std::size_t old_count, const std::size_t new_count ) noexcept
+		{
+			return m_arena->try_extend( ptr, old_count * sizeof( T ), new_count * sizeof( T ) );
+		}
+
 		/// @brief No-op deallocation; arena memory is reclaimed only in bulk by the @ref memory_arena.
 		void deallocate( T*, std::size_t ) noexcept
 		{
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "mclo/container/bitset.hpp"
+#include "mclo/container/detail/atomic_bitset_base.hpp"
+
+namespace mclo
+{
+	/// @brief Fixed size bitset whose bits can be tested and modified concurrently from many threads
+	/// @details Layout compatible with mclo::bitset, every word is accessed atomically. Suited to lock-free flag
+	/// tables such as visited sets in parallel traversals or slot occupancy with find_first_unset_and_set.
+	/// @tparam Bits Number of bits in the set
+	/// @tparam UnderlyingType Underlying integral type, defaults to smallest integer that represents Bits
+	template <std::size_t Bits, std::unsigned_integral UnderlyingType = uint_least_t<Bits>>
+	class atomic_bitset : public detail::atomic_bitset_base<bitset<Bits, UnderlyingType>>
+	{
+		using base = detail::atomic_bitset_base<bitset<Bits, UnderlyingType>>;
+
+	public:
+		using bitset_type = typename base::bitset_type;
+
+		/// @brief Construct the bitset with no set bits
+		atomic_bitset() noexcept = default;
+
+		/// @brief Construct the bitset with the bits of an existing bitset
+		/// @param bits Initial bits
+		explicit atomic_bitset( const bitset_type& bits ) noexcept
+			: base( bits )
+		{
+		}
+	};
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "mclo/container/detail/atomic_bitset_base.hpp"
+#include "mclo/container/dynamic_bitset.hpp"
+
+namespace mclo
+{
+	/// @brief Bitset with a size set at construction whose bits can be tested and modified concurrently from many
+	/// threads
+	/// @details Layout compatible with mclo::dynamic_bitset, every word is accessed atomically. The size cannot change
+	/// after construction as resizing would move the words out from under concurrent accesses.
+	/// @tparam UnderlyingType Underlying integral type
+	template <std::unsigned_integral UnderlyingType = std::size_t>
+	class atomic_dynamic_bitset : public detail::atomic_bitset_base<dynamic_bitset<UnderlyingType>>
+	{
+		using base = detail::atomic_bitset_base<dynamic_bitset<UnderlyingType>>;
+
+	public:
+		using bitset_type = typename base::bitset_type;
+		using size_type = typename base::size_type;
+
+		/// @brief Construct the bitset with size unset bits
+		/// @param size Number of bits
+		explicit atomic_dynamic_bitset( const size_type size )
+			: base( bitset_type( size ) )
+		{
+		}
+
+		/// @brief Construct the bitset taking the size and bits of an existing bitset
+		/// @param bits Initial bits
+		explicit atomic_dynamic_bitset( bitset_type bits ) noexcept
+			: base( std::move( bits ) )
+		{
+		}
+	};
+}
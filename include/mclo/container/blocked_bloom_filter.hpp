@@ -0,0 +1,255 @@
+#pragma once
+
+#include "mclo/container/detail/blocked_bloom_simd.hpp"
+#include "mclo/container/detail/filter_common.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/hash/rapidhash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A split block Bloom filter, a Bloom filter keeping all the bits of a key in one 256 bit block.
+	/// @details A key hash picks one block and sets a single bit in each of its eight 32 bit words, so an insert or
+	/// lookup touches one cache line however large the filter is, and checking the eight words maps onto one 256 bit
+	/// SIMD compare. The price is a higher false positive rate than @ref bloom_filter at the same size, as keys are not
+	/// spread evenly over blocks, which @ref with_false_positive_rate accounts for when sizing.
+	///
+	/// @ref insert_many and @ref contains_many hash keys with @ref hash_many and process them with SIMD, prefetching
+	/// the blocks of later keys so the cache misses of large filters overlap.
+	///
+	/// Keys are hashed with @ref hash_object using @p Hasher. The serialized form is the blocks in native endianness
+	/// and is only valid for the same @p Key and @p Hasher.
+	/// @tparam Key The key type.
+	/// @tparam Hasher The hasher used to hash keys.
+	template <typename Key, hasher Hasher = mclo::rapidhash>
+		requires( hashable_with<Key, Hasher> && std::default_initializable<Hasher> )
+	class blocked_bloom_filter
+	{
+		using block_type = detail::blocked_bloom_block;
+
+		static constexpr std::uint64_t magic = UINT64_C( 0x314642424f4c434d ); // "MCLOBBF1" little endian
+		static constexpr std::size_t header_words = 2;
+		static constexpr std::size_t block_bits = sizeof( block_type ) * 8;
+
+	public:
+		using key_type = Key;
+		using hasher_type = Hasher;
+		using size_type = std::size_t;
+
+		/// @brief Construct an empty filter with a given size.
+		/// @param num_bits The number of bits, rounded up to a whole number of 256 bit blocks, at least one.
+		explicit blocked_bloom_filter( const size_type num_bits )
+			: m_blocks( std::max<size_type>( 1, ( num_bits + block_bits - 1 ) / block_bits ), block_type{} )
+		{
+		}
+
+		/// @brief Construct an empty filter sized for a false positive rate once it holds some number of keys.
+		/// @param expected_keys The number of keys expected to be inserted.
+		/// @param false_positive_rate The target false positive rate in (0, 1).
+		/// @return The smallest filter whose @ref estimated_false_positive_rate meets the target.
+		[[nodiscard]] static blocked_bloom_filter with_false_positive_rate( const size_type expected_keys,
+																			const double false_positive_rate )
+		{
+			MCLO_DEBUG_ASSERT( false_positive_rate > 0 && false_positive_rate < 1,
+							   "False positive rate must be in (0, 1)",
+							   false_positive_rate );
+			const auto meets_rate = [ & ]( const size_type num_blocks ) {
+				return estimated_false_positive_rate( expected_keys, num_blocks * block_bits ) <= false_positive_rate;
+			};
+
+			// Grow until the rate is met then binary search back down for the smallest size that meets it
+			size_type high = 1;
+			while ( !meets_rate( high ) )
+			{
+				high *= 2;
+			}
+			size_type low = high / 2;
+			while ( high - low > 1 )
+			{
+				const size_type middle = low + ( high - low ) / 2;
+				if ( meets_rate( middle ) )
+				{
+					high = middle;
+				}
+				else
+				{
+					low = middle;
+				}
+			}
+			return blocked_bloom_filter( high * block_bits );
+		}
+
+		/// @brief Estimate the false positive rate of a filter holding some number of keys.
+		/// @details The number of keys in a block is Poisson distributed, a block holding @c j keys gives a false
+		/// positive when all eight bits probed are set, each with probability @c 1-(31/32)^j.
+		/// @param num_keys The number of keys inserted.
+		/// @param num_bits The size of the filter in bits, rounded up to whole blocks as the constructor does.
+		/// @return The expected probability that a key never inserted is reported present.
+		[[nodiscard]] static double estimated_false_positive_rate( const size_type num_keys,
+																   const size_type num_bits ) noexcept
+		{
+			const size_type num_blocks = std::max<size_type>( 1, ( num_bits + block_bits - 1 ) / block_bits );
+			const double keys_per_block = static_cast<double>( num_keys ) / static_cast<double>( num_blocks );
+			if ( keys_per_block == 0 )
+			{
+				return 0;
+			}
+
+			// Sum over the bulk of the distribution, the tail beyond it contributes nothing measurable
+			const double log_mean = std::log( keys_per_block );
+			const auto last = static_cast<size_type>( keys_per_block + 10 * std::sqrt( keys_per_block ) + 20 );
+			double rate = 0;
+			for ( size_type keys = 1; keys <= last; ++keys )
+			{
+				const double keys_d = static_cast<double>( keys );
+				const double probability = std::exp( keys_d * log_mean - keys_per_block - std::lgamma( keys_d + 1 ) );
+				const double bit_set = 1 - std::pow( 1 - 1.0 / 32, keys_d );
+				rate += probability * std::pow( bit_set, static_cast<double>( detail::blocked_bloom_words ) );
+			}
+			return rate;
+		}
+
+		/// @brief Insert a key.
+		void insert( const Key& key ) noexcept
+		{
+			insert_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Insert a key by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		void insert_hash( const std::size_t hash ) noexcept
+		{
+			const auto [ block, key ] = detail::blocked_bloom_locate( hash, m_blocks.size() );
+			auto& words = m_blocks[ static_cast<size_type>( block ) ].words;
+			for ( size_type word = 0; word < detail::blocked_bloom_words; ++word )
+			{
+				words[ word ] |= detail::blocked_bloom_bit( key, word );
+			}
+		}
+
+		/// @brief Insert every key of a range, hashing them in bulk.
+		/// @param keys The keys to insert.
+		template <std::ranges::forward_range Range>
+			requires( std::same_as<std::ranges::range_value_t<Range>, Key> )
+		void insert_many( Range&& keys ) noexcept
+		{
+			const auto insert_batch = [ this ]( const std::size_t* const hashes, const size_type count, size_type ) {
+				detail::blocked_bloom_insert_simd( m_blocks.data(), m_blocks.size(), hashes, count );
+			};
+			detail::for_each_hash_batch<Key, Hasher>( keys, insert_batch );
+		}
+
+		/// @brief Check if a key may be in the filter.
+		/// @return False if the key was never inserted, true if it probably was.
+		[[nodiscard]] bool contains( const Key& key ) const noexcept
+		{
+			return contains_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Check if a key may be in the filter by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		/// @return False if the key was never inserted, true if it probably was.
+		[[nodiscard]] bool contains_hash( const std::size_t hash ) const noexcept
+		{
+			const auto [ block, key ] = detail::blocked_bloom_locate( hash, m_blocks.size() );
+			const auto& words = m_blocks[ static_cast<size_type>( block ) ].words;
+			std::uint32_t missing = 0;
+			for ( size_type word = 0; word < detail::blocked_bloom_words; ++word )
+			{
+				const std::uint32_t bit = detail::blocked_bloom_bit( key, word );
+				missing |= bit & ~words[ word ];
+			}
+			return missing == 0;
+		}
+
+		/// @brief Check every key of a range, hashing them in bulk.
+		/// @param keys The keys to check.
+		/// @param results Where to write if each key may be in the filter, at least as many as there are keys.
+		template <std::ranges::forward_range Range>
+			requires( std::same_as<std::ranges::range_value_t<Range>, Key> )
+		void contains_many( Range&& keys, const mclo::span<bool> results ) const noexcept
+		{
+			MCLO_DEBUG_ASSERT( results.size() >= static_cast<size_type>( std::ranges::distance( keys ) ),
+							   "Not enough space for the results" );
+			const auto check_batch = [ this, results ]( const std::size_t* const hashes,
+														const size_type count,
+														const size_type offset ) {
+				detail::blocked_bloom_contains_simd(
+					m_blocks.data(), m_blocks.size(), hashes, count, results.data() + offset );
+			};
+			detail::for_each_hash_batch<Key, Hasher>( keys, check_batch );
+		}
+
+		/// @brief Remove every key.
+		void clear() noexcept
+		{
+			std::fill( m_blocks.begin(), m_blocks.end(), block_type{} );
+		}
+
+		/// @brief Get the number of bits in the filter.
+		[[nodiscard]] size_type num_bits() const noexcept
+		{
+			return m_blocks.size() * block_bits;
+		}
+
+		/// @brief Get the number of bytes @ref serialize writes.
+		[[nodiscard]] size_type serialized_size() const noexcept
+		{
+			return detail::filter_serialized_size<block_type>( header_words, m_blocks.size() );
+		}
+
+		/// @brief Serialize the filter.
+		/// @param out Buffer to write into, must be at least @ref serialized_size bytes.
+		/// @return The number of bytes written.
+		size_type serialize( const mclo::span<std::byte> out ) const noexcept
+		{
+			const std::array<std::uint64_t, header_words> header{ magic, m_blocks.size() };
+			return detail::serialize_filter<block_type>( header, mclo::span<const block_type>( m_blocks ), out );
+		}
+
+		/// @brief Serialize the filter.
+		/// @return The serialized bytes.
+		[[nodiscard]] std::vector<std::byte> serialize() const
+		{
+			std::vector<std::byte> result( serialized_size() );
+			serialize( result );
+			return result;
+		}
+
+		/// @brief Deserialize a filter, copying it out of @p data.
+		/// @param data The serialized bytes, trailing bytes are ignored.
+		/// @return The filter, or @c std::nullopt if @p data is not a valid serialized filter.
+		[[nodiscard]] static std::optional<blocked_bloom_filter> deserialize( const mclo::span<const std::byte> data )
+		{
+			const auto header = detail::read_filter_header<header_words>( data, magic );
+			if ( !header )
+			{
+				return std::nullopt;
+			}
+			const std::uint64_t num_blocks = ( *header )[ 1 ];
+			if ( num_blocks == 0 || num_blocks > data.size() / sizeof( block_type ) )
+			{
+				return std::nullopt;
+			}
+
+			blocked_bloom_filter result( static_cast<size_type>( num_blocks ) * block_bits );
+			if ( !detail::read_filter_words<block_type, header_words>( data,
+																	   mclo::span<block_type>( result.m_blocks ) ) )
+			{
+				return std::nullopt;
+			}
+			return result;
+		}
+
+	private:
+		std::vector<block_type> m_blocks;
+	};
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "mclo/container/detail/filter_common.hpp"
+#include "mclo/container/dynamic_bitset.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/hash/rapidhash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <optional>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A Bloom filter, a compact set that can say a key is definitely absent or probably present.
+	/// @details Each key sets @c num_hashes bits of a @ref dynamic_bitset, picked by double hashing a single hash of
+	/// the key, and a key is reported present when all of its bits are set. There are no false negatives, the false
+	/// positive rate depends on the bits per key and number of hashes, see @ref with_false_positive_rate to size for a
+	/// rate.
+	///
+	/// Every probe can miss the cache in a large filter, @ref blocked_bloom_filter keeps a key's bits in one cache line
+	/// for a slightly higher false positive rate. Keys cannot be erased, @ref cuckoo_filter supports erasing.
+	///
+	/// Keys are hashed with @ref hash_object using @p Hasher. The serialized form is the bits in native endianness
+	/// and is only valid for the same @p Key and @p Hasher.
+	/// @tparam Key The key type.
+	/// @tparam Hasher The hasher used to hash keys.
+	template <typename Key, hasher Hasher = mclo::rapidhash>
+		requires( hashable_with<Key, Hasher> && std::default_initializable<Hasher> )
+	class bloom_filter
+	{
+		using bitset_type = dynamic_bitset<std::uint64_t>;
+
+		static constexpr std::uint64_t magic = UINT64_C( 0x314d4c424f4c434d ); // "MCLOBLM1" little endian
+		static constexpr std::size_t header_words = 3;
+
+	public:
+		using key_type = Key;
+		using hasher_type = Hasher;
+		using size_type = std::size_t;
+
+		/// @brief Construct an empty filter with a given size.
+		/// @param num_bits The number of bits, rounded up to a whole number of 64 bit words, must not be zero.
+		/// @param num_hashes The number of bits set per key, must not be zero.
+		bloom_filter( const size_type num_bits, const size_type num_hashes )
+			: m_bits( ( num_bits + 63 ) / 64 * 64 )
+			, m_num_hashes( num_hashes )
+		{
+			MCLO_DEBUG_ASSERT( num_bits != 0, "A Bloom filter needs bits" );
+			MCLO_DEBUG_ASSERT( num_hashes != 0, "A Bloom filter needs hashes" );
+		}
+
+		/// @brief Construct an empty filter sized for a false positive rate once it holds some number of keys.
+		/// @param expected_keys The number of keys expected to be inserted.
+		/// @param false_positive_rate The target false positive rate in (0, 1).
+		/// @return The filter using the optimal bits and number of hashes for the rate.
+		[[nodiscard]] static bloom_filter with_false_positive_rate( const size_type expected_keys,
+																	 const double false_positive_rate )
+		{
+			MCLO_DEBUG_ASSERT( false_positive_rate > 0 && false_positive_rate < 1,
+							   "False positive rate must be in (0, 1)",
+							   false_positive_rate );
+			const double bits_per_key = -std::log( false_positive_rate ) / ( std::numbers::ln2 * std::numbers::ln2 );
+			const double num_bits = std::ceil( static_cast<double>( std::max<size_type>( expected_keys, 1 ) ) *
+											   bits_per_key );
+			return bloom_filter( static_cast<size_type>( num_bits ), optimal_num_hashes( bits_per_key ) );
+		}
+
+		/// @brief Get the number of hashes that minimises the false positive rate for a number of bits per key.
+		[[nodiscard]] static size_type optimal_num_hashes( const double bits_per_key ) noexcept
+		{
+			return std::max<size_type>( 1, static_cast<size_type>( std::lround( bits_per_key * std::numbers::ln2 ) ) );
+		}
+
+		/// @brief Insert a key.
+		void insert( const Key& key ) noexcept
+		{
+			insert_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Insert a key by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		void insert_hash( const std::size_t hash ) noexcept
+		{
+			detail::filter_probe probes( hash );
+			for ( size_type index = 0; index < m_num_hashes; ++index )
+			{
+				m_bits.set( probes.next( num_bits() ) );
+			}
+		}
+
+		/// @brief Check if a key may be in the filter.
+		/// @return False if the key was never inserted, true if it probably was.
+		[[nodiscard]] bool contains( const Key& key ) const noexcept
+		{
+			return contains_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Check if a key may be in the filter by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		/// @return False if the key was never inserted, true if it probably was.
+		[[nodiscard]] bool contains_hash( const std::size_t hash ) const noexcept
+		{
+			detail::filter_probe probes( hash );
+			for ( size_type index = 0; index < m_num_hashes; ++index )
+			{
+				if ( !m_bits.test( probes.next( num_bits() ) ) )
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/// @brief Remove every key.
+		void clear() noexcept
+		{
+			m_bits.reset();
+		}
+
+		/// @brief Get the number of bits in the filter.
+		[[nodiscard]] size_type num_bits() const noexcept
+		{
+			return m_bits.size();
+		}
+
+		/// @brief Get the number of bits set per key.
+		[[nodiscard]] size_type num_hashes() const noexcept
+		{
+			return m_num_hashes;
+		}
+
+		/// @brief Get the number of bytes @ref serialize writes.
+		[[nodiscard]] size_type serialized_size() const noexcept
+		{
+			return detail::filter_serialized_size<std::uint64_t>( header_words, m_bits.underlying().size() );
+		}
+
+		/// @brief Serialize the filter.
+		/// @param out Buffer to write into, must be at least @ref serialized_size bytes.
+		/// @return The number of bytes written.
+		size_type serialize( const mclo::span<std::byte> out ) const noexcept
+		{
+			const std::array<std::uint64_t, header_words> header{ magic, num_bits(), m_num_hashes };
+			return detail::serialize_filter<std::uint64_t>( header, m_bits.underlying(), out );
+		}
+
+		/// @brief Serialize the filter.
+		/// @return The serialized bytes.
+		[[nodiscard]] std::vector<std::byte> serialize() const
+		{
+			std::vector<std::byte> result( serialized_size() );
+			serialize( result );
+			return result;
+		}
+
+		/// @brief Deserialize a filter, copying it out of @p data.
+		/// @param data The serialized bytes, trailing bytes are ignored.
+		/// @return The filter, or @c std::nullopt if @p data is not a valid serialized filter.
+		[[nodiscard]] static std::optional<bloom_filter> deserialize( const mclo::span<const std::byte> data )
+		{
+			const auto header = detail::read_filter_header<header_words>( data, magic );
+			if ( !header )
+			{
+				return std::nullopt;
+			}
+			const std::uint64_t num_bits = ( *header )[ 1 ];
+			const std::uint64_t num_hashes = ( *header )[ 2 ];
+			// More hashes than bits can never help, bounding them stops crafted data making every lookup endless
+			if ( num_bits == 0 || num_bits % 64 != 0 || num_bits / 64 > data.size() / sizeof( std::uint64_t ) ||
+				 num_hashes == 0 || num_hashes > num_bits )
+			{
+				return std::nullopt;
+			}
+
+			std::vector<std::uint64_t> words( static_cast<size_type>( num_bits / 64 ) );
+			if ( !detail::read_filter_words<std::uint64_t, header_words>( data, mclo::span<std::uint64_t>( words ) ) )
+			{
+				return std::nullopt;
+			}
+			return bloom_filter( bitset_type( static_cast<size_type>( num_bits ), std::move( words ) ),
+								 static_cast<size_type>( num_hashes ) );
+		}
+
+	private:
+		bloom_filter( bitset_type&& bits, const size_type num_hashes ) noexcept
+			: m_bits( std::move( bits ) )
+			, m_num_hashes( num_hashes )
+		{
+		}
+
+		bitset_type m_bits;
+		size_type m_num_hashes;
+	};
+}
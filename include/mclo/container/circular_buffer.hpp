@@ -4,6 +4,7 @@
 #include "mclo/debug/assert.hpp"
 #include "mclo/platform/attributes.hpp"
 
+#include <algorithm>
 #include <compare>
 #include <cstddef>
 #include <memory>
@@ -539,6 +540,60 @@ namespace mclo
 			--m_size;
 		}
 
+		// Bulk modifiers
+
+		/// @brief Push a copy of every value onto the back, as if by calling push_back for each.
+		/// @details Once full the oldest values are overwritten, so only the last capacity() values are kept. Values
+		/// are copied a contiguous segment at a time instead of element by element.
+		/// @param values The values to push.
+		void push_back_n( mclo::span<const value_type> values )
+		{
+			const size_type buffer_capacity = capacity();
+			if ( buffer_capacity == 0 )
+			{
+				return;
+			}
+			if ( values.size() >= buffer_capacity )
+			{
+				// Everything already in the buffer would be overwritten
+				clear();
+				values = values.subspan( values.size() - buffer_capacity );
+			}
+
+			const size_type num_constructed = std::min( buffer_capacity - m_size, values.size() );
+			for_each_segment( m_tail, num_constructed, [ & ]( const pointer first, const size_type count ) {
+				std::uninitialized_copy_n( values.data(), count, first );
+				values = values.subspan( count );
+				increment( m_tail, static_cast<difference_type>( count ) );
+				m_size += count;
+			} );
+
+			// Any left over replace the oldest values, head and tail move together once full
+			for_each_segment( m_tail, values.size(), [ & ]( const pointer first, const size_type count ) {
+				std::copy_n( values.data(), count, first );
+				values = values.subspan( count );
+				increment( m_tail, static_cast<difference_type>( count ) );
+				m_head = m_tail;
+			} );
+		}
+
+		/// @brief Move values from the front into out and pop them, a contiguous segment at a time.
+		/// @param out Where to move the values to, at most out.size() values are popped.
+		/// @return The number of values popped, the smaller of size() and out.size().
+		size_type pop_front_n( const mclo::span<value_type> out )
+		{
+			const size_type num_popped = std::min( m_size, out.size() );
+			size_type num_moved = 0;
+			for_each_segment( m_head, num_popped, [ & ]( const pointer first, const size_type count ) {
+				std::move( first, first + count, out.data() + num_moved );
+				std::destroy_n( first, count );
+				num_moved += count;
+				increment( m_head, static_cast<difference_type>( count ) );
+				m_size -= count;
+			} );
+			return num_popped;
+		}
+
 		// Position modifiers
 		// todo(mc) emplace, insert, erase
 
@@ -721,6 +776,21 @@ namespace mclo
 			ptr -= ( count > ( ptr - m_data ) ) ? ( count - ( m_data_end - m_data ) ) : count;
 		}
 
+		/// @brief Invoke func with each contiguous segment of the count slots starting at first, at most two
+		template <typename Func>
+		void for_each_segment( const pointer first, const size_type count, Func func ) const
+		{
+			const size_type first_count = std::min( count, static_cast<size_type>( m_data_end - first ) );
+			if ( first_count != 0 )
+			{
+				func( first, first_count );
+			}
+			if ( first_count != count )
+			{
+				func( m_data, count - first_count );
+			}
+		}
+
 		template <typename... Args>
 		reference replace( const pointer ptr, Args&&... args )
 		{
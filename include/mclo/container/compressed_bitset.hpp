@@ -0,0 +1,252 @@
+#pragma once
+
+#include "mclo/container/bitset.hpp"
+#include "mclo/container/span.hpp"
+#include "mclo/memory/indirect.hpp"
+#include "mclo/utility/overloaded.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace mclo
+{
+	namespace detail
+	{
+		inline constexpr std::uint32_t compressed_chunk_bits = 16;
+		inline constexpr std::uint32_t compressed_chunk_size = 1u << compressed_chunk_bits;
+
+		// Above this cardinality a dense bitmap is smaller than a sorted array of 16 bit values
+		inline constexpr std::uint32_t compressed_max_array_cardinality = 4096;
+
+		using compressed_chunk_bitset = mclo::bitset<compressed_chunk_size, std::uint64_t>;
+
+		struct compressed_array_container
+		{
+			std::vector<std::uint16_t> values;
+		};
+
+		struct compressed_bitmap_container
+		{
+			mclo::indirect<compressed_chunk_bitset> bits;
+			std::uint32_t cardinality = 0;
+		};
+
+		// Inclusive range [start, last] of set bits
+		struct compressed_run
+		{
+			std::uint16_t start;
+			std::uint16_t last;
+
+			[[nodiscard]] bool operator==( const compressed_run& other ) const noexcept = default;
+		};
+
+		struct compressed_run_container
+		{
+			std::vector<compressed_run> runs;
+			std::uint32_t cardinality = 0;
+		};
+
+		using compressed_container =
+			std::variant<compressed_array_container, compressed_bitmap_container, compressed_run_container>;
+	}
+
+	/// @brief A compressed bitset over the full 32 bit integer space, in the style of a roaring bitmap.
+	/// @details The value space is split into chunks of 65536 values keyed by the upper 16 bits. Only chunks with at
+	/// least one set bit are stored and each picks the cheapest of three representations:
+	/// - A sorted array of the lower 16 bits while it holds at most 4096 values.
+	/// - A dense 65536 bit @c mclo::bitset once it holds more than that.
+	/// - A sorted list of runs, produced by @c set_range and @c run_optimize for long stretches of set bits.
+	///
+	/// This makes sparse and clustered sets far smaller than a @c mclo::dynamic_bitset over the same range while
+	/// union and intersection work chunk by chunk, using the bitset bulk kernels when both sides are dense.
+	/// The serialized form is the portable roaring format so it can be exchanged with other roaring implementations.
+	class compressed_bitset
+	{
+	public:
+		using value_type = std::uint32_t;
+		using size_type = std::uint64_t;
+
+		/// @brief Construct the bitset with no set bits
+		compressed_bitset() noexcept = default;
+
+		/// @brief Gets the total number of bits the bitset can address
+		/// @return Number of bits, 2^32
+		[[nodiscard]] static constexpr size_type size() noexcept
+		{
+			return size_type{ 1 } << 32;
+		}
+
+		/// @brief Test if the bit at pos is set
+		/// @param pos Position to check
+		/// @return If the bit is set
+		[[nodiscard]] bool test( value_type pos ) const noexcept;
+
+		/// @brief Set the bit at pos
+		/// @param pos Position to set
+		/// @return Reference to this
+		compressed_bitset& set( value_type pos );
+
+		/// @brief Set the bit at pos to value
+		/// @param pos Position to set
+		/// @param value Value to set the bit to
+		/// @return Reference to this
+		compressed_bitset& set( value_type pos, bool value );
+
+		/// @brief Set every bit in the range [first, last)
+		/// @details Whole chunks covered by the range are stored as a single run.
+		/// @param first First position to set
+		/// @param last One past the last position to set, must be >= first and <= size()
+		/// @return Reference to this
+		compressed_bitset& set_range( value_type first, size_type last );
+
+		/// @brief Reset the bit at pos
+		/// @param pos Position to reset
+		/// @return Reference to this
+		compressed_bitset& reset( value_type pos );
+
+		/// @brief Reset all bits, releasing every chunk
+		/// @return Reference to this
+		compressed_bitset& reset() noexcept;
+
+		/// @brief Check if any bit is set
+		/// @return If any bit is set
+		[[nodiscard]] bool any() const noexcept
+		{
+			return !m_keys.empty();
+		}
+
+		/// @brief Check if no bits are set
+		/// @return If no bits are set
+		[[nodiscard]] bool none() const noexcept
+		{
+			return m_keys.empty();
+		}
+
+		/// @brief Count the number of set bits
+		/// @return Number of set bits
+		[[nodiscard]] size_type count() const noexcept;
+
+		/// @brief Count the number of set bits at or before pos
+		/// @param pos Position to count up to, inclusive
+		/// @return Number of set bits in [0, pos]
+		[[nodiscard]] size_type rank( value_type pos ) const noexcept;
+
+		/// @brief Find the first set bit
+		/// @return Position of the first set bit or std::nullopt if none are set
+		[[nodiscard]] std::optional<value_type> find_first_set() const noexcept;
+
+		/// @brief Invoke func with the position of every set bit in ascending order
+		/// @param func Function to invoke with each set position
+		void for_each_set( std::invocable<value_type> auto func ) const
+		{
+			for ( std::size_t index = 0; index < m_keys.size(); ++index )
+			{
+				const value_type base = value_type{ m_keys[ index ] } << detail::compressed_chunk_bits;
+				std::visit( mclo::overloaded{
+								[ & ]( const detail::compressed_array_container& container ) {
+									for ( const std::uint16_t value : container.values )
+									{
+										func( base | value );
+									}
+								},
+								[ & ]( const detail::compressed_bitmap_container& container ) {
+									container.bits->for_each_set( [ & ]( const std::size_t value ) {
+										func( base | static_cast<value_type>( value ) );
+									} );
+								},
+								[ & ]( const detail::compressed_run_container& container ) {
+									for ( const detail::compressed_run run : container.runs )
+									{
+										for ( value_type value = run.start; value <= run.last; ++value )
+										{
+											func( base | value );
+										}
+									}
+								},
+							},
+							m_containers[ index ] );
+			}
+		}
+
+		/// @brief Set every bit that is set in other
+		/// @param other Bitset to union with
+		/// @return Reference to this
+		compressed_bitset& operator|=( const compressed_bitset& other );
+
+		/// @brief Reset every bit that is not set in other
+		/// @param other Bitset to intersect with
+		/// @return Reference to this
+		compressed_bitset& operator&=( const compressed_bitset& other );
+
+		/// @brief Union two bitsets
+		/// @param lhs First bitset
+		/// @param rhs Second bitset
+		/// @return Bitset of bits set in either
+		[[nodiscard]] friend compressed_bitset operator|( const compressed_bitset& lhs, const compressed_bitset& rhs )
+		{
+			return union_of( lhs, rhs );
+		}
+
+		/// @brief Intersect two bitsets
+		/// @param lhs First bitset
+		/// @param rhs Second bitset
+		/// @return Bitset of bits set in both
+		[[nodiscard]] friend compressed_bitset operator&( const compressed_bitset& lhs, const compressed_bitset& rhs )
+		{
+			return intersection_of( lhs, rhs );
+		}
+
+		/// @brief Check both bitsets have the same bits set, regardless of how each chunk is represented
+		/// @param other Bitset to compare against
+		/// @return If the same bits are set
+		[[nodiscard]] bool operator==( const compressed_bitset& other ) const;
+
+		/// @brief Convert each chunk to run containers where that is smaller, or back from them where it is not
+		/// @details Worthwhile after bulk construction of sets with long stretches of consecutive set bits.
+		void run_optimize();
+
+		/// @brief Release excess capacity held by the chunk storage
+		void shrink_to_fit();
+
+		/// @brief Get the number of chunks currently stored
+		/// @return Number of non-empty 65536 bit chunks
+		[[nodiscard]] std::size_t num_chunks() const noexcept
+		{
+			return m_keys.size();
+		}
+
+		/// @brief Get the number of bytes serialize will write
+		/// @return Serialized size in bytes
+		[[nodiscard]] std::size_t serialized_size() const noexcept;
+
+		/// @brief Serialize into the portable roaring format
+		/// @param out Buffer to write into, must be at least serialized_size() bytes
+		/// @return Number of bytes written
+		std::size_t serialize( mclo::span<std::byte> out ) const noexcept;
+
+		/// @brief Serialize into the portable roaring format
+		/// @return Buffer holding the serialized bytes
+		[[nodiscard]] std::vector<std::byte> serialize() const;
+
+		/// @brief Deserialize from the portable roaring format
+		/// @details The input is fully validated, malformed or truncated data is rejected rather than trusted.
+		/// @param data Bytes to read from, trailing bytes after the bitset are ignored
+		/// @return The bitset or std::nullopt if data is not a valid serialized bitset
+		[[nodiscard]] static std::optional<compressed_bitset> deserialize( mclo::span<const std::byte> data );
+
+	private:
+		[[nodiscard]] static compressed_bitset union_of( const compressed_bitset& lhs, const compressed_bitset& rhs );
+		[[nodiscard]] static compressed_bitset intersection_of( const compressed_bitset& lhs,
+																const compressed_bitset& rhs );
+
+		[[nodiscard]] std::size_t lower_bound_key( std::uint16_t key ) const noexcept;
+		void erase_chunk( std::size_t index ) noexcept;
+
+		std::vector<std::uint16_t> m_keys;
+		std::vector<detail::compressed_container> m_containers;
+	};
+}
@@ -0,0 +1,614 @@
+#pragma once
+
+#include "mclo/container/slot_map_handle.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/numeric/pow2.hpp"
+#include "mclo/numeric/standard_integer_type.hpp"
+#include "mclo/platform/warnings.hpp"
+#include "mclo/threading/spin_mutex.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace mclo
+{
+	namespace detail
+	{
+		inline std::atomic_size_t concurrent_slot_map_next_thread_shard{ 0 };
+
+		/// @brief Shard a thread prefers to insert into, threads are assigned round robin on their first insert
+		[[nodiscard]] inline std::size_t concurrent_slot_map_thread_shard() noexcept
+		{
+			thread_local const std::size_t shard =
+				concurrent_slot_map_next_thread_shard.fetch_add( 1, std::memory_order_relaxed );
+			return shard;
+		}
+	}
+
+	MCLO_DISABLE_WARNINGS( MCLO_WARNING_ALIGNMENT_PADDING )
+	/// @brief A thread safe slot map with wait-free handle validation and lookup
+	/// @details Has the same handle semantics as dense_slot_map but is safe to use from many threads at once.
+	///
+	/// Values are never moved once inserted, each slot stores its generation in an atomic alongside the value in
+	/// segmented storage that never reallocates. is_valid and lookup are a bounds check plus two acquire loads so are
+	/// wait-free and never contend with each other or with writers.
+	///
+	/// The slots are split across ShardCount shards each with their own free list behind a spin lock. Inserting threads
+	/// start from a preferred shard and move on to the next one if it is locked, so uncontended inserts and erases only
+	/// hold a lock for the few instructions to pop or push the free list. Values are constructed and destroyed outside
+	/// the lock. Erasing is a compare exchange on the slot's generation so exactly one thread wins when several erase
+	/// the same handle.
+	///
+	/// Pros:
+	/// * is_valid and lookup are wait-free from any number of threads
+	/// * Insert and erase from different threads rarely contend
+	/// * Pointers to values are stable until their entry is erased
+	///
+	/// Cons:
+	/// * Values are not contiguous, as there is no compaction iteration must skip free slots
+	/// * Every slot has the overhead of an atomic generation and a free list link
+	///
+	/// @warning The container only synchronizes its own state, a value is destroyed as soon as its entry is erased so
+	/// the caller must make sure no other thread is still using a value it is erasing, as with any shared resource.
+	///
+	/// @tparam T The type of objects to store
+	/// @tparam HandleTotalBits Total number of bits for the handle type to use, smallest integer type to fit these bits
+	/// will be the handle representation type, defaults to a std::uint32_t.
+	/// @tparam GenerationBits Number of the total bits in the handle representation type used for generation checking,
+	/// defaults to 1/4 of the total bits.
+	/// @tparam ShardCount Number of independently locked shards, must be a power of two
+	/// @tparam Allocator The allocator used for the slot storage, it must be safe to use from multiple threads
+	template <typename T,
+			  std::size_t HandleTotalBits = sizeof( std::uint32_t ) * CHAR_BIT,
+			  std::size_t GenerationBits = HandleTotalBits / 4,
+			  std::size_t ShardCount = 16,
+			  typename Allocator = std::allocator<T>>
+	class concurrent_slot_map
+	{
+	public:
+		using handle_type = slot_map_handle<T, HandleTotalBits, GenerationBits>;
+		using value_type = T;
+		using allocator_type = Allocator;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using size_type = decltype( handle_type::max_index + 1 );
+
+		static_assert( std::is_object_v<value_type>,
+					   "The C++ Standard forbids containers of non-object types "
+					   "because of [container.requirements]." );
+		static_assert( mclo::is_pow2( ShardCount ), "ShardCount must be a power of two" );
+		static_assert( ShardCount <= ( handle_type::max_index + 1 ) / 2, "ShardCount too large for the handle index" );
+
+	private:
+		using representation_type = typename handle_type::representation_type;
+
+		/// @brief Generation in the upper bits and if the slot holds a value in the lowest bit
+		using state_type = uint_least_t<GenerationBits + 1>;
+		static_assert( std::atomic<state_type>::is_always_lock_free, "Slot state must be lock-free" );
+
+		static constexpr state_type alive_bit = 1;
+
+		struct slot
+		{
+			[[nodiscard]] pointer value() noexcept
+			{
+				return std::launder( reinterpret_cast<pointer>( storage ) );
+			}
+
+			std::atomic<state_type> state{ 0 };
+
+			/// @brief Next slot in the shard's free list, only accessed under the shard's lock
+			std::size_t next_free = 0;
+
+			alignas( value_type ) std::byte storage[ sizeof( value_type ) ];
+		};
+
+		using alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<slot>;
+		using slot_allocator = typename alloc_traits::allocator_type;
+
+		static constexpr std::size_t shard_bits = std::countr_zero( ShardCount );
+		static constexpr std::size_t shard_mask = ShardCount - 1;
+
+		// Slots of a shard are split into segments that double in size, the first two segments are the same size
+		static constexpr std::size_t first_segment_bits = 6;
+		static constexpr std::size_t first_segment_size = std::size_t( 1 ) << first_segment_bits;
+		static constexpr std::size_t max_shard_slots = std::size_t( handle_type::max_index + 1 ) >> shard_bits;
+
+		[[nodiscard]] static constexpr std::size_t segment_of( const std::size_t local_index ) noexcept
+		{
+			return static_cast<std::size_t>( std::bit_width( local_index >> first_segment_bits ) );
+		}
+
+		[[nodiscard]] static constexpr std::size_t segment_begin( const std::size_t segment ) noexcept
+		{
+			return segment == 0 ? 0 : first_segment_size << ( segment - 1 );
+		}
+
+		[[nodiscard]] static constexpr std::size_t segment_size( const std::size_t segment ) noexcept
+		{
+			return segment == 0 ? first_segment_size : first_segment_size << ( segment - 1 );
+		}
+
+		// Enough segments to hold the local index of any representable handle index, including the null handle, so
+		// lookups never need to bounds check the segment
+		static constexpr std::size_t num_segments = segment_of( max_shard_slots ) + 1;
+
+		static constexpr std::size_t no_slot = static_cast<std::size_t>( -1 );
+
+		struct shard
+		{
+			/// @brief Published with release once every slot in the segment is initialized, read by lookups
+			std::array<std::atomic<slot*>, num_segments> segments{};
+
+			// Writer state on its own cache line so inserting and erasing does not invalidate the segments readers use
+			alignas( std::hardware_destructive_interference_size ) spin_mutex mutex;
+
+			/// @brief Number of entries, updated outside of the lock so only approximate
+			std::atomic<std::size_t> size{ 0 };
+
+			std::size_t slot_count = 0;
+			std::size_t free_list_head = no_slot;
+			std::size_t free_list_tail = no_slot;
+		};
+
+		[[nodiscard]] static constexpr state_type alive_state( const representation_type generation ) noexcept
+		{
+			return static_cast<state_type>( ( generation << 1 ) | alive_bit );
+		}
+
+		[[nodiscard]] static constexpr state_type next_dead_state( const state_type state ) noexcept
+		{
+			// Increment generation, now remaining handles will mismatch on usage
+			return static_cast<state_type>( ( ( ( state >> 1 ) + 1 ) & handle_type::max_generation ) << 1 );
+		}
+
+	public:
+		concurrent_slot_map() noexcept( std::is_nothrow_default_constructible_v<allocator_type> ) = default;
+
+		explicit concurrent_slot_map( const allocator_type& allocator ) noexcept
+			: m_allocator( allocator )
+		{
+		}
+
+		explicit concurrent_slot_map( const size_type slot_count, const allocator_type& allocator = allocator_type() )
+			: concurrent_slot_map( allocator )
+		{
+			reserve_slots( slot_count );
+		}
+
+		concurrent_slot_map( const concurrent_slot_map& ) = delete;
+		concurrent_slot_map& operator=( const concurrent_slot_map& ) = delete;
+
+		~concurrent_slot_map()
+		{
+			for ( shard& current_shard : m_shards )
+			{
+				for ( std::size_t segment = 0; segment < num_segments; ++segment )
+				{
+					slot* const slots = current_shard.segments[ segment ].load( std::memory_order_relaxed );
+					if ( !slots )
+					{
+						break;
+					}
+					const std::size_t count = segment_size( segment );
+					for ( std::size_t index = 0; index < count; ++index )
+					{
+						if ( slots[ index ].state.load( std::memory_order_relaxed ) & alive_bit )
+						{
+							std::destroy_at( slots[ index ].value() );
+						}
+					}
+					std::destroy_n( slots, count );
+					alloc_traits::deallocate(
+						m_allocator, std::pointer_traits<typename alloc_traits::pointer>::pointer_to( *slots ), count );
+				}
+			}
+		}
+
+		/// @brief Emplace an entry into the slot map constructed from arguments
+		/// @details Thread safe, the value is constructed outside of any lock.
+		/// @post Provides a strong exception guarantee, if an exception is thrown no entry is added
+		/// @tparam ...Args Type of arguments to construct from
+		/// @param ...arguments Arguments to construct from
+		/// @return handle to the created entry
+		template <typename... Args>
+		[[nodiscard]] handle_type emplace( Args&&... arguments )
+		{
+			const auto [ shard_index, local_index ] = acquire_slot();
+			shard& current_shard = m_shards[ shard_index ];
+			slot& current_slot = slot_at( current_shard, local_index );
+
+			try
+			{
+				std::construct_at( current_slot.value(), std::forward<Args>( arguments )... );
+			}
+			catch ( ... )
+			{
+				// Never published so the generation is unchanged, any handle to its last occupant stays invalid
+				release_slot( current_shard, local_index );
+				throw;
+			}
+
+			// Only this thread owns the slot until it is published
+			const state_type state = current_slot.state.load( std::memory_order_relaxed );
+			current_slot.state.store( static_cast<state_type>( state | alive_bit ), std::memory_order_release );
+			current_shard.size.fetch_add( 1, std::memory_order_relaxed );
+
+			handle_type handle;
+			handle.index = static_cast<representation_type>( ( local_index << shard_bits ) | shard_index );
+			handle.generation = static_cast<representation_type>( state >> 1 );
+			return handle;
+		}
+
+		/// @brief Insert a copy of object into the slot map
+		/// @post Provides a strong exception guarantee, if an exception is thrown no entry is added
+		/// @param object The object to copy into the slot map
+		/// @return handle to the created entry
+		[[nodiscard]] handle_type insert( const_reference object )
+		{
+			return emplace( object );
+		}
+
+		/// @brief Insert object into the slot map by move
+		/// @post Provides a strong exception guarantee, if an exception is thrown no entry is added
+		/// @param object The object to move into the slot map
+		/// @return handle to the created entry
+		[[nodiscard]] handle_type insert( value_type&& object )
+		{
+			return emplace( std::move( object ) );
+		}
+
+		/// @brief Erase an entry in the slot map from its handle
+		/// @details Thread safe, if multiple threads erase the same handle only one of them erases it.
+		/// @param handle The handle to the entry to erase
+		/// @return If this call erased the entry
+		bool erase( const handle_type handle ) noexcept
+		{
+			slot* const found = claim( handle );
+			if ( !found )
+			{
+				return false;
+			}
+			std::destroy_at( found->value() );
+			release_erased( handle );
+			return true;
+		}
+
+		/// @brief Erase the element at the handle if it exists returning the data it contained, else return an empty
+		/// optional
+		/// @details Thread safe, if multiple threads pop the same handle only one of them gets the data.
+		/// @param handle The handle to move the data from then erase
+		/// @return Contains the data at the handle's location, else an empty optional
+		[[nodiscard]] std::optional<value_type> pop( const handle_type handle ) noexcept(
+			std::is_nothrow_move_constructible_v<T> )
+		{
+			slot* const found = claim( handle );
+			if ( !found )
+			{
+				return std::nullopt;
+			}
+
+			struct release_guard
+			{
+				~release_guard()
+				{
+					std::destroy_at( found->value() );
+					map->release_erased( handle );
+				}
+
+				concurrent_slot_map* map;
+				slot* found;
+				handle_type handle;
+			} guard{ this, found, handle };
+
+			return std::optional<value_type>( std::move( *found->value() ) );
+		}
+
+		/// @brief Check if a handle is a valid entry into the slot map
+		/// @details Wait-free, safe to call concurrently with any other thread safe operation.
+		/// @param handle The handle to check
+		/// @return If the handle refers to a valid entry in the slot map at the time of the call
+		[[nodiscard]] bool is_valid( const handle_type handle ) const noexcept
+		{
+			return find( handle ) != nullptr;
+		}
+
+		/// @brief Lookup an entry in the slot map
+		/// @details Wait-free, safe to call concurrently with any other thread safe operation.
+		/// @param handle The handle to lookup
+		/// @return Const pointer to the object the handle refers to, or nullptr if an invalid handle
+		[[nodiscard]] const_pointer lookup( const handle_type handle ) const noexcept
+		{
+			slot* const found = find( handle );
+			return found ? found->value() : nullptr;
+		}
+
+		/// @brief Lookup an entry in the slot map
+		/// @details Wait-free, safe to call concurrently with any other thread safe operation.
+		/// @param handle The handle to lookup
+		/// @return Mutable pointer to the object the handle refers to, or nullptr if an invalid handle
+		[[nodiscard]] pointer lookup( const handle_type handle ) noexcept
+		{
+			slot* const found = find( handle );
+			return found ? found->value() : nullptr;
+		}
+
+		/// @brief Invoke func with every entry in the slot map
+		/// @details Entries inserted or erased concurrently may or may not be visited.
+		/// @warning Must not run concurrently with erasing any entry that could be visited
+		/// @param func Function to invoke with the handle and a reference to each entry
+		template <typename Func>
+		void for_each( Func func )
+		{
+			for ( std::size_t shard_index = 0; shard_index < ShardCount; ++shard_index )
+			{
+				shard& current_shard = m_shards[ shard_index ];
+				for ( std::size_t segment = 0; segment < num_segments; ++segment )
+				{
+					slot* const slots = current_shard.segments[ segment ].load( std::memory_order_acquire );
+					if ( !slots )
+					{
+						break;
+					}
+					const std::size_t begin = segment_begin( segment );
+					const std::size_t count = segment_size( segment );
+					for ( std::size_t index = 0; index < count; ++index )
+					{
+						const state_type state = slots[ index ].state.load( std::memory_order_acquire );
+						if ( state & alive_bit )
+						{
+							handle_type handle;
+							handle.index =
+								static_cast<representation_type>( ( ( begin + index ) << shard_bits ) | shard_index );
+							handle.generation = static_cast<representation_type>( state >> 1 );
+							func( handle, *slots[ index ].value() );
+						}
+					}
+				}
+			}
+		}
+
+		/// @brief Reserve storage for amount slots so inserts do not allocate
+		/// @details Thread safe, slots are spread evenly over the shards.
+		/// @param amount The number of slots to reserve for
+		void reserve_slots( const size_type amount )
+		{
+			if ( static_cast<std::size_t>( amount ) > max_size() ) [[unlikely]]
+			{
+				throw_too_big();
+			}
+			const std::size_t per_shard = ( static_cast<std::size_t>( amount ) + shard_mask ) >> shard_bits;
+			if ( per_shard == 0 )
+			{
+				return;
+			}
+			for ( shard& current_shard : m_shards )
+			{
+				std::scoped_lock lock( current_shard.mutex );
+				const std::size_t last_segment = segment_of( per_shard - 1 );
+				for ( std::size_t segment = 0; segment <= last_segment; ++segment )
+				{
+					ensure_segment( current_shard, segment );
+				}
+			}
+		}
+
+		/// @brief Destroy all active elements and put all slots back into the free list
+		/// @details Increases the generation counter of all slots in use, so existing handles are valid to use
+		/// @warning Not thread safe, no other operations may run concurrently
+		void clear() noexcept
+		{
+			for ( shard& current_shard : m_shards )
+			{
+				for ( std::size_t local_index = 0; local_index < current_shard.slot_count; ++local_index )
+				{
+					slot& current_slot = slot_at( current_shard, local_index );
+					const state_type state = current_slot.state.load( std::memory_order_relaxed );
+					if ( state & alive_bit )
+					{
+						std::destroy_at( current_slot.value() );
+						current_slot.state.store( next_dead_state( state ), std::memory_order_relaxed );
+						push_free_list( current_shard, local_index );
+					}
+				}
+				current_shard.size.store( 0, std::memory_order_relaxed );
+			}
+		}
+
+		/// @brief Get the number of entries
+		/// @details With concurrent modification this is only a snapshot
+		[[nodiscard]] size_type size() const noexcept
+		{
+			std::size_t result = 0;
+			for ( const shard& current_shard : m_shards )
+			{
+				result += current_shard.size.load( std::memory_order_relaxed );
+			}
+			return static_cast<size_type>( result );
+		}
+
+		/// @brief Check if there are no entries
+		/// @details With concurrent modification this is only a snapshot
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		/// @brief Get the maximum number of entries
+		[[nodiscard]] static constexpr size_type max_size() noexcept
+		{
+			return static_cast<size_type>( max_shard_slots << shard_bits );
+		}
+
+		/// @brief Get the allocator used
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return allocator_type( m_allocator );
+		}
+
+	private:
+		[[noreturn]] static void throw_too_big()
+		{
+			throw std::length_error( "Slot map too large for maximum handle index" );
+		}
+
+		[[nodiscard]] static slot& slot_at( const shard& current_shard, const std::size_t local_index ) noexcept
+		{
+			const std::size_t segment = segment_of( local_index );
+			slot* const slots = current_shard.segments[ segment ].load( std::memory_order_acquire );
+			MCLO_DEBUG_ASSERT( slots, "Segment for slot not allocated" );
+			return slots[ local_index - segment_begin( segment ) ];
+		}
+
+		[[nodiscard]] slot* find( const handle_type handle ) const noexcept
+		{
+			const std::size_t index = handle.index;
+			const std::size_t local_index = index >> shard_bits;
+			const std::size_t segment = segment_of( local_index );
+			slot* const slots = m_shards[ index & shard_mask ].segments[ segment ].load( std::memory_order_acquire );
+			if ( !slots ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			slot& found = slots[ local_index - segment_begin( segment ) ];
+			const state_type state = found.state.load( std::memory_order_acquire );
+			return state == alive_state( handle.generation ) ? &found : nullptr;
+		}
+
+		/// @brief Atomically mark the entry as dead so only this thread destroys it
+		[[nodiscard]] slot* claim( const handle_type handle ) noexcept
+		{
+			slot* const found = find( handle );
+			if ( !found )
+			{
+				return nullptr;
+			}
+			state_type expected = alive_state( handle.generation );
+			if ( !found->state.compare_exchange_strong(
+					 expected, next_dead_state( expected ), std::memory_order_acq_rel, std::memory_order_relaxed ) )
+			{
+				return nullptr;
+			}
+			return found;
+		}
+
+		void release_erased( const handle_type handle ) noexcept
+		{
+			shard& current_shard = m_shards[ handle.index & shard_mask ];
+			current_shard.size.fetch_sub( 1, std::memory_order_relaxed );
+			release_slot( current_shard, static_cast<std::size_t>( handle.index ) >> shard_bits );
+		}
+
+		void ensure_segment( shard& current_shard, const std::size_t segment )
+		{
+			std::atomic<slot*>& segment_ptr = current_shard.segments[ segment ];
+			if ( segment_ptr.load( std::memory_order_relaxed ) )
+			{
+				return;
+			}
+			const std::size_t count = segment_size( segment );
+			slot* const slots = std::to_address( alloc_traits::allocate( m_allocator, count ) );
+			std::uninitialized_value_construct_n( slots, count );
+			segment_ptr.store( slots, std::memory_order_release );
+		}
+
+		/// @brief Pop a slot from the free list of the first shard available, growing the shard if it has none free
+		/// @return Shard index and local index of the slot taken
+		[[nodiscard]] std::pair<std::size_t, std::size_t> acquire_slot()
+		{
+			const std::size_t preferred = detail::concurrent_slot_map_thread_shard();
+
+			// First look for a shard no other thread is using, then fall back to waiting on the preferred ones
+			for ( std::size_t offset = 0; offset < ShardCount; ++offset )
+			{
+				const std::size_t shard_index = ( preferred + offset ) & shard_mask;
+				shard& current_shard = m_shards[ shard_index ];
+				std::unique_lock lock( current_shard.mutex, std::try_to_lock );
+				if ( lock.owns_lock() )
+				{
+					const std::size_t local_index = try_pop_slot( current_shard );
+					if ( local_index != no_slot )
+					{
+						return { shard_index, local_index };
+					}
+				}
+			}
+			for ( std::size_t offset = 0; offset < ShardCount; ++offset )
+			{
+				const std::size_t shard_index = ( preferred + offset ) & shard_mask;
+				shard& current_shard = m_shards[ shard_index ];
+				std::scoped_lock lock( current_shard.mutex );
+				const std::size_t local_index = try_pop_slot( current_shard );
+				if ( local_index != no_slot )
+				{
+					return { shard_index, local_index };
+				}
+			}
+			throw_too_big();
+		}
+
+		/// @pre The shard's lock is held
+		[[nodiscard]] std::size_t try_pop_slot( shard& current_shard )
+		{
+			std::size_t local_index = current_shard.free_list_head;
+			if ( local_index != no_slot )
+			{
+				if ( local_index == current_shard.free_list_tail )
+				{
+					current_shard.free_list_head = current_shard.free_list_tail = no_slot;
+				}
+				else
+				{
+					current_shard.free_list_head = slot_at( current_shard, local_index ).next_free;
+				}
+				return local_index;
+			}
+
+			local_index = current_shard.slot_count;
+			if ( local_index == max_shard_slots )
+			{
+				return no_slot;
+			}
+			ensure_segment( current_shard, segment_of( local_index ) );
+			++current_shard.slot_count;
+			return local_index;
+		}
+
+		void release_slot( shard& current_shard, const std::size_t local_index ) noexcept
+		{
+			std::scoped_lock lock( current_shard.mutex );
+			push_free_list( current_shard, local_index );
+		}
+
+		/// @pre The shard's lock is held or no other thread is using the map
+		static void push_free_list( shard& current_shard, const std::size_t local_index ) noexcept
+		{
+			// Freed slots go to the back of the free list so a slot's generation advances as slowly as possible
+			if ( current_shard.free_list_head == no_slot )
+			{
+				current_shard.free_list_head = local_index;
+			}
+			else
+			{
+				slot_at( current_shard, current_shard.free_list_tail ).next_free = local_index;
+			}
+			current_shard.free_list_tail = local_index;
+		}
+
+		std::array<shard, ShardCount> m_shards;
+		[[no_unique_address]] slot_allocator m_allocator;
+	};
+	MCLO_RESTORE_WARNINGS
+}
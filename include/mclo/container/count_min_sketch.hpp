@@ -0,0 +1,171 @@
+#pragma once
+
+#include "mclo/container/detail/filter_common.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/hash/rapidhash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A count-min sketch, estimating how many times each key occurs in a stream in a fixed amount of memory.
+	/// @details A grid of @c depth rows of @c width counters, each key adds its count to one counter per row picked by
+	/// double hashing a single hash of the key. The estimate of a key is the smallest of its counters, which never
+	/// underestimates and with probability @c 1-delta overestimates by at most @c epsilon times the total count, see
+	/// @ref with_error to size for a bound.
+	///
+	/// Sketches of the same size and @p Hasher @ref merge by adding their counters, giving exactly the sketch of both
+	/// streams.
+	/// @tparam Key The key type.
+	/// @tparam Hasher The hasher used to hash keys.
+	/// @tparam Counter The unsigned integer type of the counters, must be wide enough for the total count.
+	template <typename Key, hasher Hasher = mclo::rapidhash, std::unsigned_integral Counter = std::uint32_t>
+		requires( hashable_with<Key, Hasher> && std::default_initializable<Hasher> )
+	class count_min_sketch
+	{
+	public:
+		using key_type = Key;
+		using hasher_type = Hasher;
+		using counter_type = Counter;
+		using size_type = std::size_t;
+
+		/// @brief Construct an empty sketch with a given size.
+		/// @param width The number of counters per row, must not be zero.
+		/// @param depth The number of rows, must not be zero.
+		count_min_sketch( const size_type width, const size_type depth )
+			: m_counters( width * depth )
+			, m_width( width )
+			, m_depth( depth )
+		{
+			MCLO_DEBUG_ASSERT( width != 0, "A count-min sketch needs columns" );
+			MCLO_DEBUG_ASSERT( depth != 0, "A count-min sketch needs rows" );
+		}
+
+		/// @brief Construct an empty sketch sized for an error bound.
+		/// @param epsilon The largest overestimate as a fraction of the total count, must be positive.
+		/// @param delta The probability an estimate exceeds the bound, in (0, 1).
+		/// @return The sketch of width @c e/epsilon and depth @c ln(1/delta).
+		[[nodiscard]] static count_min_sketch with_error( const double epsilon, const double delta )
+		{
+			MCLO_DEBUG_ASSERT( epsilon > 0, "Epsilon must be positive", epsilon );
+			MCLO_DEBUG_ASSERT( delta > 0 && delta < 1, "Delta must be in (0, 1)", delta );
+			const double width = std::ceil( std::numbers::e / epsilon );
+			const double depth = std::ceil( -std::log( delta ) );
+			return count_min_sketch( static_cast<size_type>( width ),
+									 std::max<size_type>( 1, static_cast<size_type>( depth ) ) );
+		}
+
+		/// @brief Add to the count of a key.
+		/// @param key The key to count.
+		/// @param count The number of occurrences to add.
+		void insert( const Key& key, const Counter count = 1 ) noexcept
+		{
+			insert_hash( hash_object<Hasher>( key ), count );
+		}
+
+		/// @brief Add to the count of a key by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		/// @param count The number of occurrences to add.
+		void insert_hash( const std::size_t hash, const Counter count = 1 ) noexcept
+		{
+			detail::filter_probe probes( hash );
+			Counter* row = m_counters.data();
+			for ( size_type index = 0; index < m_depth; ++index, row += m_width )
+			{
+				row[ probes.next( m_width ) ] += count;
+			}
+			m_total += count;
+		}
+
+		/// @brief Count one occurrence of every key of a range, hashing them in bulk.
+		/// @param keys The keys to count.
+		template <std::ranges::forward_range Range>
+			requires( std::same_as<std::ranges::range_value_t<Range>, Key> )
+		void insert_many( Range&& keys ) noexcept
+		{
+			const auto insert_batch = [ this ]( const std::size_t* const hashes, const size_type count, size_type ) {
+				for ( size_type index = 0; index < count; ++index )
+				{
+					insert_hash( hashes[ index ] );
+				}
+			};
+			detail::for_each_hash_batch<Key, Hasher>( keys, insert_batch );
+		}
+
+		/// @brief Estimate the count of a key.
+		/// @return At least the true count of @p key.
+		[[nodiscard]] Counter estimate( const Key& key ) const noexcept
+		{
+			return estimate_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Estimate the count of a key by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		/// @return At least the true count of the key.
+		[[nodiscard]] Counter estimate_hash( const std::size_t hash ) const noexcept
+		{
+			detail::filter_probe probes( hash );
+			Counter result = std::numeric_limits<Counter>::max();
+			const Counter* row = m_counters.data();
+			for ( size_type index = 0; index < m_depth; ++index, row += m_width )
+			{
+				result = std::min( result, row[ probes.next( m_width ) ] );
+			}
+			return result;
+		}
+
+		/// @brief Merge another sketch into this one, giving the sketch of both streams.
+		/// @param other The sketch to merge, must have the same width and depth.
+		void merge( const count_min_sketch& other ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( m_width == other.m_width && m_depth == other.m_depth,
+							   "Can only merge count-min sketches of the same size" );
+			std::transform( m_counters.begin(),
+							m_counters.end(),
+							other.m_counters.begin(),
+							m_counters.begin(),
+							[]( const Counter lhs, const Counter rhs ) { return static_cast<Counter>( lhs + rhs ); } );
+			m_total += other.m_total;
+		}
+
+		/// @brief Reset every count to zero.
+		void clear() noexcept
+		{
+			std::fill( m_counters.begin(), m_counters.end(), Counter{ 0 } );
+			m_total = 0;
+		}
+
+		/// @brief Get the sum of every count added.
+		[[nodiscard]] Counter total() const noexcept
+		{
+			return m_total;
+		}
+
+		/// @brief Get the number of counters per row.
+		[[nodiscard]] size_type width() const noexcept
+		{
+			return m_width;
+		}
+
+		/// @brief Get the number of rows.
+		[[nodiscard]] size_type depth() const noexcept
+		{
+			return m_depth;
+		}
+
+	private:
+		std::vector<Counter> m_counters;
+		size_type m_width;
+		size_type m_depth;
+		Counter m_total = 0;
+	};
+}
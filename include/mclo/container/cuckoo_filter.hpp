@@ -0,0 +1,375 @@
+#pragma once
+
+#include "mclo/container/detail/filter_common.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/hash/rapidhash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A cuckoo filter, a compact set that can say a key is definitely absent or probably present and that
+	/// supports erasing keys.
+	/// @details Stores a small fingerprint of each key in one of two buckets of four slots, the second bucket derived
+	/// from the first and the fingerprint alone so a fingerprint can be moved between its buckets without the key.
+	/// Inserting into two full buckets evicts a fingerprint to its other bucket, repeating up to a limit. A lookup
+	/// checks the eight slots of two buckets, each bucket a single small load.
+	///
+	/// The false positive rate is about @c 8/2^b for @c b fingerprint bits, so 16 bit fingerprints give roughly 0.012%
+	/// and 8 bit ones 3%. The filter is sized for a capacity up front and does not grow. Once an insert runs out of
+	/// evictions the homeless fingerprint is kept aside and the filter reports itself full, later inserts fail until a
+	/// key is erased.
+	///
+	/// Only erase keys that were inserted, erasing a false positive removes some other key's fingerprint. Inserting a
+	/// key twice stores it twice, it must be erased twice to be removed.
+	///
+	/// Keys are hashed with @ref hash_object using @p Hasher. The serialized form is the buckets in native endianness
+	/// and is only valid for the same @p Key, @p Hasher and @p Fingerprint.
+	/// @tparam Key The key type.
+	/// @tparam Hasher The hasher used to hash keys.
+	/// @tparam Fingerprint The unsigned integer type storing fingerprints, larger types have fewer false positives.
+	template <typename Key, hasher Hasher = mclo::rapidhash, std::unsigned_integral Fingerprint = std::uint16_t>
+		requires( hashable_with<Key, Hasher> && std::default_initializable<Hasher> && sizeof( Fingerprint ) <= 4 )
+	class cuckoo_filter
+	{
+		static constexpr std::size_t slots_per_bucket = 4;
+		using bucket_type = std::array<Fingerprint, slots_per_bucket>;
+
+		static constexpr std::uint64_t magic = UINT64_C( 0x31464b434f4c434d ); // "MCLOCKF1" little endian
+		static constexpr std::size_t header_words = 7;
+		static constexpr unsigned fingerprint_bits = std::numeric_limits<Fingerprint>::digits;
+
+		// Zero marks an empty slot so is never a fingerprint
+		static constexpr Fingerprint empty_slot = 0;
+
+		// Load factor a filter of four slot buckets reliably reaches before inserts start to fail
+		static constexpr double max_load_factor = 0.95;
+
+		static constexpr std::size_t max_kicks = 500;
+
+	public:
+		using key_type = Key;
+		using hasher_type = Hasher;
+		using fingerprint_type = Fingerprint;
+		using size_type = std::size_t;
+
+		/// @brief Construct an empty filter able to hold at least some number of keys.
+		/// @param capacity The number of keys the filter must hold, the number of buckets is rounded up to a power of
+		/// two so it usually holds more.
+		explicit cuckoo_filter( const size_type capacity )
+			: m_buckets( num_buckets_for( capacity ) )
+		{
+		}
+
+		/// @brief Insert a key.
+		/// @return False if the filter is full and the key was not inserted.
+		[[nodiscard]] bool insert( const Key& key ) noexcept
+		{
+			return insert_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Insert a key by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		/// @return False if the filter is full and the key was not inserted.
+		[[nodiscard]] bool insert_hash( const std::size_t hash ) noexcept
+		{
+			if ( m_victim.used )
+			{
+				return false;
+			}
+			const location loc = locate( hash );
+			place( loc.index, loc.fingerprint );
+			++m_size;
+			return true;
+		}
+
+		/// @brief Check if a key may be in the filter.
+		/// @return False if the key is not in the filter, true if it probably is.
+		[[nodiscard]] bool contains( const Key& key ) const noexcept
+		{
+			return contains_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Check if a key may be in the filter by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		/// @return False if the key is not in the filter, true if it probably is.
+		[[nodiscard]] bool contains_hash( const std::size_t hash ) const noexcept
+		{
+			const location loc = locate( hash );
+			const size_type other = alternate_index( loc.index, loc.fingerprint );
+			const bucket_type& first = m_buckets[ loc.index ];
+			const bucket_type& second = m_buckets[ other ];
+
+			// Check all eight slots without branching, the buckets are loaded either way
+			bool found = false;
+			for ( size_type slot = 0; slot < slots_per_bucket; ++slot )
+			{
+				found |= ( first[ slot ] == loc.fingerprint ) | ( second[ slot ] == loc.fingerprint );
+			}
+			return found || victim_matches( loc.index, other, loc.fingerprint );
+		}
+
+		/// @brief Erase one copy of a key.
+		/// @return True if a matching fingerprint was found and removed.
+		bool erase( const Key& key ) noexcept
+		{
+			return erase_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Erase one copy of a key by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		/// @return True if a matching fingerprint was found and removed.
+		bool erase_hash( const std::size_t hash ) noexcept
+		{
+			const location loc = locate( hash );
+			const size_type other = alternate_index( loc.index, loc.fingerprint );
+			if ( remove_from_bucket( loc.index, loc.fingerprint ) || remove_from_bucket( other, loc.fingerprint ) )
+			{
+				--m_size;
+				// A slot is now free, give the homeless fingerprint another chance to find a bucket
+				if ( m_victim.used )
+				{
+					m_victim.used = false;
+					place( m_victim.index, m_victim.fingerprint );
+				}
+				return true;
+			}
+			if ( victim_matches( loc.index, other, loc.fingerprint ) )
+			{
+				m_victim.used = false;
+				--m_size;
+				return true;
+			}
+			return false;
+		}
+
+		/// @brief Remove every key.
+		void clear() noexcept
+		{
+			std::fill( m_buckets.begin(), m_buckets.end(), bucket_type{} );
+			m_victim = {};
+			m_size = 0;
+		}
+
+		/// @brief Get the number of keys in the filter.
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_size;
+		}
+
+		/// @brief Check if the filter holds no keys.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		/// @brief Check if the filter is full, inserts fail until a key is erased.
+		[[nodiscard]] bool full() const noexcept
+		{
+			return m_victim.used;
+		}
+
+		/// @brief Get the number of fingerprint slots, an upper bound on the keys the filter can hold.
+		[[nodiscard]] size_type capacity() const noexcept
+		{
+			return m_buckets.size() * slots_per_bucket;
+		}
+
+		/// @brief Get the fraction of slots in use.
+		[[nodiscard]] double load_factor() const noexcept
+		{
+			return static_cast<double>( m_size ) / static_cast<double>( capacity() );
+		}
+
+		/// @brief Get the number of bytes @ref serialize writes.
+		[[nodiscard]] size_type serialized_size() const noexcept
+		{
+			return detail::filter_serialized_size<bucket_type>( header_words, m_buckets.size() );
+		}
+
+		/// @brief Serialize the filter.
+		/// @param out Buffer to write into, must be at least @ref serialized_size bytes.
+		/// @return The number of bytes written.
+		size_type serialize( const mclo::span<std::byte> out ) const noexcept
+		{
+			const std::array<std::uint64_t, header_words> header{ magic,
+																   m_buckets.size(),
+																   m_size,
+																   fingerprint_bits,
+																   m_victim.used,
+																   m_victim.fingerprint,
+																   m_victim.index };
+			return detail::serialize_filter<bucket_type>( header, mclo::span<const bucket_type>( m_buckets ), out );
+		}
+
+		/// @brief Serialize the filter.
+		/// @return The serialized bytes.
+		[[nodiscard]] std::vector<std::byte> serialize() const
+		{
+			std::vector<std::byte> result( serialized_size() );
+			serialize( result );
+			return result;
+		}
+
+		/// @brief Deserialize a filter, copying it out of @p data.
+		/// @param data The serialized bytes, trailing bytes are ignored.
+		/// @return The filter, or @c std::nullopt if @p data is not a valid serialized filter.
+		[[nodiscard]] static std::optional<cuckoo_filter> deserialize( const mclo::span<const std::byte> data )
+		{
+			const auto header = detail::read_filter_header<header_words>( data, magic );
+			if ( !header )
+			{
+				return std::nullopt;
+			}
+			const std::uint64_t num_buckets = ( *header )[ 1 ];
+			const std::uint64_t size = ( *header )[ 2 ];
+			const std::uint64_t bits = ( *header )[ 3 ];
+			const std::uint64_t victim_used = ( *header )[ 4 ];
+			const std::uint64_t victim_fingerprint = ( *header )[ 5 ];
+			const std::uint64_t victim_index = ( *header )[ 6 ];
+			if ( num_buckets == 0 || !std::has_single_bit( num_buckets ) ||
+				 num_buckets > data.size() / sizeof( bucket_type ) || bits != fingerprint_bits ||
+				 size > num_buckets * slots_per_bucket + 1 || victim_used > 1 ||
+				 ( victim_used &&
+				   ( victim_fingerprint == empty_slot || victim_fingerprint > std::numeric_limits<Fingerprint>::max() ||
+					 victim_index >= num_buckets ) ) )
+			{
+				return std::nullopt;
+			}
+
+			cuckoo_filter result;
+			result.m_buckets.resize( static_cast<size_type>( num_buckets ) );
+			if ( !detail::read_filter_words<bucket_type, header_words>( data,
+																		mclo::span<bucket_type>( result.m_buckets ) ) )
+			{
+				return std::nullopt;
+			}
+			result.m_size = static_cast<size_type>( size );
+			if ( victim_used )
+			{
+				result.m_victim = {
+					static_cast<size_type>( victim_index ), static_cast<Fingerprint>( victim_fingerprint ), true };
+			}
+			return result;
+		}
+
+	private:
+		struct location
+		{
+			size_type index;
+			Fingerprint fingerprint;
+		};
+
+		/// @brief A fingerprint that could not be placed and the bucket it was last evicted for
+		struct victim
+		{
+			size_type index = 0;
+			Fingerprint fingerprint = empty_slot;
+			bool used = false;
+		};
+
+		cuckoo_filter() = default;
+
+		[[nodiscard]] static size_type num_buckets_for( const size_type capacity ) noexcept
+		{
+			const double buckets =
+				std::ceil( static_cast<double>( capacity ) / ( slots_per_bucket * max_load_factor ) );
+			return std::bit_ceil( std::max<size_type>( 1, static_cast<size_type>( buckets ) ) );
+		}
+
+		[[nodiscard]] size_type bucket_mask() const noexcept
+		{
+			return m_buckets.size() - 1;
+		}
+
+		/// @brief The first bucket from the low bits of the mixed hash and the fingerprint from the high bits
+		[[nodiscard]] location locate( const std::size_t hash ) const noexcept
+		{
+			const std::uint64_t mixed = detail::filter_mix( hash );
+			auto fingerprint = static_cast<Fingerprint>( mixed >> ( 64 - fingerprint_bits ) );
+			fingerprint += static_cast<Fingerprint>( fingerprint == empty_slot );
+			return { static_cast<size_type>( mixed ) & bucket_mask(), fingerprint };
+		}
+
+		/// @brief Partial key cuckoo hashing, XOR with a hash of the fingerprint so applying it twice gives back index
+		[[nodiscard]] size_type alternate_index( const size_type index, const Fingerprint fingerprint ) const noexcept
+		{
+			const std::uint64_t fingerprint_hash = static_cast<std::uint64_t>( fingerprint ) * UINT64_C( 0x5bd1e995 );
+			return ( index ^ static_cast<size_type>( fingerprint_hash ) ) & bucket_mask();
+		}
+
+		[[nodiscard]] bool victim_matches( const size_type index,
+										   const size_type other,
+										   const Fingerprint fingerprint ) const noexcept
+		{
+			return m_victim.used && m_victim.fingerprint == fingerprint &&
+				   ( m_victim.index == index || m_victim.index == other );
+		}
+
+		bool add_to_bucket( const size_type index, const Fingerprint fingerprint ) noexcept
+		{
+			bucket_type& bucket = m_buckets[ index ];
+			const auto it = std::find( bucket.begin(), bucket.end(), empty_slot );
+			if ( it == bucket.end() )
+			{
+				return false;
+			}
+			*it = fingerprint;
+			return true;
+		}
+
+		bool remove_from_bucket( const size_type index, const Fingerprint fingerprint ) noexcept
+		{
+			bucket_type& bucket = m_buckets[ index ];
+			const auto it = std::find( bucket.begin(), bucket.end(), fingerprint );
+			if ( it == bucket.end() )
+			{
+				return false;
+			}
+			*it = empty_slot;
+			return true;
+		}
+
+		/// @brief Place a fingerprint in either of its buckets, making room by relocating others if both are full
+		void place( const size_type index, const Fingerprint fingerprint ) noexcept
+		{
+			if ( !add_to_bucket( index, fingerprint ) &&
+				 !add_to_bucket( alternate_index( index, fingerprint ), fingerprint ) )
+			{
+				relocate( index, fingerprint );
+			}
+		}
+
+		/// @brief Place a fingerprint whose buckets may both be full by evicting others to their alternate buckets
+		/// @details The slot to evict is picked from the fingerprint and attempt so the filter is deterministic. If
+		/// every attempt is used up the last evicted fingerprint becomes the victim and the filter is full.
+		void relocate( size_type index, Fingerprint fingerprint ) noexcept
+		{
+			for ( size_type kick = 0; kick < max_kicks; ++kick )
+			{
+				const size_type slot = ( static_cast<size_type>( fingerprint ) + kick ) % slots_per_bucket;
+				std::swap( fingerprint, m_buckets[ index ][ slot ] );
+				index = alternate_index( index, fingerprint );
+				if ( add_to_bucket( index, fingerprint ) )
+				{
+					return;
+				}
+			}
+			m_victim = { index, fingerprint, true };
+		}
+
+		std::vector<bucket_type> m_buckets;
+		size_type m_size = 0;
+		victim m_victim;
+	};
+}
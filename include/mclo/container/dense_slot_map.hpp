@@ -1,7 +1,10 @@
 #pragma once
 
+#include "mclo/container/detail/slot_map_indirection.hpp"
 #include "mclo/container/slot_map_handle.hpp"
+#include "mclo/container/span.hpp"
 #include "mclo/debug/assert.hpp"
+#include "mclo/memory/prefetch.hpp"
 #include "mclo/numeric/math.hpp"
 #include "mclo/platform/attributes.hpp"
 
@@ -537,51 +540,113 @@ namespace mclo
 			return emplace( std::move( object ) );
 		}
 
-		/// @brief Reserve space for amount slots
-		/// @post Provides a basic exception guarantee, if an exception is thrown invariants are held and no leaks occur
-		/// @details Beneficial as allocating more slots than values causes the generations to increase
-		/// more evenly distributed across the slots compared to recycling the same slots forever.
-		/// @param amount The number of slots to reserve for
-		void reserve_slots( const size_type amount )
+		/// @brief Insert a batch of objects, reserving space for all of them up front
+		/// @post Provides a basic exception guarantee, if an exception is thrown the objects inserted before it remain
+		/// and their handles have been written
+		/// @param first Iterator to the first object to insert, out_handles.size() objects are read from it
+		/// @param out_handles Span to write the handle of each inserted object to
+		template <std::input_iterator InputIt>
+		void insert_n( InputIt first, const mclo::span<handle_type> out_handles )
 		{
-			if ( amount > max_size() ) [[unlikely]]
+			const size_type count = static_cast<size_type>( out_handles.size() );
+			if ( out_handles.size() > static_cast<std::size_t>( max_size() - size() ) ) [[unlikely]]
 			{
 				throw_too_big();
 			}
+			reserve( size() + count );
 
-			m_slot_indirection.reserve( amount );
-
-			const size_type old_num_slots = slot_count();
+			// Space for the data and free slots are reserved so no insert in the batch can allocate
+			for ( handle_type& handle : out_handles )
+			{
+				handle = emplace_and_get_with_guard<noop_guard>( *first ).handle;
+				++first;
+			}
+		}
 
-			// If we reserved more slots then link into the free list
-			// This links the new slots in reverse order and inserts them as the new head, this is because
-			// they have fresh generation counters so we want to use them up first instead of ones with
-			// potentially higher and uneven distribution of generations
-			if ( old_num_slots < amount )
+		/// @brief Erase a batch of entries from their handles, invalid handles are skipped
+		/// @param handles The handles to the objects to erase
+		/// @return Number of entries erased
+		size_type erase_many( const mclo::span<const handle_type> handles ) noexcept(
+			std::is_nothrow_move_assignable_v<T> )
+		{
+			size_type num_erased = 0;
+			for ( const handle_type handle : handles )
 			{
-				try
+				if ( is_valid( handle ) )
 				{
-					// Link in the first item as pointing to the current head
-					m_slot_indirection.push_back( handle_type{ m_free_list_head, {} } );
-
-					const size_type last_new_slot = amount - 1;
-					size_type newest_slot = old_num_slots;
+					erase_valid_handle( handle );
+					++num_erased;
+				}
+			}
+			return num_erased;
+		}
 
-					// Chain together all the other slots
-					while ( newest_slot != last_new_slot )
-					{
-						m_slot_indirection.push_back( handle_type{ newest_slot++, {} } );
-					}
+		/// @brief Lookup a batch of entries in the slot map
+		/// @details Slots are prefetched in groups and each value found is prefetched, so a batch small enough to fit
+		/// in the cache is likely cached by the time the results are used.
+		/// @param handles The handles to lookup
+		/// @param out Span to write a const pointer to each object to, or nullptr for an invalid handle, must be the
+		/// same size as handles
+		/// @return Number of valid handles
+		size_type lookup_many( const mclo::span<const handle_type> handles,
+							   const mclo::span<const_pointer> out ) const noexcept
+		{
+			MCLO_DEBUG_ASSERT( handles.size() == out.size(), "Output must be the same size as handles" );
+			size_type num_found = 0;
+			const const_pointer values = m_data.values();
+			m_slot_indirection.find_many( handles, [ & ]( const std::size_t index, const handle_type* const slot ) {
+				if ( slot )
+				{
+					out[ index ] = values + slot->index;
+					mclo::prefetch( std::to_address( out[ index ] ) );
+					++num_found;
+				}
+				else
+				{
+					out[ index ] = nullptr;
+				}
+			} );
+			return num_found;
+		}
 
-					// Make the end of our new slots the new head
-					m_free_list_head = newest_slot;
+		/// @brief Lookup a batch of entries in the slot map
+		/// @param handles The handles to lookup
+		/// @param out Span to write a mutable pointer to each object to, or nullptr for an invalid handle, must be the
+		/// same size as handles
+		/// @return Number of valid handles
+		size_type lookup_many( const mclo::span<const handle_type> handles, const mclo::span<pointer> out ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( handles.size() == out.size(), "Output must be the same size as handles" );
+			size_type num_found = 0;
+			const pointer values = m_data.values();
+			m_slot_indirection.find_many( handles, [ & ]( const std::size_t index, const handle_type* const slot ) {
+				if ( slot )
+				{
+					out[ index ] = values + slot->index;
+					mclo::prefetch( std::to_address( out[ index ] ) );
+					++num_found;
 				}
-				catch ( ... )
+				else
 				{
-					m_slot_indirection.resize( old_num_slots );
-					throw;
+					out[ index ] = nullptr;
 				}
+			} );
+			return num_found;
+		}
+
+		/// @brief Reserve space for amount slots
+		/// @post Provides a basic exception guarantee, if an exception is thrown invariants are held and no leaks occur
+		/// @details Beneficial as allocating more slots than values causes the generations to increase
+		/// more evenly distributed across the slots compared to recycling the same slots forever.
+		/// @param amount The number of slots to reserve for
+		void reserve_slots( const size_type amount )
+		{
+			if ( amount > max_size() ) [[unlikely]]
+			{
+				throw_too_big();
 			}
+
+			m_slot_indirection.reserve( amount );
 		}
 
 		/// @brief Reserve capacity for elements and slots in the slot map
@@ -660,22 +725,7 @@ namespace mclo
 		void clear() noexcept
 		{
 			m_data.clear();
-
-			// Start from the first again
-			m_free_list_head = 0;
-			const size_type num_slots = slot_count();
-
-			// Chain all following elements to the end
-			for ( size_type index = 0; index < num_slots; ++index )
-			{
-				handle_type& handle = m_slot_indirection[ index ];
-				handle.index = index + 1;
-				++handle.generation;
-			}
-
-			// Set the last element as the tail and refer to itself as the end point
-			m_free_list_tail = num_slots - 1;
-			m_slot_indirection[ m_free_list_tail ].index = m_free_list_tail;
+			m_slot_indirection.clear();
 		}
 
 		/// @brief Destroy all active elements and clear all slots
@@ -684,9 +734,7 @@ namespace mclo
 		void reset() noexcept
 		{
 			m_data.clear();
-			m_slot_indirection.clear();
-			m_free_list_head = 0;
-			m_free_list_tail = 0;
+			m_slot_indirection.reset();
 		}
 
 		/// @brief Check if a handle is a valid entry into the slot map
@@ -694,9 +742,7 @@ namespace mclo
 		/// @return If the handle refers to a valid entry in the slot map
 		[[nodiscard]] bool is_valid( const handle_type handle ) const noexcept
 		{
-			// index is in bounds and matching generation, if slot re-used and our handle is out of date generation
-			// mismatches
-			return handle.index < slot_count() && m_slot_indirection[ handle.index ].generation == handle.generation;
+			return m_slot_indirection.is_valid( handle );
 		}
 
 		/// @brief Lookup an entry in the slot map
@@ -704,18 +750,13 @@ namespace mclo
 		/// @return Const pointer to the object the handle refers to, or nullptr if an invalid handle
 		[[nodiscard]] const_pointer lookup( const handle_type handle ) const noexcept
 		{
-			if ( handle.index >= slot_count() ) [[unlikely]]
-			{
-				return nullptr;
-			}
-
-			const handle_type indirection_handle = m_slot_indirection[ handle.index ];
-			if ( indirection_handle.generation != handle.generation )
+			const handle_type* const slot = m_slot_indirection.find( handle );
+			if ( !slot )
 			{
 				return nullptr;
 			}
 
-			return m_data.values() + indirection_handle.index;
+			return m_data.values() + slot->index;
 		}
 
 		/// @brief Lookup an entry in the slot map
@@ -723,18 +764,13 @@ namespace mclo
 		/// @return Mutable pointer to the object the handle refers to, or nullptr if an invalid handle
 		[[nodiscard]] pointer lookup( const handle_type handle ) noexcept
 		{
-			if ( handle.index >= slot_count() ) [[unlikely]]
-			{
-				return nullptr;
-			}
-
-			const handle_type indirection_handle = m_slot_indirection[ handle.index ];
-			if ( indirection_handle.generation != handle.generation )
+			const handle_type* const slot = m_slot_indirection.find( handle );
+			if ( !slot )
 			{
 				return nullptr;
 			}
 
-			return m_data.values() + indirection_handle.index;
+			return m_data.values() + slot->index;
 		}
 
 		/// @brief Get the handle for the entry the iterator refers to
@@ -771,7 +807,7 @@ namespace mclo
 		/// @brief Get the number of slots, guaranteed >= size()
 		[[nodiscard]] size_type slot_count() const noexcept
 		{
-			return static_cast<size_type>( m_slot_indirection.size() );
+			return m_slot_indirection.slot_count();
 		}
 
 		/// @brief Get the maximum number of objects
@@ -876,8 +912,6 @@ namespace mclo
 			using std::swap;
 			swap( m_data, other.m_data );
 			swap( m_slot_indirection, other.m_slot_indirection );
-			swap( m_free_list_head, other.m_free_list_head );
-			swap( m_free_list_tail, other.m_free_list_tail );
 		}
 
 		friend void swap( dense_slot_map& lhs, dense_slot_map& rhs ) noexcept
@@ -899,7 +933,7 @@ namespace mclo
 		template <typename GuardType, typename... Args>
 		[[nodiscard]] emplace_result emplace_and_get_with_guard( Args&&... arguments )
 		{
-			const size_type slot_index = m_free_list_head;
+			const size_type slot_index = m_slot_indirection.next_free_slot();
 
 			// Insert our data, if this throws we've no clean up needed so we do it first since it is most possible to
 			// throw due to user constructors
@@ -907,48 +941,14 @@ namespace mclo
 
 			GuardType guard( m_data );
 
-			const size_type old_num_slots = slot_count();
-
-			// Free list empty so we add a new index
-			const bool needs_new_index = m_free_list_head == old_num_slots;
-
-			// Free list empty or last in free list, we need to update the head + tail to the new sentinel size
-			const bool mark_empty_free_list = needs_new_index || m_free_list_head == m_free_list_tail;
-
-			const size_type new_num_slots = old_num_slots + static_cast<size_type>( needs_new_index );
-
-			if ( needs_new_index )
-			{
-				// If this throws we've not modified the free list head or tail yet
-				m_slot_indirection.push_back( handle_type{ new_num_slots, {} } );
-			}
-
-			MCLO_DEBUG_ASSERT( new_num_slots == slot_count(), "New num slots should equal slot_count" );
+			// If this throws we've not modified the free list yet
+			m_slot_indirection.reserve_free_slot();
 
 			// We're safe now to return without cleanup, remaining changes are noexcept
 			guard.release();
 
-			// Our re-used handle for this object
-			handle_type& handle = m_slot_indirection[ slot_index ];
-
-			if ( mark_empty_free_list )
-			{
-				m_free_list_tail = m_free_list_head = new_num_slots;
-			}
-			else // Advance free list
-			{
-				m_free_list_head = handle.index;
-			}
-
-			// Set handle's index to point to that
 			const size_type data_index = m_data.size() - 1;
-			handle.index = data_index;
-
-			// We return the original slot index and the generation, generation will be changed in erasure for
-			// invalidating existing handles
-			return {
-				m_data.values()[ data_index ], { slot_index, handle.generation }
-            };
+			return { m_data.values()[ data_index ], m_slot_indirection.acquire( data_index ) };
 		}
 
 		/// @brief Erase an entry in the slot map from its handle
@@ -957,11 +957,7 @@ namespace mclo
 		void erase_valid_handle( handle_type handle ) noexcept( std::is_nothrow_move_assignable_v<T> )
 		{
 			const size_type handle_index = handle.index;
-
-			// Increment generation, now remaining handles will mismatch on usage
-			++m_slot_indirection[ handle_index ].generation;
-
-			const size_type data_index = m_slot_indirection[ handle_index ].index;
+			const size_type data_index = m_slot_indirection.data_index( handle_index );
 			const size_type data_last_index = size() - 1;
 
 			// If we are not the tail we overwrite our data with the tail so maintain a contiguous array of data
@@ -976,24 +972,14 @@ namespace mclo
 
 				// Use data we overwrote with to find and update its indirection array link with the data for our new
 				// location
-				m_slot_indirection[ data_reverse_map[ data_index ] ].index = data_index;
+				m_slot_indirection.set_data_index( data_reverse_map[ data_index ], data_index );
 			}
 
 			// We pop the tail as that is either us directly or what we moved from to overwrite ourselves
 			m_data.pop_back();
 
-			// Start free list if empty or chain into existing free list
-			if ( m_free_list_head == slot_count() )
-			{
-				m_free_list_head = handle_index;
-			}
-			else
-			{
-				m_slot_indirection[ m_free_list_tail ].index = handle_index;
-			}
-
-			// Is always the new tail of the free list
-			m_free_list_tail = handle_index;
+			// Invalidates remaining handles and returns the slot to the free list
+			m_slot_indirection.release( handle_index );
 		}
 
 		/// @brief Get the handle for the entry the iterator refers to
@@ -1001,33 +987,16 @@ namespace mclo
 		/// @return The handle to the entry for the iterator, or null handle if end iterator
 		[[nodiscard]] handle_type get_valid_handle_at( const size_type data_index ) const noexcept
 		{
-			const size_type indirection_index = m_data.data_reverse_map()[ data_index ];
-			const size_type generation = m_slot_indirection[ indirection_index ].generation;
-			return handle_type{ indirection_index, generation };
+			return m_slot_indirection.handle_at( m_data.data_reverse_map()[ data_index ] );
 		}
 
-		using alloc_traits = std::allocator_traits<allocator_type>;
-
 		/// @brief Underlying container containing the data and reverse map
 		underlying_container m_data;
 
 		/// @brief Indirection array, lookup from handle.index -> m_data
 		/// @details Handles returned by the API provide indexes into this array, which is stable, to then index into
 		/// the actual data.
-		/// The handle's indexes are also an in built free list, if an entry is in the free list its index points to the
-		/// next entry in this array that is part of the free list.
-		/// If the index is itself then it is the end of the free list.
-		std::vector<handle_type, indirection_alloc> m_slot_indirection;
-
-		/// @brief index into slot array for the start of the free list
-		/// @details Is either equal to m_free_list_tail and slot_count() when empty
-		/// Or is > 0 and < slot_count() and points to start of free list, with each slot pointing to the
-		/// next entry in the free list until m_free_list_tail.
-		/// Tail can be equal to head if there is only one free slot.
-		size_type m_free_list_head = 0;
-
-		/// @brief index into slot array for the end of the free list
-		size_type m_free_list_tail = 0;
+		detail::slot_map_indirection<handle_type, indirection_alloc> m_slot_indirection;
 	};
 
 	namespace pmr
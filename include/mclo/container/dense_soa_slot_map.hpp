@@ -0,0 +1,510 @@
+#pragma once
+
+#include "mclo/container/detail/slot_map_indirection.hpp"
+#include "mclo/container/slot_map_handle.hpp"
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/meta/count.hpp"
+#include "mclo/meta/index_of.hpp"
+#include "mclo/meta/type_list.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	template <typename Components,
+			  std::size_t HandleTotalBits = sizeof( std::uint32_t ) * CHAR_BIT,
+			  std::size_t GenerationBits = HandleTotalBits / 4,
+			  typename Allocator = std::allocator<std::byte>>
+	class dense_soa_slot_map;
+
+	/// @brief A slot map storing each component type in its own contiguous array, struct of arrays style
+	/// @details Has the same handle semantics as dense_slot_map, one handle refers to one entry made up of a value of
+	/// each component type. Each component is stored in a separate contiguous array all sharing one indirection and
+	/// generation table, so iterating a single component only touches the memory for that component.
+	///
+	/// All columns are kept in the same order, the entry at data index i of every column belongs to the same handle,
+	/// so columns can be iterated in lockstep. Like dense_slot_map erasure swaps the last entry into the erased
+	/// position in every column.
+	///
+	/// @code
+	/// mclo::dense_soa_slot_map<std::tuple<position, velocity>> particles;
+	/// const auto handle = particles.emplace( position{}, velocity{ 1, 0 } );
+	/// const auto positions = particles.column<position>();
+	/// const auto velocities = particles.column<velocity>();
+	/// for ( std::size_t i = 0; i < positions.size(); ++i ) { positions[ i ] += velocities[ i ]; }
+	/// @endcode
+	///
+	/// @tparam Components std::tuple of the component types to store, each component type must be an object type
+	/// @tparam HandleTotalBits Total number of bits for the handle type to use, smallest integer type to fit these bits
+	/// will be the handle representation type, defaults to a std::uint32_t.
+	/// @tparam GenerationBits Number of the total bits in the handle representation type used for generation checking,
+	/// defaults to 1/4 of the total bits.
+	/// @tparam Allocator The allocator used by the backing arrays, rebound for each component
+	template <typename... Ts, std::size_t HandleTotalBits, std::size_t GenerationBits, typename Allocator>
+	class dense_soa_slot_map<std::tuple<Ts...>, HandleTotalBits, GenerationBits, Allocator>
+	{
+		static_assert( sizeof...( Ts ) > 0, "Must have at least one component" );
+		static_assert( ( std::is_object_v<Ts> && ... ),
+					   "The C++ Standard forbids containers of non-object types "
+					   "because of [container.requirements]." );
+
+		using alloc_traits = std::allocator_traits<Allocator>;
+
+		template <typename T>
+		using column_type = std::vector<T, typename alloc_traits::template rebind_alloc<T>>;
+
+		using component_list = meta::type_list<Ts...>;
+
+		// Components can only be looked up by type if that type is unambiguous
+		template <typename T>
+			requires( meta::count_v<T, component_list> == 1 )
+		static constexpr std::size_t index_of = meta::index_of_v<T, component_list>;
+
+	public:
+		using handle_type = slot_map_handle<std::tuple<Ts...>, HandleTotalBits, GenerationBits>;
+		using size_type = decltype( handle_type::max_index + 1 );
+		using allocator_type = Allocator;
+		using value_type = std::tuple<Ts...>;
+		using reference = std::tuple<Ts&...>;
+		using const_reference = std::tuple<const Ts&...>;
+
+		/// @brief Type of the component at Index
+		template <std::size_t Index>
+		using component_type = std::tuple_element_t<Index, value_type>;
+
+		dense_soa_slot_map() noexcept( std::is_nothrow_default_constructible_v<allocator_type> ) = default;
+
+		explicit dense_soa_slot_map( const allocator_type& allocator ) noexcept
+			: m_columns( column_type<Ts>( allocator )... )
+			, m_data_reverse_map( allocator )
+			, m_slot_indirection( indirection_alloc( allocator ) )
+		{
+		}
+
+		explicit dense_soa_slot_map( const size_type slot_count, const allocator_type& allocator = allocator_type() )
+			: dense_soa_slot_map( allocator )
+		{
+			reserve_slots( slot_count );
+		}
+
+		/// @brief Emplace an entry constructing each component from one argument
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change to the container is made
+		/// @tparam ...Args Type of arguments to construct from, one per component
+		/// @param ...arguments Arguments to construct each component from
+		/// @return handle to the created entry
+		template <typename... Args>
+			requires( sizeof...( Args ) == sizeof...( Ts ) )
+		[[nodiscard]] handle_type emplace( Args&&... arguments )
+		{
+			if ( size() >= max_size() ) [[unlikely]]
+			{
+				throw_too_big();
+			}
+
+			// Grow everything up front, after this only component constructors can throw
+			const size_type current_size = size();
+			if ( current_size == static_cast<size_type>( m_data_reverse_map.capacity() ) )
+			{
+				reserve_data( std::max<size_type>( current_size + 1, current_size + current_size / 2 ) );
+			}
+			m_slot_indirection.reserve_free_slot();
+
+			emplace_columns( std::index_sequence_for<Ts...>{}, std::forward<Args>( arguments )... );
+			m_data_reverse_map.push_back( m_slot_indirection.next_free_slot() );
+			return m_slot_indirection.acquire( size() - 1 );
+		}
+
+		/// @brief Insert a copy of each component
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change to the container is made
+		/// @param components Tuple of components to copy into the slot map
+		/// @return handle to the created entry
+		[[nodiscard]] handle_type insert( const value_type& components )
+		{
+			return std::apply( [ this ]( const Ts&... values ) { return emplace( values... ); }, components );
+		}
+
+		/// @brief Insert each component by move
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change to the container is made
+		/// @param components Tuple of components to move into the slot map
+		/// @return handle to the created entry
+		[[nodiscard]] handle_type insert( value_type&& components )
+		{
+			return std::apply( [ this ]( Ts&... values ) { return emplace( std::move( values )... ); }, components );
+		}
+
+		/// @brief Reserve space for amount slots
+		/// @post Provides a basic exception guarantee, if an exception is thrown invariants are held and no leaks occur
+		/// @param amount The number of slots to reserve for
+		void reserve_slots( const size_type amount )
+		{
+			if ( amount > max_size() ) [[unlikely]]
+			{
+				throw_too_big();
+			}
+			m_slot_indirection.reserve( amount );
+		}
+
+		/// @brief Reserve capacity for entries in every column and slots in the slot map
+		/// @post Provides a basic exception guarantee, if an exception is thrown invariants are held and no leaks occur
+		/// @param amount Number of entries to reserve space for
+		void reserve( const size_type amount )
+		{
+			reserve_slots( amount );
+			reserve_data( amount );
+		}
+
+		/// @brief Erase an entry in the slot map from its handle
+		/// @param handle The handle to the entry to erase
+		void erase( const handle_type handle ) noexcept( ( std::is_nothrow_move_assignable_v<Ts> && ... ) )
+		{
+			if ( is_valid( handle ) ) [[likely]]
+			{
+				erase_valid_handle( handle );
+			}
+		}
+
+		/// @brief Erase the entry at the handle if it exists returning its components, else return an empty optional
+		/// @param handle The handle to move the components from then erase
+		/// @return Contains the components at the handle's location, else an empty optional
+		[[nodiscard]] std::optional<value_type> pop( const handle_type handle )
+		{
+			const handle_type* const slot = m_slot_indirection.find( handle );
+			if ( !slot )
+			{
+				return std::nullopt;
+			}
+
+			const size_type data_index = slot->index;
+			std::optional<value_type> result( take_entry( std::index_sequence_for<Ts...>{}, data_index ) );
+			erase_valid_handle( handle );
+			return result;
+		}
+
+		/// @brief Destroy all entries and put all slots back into the free list
+		/// @details Increases the generation counter of all slots, so existing handles are valid to use
+		void clear() noexcept
+		{
+			clear_data();
+			m_slot_indirection.clear();
+		}
+
+		/// @brief Destroy all entries and clear all slots
+		/// @warning This invalidates all existing handles as it resets generation counters, be sure none in use else
+		/// it'll lead to collisions
+		void reset() noexcept
+		{
+			clear_data();
+			m_slot_indirection.reset();
+		}
+
+		/// @brief Check if a handle is a valid entry into the slot map
+		/// @param handle The handle to check
+		/// @return If the handle refers to a valid entry in the slot map
+		[[nodiscard]] bool is_valid( const handle_type handle ) const noexcept
+		{
+			return m_slot_indirection.is_valid( handle );
+		}
+
+		/// @brief Lookup one component of an entry
+		/// @tparam T Type of the component to lookup, must appear once in the components
+		/// @param handle The handle to lookup
+		/// @return Pointer to the component, or nullptr if an invalid handle
+		template <typename T>
+		[[nodiscard]] T* lookup( const handle_type handle ) noexcept
+		{
+			return lookup<index_of<T>>( handle );
+		}
+
+		/// @brief Lookup one component of an entry
+		/// @tparam T Type of the component to lookup, must appear once in the components
+		/// @param handle The handle to lookup
+		/// @return Const pointer to the component, or nullptr if an invalid handle
+		template <typename T>
+		[[nodiscard]] const T* lookup( const handle_type handle ) const noexcept
+		{
+			return lookup<index_of<T>>( handle );
+		}
+
+		/// @brief Lookup one component of an entry
+		/// @tparam Index Index of the component to lookup
+		/// @param handle The handle to lookup
+		/// @return Pointer to the component, or nullptr if an invalid handle
+		template <std::size_t Index>
+		[[nodiscard]] component_type<Index>* lookup( const handle_type handle ) noexcept
+		{
+			const handle_type* const slot = m_slot_indirection.find( handle );
+			return slot ? std::get<Index>( m_columns ).data() + slot->index : nullptr;
+		}
+
+		/// @brief Lookup one component of an entry
+		/// @tparam Index Index of the component to lookup
+		/// @param handle The handle to lookup
+		/// @return Const pointer to the component, or nullptr if an invalid handle
+		template <std::size_t Index>
+		[[nodiscard]] const component_type<Index>* lookup( const handle_type handle ) const noexcept
+		{
+			const handle_type* const slot = m_slot_indirection.find( handle );
+			return slot ? std::get<Index>( m_columns ).data() + slot->index : nullptr;
+		}
+
+		/// @brief Lookup every component of an entry
+		/// @param handle The handle to lookup
+		/// @return References to each component, or an empty optional if an invalid handle
+		[[nodiscard]] std::optional<reference> lookup_all( const handle_type handle ) noexcept
+		{
+			const handle_type* const slot = m_slot_indirection.find( handle );
+			if ( !slot )
+			{
+				return std::nullopt;
+			}
+			return entry_at( std::index_sequence_for<Ts...>{}, slot->index );
+		}
+
+		/// @brief Lookup every component of an entry
+		/// @param handle The handle to lookup
+		/// @return Const references to each component, or an empty optional if an invalid handle
+		[[nodiscard]] std::optional<const_reference> lookup_all( const handle_type handle ) const noexcept
+		{
+			const handle_type* const slot = m_slot_indirection.find( handle );
+			if ( !slot )
+			{
+				return std::nullopt;
+			}
+			return entry_at( std::index_sequence_for<Ts...>{}, slot->index );
+		}
+
+		/// @brief Get a span over every value of one component, in data order
+		/// @tparam T Type of the component, must appear once in the components
+		/// @return Span over the component's contiguous array
+		template <typename T>
+		[[nodiscard]] mclo::span<T> column() noexcept
+		{
+			return column<index_of<T>>();
+		}
+
+		/// @brief Get a span over every value of one component, in data order
+		/// @tparam T Type of the component, must appear once in the components
+		/// @return Const span over the component's contiguous array
+		template <typename T>
+		[[nodiscard]] mclo::span<const T> column() const noexcept
+		{
+			return column<index_of<T>>();
+		}
+
+		/// @brief Get a span over every value of one component, in data order
+		/// @tparam Index Index of the component
+		/// @return Span over the component's contiguous array
+		template <std::size_t Index>
+		[[nodiscard]] mclo::span<component_type<Index>> column() noexcept
+		{
+			return mclo::span<component_type<Index>>( std::get<Index>( m_columns ) );
+		}
+
+		/// @brief Get a span over every value of one component, in data order
+		/// @tparam Index Index of the component
+		/// @return Const span over the component's contiguous array
+		template <std::size_t Index>
+		[[nodiscard]] mclo::span<const component_type<Index>> column() const noexcept
+		{
+			return mclo::span<const component_type<Index>>( std::get<Index>( m_columns ) );
+		}
+
+		/// @brief Invoke func with references to every component of each entry, in data order
+		/// @param func Function to invoke with the components of each entry
+		void for_each( std::invocable<Ts&...> auto func )
+		{
+			for_each_entry( std::index_sequence_for<Ts...>{}, func );
+		}
+
+		/// @brief Invoke func with const references to every component of each entry, in data order
+		/// @param func Function to invoke with the components of each entry
+		void for_each( std::invocable<const Ts&...> auto func ) const
+		{
+			for_each_entry( std::index_sequence_for<Ts...>{}, func );
+		}
+
+		/// @brief Get the handle for the entry at data_index in the columns
+		/// @param data_index Index into the columns, must be < size()
+		/// @return The handle to the entry
+		[[nodiscard]] handle_type get_handle( const size_type data_index ) const noexcept
+		{
+			MCLO_DEBUG_ASSERT( data_index < size(), "Data index out of range" );
+			return m_slot_indirection.handle_at( m_data_reverse_map[ data_index ] );
+		}
+
+		/// @brief Get the number of entries
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return static_cast<size_type>( m_data_reverse_map.size() );
+		}
+
+		/// @brief Is the slot map empty
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_data_reverse_map.empty();
+		}
+
+		/// @brief Get the number of slots, guaranteed >= size()
+		[[nodiscard]] size_type slot_count() const noexcept
+		{
+			return m_slot_indirection.slot_count();
+		}
+
+		/// @brief Get the maximum number of entries
+		[[nodiscard]] static constexpr size_type max_size() noexcept
+		{
+			return handle_type::max_index + 1;
+		}
+
+		/// @brief Get the allocator used
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return allocator_type( m_data_reverse_map.get_allocator() );
+		}
+
+		/// @brief Swap this with Other
+		/// @param Other The target of the swap
+		void swap( dense_soa_slot_map& other ) noexcept
+		{
+			using std::swap;
+			swap( m_columns, other.m_columns );
+			swap( m_data_reverse_map, other.m_data_reverse_map );
+			swap( m_slot_indirection, other.m_slot_indirection );
+		}
+
+		friend void swap( dense_soa_slot_map& lhs, dense_soa_slot_map& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+	private:
+		using size_alloc = typename alloc_traits::template rebind_alloc<size_type>;
+		using indirection_alloc = typename alloc_traits::template rebind_alloc<handle_type>;
+
+		[[noreturn]] void throw_too_big() const
+		{
+			throw std::length_error( "Slot map too large for maximum handle index" );
+		}
+
+		void reserve_data( const size_type amount )
+		{
+			std::apply( [ amount ]( auto&... columns ) { ( columns.reserve( amount ), ... ); }, m_columns );
+			m_data_reverse_map.reserve( amount );
+		}
+
+		template <std::size_t... Is>
+		[[nodiscard]] reference entry_at( std::index_sequence<Is...>, const size_type data_index ) noexcept
+		{
+			return reference( std::get<Is>( m_columns )[ data_index ]... );
+		}
+
+		template <std::size_t... Is>
+		[[nodiscard]] const_reference entry_at( std::index_sequence<Is...>, const size_type data_index ) const noexcept
+		{
+			return const_reference( std::get<Is>( m_columns )[ data_index ]... );
+		}
+
+		template <std::size_t... Is>
+		[[nodiscard]] value_type take_entry( std::index_sequence<Is...>, const size_type data_index )
+		{
+			return value_type( std::move( std::get<Is>( m_columns )[ data_index ] )... );
+		}
+
+		template <std::size_t... Is, typename Func>
+		void for_each_entry( std::index_sequence<Is...>, Func& func )
+		{
+			const size_type num = size();
+			for ( size_type index = 0; index < num; ++index )
+			{
+				func( std::get<Is>( m_columns )[ index ]... );
+			}
+		}
+
+		template <std::size_t... Is, typename Func>
+		void for_each_entry( std::index_sequence<Is...>, Func& func ) const
+		{
+			const size_type num = size();
+			for ( size_type index = 0; index < num; ++index )
+			{
+				func( std::get<Is>( m_columns )[ index ]... );
+			}
+		}
+
+		template <std::size_t... Is, typename... Args>
+		void emplace_columns( std::index_sequence<Is...>, Args&&... arguments )
+		{
+			// Capacity is reserved so only the component constructors can throw, if one does the columns already
+			// emplaced into are popped back off to give the strong exception guarantee
+			std::size_t num_emplaced = 0;
+			try
+			{
+				( ( std::get<Is>( m_columns ).emplace_back( std::forward<Args>( arguments ) ), ++num_emplaced ), ... );
+			}
+			catch ( ... )
+			{
+				( ( Is < num_emplaced ? std::get<Is>( m_columns ).pop_back() : void() ), ... );
+				throw;
+			}
+		}
+
+		void erase_valid_handle( const handle_type handle ) noexcept( ( std::is_nothrow_move_assignable_v<Ts> && ... ) )
+		{
+			const size_type handle_index = handle.index;
+			const size_type data_index = m_slot_indirection.data_index( handle_index );
+			const size_type data_last_index = size() - 1;
+
+			// If we are not the tail we overwrite our data with the tail in every column to stay contiguous
+			if ( data_index != data_last_index ) [[likely]]
+			{
+				std::apply(
+					[ data_index, data_last_index ]( auto&... columns ) {
+						( ( columns[ data_index ] = std::move( columns[ data_last_index ] ) ), ... );
+					},
+					m_columns );
+				m_data_reverse_map[ data_index ] = m_data_reverse_map[ data_last_index ];
+				m_slot_indirection.set_data_index( m_data_reverse_map[ data_index ], data_index );
+			}
+
+			std::apply( []( auto&... columns ) { ( columns.pop_back(), ... ); }, m_columns );
+			m_data_reverse_map.pop_back();
+
+			m_slot_indirection.release( handle_index );
+		}
+
+		void clear_data() noexcept
+		{
+			std::apply( []( auto&... columns ) { ( columns.clear(), ... ); }, m_columns );
+			m_data_reverse_map.clear();
+		}
+
+		/// @brief One contiguous array per component, all in the same data order
+		std::tuple<column_type<Ts>...> m_columns;
+
+		/// @brief Lookup from data index -> slot index, used to update the slot of data moved by erasure
+		std::vector<size_type, size_alloc> m_data_reverse_map;
+
+		/// @brief Indirection array, lookup from handle.index -> data index, shared by every column
+		detail::slot_map_indirection<handle_type, indirection_alloc> m_slot_indirection;
+	};
+
+	namespace pmr
+	{
+		template <typename Components,
+				  std::size_t HandleTotalBits = sizeof( std::uint32_t ) * CHAR_BIT,
+				  std::size_t GenerationBits = HandleTotalBits / 4>
+		using dense_soa_slot_map = mclo::dense_soa_slot_map<Components,
+															HandleTotalBits,
+															GenerationBits,
+															std::pmr::polymorphic_allocator<std::byte>>;
+	}
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "mclo/container/detail/bitset_base.hpp"
+#include "mclo/debug/assert.hpp"
+
+#include <atomic>
+#include <bit>
+#include <limits>
+
+namespace mclo::detail
+{
+	/// @brief Thread safe bitset API implemented on top of a regular bitset
+	/// @details Every word of the wrapped bitset is accessed through std::atomic_ref, so single bit updates from many
+	/// threads are lock-free fetch_or/fetch_and operations while the storage layout is exactly that of the wrapped
+	/// bitset. Once concurrent writers are done the wrapped bitset can be used directly for the full non-atomic bitset
+	/// API, e.g. for_each_set over a visited set after a parallel traversal.
+	/// @tparam Bitset The bitset type wrapped, either mclo::bitset or mclo::dynamic_bitset
+	template <typename Bitset>
+	class atomic_bitset_base
+	{
+	public:
+		using bitset_type = Bitset;
+		using underlying_type = typename bitset_type::underlying_type;
+		using size_type = typename bitset_type::size_type;
+		static constexpr size_type npos = bitset_type::npos;
+
+	private:
+		using atomic_ref = std::atomic_ref<underlying_type>;
+
+		static_assert( atomic_ref::required_alignment <= alignof( underlying_type ),
+					   "Underlying type is not sufficiently aligned for atomic access on this platform" );
+
+	protected:
+		static constexpr size_type bits_per_value = CHAR_BIT * sizeof( underlying_type );
+		static constexpr underlying_type one = 1;
+
+		atomic_bitset_base() noexcept = default;
+
+		explicit atomic_bitset_base( bitset_type bits ) noexcept( std::is_nothrow_move_constructible_v<bitset_type> )
+			: m_bits( std::move( bits ) )
+		{
+		}
+
+		~atomic_bitset_base() = default;
+
+	public:
+		atomic_bitset_base( const atomic_bitset_base& ) = delete;
+		atomic_bitset_base& operator=( const atomic_bitset_base& ) = delete;
+
+		/// @brief Whether the operations are always lock-free on this platform
+		static constexpr bool is_always_lock_free = atomic_ref::is_always_lock_free;
+
+		/// @brief Gets the total number of bits in the bitset
+		/// @return Number of bits
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_bits.size();
+		}
+
+		/// @brief Atomically test if the bit at pos is set
+		/// @param pos Position to check, must be < size()
+		/// @param order Memory order of the load
+		/// @return If the bit is set
+		[[nodiscard]] bool test( const size_type pos,
+								 const std::memory_order order = std::memory_order_seq_cst ) const noexcept
+		{
+			MCLO_DEBUG_ASSERT( pos < size(), "Pos out of range of bitset" );
+			return ( value_ref( pos / bits_per_value ).load( order ) & bit_mask( pos ) ) != 0;
+		}
+
+		/// @brief Atomically set the bit at pos, returning if it was already set
+		/// @details Implemented with a single fetch_or, so exactly one thread sees false for each bit that gets set.
+		/// @param pos Position to set, must be < size()
+		/// @param order Memory order of the read-modify-write
+		/// @return If the bit was previously set
+		[[nodiscard]] bool test_and_set( const size_type pos,
+										 const std::memory_order order = std::memory_order_seq_cst ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( pos < size(), "Pos out of range of bitset" );
+			const underlying_type mask = bit_mask( pos );
+			return ( value_ref( pos / bits_per_value ).fetch_or( mask, order ) & mask ) != 0;
+		}
+
+		/// @brief Atomically reset the bit at pos, returning if it was set
+		/// @details Implemented with a single fetch_and, so exactly one thread sees true for each bit that gets reset.
+		/// @param pos Position to reset, must be < size()
+		/// @param order Memory order of the read-modify-write
+		/// @return If the bit was previously set
+		[[nodiscard]] bool test_and_reset( const size_type pos,
+										   const std::memory_order order = std::memory_order_seq_cst ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( pos < size(), "Pos out of range of bitset" );
+			const underlying_type mask = bit_mask( pos );
+			return ( value_ref( pos / bits_per_value ).fetch_and( static_cast<underlying_type>( ~mask ), order ) &
+					 mask ) != 0;
+		}
+
+		/// @brief Atomically set the bit at pos
+		/// @param pos Position to set, must be < size()
+		/// @param order Memory order of the read-modify-write
+		void set( const size_type pos, const std::memory_order order = std::memory_order_seq_cst ) noexcept
+		{
+			(void)test_and_set( pos, order );
+		}
+
+		/// @brief Atomically reset the bit at pos
+		/// @param pos Position to reset, must be < size()
+		/// @param order Memory order of the read-modify-write
+		void reset( const size_type pos, const std::memory_order order = std::memory_order_seq_cst ) noexcept
+		{
+			(void)test_and_reset( pos, order );
+		}
+
+		/// @brief Atomically find an unset bit and set it, for lock-free slot allocation
+		/// @details Scans words from the one containing start_pos, claiming the lowest unset bit of a word with a
+		/// compare exchange. On contention the word is reloaded and retried, so the call only fails if every bit was
+		/// observed set during the scan.
+		/// @param start_pos Position to start searching from, bits before it are not considered
+		/// @param order Memory order of the successful read-modify-write
+		/// @return Position of the bit this call set or npos if none were found unset
+		[[nodiscard]] size_type find_first_unset_and_set(
+			const size_type start_pos = 0, const std::memory_order order = std::memory_order_seq_cst ) noexcept
+		{
+			const size_type bit_size = size();
+			const size_type num_values = ceil_divide( bit_size, bits_per_value );
+			for ( size_type page = start_pos / bits_per_value; page < num_values; ++page )
+			{
+				underlying_type valid = static_cast<underlying_type>( ~underlying_type{ 0 } );
+				if ( page == start_pos / bits_per_value )
+				{
+					valid &= static_cast<underlying_type>( valid << ( start_pos % bits_per_value ) );
+				}
+				if ( page == num_values - 1 && bit_size % bits_per_value != 0 )
+				{
+					valid &= static_cast<underlying_type>( ( one << ( bit_size % bits_per_value ) ) - 1 );
+				}
+
+				atomic_ref ref = value_ref( page );
+				underlying_type value = ref.load( std::memory_order_relaxed );
+				underlying_type unset = static_cast<underlying_type>( ~value & valid );
+				while ( unset != 0 )
+				{
+					const underlying_type mask = static_cast<underlying_type>( unset & ( ~unset + 1 ) );
+					if ( ref.compare_exchange_weak(
+							 value, static_cast<underlying_type>( value | mask ), order, std::memory_order_relaxed ) )
+					{
+						return page * bits_per_value + static_cast<size_type>( std::countr_zero( mask ) );
+					}
+					unset = static_cast<underlying_type>( ~value & valid );
+				}
+			}
+			return npos;
+		}
+
+		/// @brief Count the number of set bits
+		/// @details Each word is loaded atomically but not all at once, with concurrent writers the result is not a
+		/// snapshot of any single moment, only bounded by the counts before and after the call.
+		/// @param order Memory order of the loads
+		/// @return Number of set bits observed
+		[[nodiscard]] size_type count( const std::memory_order order = std::memory_order_relaxed ) const noexcept
+		{
+			size_type result = 0;
+			for_each_value( order, [ &result ]( const underlying_type value ) {
+				result += static_cast<size_type>( std::popcount( value ) );
+				return true;
+			} );
+			return result;
+		}
+
+		/// @brief Check if any bit is set
+		/// @param order Memory order of the loads
+		/// @return If any set bit was observed
+		[[nodiscard]] bool any( const std::memory_order order = std::memory_order_relaxed ) const noexcept
+		{
+			bool result = false;
+			for_each_value( order, [ &result ]( const underlying_type value ) {
+				result = value != 0;
+				return !result;
+			} );
+			return result;
+		}
+
+		/// @brief Check if no bits are set
+		/// @param order Memory order of the loads
+		/// @return If no set bits were observed
+		[[nodiscard]] bool none( const std::memory_order order = std::memory_order_relaxed ) const noexcept
+		{
+			return !any( order );
+		}
+
+		/// @brief Atomically reset every bit, one word at a time
+		/// @param order Memory order of the stores
+		void reset_all( const std::memory_order order = std::memory_order_seq_cst ) noexcept
+		{
+			const size_type num_values = ceil_divide( size(), bits_per_value );
+			for ( size_type page = 0; page < num_values; ++page )
+			{
+				value_ref( page ).store( 0, order );
+			}
+		}
+
+		/// @brief Copy the current bits out into a regular bitset, each word is loaded atomically
+		/// @param order Memory order of the loads
+		/// @return Copy of the bits
+		[[nodiscard]] bitset_type load( const std::memory_order order = std::memory_order_seq_cst ) const
+		{
+			// Start from an empty bitset of the same size, copying m_bits would read the words non-atomically
+			bitset_type result = [ this ] {
+				if constexpr ( requires( bitset_type& bits ) { bits.resize( size_type{} ); } )
+				{
+					return bitset_type( size() );
+				}
+				else
+				{
+					return bitset_type();
+				}
+			}();
+			auto values = result.underlying();
+			for ( size_type page = 0; page < values.size(); ++page )
+			{
+				values[ page ] = value_ref( page ).load( order );
+			}
+			return result;
+		}
+
+		/// @brief Access the wrapped bitset directly for the full non-atomic bitset API
+		/// @warning Only safe while no other thread is modifying the bitset
+		/// @return Reference to the wrapped bitset
+		[[nodiscard]] bitset_type& unsafe_bitset() noexcept
+		{
+			return m_bits;
+		}
+
+		/// @brief Access the wrapped bitset directly for the full non-atomic bitset API
+		/// @warning Only safe while no other thread is modifying the bitset
+		/// @return Const reference to the wrapped bitset
+		[[nodiscard]] const bitset_type& unsafe_bitset() const noexcept
+		{
+			return m_bits;
+		}
+
+	private:
+		[[nodiscard]] static underlying_type bit_mask( const size_type pos ) noexcept
+		{
+			return static_cast<underlying_type>( one << ( pos % bits_per_value ) );
+		}
+
+		[[nodiscard]] atomic_ref value_ref( const size_type page ) const noexcept
+		{
+			// atomic_ref only needs a non-const reference to be constructed, loads through it do not modify the value
+			return atomic_ref( const_cast<underlying_type&>( m_bits.underlying()[ page ] ) );
+		}
+
+		template <typename Func>
+		void for_each_value( const std::memory_order order, Func func ) const noexcept
+		{
+			const size_type num_values = ceil_divide( size(), bits_per_value );
+			for ( size_type page = 0; page < num_values; ++page )
+			{
+				if ( !func( value_ref( page ).load( order ) ) )
+				{
+					return;
+				}
+			}
+		}
+
+	protected:
+		bitset_type m_bits;
+	};
+}
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "mclo/container/detail/bitset_simd.hpp"
 #include "mclo/container/span.hpp"
 #include "mclo/debug/assert.hpp"
 #include "mclo/hash/hash_append_range.hpp"
 #include "mclo/numeric/math.hpp"
+#include <array>
 #include <bit>
 #include <climits>
 #include <concepts>
@@ -33,7 +35,9 @@ namespace mclo::detail
 	/// - Usable at compile time if container is
 	/// - Exception safe querying and modification of the set, only container growth can throw if the container can be
 	/// resized
-	/// - Supports fast iteration via for_each_set
+	/// - Supports fast iteration via for_each_set and for_each_set_batch
+	/// - Bulk operations (count, set algebra and fused counts such as and_count) use SIMD kernels at run time for
+	/// large sets
 	/// - Supports fast iteration via find_first_set/unset including starting offset
 	/// - test_set in one function
 	/// @warnings The follow std::bitset functionality is divergent
@@ -232,14 +236,7 @@ namespace mclo::detail
 		/// @return If any are set
 		[[nodiscard]] constexpr bool any() const noexcept
 		{
-			for ( const underlying_type value : m_container )
-			{
-				if ( value != 0 )
-				{
-					return true;
-				}
-			}
-			return false;
+			return find_non_zero_value( 0 ) != m_container.size();
 		}
 
 		/// @brief Check if no bits are set
@@ -253,6 +250,12 @@ namespace mclo::detail
 		/// @return The number of set bits
 		[[nodiscard]] constexpr size_type count() const noexcept
 		{
+			if ( use_simd( m_container.size() ) )
+			{
+				return bitset_count_simd( as_bytes( m_container.data() ),
+										  m_container.size() * sizeof( underlying_type ) );
+			}
+
 			size_type total_set = 0;
 			for ( const underlying_type value : m_container )
 			{
@@ -357,6 +360,11 @@ namespace mclo::detail
 				{
 					return ( page * bits_per_value ) + start_index + bit_index;
 				}
+				if ( start_index == 0 )
+				{
+					// Whole page was empty, skip any run of empty pages after it in bulk
+					page = skip_zero_values( page );
+				}
 				start_index = 0; // Moved off of partial page, no need to adjust now
 			}
 
@@ -399,13 +407,19 @@ namespace mclo::detail
 		}
 
 		/// @brief Iterate over every set bit and call func with the position
-		/// @details Optimized for fast looping vs find_first_set or test loops
+		/// @details Optimized for fast looping vs find_first_set or test loops, runs of empty values are skipped in
+		/// bulk
 		/// @param func Callable that takes the size_type position
 		constexpr void for_each_set( std::invocable<size_type> auto func ) const noexcept
 		{
 			for ( size_type page = 0, end = m_container.size(); page < end; ++page )
 			{
 				underlying_type value = m_container[ page ];
+				if ( value == 0 )
+				{
+					page = skip_zero_values( page );
+					continue;
+				}
 				while ( value )
 				{
 					const int bit_index = std::countr_zero( value );
@@ -415,6 +429,52 @@ namespace mclo::detail
 			}
 		}
 
+		/// @brief Maximum number of positions passed to the callable of for_each_set_batch at once
+		static constexpr size_type for_each_set_batch_size = 256;
+
+		/// @brief Iterate over every set bit, calling func with batches of positions
+		/// @details Positions are decoded into a local buffer before func is invoked, this keeps the bit scanning
+		/// loop free of the callable so it runs at full speed and lets func process the positions with its own
+		/// vectorized or prefetching loop.
+		/// Positions are in ascending order both within and across batches.
+		/// @param func Callable that takes a mclo::span<const size_type> of positions, each span has between 1 and
+		/// for_each_set_batch_size positions
+		constexpr void for_each_set_batch( std::invocable<mclo::span<const size_type>> auto func ) const noexcept
+		{
+			static_assert( for_each_set_batch_size >= bits_per_value, "Batch must be able to hold a whole value" );
+
+			std::array<size_type, for_each_set_batch_size> positions;
+			size_type num_positions = 0;
+
+			for ( size_type page = 0, end = m_container.size(); page < end; ++page )
+			{
+				underlying_type value = m_container[ page ];
+				if ( value == 0 )
+				{
+					page = skip_zero_values( page );
+					continue;
+				}
+
+				if ( num_positions + std::popcount( value ) > for_each_set_batch_size )
+				{
+					func( mclo::span<const size_type>( positions.data(), num_positions ) );
+					num_positions = 0;
+				}
+
+				const size_type page_offset = page * bits_per_value;
+				while ( value )
+				{
+					positions[ num_positions++ ] = page_offset + std::countr_zero( value );
+					value &= value - 1; // Clear rightmost set bit
+				}
+			}
+
+			if ( num_positions != 0 )
+			{
+				func( mclo::span<const size_type>( positions.data(), num_positions ) );
+			}
+		}
+
 		/// @brief Get a const span over the underlying container
 		/// @return Const span of the container
 		[[nodiscard]] constexpr auto underlying() const noexcept
@@ -462,12 +522,12 @@ namespace mclo::detail
 		/// @return This set
 		constexpr Derived& operator&=( const Derived& other ) noexcept
 		{
-			for ( size_type page = 0, size = std::min( m_container.size(), other.m_container.size() ); page < size;
-				  ++page )
-			{
-				m_container[ page ] &= other.m_container[ page ];
-			}
-			return as_derived();
+			return binary_assign(
+				other,
+				[]( const underlying_type lhs, const underlying_type rhs ) noexcept {
+					return static_cast<underlying_type>( lhs & rhs );
+				},
+				&bitset_and_simd );
 		}
 
 		/// @brief Bitwise & of lhs with rhs, performs & on every bit
@@ -486,12 +546,12 @@ namespace mclo::detail
 		/// @return This set
 		constexpr Derived& operator|=( const Derived& other ) noexcept
 		{
-			for ( size_type page = 0, size = std::min( m_container.size(), other.m_container.size() ); page < size;
-				  ++page )
-			{
-				m_container[ page ] |= other.m_container[ page ];
-			}
-			return as_derived();
+			return binary_assign(
+				other,
+				[]( const underlying_type lhs, const underlying_type rhs ) noexcept {
+					return static_cast<underlying_type>( lhs | rhs );
+				},
+				&bitset_or_simd );
 		}
 
 		/// @brief Bitwise | of lhs with rhs, performs | on every bit
@@ -510,12 +570,12 @@ namespace mclo::detail
 		/// @return This set
 		constexpr Derived& operator^=( const Derived& other ) noexcept
 		{
-			for ( size_type page = 0, size = std::min( m_container.size(), other.m_container.size() ); page < size;
-				  ++page )
-			{
-				m_container[ page ] ^= other.m_container[ page ];
-			}
-			return as_derived();
+			return binary_assign(
+				other,
+				[]( const underlying_type lhs, const underlying_type rhs ) noexcept {
+					return static_cast<underlying_type>( lhs ^ rhs );
+				},
+				&bitset_xor_simd );
 		}
 
 		/// @brief Bitwise ^ of lhs with rhs, performs & on every bit
@@ -529,6 +589,84 @@ namespace mclo::detail
 			return result;
 		}
 
+		/// @brief Bitwise &= ~other of this set, clears every bit that is set in other
+		/// @details Equivalent to *this &= ~other without materializing the flipped set
+		/// @param other The set whose set bits are cleared from this
+		/// @return This set
+		constexpr Derived& and_not( const Derived& other ) noexcept
+		{
+			return binary_assign(
+				other,
+				[]( const underlying_type lhs, const underlying_type rhs ) noexcept {
+					return static_cast<underlying_type>( lhs & ~rhs );
+				},
+				&bitset_and_not_simd );
+		}
+
+		/// @brief Count the set bits of lhs & rhs without materializing the result
+		/// @param lhs Left set to &
+		/// @param rhs Right set to &
+		/// @return Same as ( lhs & rhs ).count()
+		[[nodiscard]] friend constexpr size_type and_count( const Derived& lhs, const Derived& rhs ) noexcept
+		{
+			return fused_count(
+				lhs,
+				rhs,
+				[]( const underlying_type l, const underlying_type r ) noexcept {
+					return static_cast<underlying_type>( l & r );
+				},
+				&bitset_and_count_simd,
+				false );
+		}
+
+		/// @brief Count the set bits of lhs | rhs without materializing the result
+		/// @param lhs Left set to |
+		/// @param rhs Right set to |
+		/// @return Same as ( lhs | rhs ).count()
+		[[nodiscard]] friend constexpr size_type or_count( const Derived& lhs, const Derived& rhs ) noexcept
+		{
+			return fused_count(
+				lhs,
+				rhs,
+				[]( const underlying_type l, const underlying_type r ) noexcept {
+					return static_cast<underlying_type>( l | r );
+				},
+				&bitset_or_count_simd,
+				true );
+		}
+
+		/// @brief Count the set bits of lhs ^ rhs without materializing the result
+		/// @param lhs Left set to ^
+		/// @param rhs Right set to ^
+		/// @return Same as ( lhs ^ rhs ).count()
+		[[nodiscard]] friend constexpr size_type xor_count( const Derived& lhs, const Derived& rhs ) noexcept
+		{
+			return fused_count(
+				lhs,
+				rhs,
+				[]( const underlying_type l, const underlying_type r ) noexcept {
+					return static_cast<underlying_type>( l ^ r );
+				},
+				&bitset_xor_count_simd,
+				true );
+		}
+
+		/// @brief Count the set bits of lhs with the bits of rhs cleared without materializing the result
+		/// @param lhs Set to count the bits of
+		/// @param rhs Set whose bits are excluded
+		/// @return Same as Derived( lhs ).and_not( rhs ).count()
+		[[nodiscard]] friend constexpr size_type and_not_count( const Derived& lhs, const Derived& rhs ) noexcept
+		{
+			return fused_count(
+				lhs,
+				rhs,
+				[]( const underlying_type l, const underlying_type r ) noexcept {
+					return static_cast<underlying_type>( l & ~r );
+				},
+				&bitset_and_not_count_simd,
+				true );
+		}
+
 		/// @brief Flip every set bit and return the new set
 		/// @return new set with the ~ of every bit
 		[[nodiscard]] constexpr Derived operator~() const noexcept( std::is_nothrow_copy_constructible_v<Derived> )
@@ -683,6 +821,115 @@ namespace mclo::detail
 			as_derived().derived_trim();
 		}
 
+		using simd_binary_function = void ( * )( std::uint8_t*, const std::uint8_t*, std::size_t ) noexcept;
+		using simd_count_function =
+			std::size_t ( * )( const std::uint8_t*, const std::uint8_t*, std::size_t ) noexcept;
+
+		[[nodiscard]] static constexpr bool use_simd( const size_type num_values ) noexcept
+		{
+			if constexpr ( bitset_simd_word<underlying_type> )
+			{
+				return !std::is_constant_evaluated() && num_values * sizeof( underlying_type ) >= bitset_simd_min_bytes;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		[[nodiscard]] static std::uint8_t* as_bytes( underlying_type* const data ) noexcept
+		{
+			return reinterpret_cast<std::uint8_t*>( data );
+		}
+
+		[[nodiscard]] static const std::uint8_t* as_bytes( const underlying_type* const data ) noexcept
+		{
+			return reinterpret_cast<const std::uint8_t*>( data );
+		}
+
+		// Index of the first non-zero value at or after start, or m_container.size() if there is none
+		[[nodiscard]] constexpr size_type find_non_zero_value( size_type start ) const noexcept
+		{
+			const size_type end = m_container.size();
+			if ( start < end && use_simd( end - start ) )
+			{
+				const size_type num_bytes = ( end - start ) * sizeof( underlying_type );
+				const size_type offset = bitset_find_non_zero_simd( as_bytes( m_container.data() + start ), num_bytes );
+				return start + ( offset / sizeof( underlying_type ) );
+			}
+			while ( start < end && m_container[ start ] == 0 )
+			{
+				++start;
+			}
+			return start;
+		}
+
+		// Given a zero value at page, returns the last page of the run of zero values it starts
+		[[nodiscard]] constexpr size_type skip_zero_values( const size_type page ) const noexcept
+		{
+			const size_type next = page + 1;
+			if ( next < m_container.size() && m_container[ next ] == 0 )
+			{
+				// Only pay for a bulk scan once there is more than a single empty value to skip
+				return find_non_zero_value( next + 1 ) - 1;
+			}
+			return page;
+		}
+
+		template <typename Op>
+		constexpr Derived& binary_assign( const Derived& other, Op op, simd_binary_function simd_op ) noexcept
+		{
+			const size_type size = std::min( m_container.size(), other.m_container.size() );
+			if ( use_simd( size ) )
+			{
+				simd_op( as_bytes( m_container.data() ),
+						 as_bytes( other.m_container.data() ),
+						 size * sizeof( underlying_type ) );
+			}
+			else
+			{
+				for ( size_type page = 0; page < size; ++page )
+				{
+					m_container[ page ] = op( m_container[ page ], other.m_container[ page ] );
+				}
+			}
+			return as_derived();
+		}
+
+		template <typename Op>
+		[[nodiscard]] static constexpr size_type fused_count( const Derived& lhs,
+															  const Derived& rhs,
+															  Op op,
+															  simd_count_function simd_count,
+															  const bool count_lhs_remainder ) noexcept
+		{
+			const size_type size = std::min( lhs.m_container.size(), rhs.m_container.size() );
+			size_type total_set = 0;
+			if ( use_simd( size ) )
+			{
+				total_set = simd_count( as_bytes( lhs.m_container.data() ),
+										as_bytes( rhs.m_container.data() ),
+										size * sizeof( underlying_type ) );
+			}
+			else
+			{
+				for ( size_type page = 0; page < size; ++page )
+				{
+					total_set += std::popcount( op( lhs.m_container[ page ], rhs.m_container[ page ] ) );
+				}
+			}
+
+			if ( count_lhs_remainder )
+			{
+				// Bits past the end of rhs are treated as unset
+				for ( size_type page = size, end = lhs.m_container.size(); page < end; ++page )
+				{
+					total_set += std::popcount( lhs.m_container[ page ] );
+				}
+			}
+			return total_set;
+		}
+
 	protected:
 		// Construct from undelying container, no trimming is performed, derived class should expose
 		// with its own trimming logic
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace mclo::detail
+{
+	// Bulk kernels for bitset_base, implemented with xsimd in the compiled library.
+	// They operate on raw bytes so they are shared by every underlying word size, bitwise operations and population
+	// counts give the same answer regardless of how the bytes are grouped into words.
+
+	template <typename T>
+	concept bitset_simd_word = std::same_as<T, std::uint8_t> || std::same_as<T, std::uint16_t> ||
+							   std::same_as<T, std::uint32_t> || std::same_as<T, std::uint64_t>;
+
+	// Below this many bytes the call overhead outweighs the vector width, so the scalar loops are used
+	inline constexpr std::size_t bitset_simd_min_bytes = 64;
+
+	void bitset_and_simd( std::uint8_t* lhs, const std::uint8_t* rhs, std::size_t num_bytes ) noexcept;
+	void bitset_or_simd( std::uint8_t* lhs, const std::uint8_t* rhs, std::size_t num_bytes ) noexcept;
+	void bitset_xor_simd( std::uint8_t* lhs, const std::uint8_t* rhs, std::size_t num_bytes ) noexcept;
+	void bitset_and_not_simd( std::uint8_t* lhs, const std::uint8_t* rhs, std::size_t num_bytes ) noexcept;
+
+	[[nodiscard]] std::size_t bitset_count_simd( const std::uint8_t* data, std::size_t num_bytes ) noexcept;
+	[[nodiscard]] std::size_t bitset_and_count_simd( const std::uint8_t* lhs,
+													 const std::uint8_t* rhs,
+													 std::size_t num_bytes ) noexcept;
+	[[nodiscard]] std::size_t bitset_or_count_simd( const std::uint8_t* lhs,
+													const std::uint8_t* rhs,
+													std::size_t num_bytes ) noexcept;
+	[[nodiscard]] std::size_t bitset_xor_count_simd( const std::uint8_t* lhs,
+													 const std::uint8_t* rhs,
+													 std::size_t num_bytes ) noexcept;
+	[[nodiscard]] std::size_t bitset_and_not_count_simd( const std::uint8_t* lhs,
+														 const std::uint8_t* rhs,
+														 std::size_t num_bytes ) noexcept;
+
+	// Returns the offset of the first non-zero byte, or num_bytes if every byte is zero
+	[[nodiscard]] std::size_t bitset_find_non_zero_simd( const std::uint8_t* data, std::size_t num_bytes ) noexcept;
+}
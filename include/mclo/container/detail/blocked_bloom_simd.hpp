@@ -0,0 +1,58 @@
+#pragma once
+
+#include "mclo/container/detail/filter_common.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mclo::detail
+{
+	// Split block Bloom filter blocks as used by Parquet and Impala, 256 bits as eight 32 bit words with a key setting
+	// one bit in each word. Blocks are aligned to their size so one never straddles a cache line.
+
+	inline constexpr std::size_t blocked_bloom_words = 8;
+
+	inline constexpr std::array<std::uint32_t, blocked_bloom_words> blocked_bloom_salts{
+		0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U };
+
+	struct alignas( 32 ) blocked_bloom_block
+	{
+		std::array<std::uint32_t, blocked_bloom_words> words;
+	};
+
+	/// @brief Where a key hash lands, the block from the high bits of the mixed hash and the key bits from the low
+	struct blocked_bloom_position
+	{
+		std::uint64_t block;
+		std::uint32_t key;
+	};
+
+	[[nodiscard]] constexpr blocked_bloom_position blocked_bloom_locate( const std::size_t hash,
+																		 const std::uint64_t num_blocks ) noexcept
+	{
+		const std::uint64_t mixed = filter_mix( hash );
+		return { filter_reduce( mixed, num_blocks ), static_cast<std::uint32_t>( mixed ) };
+	}
+
+	/// @brief The bit a key sets in one word of its block, from the top 5 bits of the key times the word's salt
+	[[nodiscard]] constexpr std::uint32_t blocked_bloom_bit( const std::uint32_t key, const std::size_t word ) noexcept
+	{
+		return std::uint32_t{ 1 } << ( ( key * blocked_bloom_salts[ word ] ) >> 27 );
+	}
+
+	// Bulk kernels for blocked_bloom_filter implemented with xsimd in the compiled library, each key's block and key
+	// bits come from its hash the same as the inline single key functions. Blocks of later keys are prefetched so the
+	// cache misses of a batch overlap.
+
+	void blocked_bloom_insert_simd( blocked_bloom_block* blocks,
+									std::uint64_t num_blocks,
+									const std::size_t* hashes,
+									std::size_t count ) noexcept;
+
+	void blocked_bloom_contains_simd( const blocked_bloom_block* blocks,
+									  std::uint64_t num_blocks,
+									  const std::size_t* hashes,
+									  std::size_t count,
+									  bool* results ) noexcept;
+}
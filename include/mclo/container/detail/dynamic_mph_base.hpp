@@ -0,0 +1,389 @@
+#pragma once
+
+#include "mclo/container/detail/mph_base.hpp"
+#include "mclo/container/minimal_perfect_hash.hpp"
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/memory/prefetch.hpp"
+#include "mclo/platform/attributes.hpp"
+#include "mclo/threading/parallel_for.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mclo::detail
+{
+	/// @brief Shared implementation for the runtime built minimal perfect hash containers @ref mclo::dynamic_mph_map
+	/// and @ref mclo::dynamic_mph_set.
+	/// @details Builds a @ref mclo::minimal_perfect_hash over the keys and stores them in the order of their perfect
+	/// hash index, so a lookup is one hash, one function evaluation and one key comparison. Like @ref mph_base the
+	/// contents are fixed after construction.
+	///
+	/// The keys are either owned or viewed in place from serialized data, in which case the container is only a view
+	/// and the data must outlive it.
+	/// @tparam Key The key type used for lookups.
+	/// @tparam Hash The salted hash functor, see @ref mclo::mph_hash.
+	/// @tparam KeyEquals The key equality comparator.
+	/// @tparam Allocator The allocator for the owned keys.
+	template <typename Key, typename Hash, typename KeyEquals, typename Allocator>
+	class MCLO_EMPTY_BASES dynamic_mph_base : private Hash, private KeyEquals
+	{
+	protected:
+		using key_storage = std::vector<Key, typename std::allocator_traits<Allocator>::template rebind_alloc<Key>>;
+
+		// Seeds only change when the hashes collide, which for 64 bit hashes means the keys were not unique
+		static constexpr std::size_t max_build_attempts = 4;
+
+		// Enough lookups in flight to hide memory latency while the group's state stays in registers and L1
+		static constexpr std::size_t lookup_group_size = 16;
+
+	public:
+		using key_type = Key;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using hasher = Hash;
+		using key_equal = KeyEquals;
+		using allocator_type = Allocator;
+
+		/// @brief Returned by index_of when the key is not present
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		/// @brief Constructs an empty container.
+		/// @param allocator The allocator to use.
+		explicit dynamic_mph_base( const allocator_type& allocator = allocator_type() )
+			: m_owned_keys( allocator )
+		{
+		}
+
+		dynamic_mph_base( const dynamic_mph_base& other )
+			: Hash( other )
+			, KeyEquals( other )
+			, m_function( other.m_function )
+			, m_owned_keys( other.m_owned_keys )
+		{
+			m_keys = other.is_view() ? other.m_keys : mclo::span<const Key>( m_owned_keys );
+		}
+
+		dynamic_mph_base( dynamic_mph_base&& other ) noexcept
+			: Hash( std::move( other ) )
+			, KeyEquals( std::move( other ) )
+			, m_function( std::move( other.m_function ) )
+			, m_owned_keys( std::move( other.m_owned_keys ) )
+			, m_keys( std::exchange( other.m_keys, {} ) )
+		{
+			other.m_owned_keys.clear();
+		}
+
+		dynamic_mph_base& operator=( const dynamic_mph_base& other )
+		{
+			if ( this != &other )
+			{
+				dynamic_mph_base copy( other );
+				*this = std::move( copy );
+			}
+			return *this;
+		}
+
+		dynamic_mph_base& operator=( dynamic_mph_base&& other ) noexcept(
+			std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+			std::allocator_traits<Allocator>::is_always_equal::value )
+		{
+			if ( this != &other )
+			{
+				// Unequal allocators that do not propagate copy the keys so the span can't be taken from other
+				const bool viewing = other.is_view();
+				static_cast<Hash&>( *this ) = std::move( other );
+				static_cast<KeyEquals&>( *this ) = std::move( other );
+				m_function = std::move( other.m_function );
+				m_owned_keys = std::move( other.m_owned_keys );
+				m_keys = viewing ? other.m_keys : mclo::span<const Key>( m_owned_keys );
+				other.m_owned_keys.clear();
+				other.m_keys = {};
+			}
+			return *this;
+		}
+
+		~dynamic_mph_base() = default;
+
+		/// @brief Gets the index of @p key, indices are dense in [0, size())
+		/// @param key The key to look up.
+		/// @return The index of @p key or npos if it is not present.
+		[[nodiscard]] size_type index_of( const key_type& key ) const
+		{
+			if ( m_keys.empty() ) [[unlikely]]
+			{
+				return npos;
+			}
+			const size_type index = m_function( hash( key ) );
+			return equals( m_keys[ index ], key ) ? index : npos;
+		}
+
+		/// @brief Gets the index of every key in a batch.
+		/// @details Lookups are pipelined in groups, every key in a group is hashed and its read of the function
+		/// prefetched, then every index is computed and its key prefetched before any keys are compared. The cache
+		/// misses of a group overlap instead of each lookup stalling on them in turn, which pays off once the container
+		/// is larger than the cache.
+		/// @param keys The keys to look up.
+		/// @param out Span to write the index of each key to, or npos if it is not present, must be the same size as
+		/// keys.
+		/// @return The number of keys present.
+		size_type index_of_many( const mclo::span<const key_type> keys, const mclo::span<size_type> out ) const
+		{
+			MCLO_DEBUG_ASSERT( keys.size() == out.size(), "Output must be the same size as keys" );
+			return find_indices(
+				keys,
+				[]( size_type ) {},
+				[ & ]( const std::size_t position, const size_type index ) {
+					out[ position ] = index;
+				} );
+		}
+
+		/// @brief Checks whether @p key is present.
+		/// @param key The key to look up.
+		/// @return @c true if @p key is stored in the container.
+		[[nodiscard]] bool contains( const key_type& key ) const
+		{
+			return index_of( key ) != npos;
+		}
+
+		/// @brief Returns the keys, ordered by their index.
+		[[nodiscard]] mclo::span<const key_type> keys() const noexcept
+		{
+			return m_keys;
+		}
+
+		/// @brief Returns the number of elements.
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_keys.size();
+		}
+
+		/// @brief Checks whether the container is empty.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_keys.empty();
+		}
+
+		/// @brief Checks whether the container is viewing serialized data instead of owning its elements.
+		[[nodiscard]] bool is_view() const noexcept
+		{
+			return m_owned_keys.empty() && !m_keys.empty();
+		}
+
+		/// @brief Returns the perfect hash function mapping key hashes to indices.
+		[[nodiscard]] const minimal_perfect_hash& hash_function() const noexcept
+		{
+			return m_function;
+		}
+
+		/// @brief Returns the allocator used for owned elements.
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return allocator_type( m_owned_keys.get_allocator() );
+		}
+
+	protected:
+		/// @brief Find the index of every key in a batch, see @ref index_of_many
+		/// @param keys The keys to look up
+		/// @param prefetch_index Invoked with each index as soon as it is known, to prefetch data stored alongside keys
+		/// @param func Invoked with the position in keys and the index of the key there, or npos if it is not present
+		/// @return The number of keys present
+		template <typename PrefetchIndex, typename Func>
+		size_type find_indices( const mclo::span<const key_type> keys, PrefetchIndex prefetch_index, Func func ) const
+		{
+			if ( m_keys.empty() ) [[unlikely]]
+			{
+				for ( std::size_t position = 0; position < keys.size(); ++position )
+				{
+					func( position, npos );
+				}
+				return 0;
+			}
+
+			std::array<std::uint64_t, lookup_group_size> hashes;
+			std::array<size_type, lookup_group_size> indices;
+			size_type num_found = 0;
+			for ( std::size_t first = 0; first < keys.size(); first += lookup_group_size )
+			{
+				const std::size_t count = std::min( lookup_group_size, keys.size() - first );
+				for ( std::size_t offset = 0; offset < count; ++offset )
+				{
+					hashes[ offset ] = hash( keys[ first + offset ] );
+					m_function.prefetch( hashes[ offset ] );
+				}
+				for ( std::size_t offset = 0; offset < count; ++offset )
+				{
+					indices[ offset ] = m_function( hashes[ offset ] );
+					mclo::prefetch( m_keys.data() + indices[ offset ] );
+					prefetch_index( indices[ offset ] );
+				}
+				for ( std::size_t offset = 0; offset < count; ++offset )
+				{
+					const bool found = equals( m_keys[ indices[ offset ] ], keys[ first + offset ] );
+					num_found += found;
+					func( first + offset, found ? indices[ offset ] : npos );
+				}
+			}
+			return num_found;
+		}
+
+		/// @brief Build the perfect hash and store the keys in index order.
+		/// @param count Number of keys.
+		/// @param key_at Invoked with an input position to get the key there.
+		/// @param options Options to build the perfect hash with.
+		/// @return For each index, the input position of the key stored there.
+		template <typename KeyAt>
+		std::vector<std::size_t> build( const std::size_t count, KeyAt key_at, const mph_build_options& options )
+		{
+			std::vector<std::uint64_t> hashes( count );
+			for ( std::size_t attempt = 0;; ++attempt )
+			{
+				if ( attempt == max_build_attempts )
+				{
+					throw std::invalid_argument( "Minimal perfect hash keys must be unique" );
+				}
+
+				const std::size_t seed = static_cast<std::size_t>( mclo::avalanche_bits( attempt + 1 ) );
+				parallel_for_chunks(
+					options.num_threads,
+					count,
+					[ & ]( std::size_t, const std::size_t begin, const std::size_t end ) {
+						for ( std::size_t index = begin; index < end; ++index )
+						{
+							hashes[ index ] = static_cast<std::uint64_t>( hash( key_at( index ), seed ) );
+						}
+					} );
+
+				if ( std::optional<minimal_perfect_hash> function =
+						 minimal_perfect_hash::build( hashes, seed, options ) )
+				{
+					m_function = std::move( *function );
+					break;
+				}
+			}
+
+			// Indices are unique so each chunk can scatter without synchronization
+			std::vector<std::size_t> position_at( count );
+			parallel_for_chunks(
+				options.num_threads,
+				count,
+				[ & ]( std::size_t, const std::size_t begin, const std::size_t end ) {
+					for ( std::size_t index = begin; index < end; ++index )
+					{
+						position_at[ m_function( hashes[ index ] ) ] = index;
+					}
+				} );
+
+			m_owned_keys.reserve( count );
+			for ( const std::size_t position : position_at )
+			{
+				m_owned_keys.emplace_back( key_at( position ) );
+			}
+			m_keys = m_owned_keys;
+			return position_at;
+		}
+
+		/// @brief Bytes used to serialize count elements of T, padded to keep the next array aligned
+		template <typename T>
+		[[nodiscard]] static constexpr std::size_t array_bytes( const std::size_t count ) noexcept
+		{
+			static_assert( alignof( T ) <= alignof( std::uint64_t ), "Serialized arrays are only 8 byte aligned" );
+			return ( count * sizeof( T ) + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t ) *
+				   sizeof( std::uint64_t );
+		}
+
+		/// @brief Write an array after the function and any previous arrays
+		template <typename T>
+		static std::size_t write_array( const mclo::span<const T> values, const mclo::span<std::byte> out ) noexcept
+		{
+			const std::size_t bytes = array_bytes<T>( values.size() );
+			std::memset( out.data(), 0, bytes );
+			if ( !values.empty() )
+			{
+				std::memcpy( out.data(), values.data(), values.size() * sizeof( T ) );
+			}
+			return bytes;
+		}
+
+		[[nodiscard]] std::size_t serialized_keys_size() const noexcept
+		{
+			return m_function.serialized_size() + array_bytes<Key>( size() );
+		}
+
+		std::size_t serialize_keys( const mclo::span<std::byte> out ) const noexcept
+		{
+			const std::size_t function_bytes = m_function.serialize( out );
+			return function_bytes + write_array( m_keys, out.subspan( function_bytes ) );
+		}
+
+		/// @brief Load the function and keys from serialized data, by view or by copy
+		/// @return The remaining data after the keys, or std::nullopt if the data is invalid
+		std::optional<mclo::span<const std::byte>> load_keys( const mclo::span<const std::byte> data,
+															  const bool copy )
+		{
+			std::optional<minimal_perfect_hash> function =
+				copy ? minimal_perfect_hash::deserialize( data ) : minimal_perfect_hash::view( data );
+			if ( !function )
+			{
+				return std::nullopt;
+			}
+			const std::size_t num_keys = function->size();
+			const std::size_t function_bytes = function->serialized_size();
+			if ( num_keys > ( data.size() - function_bytes ) / sizeof( Key ) ||
+				 array_bytes<Key>( num_keys ) > data.size() - function_bytes )
+			{
+				return std::nullopt;
+			}
+
+			m_function = std::move( *function );
+			const mclo::span<const std::byte> key_bytes = data.subspan( function_bytes );
+			if ( copy )
+			{
+				m_owned_keys.resize( num_keys );
+				if ( num_keys != 0 )
+				{
+					std::memcpy( m_owned_keys.data(), key_bytes.data(), num_keys * sizeof( Key ) );
+				}
+				m_keys = m_owned_keys;
+			}
+			else
+			{
+				m_keys = mclo::span<const Key>( reinterpret_cast<const Key*>( key_bytes.data() ), num_keys );
+			}
+			return key_bytes.subspan( array_bytes<Key>( num_keys ) );
+		}
+
+		/// @brief Hashes @p key with @p salt using the @p Hash functor.
+		[[nodiscard]] std::size_t hash( const Key& key, const std::size_t salt ) const noexcept
+		{
+			return static_cast<const Hash&>( *this )( key, salt );
+		}
+		/// @brief Hashes @p key with the seed of the perfect hash function.
+		[[nodiscard]] std::uint64_t hash( const Key& key ) const noexcept
+		{
+			return static_cast<std::uint64_t>( hash( key, static_cast<std::size_t>( m_function.seed() ) ) );
+		}
+		/// @brief Compares @p lhs and @p rhs for equality using the @p KeyEquals functor.
+		[[nodiscard]] bool equals( const Key& lhs, const Key& rhs ) const noexcept
+		{
+			return static_cast<const KeyEquals&>( *this )( lhs, rhs );
+		}
+
+	private:
+		minimal_perfect_hash m_function;
+
+		/// @brief Keys in index order when owned, empty when viewing serialized data
+		key_storage m_owned_keys;
+
+		/// @brief The keys in use, either m_owned_keys or the viewed data
+		mclo::span<const Key> m_keys;
+	};
+}
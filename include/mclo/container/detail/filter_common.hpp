@@ -0,0 +1,156 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/numeric/128_bit_integer.hpp"
+#include "mclo/random/seed_mixing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ranges>
+
+namespace mclo::detail
+{
+	// Shared by the probabilistic filters and sketches, bloom_filter, blocked_bloom_filter, cuckoo_filter,
+	// count_min_sketch and hyperloglog
+
+	/// @brief Spreads a key hash over all 64 bits, some hashers such as murmur_hash_3 only fill the low 32
+	[[nodiscard]] constexpr std::uint64_t filter_mix( const std::size_t hash ) noexcept
+	{
+		return mclo::avalanche_bits( static_cast<std::uint64_t>( hash ) );
+	}
+
+	/// @brief Maps a uniform 64 bit value onto [0, range) with a multiply instead of a modulo
+	[[nodiscard]] constexpr std::uint64_t filter_reduce( const std::uint64_t value, const std::uint64_t range ) noexcept
+	{
+		return static_cast<std::uint64_t>( ( static_cast<mclo::uint128_t>( value ) * range ) >> 64 );
+	}
+
+	/// @brief Double hashing, probe i is at h1 + i * h2 over 64 bits reduced onto the range
+	class filter_probe
+	{
+	public:
+		explicit constexpr filter_probe( const std::size_t hash ) noexcept
+			: m_value( filter_mix( hash ) )
+			, m_step( std::rotl( m_value, 32 ) | 1 )
+		{
+		}
+
+		[[nodiscard]] constexpr std::size_t next( const std::size_t range ) noexcept
+		{
+			const auto result = static_cast<std::size_t>( filter_reduce( m_value, range ) );
+			m_value += m_step;
+			return result;
+		}
+
+	private:
+		std::uint64_t m_value;
+		std::uint64_t m_step;
+	};
+
+	/// @brief Keys hashed at a time by the bulk functions, keeps the hashes on the stack
+	inline constexpr std::size_t hash_batch_size = 64;
+
+	/// @brief Hash keys a batch at a time, calling func with the hashes, their count and the index of the first
+	/// @details Contiguous ranges are hashed as spans so the hasher's bulk hash_many is used where it has one
+	template <typename Key, hasher Hasher, std::ranges::forward_range Range, typename Func>
+	void for_each_hash_batch( Range& keys, Func func ) noexcept
+	{
+		std::array<std::size_t, hash_batch_size> hashes;
+		if constexpr ( std::ranges::contiguous_range<Range> )
+		{
+			const mclo::span<const Key> all( keys );
+			for ( std::size_t offset = 0; offset < all.size(); offset += hash_batch_size )
+			{
+				const auto batch = all.subspan( offset, std::min( hash_batch_size, all.size() - offset ) );
+				hash_many<Hasher>( batch, hashes );
+				func( hashes.data(), batch.size(), offset );
+			}
+		}
+		else
+		{
+			auto it = std::ranges::begin( keys );
+			const auto last = std::ranges::end( keys );
+			for ( std::size_t offset = 0; it != last; )
+			{
+				std::size_t count = 0;
+				for ( ; it != last && count < hash_batch_size; ++it, ++count )
+				{
+					hashes[ count ] = hash_object<Hasher>( *it );
+				}
+				func( hashes.data(), count, offset );
+				offset += count;
+			}
+		}
+	}
+
+	// A serialized filter is a header of 64 bit words starting with a magic number, followed by its array of words,
+	// all in native endianness with the array padded to a whole number of 64 bit words
+
+	template <typename Word>
+	[[nodiscard]] constexpr std::size_t filter_serialized_size( const std::size_t header_words,
+																const std::size_t num_words ) noexcept
+	{
+		const std::size_t array_bytes = num_words * sizeof( Word );
+		return header_words * sizeof( std::uint64_t ) +
+			   ( array_bytes + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t ) * sizeof( std::uint64_t );
+	}
+
+	template <typename Word, std::size_t HeaderWords>
+	std::size_t serialize_filter( const std::array<std::uint64_t, HeaderWords>& header,
+								  const mclo::span<const Word> words,
+								  const mclo::span<std::byte> out ) noexcept
+	{
+		const std::size_t size = filter_serialized_size<Word>( HeaderWords, words.size() );
+		MCLO_DEBUG_ASSERT( out.size() >= size, "Output buffer too small", out.size(), size );
+		std::memset( out.data(), 0, size );
+		std::memcpy( out.data(), header.data(), sizeof( header ) );
+		if ( !words.empty() )
+		{
+			std::memcpy( out.data() + sizeof( header ), words.data(), words.size_bytes() );
+		}
+		return size;
+	}
+
+	/// @brief Read the header of a serialized filter
+	/// @return The header or std::nullopt if data is too short or is not a filter of the type magic identifies
+	template <std::size_t HeaderWords>
+	[[nodiscard]] std::optional<std::array<std::uint64_t, HeaderWords>> read_filter_header(
+		const mclo::span<const std::byte> data, const std::uint64_t magic ) noexcept
+	{
+		std::array<std::uint64_t, HeaderWords> header;
+		if ( data.size() < sizeof( header ) )
+		{
+			return std::nullopt;
+		}
+		std::memcpy( header.data(), data.data(), sizeof( header ) );
+		if ( header[ 0 ] != magic )
+		{
+			return std::nullopt;
+		}
+		return header;
+	}
+
+	/// @brief Copy the array of a serialized filter following its header into out
+	/// @return If data held all of the array
+	template <typename Word, std::size_t HeaderWords>
+	[[nodiscard]] bool read_filter_words( const mclo::span<const std::byte> data, const mclo::span<Word> out ) noexcept
+	{
+		constexpr std::size_t header_bytes = HeaderWords * sizeof( std::uint64_t );
+		if ( out.size() > ( data.size() - header_bytes ) / sizeof( Word ) )
+		{
+			return false;
+		}
+		if ( !out.empty() )
+		{
+			std::memcpy( out.data(), data.data() + header_bytes, out.size_bytes() );
+		}
+		return true;
+	}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "mclo/container/arrow_proxy.hpp"
+
+#include <compare>
+#include <concepts>
+#include <iterator>
+#include <utility>
+
+namespace mclo
+{
+	template <typename Key, typename T, typename Compare, typename Layout, typename Allocator>
+	class flat_map;
+
+	/// @brief A random-access iterator over a @ref flat_map, pairing its separate key and value arrays.
+	/// @details Dereferencing produces a @c std::pair of a const reference to the key and a reference to the value.
+	/// @tparam KeyIt The const iterator of the key array.
+	/// @tparam ValueIt The iterator of the value array, const for const iterators.
+	template <typename KeyIt, typename ValueIt>
+	class flat_map_iterator
+	{
+		template <typename, typename>
+		friend class flat_map_iterator;
+
+		template <typename, typename, typename, typename, typename>
+		friend class flat_map;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using difference_type = std::iter_difference_t<KeyIt>;
+		using value_type = std::pair<std::iter_value_t<KeyIt>, std::iter_value_t<ValueIt>>;
+		using reference = std::pair<std::iter_reference_t<KeyIt>, std::iter_reference_t<ValueIt>>;
+		using pointer = arrow_proxy<reference>;
+
+		/// @brief Constructs a singular iterator.
+		flat_map_iterator() = default;
+
+		/// @brief Converts a mutable iterator to a const iterator.
+		template <typename OtherValueIt>
+			requires( !std::same_as<OtherValueIt, ValueIt> && std::convertible_to<OtherValueIt, ValueIt> )
+		flat_map_iterator( const flat_map_iterator<KeyIt, OtherValueIt>& other ) noexcept
+			: m_key( other.m_key )
+			, m_value( other.m_value )
+		{
+		}
+
+		/// @brief Returns the current key/value pair.
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return reference{ *m_key, *m_value };
+		}
+
+		/// @brief Returns a proxy granting member access to the current key/value pair.
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return { operator*() };
+		}
+
+		/// @brief Returns the key/value pair @p diff positions away.
+		[[nodiscard]] reference operator[]( const difference_type diff ) const noexcept
+		{
+			return reference{ m_key[ diff ], m_value[ diff ] };
+		}
+
+		flat_map_iterator& operator++() noexcept
+		{
+			++m_key;
+			++m_value;
+			return *this;
+		}
+
+		flat_map_iterator operator++( int ) noexcept
+		{
+			flat_map_iterator copy( *this );
+			++*this;
+			return copy;
+		}
+
+		flat_map_iterator& operator--() noexcept
+		{
+			--m_key;
+			--m_value;
+			return *this;
+		}
+
+		flat_map_iterator operator--( int ) noexcept
+		{
+			flat_map_iterator copy( *this );
+			--*this;
+			return copy;
+		}
+
+		flat_map_iterator& operator+=( const difference_type diff ) noexcept
+		{
+			m_key += diff;
+			m_value += diff;
+			return *this;
+		}
+
+		flat_map_iterator& operator-=( const difference_type diff ) noexcept
+		{
+			m_key -= diff;
+			m_value -= diff;
+			return *this;
+		}
+
+		/// @brief Orders two iterators by their position.
+		[[nodiscard]] friend std::strong_ordering operator<=>( const flat_map_iterator& lhs,
+															   const flat_map_iterator& rhs ) noexcept
+		{
+			return lhs.m_key <=> rhs.m_key;
+		}
+		/// @brief Compares two iterators for equality by position.
+		[[nodiscard]] friend bool operator==( const flat_map_iterator& lhs, const flat_map_iterator& rhs ) noexcept
+		{
+			return lhs.m_key == rhs.m_key;
+		}
+
+		[[nodiscard]] friend flat_map_iterator operator+( const flat_map_iterator& it,
+														  const difference_type diff ) noexcept
+		{
+			auto temp = it;
+			temp += diff;
+			return temp;
+		}
+		[[nodiscard]] friend flat_map_iterator operator+( const difference_type diff,
+														  const flat_map_iterator& it ) noexcept
+		{
+			return it + diff;
+		}
+		[[nodiscard]] friend flat_map_iterator operator-( const flat_map_iterator& it,
+														  const difference_type diff ) noexcept
+		{
+			auto temp = it;
+			temp -= diff;
+			return temp;
+		}
+		/// @brief Returns the number of entries between @p lhs and @p rhs.
+		[[nodiscard]] friend difference_type operator-( const flat_map_iterator& lhs,
+														const flat_map_iterator& rhs ) noexcept
+		{
+			return lhs.m_key - rhs.m_key;
+		}
+
+	private:
+		flat_map_iterator( KeyIt key, ValueIt value ) noexcept
+			: m_key( std::move( key ) )
+			, m_value( std::move( value ) )
+		{
+		}
+
+		KeyIt m_key{};
+		ValueIt m_value{};
+	};
+}
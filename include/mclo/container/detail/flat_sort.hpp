@@ -0,0 +1,41 @@
+#pragma once
+
+#include "mclo/algorithm/radix_sort.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace mclo::detail
+{
+	/// @brief Keys the flat containers sort with @ref radix_sort, integers ordered by their natural order
+	template <typename Key, typename Compare>
+	concept flat_radix_sortable = std::integral<Key> && !std::same_as<Key, bool> &&
+								  ( std::same_as<Compare, std::less<Key>> || std::same_as<Compare, std::less<>> );
+
+	/// @brief Stable sort of a random access range, with @ref radix_sort where the keys allow it
+	template <typename Compare, std::random_access_iterator It, typename KeyExtractor = std::identity>
+	void flat_stable_sort( const It first, const It last, const Compare& comp, KeyExtractor key_extractor = {} )
+	{
+		using value_type = std::iter_value_t<It>;
+		using key_type = std::remove_cvref_t<std::invoke_result_t<KeyExtractor&, const value_type&>>;
+		if constexpr ( flat_radix_sortable<key_type, Compare> )
+		{
+			std::vector<value_type> buffer( static_cast<std::size_t>( last - first ) );
+			if ( radix_sort( first, last, buffer.begin(), key_extractor ) == radix_sort_result::in_output )
+			{
+				std::move( buffer.begin(), buffer.end(), first );
+			}
+		}
+		else
+		{
+			std::stable_sort( first, last, [ &comp, &key_extractor ]( const value_type& lhs, const value_type& rhs ) {
+				return comp( std::invoke( key_extractor, lhs ), std::invoke( key_extractor, rhs ) );
+			} );
+		}
+	}
+}
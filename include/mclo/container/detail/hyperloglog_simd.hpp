@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mclo::detail
+{
+	// Bulk kernel for hyperloglog implemented with xsimd in the compiled library, merging dense registers is a byte
+	// wise maximum so runs a whole vector of registers at a time.
+
+	void hyperloglog_merge_simd( std::uint8_t* registers, const std::uint8_t* other, std::size_t count ) noexcept;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "mclo/container/intrusive_hash_table_hook.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace mclo
+{
+	template <typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Tag, typename Allocator>
+	class intrusive_hash_table;
+
+	template <typename T, typename Tag>
+	class intrusive_hash_table_iterator
+	{
+		using hook_type = intrusive_hash_table_hook<Tag>;
+		static_assert( std::derived_from<T, hook_type>, "T must be derived from the intrusive hash table hook" );
+
+		static_assert( std::is_object_v<T> );
+
+		template <typename, typename>
+		friend class intrusive_hash_table_iterator;
+
+		template <typename, typename, typename, typename, typename, typename>
+		friend class intrusive_hash_table;
+
+		template <typename U>
+		static constexpr bool same_type = std::same_as<std::remove_const_t<T>, std::remove_const_t<U>>;
+
+	public:
+		using value_type = std::remove_const_t<T>;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using pointer = T*;
+		using iterator_category = std::forward_iterator_tag;
+		using iterator_concept = std::forward_iterator_tag;
+
+		intrusive_hash_table_iterator() = default;
+
+		template <typename U>
+			requires( same_type<U> && ( std::is_const_v<T> || !std::is_const_v<U> ) )
+		intrusive_hash_table_iterator( const intrusive_hash_table_iterator<U, Tag>& other ) noexcept
+			: m_buckets( other.m_buckets )
+			, m_bucket_count( other.m_bucket_count )
+			, m_hook( other.m_hook )
+		{
+		}
+
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return *static_cast<pointer>( m_hook );
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return static_cast<pointer>( m_hook );
+		}
+
+		intrusive_hash_table_iterator& operator++() noexcept
+		{
+			if ( m_hook->m_next )
+			{
+				m_hook = m_hook->m_next;
+				return *this;
+			}
+
+			// Move on to the next non empty bucket, the bucket count is a power of two
+			std::size_t bucket = ( m_hook->m_hash & ( m_bucket_count - 1 ) ) + 1;
+			while ( bucket < m_bucket_count && !m_buckets[ bucket ] )
+			{
+				++bucket;
+			}
+			m_hook = bucket < m_bucket_count ? m_buckets[ bucket ] : nullptr;
+			return *this;
+		}
+
+		intrusive_hash_table_iterator operator++( int ) noexcept
+		{
+			intrusive_hash_table_iterator temp( *this );
+			++( *this );
+			return temp;
+		}
+
+		template <typename U>
+			requires( same_type<U> )
+		[[nodiscard]] bool operator==( const intrusive_hash_table_iterator<U, Tag>& other ) const noexcept
+		{
+			return m_hook == other.m_hook;
+		}
+
+	private:
+		intrusive_hash_table_iterator( hook_type* const* const buckets,
+									   const std::size_t bucket_count,
+									   hook_type* const hook ) noexcept
+			: m_buckets( buckets )
+			, m_bucket_count( bucket_count )
+			, m_hook( hook )
+		{
+		}
+
+		hook_type* const* m_buckets = nullptr;
+		std::size_t m_bucket_count = 0;
+		hook_type* m_hook = nullptr;
+	};
+}
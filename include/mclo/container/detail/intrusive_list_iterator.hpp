@@ -0,0 +1,100 @@
+#pragma once
+
+#include "mclo/container/intrusive_list_hook.hpp"
+
+#include <concepts>
+#include <iterator>
+#include <type_traits>
+
+namespace mclo
+{
+	template <typename T, typename Tag>
+	class intrusive_list;
+
+	template <typename T, typename Tag>
+	class intrusive_list_iterator
+	{
+		using hook_type = intrusive_list_hook<Tag>;
+		using hook_pointer = std::conditional_t<std::is_const_v<T>, const hook_type*, hook_type*>;
+		static_assert( std::derived_from<T, hook_type>, "T must be derived from the intrusive list hook" );
+
+		static_assert( std::is_object_v<T> );
+
+		template <typename, typename>
+		friend class intrusive_list_iterator;
+
+		friend class intrusive_list<std::remove_const_t<T>, Tag>;
+
+		template <typename U>
+		static constexpr bool same_type = std::same_as<std::remove_const_t<T>, std::remove_const_t<U>>;
+
+	public:
+		using value_type = std::remove_const_t<T>;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using pointer = T*;
+		using iterator_category = std::bidirectional_iterator_tag;
+		using iterator_concept = std::bidirectional_iterator_tag;
+
+		intrusive_list_iterator() = default;
+
+		template <typename U>
+			requires( same_type<U> && ( std::is_const_v<T> || !std::is_const_v<U> ) )
+		intrusive_list_iterator( const intrusive_list_iterator<U, Tag>& other ) noexcept
+			: m_hook( other.m_hook )
+		{
+		}
+
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return *static_cast<pointer>( m_hook );
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return static_cast<pointer>( m_hook );
+		}
+
+		intrusive_list_iterator& operator++() noexcept
+		{
+			m_hook = m_hook->m_next;
+			return *this;
+		}
+
+		intrusive_list_iterator operator++( int ) noexcept
+		{
+			intrusive_list_iterator temp( *this );
+			++( *this );
+			return temp;
+		}
+
+		intrusive_list_iterator& operator--() noexcept
+		{
+			m_hook = m_hook->m_prev;
+			return *this;
+		}
+
+		intrusive_list_iterator operator--( int ) noexcept
+		{
+			intrusive_list_iterator temp( *this );
+			--( *this );
+			return temp;
+		}
+
+		template <typename U>
+			requires( same_type<U> )
+		[[nodiscard]] bool operator==( const intrusive_list_iterator<U, Tag>& other ) const noexcept
+		{
+			return m_hook == other.m_hook;
+		}
+
+	private:
+		// Holds the hook rather than the value as the end iterator points at the list's sentinel hook
+		explicit intrusive_list_iterator( const hook_pointer hook ) noexcept
+			: m_hook( hook )
+		{
+		}
+
+		hook_pointer m_hook = nullptr;
+	};
+}
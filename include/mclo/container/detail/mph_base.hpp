@@ -1,15 +1,22 @@
 #pragma once
 
 #include "mclo/container/detail/nontrivial_dummy_type.hpp"
+#include "mclo/container/span.hpp"
 #include "mclo/debug/assert.hpp"
 #include "mclo/hash/constexpr_hash.hpp"
+#include "mclo/memory/prefetch.hpp"
+#include "mclo/numeric/standard_integer_type.hpp"
 #include "mclo/platform/attributes.hpp"
 #include "mclo/platform/cpp_feature_compat.hpp"
 
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <cstdint>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace mclo
@@ -75,9 +82,12 @@ namespace mclo::detail
 	/// @brief Shared implementation for the minimal perfect hash containers @ref mclo::mph_map and @ref mclo::mph_set.
 	/// @details Builds, at construction (which is usable in a constant expression), a minimal perfect hash over a fixed
 	/// set of @p Size keys so that every key maps to a unique slot with no collisions and no wasted space. Each key is
-	/// first hashed with a primary salt into a bucket; buckets are then resolved largest-first, each finding a
-	/// secondary salt that scatters its entries into free slots, while single-entry buckets are placed directly.
-	/// Lookups therefore touch at most two hashes and one comparison. The container is fixed-size and immutable after
+	/// hashed once into a bucket, buckets are then placed largest-first, each finding a displacement that moves all of
+	/// its keys into free slots. Construction is roughly linear in @p Size so tables of thousands of keys build within
+	/// the default constant evaluation limits.
+	///
+	/// Lookups take one hash, one displacement read and a branchless slot computation, a one byte fingerprint stored
+	/// per slot then rejects most absent keys before comparing keys. The container is fixed-size and immutable after
 	/// construction.
 	/// @tparam Key The key type used for lookups.
 	/// @tparam StoredValue The element type stored in each slot (the key itself for a set, a key/value pair for a map).
@@ -90,42 +100,52 @@ namespace mclo::detail
 	{
 	private:
 		/*
-		 * Every entry gets hashed into a bucket using a primary salt, multiple entries can hash to the same bucket
-		 * We distribute them into the actual slots by using a second hash with a value that guarantees the bucket
-		 * puts things into empty slots, we process the largest buckets first. We store this secondary salt for lookup.
+		 * Every key is hashed once with the seed, the hash is split into a bucket, a base slot, a step and a
+		 * fingerprint. A key's slot is ( base + step * multiplier + offset ) % Size where each bucket stores its own
+		 * multiplier and offset, the displacement scheme from compress, hash and displace.
 		 *
-		 * Single item buckets just take whatever slots are left and instead of storing the salt they store the index
-		 * in the actual entry storage, they store this as -index - 1. That way we can tell later by the sign how to
-		 * handle.
+		 * Buckets are placed largest first while the table is mostly empty. For each multiplier the bucket's keys get
+		 * their unshifted slots, then we try offsets that move the first key onto each free slot in turn and keep the
+		 * first that lands every other key on a free slot too. Single key buckets, the majority, need no search as a
+		 * zero multiplier and the right offset moves the key directly onto any free slot.
 		 *
-		 * To look up something we hash the key with the primary salt to find the bucket it would be in, we load the
-		 * secondary salt for that bucket and if it is positive then it is a salt we use to hash again to find the
-		 * object slot. If it is negative we take -index - 1 to get the index of the direct slot it got place in.
-		 *
-		 * This guarantees every object hashes to one single slot with minimal extra data overhead and that we handle
-		 * conflicts in such a way that we find a perfect set of secondary salts in the minimal number of loops.
+		 * Free slots are tracked in an unordered list so the search is proportional to the candidates tried rather
+		 * than the table size. If a bucket can't be placed, or two keys share a hash, we retry with another seed,
+		 * equal keys fail every seed.
 		 */
 
 		template <typename T>
 		using sized_array = std::array<T, Size>;
 
-		// 0 is used as a sentinel value in setup so must be less than max
-		static_assert( Size < std::numeric_limits<std::size_t>::max(), "Too many entries" );
+		static_assert( Size > 0, "A minimal perfect hash needs at least one entry" );
+		static_assert( Size < std::numeric_limits<std::uint32_t>::max(), "Too many entries" );
+
+		// Two keys per bucket on average keeps buckets small enough to place quickly
+		static constexpr std::size_t num_buckets = Size / 2 + 1;
+
+		static constexpr std::size_t first_seed = 42;
+		static constexpr std::size_t max_seed_attempts = 8;
+
+		// Bounds the search for a bucket, failing is rare and just retries with another seed
+		static constexpr std::size_t max_multiplier = std::min<std::size_t>( Size, 64 );
+
+		// Enough lookups in flight to hide memory latency while the group's state stays in registers and L1
+		static constexpr std::size_t lookup_group_size = 16;
 
-		static constexpr std::size_t primary_salt = 42;
+		using displacement_type = uint_least_t<std::max<std::size_t>( std::bit_width( Size - 1 ), 1 )>;
 
-		// Buckets are stored inline in setup in a singly linked list
-		struct primary_bucket_entry
+		struct bucket_displacement
 		{
-			std::size_t m_data_index = 0;
-			primary_bucket_entry* m_next = nullptr;
+			displacement_type m_multiplier = 0;
+			displacement_type m_offset = 0;
 		};
 
-		// We store the size so we can sort by it since the linked list does not have O(1) size itself
-		struct primary_bucket
+		struct split_key_hash
 		{
-			std::size_t m_size = 0;
-			primary_bucket_entry* m_head = nullptr;
+			std::uint32_t m_bucket = 0;
+			std::uint32_t m_base = 0;
+			std::uint32_t m_step = 0;
+			std::uint8_t m_fingerprint = 0;
 		};
 
 		using storage_array = sized_array<StoredValue>;
@@ -147,108 +167,26 @@ namespace mclo::detail
 		using const_reverse_iterator = typename storage_array::const_reverse_iterator;
 
 		/// @brief Constructs the container by building a minimal perfect hash over @p data.
-		/// @details Distributes the @p Size keys into buckets, resolves secondary salts so each key lands in a unique
-		/// slot, and then constructs the stored values into those slots.
+		/// @details Groups the @p Size keys into buckets, finds a displacement for each bucket so every key lands in a
+		/// unique slot, and then constructs the stored values into those slots.
 		/// @param data The exact set of @p Size elements to store; keys must be unique.
+		/// @throws std::invalid_argument If no seed places every key, almost always because the keys are not unique.
 		constexpr mph_base( const sized_array<value_type>& data )
 		{
-			// Every entry gets hashed into a bucket, the bucket maintains a linked list of everything
-			// hashed into it and we then spread them out later
-			sized_array<primary_bucket_entry> bucket_entries{};
-			sized_array<primary_bucket> buckets{};
-
-			for ( std::size_t data_index = 0; data_index < Size; ++data_index )
-			{
-				primary_bucket_entry& entry = bucket_entries[ data_index ];
-				entry.m_data_index = data_index;
-
-				const std::size_t bucket_index = hash( get_key( data[ data_index ] ), primary_salt ) % Size;
-				primary_bucket& bucket = buckets[ bucket_index ];
-				++bucket.m_size;
-
-				entry.m_next = bucket.m_head;
-				bucket.m_head = &entry;
-			}
-
-			// We sort the indices so we process the largest buckets first as they are hardest to find a valid
-			// salt for
-			sized_array<std::size_t> sorted_bucket_indices{};
-			std::iota( sorted_bucket_indices.begin(), sorted_bucket_indices.end(), 0 );
-
-			std::sort( sorted_bucket_indices.begin(),
-					   sorted_bucket_indices.end(),
-					   [ &buckets ]( const std::size_t lhs_index, const std::size_t rhs_index ) {
-						   return buckets[ lhs_index ].m_size > buckets[ rhs_index ].m_size;
-					   } );
-
 			// Stores data index + 1, 0 means unused
 			sized_array<std::size_t> slot_data_index{};
 
-			std::size_t sorted_index = 0;
-			for ( ; sorted_index < Size; ++sorted_index )
+			for ( std::size_t attempt = 0;; ++attempt )
 			{
-				const std::size_t bucket_index = sorted_bucket_indices[ sorted_index ];
-				const primary_bucket& bucket = buckets[ bucket_index ];
-
-				// Single elements can be handled simply later
-				if ( bucket.m_size <= 1 )
+				if ( attempt == max_seed_attempts )
 				{
-					break;
+					throw std::invalid_argument( "Could not build minimal perfect hash, keys may not be unique" );
 				}
-
-				// We repeatedly try salts for this bucket to put each entry into an empty slot
-				std::int32_t salt = 0;
-
-				sized_array<std::size_t> potential_slot_data_index = slot_data_index;
-				primary_bucket_entry* next = bucket.m_head;
-
-				while ( next )
-				{
-					const std::size_t data_index = next->m_data_index;
-					const std::size_t slot = hash( get_key( data[ data_index ] ), salt ) % Size;
-					if ( potential_slot_data_index[ slot ] != 0 )
-					{
-						// Start over increase the salt we use
-						next = bucket.m_head;
-						potential_slot_data_index = slot_data_index;
-						++salt;
-					}
-					else
-					{
-						// Keep trying to see if we keep this salt
-						potential_slot_data_index[ slot ] = data_index + 1;
-						next = next->m_next;
-					}
-				}
-
-				// Found a valid salt for this bucket, we store it and our new slot configuration for next loop
-				slot_data_index = potential_slot_data_index;
-				m_salts[ bucket_index ] = salt;
-			}
-
-			// Single element buckets we just distribute them in order of whatever slot is free
-			std::size_t empty_search_start = 0;
-			for ( ; sorted_index < Size; ++sorted_index )
-			{
-				const std::size_t bucket_index = sorted_bucket_indices[ sorted_index ];
-				const primary_bucket& bucket = buckets[ bucket_index ];
-
-				// Bucket indices are sorted so first zero means we are done
-				if ( bucket.m_size == 0 )
+				m_seed = first_seed + attempt;
+				if ( try_place( data, slot_data_index ) )
 				{
 					break;
 				}
-
-				for ( std::size_t index = empty_search_start; index < Size; ++index )
-				{
-					if ( slot_data_index[ index ] == 0 )
-					{
-						m_salts[ bucket_index ] = -static_cast<std::int32_t>( index ) - 1;
-						empty_search_start = index + 1;
-						slot_data_index[ index ] = bucket.m_head->m_data_index + 1;
-						break;
-					}
-				}
 			}
 
 			// All slots are used so we now finally construct the real values
@@ -267,9 +205,7 @@ namespace mclo::detail
 		/// @return A const iterator to the matching element, or @ref end() if @p key is not present.
 		[[nodiscard]] constexpr const_iterator find( const key_type& key ) const
 		{
-			const std::size_t data_index = find_data_index( key );
-			const auto it = begin() + data_index;
-			return equals( get_key( *it ), key ) ? it : end();
+			return begin() + find_slot( key );
 		}
 
 		/// @brief Checks whether an element with the given @p key is present.
@@ -277,8 +213,24 @@ namespace mclo::detail
 		/// @return @c true if @p key is stored in the container.
 		[[nodiscard]] constexpr bool contains( const key_type& key ) const
 		{
-			const std::size_t data_index = find_data_index( key );
-			return equals( get_key( m_storage[ data_index ] ), key );
+			return find_slot( key ) != Size;
+		}
+
+		/// @brief Finds the elements for a batch of keys.
+		/// @details Lookups are pipelined in groups, every key in a group is hashed and its displacement prefetched,
+		/// then every slot is computed and its fingerprint and element prefetched before any keys are compared. The
+		/// cache misses of a group overlap instead of each lookup stalling on them in turn.
+		/// @param keys The keys to look up.
+		/// @param out Span to write a const iterator to each matching element to, or @ref end() if the key is not
+		/// present, must be the same size as keys.
+		/// @return The number of keys present.
+		constexpr size_type find_many( const mclo::span<const key_type> keys,
+									   const mclo::span<const_iterator> out ) const
+		{
+			MCLO_DEBUG_ASSERT( keys.size() == out.size(), "Output must be the same size as keys" );
+			return find_slots( keys, [ & ]( const std::size_t position, const size_type slot ) {
+				out[ position ] = begin() + slot;
+			} );
 		}
 
 		/// @brief Returns the number of elements, which is always @p Size.
@@ -369,17 +321,62 @@ namespace mclo::detail
 		}
 
 	protected:
-		/// @brief Computes the storage slot index a @p key maps to via the perfect hash.
-		/// @details Resolves the bucket's stored salt: a negative value encodes a direct slot index, a non-negative
-		/// value is the secondary salt used to hash @p key to its slot. The result is unverified, callers must still
-		/// compare the key at that slot, since a key not in the set will still map to some slot.
+		/// @brief Finds the storage slot holding @p key.
+		/// @details The slot is computed without branching on the bucket, the stored fingerprint is compared before
+		/// the key so most absent keys are rejected without a key comparison.
 		/// @param key The key to locate.
-		/// @return The slot index @p key hashes to.
-		[[nodiscard]] constexpr size_type find_data_index( const key_type& key ) const
+		/// @return The slot index of @p key, or @p Size if it is not present.
+		[[nodiscard]] constexpr size_type find_slot( const key_type& key ) const
+		{
+			const split_key_hash key_hash = split_hash( hash( key, m_seed ) );
+			const std::size_t slot = slot_of( key_hash, m_displacements[ key_hash.m_bucket ] );
+			const bool found =
+				m_fingerprints[ slot ] == key_hash.m_fingerprint && equals( get_key( m_storage[ slot ] ), key );
+			return found ? slot : Size;
+		}
+
+		/// @brief Finds the storage slot of every key in a batch, see @ref find_many.
+		/// @param keys The keys to locate.
+		/// @param func Invoked with the position in @p keys and the slot of the key there, or @p Size if it is not
+		/// present.
+		/// @return The number of keys present.
+		template <typename Func>
+		constexpr size_type find_slots( const mclo::span<const key_type> keys, Func func ) const
 		{
-			const std::size_t salt_index = hash( key, primary_salt ) % Size;
-			const std::int32_t salt_value = m_salts[ salt_index ];
-			return salt_value < 0 ? ( -salt_value - 1 ) : ( hash( key, salt_value ) % Size );
+			std::array<split_key_hash, lookup_group_size> key_hashes{};
+			std::array<std::size_t, lookup_group_size> slots{};
+			size_type num_found = 0;
+			for ( std::size_t first = 0; first < keys.size(); first += lookup_group_size )
+			{
+				const std::size_t count = std::min( lookup_group_size, keys.size() - first );
+				for ( std::size_t offset = 0; offset < count; ++offset )
+				{
+					key_hashes[ offset ] = split_hash( hash( keys[ first + offset ], m_seed ) );
+					if ( !std::is_constant_evaluated() )
+					{
+						mclo::prefetch( m_displacements.data() + key_hashes[ offset ].m_bucket );
+					}
+				}
+				for ( std::size_t offset = 0; offset < count; ++offset )
+				{
+					const split_key_hash& key_hash = key_hashes[ offset ];
+					slots[ offset ] = slot_of( key_hash, m_displacements[ key_hash.m_bucket ] );
+					if ( !std::is_constant_evaluated() )
+					{
+						mclo::prefetch( m_fingerprints.data() + slots[ offset ] );
+						mclo::prefetch( m_storage.data() + slots[ offset ] );
+					}
+				}
+				for ( std::size_t offset = 0; offset < count; ++offset )
+				{
+					const std::size_t slot = slots[ offset ];
+					const bool found = m_fingerprints[ slot ] == key_hashes[ offset ].m_fingerprint &&
+									   equals( get_key( m_storage[ slot ] ), keys[ first + offset ] );
+					num_found += found;
+					func( first + offset, found ? slot : Size );
+				}
+			}
+			return num_found;
 		}
 
 		/// @brief Hashes @p key with @p salt using the @p Hash functor.
@@ -399,7 +396,222 @@ namespace mclo::detail
 		}
 
 	private:
+		[[nodiscard]] static constexpr split_key_hash split_hash( const std::size_t hash ) noexcept
+		{
+			// Halves of two multiplies give independent values for each part, cheaper than a full avalanche which
+			// the salted hash has mostly done already. 32 bit modulo by a constant is a multiply and shift.
+			const std::uint64_t wide_hash = hash;
+			const std::uint64_t mixed = ( wide_hash ^ ( wide_hash >> 32 ) ) * UINT64_C( 0xbf58476d1ce4e5b9 );
+			const std::uint64_t remixed = mixed * UINT64_C( 0x9e3779b97f4a7c15 );
+			return { static_cast<std::uint32_t>( mixed ) % static_cast<std::uint32_t>( num_buckets ),
+					 static_cast<std::uint32_t>( mixed >> 32 ) % static_cast<std::uint32_t>( Size ),
+					 static_cast<std::uint32_t>( remixed >> 32 ) % static_cast<std::uint32_t>( Size ),
+					 static_cast<std::uint8_t>( remixed >> 24 ) };
+		}
+
+		/// @brief The slot before adding the bucket's offset, always below Size
+		[[nodiscard]] static constexpr std::size_t unshifted_slot( const split_key_hash& key_hash,
+																   const std::size_t multiplier ) noexcept
+		{
+			// Both terms are below Size so this can't overflow for Size below 2^32
+			return static_cast<std::size_t>(
+				( key_hash.m_base + static_cast<std::uint64_t>( key_hash.m_step ) * multiplier ) % Size );
+		}
+
+		/// @brief Add an offset to an unshifted slot, both are below Size
+		[[nodiscard]] static constexpr std::size_t shift_slot( const std::size_t unshifted,
+															   const std::size_t offset ) noexcept
+		{
+			const std::size_t slot = unshifted + offset;
+			return slot >= Size ? slot - Size : slot;
+		}
+
+		[[nodiscard]] static constexpr std::size_t slot_of( const split_key_hash& key_hash,
+															const bucket_displacement displacement ) noexcept
+		{
+			return shift_slot( unshifted_slot( key_hash, displacement.m_multiplier ), displacement.m_offset );
+		}
+
+		/// @brief Try to place every key with the current seed, filling slot_data_index and the displacements
+		/// @return false if a bucket could not be placed and another seed is needed
+		[[nodiscard]] constexpr bool try_place( const sized_array<value_type>& data,
+												sized_array<std::size_t>& slot_data_index )
+		{
+			slot_data_index = {};
+			m_displacements = {};
+
+			sized_array<split_key_hash> key_hashes{};
+			std::array<std::size_t, num_buckets + 1> bucket_starts{};
+			for ( std::size_t data_index = 0; data_index < Size; ++data_index )
+			{
+				key_hashes[ data_index ] = split_hash( hash( get_key( data[ data_index ] ), m_seed ) );
+				++bucket_starts[ key_hashes[ data_index ].m_bucket + 1 ];
+			}
+
+			// Counting sort the keys by bucket, then the buckets by descending size
+			std::size_t max_bucket_size = 0;
+			for ( std::size_t bucket = 0; bucket < num_buckets; ++bucket )
+			{
+				max_bucket_size = std::max( max_bucket_size, bucket_starts[ bucket + 1 ] );
+				bucket_starts[ bucket + 1 ] += bucket_starts[ bucket ];
+			}
+
+			sized_array<std::size_t> bucket_keys{};
+			{
+				std::array<std::size_t, num_buckets> bucket_fill{};
+				for ( std::size_t data_index = 0; data_index < Size; ++data_index )
+				{
+					const std::size_t bucket = key_hashes[ data_index ].m_bucket;
+					bucket_keys[ bucket_starts[ bucket ] + bucket_fill[ bucket ]++ ] = data_index;
+				}
+			}
+
+			sized_array<std::size_t> size_starts{};
+			for ( std::size_t bucket = 0; bucket < num_buckets; ++bucket )
+			{
+				const std::size_t size = bucket_starts[ bucket + 1 ] - bucket_starts[ bucket ];
+				if ( size != 0 )
+				{
+					++size_starts[ max_bucket_size - size ];
+				}
+			}
+			std::size_t num_used_buckets = 0;
+			for ( std::size_t index = 0; index < max_bucket_size; ++index )
+			{
+				num_used_buckets += std::exchange( size_starts[ index ], num_used_buckets );
+			}
+			std::array<std::size_t, num_buckets> sorted_buckets{};
+			for ( std::size_t bucket = 0; bucket < num_buckets; ++bucket )
+			{
+				const std::size_t size = bucket_starts[ bucket + 1 ] - bucket_starts[ bucket ];
+				if ( size != 0 )
+				{
+					sorted_buckets[ size_starts[ max_bucket_size - size ]++ ] = bucket;
+				}
+			}
+
+			// Unordered list of free slots with each slot's position in it so taking a slot is O(1)
+			sized_array<std::size_t> free_slots{};
+			sized_array<std::size_t> free_positions{};
+			for ( std::size_t slot = 0; slot < Size; ++slot )
+			{
+				free_slots[ slot ] = free_positions[ slot ] = slot;
+			}
+			std::size_t num_free = Size;
+			const auto take_slot = [ & ]( const std::size_t slot, const std::size_t data_index ) {
+				slot_data_index[ slot ] = data_index + 1;
+				const std::size_t position = free_positions[ slot ];
+				const std::size_t last_slot = free_slots[ --num_free ];
+				free_slots[ position ] = last_slot;
+				free_positions[ last_slot ] = position;
+			};
+
+			// Unshifted slots of the keys in bucket_keys order for the bucket being placed
+			sized_array<std::size_t> unshifted_slots{};
+
+			for ( std::size_t sorted_index = 0; sorted_index < num_used_buckets; ++sorted_index )
+			{
+				const std::size_t bucket = sorted_buckets[ sorted_index ];
+				const std::size_t first_key = bucket_starts[ bucket ];
+				const std::size_t last_key = bucket_starts[ bucket + 1 ];
+
+				if ( last_key - first_key == 1 )
+				{
+					// A zero multiplier and the right offset moves the key onto any free slot
+					const std::size_t data_index = bucket_keys[ first_key ];
+					const std::size_t slot = free_slots[ num_free - 1 ];
+					const std::size_t offset = ( slot + Size - key_hashes[ data_index ].m_base ) % Size;
+					m_displacements[ bucket ] = { 0, static_cast<displacement_type>( offset ) };
+					take_slot( slot, data_index );
+					continue;
+				}
+
+				if ( !place_bucket( { bucket, first_key, last_key },
+									key_hashes,
+									bucket_keys,
+									slot_data_index,
+									free_slots,
+									num_free,
+									unshifted_slots ) )
+				{
+					return false;
+				}
+				const std::size_t offset = m_displacements[ bucket ].m_offset;
+				for ( std::size_t key = first_key; key < last_key; ++key )
+				{
+					take_slot( shift_slot( unshifted_slots[ key ], offset ), bucket_keys[ key ] );
+				}
+			}
+
+			for ( std::size_t slot = 0; slot < Size; ++slot )
+			{
+				m_fingerprints[ slot ] = key_hashes[ slot_data_index[ slot ] - 1 ].m_fingerprint;
+			}
+			return true;
+		}
+
+		struct bucket_range
+		{
+			std::size_t m_bucket = 0;
+			std::size_t m_first_key = 0;
+			std::size_t m_last_key = 0;
+		};
+
+		/// @brief Search for a displacement putting every key of a bucket on a distinct free slot
+		/// @details On success unshifted_slots holds the bucket's slots before adding the found offset.
+		[[nodiscard]] constexpr bool place_bucket( const bucket_range range,
+												   const sized_array<split_key_hash>& key_hashes,
+												   const sized_array<std::size_t>& bucket_keys,
+												   const sized_array<std::size_t>& slot_data_index,
+												   const sized_array<std::size_t>& free_slots,
+												   const std::size_t num_free,
+												   sized_array<std::size_t>& unshifted_slots )
+		{
+			for ( std::size_t multiplier = 0; multiplier < max_multiplier; ++multiplier )
+			{
+				// An offset moves every key together so keys sharing an unshifted slot collide for any offset, keys
+				// sharing a hash do so for every multiplier and fail over to another seed
+				bool distinct = true;
+				for ( std::size_t key = range.m_first_key; key < range.m_last_key && distinct; ++key )
+				{
+					unshifted_slots[ key ] = unshifted_slot( key_hashes[ bucket_keys[ key ] ], multiplier );
+					for ( std::size_t other = range.m_first_key; other < key; ++other )
+					{
+						distinct = distinct && unshifted_slots[ other ] != unshifted_slots[ key ];
+					}
+				}
+				if ( !distinct )
+				{
+					continue;
+				}
+
+				// Try offsets that move the first key onto each free slot in turn
+				const std::size_t first_unshifted = unshifted_slots[ range.m_first_key ];
+				for ( std::size_t free_index = 0; free_index < num_free; ++free_index )
+				{
+					const std::size_t offset = ( free_slots[ free_index ] + Size - first_unshifted ) % Size;
+					std::size_t key = range.m_first_key + 1;
+					for ( ; key < range.m_last_key; ++key )
+					{
+						if ( slot_data_index[ shift_slot( unshifted_slots[ key ], offset ) ] != 0 )
+						{
+							break;
+						}
+					}
+					if ( key == range.m_last_key )
+					{
+						m_displacements[ range.m_bucket ] = { static_cast<displacement_type>( multiplier ),
+															  static_cast<displacement_type>( offset ) };
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
 		storage_array m_storage{};
-		sized_array<std::int32_t> m_salts{};
+		std::array<bucket_displacement, num_buckets> m_displacements{};
+		sized_array<std::uint8_t> m_fingerprints{};
+		std::size_t m_seed = first_seed;
 	};
 }
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/memory/prefetch.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mclo::detail
+{
+	/// @brief Indirection and generation table shared by the slot map containers
+	/// @details Handles returned by a slot map index into this table, which is stable, and the entry found there gives
+	/// the generation to validate against and the index of the actual data.
+	/// Entries not in use form an in built free list, their index points to the next entry in the free list. If the
+	/// index is itself then it is the end of the free list.
+	/// @tparam Handle The slot map handle type
+	/// @tparam Allocator Allocator for the handle table, already rebound to Handle
+	template <typename Handle, typename Allocator>
+	class slot_map_indirection
+	{
+		// Enough lookups in flight to hide memory latency without the first prefetches being evicted
+		static constexpr std::size_t lookup_group_size = 16;
+
+	public:
+		using handle_type = Handle;
+		using size_type = decltype( handle_type::max_index + 1 );
+
+		slot_map_indirection() = default;
+
+		explicit slot_map_indirection( const Allocator& allocator ) noexcept
+			: m_slots( allocator )
+		{
+		}
+
+		/// @brief Get the number of slots
+		[[nodiscard]] size_type slot_count() const noexcept
+		{
+			return static_cast<size_type>( m_slots.size() );
+		}
+
+		/// @brief Check if a handle refers to a slot in use with a matching generation
+		[[nodiscard]] bool is_valid( const handle_type handle ) const noexcept
+		{
+			// index is in bounds and matching generation, if slot re-used and our handle is out of date generation
+			// mismatches
+			return handle.index < slot_count() && m_slots[ handle.index ].generation == handle.generation;
+		}
+
+		/// @brief Get the slot for a handle, the index of the slot is the data index
+		/// @return Pointer to the slot or nullptr if the handle is not valid
+		[[nodiscard]] const handle_type* find( const handle_type handle ) const noexcept
+		{
+			if ( handle.index >= slot_count() ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			const handle_type& slot = m_slots[ handle.index ];
+			return slot.generation == handle.generation ? &slot : nullptr;
+		}
+
+		/// @brief Find the slot of every handle in a batch
+		/// @details The table bounds are loaded once for the whole batch instead of once per handle. Handles are
+		/// resolved in groups, the slots of a whole group are prefetched before any are read so that with a table
+		/// larger than the cache their misses overlap instead of stalling one at a time.
+		/// @param handles Handles to find
+		/// @param func Invoked with the position in handles and the slot found, or nullptr if the handle is not valid
+		template <typename Func>
+		void find_many( const mclo::span<const handle_type> handles, Func func ) const noexcept
+		{
+			const handle_type* const slots = std::to_address( m_slots.data() );
+			const std::size_t num_slots = m_slots.size();
+			for ( std::size_t first = 0; first < handles.size(); first += lookup_group_size )
+			{
+				const std::size_t last = std::min( first + lookup_group_size, handles.size() );
+				for ( std::size_t index = first; index < last; ++index )
+				{
+					// Out of range handles prefetch the first slot rather than form an out of bounds pointer
+					const std::size_t slot_index = handles[ index ].index;
+					mclo::prefetch( slots + ( slot_index < num_slots ? slot_index : 0 ) );
+				}
+				for ( std::size_t index = first; index < last; ++index )
+				{
+					const handle_type handle = handles[ index ];
+					const handle_type* slot = nullptr;
+					if ( handle.index < num_slots && slots[ handle.index ].generation == handle.generation ) [[likely]]
+					{
+						slot = slots + handle.index;
+					}
+					func( index, slot );
+				}
+			}
+		}
+
+		/// @brief Get the data index of a slot in use
+		[[nodiscard]] size_type data_index( const size_type slot_index ) const noexcept
+		{
+			return m_slots[ slot_index ].index;
+		}
+
+		/// @brief Point a slot in use at a new data index, used when data is moved to keep it contiguous
+		void set_data_index( const size_type slot_index, const size_type data_index ) noexcept
+		{
+			m_slots[ slot_index ].index = data_index;
+		}
+
+		/// @brief Get the handle to a slot in use
+		[[nodiscard]] handle_type handle_at( const size_type slot_index ) const noexcept
+		{
+			return handle_type{ slot_index, m_slots[ slot_index ].generation };
+		}
+
+		/// @brief Get the slot the next acquire will use
+		[[nodiscard]] size_type next_free_slot() const noexcept
+		{
+			return m_free_list_head;
+		}
+
+		/// @brief Reserve space for amount slots, linking any new ones into the front of the free list
+		/// @post Provides a basic exception guarantee, if an exception is thrown invariants are held and no leaks occur
+		void reserve( const size_type amount )
+		{
+			m_slots.reserve( amount );
+
+			const size_type old_num_slots = slot_count();
+
+			// If we reserved more slots then link into the free list
+			// This links the new slots in reverse order and inserts them as the new head, this is because
+			// they have fresh generation counters so we want to use them up first instead of ones with
+			// potentially higher and uneven distribution of generations
+			if ( old_num_slots < amount )
+			{
+				try
+				{
+					// Link in the first item as pointing to the current head
+					m_slots.push_back( handle_type{ m_free_list_head, {} } );
+
+					const size_type last_new_slot = amount - 1;
+					size_type newest_slot = old_num_slots;
+
+					// Chain together all the other slots
+					while ( newest_slot != last_new_slot )
+					{
+						m_slots.push_back( handle_type{ newest_slot++, {} } );
+					}
+
+					// Make the end of our new slots the new head
+					m_free_list_head = newest_slot;
+				}
+				catch ( ... )
+				{
+					m_slots.resize( old_num_slots );
+					throw;
+				}
+			}
+		}
+
+		/// @brief Make sure the free list is not empty so acquire cannot fail
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change is made
+		void reserve_free_slot()
+		{
+			// Free list empty so we add a new slot, it is both head and tail of the free list
+			if ( m_free_list_head == slot_count() )
+			{
+				m_slots.push_back( handle_type{ static_cast<size_type>( slot_count() + 1 ), {} } );
+			}
+		}
+
+		/// @brief Take the head of the free list and point it at data_index
+		/// @pre reserve_free_slot must have been called
+		/// @return Handle to the acquired slot
+		[[nodiscard]] handle_type acquire( const size_type data_index ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( m_free_list_head < slot_count(), "reserve_free_slot must be called before acquire" );
+			const size_type slot_index = m_free_list_head;
+			handle_type& slot = m_slots[ slot_index ];
+
+			// Last in free list, we need to update the head + tail to the empty sentinel
+			if ( m_free_list_head == m_free_list_tail )
+			{
+				m_free_list_tail = m_free_list_head = slot_count();
+			}
+			else // Advance free list
+			{
+				m_free_list_head = slot.index;
+			}
+
+			slot.index = data_index;
+
+			// We return the slot index and the generation, generation will be changed in release for invalidating
+			// existing handles
+			return handle_type{ slot_index, slot.generation };
+		}
+
+		/// @brief Return a slot in use to the free list, invalidating all handles to it
+		void release( const size_type slot_index ) noexcept
+		{
+			// Increment generation, now remaining handles will mismatch on usage
+			++m_slots[ slot_index ].generation;
+
+			// Start free list if empty or chain into existing free list
+			if ( m_free_list_head == slot_count() )
+			{
+				m_free_list_head = slot_index;
+			}
+			else
+			{
+				m_slots[ m_free_list_tail ].index = slot_index;
+			}
+
+			// Is always the new tail of the free list
+			m_free_list_tail = slot_index;
+		}
+
+		/// @brief Put all slots back into the free list, increasing every generation
+		void clear() noexcept
+		{
+			// Start from the first again
+			m_free_list_head = 0;
+			const size_type num_slots = slot_count();
+			if ( num_slots == 0 )
+			{
+				m_free_list_tail = 0;
+				return;
+			}
+
+			// Chain all following elements to the end
+			for ( size_type index = 0; index < num_slots; ++index )
+			{
+				handle_type& handle = m_slots[ index ];
+				handle.index = index + 1;
+				++handle.generation;
+			}
+
+			// Set the last element as the tail and refer to itself as the end point
+			m_free_list_tail = num_slots - 1;
+			m_slots[ m_free_list_tail ].index = m_free_list_tail;
+		}
+
+		/// @brief Remove all slots, resetting generations
+		void reset() noexcept
+		{
+			m_slots.clear();
+			m_free_list_head = 0;
+			m_free_list_tail = 0;
+		}
+
+		void swap( slot_map_indirection& other ) noexcept
+		{
+			using std::swap;
+			swap( m_slots, other.m_slots );
+			swap( m_free_list_head, other.m_free_list_head );
+			swap( m_free_list_tail, other.m_free_list_tail );
+		}
+
+		friend void swap( slot_map_indirection& lhs, slot_map_indirection& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+	private:
+		/// @brief Indirection array, lookup from handle.index -> data index
+		std::vector<handle_type, Allocator> m_slots;
+
+		/// @brief index into slot array for the start of the free list
+		/// @details Is either equal to m_free_list_tail and slot_count() when empty
+		/// Or is > 0 and < slot_count() and points to start of free list, with each slot pointing to the
+		/// next entry in the free list until m_free_list_tail.
+		/// Tail can be equal to head if there is only one free slot.
+		size_type m_free_list_head = 0;
+
+		/// @brief index into slot array for the end of the free list
+		size_type m_free_list_tail = 0;
+	};
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "mclo/container/detail/dynamic_mph_base.hpp"
+
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <ranges>
+#include <tuple>
+#include <utility>
+
+namespace mclo
+{
+	/// @brief An immutable map built at runtime on a minimal perfect hash, for large key sets only known at runtime.
+	/// @details The runtime counterpart of @ref mph_map, built over any number of keys, in parallel if requested, and
+	/// using only a few bits per key on top of the keys and values. Lookup is one hash, one evaluation of the
+	/// @ref minimal_perfect_hash and one key comparison.
+	///
+	/// Keys and values are stored in separate arrays ordered by their perfect hash index. When both are trivially
+	/// copyable the map can be serialized to a flat buffer and later used in place with @ref view, without copying or
+	/// rebuilding, such as from a memory mapped file. The format is in native endianness.
+	/// @tparam Key The key type.
+	/// @tparam Value The mapped value type.
+	/// @tparam Hash The salted hash functor for keys, see @ref mph_hash.
+	/// @tparam KeyEquals The key equality comparator.
+	/// @tparam Allocator The allocator for the owned keys and values.
+	template <typename Key,
+			  typename Value,
+			  typename Hash = mph_hash<Key>,
+			  typename KeyEquals = std::equal_to<Key>,
+			  typename Allocator = std::allocator<std::pair<const Key, Value>>>
+	class dynamic_mph_map : public detail::dynamic_mph_base<Key, Hash, KeyEquals, Allocator>
+	{
+		using base = detail::dynamic_mph_base<Key, Hash, KeyEquals, Allocator>;
+		using value_storage =
+			std::vector<Value, typename std::allocator_traits<Allocator>::template rebind_alloc<Value>>;
+
+		static constexpr bool serializable = std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>;
+
+	public:
+		using mapped_type = Value;
+		using typename base::allocator_type;
+		using typename base::key_type;
+		using typename base::size_type;
+
+		/// @brief Constructs an empty map.
+		/// @param allocator The allocator to use.
+		explicit dynamic_mph_map( const allocator_type& allocator = allocator_type() )
+			: base( allocator )
+			, m_owned_values( allocator )
+		{
+		}
+
+		/// @brief Constructs the map from a random access range of pair like key/value elements.
+		/// @param pairs The elements to build from, read with @c std::get<0> and @c std::get<1>.
+		/// @param options Options to build the perfect hash with.
+		/// @param allocator The allocator to use.
+		/// @throws std::invalid_argument If the keys are not unique.
+		template <std::ranges::random_access_range Range>
+			requires std::ranges::sized_range<Range>
+		explicit dynamic_mph_map( const Range& pairs,
+								  const mph_build_options& options = {},
+								  const allocator_type& allocator = allocator_type() )
+			: base( allocator )
+			, m_owned_values( allocator )
+		{
+			const auto first = std::ranges::begin( pairs );
+			const std::size_t count = static_cast<std::size_t>( std::ranges::size( pairs ) );
+			const std::vector<std::size_t> position_at =
+				base::build( count,
+							 [ first ]( const std::size_t position ) -> const Key& {
+								 return std::get<0>( first[ static_cast<std::ptrdiff_t>( position ) ] );
+							 },
+							 options );
+
+			m_owned_values.reserve( count );
+			for ( const std::size_t position : position_at )
+			{
+				m_owned_values.emplace_back( std::get<1>( first[ static_cast<std::ptrdiff_t>( position ) ] ) );
+			}
+			m_values = m_owned_values;
+		}
+
+		/// @brief Constructs the map from a list of key/value pairs.
+		/// @param pairs The elements to build from.
+		/// @param options Options to build the perfect hash with.
+		/// @param allocator The allocator to use.
+		/// @throws std::invalid_argument If the keys are not unique.
+		dynamic_mph_map( const std::initializer_list<std::pair<Key, Value>> pairs,
+						 const mph_build_options& options = {},
+						 const allocator_type& allocator = allocator_type() )
+			: dynamic_mph_map( mclo::span<const std::pair<Key, Value>>( pairs.begin(), pairs.size() ),
+							   options,
+							   allocator )
+		{
+		}
+
+		dynamic_mph_map( const dynamic_mph_map& other )
+			: base( other )
+			, m_owned_values( other.m_owned_values )
+		{
+			m_values = other.is_view() ? other.m_values : mclo::span<const Value>( m_owned_values );
+		}
+
+		dynamic_mph_map( dynamic_mph_map&& other ) noexcept
+			: base( std::move( other ) )
+			, m_owned_values( std::move( other.m_owned_values ) )
+			, m_values( std::exchange( other.m_values, {} ) )
+		{
+			other.m_owned_values.clear();
+		}
+
+		dynamic_mph_map& operator=( const dynamic_mph_map& other )
+		{
+			if ( this != &other )
+			{
+				dynamic_mph_map copy( other );
+				*this = std::move( copy );
+			}
+			return *this;
+		}
+
+		dynamic_mph_map& operator=( dynamic_mph_map&& other ) noexcept(
+			std::is_nothrow_move_assignable_v<base> && std::is_nothrow_move_assignable_v<value_storage> )
+		{
+			if ( this != &other )
+			{
+				const bool viewing = other.is_view();
+				base::operator=( std::move( other ) );
+				m_owned_values = std::move( other.m_owned_values );
+				m_values = viewing ? other.m_values : mclo::span<const Value>( m_owned_values );
+				other.m_owned_values.clear();
+				other.m_values = {};
+			}
+			return *this;
+		}
+
+		~dynamic_mph_map() = default;
+
+		/// @brief Looks up the value mapped to @p key.
+		/// @param key The key to look up.
+		/// @return A pointer to the mapped value, or @c nullptr if @p key is not present.
+		[[nodiscard]] const mapped_type* lookup( const key_type& key ) const
+		{
+			const size_type index = base::index_of( key );
+			return index != base::npos ? m_values.data() + index : nullptr;
+		}
+
+		/// @brief Looks up the values mapped to a batch of keys.
+		/// @details Pipelined like @ref index_of_many, values are prefetched along with keys so they are likely cached
+		/// when the results are used.
+		/// @param keys The keys to look up.
+		/// @param out Span to write a pointer to each mapped value to, or @c nullptr if the key is not present, must be
+		/// the same size as keys.
+		/// @return The number of keys present.
+		size_type lookup_many( const mclo::span<const key_type> keys, const mclo::span<const mapped_type*> out ) const
+		{
+			MCLO_DEBUG_ASSERT( keys.size() == out.size(), "Output must be the same size as keys" );
+			const mapped_type* const values = m_values.data();
+			return base::find_indices(
+				keys,
+				[ values ]( const size_type index ) {
+					mclo::prefetch( values + index );
+				},
+				[ & ]( const std::size_t position, const size_type index ) {
+					out[ position ] = index != base::npos ? values + index : nullptr;
+				} );
+		}
+
+		/// @brief Returns the values, ordered by their index so @c values()[ index_of( key ) ] is the value of @c key.
+		[[nodiscard]] mclo::span<const mapped_type> values() const noexcept
+		{
+			return m_values;
+		}
+
+		/// @brief Returns the number of bytes @ref serialize writes.
+		[[nodiscard]] size_type serialized_size() const noexcept
+			requires serializable
+		{
+			return base::serialized_keys_size() + base::template array_bytes<Value>( m_values.size() );
+		}
+
+		/// @brief Serializes the map to a flat buffer.
+		/// @param out Buffer to write into, must be at least @ref serialized_size bytes.
+		/// @return The number of bytes written.
+		size_type serialize( const mclo::span<std::byte> out ) const noexcept
+			requires serializable
+		{
+			const size_type key_bytes = base::serialize_keys( out );
+			return key_bytes + base::write_array( m_values, out.subspan( key_bytes ) );
+		}
+
+		/// @brief Serializes the map to a flat buffer.
+		/// @return The serialized bytes.
+		[[nodiscard]] std::vector<std::byte> serialize() const
+			requires serializable
+		{
+			std::vector<std::byte> result( serialized_size() );
+			serialize( result );
+			return result;
+		}
+
+		/// @brief Deserializes a map, copying it out of @p data.
+		/// @param data The serialized bytes, trailing bytes are ignored.
+		/// @param allocator The allocator to use.
+		/// @return The map, or @c std::nullopt if @p data is not a valid serialized map.
+		[[nodiscard]] static std::optional<dynamic_mph_map> deserialize(
+			const mclo::span<const std::byte> data, const allocator_type& allocator = allocator_type() )
+			requires serializable
+		{
+			return load( data, true, allocator );
+		}
+
+		/// @brief Uses a serialized map in place without copying it, such as from a memory mapped file.
+		/// @warning @p data must outlive the returned map and all copies of it.
+		/// @param data The serialized bytes, must be aligned to 8 bytes, trailing bytes are ignored.
+		/// @return The map, or @c std::nullopt if @p data is not a valid serialized map or is misaligned.
+		[[nodiscard]] static std::optional<dynamic_mph_map> view( const mclo::span<const std::byte> data )
+			requires serializable
+		{
+			return load( data, false, allocator_type() );
+		}
+
+	private:
+		[[nodiscard]] static std::optional<dynamic_mph_map> load( const mclo::span<const std::byte> data,
+																  const bool copy,
+																  const allocator_type& allocator )
+		{
+			dynamic_mph_map result( allocator );
+			const std::optional<mclo::span<const std::byte>> value_bytes = result.load_keys( data, copy );
+			if ( !value_bytes )
+			{
+				return std::nullopt;
+			}
+
+			const std::size_t count = result.size();
+			if ( count > value_bytes->size() / sizeof( Value ) )
+			{
+				return std::nullopt;
+			}
+			if ( copy )
+			{
+				result.m_owned_values.resize( count );
+				if ( count != 0 )
+				{
+					std::memcpy( result.m_owned_values.data(), value_bytes->data(), count * sizeof( Value ) );
+				}
+				result.m_values = result.m_owned_values;
+			}
+			else
+			{
+				result.m_values =
+					mclo::span<const Value>( reinterpret_cast<const Value*>( value_bytes->data() ), count );
+			}
+			return result;
+		}
+
+		/// @brief Values in index order when owned, empty when viewing serialized data
+		value_storage m_owned_values;
+
+		/// @brief The values in use, either m_owned_values or the viewed data
+		mclo::span<const Value> m_values;
+	};
+
+	namespace pmr
+	{
+		template <typename Key,
+				  typename Value,
+				  typename Hash = mph_hash<Key>,
+				  typename KeyEquals = std::equal_to<Key>>
+		using dynamic_mph_map = mclo::
+			dynamic_mph_map<Key, Value, Hash, KeyEquals, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+	}
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "mclo/container/detail/dynamic_mph_base.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <ranges>
+
+namespace mclo
+{
+	/// @brief An immutable set built at runtime on a minimal perfect hash, for large key sets only known at runtime.
+	/// @details The runtime counterpart of @ref mph_set, see @ref dynamic_mph_map for details. Each key has a dense
+	/// index in [0, size()) from @c index_of which can be used to address external arrays.
+	/// @tparam Key The key type.
+	/// @tparam Hash The salted hash functor for keys, see @ref mph_hash.
+	/// @tparam KeyEquals The key equality comparator.
+	/// @tparam Allocator The allocator for the owned keys.
+	template <typename Key,
+			  typename Hash = mph_hash<Key>,
+			  typename KeyEquals = std::equal_to<Key>,
+			  typename Allocator = std::allocator<Key>>
+	class dynamic_mph_set : public detail::dynamic_mph_base<Key, Hash, KeyEquals, Allocator>
+	{
+		using base = detail::dynamic_mph_base<Key, Hash, KeyEquals, Allocator>;
+
+		static constexpr bool serializable = std::is_trivially_copyable_v<Key>;
+
+	public:
+		using value_type = Key;
+		using typename base::allocator_type;
+		using typename base::size_type;
+		using iterator = typename mclo::span<const Key>::iterator;
+		using const_iterator = iterator;
+
+		using base::base;
+
+		/// @brief Constructs the set from a random access range of keys.
+		/// @param keys The keys to build from.
+		/// @param options Options to build the perfect hash with.
+		/// @param allocator The allocator to use.
+		/// @throws std::invalid_argument If the keys are not unique.
+		template <std::ranges::random_access_range Range>
+			requires std::ranges::sized_range<Range>
+		explicit dynamic_mph_set( const Range& keys,
+								  const mph_build_options& options = {},
+								  const allocator_type& allocator = allocator_type() )
+			: base( allocator )
+		{
+			const auto first = std::ranges::begin( keys );
+			base::build(
+				static_cast<std::size_t>( std::ranges::size( keys ) ),
+				[ first ]( const std::size_t position ) -> const Key& {
+					return first[ static_cast<std::ptrdiff_t>( position ) ];
+				},
+				options );
+		}
+
+		/// @brief Constructs the set from a list of keys.
+		/// @param keys The keys to build from.
+		/// @param options Options to build the perfect hash with.
+		/// @param allocator The allocator to use.
+		/// @throws std::invalid_argument If the keys are not unique.
+		dynamic_mph_set( const std::initializer_list<Key> keys,
+						 const mph_build_options& options = {},
+						 const allocator_type& allocator = allocator_type() )
+			: dynamic_mph_set( mclo::span<const Key>( keys.begin(), keys.size() ), options, allocator )
+		{
+		}
+
+		[[nodiscard]] iterator begin() const noexcept
+		{
+			return base::keys().begin();
+		}
+		[[nodiscard]] iterator end() const noexcept
+		{
+			return base::keys().end();
+		}
+
+		/// @brief Returns the number of bytes @ref serialize writes.
+		[[nodiscard]] size_type serialized_size() const noexcept
+			requires serializable
+		{
+			return base::serialized_keys_size();
+		}
+
+		/// @brief Serializes the set to a flat buffer.
+		/// @param out Buffer to write into, must be at least @ref serialized_size bytes.
+		/// @return The number of bytes written.
+		size_type serialize( const mclo::span<std::byte> out ) const noexcept
+			requires serializable
+		{
+			return base::serialize_keys( out );
+		}
+
+		/// @brief Serializes the set to a flat buffer.
+		/// @return The serialized bytes.
+		[[nodiscard]] std::vector<std::byte> serialize() const
+			requires serializable
+		{
+			std::vector<std::byte> result( serialized_size() );
+			serialize( result );
+			return result;
+		}
+
+		/// @brief Deserializes a set, copying it out of @p data.
+		/// @param data The serialized bytes, trailing bytes are ignored.
+		/// @param allocator The allocator to use.
+		/// @return The set, or @c std::nullopt if @p data is not a valid serialized set.
+		[[nodiscard]] static std::optional<dynamic_mph_set> deserialize(
+			const mclo::span<const std::byte> data, const allocator_type& allocator = allocator_type() )
+			requires serializable
+		{
+			return load( data, true, allocator );
+		}
+
+		/// @brief Uses a serialized set in place without copying it, such as from a memory mapped file.
+		/// @warning @p data must outlive the returned set and all copies of it.
+		/// @param data The serialized bytes, must be aligned to 8 bytes, trailing bytes are ignored.
+		/// @return The set, or @c std::nullopt if @p data is not a valid serialized set or is misaligned.
+		[[nodiscard]] static std::optional<dynamic_mph_set> view( const mclo::span<const std::byte> data )
+			requires serializable
+		{
+			return load( data, false, allocator_type() );
+		}
+
+	private:
+		[[nodiscard]] static std::optional<dynamic_mph_set> load( const mclo::span<const std::byte> data,
+																  const bool copy,
+																  const allocator_type& allocator )
+		{
+			dynamic_mph_set result( allocator );
+			if ( !result.load_keys( data, copy ) )
+			{
+				return std::nullopt;
+			}
+			return result;
+		}
+	};
+
+	namespace pmr
+	{
+		template <typename Key, typename Hash = mph_hash<Key>, typename KeyEquals = std::equal_to<Key>>
+		using dynamic_mph_set = mclo::dynamic_mph_set<Key, Hash, KeyEquals, std::pmr::polymorphic_allocator<Key>>;
+	}
+}
@@ -0,0 +1,598 @@
+#pragma once
+
+#include "mclo/container/detail/flat_map_iterator.hpp"
+#include "mclo/container/detail/flat_sort.hpp"
+#include "mclo/container/flat_search_layout.hpp"
+#include "mclo/container/span.hpp"
+#include "mclo/platform/attributes.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A map of unique keys to values, stored sorted by key in separate contiguous key and value arrays.
+	/// @details Lookups search only the key array, so the values never pollute the cache while searching and there is
+	/// no per node allocation or pointer chasing as in @c std::map, at the cost of inserting and erasing shifting the
+	/// later entries. Build in bulk with @ref insert_range, which appends the new entries, sorts just those,
+	/// @ref radix_sort for integer keys, then merges them in a single pass.
+	///
+	/// Iterators dereference to a @c std::pair of references, use @ref keys and @ref values to work on either array
+	/// directly.
+	/// @tparam Key The key type.
+	/// @tparam T The mapped value type.
+	/// @tparam Compare The strict weak ordering of keys.
+	/// @tparam Layout How lookups search the keys, @ref binary_search_layout or @ref eytzinger_layout.
+	/// @tparam Allocator The allocator, rebound for the key and value arrays.
+	template <typename Key,
+			  typename T,
+			  typename Compare = std::less<Key>,
+			  typename Layout = binary_search_layout,
+			  typename Allocator = std::allocator<std::pair<const Key, T>>>
+	class flat_map
+	{
+		template <typename U>
+		using rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+		using key_storage = std::vector<Key, rebind<Key>>;
+		using value_storage = std::vector<T, rebind<T>>;
+		using search_index = typename Layout::template index<Key, rebind<Key>>;
+
+	public:
+		using key_type = Key;
+		using mapped_type = T;
+		using value_type = std::pair<key_type, mapped_type>;
+		using key_compare = Compare;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using allocator_type = Allocator;
+		using iterator = flat_map_iterator<typename key_storage::const_iterator, typename value_storage::iterator>;
+		using const_iterator =
+			flat_map_iterator<typename key_storage::const_iterator, typename value_storage::const_iterator>;
+		using reference = std::iter_reference_t<iterator>;
+		using const_reference = std::iter_reference_t<const_iterator>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		flat_map() = default;
+
+		explicit flat_map( const key_compare& comp, const allocator_type& alloc = allocator_type() )
+			: m_compare( comp )
+			, m_keys( alloc )
+			, m_values( alloc )
+			, m_index( alloc )
+		{
+		}
+
+		explicit flat_map( const allocator_type& alloc )
+			: flat_map( key_compare(), alloc )
+		{
+		}
+
+		template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+		flat_map( It first,
+				  Sentinel last,
+				  const key_compare& comp = key_compare(),
+				  const allocator_type& alloc = allocator_type() )
+			: flat_map( comp, alloc )
+		{
+			insert( std::move( first ), std::move( last ) );
+		}
+
+		/// @brief Constructs the map from a range of pair like key/value elements.
+		template <std::ranges::input_range Range>
+		explicit flat_map( Range&& range,
+						   const key_compare& comp = key_compare(),
+						   const allocator_type& alloc = allocator_type() )
+			: flat_map( comp, alloc )
+		{
+			insert_range( std::forward<Range>( range ) );
+		}
+
+		flat_map( const std::initializer_list<value_type> init,
+				  const key_compare& comp = key_compare(),
+				  const allocator_type& alloc = allocator_type() )
+			: flat_map( comp, alloc )
+		{
+			insert_range( init );
+		}
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator( m_keys.cbegin(), m_values.begin() );
+		}
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator( m_keys.cbegin(), m_values.cbegin() );
+		}
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator( m_keys.cend(), m_values.end() );
+		}
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator( m_keys.cend(), m_values.cend() );
+		}
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		[[nodiscard]] reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator( end() );
+		}
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator( end() );
+		}
+		[[nodiscard]] const_reverse_iterator crbegin() const noexcept
+		{
+			return rbegin();
+		}
+
+		[[nodiscard]] reverse_iterator rend() noexcept
+		{
+			return reverse_iterator( begin() );
+		}
+		[[nodiscard]] const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator( begin() );
+		}
+		[[nodiscard]] const_reverse_iterator crend() const noexcept
+		{
+			return rend();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_keys.empty();
+		}
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_keys.size();
+		}
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			return std::min( m_keys.max_size(), m_values.max_size() );
+		}
+
+		void reserve( const size_type count )
+		{
+			m_keys.reserve( count );
+			m_values.reserve( count );
+		}
+
+		void shrink_to_fit()
+		{
+			m_keys.shrink_to_fit();
+			m_values.shrink_to_fit();
+		}
+
+		/// @brief Get the sorted keys, @c keys()[ i ] is the key of @c values()[ i ].
+		[[nodiscard]] mclo::span<const key_type> keys() const noexcept
+		{
+			return { m_keys.data(), m_keys.size() };
+		}
+
+		/// @brief Get the values in key order, @c values()[ i ] is the value of @c keys()[ i ].
+		[[nodiscard]] mclo::span<mapped_type> values() noexcept
+		{
+			return { m_values.data(), m_values.size() };
+		}
+		/// @copydoc values()
+		[[nodiscard]] mclo::span<const mapped_type> values() const noexcept
+		{
+			return { m_values.data(), m_values.size() };
+		}
+
+		[[nodiscard]] key_compare key_comp() const
+		{
+			return m_compare;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return allocator_type( m_keys.get_allocator() );
+		}
+
+		/// @brief Get the value for key, inserting a value initialized one if key is not present.
+		mapped_type& operator[]( const key_type& key )
+		{
+			return try_emplace( key ).first->second;
+		}
+		/// @copydoc operator[]
+		mapped_type& operator[]( key_type&& key )
+		{
+			return try_emplace( std::move( key ) ).first->second;
+		}
+
+		/// @brief Get the value for key.
+		/// @throws std::out_of_range if key is not present.
+		[[nodiscard]] mapped_type& at( const key_type& key )
+		{
+			const iterator it = find( key );
+			if ( it == end() )
+			{
+				throw std::out_of_range( "Key not in flat_map" );
+			}
+			return it->second;
+		}
+		/// @copydoc at
+		[[nodiscard]] const mapped_type& at( const key_type& key ) const
+		{
+			const const_iterator it = find( key );
+			if ( it == end() )
+			{
+				throw std::out_of_range( "Key not in flat_map" );
+			}
+			return it->second;
+		}
+
+		/// @brief Constructs the value for key in place if key is not present.
+		/// @return An iterator to the inserted or existing entry, and true if it was inserted.
+		template <typename K, typename... Args>
+			requires( std::constructible_from<key_type, K> )
+		std::pair<iterator, bool> try_emplace( K&& key, Args&&... args )
+		{
+			const size_type position = lower_bound_index( key );
+			if ( position != size() && !m_compare( key, m_keys[ position ] ) )
+			{
+				return { begin() + static_cast<difference_type>( position ), false };
+			}
+
+			const auto key_it = m_keys.insert( m_keys.begin() + static_cast<difference_type>( position ),
+											   std::forward<K>( key ) );
+			try
+			{
+				m_values.emplace( m_values.begin() + static_cast<difference_type>( position ),
+								  std::forward<Args>( args )... );
+			}
+			catch ( ... )
+			{
+				m_keys.erase( key_it );
+				throw;
+			}
+			rebuild_index();
+			return { begin() + static_cast<difference_type>( position ), true };
+		}
+
+		/// @brief Inserts the entry if its key is not present.
+		/// @return An iterator to the inserted or existing entry, and true if it was inserted.
+		std::pair<iterator, bool> insert( const value_type& entry )
+		{
+			return try_emplace( entry.first, entry.second );
+		}
+		/// @copydoc insert( const value_type& )
+		std::pair<iterator, bool> insert( value_type&& entry )
+		{
+			return try_emplace( std::move( entry.first ), std::move( entry.second ) );
+		}
+
+		/// @brief Constructs an entry from args and inserts it if its key is not present.
+		template <typename... Args>
+		std::pair<iterator, bool> emplace( Args&&... args )
+		{
+			return insert( value_type( std::forward<Args>( args )... ) );
+		}
+
+		/// @brief Sets the value for key, inserting it if key is not present.
+		/// @return An iterator to the entry, and true if it was inserted or false if it was assigned.
+		template <typename K, typename V>
+			requires( std::constructible_from<key_type, K> )
+		std::pair<iterator, bool> insert_or_assign( K&& key, V&& value )
+		{
+			auto result = try_emplace( std::forward<K>( key ), std::forward<V>( value ) );
+			if ( !result.second )
+			{
+				result.first->second = std::forward<V>( value );
+			}
+			return result;
+		}
+
+		template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+		void insert( It first, Sentinel last )
+		{
+			insert_range( std::ranges::subrange( std::move( first ), std::move( last ) ) );
+		}
+
+		void insert( const std::initializer_list<value_type> init )
+		{
+			insert_range( init );
+		}
+
+		/// @brief Inserts every entry in range whose key is not already present.
+		/// @details Appends the entries, stable sorts only the appended ones, with @ref radix_sort for integer keys in
+		/// their natural order, then merges them with the existing entries in one pass and drops duplicate keys. Where
+		/// range has equivalent keys the first is kept. O(n + m log m) rather than the O(n m) of inserting one at a
+		/// time.
+		/// @param range Pair like key/value elements, read with @c std::get<0> and @c std::get<1>.
+		template <std::ranges::input_range Range>
+		void insert_range( Range&& range )
+		{
+			const size_type old_size = size();
+			if constexpr ( std::ranges::sized_range<Range> )
+			{
+				reserve( old_size + static_cast<size_type>( std::ranges::size( range ) ) );
+			}
+			try
+			{
+				for ( auto&& entry : range )
+				{
+					m_keys.emplace_back( std::get<0>( std::forward<decltype( entry )>( entry ) ) );
+					m_values.emplace_back( std::get<1>( std::forward<decltype( entry )>( entry ) ) );
+				}
+			}
+			catch ( ... )
+			{
+				m_keys.erase( m_keys.begin() + static_cast<difference_type>( old_size ), m_keys.end() );
+				m_values.erase( m_values.begin() + static_cast<difference_type>( old_size ), m_values.end() );
+				throw;
+			}
+
+			try
+			{
+				merge_appended( old_size );
+			}
+			catch ( ... )
+			{
+				// Entries may have been moved from, the only state left consistent is empty
+				clear();
+				throw;
+			}
+		}
+
+		/// @brief Erases the entry at pos.
+		/// @return An iterator to the entry after pos.
+		iterator erase( const const_iterator pos )
+		{
+			return erase( pos, std::next( pos ) );
+		}
+
+		/// @brief Erases the entries in [first, last).
+		/// @return An iterator to the entry after the erased entries.
+		iterator erase( const const_iterator first, const const_iterator last )
+		{
+			const auto key_it = m_keys.erase( first.m_key, last.m_key );
+			const auto value_it = m_values.erase( first.m_value, last.m_value );
+			rebuild_index();
+			return iterator( key_it, value_it );
+		}
+
+		/// @brief Erases the entry with key equivalent to key.
+		/// @return The number of entries erased, 0 or 1.
+		size_type erase( const key_type& key )
+		{
+			const const_iterator it = find( key );
+			if ( it == end() )
+			{
+				return 0;
+			}
+			erase( it );
+			return 1;
+		}
+
+		/// @brief Erases every entry for which pred returns true.
+		/// @param pred Called with a @ref const_reference to each entry.
+		/// @return The number of entries erased.
+		template <typename Predicate>
+		size_type remove_if( Predicate pred )
+		{
+			size_type out = 0;
+			for ( size_type index = 0; index < size(); ++index )
+			{
+				if ( pred( const_reference{ m_keys[ index ], m_values[ index ] } ) )
+				{
+					continue;
+				}
+				if ( out != index )
+				{
+					m_keys[ out ] = std::move( m_keys[ index ] );
+					m_values[ out ] = std::move( m_values[ index ] );
+				}
+				++out;
+			}
+			const size_type count = size() - out;
+			m_keys.erase( m_keys.begin() + static_cast<difference_type>( out ), m_keys.end() );
+			m_values.erase( m_values.begin() + static_cast<difference_type>( out ), m_values.end() );
+			rebuild_index();
+			return count;
+		}
+
+		void clear() noexcept
+		{
+			m_keys.clear();
+			m_values.clear();
+			m_index.clear();
+		}
+
+		void swap( flat_map& other ) noexcept
+		{
+			using std::swap;
+			swap( m_compare, other.m_compare );
+			m_keys.swap( other.m_keys );
+			m_values.swap( other.m_values );
+			m_index.swap( other.m_index );
+		}
+
+		friend void swap( flat_map& lhs, flat_map& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+		[[nodiscard]] iterator find( const key_type& key )
+		{
+			const size_type position = find_index( key );
+			return begin() + static_cast<difference_type>( position );
+		}
+		[[nodiscard]] const_iterator find( const key_type& key ) const
+		{
+			const size_type position = find_index( key );
+			return begin() + static_cast<difference_type>( position );
+		}
+
+		[[nodiscard]] bool contains( const key_type& key ) const
+		{
+			return find_index( key ) != size();
+		}
+
+		[[nodiscard]] size_type count( const key_type& key ) const
+		{
+			return contains( key ) ? 1 : 0;
+		}
+
+		[[nodiscard]] iterator lower_bound( const key_type& key )
+		{
+			return begin() + static_cast<difference_type>( lower_bound_index( key ) );
+		}
+		[[nodiscard]] const_iterator lower_bound( const key_type& key ) const
+		{
+			return begin() + static_cast<difference_type>( lower_bound_index( key ) );
+		}
+
+		[[nodiscard]] iterator upper_bound( const key_type& key )
+		{
+			return begin() + static_cast<difference_type>( upper_bound_index( key ) );
+		}
+		[[nodiscard]] const_iterator upper_bound( const key_type& key ) const
+		{
+			return begin() + static_cast<difference_type>( upper_bound_index( key ) );
+		}
+
+		[[nodiscard]] std::pair<iterator, iterator> equal_range( const key_type& key )
+		{
+			return { lower_bound( key ), upper_bound( key ) };
+		}
+		[[nodiscard]] std::pair<const_iterator, const_iterator> equal_range( const key_type& key ) const
+		{
+			return { lower_bound( key ), upper_bound( key ) };
+		}
+
+		[[nodiscard]] friend bool operator==( const flat_map& lhs, const flat_map& rhs )
+		{
+			return lhs.m_keys == rhs.m_keys && lhs.m_values == rhs.m_values;
+		}
+
+	private:
+		[[nodiscard]] size_type lower_bound_index( const key_type& key ) const
+		{
+			return m_index.lower_bound( keys(), key, m_compare );
+		}
+
+		[[nodiscard]] size_type upper_bound_index( const key_type& key ) const
+		{
+			const size_type position = lower_bound_index( key );
+			return position != size() && !m_compare( key, m_keys[ position ] ) ? position + 1 : position;
+		}
+
+		/// @brief Get the position of the entry with key equivalent to key, or size() if there is none
+		[[nodiscard]] size_type find_index( const key_type& key ) const
+		{
+			const size_type position = lower_bound_index( key );
+			return position != size() && !m_compare( key, m_keys[ position ] ) ? position : size();
+		}
+
+		/// @brief Sort the entries appended after old_size and merge them into the sorted entries before it
+		void merge_appended( const size_type old_size )
+		{
+			const size_type appended = size() - old_size;
+			if ( appended == 0 )
+			{
+				return;
+			}
+
+			// Sort the positions of the appended entries by key, radix sorting copies of integer keys directly
+			std::vector<size_type, rebind<size_type>> order( appended, m_keys.get_allocator() );
+			if constexpr ( detail::flat_radix_sortable<key_type, key_compare> )
+			{
+				struct keyed_position
+				{
+					key_type key;
+					size_type position;
+				};
+				std::vector<keyed_position, rebind<keyed_position>> keyed( appended, m_keys.get_allocator() );
+				for ( size_type index = 0; index < appended; ++index )
+				{
+					keyed[ index ] = { m_keys[ old_size + index ], old_size + index };
+				}
+				detail::flat_stable_sort( keyed.begin(), keyed.end(), m_compare, &keyed_position::key );
+				std::ranges::transform( keyed, order.begin(), &keyed_position::position );
+			}
+			else
+			{
+				for ( size_type index = 0; index < appended; ++index )
+				{
+					order[ index ] = old_size + index;
+				}
+				std::ranges::stable_sort( order, [ this ]( const size_type lhs, const size_type rhs ) {
+					return m_compare( m_keys[ lhs ], m_keys[ rhs ] );
+				} );
+			}
+
+			key_storage keys( m_keys.get_allocator() );
+			value_storage values( m_values.get_allocator() );
+			keys.reserve( size() );
+			values.reserve( size() );
+
+			// Existing entries win ties so they are kept over appended duplicates, as are earlier appended entries
+			size_type existing = 0;
+			size_type next = 0;
+			while ( existing < old_size || next < appended )
+			{
+				if ( next == appended ||
+					 ( existing < old_size && !m_compare( m_keys[ order[ next ] ], m_keys[ existing ] ) ) )
+				{
+					keys.push_back( std::move( m_keys[ existing ] ) );
+					values.push_back( std::move( m_values[ existing ] ) );
+					++existing;
+					continue;
+				}
+
+				const size_type position = order[ next++ ];
+				if ( keys.empty() || m_compare( keys.back(), m_keys[ position ] ) )
+				{
+					keys.push_back( std::move( m_keys[ position ] ) );
+					values.push_back( std::move( m_values[ position ] ) );
+				}
+			}
+
+			m_keys = std::move( keys );
+			m_values = std::move( values );
+			rebuild_index();
+		}
+
+		void rebuild_index()
+		{
+			m_index.rebuild( keys() );
+		}
+
+		MCLO_NO_UNIQUE_ADDRESS key_compare m_compare;
+		key_storage m_keys;
+		value_storage m_values;
+		search_index m_index;
+	};
+}
+
+namespace std
+{
+	template <typename Key, typename T, typename Compare, typename Layout, typename Allocator, typename Predicate>
+	typename mclo::flat_map<Key, T, Compare, Layout, Allocator>::size_type erase_if(
+		mclo::flat_map<Key, T, Compare, Layout, Allocator>& map, Predicate pred )
+	{
+		return map.remove_if( std::move( pred ) );
+	}
+}
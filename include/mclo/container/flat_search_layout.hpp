@@ -0,0 +1,150 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/memory/prefetch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief Search layout for @ref flat_set and @ref flat_map that binary searches the sorted keys directly.
+	/// @details The search halves the range with a conditional move rather than a branch, so it never mispredicts,
+	/// and needs no memory beyond the keys. Best for tables that are modified often or fit in cache.
+	struct binary_search_layout
+	{
+		template <typename Key, typename Allocator>
+		class index
+		{
+		public:
+			index() = default;
+
+			explicit index( const Allocator& ) noexcept
+			{
+			}
+
+			void rebuild( mclo::span<const Key> ) noexcept
+			{
+			}
+
+			/// @brief Get the position of the first key not ordered before key.
+			template <typename Compare>
+			[[nodiscard]] std::size_t lower_bound( const mclo::span<const Key> sorted_keys,
+												   const Key& key,
+												   const Compare& comp ) const
+			{
+				const Key* first = sorted_keys.data();
+				std::size_t length = sorted_keys.size();
+				while ( length > 1 )
+				{
+					const std::size_t half = length / 2;
+					first = comp( first[ half - 1 ], key ) ? first + half : first;
+					length -= half;
+				}
+				return static_cast<std::size_t>( first - sorted_keys.data() ) +
+					   ( length == 1 && comp( *first, key ) );
+			}
+
+			void clear() noexcept
+			{
+			}
+
+			void swap( index& ) noexcept
+			{
+			}
+		};
+	};
+
+	/// @brief Search layout for @ref flat_set and @ref flat_map that keeps a copy of the keys in Eytzinger order.
+	/// @details The copy is laid out like a binary heap, the children of the key at position k are at 2k and 2k + 1,
+	/// so the first levels of every search share a few cache lines and the keys several levels below the current one
+	/// are contiguous and prefetched ahead of the search. This beats binary search once the table is larger than the
+	/// cache, at the cost of a second copy of the keys plus an index per key, rebuilt on every modification. Best for
+	/// large read mostly tables.
+	struct eytzinger_layout
+	{
+		template <typename Key, typename Allocator>
+		class index
+		{
+			template <typename T>
+			using rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+			// How many levels ahead to prefetch so a whole cache line of descendants is fetched at once
+			static constexpr std::size_t keys_per_line = std::hardware_destructive_interference_size / sizeof( Key );
+			static constexpr std::size_t prefetch_stride = std::bit_floor( std::max<std::size_t>( keys_per_line, 1 ) );
+
+		public:
+			index() = default;
+
+			explicit index( const Allocator& alloc )
+				: m_keys( alloc )
+				, m_ranks( alloc )
+			{
+			}
+
+			void rebuild( const mclo::span<const Key> sorted_keys )
+			{
+				m_keys.assign( sorted_keys.size(), Key() );
+				m_ranks.assign( sorted_keys.size(), 0 );
+				std::size_t rank = 0;
+				fill( sorted_keys, 1, rank );
+			}
+
+			/// @brief Get the position in sorted order of the first key not ordered before key.
+			template <typename Compare>
+			[[nodiscard]] std::size_t lower_bound( const mclo::span<const Key> sorted_keys,
+												   const Key& key,
+												   const Compare& comp ) const
+			{
+				const std::size_t size = m_keys.size();
+				const std::uintptr_t base = reinterpret_cast<std::uintptr_t>( m_keys.data() );
+				std::size_t k = 1;
+				while ( k <= size )
+				{
+					// Prefetching never faults so the descendants may be past the end
+					prefetch( reinterpret_cast<const void*>( base + ( k * prefetch_stride - 1 ) * sizeof( Key ) ) );
+					k = 2 * k + comp( m_keys[ k - 1 ], key );
+				}
+
+				// The path went right at every level below the answer, undo those moves and the final left one
+				k >>= std::countr_one( k ) + 1;
+				return k == 0 ? sorted_keys.size() : m_ranks[ k - 1 ];
+			}
+
+			void clear() noexcept
+			{
+				m_keys.clear();
+				m_ranks.clear();
+			}
+
+			void swap( index& other ) noexcept
+			{
+				m_keys.swap( other.m_keys );
+				m_ranks.swap( other.m_ranks );
+			}
+
+		private:
+			/// @brief In order walk of the implicit tree, assigning the sorted keys in turn
+			void fill( const mclo::span<const Key> sorted_keys, const std::size_t k, std::size_t& rank )
+			{
+				if ( k > m_keys.size() )
+				{
+					return;
+				}
+				fill( sorted_keys, 2 * k, rank );
+				m_keys[ k - 1 ] = sorted_keys[ rank ];
+				m_ranks[ k - 1 ] = static_cast<std::uint32_t>( rank );
+				++rank;
+				fill( sorted_keys, 2 * k + 1, rank );
+			}
+
+			std::vector<Key, rebind<Key>> m_keys;
+			std::vector<std::uint32_t, rebind<std::uint32_t>> m_ranks;
+		};
+	};
+}
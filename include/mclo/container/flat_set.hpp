@@ -0,0 +1,374 @@
+#pragma once
+
+#include "mclo/container/detail/flat_sort.hpp"
+#include "mclo/container/flat_search_layout.hpp"
+#include "mclo/container/span.hpp"
+#include "mclo/platform/attributes.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A set of unique keys stored sorted in one contiguous array.
+	/// @details Lookups search contiguous memory with no per node allocation or pointer chasing, unlike @c std::set,
+	/// at the cost of inserting and erasing shifting the later keys. Build in bulk with @ref insert_range, which
+	/// appends the new keys, sorts just those, @ref radix_sort for integers, then merges them in a single pass.
+	///
+	/// Keys are immutable through iterators, every iterator is a const iterator.
+	/// @tparam Key The key type.
+	/// @tparam Compare The strict weak ordering of keys.
+	/// @tparam Layout How lookups search the keys, @ref binary_search_layout or @ref eytzinger_layout.
+	/// @tparam Allocator The allocator for the keys.
+	template <typename Key,
+			  typename Compare = std::less<Key>,
+			  typename Layout = binary_search_layout,
+			  typename Allocator = std::allocator<Key>>
+	class flat_set
+	{
+		using storage = std::vector<Key, Allocator>;
+		using search_index = typename Layout::template index<Key, Allocator>;
+
+	public:
+		using key_type = Key;
+		using value_type = Key;
+		using key_compare = Compare;
+		using value_compare = Compare;
+		using size_type = typename storage::size_type;
+		using difference_type = typename storage::difference_type;
+		using allocator_type = Allocator;
+		using reference = const value_type&;
+		using const_reference = const value_type&;
+		using iterator = typename storage::const_iterator;
+		using const_iterator = typename storage::const_iterator;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		flat_set() = default;
+
+		explicit flat_set( const key_compare& comp, const allocator_type& alloc = allocator_type() )
+			: m_compare( comp )
+			, m_keys( alloc )
+			, m_index( alloc )
+		{
+		}
+
+		explicit flat_set( const allocator_type& alloc )
+			: m_keys( alloc )
+			, m_index( alloc )
+		{
+		}
+
+		template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+		flat_set( It first,
+				  Sentinel last,
+				  const key_compare& comp = key_compare(),
+				  const allocator_type& alloc = allocator_type() )
+			: flat_set( comp, alloc )
+		{
+			insert( std::move( first ), std::move( last ) );
+		}
+
+		template <std::ranges::input_range Range>
+			requires( std::convertible_to<std::ranges::range_reference_t<Range>, value_type> )
+		explicit flat_set( Range&& range,
+						   const key_compare& comp = key_compare(),
+						   const allocator_type& alloc = allocator_type() )
+			: flat_set( comp, alloc )
+		{
+			insert_range( std::forward<Range>( range ) );
+		}
+
+		flat_set( const std::initializer_list<value_type> init,
+				  const key_compare& comp = key_compare(),
+				  const allocator_type& alloc = allocator_type() )
+			: flat_set( comp, alloc )
+		{
+			insert_range( init );
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return m_keys.begin();
+		}
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return m_keys.cbegin();
+		}
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return m_keys.end();
+		}
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return m_keys.cend();
+		}
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept
+		{
+			return m_keys.rbegin();
+		}
+		[[nodiscard]] const_reverse_iterator crbegin() const noexcept
+		{
+			return m_keys.crbegin();
+		}
+		[[nodiscard]] const_reverse_iterator rend() const noexcept
+		{
+			return m_keys.rend();
+		}
+		[[nodiscard]] const_reverse_iterator crend() const noexcept
+		{
+			return m_keys.crend();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_keys.empty();
+		}
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_keys.size();
+		}
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			return m_keys.max_size();
+		}
+		[[nodiscard]] size_type capacity() const noexcept
+		{
+			return m_keys.capacity();
+		}
+
+		void reserve( const size_type count )
+		{
+			m_keys.reserve( count );
+		}
+
+		void shrink_to_fit()
+		{
+			m_keys.shrink_to_fit();
+		}
+
+		/// @brief Get the sorted keys.
+		[[nodiscard]] mclo::span<const key_type> keys() const noexcept
+		{
+			return { m_keys.data(), m_keys.size() };
+		}
+
+		[[nodiscard]] key_compare key_comp() const
+		{
+			return m_compare;
+		}
+		[[nodiscard]] value_compare value_comp() const
+		{
+			return m_compare;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return m_keys.get_allocator();
+		}
+
+		/// @brief Inserts key if no equivalent key is present.
+		/// @return An iterator to the inserted or equivalent key, and true if key was inserted.
+		template <typename... Args>
+		std::pair<iterator, bool> emplace( Args&&... args )
+		{
+			return insert( value_type( std::forward<Args>( args )... ) );
+		}
+
+		/// @copydoc emplace
+		std::pair<iterator, bool> insert( const value_type& key )
+		{
+			return insert( value_type( key ) );
+		}
+
+		/// @copydoc emplace
+		std::pair<iterator, bool> insert( value_type&& key )
+		{
+			const size_type position = lower_bound_index( key );
+			if ( position != m_keys.size() && !m_compare( key, m_keys[ position ] ) )
+			{
+				return { begin() + static_cast<difference_type>( position ), false };
+			}
+			m_keys.insert( m_keys.begin() + static_cast<difference_type>( position ), std::move( key ) );
+			rebuild_index();
+			return { begin() + static_cast<difference_type>( position ), true };
+		}
+
+		template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+		void insert( It first, Sentinel last )
+		{
+			insert_range( std::ranges::subrange( std::move( first ), std::move( last ) ) );
+		}
+
+		void insert( const std::initializer_list<value_type> init )
+		{
+			insert_range( init );
+		}
+
+		/// @brief Inserts every key in range whose equivalent is not already present.
+		/// @details Appends the keys, stable sorts only the appended ones, with @ref radix_sort for integers in their
+		/// natural order, then merges them with the existing keys and drops duplicates. Where range has equivalent
+		/// keys the first is kept. O(n + m log m) rather than the O(n m) of inserting one at a time.
+		template <std::ranges::input_range Range>
+			requires( std::convertible_to<std::ranges::range_reference_t<Range>, value_type> )
+		void insert_range( Range&& range )
+		{
+			const size_type old_size = m_keys.size();
+			if constexpr ( std::ranges::sized_range<Range> )
+			{
+				m_keys.reserve( old_size + static_cast<size_type>( std::ranges::size( range ) ) );
+			}
+			try
+			{
+				for ( auto&& key : range )
+				{
+					m_keys.emplace_back( std::forward<decltype( key )>( key ) );
+				}
+			}
+			catch ( ... )
+			{
+				m_keys.erase( m_keys.begin() + static_cast<difference_type>( old_size ), m_keys.end() );
+				throw;
+			}
+
+			const auto middle = m_keys.begin() + static_cast<difference_type>( old_size );
+			detail::flat_stable_sort( middle, m_keys.end(), m_compare );
+			std::inplace_merge( m_keys.begin(), middle, m_keys.end(), m_compare );
+			const auto equivalent = [ this ]( const Key& lhs, const Key& rhs ) { return !m_compare( lhs, rhs ); };
+			const auto duplicates = std::unique( m_keys.begin(), m_keys.end(), equivalent );
+			m_keys.erase( duplicates, m_keys.end() );
+			rebuild_index();
+		}
+
+		/// @brief Erases the key at pos.
+		/// @return An iterator to the key after pos.
+		iterator erase( const const_iterator pos )
+		{
+			const auto it = m_keys.erase( pos );
+			rebuild_index();
+			return it;
+		}
+
+		/// @brief Erases the keys in [first, last).
+		/// @return An iterator to the key after the erased keys.
+		iterator erase( const const_iterator first, const const_iterator last )
+		{
+			const auto it = m_keys.erase( first, last );
+			rebuild_index();
+			return it;
+		}
+
+		/// @brief Erases the key equivalent to key.
+		/// @return The number of keys erased, 0 or 1.
+		size_type erase( const key_type& key )
+		{
+			const const_iterator it = find( key );
+			if ( it == end() )
+			{
+				return 0;
+			}
+			erase( it );
+			return 1;
+		}
+
+		/// @brief Erases every key for which pred returns true.
+		/// @return The number of keys erased.
+		template <typename Predicate>
+		size_type remove_if( Predicate pred )
+		{
+			const auto removed = std::ranges::remove_if( m_keys, pred );
+			const size_type count = static_cast<size_type>( removed.size() );
+			m_keys.erase( removed.begin(), removed.end() );
+			rebuild_index();
+			return count;
+		}
+
+		void clear() noexcept
+		{
+			m_keys.clear();
+			m_index.clear();
+		}
+
+		void swap( flat_set& other ) noexcept
+		{
+			using std::swap;
+			swap( m_compare, other.m_compare );
+			m_keys.swap( other.m_keys );
+			m_index.swap( other.m_index );
+		}
+
+		friend void swap( flat_set& lhs, flat_set& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+		[[nodiscard]] const_iterator find( const key_type& key ) const
+		{
+			const const_iterator it = lower_bound( key );
+			return it != end() && !m_compare( key, *it ) ? it : end();
+		}
+
+		[[nodiscard]] bool contains( const key_type& key ) const
+		{
+			return find( key ) != end();
+		}
+
+		[[nodiscard]] size_type count( const key_type& key ) const
+		{
+			return contains( key ) ? 1 : 0;
+		}
+
+		[[nodiscard]] const_iterator lower_bound( const key_type& key ) const
+		{
+			return begin() + static_cast<difference_type>( lower_bound_index( key ) );
+		}
+
+		[[nodiscard]] const_iterator upper_bound( const key_type& key ) const
+		{
+			const const_iterator it = lower_bound( key );
+			return it != end() && !m_compare( key, *it ) ? std::next( it ) : it;
+		}
+
+		[[nodiscard]] std::pair<const_iterator, const_iterator> equal_range( const key_type& key ) const
+		{
+			const const_iterator it = lower_bound( key );
+			return { it, it != end() && !m_compare( key, *it ) ? std::next( it ) : it };
+		}
+
+		[[nodiscard]] friend bool operator==( const flat_set& lhs, const flat_set& rhs )
+		{
+			return lhs.m_keys == rhs.m_keys;
+		}
+
+	private:
+		[[nodiscard]] size_type lower_bound_index( const key_type& key ) const
+		{
+			return m_index.lower_bound( keys(), key, m_compare );
+		}
+
+		void rebuild_index()
+		{
+			m_index.rebuild( keys() );
+		}
+
+		MCLO_NO_UNIQUE_ADDRESS key_compare m_compare;
+		storage m_keys;
+		search_index m_index;
+	};
+}
+
+namespace std
+{
+	template <typename Key, typename Compare, typename Layout, typename Allocator, typename Predicate>
+	typename mclo::flat_set<Key, Compare, Layout, Allocator>::size_type erase_if(
+		mclo::flat_set<Key, Compare, Layout, Allocator>& set, Predicate pred )
+	{
+		return set.remove_if( std::move( pred ) );
+	}
+}
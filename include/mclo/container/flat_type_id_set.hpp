@@ -0,0 +1,243 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/container/type_id_set.hpp"
+#include "mclo/meta/type_id.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A set of @ref mclo::meta::type_id_t in flat arrays, a backend for @ref type_id_set and @ref type_id_map.
+	/// @details The identities are stored densely in insertion order and found through an open addressed index with
+	/// linear probing kept at most half full. Type identities are the addresses of distinct objects, so a
+	/// multiplicative hash of the address spreads them almost perfectly and a lookup is usually a single probe of one
+	/// contiguous array, with no per node allocation or bucket chain as in @c std::unordered_set.
+	///
+	/// Erasing moves the last identity into the erased one's place, so @ref index_of stays a dense index usable to
+	/// address parallel arrays.
+	/// @tparam Allocator The allocator for the arrays.
+	template <typename Allocator = std::allocator<meta::type_id_t>>
+	class type_id_hash_index
+	{
+		template <typename T>
+		using rebind = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+		struct slot
+		{
+			meta::type_id_t id = nullptr;
+			std::uint32_t index = 0;
+		};
+
+		using key_storage = std::vector<meta::type_id_t, rebind<meta::type_id_t>>;
+
+	public:
+		using key_type = meta::type_id_t;
+		using value_type = meta::type_id_t;
+		using reference = const value_type&;
+		using const_reference = const value_type&;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using iterator = typename key_storage::const_iterator;
+		using const_iterator = typename key_storage::const_iterator;
+		using allocator_type = Allocator;
+
+		/// @brief Returned by @ref index_of when the identity is not present.
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		type_id_hash_index() = default;
+
+		explicit type_id_hash_index( const allocator_type& alloc )
+			: m_keys( alloc )
+			, m_slots( alloc )
+		{
+		}
+
+		/// @brief Inserts id at the end of the dense order if not present.
+		/// @return An iterator to id and true if it was inserted, false if it was already present.
+		std::pair<iterator, bool> insert( const key_type id )
+		{
+			if ( const size_type index = index_of( id ); index != npos )
+			{
+				return { m_keys.begin() + static_cast<difference_type>( index ), false };
+			}
+			if ( ( m_keys.size() + 1 ) * 2 > m_slots.size() )
+			{
+				rehash( std::max<size_type>( m_slots.size() * 2, 16 ) );
+			}
+			m_keys.push_back( id );
+			m_slots[ probe( id ) ] = { id, static_cast<std::uint32_t>( m_keys.size() - 1 ) };
+			return { std::prev( m_keys.end() ), true };
+		}
+
+		/// @brief Erases id, moving the last identity into its place.
+		/// @return The number of identities erased, 0 or 1.
+		size_type erase( const key_type id ) noexcept
+		{
+			if ( m_slots.empty() )
+			{
+				return 0;
+			}
+			const size_type found = probe( id );
+			if ( !m_slots[ found ].id )
+			{
+				return 0;
+			}
+
+			const std::uint32_t index = m_slots[ found ].index;
+			const std::uint32_t last = static_cast<std::uint32_t>( m_keys.size() - 1 );
+			if ( index != last )
+			{
+				m_keys[ index ] = m_keys[ last ];
+				m_slots[ probe( m_keys[ index ] ) ].index = index;
+			}
+			m_keys.pop_back();
+			erase_slot( found );
+			return 1;
+		}
+
+		/// @brief Gets the dense index of id, its position when iterating.
+		/// @return The index, or @ref npos if id is not present.
+		[[nodiscard]] size_type index_of( const key_type id ) const noexcept
+		{
+			if ( m_slots.empty() )
+			{
+				return npos;
+			}
+			const slot& found = m_slots[ probe( id ) ];
+			return found.id ? found.index : npos;
+		}
+
+		[[nodiscard]] bool contains( const key_type id ) const noexcept
+		{
+			return !m_slots.empty() && m_slots[ probe( id ) ].id;
+		}
+
+		/// @brief Reserves storage for count identities so inserting up to count does not allocate.
+		void reserve( const size_type count )
+		{
+			m_keys.reserve( count );
+			if ( count * 2 > m_slots.size() )
+			{
+				rehash( std::bit_ceil( count * 2 ) );
+			}
+		}
+
+		void clear() noexcept
+		{
+			m_keys.clear();
+			std::fill( m_slots.begin(), m_slots.end(), slot() );
+		}
+
+		void swap( type_id_hash_index& other ) noexcept
+		{
+			m_keys.swap( other.m_keys );
+			m_slots.swap( other.m_slots );
+			std::swap( m_shift, other.m_shift );
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_keys.empty();
+		}
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_keys.size();
+		}
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			return std::min<size_type>( m_keys.max_size(), std::numeric_limits<std::uint32_t>::max() );
+		}
+
+		/// @brief Returns the identities in dense order, @c keys()[ index_of( id ) ] is id.
+		[[nodiscard]] mclo::span<const key_type> keys() const noexcept
+		{
+			return { m_keys.data(), m_keys.size() };
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return m_keys.begin();
+		}
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return m_keys.cbegin();
+		}
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return m_keys.end();
+		}
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return m_keys.cend();
+		}
+
+		/// @brief Compares as sets, ignoring the order identities were inserted in.
+		[[nodiscard]] bool operator==( const type_id_hash_index& other ) const noexcept
+		{
+			return size() == other.size() && std::ranges::all_of( m_keys, [ &other ]( const key_type id ) {
+					   return other.contains( id );
+				   } );
+		}
+
+	private:
+		/// @brief Fibonacci hash of the identity's address, taking the high bits which mix in every address bit
+		[[nodiscard]] size_type home_slot( const key_type id ) const noexcept
+		{
+			const std::uint64_t address = reinterpret_cast<std::uintptr_t>( id );
+			return static_cast<size_type>( ( address * 0x9E3779B97F4A7C15ull ) >> m_shift );
+		}
+
+		/// @brief Get the index of the slot holding id, or of the empty slot ending its probe sequence
+		[[nodiscard]] size_type probe( const key_type id ) const noexcept
+		{
+			const size_type mask = m_slots.size() - 1;
+			size_type index = home_slot( id );
+			while ( m_slots[ index ].id && m_slots[ index ].id != id )
+			{
+				index = ( index + 1 ) & mask;
+			}
+			return index;
+		}
+
+		/// @brief Empty a slot, shifting later slots of the probe run back so lookups never need tombstones
+		void erase_slot( size_type hole ) noexcept
+		{
+			const size_type mask = m_slots.size() - 1;
+			for ( size_type index = ( hole + 1 ) & mask; m_slots[ index ].id; index = ( index + 1 ) & mask )
+			{
+				// Move the entry back into the hole unless its home lies cyclically within ( hole, index ]
+				const size_type home = home_slot( m_slots[ index ].id );
+				if ( ( ( index - home ) & mask ) >= ( ( index - hole ) & mask ) )
+				{
+					m_slots[ hole ] = m_slots[ index ];
+					hole = index;
+				}
+			}
+			m_slots[ hole ] = slot();
+		}
+
+		void rehash( const size_type slot_count )
+		{
+			m_slots.assign( slot_count, slot() );
+			m_shift = 64 - std::countr_zero( slot_count );
+			for ( std::uint32_t index = 0; index < m_keys.size(); ++index )
+			{
+				m_slots[ probe( m_keys[ index ] ) ] = { m_keys[ index ], index };
+			}
+		}
+
+		key_storage m_keys;
+		std::vector<slot, rebind<slot>> m_slots;
+		int m_shift = 64;
+	};
+
+	/// @brief A @ref type_id_set stored in flat arrays, see @ref type_id_hash_index.
+	using flat_type_id_set = type_id_set<type_id_hash_index<>>;
+}
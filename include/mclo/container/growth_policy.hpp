@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace mclo
+{
+	/// @brief Growth policy that multiplies the capacity by Numerator / Denominator when a container runs out of space.
+	/// @details Growth policies provide a static @c next_capacity( capacity, required, max_capacity ) returning the new
+	/// capacity, at least required and at most max_capacity. A factor of 1.5 lets freed blocks be reused by later
+	/// growth, 2 does fewer reallocations for faster growing containers.
+	/// @tparam Numerator The numerator of the growth factor.
+	/// @tparam Denominator The denominator of the growth factor.
+	template <std::size_t Numerator, std::size_t Denominator = 1>
+	struct geometric_growth
+	{
+		static_assert( Numerator > Denominator, "Growth factor must be greater than one" );
+
+		[[nodiscard]] static constexpr std::size_t next_capacity( const std::size_t capacity,
+																  const std::size_t required,
+																  const std::size_t max_capacity ) noexcept
+		{
+			constexpr std::size_t extra = Numerator - Denominator;
+			const std::size_t increase = capacity / Denominator * extra + capacity % Denominator * extra / Denominator;
+			if ( increase > max_capacity - capacity ) [[unlikely]]
+			{
+				return max_capacity;
+			}
+			return std::max( capacity + increase, required );
+		}
+	};
+
+	/// @brief Growth policy that only grows to the capacity required, for containers sized up front or memory bound.
+	struct exact_growth
+	{
+		[[nodiscard]] static constexpr std::size_t next_capacity( const std::size_t,
+																  const std::size_t required,
+																  const std::size_t ) noexcept
+		{
+			return required;
+		}
+	};
+}
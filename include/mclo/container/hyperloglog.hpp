@@ -0,0 +1,345 @@
+#pragma once
+
+#include "mclo/container/detail/filter_common.hpp"
+#include "mclo/container/detail/hyperloglog_simd.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/hash/rapidhash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A HyperLogLog sketch, estimating the number of distinct keys in a stream in a small fixed amount of
+	/// memory.
+	/// @details Each key hash picks one of @c 2^precision registers and the register keeps the longest run of leading
+	/// zeros seen in the rest of the hash. The relative standard error of @ref estimate is about
+	/// @c 1.04/sqrt(2^precision), 0.81% at the default precision of 14 using 16KiB of registers.
+	///
+	/// Small sketches use a sparse representation as in HyperLogLog++, a sorted list of the registers touched kept at
+	/// a precision of 25 bits so small cardinalities are estimated almost exactly. It converts to dense registers once
+	/// the list would be larger than them. The dense estimate uses Ertl's improved estimator over the histogram of
+	/// register values, which is unbiased across the whole range without the empirical bias tables of HyperLogLog++.
+	///
+	/// Sketches of the same precision and @p Hasher @ref merge into the sketch of the union of their streams, the same
+	/// as if every key had been inserted into one sketch. Dense registers merge with SIMD.
+	/// @tparam Key The key type.
+	/// @tparam Hasher The hasher used to hash keys.
+	template <typename Key, hasher Hasher = mclo::rapidhash>
+		requires( hashable_with<Key, Hasher> && std::default_initializable<Hasher> )
+	class hyperloglog
+	{
+		// Sparse entries are the register index at sparse_precision bits above 6 bits of rank
+		static constexpr unsigned sparse_precision = 25;
+		static constexpr unsigned sparse_rank_bits = 6;
+
+	public:
+		using key_type = Key;
+		using hasher_type = Hasher;
+		using size_type = std::size_t;
+
+		static constexpr unsigned min_precision = 4;
+		static constexpr unsigned max_precision = 18;
+		static constexpr unsigned default_precision = 14;
+
+		/// @brief Construct an empty sketch.
+		/// @param precision The number of index bits, there are @c 2^precision registers. Must be in
+		/// [@ref min_precision, @ref max_precision].
+		explicit hyperloglog( const unsigned precision = default_precision ) noexcept
+			: m_precision( precision )
+		{
+			MCLO_DEBUG_ASSERT( precision >= min_precision && precision <= max_precision,
+							   "HyperLogLog precision out of range",
+							   precision );
+		}
+
+		/// @brief Get the relative standard error of estimates at a precision.
+		[[nodiscard]] static double relative_error( const unsigned precision ) noexcept
+		{
+			return 1.04 / std::sqrt( static_cast<double>( size_type{ 1 } << precision ) );
+		}
+
+		/// @brief Insert a key.
+		void insert( const Key& key )
+		{
+			insert_hash( hash_object<Hasher>( key ) );
+		}
+
+		/// @brief Insert a key by its hash.
+		/// @param hash The hash of the key from @ref hash_object using @p Hasher, such as from @ref hash_many.
+		void insert_hash( const std::size_t hash )
+		{
+			const std::uint64_t mixed = detail::filter_mix( hash );
+			if ( is_sparse() )
+			{
+				m_sparse_buffer.push_back( sparse_entry( mixed ) );
+				if ( m_sparse_buffer.size() >= sparse_buffer_limit() )
+				{
+					flush_sparse_buffer();
+				}
+			}
+			else
+			{
+				std::uint8_t& reg = m_registers[ static_cast<size_type>( mixed >> ( 64 - m_precision ) ) ];
+				reg = std::max( reg, dense_rank( mixed ) );
+			}
+		}
+
+		/// @brief Insert every key of a range, hashing them in bulk.
+		/// @param keys The keys to insert.
+		template <std::ranges::forward_range Range>
+			requires( std::same_as<std::ranges::range_value_t<Range>, Key> )
+		void insert_many( Range&& keys )
+		{
+			const auto insert_batch = [ this ]( const std::size_t* const hashes, const size_type count, size_type ) {
+				for ( size_type index = 0; index < count; ++index )
+				{
+					insert_hash( hashes[ index ] );
+				}
+			};
+			detail::for_each_hash_batch<Key, Hasher>( keys, insert_batch );
+		}
+
+		/// @brief Estimate the number of distinct keys inserted.
+		[[nodiscard]] double estimate() const
+		{
+			if ( is_sparse() )
+			{
+				// Linear counting over the sparse registers, nearly exact while they are few of the 2^25
+				const std::vector<std::uint32_t> entries = merged_sparse_entries();
+				constexpr double sparse_registers = static_cast<double>( std::uint64_t{ 1 } << sparse_precision );
+				const double empty = sparse_registers - static_cast<double>( entries.size() );
+				return sparse_registers * std::log( sparse_registers / empty );
+			}
+			return dense_estimate();
+		}
+
+		/// @brief Merge another sketch into this one, giving the sketch of both streams.
+		/// @details Sketches are not thread safe, to count a stream in parallel give each thread its own sketch and
+		/// merge them at the end.
+		/// @param other The sketch to merge, must have the same precision.
+		void merge( const hyperloglog& other )
+		{
+			MCLO_DEBUG_ASSERT( m_precision == other.m_precision,
+							   "Can only merge HyperLogLogs of the same precision",
+							   m_precision,
+							   other.m_precision );
+			if ( &other == this )
+			{
+				return;
+			}
+			if ( other.is_sparse() )
+			{
+				if ( is_sparse() )
+				{
+					m_sparse_buffer.insert( m_sparse_buffer.end(), other.m_sparse.begin(), other.m_sparse.end() );
+					m_sparse_buffer.insert(
+						m_sparse_buffer.end(), other.m_sparse_buffer.begin(), other.m_sparse_buffer.end() );
+					flush_sparse_buffer();
+				}
+				else
+				{
+					add_sparse_to_dense( other.m_sparse );
+					add_sparse_to_dense( other.m_sparse_buffer );
+				}
+				return;
+			}
+			if ( is_sparse() )
+			{
+				convert_to_dense();
+			}
+			detail::hyperloglog_merge_simd( m_registers.data(), other.m_registers.data(), m_registers.size() );
+		}
+
+		/// @brief Remove every key, returning to the sparse representation.
+		void clear() noexcept
+		{
+			m_registers.clear();
+			m_sparse.clear();
+			m_sparse_buffer.clear();
+		}
+
+		/// @brief Get the number of index bits.
+		[[nodiscard]] unsigned precision() const noexcept
+		{
+			return m_precision;
+		}
+
+		/// @brief Check if the sketch is still using the sparse representation.
+		[[nodiscard]] bool is_sparse() const noexcept
+		{
+			return m_registers.empty();
+		}
+
+	private:
+		[[nodiscard]] size_type num_registers() const noexcept
+		{
+			return size_type{ 1 } << m_precision;
+		}
+
+		// Entries are 4 bytes and registers 1 byte, so the sparse list is smaller while it holds under a quarter
+		[[nodiscard]] size_type sparse_limit() const noexcept
+		{
+			return num_registers() / 4;
+		}
+
+		[[nodiscard]] size_type sparse_buffer_limit() const noexcept
+		{
+			return std::max<size_type>( 16, num_registers() / 32 );
+		}
+
+		/// @brief One more than the number of leading zeros after the index bits, a guard bit bounds it
+		[[nodiscard]] std::uint8_t dense_rank( const std::uint64_t mixed ) const noexcept
+		{
+			const std::uint64_t rest = ( mixed << m_precision ) | ( std::uint64_t{ 1 } << ( m_precision - 1 ) );
+			return static_cast<std::uint8_t>( std::countl_zero( rest ) + 1 );
+		}
+
+		[[nodiscard]] static std::uint32_t sparse_entry( const std::uint64_t mixed ) noexcept
+		{
+			const auto index = static_cast<std::uint32_t>( mixed >> ( 64 - sparse_precision ) );
+			const std::uint64_t rest =
+				( mixed << sparse_precision ) | ( std::uint64_t{ 1 } << ( sparse_precision - 1 ) );
+			const auto rank = static_cast<std::uint32_t>( std::countl_zero( rest ) + 1 );
+			return ( index << sparse_rank_bits ) | rank;
+		}
+
+		/// @brief The dense register and rank a sparse entry maps to, the same as inserting its hash when dense
+		[[nodiscard]] std::pair<size_type, std::uint8_t> dense_position( const std::uint32_t entry ) const noexcept
+		{
+			const std::uint32_t index = entry >> sparse_rank_bits;
+			const std::uint32_t rank = entry & ( ( std::uint32_t{ 1 } << sparse_rank_bits ) - 1 );
+			const unsigned extra_bits = sparse_precision - m_precision;
+
+			// The index bits beyond the dense precision are the start of the dense rank's bits
+			const std::uint32_t extra = index << ( 32 - extra_bits );
+			const auto dense_rank = extra != 0 ? static_cast<std::uint32_t>( std::countl_zero( extra ) + 1 )
+											   : extra_bits + rank;
+			return { static_cast<size_type>( index >> extra_bits ), static_cast<std::uint8_t>( dense_rank ) };
+		}
+
+		/// @brief The sparse list and buffer sorted by index with only the highest rank of each index
+		[[nodiscard]] std::vector<std::uint32_t> merged_sparse_entries() const
+		{
+			std::vector<std::uint32_t> buffer = m_sparse_buffer;
+			std::sort( buffer.begin(), buffer.end() );
+			std::vector<std::uint32_t> result;
+			result.reserve( m_sparse.size() + buffer.size() );
+			std::merge( m_sparse.begin(), m_sparse.end(), buffer.begin(), buffer.end(), std::back_inserter( result ) );
+
+			// Entries of the same index are adjacent in increasing rank, keep the last of each
+			const auto same_index = []( const std::uint32_t lhs, const std::uint32_t rhs ) {
+				return ( lhs >> sparse_rank_bits ) == ( rhs >> sparse_rank_bits );
+			};
+			std::reverse( result.begin(), result.end() );
+			result.erase( std::unique( result.begin(), result.end(), same_index ), result.end() );
+			std::reverse( result.begin(), result.end() );
+			return result;
+		}
+
+		void flush_sparse_buffer()
+		{
+			m_sparse = merged_sparse_entries();
+			m_sparse_buffer.clear();
+			if ( m_sparse.size() > sparse_limit() )
+			{
+				convert_to_dense();
+			}
+		}
+
+		void convert_to_dense()
+		{
+			m_registers.assign( num_registers(), 0 );
+			add_sparse_to_dense( m_sparse );
+			add_sparse_to_dense( m_sparse_buffer );
+			m_sparse = {};
+			m_sparse_buffer = {};
+		}
+
+		void add_sparse_to_dense( const std::vector<std::uint32_t>& entries ) noexcept
+		{
+			for ( const std::uint32_t entry : entries )
+			{
+				const auto [ index, rank ] = dense_position( entry );
+				m_registers[ index ] = std::max( m_registers[ index ], rank );
+			}
+		}
+
+		/// @brief Ertl's improved raw estimator from the histogram of register values
+		[[nodiscard]] double dense_estimate() const noexcept
+		{
+			const unsigned max_rank = 64 - m_precision;
+			std::array<size_type, 66> histogram{};
+			for ( const std::uint8_t reg : m_registers )
+			{
+				++histogram[ reg ];
+			}
+
+			const double m = static_cast<double>( num_registers() );
+			double z = m * tau( 1 - static_cast<double>( histogram[ max_rank + 1 ] ) / m );
+			for ( unsigned rank = max_rank; rank >= 1; --rank )
+			{
+				z += static_cast<double>( histogram[ rank ] );
+				z *= 0.5;
+			}
+			z += m * sigma( static_cast<double>( histogram[ 0 ] ) / m );
+			return m * m / ( 2 * std::numbers::ln2 * z );
+		}
+
+		[[nodiscard]] static double sigma( double x ) noexcept
+		{
+			if ( x == 1 )
+			{
+				return std::numeric_limits<double>::infinity();
+			}
+			double y = 1;
+			double z = x;
+			double previous;
+			do
+			{
+				x *= x;
+				previous = z;
+				z += x * y;
+				y += y;
+			}
+			while ( previous != z );
+			return z;
+		}
+
+		[[nodiscard]] static double tau( double x ) noexcept
+		{
+			if ( x == 0 || x == 1 )
+			{
+				return 0;
+			}
+			double y = 1;
+			double z = 1 - x;
+			double previous;
+			do
+			{
+				x = std::sqrt( x );
+				previous = z;
+				y *= 0.5;
+				z -= ( 1 - x ) * ( 1 - x ) * y;
+			}
+			while ( previous != z );
+			return z / 3;
+		}
+
+		unsigned m_precision;
+		std::vector<std::uint8_t> m_registers;
+		std::vector<std::uint32_t> m_sparse;
+		std::vector<std::uint32_t> m_sparse_buffer;
+	};
+}
@@ -0,0 +1,413 @@
+#pragma once
+
+#include "mclo/container/detail/intrusive_hash_table_iterator.hpp"
+#include "mclo/container/intrusive_hash_table_hook.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/platform/attributes.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace mclo
+{
+	namespace detail
+	{
+		template <typename T, typename KeyOf>
+		using intrusive_key_t = std::remove_cvref_t<std::invoke_result_t<const KeyOf&, const T&>>;
+	}
+
+	/// @brief A chained hash table of values that hold their own chain link by deriving from
+	/// @ref intrusive_hash_table_hook.
+	/// @details The table never allocates or owns its values, only the array of bucket heads, so values must outlive
+	/// their time in the table. Keys are unique and found from values with KeyOf, so a value can be looked up by a
+	/// key member without storing the key twice. Each hook caches its value's hash.
+	///
+	/// The bucket array grows when the size would exceed the bucket count, call @ref reserve up front for inserts
+	/// that never allocate.
+	/// @tparam T The type of values, must derive from @c intrusive_hash_table_hook<Tag>.
+	/// @tparam KeyOf Function object returning the key of a value, defaults to the value itself.
+	/// @tparam Hash Function object hashing keys.
+	/// @tparam KeyEqual Function object comparing keys for equality.
+	/// @tparam Tag Selects which hook to use when T is in multiple tables.
+	/// @tparam Allocator Allocator for the bucket array.
+	template <typename T,
+			  typename KeyOf = std::identity,
+			  typename Hash = mclo::hash<detail::intrusive_key_t<T, KeyOf>>,
+			  typename KeyEqual = std::equal_to<>,
+			  typename Tag = void,
+			  typename Allocator = std::allocator<T>>
+	class intrusive_hash_table
+	{
+		using hook_type = intrusive_hash_table_hook<Tag>;
+		static_assert( std::derived_from<T, hook_type>, "T must be derived from the intrusive hash table hook" );
+
+		using bucket_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<hook_type*>;
+		using bucket_traits = std::allocator_traits<bucket_allocator>;
+
+	public:
+		using key_type = detail::intrusive_key_t<T, KeyOf>;
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using key_of = KeyOf;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using allocator_type = Allocator;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using iterator = intrusive_hash_table_iterator<T, Tag>;
+		using const_iterator = intrusive_hash_table_iterator<const T, Tag>;
+
+		/// @brief Construct an empty table.
+		/// @param bucket_count The minimum number of buckets, rounded up to a power of two. The table holds this many
+		/// values before the bucket array grows.
+		explicit intrusive_hash_table( const size_type bucket_count = 0,
+									   const hasher& hash = hasher(),
+									   const key_equal& equal = key_equal(),
+									   const key_of& get_key = key_of(),
+									   const allocator_type& alloc = allocator_type() )
+			: m_hash( hash )
+			, m_equal( equal )
+			, m_get_key( get_key )
+			, m_allocator( alloc )
+		{
+			rehash( bucket_count );
+		}
+
+		intrusive_hash_table( const intrusive_hash_table& other ) = delete;
+		intrusive_hash_table& operator=( const intrusive_hash_table& other ) = delete;
+
+		intrusive_hash_table( intrusive_hash_table&& other ) noexcept
+			: m_hash( std::move( other.m_hash ) )
+			, m_equal( std::move( other.m_equal ) )
+			, m_get_key( std::move( other.m_get_key ) )
+			, m_allocator( std::move( other.m_allocator ) )
+			, m_buckets( std::exchange( other.m_buckets, nullptr ) )
+			, m_bucket_count( std::exchange( other.m_bucket_count, 0 ) )
+			, m_size( std::exchange( other.m_size, 0 ) )
+		{
+		}
+
+		intrusive_hash_table& operator=( intrusive_hash_table&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				deallocate_buckets();
+				m_hash = std::move( other.m_hash );
+				m_equal = std::move( other.m_equal );
+				m_get_key = std::move( other.m_get_key );
+				m_allocator = std::move( other.m_allocator );
+				m_buckets = std::exchange( other.m_buckets, nullptr );
+				m_bucket_count = std::exchange( other.m_bucket_count, 0 );
+				m_size = std::exchange( other.m_size, 0 );
+			}
+			return *this;
+		}
+
+		~intrusive_hash_table()
+		{
+			deallocate_buckets();
+		}
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator( m_buckets, m_bucket_count, first_hook() );
+		}
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator( m_buckets, m_bucket_count, first_hook() );
+		}
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator();
+		}
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator();
+		}
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_size;
+		}
+
+		[[nodiscard]] size_type bucket_count() const noexcept
+		{
+			return m_bucket_count;
+		}
+
+		[[nodiscard]] float load_factor() const noexcept
+		{
+			return m_bucket_count ? static_cast<float>( m_size ) / static_cast<float>( m_bucket_count ) : 0.0f;
+		}
+
+		[[nodiscard]] hasher hash_function() const
+		{
+			return m_hash;
+		}
+
+		[[nodiscard]] key_equal key_eq() const
+		{
+			return m_equal;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return m_allocator;
+		}
+
+		/// @brief Link value into the table if no value with an equal key is in it.
+		/// @param value The value to link, must not already be in a table using this hook.
+		/// @return An iterator to value or the value with an equal key, and true if value was linked.
+		std::pair<iterator, bool> insert( reference value )
+		{
+			const std::size_t hash = m_hash( m_get_key( std::as_const( value ) ) );
+			if ( hook_type* const existing = find_hook( m_get_key( std::as_const( value ) ), hash ) )
+			{
+				return { make_iterator( existing ), false };
+			}
+			if ( m_size >= m_bucket_count )
+			{
+				rehash( std::max<size_type>( m_bucket_count * 2, 8 ) );
+			}
+
+			hook_type& hook = as_hook( value );
+			hook.m_hash = hash;
+			hook_type*& head = m_buckets[ bucket_index( hash ) ];
+			hook.m_next = std::exchange( head, &hook );
+			++m_size;
+			return { make_iterator( &hook ), true };
+		}
+
+		[[nodiscard]] iterator find( const key_type& key )
+			noexcept( std::is_nothrow_invocable_v<const Hash&, const key_type&> )
+		{
+			return make_iterator( find_hook( key, m_hash( key ) ) );
+		}
+		[[nodiscard]] const_iterator find( const key_type& key ) const
+			noexcept( std::is_nothrow_invocable_v<const Hash&, const key_type&> )
+		{
+			const hook_type* const hook = find_hook( key, m_hash( key ) );
+			return const_iterator( m_buckets, m_bucket_count, const_cast<hook_type*>( hook ) );
+		}
+
+		[[nodiscard]] bool contains( const key_type& key ) const
+			noexcept( std::is_nothrow_invocable_v<const Hash&, const key_type&> )
+		{
+			return find_hook( key, m_hash( key ) ) != nullptr;
+		}
+
+		[[nodiscard]] size_type count( const key_type& key ) const
+			noexcept( std::is_nothrow_invocable_v<const Hash&, const key_type&> )
+		{
+			return contains( key ) ? 1 : 0;
+		}
+
+		/// @brief Unlink the value with an equal key.
+		/// @return The unlinked value, or nullptr if no value had an equal key.
+		pointer erase( const key_type& key ) noexcept( std::is_nothrow_invocable_v<const Hash&, const key_type&> )
+		{
+			const iterator it = find( key );
+			if ( it == end() )
+			{
+				return nullptr;
+			}
+			unlink( *it.m_hook );
+			return std::addressof( *it );
+		}
+
+		/// @brief Unlink value, which must be in this table.
+		/// @details Only walks the value's bucket chain, found from the cached hash.
+		void erase( reference value ) noexcept
+		{
+			unlink( as_hook( value ) );
+		}
+
+		/// @brief Unlink the value at pos.
+		/// @return An iterator to the value after pos.
+		iterator erase( const const_iterator pos ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( pos != end(), "Cannot erase end of hash table" );
+			hook_type* const hook = pos.m_hook;
+			iterator next = make_iterator( hook );
+			++next;
+			unlink( *hook );
+			return next;
+		}
+
+		/// @brief Unlink every value, calling func with each after it is unlinked so it may be destroyed.
+		template <std::invocable<pointer> Func>
+			requires( std::is_nothrow_invocable_v<Func, pointer> )
+		void consume( Func func ) noexcept
+		{
+			for ( hook_type*& head : std::span( m_buckets, m_bucket_count ) )
+			{
+				hook_type* hook = std::exchange( head, nullptr );
+				while ( hook )
+				{
+					hook_type* const next = std::exchange( hook->m_next, nullptr );
+					func( static_cast<pointer>( hook ) );
+					hook = next;
+				}
+			}
+			m_size = 0;
+		}
+
+		void clear() noexcept
+		{
+			consume( []( pointer ) noexcept {} );
+		}
+
+		/// @brief Set the number of buckets, relinking every value using its cached hash.
+		/// @param count The minimum number of buckets, rounded up to a power of two and to at least size().
+		void rehash( const size_type count )
+		{
+			const size_type new_count = count || m_size ? std::bit_ceil( std::max( count, m_size ) ) : 0;
+			if ( new_count == m_bucket_count )
+			{
+				return;
+			}
+
+			hook_type** const new_buckets = new_count ? bucket_traits::allocate( m_allocator, new_count ) : nullptr;
+			std::uninitialized_fill_n( new_buckets, new_count, nullptr );
+			for ( size_type bucket = 0; bucket < m_bucket_count; ++bucket )
+			{
+				hook_type* hook = m_buckets[ bucket ];
+				while ( hook )
+				{
+					hook_type* const next = hook->m_next;
+					hook_type*& head = new_buckets[ hook->m_hash & ( new_count - 1 ) ];
+					hook->m_next = std::exchange( head, hook );
+					hook = next;
+				}
+			}
+
+			deallocate_buckets();
+			m_buckets = new_buckets;
+			m_bucket_count = new_count;
+		}
+
+		/// @brief Make sure count values can be inserted without the bucket array growing.
+		void reserve( const size_type count )
+		{
+			if ( count > m_bucket_count )
+			{
+				rehash( count );
+			}
+		}
+
+		void swap( intrusive_hash_table& other ) noexcept
+		{
+			using std::swap;
+			swap( m_hash, other.m_hash );
+			swap( m_equal, other.m_equal );
+			swap( m_get_key, other.m_get_key );
+			swap( m_allocator, other.m_allocator );
+			swap( m_buckets, other.m_buckets );
+			swap( m_bucket_count, other.m_bucket_count );
+			swap( m_size, other.m_size );
+		}
+
+		friend void swap( intrusive_hash_table& lhs, intrusive_hash_table& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+	private:
+		[[nodiscard]] static hook_type& as_hook( reference value ) noexcept
+		{
+			return static_cast<hook_type&>( value );
+		}
+
+		[[nodiscard]] static const_reference as_value( const hook_type& hook ) noexcept
+		{
+			return static_cast<const_reference>( hook );
+		}
+
+		[[nodiscard]] iterator make_iterator( hook_type* const hook ) noexcept
+		{
+			return iterator( m_buckets, m_bucket_count, hook );
+		}
+
+		[[nodiscard]] size_type bucket_index( const std::size_t hash ) const noexcept
+		{
+			return hash & ( m_bucket_count - 1 );
+		}
+
+		[[nodiscard]] hook_type* find_hook( const key_type& key, const std::size_t hash ) const noexcept
+		{
+			if ( m_bucket_count == 0 )
+			{
+				return nullptr;
+			}
+			for ( hook_type* hook = m_buckets[ bucket_index( hash ) ]; hook; hook = hook->m_next )
+			{
+				if ( hook->m_hash == hash && m_equal( m_get_key( as_value( *hook ) ), key ) )
+				{
+					return hook;
+				}
+			}
+			return nullptr;
+		}
+
+		[[nodiscard]] hook_type* first_hook() const noexcept
+		{
+			const auto it = std::find_if( m_buckets, m_buckets + m_bucket_count, []( hook_type* const head ) {
+				return head != nullptr;
+			} );
+			return it != m_buckets + m_bucket_count ? *it : nullptr;
+		}
+
+		void unlink( hook_type& hook ) noexcept
+		{
+			hook_type** link = &m_buckets[ bucket_index( hook.m_hash ) ];
+			while ( *link != &hook )
+			{
+				MCLO_DEBUG_ASSERT( *link, "Value is not in this hash table" );
+				link = &( *link )->m_next;
+			}
+			*link = std::exchange( hook.m_next, nullptr );
+			--m_size;
+		}
+
+		void deallocate_buckets() noexcept
+		{
+			if ( m_buckets )
+			{
+				bucket_traits::deallocate( m_allocator, m_buckets, m_bucket_count );
+				m_buckets = nullptr;
+			}
+		}
+
+		MCLO_NO_UNIQUE_ADDRESS hasher m_hash;
+		MCLO_NO_UNIQUE_ADDRESS key_equal m_equal;
+		MCLO_NO_UNIQUE_ADDRESS key_of m_get_key;
+		MCLO_NO_UNIQUE_ADDRESS bucket_allocator m_allocator;
+		hook_type** m_buckets = nullptr;
+		size_type m_bucket_count = 0;
+		size_type m_size = 0;
+	};
+}
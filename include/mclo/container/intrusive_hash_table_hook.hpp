@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mclo
+{
+	/// @brief Base class providing the bucket chain link for a value to be in an @ref intrusive_hash_table.
+	/// @details Also caches the value's hash so rehashing never rehashes keys and lookups only compare keys with
+	/// matching hashes. Copying a value does not copy its link, the copy starts unlinked.
+	/// @tparam Tag Distinguishes multiple hooks in the same type.
+	template <typename Tag = void>
+	class intrusive_hash_table_hook
+	{
+	public:
+		template <typename, typename, typename, typename, typename, typename>
+		friend class intrusive_hash_table;
+
+		template <typename, typename>
+		friend class intrusive_hash_table_iterator;
+
+		constexpr intrusive_hash_table_hook() noexcept = default;
+
+		constexpr intrusive_hash_table_hook( const intrusive_hash_table_hook& ) noexcept
+		{
+		}
+
+		constexpr intrusive_hash_table_hook& operator=( const intrusive_hash_table_hook& ) noexcept
+		{
+			return *this;
+		}
+
+	private:
+		intrusive_hash_table_hook* m_next = nullptr;
+		std::size_t m_hash = 0;
+	};
+}
@@ -0,0 +1,503 @@
+#pragma once
+
+#include "mclo/container/detail/intrusive_list_iterator.hpp"
+#include "mclo/container/intrusive_list_hook.hpp"
+#include "mclo/debug/assert.hpp"
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace mclo
+{
+	/// @brief A doubly linked list of values that hold their own links by deriving from @ref intrusive_list_hook.
+	/// @details The list never allocates or owns its values, it only links them, so values must outlive their time in
+	/// the list. Unlike @ref intrusive_forward_list any value can be unlinked in O(1) given only a reference to it, via
+	/// @ref iterator_to, making it suitable for LRU and timer lists.
+	///
+	/// The list is circular through a sentinel hook owned by the list, so inserting and erasing never branch on the
+	/// ends of the list.
+	/// @tparam T The type of values, must derive from @c intrusive_list_hook<Tag>.
+	/// @tparam Tag Selects which hook to use when T is in multiple lists.
+	template <typename T, typename Tag = void>
+	class intrusive_list
+	{
+		using hook_type = intrusive_list_hook<Tag>;
+		static_assert( std::derived_from<T, hook_type>, "T must be derived from the intrusive list hook" );
+
+		static_assert( std::is_object_v<T>,
+					   "The C++ Standard forbids containers of non-object types "
+					   "because of [container.requirements]." );
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using iterator = intrusive_list_iterator<T, Tag>;
+		using const_iterator = intrusive_list_iterator<const T, Tag>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		intrusive_list() noexcept
+		{
+			reset_sentinel();
+		}
+
+		intrusive_list( const intrusive_list& other ) = delete;
+		intrusive_list& operator=( const intrusive_list& other ) = delete;
+
+		intrusive_list( intrusive_list&& other ) noexcept
+			: intrusive_list()
+		{
+			take( other );
+		}
+		intrusive_list& operator=( intrusive_list&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				clear();
+				take( other );
+			}
+			return *this;
+		}
+
+		template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+		intrusive_list( It first, Sentinel last ) noexcept
+			: intrusive_list()
+		{
+			insert( end(), std::move( first ), std::move( last ) );
+		}
+
+		template <std::ranges::input_range Range>
+		intrusive_list( Range&& range ) noexcept
+			: intrusive_list()
+		{
+			insert( end(), std::forward<Range>( range ) );
+		}
+
+		~intrusive_list()
+		{
+			clear();
+		}
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator( m_sentinel.m_next );
+		}
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator( m_sentinel.m_next );
+		}
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator( &m_sentinel );
+		}
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator( &m_sentinel );
+		}
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		[[nodiscard]] reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator( end() );
+		}
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator( end() );
+		}
+		[[nodiscard]] const_reverse_iterator crbegin() const noexcept
+		{
+			return rbegin();
+		}
+
+		[[nodiscard]] reverse_iterator rend() noexcept
+		{
+			return reverse_iterator( begin() );
+		}
+		[[nodiscard]] const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator( begin() );
+		}
+		[[nodiscard]] const_reverse_iterator crend() const noexcept
+		{
+			return rend();
+		}
+
+		/// @brief Get an iterator to a value in this list, to erase or splice it in O(1).
+		/// @param value The value, must be in this list.
+		[[nodiscard]] iterator iterator_to( reference value ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( as_hook( value ).is_linked(), "Value is not in a list" );
+			return iterator( &as_hook( value ) );
+		}
+		[[nodiscard]] const_iterator iterator_to( const_reference value ) const noexcept
+		{
+			MCLO_DEBUG_ASSERT( as_hook( value ).is_linked(), "Value is not in a list" );
+			return const_iterator( &as_hook( value ) );
+		}
+
+		[[nodiscard]] reference front() noexcept
+		{
+			MCLO_DEBUG_ASSERT( !empty(), "Cannot access front of empty list" );
+			return *begin();
+		}
+		[[nodiscard]] const_reference front() const noexcept
+		{
+			MCLO_DEBUG_ASSERT( !empty(), "Cannot access front of empty list" );
+			return *begin();
+		}
+
+		[[nodiscard]] reference back() noexcept
+		{
+			MCLO_DEBUG_ASSERT( !empty(), "Cannot access back of empty list" );
+			return *std::prev( end() );
+		}
+		[[nodiscard]] const_reference back() const noexcept
+		{
+			MCLO_DEBUG_ASSERT( !empty(), "Cannot access back of empty list" );
+			return *std::prev( end() );
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_size;
+		}
+
+		void push_front( reference value ) noexcept
+		{
+			insert( begin(), value );
+		}
+
+		void push_back( reference value ) noexcept
+		{
+			insert( end(), value );
+		}
+
+		/// @brief Unlink the first value.
+		/// @return The unlinked value.
+		pointer pop_front() noexcept
+		{
+			MCLO_DEBUG_ASSERT( !empty(), "Cannot pop front of empty list" );
+			const pointer value = std::addressof( front() );
+			erase( begin() );
+			return value;
+		}
+
+		/// @brief Unlink the last value.
+		/// @return The unlinked value.
+		pointer pop_back() noexcept
+		{
+			MCLO_DEBUG_ASSERT( !empty(), "Cannot pop back of empty list" );
+			const pointer value = std::addressof( back() );
+			erase( std::prev( end() ) );
+			return value;
+		}
+
+		/// @brief Link value before pos.
+		/// @param pos The position to insert before.
+		/// @param value The value to link, must not already be in a list using this hook.
+		/// @return An iterator to value.
+		iterator insert( const const_iterator pos, reference value ) noexcept
+		{
+			hook_type& hook = as_hook( value );
+			MCLO_DEBUG_ASSERT( !hook.is_linked(), "Value is already in a list" );
+			link_before( unwrap_iterator( pos ), hook );
+			++m_size;
+			return iterator( &hook );
+		}
+
+		template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+			requires( std::same_as<reference, std::iter_reference_t<It>> )
+		iterator insert( const const_iterator pos, It first, Sentinel last ) noexcept
+		{
+			hook_type* const next = unwrap_iterator( pos );
+			hook_type* prev = next->m_prev;
+			for ( ; first != last; ++first )
+			{
+				hook_type& hook = as_hook( *first );
+				MCLO_DEBUG_ASSERT( !hook.is_linked(), "Value is already in a list" );
+				hook.m_prev = prev;
+				prev->m_next = &hook;
+				prev = &hook;
+				++m_size;
+			}
+			iterator result( next->m_prev->m_next );
+			prev->m_next = next;
+			next->m_prev = prev;
+			return result;
+		}
+
+		template <std::ranges::input_range Range>
+			requires( std::same_as<reference, std::ranges::range_reference_t<Range>> )
+		iterator insert( const const_iterator pos, Range&& range ) noexcept
+		{
+			return insert( pos, std::ranges::begin( range ), std::ranges::end( range ) );
+		}
+
+		/// @brief Unlink the value at pos.
+		/// @return An iterator to the value after pos.
+		iterator erase( const const_iterator pos ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( pos != end(), "Cannot erase end of list" );
+			hook_type* const hook = unwrap_iterator( pos );
+			hook_type* const next = hook->m_next;
+			unlink( *hook );
+			--m_size;
+			return iterator( next );
+		}
+
+		iterator erase( const_iterator first, const const_iterator last ) noexcept
+		{
+			while ( first != last )
+			{
+				first = erase( first );
+			}
+			return iterator( unwrap_iterator( last ) );
+		}
+
+		/// @brief Unlink value, which must be in this list.
+		void erase( reference value ) noexcept
+		{
+			erase( iterator_to( value ) );
+		}
+
+		/// @brief Move all values of other before pos.
+		void splice( const const_iterator pos, intrusive_list& other ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( this != &other, "Cannot splice in same container" );
+			splice( pos, other, other.begin(), other.end() );
+		}
+
+		void splice( const const_iterator pos, intrusive_list&& other ) noexcept
+		{
+			splice( pos, other );
+		}
+
+		/// @brief Move the value at it from other to before pos, other may be this list.
+		void splice( const const_iterator pos, intrusive_list& other, const const_iterator it ) noexcept
+		{
+			hook_type* const next = unwrap_iterator( pos );
+			hook_type* const hook = unwrap_iterator( it );
+			if ( hook == next || hook->m_next == next )
+			{
+				return;
+			}
+			unlink( *hook );
+			link_before( next, *hook );
+			--other.m_size;
+			++m_size;
+		}
+
+		void splice( const const_iterator pos, intrusive_list&& other, const const_iterator it ) noexcept
+		{
+			splice( pos, other, it );
+		}
+
+		/// @brief Move the values in [first, last) from other to before pos, other may be this list if pos is not in
+		/// the range.
+		void splice( const const_iterator pos,
+					 intrusive_list& other,
+					 const const_iterator first,
+					 const const_iterator last ) noexcept
+		{
+			if ( first == last )
+			{
+				return;
+			}
+
+			if ( this != &other )
+			{
+				const size_type count = static_cast<size_type>( std::distance( first, last ) );
+				other.m_size -= count;
+				m_size += count;
+			}
+
+			hook_type* const next = unwrap_iterator( pos );
+			hook_type* const range_first = unwrap_iterator( first );
+			hook_type* const range_last = unwrap_iterator( last )->m_prev;
+
+			// Detach the range
+			range_first->m_prev->m_next = range_last->m_next;
+			range_last->m_next->m_prev = range_first->m_prev;
+
+			// Attach it before next
+			range_first->m_prev = next->m_prev;
+			next->m_prev->m_next = range_first;
+			range_last->m_next = next;
+			next->m_prev = range_last;
+		}
+
+		void splice( const const_iterator pos,
+					 intrusive_list&& other,
+					 const const_iterator first,
+					 const const_iterator last ) noexcept
+		{
+			splice( pos, other, first, last );
+		}
+
+		template <typename U>
+		size_type remove( const U& value )
+		{
+			return remove_if( [ &value ]( const_reference object ) { return object == value; } );
+		}
+
+		template <typename UnaryPredicate>
+		size_type remove_if( UnaryPredicate predicate )
+		{
+			size_type count = 0;
+			for ( iterator it = begin(); it != end(); )
+			{
+				if ( predicate( std::as_const( *it ) ) )
+				{
+					it = erase( it );
+					++count;
+				}
+				else
+				{
+					++it;
+				}
+			}
+			return count;
+		}
+
+		void reverse() noexcept
+		{
+			hook_type* hook = &m_sentinel;
+			do
+			{
+				std::swap( hook->m_prev, hook->m_next );
+				hook = hook->m_prev;
+			}
+			while ( hook != &m_sentinel );
+		}
+
+		/// @brief Unlink every value, calling func with each after it is unlinked so it may be destroyed.
+		template <std::invocable<pointer> Func>
+			requires( std::is_nothrow_invocable_v<Func, pointer> )
+		void consume( Func func ) noexcept
+		{
+			hook_type* hook = m_sentinel.m_next;
+			reset_sentinel();
+			m_size = 0;
+			while ( hook != &m_sentinel )
+			{
+				hook_type* const next = hook->m_next;
+				hook->m_prev = nullptr;
+				hook->m_next = nullptr;
+				func( static_cast<pointer>( hook ) );
+				hook = next;
+			}
+		}
+
+		void clear() noexcept
+		{
+			consume( []( pointer ) noexcept {} );
+		}
+
+		void swap( intrusive_list& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				intrusive_list temp( std::move( other ) );
+				other.take( *this );
+				take( temp );
+			}
+		}
+
+		friend void swap( intrusive_list& lhs, intrusive_list& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+	private:
+		[[nodiscard]] static hook_type& as_hook( reference value ) noexcept
+		{
+			return static_cast<hook_type&>( value );
+		}
+		[[nodiscard]] static const hook_type& as_hook( const_reference value ) noexcept
+		{
+			return static_cast<const hook_type&>( value );
+		}
+
+		[[nodiscard]] static hook_type* unwrap_iterator( const const_iterator it ) noexcept
+		{
+			return const_cast<hook_type*>( it.m_hook );
+		}
+
+		static void link_before( hook_type* const next, hook_type& hook ) noexcept
+		{
+			hook.m_next = next;
+			hook.m_prev = next->m_prev;
+			next->m_prev->m_next = &hook;
+			next->m_prev = &hook;
+		}
+
+		static void unlink( hook_type& hook ) noexcept
+		{
+			hook.m_prev->m_next = hook.m_next;
+			hook.m_next->m_prev = hook.m_prev;
+			hook.m_prev = nullptr;
+			hook.m_next = nullptr;
+		}
+
+		void reset_sentinel() noexcept
+		{
+			m_sentinel.m_prev = &m_sentinel;
+			m_sentinel.m_next = &m_sentinel;
+		}
+
+		/// @brief Take the values of other, this list must be empty
+		void take( intrusive_list& other ) noexcept
+		{
+			if ( other.empty() )
+			{
+				return;
+			}
+			m_sentinel.m_next = other.m_sentinel.m_next;
+			m_sentinel.m_prev = other.m_sentinel.m_prev;
+			m_sentinel.m_next->m_prev = &m_sentinel;
+			m_sentinel.m_prev->m_next = &m_sentinel;
+			m_size = std::exchange( other.m_size, 0 );
+			other.reset_sentinel();
+		}
+
+		hook_type m_sentinel;
+		size_type m_size = 0;
+	};
+}
+
+namespace std
+{
+	template <typename T, typename Tag, typename U = T>
+	typename mclo::intrusive_list<T, Tag>::size_type erase( mclo::intrusive_list<T, Tag>& list, const U& value )
+	{
+		return list.remove( value );
+	}
+
+	template <typename T, typename Tag, typename Pred>
+	typename mclo::intrusive_list<T, Tag>::size_type erase_if( mclo::intrusive_list<T, Tag>& list, Pred pred )
+	{
+		return list.remove_if( pred );
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+namespace mclo
+{
+	/// @brief Base class providing the links for a value to be in an @ref intrusive_list.
+	/// @details Derive from one hook per list the value can be in at the same time, each with a different Tag. Copying
+	/// a value does not copy its links, the copy starts unlinked.
+	/// @tparam Tag Distinguishes multiple hooks in the same type.
+	template <typename Tag = void>
+	class intrusive_list_hook
+	{
+	public:
+		template <typename, typename>
+		friend class intrusive_list;
+
+		template <typename, typename>
+		friend class intrusive_list_iterator;
+
+		constexpr intrusive_list_hook() noexcept = default;
+
+		constexpr intrusive_list_hook( const intrusive_list_hook& ) noexcept
+		{
+		}
+
+		constexpr intrusive_list_hook& operator=( const intrusive_list_hook& ) noexcept
+		{
+			return *this;
+		}
+
+		/// @brief Check if the value is currently in a list.
+		[[nodiscard]] constexpr bool is_linked() const noexcept
+		{
+			return m_next != nullptr;
+		}
+
+	private:
+		intrusive_list_hook* m_prev = nullptr;
+		intrusive_list_hook* m_next = nullptr;
+	};
+}
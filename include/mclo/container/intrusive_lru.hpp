@@ -0,0 +1,244 @@
+#pragma once
+
+#include "mclo/container/intrusive_hash_table.hpp"
+#include "mclo/container/intrusive_list.hpp"
+#include "mclo/debug/assert.hpp"
+
+#include <concepts>
+#include <memory>
+#include <utility>
+
+namespace mclo
+{
+	/// @brief A fixed capacity least recently used cache of values that hold their own links.
+	/// @details Values derive from both @c intrusive_list_hook<Tag> for the recency order and
+	/// @c intrusive_hash_table_hook<Tag> for lookup by key. The bucket array is sized for the capacity at construction,
+	/// after which nothing allocates; inserting into a full cache unlinks and hands back the least recently used value
+	/// so its storage can be reused for the next entry, such as from a fixed pool of nodes.
+	///
+	/// Iteration is from most to least recently used.
+	/// @tparam T The type of values.
+	/// @tparam KeyOf Function object returning the key of a value.
+	/// @tparam Hash Function object hashing keys.
+	/// @tparam KeyEqual Function object comparing keys for equality.
+	/// @tparam Tag Selects which hooks to use when T is in multiple containers.
+	/// @tparam Allocator Allocator for the bucket array.
+	template <typename T,
+			  typename KeyOf = std::identity,
+			  typename Hash = mclo::hash<detail::intrusive_key_t<T, KeyOf>>,
+			  typename KeyEqual = std::equal_to<>,
+			  typename Tag = void,
+			  typename Allocator = std::allocator<T>>
+	class intrusive_lru
+	{
+		using list_type = intrusive_list<T, Tag>;
+		using table_type = intrusive_hash_table<T, KeyOf, Hash, KeyEqual, Tag, Allocator>;
+
+	public:
+		using key_type = typename table_type::key_type;
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using key_of = KeyOf;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using allocator_type = Allocator;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using iterator = typename list_type::iterator;
+		using const_iterator = typename list_type::const_iterator;
+
+		/// @brief Construct an empty cache.
+		/// @param capacity The number of values the cache holds before inserting evicts, must be greater than zero.
+		explicit intrusive_lru( const size_type capacity,
+								const hasher& hash = hasher(),
+								const key_equal& equal = key_equal(),
+								const key_of& get_key = key_of(),
+								const allocator_type& alloc = allocator_type() )
+			: m_table( capacity, hash, equal, get_key, alloc )
+			, m_capacity( capacity )
+		{
+			MCLO_DEBUG_ASSERT( capacity > 0, "LRU capacity must be greater than zero" );
+		}
+
+		intrusive_lru( intrusive_lru&& other ) noexcept = default;
+		intrusive_lru& operator=( intrusive_lru&& other ) noexcept = default;
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return m_list.begin();
+		}
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return m_list.begin();
+		}
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return m_list.cbegin();
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return m_list.end();
+		}
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return m_list.end();
+		}
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return m_list.cend();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_list.empty();
+		}
+
+		[[nodiscard]] bool full() const noexcept
+		{
+			return size() == m_capacity;
+		}
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_list.size();
+		}
+
+		[[nodiscard]] size_type capacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		/// @brief Get the most recently used value, the cache must not be empty.
+		[[nodiscard]] reference most_recent() noexcept
+		{
+			return m_list.front();
+		}
+		[[nodiscard]] const_reference most_recent() const noexcept
+		{
+			return m_list.front();
+		}
+
+		/// @brief Get the least recently used value, the next to be evicted, the cache must not be empty.
+		[[nodiscard]] reference least_recent() noexcept
+		{
+			return m_list.back();
+		}
+		[[nodiscard]] const_reference least_recent() const noexcept
+		{
+			return m_list.back();
+		}
+
+		/// @brief Find the value with an equal key and mark it as the most recently used.
+		/// @return The value, or nullptr if no value had an equal key.
+		[[nodiscard]] pointer find( const key_type& key )
+		{
+			const auto it = m_table.find( key );
+			if ( it == m_table.end() )
+			{
+				return nullptr;
+			}
+			touch( *it );
+			return std::addressof( *it );
+		}
+
+		/// @brief Find the value with an equal key without changing how recently it was used.
+		/// @return The value, or nullptr if no value had an equal key.
+		[[nodiscard]] const_pointer peek( const key_type& key ) const
+		{
+			const auto it = m_table.find( key );
+			return it != m_table.end() ? std::addressof( *it ) : nullptr;
+		}
+
+		[[nodiscard]] bool contains( const key_type& key ) const
+		{
+			return m_table.contains( key );
+		}
+
+		/// @brief Link value in as the most recently used, evicting the least recently used value if the cache is full.
+		/// @param value The value to link, no value with an equal key may be in the cache.
+		/// @return The evicted value, or nullptr if the cache was not full.
+		[[nodiscard]] pointer insert( reference value )
+		{
+			const pointer evicted = full() ? pop_least_recent() : nullptr;
+			[[maybe_unused]] const bool inserted = m_table.insert( value ).second;
+			MCLO_DEBUG_ASSERT( inserted, "Value with an equal key is already in the LRU" );
+			m_list.push_front( value );
+			return evicted;
+		}
+
+		/// @brief Mark value, which must be in the cache, as the most recently used.
+		void touch( reference value ) noexcept
+		{
+			m_list.splice( m_list.begin(), m_list, m_list.iterator_to( value ) );
+		}
+
+		/// @brief Unlink value, which must be in the cache.
+		void erase( reference value ) noexcept
+		{
+			m_table.erase( value );
+			m_list.erase( value );
+		}
+
+		/// @brief Unlink the value with an equal key.
+		/// @return The unlinked value, or nullptr if no value had an equal key.
+		pointer erase( const key_type& key )
+		{
+			const pointer value = m_table.erase( key );
+			if ( value )
+			{
+				m_list.erase( *value );
+			}
+			return value;
+		}
+
+		/// @brief Unlink the least recently used value.
+		/// @return The unlinked value, or nullptr if the cache was empty.
+		pointer pop_least_recent() noexcept
+		{
+			if ( empty() )
+			{
+				return nullptr;
+			}
+			const pointer value = m_list.pop_back();
+			m_table.erase( *value );
+			return value;
+		}
+
+		/// @brief Unlink every value, calling func with each after it is unlinked so it may be destroyed.
+		template <std::invocable<pointer> Func>
+			requires( std::is_nothrow_invocable_v<Func, pointer> )
+		void consume( Func func ) noexcept
+		{
+			m_table.clear();
+			m_list.consume( std::move( func ) );
+		}
+
+		void clear() noexcept
+		{
+			m_table.clear();
+			m_list.clear();
+		}
+
+		void swap( intrusive_lru& other ) noexcept
+		{
+			using std::swap;
+			m_list.swap( other.m_list );
+			m_table.swap( other.m_table );
+			swap( m_capacity, other.m_capacity );
+		}
+
+		friend void swap( intrusive_lru& lhs, intrusive_lru& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+	private:
+		list_type m_list;
+		table_type m_table;
+		size_type m_capacity = 0;
+	};
+}
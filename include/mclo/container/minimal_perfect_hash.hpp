@@ -0,0 +1,226 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/memory/prefetch.hpp"
+#include "mclo/numeric/128_bit_integer.hpp"
+#include "mclo/random/seed_mixing.hpp"
+
+#include <cinttypes>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief Options controlling how a minimal_perfect_hash is built
+	struct mph_build_options
+	{
+		/// @brief Number of threads to build with, 0 uses every hardware thread
+		/// @details The built function does not depend on the thread count.
+		std::size_t num_threads = 1;
+
+		/// @brief Keys are split into independently built partitions of around this many keys
+		/// @details Larger partitions use slightly fewer bits per key, smaller ones give more parallelism.
+		std::size_t partition_size = std::size_t{ 1 } << 16;
+
+		/// @brief Fraction of each partition's table filled by keys, the rest of the slots give the search slack
+		/// @details Keys landing past the end of the keys are remapped into the holes left behind. Lower is faster to
+		/// build and gives smaller pilots but needs a larger remap table.
+		double load_factor = 0.99;
+
+		/// @brief Scales the number of buckets per key, higher is faster to build but uses more bits per key
+		double bucket_density = 5.0;
+	};
+
+	/// @brief A minimal perfect hash function over a fixed set of 64 bit key hashes built at runtime
+	/// @details Maps each of the N hashes it was built from to a unique index in [0, N), any other hash maps to some
+	/// index in that range so callers must verify the key found at the index.
+	///
+	/// Built using pilot search in the style of PTHash. Keys are split into partitions that are built independently
+	/// and in parallel. Within a partition keys are hashed into buckets, skewed so 60% of keys land in 30% of the
+	/// buckets, and buckets are placed largest first by searching for the smallest pilot value that moves all of the
+	/// bucket's keys into free slots. Pilots are bit packed to the width of the largest one, only a few bits per key.
+	///
+	/// Lookup is a mix, one bit packed pilot read and a multiply, with a rare extra read for remapped slots.
+	///
+	/// All of the state is a single array of 64 bit words in native endianness, serialize writes it as is and view
+	/// reads it in place so a serialized function can be memory mapped and used without loading it.
+	class minimal_perfect_hash
+	{
+	public:
+		/// @brief Construct an empty function with no keys
+		minimal_perfect_hash() = default;
+
+		/// @brief Build a minimal perfect hash over a set of key hashes
+		/// @param hashes Hashes of the keys, must be unique
+		/// @param seed Seed the hashes were made with, stored so lookups can hash with the same seed
+		/// @param options Options to build with
+		/// @return The function or std::nullopt if hashes contains duplicates or a pilot could not be found, retry
+		/// with hashes made from a different seed
+		[[nodiscard]] static std::optional<minimal_perfect_hash> build( mclo::span<const std::uint64_t> hashes,
+																		 std::uint64_t seed,
+																		 const mph_build_options& options = {} );
+
+		/// @brief Get the index for a key hash
+		/// @warning The function must not be empty, there is no index to return
+		/// @param hash Hash of the key, made with seed()
+		/// @return Unique index in [0, size()) if hash is one of the built hashes, else an arbitrary index in range
+		[[nodiscard]] std::size_t operator()( const std::uint64_t hash ) const noexcept
+		{
+			const std::uint64_t mixed = mclo::avalanche_bits( hash );
+			const std::uint64_t partition = mul_high( mixed, m_num_partitions );
+			const std::uint64_t pilot = read_pilot( bucket_of( mixed, partition ) );
+			const std::uint64_t* const meta = m_partitions + partition * partition_words;
+			const std::uint64_t first_key = meta[ 0 ];
+			const std::uint64_t num_keys = meta[ 1 ] & num_keys_mask;
+			const std::uint64_t table_size = meta[ 1 ] >> 32;
+
+			const std::uint64_t slot = position( hash, pilot, table_size );
+			if ( slot < num_keys ) [[likely]]
+			{
+				return static_cast<std::size_t>( first_key + slot );
+			}
+			return static_cast<std::size_t>( first_key + read_remap( meta[ 2 ] + slot - num_keys ) );
+		}
+
+		/// @brief Prefetch the state operator() reads for a hash
+		/// @details Batched lookups prefetch a group of hashes before evaluating any so the pilot reads, the cache miss
+		/// in a large function, overlap.
+		/// @param hash Hash of the key, made with seed()
+		void prefetch( const std::uint64_t hash ) const noexcept
+		{
+			const std::uint64_t mixed = mclo::avalanche_bits( hash );
+			const std::uint64_t partition = mul_high( mixed, m_num_partitions );
+			mclo::prefetch( m_pilots + bucket_of( mixed, partition ) * m_pilot_width / 64 );
+			mclo::prefetch( m_partitions + partition * partition_words );
+		}
+
+		/// @brief Get the number of keys the function was built over
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return static_cast<std::size_t>( m_num_keys );
+		}
+
+		/// @brief Is the function built over no keys
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_num_keys == 0;
+		}
+
+		/// @brief Get the seed the key hashes must be made with
+		[[nodiscard]] std::uint64_t seed() const noexcept
+		{
+			return m_seed;
+		}
+
+		/// @brief Get the average number of bits of state per key
+		[[nodiscard]] double bits_per_key() const noexcept;
+
+		/// @brief Get the number of bytes serialize will write
+		[[nodiscard]] std::size_t serialized_size() const noexcept;
+
+		/// @brief Serialize the function
+		/// @param out Buffer to write into, must be at least serialized_size() bytes
+		/// @return Number of bytes written
+		std::size_t serialize( mclo::span<std::byte> out ) const noexcept;
+
+		/// @brief Serialize the function
+		/// @return Buffer holding the serialized bytes
+		[[nodiscard]] std::vector<std::byte> serialize() const;
+
+		/// @brief Deserialize a function, copying it out of data
+		/// @param data Bytes to read from, trailing bytes after the function are ignored
+		/// @return The function or std::nullopt if data is not a valid serialized function
+		[[nodiscard]] static std::optional<minimal_perfect_hash> deserialize( mclo::span<const std::byte> data );
+
+		/// @brief Use a serialized function in place without copying it, such as from a memory mapped file
+		/// @warning data must outlive the returned function and all copies of it
+		/// @param data Bytes to read from, must be aligned to 8 bytes, trailing bytes after the function are ignored
+		/// @return The function or std::nullopt if data is not a valid serialized function or is misaligned
+		[[nodiscard]] static std::optional<minimal_perfect_hash> view( mclo::span<const std::byte> data );
+
+		minimal_perfect_hash( const minimal_perfect_hash& other );
+		minimal_perfect_hash( minimal_perfect_hash&& other ) noexcept;
+		minimal_perfect_hash& operator=( const minimal_perfect_hash& other );
+		minimal_perfect_hash& operator=( minimal_perfect_hash&& other ) noexcept;
+		~minimal_perfect_hash() = default;
+
+	private:
+		// 60% of keys are hashed into the first 30% of buckets, the dense buckets are placed first while the table is
+		// empty so their larger size is cheap to place and the sparse ones fill in the rest
+		static constexpr std::uint64_t dense_bucket_threshold = UINT64_C( 0x9999999999999999 );
+		static constexpr std::size_t partition_words = 3;
+		static constexpr std::uint64_t num_keys_mask = UINT64_C( 0xffffffff );
+
+		friend class mph_builder;
+
+		[[nodiscard]] static std::uint64_t mul_high( const std::uint64_t lhs, const std::uint64_t rhs ) noexcept
+		{
+			return static_cast<std::uint64_t>( ( static_cast<mclo::uint128_t>( lhs ) * rhs ) >> 64 );
+		}
+
+		[[nodiscard]] static std::uint64_t position( const std::uint64_t hash,
+													 const std::uint64_t pilot,
+													 const std::uint64_t table_size ) noexcept
+		{
+			// Spreading the pilot with a multiply is enough to try a different slot per pilot and is cheaper than a
+			// full mix, the second multiply makes every bit of the xor affect the high bits used to pick the slot
+			const std::uint64_t spread_pilot = pilot * UINT64_C( 0xc2b2ae3d27d4eb4f );
+			return mul_high( ( hash ^ spread_pilot ) * UINT64_C( 0x9e3779b97f4a7c15 ), table_size );
+		}
+
+		/// @brief Get the index of the bucket a mixed hash falls in, across all partitions
+		[[nodiscard]] std::uint64_t bucket_of( const std::uint64_t mixed, const std::uint64_t partition ) const noexcept
+		{
+			// Low bits of the partition multiply are uniform within the partition so select the bucket
+			// Dense or sparse is a coin flip so compute both and select rather than mispredict a branch
+			const std::uint64_t in_partition = mixed * m_num_partitions;
+			const std::uint64_t dense_bucket = mul_high( in_partition, m_dense_multiplier );
+			const std::uint64_t sparse_bucket =
+				m_dense_buckets + mul_high( in_partition - dense_bucket_threshold, m_sparse_multiplier );
+			const std::uint64_t bucket = in_partition < dense_bucket_threshold ? dense_bucket : sparse_bucket;
+			return partition * m_buckets_per_partition + bucket;
+		}
+
+		[[nodiscard]] std::uint64_t read_pilot( const std::uint64_t index ) const noexcept
+		{
+			// The pilot array has a padding word so the next word is always safe to read
+			const std::uint64_t bit = index * m_pilot_width;
+			const std::uint64_t* const words = m_pilots + bit / 64;
+			const unsigned shift = static_cast<unsigned>( bit % 64 );
+			const std::uint64_t value = ( words[ 0 ] >> shift ) | ( ( words[ 1 ] << 1 ) << ( 63 - shift ) );
+			return value & m_pilot_mask;
+		}
+
+		[[nodiscard]] std::uint64_t read_remap( const std::uint64_t index ) const noexcept
+		{
+			return ( m_remap[ index / 2 ] >> ( ( index % 2 ) * 32 ) ) & num_keys_mask;
+		}
+
+		/// @brief Words of a function built over no keys, used to serialize a default constructed function
+		[[nodiscard]] static mclo::span<const std::uint64_t> empty_words() noexcept;
+
+		[[nodiscard]] static std::optional<minimal_perfect_hash> from_words( mclo::span<const std::uint64_t> words );
+		void bind_words( mclo::span<const std::uint64_t> words ) noexcept;
+
+		/// @brief Serialized state when owned, empty when viewing external data
+		std::vector<std::uint64_t> m_words;
+
+		/// @brief The serialized state in use, either m_words or the viewed data
+		mclo::span<const std::uint64_t> m_data;
+
+		// Header values and array pointers decoded from m_data
+		std::uint64_t m_num_keys = 0;
+		std::uint64_t m_seed = 0;
+		std::uint64_t m_num_partitions = 0;
+		std::uint64_t m_buckets_per_partition = 0;
+		std::uint64_t m_dense_buckets = 0;
+		std::uint64_t m_dense_multiplier = 0;
+		std::uint64_t m_sparse_multiplier = 0;
+		std::uint64_t m_pilot_width = 0;
+		std::uint64_t m_pilot_mask = 0;
+		const std::uint64_t* m_partitions = nullptr;
+		const std::uint64_t* m_pilots = nullptr;
+		const std::uint64_t* m_remap = nullptr;
+	};
+}
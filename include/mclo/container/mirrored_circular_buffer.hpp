@@ -0,0 +1,211 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/memory/mirrored_memory.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+namespace mclo
+{
+	/// @brief A fixed capacity ring of trivially copyable values where every window of values is contiguous.
+	/// @details The storage is @ref mirrored_memory, the same pages mapped twice back to back, so a run of values that
+	/// wraps past the end of the ring continues straight on into the mirror. @ref peek and @ref write_window always
+	/// return a single span, letting stream data be parsed or read() in place with no special case or copy at the wrap
+	/// point, unlike @ref circular_buffer which hands out two segments.
+	///
+	/// Values are written by filling @ref write_window and publishing with @ref commit_write, and read with @ref peek
+	/// and released with @ref commit_read. A full ring rejects writes instead of overwriting.
+	/// @tparam T The type of values, must be trivially copyable as they are only ever copied as bytes.
+	template <typename T>
+	class mirrored_circular_buffer
+	{
+		static_assert( std::is_trivially_copyable_v<T>, "T must be trivially copyable" );
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+		/// @brief Constructs an empty ring with no capacity.
+		mirrored_circular_buffer() noexcept = default;
+
+		/// @brief Constructs an empty ring.
+		/// @param min_capacity The minimum number of values the ring can hold, rounded up to fill whole pages.
+		/// @throws std::system_error if the memory could not be mapped.
+		explicit mirrored_circular_buffer( const size_type min_capacity )
+			: m_memory( bytes_for( min_capacity ) )
+			, m_capacity( m_memory.size() / sizeof( value_type ) )
+		{
+		}
+
+		mirrored_circular_buffer( mirrored_circular_buffer&& other ) noexcept
+			: m_memory( std::move( other.m_memory ) )
+			, m_capacity( std::exchange( other.m_capacity, 0 ) )
+			, m_head( std::exchange( other.m_head, 0 ) )
+			, m_size( std::exchange( other.m_size, 0 ) )
+		{
+		}
+
+		mirrored_circular_buffer& operator=( mirrored_circular_buffer&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				m_memory = std::move( other.m_memory );
+				m_capacity = std::exchange( other.m_capacity, 0 );
+				m_head = std::exchange( other.m_head, 0 );
+				m_size = std::exchange( other.m_size, 0 );
+			}
+			return *this;
+		}
+
+		~mirrored_circular_buffer() = default;
+
+		// Size and capacity
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_size;
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		[[nodiscard]] bool full() const noexcept
+		{
+			return m_size == m_capacity;
+		}
+
+		[[nodiscard]] size_type capacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		/// @brief Get the number of values that can be written before the ring is full.
+		[[nodiscard]] size_type writable_size() const noexcept
+		{
+			return m_capacity - m_size;
+		}
+
+		// Reading
+
+		/// @brief View the first count values without popping them.
+		/// @param count The number of values to view, must be at most size().
+		/// @return The values, contiguous even if they wrap around the end of the ring.
+		[[nodiscard]] span<const value_type> peek( const size_type count ) const noexcept
+		{
+			MCLO_DEBUG_ASSERT( count <= m_size, "Peeking more values than are in the ring" );
+			return { values() + m_head, count };
+		}
+
+		/// @brief View every value without popping them.
+		[[nodiscard]] span<const value_type> peek() const noexcept
+		{
+			return peek( m_size );
+		}
+
+		/// @brief Pop values from the front of the ring, such as after parsing them with @ref peek.
+		/// @param count The number of values to pop, must be at most size().
+		void commit_read( const size_type count ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( count <= m_size, "Popping more values than are in the ring" );
+			m_head += count;
+			if ( m_head >= m_capacity )
+			{
+				m_head -= m_capacity;
+			}
+			m_size -= count;
+		}
+
+		/// @brief Copy values from the front of the ring into out and pop them.
+		/// @param out Where to copy the values to, at most out.size() values are popped.
+		/// @return The number of values popped, the smaller of size() and out.size().
+		size_type pop_front_n( const span<value_type> out ) noexcept
+		{
+			const size_type count = std::min( m_size, out.size() );
+			if ( count != 0 )
+			{
+				std::memcpy( out.data(), values() + m_head, count * sizeof( value_type ) );
+				commit_read( count );
+			}
+			return count;
+		}
+
+		// Writing
+
+		/// @brief Get free space after the last value to write values into in place.
+		/// @details Publish written values with @ref commit_write.
+		/// @param count The number of values to make space for, must be at most writable_size().
+		/// @return The free space, contiguous even if it wraps around the end of the ring.
+		[[nodiscard]] span<value_type> write_window( const size_type count ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( count <= writable_size(), "Writing more values than there is space for" );
+			// The tail may be in the mirror but the window always ends before the end of the mirror
+			return { values() + m_head + m_size, count };
+		}
+
+		/// @brief Get all of the free space after the last value to write values into in place.
+		[[nodiscard]] span<value_type> write_window() noexcept
+		{
+			return write_window( writable_size() );
+		}
+
+		/// @brief Publish values written in place at the start of @ref write_window.
+		/// @param count The number of values written, must be at most writable_size().
+		void commit_write( const size_type count ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( count <= writable_size(), "Committing more values than there is space for" );
+			m_size += count;
+		}
+
+		/// @brief Copy as many values as there is space for onto the back of the ring.
+		/// @param in The values to push, pushed in order from the front.
+		/// @return The number of values pushed.
+		size_type push_back_n( const span<const value_type> in ) noexcept
+		{
+			const size_type count = std::min( writable_size(), in.size() );
+			if ( count != 0 )
+			{
+				std::memcpy( write_window( count ).data(), in.data(), count * sizeof( value_type ) );
+				commit_write( count );
+			}
+			return count;
+		}
+
+		void clear() noexcept
+		{
+			m_head = 0;
+			m_size = 0;
+		}
+
+	private:
+		/// @brief Round up to whole pages that also hold a whole number of values, so the mirror starts on a value
+		[[nodiscard]] static size_type bytes_for( const size_type min_capacity ) noexcept
+		{
+			const size_type unit = std::lcm( mirrored_memory::granularity(), sizeof( value_type ) );
+			const size_type min_bytes = std::max<size_type>( min_capacity, 1 ) * sizeof( value_type );
+			return ( min_bytes + unit - 1 ) / unit * unit;
+		}
+
+		[[nodiscard]] pointer values() const noexcept
+		{
+			return reinterpret_cast<pointer>( m_memory.data() );
+		}
+
+		mirrored_memory m_memory;
+		size_type m_capacity = 0;
+		size_type m_head = 0;
+		size_type m_size = 0;
+	};
+}
@@ -19,11 +19,10 @@ namespace mclo
 
 	/// @brief A fixed-size, immutable map built on a minimal perfect hash, ideal for compile-time constant tables.
 	/// @details Stores a fixed set of @p Size key/value pairs known at construction and supports collision-free lookup
-	/// in at most two hashes and one comparison. The whole map can be a @c constexpr value. See @ref detail::mph_base
+	/// in one hash and at most one comparison. The whole map can be a @c constexpr value. See @ref detail::mph_base
 	/// for the underlying lookup mechanism and @ref mph_hash for customising the key hash.
-	/// @warning Building the perfect hash is a fairly heavy compile-time computation (repeatedly searching for salts).
-	/// It is constant-evaluation capable but can noticeably hurt compile times if used for many or large tables, so
-	/// use it judiciously.
+	/// @warning Building the perfect hash at compile time costs roughly linear constant evaluation in @p Size, tables
+	/// of thousands of keys fit the default limits but many large tables still add noticeably to compile times.
 	/// @tparam Key The key type.
 	/// @tparam Value The mapped value type.
 	/// @tparam Size The exact number of key/value pairs.
@@ -50,9 +49,23 @@ namespace mclo
 		/// @return An iterator to the matching key/value pair, or @c end() if @p key is not present.
 		[[nodiscard]] constexpr typename base::iterator find( const typename base::key_type& key )
 		{
-			const std::size_t data_index = base::find_data_index( key );
-			const auto it = base::begin() + data_index;
-			return base::equals( base::get_key( *it ), key ) ? it : base::end();
+			return base::begin() + base::find_slot( key );
+		}
+
+		using base::find_many;
+
+		/// @brief Finds the elements for a batch of keys, see @ref detail::mph_base::find_many.
+		/// @param keys The keys to look up.
+		/// @param out Span to write an iterator to each matching key/value pair to, or @c end() if the key is not
+		/// present, must be the same size as keys.
+		/// @return The number of keys present.
+		constexpr typename base::size_type find_many( const mclo::span<const typename base::key_type> keys,
+													  const mclo::span<typename base::iterator> out )
+		{
+			MCLO_DEBUG_ASSERT( keys.size() == out.size(), "Output must be the same size as keys" );
+			return base::find_slots( keys, [ & ]( const std::size_t position, const typename base::size_type slot ) {
+				out[ position ] = base::begin() + slot;
+			} );
 		}
 	};
 }
@@ -0,0 +1,825 @@
+#pragma once
+
+#include "mclo/container/bitset.hpp"
+#include "mclo/container/detail/slot_map_indirection.hpp"
+#include "mclo/container/slot_map_handle.hpp"
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/numeric/math.hpp"
+#include "mclo/platform/attributes.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cinttypes>
+#include <climits>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	namespace detail
+	{
+		/// @brief Default number of values per page of a paged_slot_map, aims for pages of around 16KiB
+		template <typename T>
+		inline constexpr std::size_t default_slot_map_page_size =
+			std::max<std::size_t>( std::bit_floor( 16384 / sizeof( T ) ), 16 );
+	}
+
+	/// @brief A slot map which never moves its values, storing them in fixed size pages
+	/// @details Has the same handle semantics as dense_slot_map, a handle gives access to an object which may be
+	/// erased and the handle is able to detect that it is no longer valid.
+	///
+	/// Values are stored in pages of PageSize slots which are never reallocated, the handle index is the position of
+	/// the value in the pages so lookup is a single generation check then direct access. Erasure destroys the value
+	/// in place instead of moving the last value into the gap, so pointers and references to values remain valid
+	/// until that value is erased and erasure never has to move a potentially large object.
+	///
+	/// Each page tracks which slots are occupied with a bitset, iteration skips runs of free slots a word at a time.
+	///
+	/// Pros:
+	/// * Pointers and references to values are stable
+	/// * Erase is a destroy in place, no moves of other values
+	/// * Growing allocates a new page, existing values are never moved
+	///
+	/// Cons:
+	/// * Values are not contiguous, iteration has to skip free slots
+	/// * Memory of erased values is only reused by later inserts, pages are never released until destruction
+	///
+	/// @tparam T The type of objects to store
+	/// @tparam HandleTotalBits Total number of bits for the handle type to use, smallest integer type to fit these bits
+	/// will be the handle representation type, defaults to a std::uint32_t. More bits = larger max size & generation
+	/// but larger handle.
+	/// @tparam GenerationBits Number of the total bits in the handle representation type used for generation checking,
+	/// defaults to 1/4 of the total bits. More bits = lower max size but higher generation before wrapping
+	/// @tparam PageSize Number of values stored in each page, defaults to pages of around 16KiB
+	/// @tparam Allocator The allocator used for the pages and values
+	template <typename T,
+			  std::size_t HandleTotalBits = sizeof( std::uint32_t ) * CHAR_BIT,
+			  std::size_t GenerationBits = HandleTotalBits / 4,
+			  std::size_t PageSize = detail::default_slot_map_page_size<T>,
+			  typename Allocator = std::allocator<T>>
+	class paged_slot_map
+	{
+	public:
+		using handle_type = slot_map_handle<T, HandleTotalBits, GenerationBits>;
+
+	private:
+		using alloc_traits = std::allocator_traits<Allocator>;
+
+		struct alignas( T ) value_storage
+		{
+			std::byte bytes[ sizeof( T ) ];
+		};
+
+		struct page
+		{
+			/// @brief Which slots of the page hold a value
+			mclo::bitset<PageSize, std::uint64_t> occupied;
+			value_storage values[ PageSize ];
+		};
+
+		using page_alloc_traits = typename alloc_traits::template rebind_traits<page>;
+		using page_allocator = typename page_alloc_traits::allocator_type;
+		using page_pointer = typename page_alloc_traits::pointer;
+		using page_table = std::vector<page_pointer, typename alloc_traits::template rebind_alloc<page_pointer>>;
+		using indirection_alloc = typename alloc_traits::template rebind_alloc<handle_type>;
+
+		template <bool IsConst>
+		class iterator_base;
+
+	public:
+		using value_type = T;
+		using allocator_type = Allocator;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		// Values live inside pages so are always accessed with regular pointers
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using difference_type = std::ptrdiff_t;
+		using size_type = decltype( handle_type::max_index + 1 );
+		using iterator = iterator_base<false>;
+		using const_iterator = iterator_base<true>;
+
+		static_assert( std::is_object_v<value_type>,
+					   "The C++ Standard forbids containers of non-object types "
+					   "because of [container.requirements]." );
+		static_assert( PageSize > 0, "Pages must hold at least one value" );
+
+	private:
+		template <bool IsConst>
+		class iterator_base
+		{
+			using map_type = std::conditional_t<IsConst, const paged_slot_map, paged_slot_map>;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = paged_slot_map::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+			using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+			iterator_base() noexcept = default;
+
+			template <bool OtherConst>
+				requires( IsConst && !OtherConst )
+			iterator_base( const iterator_base<OtherConst>& other ) noexcept
+				: m_map( other.m_map )
+				, m_slot( other.m_slot )
+			{
+			}
+
+			[[nodiscard]] reference operator*() const noexcept
+			{
+				return *m_map->value_at( m_slot );
+			}
+
+			[[nodiscard]] pointer operator->() const noexcept
+			{
+				return m_map->value_at( m_slot );
+			}
+
+			iterator_base& operator++() noexcept
+			{
+				m_slot = m_map->next_occupied_after( m_slot );
+				return *this;
+			}
+
+			iterator_base operator++( int ) noexcept
+			{
+				iterator_base result = *this;
+				++*this;
+				return result;
+			}
+
+			[[nodiscard]] bool operator==( const iterator_base& other ) const noexcept = default;
+
+		private:
+			friend paged_slot_map;
+			friend iterator_base<true>;
+
+			iterator_base( map_type* const map, const std::size_t slot ) noexcept
+				: m_map( map )
+				, m_slot( slot )
+			{
+			}
+
+			map_type* m_map = nullptr;
+			std::size_t m_slot = 0;
+		};
+
+	public:
+		paged_slot_map() noexcept( std::is_nothrow_default_constructible_v<allocator_type> ) = default;
+
+		explicit paged_slot_map( const allocator_type& allocator ) noexcept
+			: m_pages( typename page_table::allocator_type( allocator ) )
+			, m_slot_indirection( indirection_alloc( allocator ) )
+			, m_allocator( allocator )
+		{
+		}
+
+		explicit paged_slot_map( const size_type slot_count, const allocator_type& allocator = allocator_type() )
+			: paged_slot_map( allocator )
+		{
+			reserve_slots( slot_count );
+		}
+
+		paged_slot_map( const paged_slot_map& other )
+			: paged_slot_map( alloc_traits::select_on_container_copy_construction( other.m_allocator ) )
+		{
+			try
+			{
+				copy_from( other );
+			}
+			catch ( ... )
+			{
+				destroy_pages();
+				throw;
+			}
+		}
+
+		paged_slot_map( paged_slot_map&& other ) noexcept
+			: m_pages( std::move( other.m_pages ) )
+			, m_slot_indirection( std::move( other.m_slot_indirection ) )
+			, m_size( std::exchange( other.m_size, 0 ) )
+			, m_allocator( std::move( other.m_allocator ) )
+		{
+			other.m_pages.clear();
+			other.m_slot_indirection.reset();
+		}
+
+		paged_slot_map& operator=( const paged_slot_map& other )
+		{
+			if ( this != &other )
+			{
+				paged_slot_map copy( other );
+				swap( copy );
+			}
+			return *this;
+		}
+
+		paged_slot_map& operator=( paged_slot_map&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				paged_slot_map moved( std::move( other ) );
+				swap( moved );
+			}
+			return *this;
+		}
+
+		~paged_slot_map()
+		{
+			destroy_pages();
+		}
+
+		/// @brief Result of creating an object containing a reference to it and its handle
+		struct emplace_result
+		{
+			/// @brief Reference to the created object itself
+			reference object;
+
+			/// @brief handle to the created object
+			handle_type handle;
+		};
+
+		/// @brief Emplace an entry into the slot map constructed from arguments
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change to the container is made
+		/// @tparam ...Args Type of arguments to construct from
+		/// @param ...arguments Arguments to construct from
+		/// @return Result containing a reference to the created entry and the handle to it
+		template <typename... Args>
+		[[nodiscard]] emplace_result emplace_and_get( Args&&... arguments )
+		{
+			// If this throws only unused pages and slots were added
+			const size_type slot_index = reserve_free_slot();
+
+			pointer const object = storage_at( slot_index );
+			alloc_traits::construct( m_allocator, object, std::forward<Args>( arguments )... );
+
+			// We're safe now to return without cleanup, remaining changes are noexcept
+			page_at( slot_index ).occupied.set( slot_index % PageSize );
+			++m_size;
+			return { *object, m_slot_indirection.acquire( slot_index ) };
+		}
+
+		/// @brief Emplace an entry into the slot map constructed from arguments
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change to the container is made
+		/// @tparam ...Args Type of arguments to construct from
+		/// @param ...arguments Arguments to construct from
+		/// @return handle to the created entry
+		template <typename... Args>
+		[[nodiscard]] handle_type emplace( Args&&... arguments )
+		{
+			return emplace_and_get( std::forward<Args>( arguments )... ).handle;
+		}
+
+		/// @brief Insert a copy into the slot map
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change to the container is made
+		/// @param object Reference to the object to copy into the slot map
+		/// @return handle to the created entry
+		[[nodiscard]] handle_type insert( const_reference object )
+		{
+			return emplace( object );
+		}
+
+		/// @brief Insert a move into the slot map
+		/// @post Provides a strong exception guarantee, if an exception is thrown no change to the container is made
+		/// @param object Reference to the object to move into the slot map
+		/// @return handle to the created entry
+		[[nodiscard]] handle_type insert( value_type&& object )
+		{
+			return emplace( std::move( object ) );
+		}
+
+		/// @brief Insert a batch of objects, allocating the pages for all of them up front
+		/// @post Provides a basic exception guarantee, if an exception is thrown the objects inserted before it remain
+		/// and their handles have been written
+		/// @param first Iterator to the first object to insert, out_handles.size() objects are read from it
+		/// @param out_handles Span to write the handle of each inserted object to
+		template <std::input_iterator InputIt>
+		void insert_n( InputIt first, const mclo::span<handle_type> out_handles )
+		{
+			const std::size_t count = out_handles.size();
+			if ( count > static_cast<std::size_t>( max_size() - size() ) ) [[unlikely]]
+			{
+				throw_too_big();
+			}
+
+			const std::size_t free_slots = static_cast<std::size_t>( slot_count() - size() );
+			if ( free_slots < count )
+			{
+				grow_slots( static_cast<std::size_t>( slot_count() ) + count - free_slots );
+			}
+
+			// Enough free slots are reserved so no insert in the batch can allocate
+			for ( handle_type& handle : out_handles )
+			{
+				handle = emplace_and_get( *first ).handle;
+				++first;
+			}
+		}
+
+		/// @brief Reserve space for amount slots, rounded up to whole pages
+		/// @post Provides a basic exception guarantee, if an exception is thrown invariants are held and no leaks occur
+		/// @param amount The number of slots to reserve for
+		void reserve_slots( const size_type amount )
+		{
+			if ( amount > max_size() ) [[unlikely]]
+			{
+				throw_too_big();
+			}
+			grow_slots( amount );
+		}
+
+		/// @brief Erase an entry in the slot map from its handle
+		/// @details The value is destroyed in place, no other value is moved
+		/// @param handle The handle to the object to erase
+		void erase( const handle_type handle ) noexcept
+		{
+			if ( is_valid( handle ) ) [[likely]]
+			{
+				erase_valid_slot( handle.index );
+			}
+		}
+
+		/// @brief Erase an entry in the slot map from its iterator
+		/// @param pos The iterator to the object to erase
+		/// @return Iterator to the next element after the erased one
+		iterator erase( const const_iterator pos ) noexcept
+		{
+			if ( pos == cend() ) [[unlikely]]
+			{
+				return end();
+			}
+			const std::size_t slot_index = pos.m_slot;
+			erase_valid_slot( static_cast<size_type>( slot_index ) );
+			return iterator( this, next_occupied_after( slot_index ) );
+		}
+
+		/// @brief Erase a batch of entries from their handles, invalid handles are skipped
+		/// @param handles The handles to the objects to erase
+		/// @return Number of entries erased
+		size_type erase_many( const mclo::span<const handle_type> handles ) noexcept
+		{
+			size_type num_erased = 0;
+			m_slot_indirection.find_many( handles, [ & ]( std::size_t, const handle_type* const slot ) {
+				if ( slot )
+				{
+					// Erasing only changes the generation of this slot, so the handles still to come are unaffected
+					// unless they are duplicates which will then mismatch on generation
+					erase_valid_slot( slot->index );
+					++num_erased;
+				}
+			} );
+			return num_erased;
+		}
+
+		/// @brief Erase the element at the handle if it exists returning the data it contained, else return an empty
+		/// optional
+		/// @param handle The handle to move the data from then erase
+		/// @return Contains the data at the handle's location, else an empty optional
+		[[nodiscard]] std::optional<value_type> pop( const handle_type handle ) noexcept(
+			std::is_nothrow_move_constructible_v<T> )
+		{
+			const pointer ptr = lookup( handle );
+			if ( !ptr ) [[unlikely]]
+			{
+				return std::nullopt;
+			}
+
+			T object( std::move( *ptr ) );
+			erase_valid_slot( handle.index );
+			return std::move( object );
+		}
+
+		/// @brief Destroy all active elements and put all slots back into the free list
+		/// @details Increases the generation counter of all slots, so existing handles are valid to use
+		/// @warning Doing this frequently can cause your slots to increase in version faster than via normal
+		/// use, if you want to clear everything out and have no old handles you'll want to use Reset instead
+		void clear() noexcept
+		{
+			destroy_values();
+			m_slot_indirection.clear();
+		}
+
+		/// @brief Destroy all active elements and clear all slots, the pages are kept for reuse
+		/// @warning This invalidates all existing handles as it resets generation counters, be sure none in use else
+		/// it'll lead to collisions
+		void reset() noexcept
+		{
+			destroy_values();
+			m_slot_indirection.reset();
+		}
+
+		/// @brief Check if a handle is a valid entry into the slot map
+		/// @param handle The handle to check
+		/// @return If the handle refers to a valid entry in the slot map
+		[[nodiscard]] bool is_valid( const handle_type handle ) const noexcept
+		{
+			return m_slot_indirection.is_valid( handle );
+		}
+
+		/// @brief Lookup an entry in the slot map
+		/// @param handle The handle to lookup
+		/// @return Const pointer to the object the handle refers to, or nullptr if an invalid handle
+		[[nodiscard]] const_pointer lookup( const handle_type handle ) const noexcept
+		{
+			return is_valid( handle ) ? value_at( handle.index ) : nullptr;
+		}
+
+		/// @brief Lookup an entry in the slot map
+		/// @param handle The handle to lookup
+		/// @return Mutable pointer to the object the handle refers to, or nullptr if an invalid handle
+		[[nodiscard]] pointer lookup( const handle_type handle ) noexcept
+		{
+			return is_valid( handle ) ? value_at( handle.index ) : nullptr;
+		}
+
+		/// @brief Lookup a batch of entries in the slot map
+		/// @param handles The handles to lookup
+		/// @param out Span to write a const pointer to each object to, or nullptr for an invalid handle, must be the
+		/// same size as handles
+		/// @return Number of valid handles
+		size_type lookup_many( const mclo::span<const handle_type> handles,
+							   const mclo::span<const_pointer> out ) const noexcept
+		{
+			MCLO_DEBUG_ASSERT( handles.size() == out.size(), "Output must be the same size as handles" );
+			size_type num_found = 0;
+			m_slot_indirection.find_many( handles, [ & ]( const std::size_t index, const handle_type* const slot ) {
+				out[ index ] = slot ? value_at( slot->index ) : nullptr;
+				num_found += slot != nullptr;
+			} );
+			return num_found;
+		}
+
+		/// @brief Lookup a batch of entries in the slot map
+		/// @param handles The handles to lookup
+		/// @param out Span to write a mutable pointer to each object to, or nullptr for an invalid handle, must be the
+		/// same size as handles
+		/// @return Number of valid handles
+		size_type lookup_many( const mclo::span<const handle_type> handles, const mclo::span<pointer> out ) noexcept
+		{
+			MCLO_DEBUG_ASSERT( handles.size() == out.size(), "Output must be the same size as handles" );
+			size_type num_found = 0;
+			m_slot_indirection.find_many( handles, [ & ]( const std::size_t index, const handle_type* const slot ) {
+				out[ index ] = slot ? value_at( slot->index ) : nullptr;
+				num_found += slot != nullptr;
+			} );
+			return num_found;
+		}
+
+		/// @brief Invoke func with every entry in the slot map
+		/// @details Faster than iterating, the occupied bits are walked a word at a time without looking the word up
+		/// again for every entry.
+		/// @warning func must not insert into or erase from the slot map
+		/// @param func Function to invoke with a reference to each entry
+		template <typename Func>
+		void for_each( Func func )
+		{
+			for_each_slot( [ & ]( const std::size_t slot_index ) { func( *value_at( slot_index ) ); } );
+		}
+
+		/// @brief Invoke func with every entry in the slot map
+		/// @details Faster than iterating, the occupied bits are walked a word at a time without looking the word up
+		/// again for every entry.
+		/// @param func Function to invoke with a const reference to each entry
+		template <typename Func>
+		void for_each( Func func ) const
+		{
+			for_each_slot( [ & ]( const std::size_t slot_index ) { func( *value_at( slot_index ) ); } );
+		}
+
+		/// @brief Get the handle for the entry the iterator refers to
+		/// @param pos The iterator to get the handle for
+		/// @return The handle to the entry for the iterator, or null handle if end iterator
+		[[nodiscard]] handle_type get_handle( const const_iterator pos ) const noexcept
+		{
+			if ( pos == cend() ) [[unlikely]]
+			{
+				return {};
+			}
+			return m_slot_indirection.handle_at( static_cast<size_type>( pos.m_slot ) );
+		}
+
+		/// @brief Get the number of active objects
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_size;
+		}
+
+		/// @brief Is the slot map empty
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_size == 0;
+		}
+
+		/// @brief Get the number of slots, guaranteed >= size()
+		[[nodiscard]] size_type slot_count() const noexcept
+		{
+			return m_slot_indirection.slot_count();
+		}
+
+		/// @brief Get the number of values each page holds
+		[[nodiscard]] static constexpr std::size_t page_size() noexcept
+		{
+			return PageSize;
+		}
+
+		/// @brief Get the maximum number of objects
+		[[nodiscard]] static constexpr size_type max_size() noexcept
+		{
+			return handle_type::max_index + 1;
+		}
+
+		/// @brief Get the allocator used
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return m_allocator;
+		}
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator( this, next_occupied( 0 ) );
+		}
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator( this, next_occupied( 0 ) );
+		}
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator( this, end_slot() );
+		}
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator( this, end_slot() );
+		}
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		/// @brief Swap this with Other
+		/// @param Other The target of the swap
+		void swap( paged_slot_map& other ) noexcept
+		{
+			using std::swap;
+			if constexpr ( alloc_traits::propagate_on_container_swap::value )
+			{
+				swap( m_allocator, other.m_allocator );
+			}
+			else
+			{
+				MCLO_DEBUG_ASSERT( m_allocator == other.m_allocator, "containers incompatible for swap" );
+			}
+			swap( m_pages, other.m_pages );
+			swap( m_slot_indirection, other.m_slot_indirection );
+			swap( m_size, other.m_size );
+		}
+
+		friend void swap( paged_slot_map& lhs, paged_slot_map& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+	private:
+		[[noreturn]] void throw_too_big() const
+		{
+			throw std::length_error( "Slot map too large for maximum handle index" );
+		}
+
+		[[nodiscard]] page& page_at( const std::size_t slot_index ) const noexcept
+		{
+			return *std::to_address( m_pages[ slot_index / PageSize ] );
+		}
+
+		/// @brief Pointer to the storage of a slot for constructing into
+		[[nodiscard]] pointer storage_at( const std::size_t slot_index ) const noexcept
+		{
+			return reinterpret_cast<pointer>( page_at( slot_index ).values[ slot_index % PageSize ].bytes );
+		}
+
+		/// @brief Pointer to the value in an occupied slot
+		[[nodiscard]] pointer value_at( const std::size_t slot_index ) const noexcept
+		{
+			return std::launder( storage_at( slot_index ) );
+		}
+
+		[[nodiscard]] std::size_t end_slot() const noexcept
+		{
+			return m_pages.size() * PageSize;
+		}
+
+		/// @brief Find the first occupied slot at or after slot_index
+		/// @return The occupied slot or end_slot() if there are none
+		[[nodiscard]] std::size_t next_occupied( const std::size_t slot_index ) const noexcept
+		{
+			std::size_t offset = slot_index % PageSize;
+			for ( std::size_t page_index = slot_index / PageSize; page_index < m_pages.size(); ++page_index )
+			{
+				const auto& occupied = std::to_address( m_pages[ page_index ] )->occupied;
+				const std::size_t found = occupied.find_first_set( offset );
+				if ( found != occupied.npos )
+				{
+					return page_index * PageSize + found;
+				}
+				offset = 0;
+			}
+			return end_slot();
+		}
+
+		/// @brief Find the first occupied slot after slot_index
+		/// @details Values are usually dense so the rest of the bitset word holding slot_index is checked first
+		/// @return The occupied slot or end_slot() if there are none
+		[[nodiscard]] std::size_t next_occupied_after( const std::size_t slot_index ) const noexcept
+		{
+			constexpr std::size_t bits_per_word = sizeof( std::uint64_t ) * CHAR_BIT;
+			const std::size_t offset = slot_index % PageSize;
+			const std::size_t bit = offset % bits_per_word;
+			const std::uint64_t word = page_at( slot_index ).occupied.underlying()[ offset / bits_per_word ];
+
+			// Mask off bit and all below it, shifting 2 avoids an out of range shift when bit is the last in the word
+			const std::uint64_t remaining = word & ~( ( std::uint64_t{ 2 } << bit ) - 1 );
+			if ( remaining != 0 )
+			{
+				return slot_index - bit + static_cast<std::size_t>( std::countr_zero( remaining ) );
+			}
+			return next_occupied( slot_index + 1 );
+		}
+
+		template <typename Func>
+		void for_each_slot( Func func ) const
+		{
+			constexpr std::size_t bits_per_word = sizeof( std::uint64_t ) * CHAR_BIT;
+			for ( std::size_t page_index = 0; page_index < m_pages.size(); ++page_index )
+			{
+				const auto words = std::to_address( m_pages[ page_index ] )->occupied.underlying();
+				for ( std::size_t word_index = 0; word_index < words.size(); ++word_index )
+				{
+					const std::size_t first_slot = page_index * PageSize + word_index * bits_per_word;
+					for ( std::uint64_t word = words[ word_index ]; word != 0; word &= word - 1 )
+					{
+						func( first_slot + static_cast<std::size_t>( std::countr_zero( word ) ) );
+					}
+				}
+			}
+		}
+
+		/// @brief Grow the slots to at least amount, rounding up to whole pages
+		/// @post Provides a basic exception guarantee, pages allocated before an exception are kept for later use
+		void grow_slots( const std::size_t amount )
+		{
+			if ( amount <= static_cast<std::size_t>( slot_count() ) )
+			{
+				return;
+			}
+
+			const std::size_t num_pages = mclo::ceil_divide( amount, PageSize );
+			m_pages.reserve( num_pages );
+			page_allocator allocator( m_allocator );
+			while ( m_pages.size() < num_pages )
+			{
+				const page_pointer new_page = page_alloc_traits::allocate( allocator, 1 );
+				page_alloc_traits::construct( allocator, std::to_address( new_page ) );
+				m_pages.push_back( new_page );
+			}
+
+			const std::size_t new_slot_count = std::min( num_pages * PageSize, static_cast<std::size_t>( max_size() ) );
+			m_slot_indirection.reserve( static_cast<size_type>( new_slot_count ) );
+		}
+
+		/// @brief Make sure the free list is not empty, adding a new page of slots if needed
+		/// @return The slot the next acquire will use
+		[[nodiscard]] size_type reserve_free_slot()
+		{
+			const size_type current_slot_count = slot_count();
+			if ( m_slot_indirection.next_free_slot() == current_slot_count )
+			{
+				if ( current_slot_count == max_size() ) [[unlikely]]
+				{
+					throw_too_big();
+				}
+				grow_slots( static_cast<std::size_t>( current_slot_count ) + 1 );
+			}
+			return m_slot_indirection.next_free_slot();
+		}
+
+		void erase_valid_slot( const size_type slot_index ) noexcept
+		{
+			alloc_traits::destroy( m_allocator, value_at( slot_index ) );
+			page_at( slot_index ).occupied.reset( slot_index % PageSize );
+			--m_size;
+
+			// Invalidates remaining handles and returns the slot to the free list
+			m_slot_indirection.release( slot_index );
+		}
+
+		void destroy_values() noexcept
+		{
+			if constexpr ( !std::is_trivially_destructible_v<value_type> )
+			{
+				for ( std::size_t slot = next_occupied( 0 ); slot != end_slot(); slot = next_occupied( slot + 1 ) )
+				{
+					alloc_traits::destroy( m_allocator, value_at( slot ) );
+				}
+			}
+			for ( const page_pointer& current_page : m_pages )
+			{
+				std::to_address( current_page )->occupied.reset();
+			}
+			m_size = 0;
+		}
+
+		void destroy_pages() noexcept
+		{
+			destroy_values();
+			page_allocator allocator( m_allocator );
+			for ( const page_pointer& current_page : m_pages )
+			{
+				page_alloc_traits::destroy( allocator, std::to_address( current_page ) );
+				page_alloc_traits::deallocate( allocator, current_page, 1 );
+			}
+			m_pages.clear();
+		}
+
+		void copy_from( const paged_slot_map& other )
+		{
+			page_allocator allocator( m_allocator );
+			m_pages.reserve( other.m_pages.size() );
+			for ( std::size_t page_index = 0; page_index < other.m_pages.size(); ++page_index )
+			{
+				const page_pointer new_page = page_alloc_traits::allocate( allocator, 1 );
+				page_alloc_traits::construct( allocator, std::to_address( new_page ) );
+				m_pages.push_back( new_page );
+			}
+
+			// Values are copied into the same slots so the copied handles refer to them, each slot is only marked
+			// occupied once constructed so a partial copy is cleaned up correctly
+			for ( std::size_t slot = other.next_occupied( 0 ); slot != other.end_slot();
+				  slot = other.next_occupied( slot + 1 ) )
+			{
+				alloc_traits::construct( m_allocator, storage_at( slot ), *other.value_at( slot ) );
+				page_at( slot ).occupied.set( slot % PageSize );
+				++m_size;
+			}
+			m_slot_indirection = other.m_slot_indirection;
+		}
+
+		/// @brief Fixed size pages of values, the page of a slot is slot index / PageSize
+		page_table m_pages;
+
+		/// @brief Generation table and free list, lookup from handle.index -> slot in use
+		detail::slot_map_indirection<handle_type, indirection_alloc> m_slot_indirection;
+
+		size_type m_size = 0;
+
+		MCLO_NO_UNIQUE_ADDRESS allocator_type m_allocator;
+	};
+
+	namespace pmr
+	{
+		template <typename T,
+				  std::size_t HandleTotalBits = sizeof( std::uint32_t ) * CHAR_BIT,
+				  std::size_t GenerationBits = HandleTotalBits / 4,
+				  std::size_t PageSize = detail::default_slot_map_page_size<T>>
+		using paged_slot_map =
+			mclo::paged_slot_map<T, HandleTotalBits, GenerationBits, PageSize, std::pmr::polymorphic_allocator<T>>;
+	}
+}
+
+namespace std
+{
+	template <typename T,
+			  std::size_t HandleTotalBits,
+			  std::size_t GenerationBits,
+			  std::size_t PageSize,
+			  typename Allocator,
+			  typename Predicate>
+	auto erase_if( mclo::paged_slot_map<T, HandleTotalBits, GenerationBits, PageSize, Allocator>& map, Predicate pred )
+	{
+		auto first = map.begin();
+		const auto old_size = map.size();
+		while ( first != map.end() )
+		{
+			if ( pred( *first ) )
+			{
+				first = map.erase( first );
+			}
+			else
+			{
+				++first;
+			}
+		}
+		return old_size - map.size();
+	}
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "mclo/container/growth_policy.hpp"
 #include "mclo/debug/assert.hpp"
+#include "mclo/memory/relocate.hpp"
+#include "mclo/platform/attributes.hpp"
 #include "mclo/platform/warnings.hpp"
 #include "mclo/utility/synth_three_way.hpp"
 
@@ -56,21 +59,26 @@ namespace mclo
 			}
 
 		protected:
-			static constexpr float growth_factor = 1.5f;
-
 			std::byte* m_data = nullptr;
 			size_type m_size = 0;
 			size_type m_capacity = 0;
 		};
 
 		/// @brief Size helper mimics a small_vector size 1 to find the variable offset
-		template <typename T>
+		template <typename T, typename Allocator>
 		struct small_vector_offset_helper
 		{
 			small_vector_header m_header;
+			MCLO_NO_UNIQUE_ADDRESS Allocator m_allocator;
 			alignas( T ) std::byte m_data[ sizeof( T ) ];
 		};
 
+		/// @brief Allocators that can grow an allocation in place, such as @ref arena_allocator
+		template <typename Allocator, typename T>
+		concept extendable_allocator = requires( Allocator& allocator, T* const ptr, const std::size_t count ) {
+			{ allocator.try_extend( ptr, count, count ) } -> std::same_as<bool>;
+		};
+
 		struct value_initialize_tag
 		{
 		};
@@ -79,11 +87,22 @@ namespace mclo
 	/// @brief small_vector size independent code, mimics the API of std::vector
 	/// @details Can not be constructed directly should only be used as a reference type in functions
 	/// which should operate on any sized small_vector of a given type.
+	///
+	/// Values that are @ref is_trivially_relocatable are copied as bytes when reallocating, inserting and erasing
+	/// instead of being moved and destroyed one at a time. Heap storage that can be extended in place by the
+	/// allocator, such as from a @ref memory_arena, is grown without moving the values at all.
 	/// @tparam T Type of objects stored
-	template <typename T>
+	/// @tparam Allocator Allocator for the heap storage, used once the inline capacity is exceeded. Fixed at
+	/// construction, heap storage is only taken over on move or swap when the allocators compare equal.
+	/// @tparam GrowthPolicy How much to grow the capacity when it is exceeded, such as @ref geometric_growth or
+	/// @ref exact_growth.
+	template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = geometric_growth<3, 2>>
 	class small_vector_base : private detail::small_vector_header
 	{
 		using base = detail::small_vector_header;
+		using alloc_traits = std::allocator_traits<Allocator>;
+
+		static_assert( std::is_same_v<typename alloc_traits::pointer, T*>, "Allocator must use raw pointers" );
 
 	public:
 		using value_type = T;
@@ -97,6 +116,8 @@ namespace mclo
 		using const_iterator = const_pointer;
 		using reverse_iterator = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using allocator_type = Allocator;
+		using growth_policy = GrowthPolicy;
 
 		// Cannot know the derived internal capacity
 		small_vector_base( const small_vector_base& other ) = delete;
@@ -118,7 +139,7 @@ namespace mclo
 				return *this;
 			}
 
-			if ( other.is_internal() )
+			if ( other.is_internal() || !allocators_equal( other ) )
 			{
 				assign( std::make_move_iterator( other.begin() ), std::make_move_iterator( other.end() ) );
 				other.clear();
@@ -146,7 +167,7 @@ namespace mclo
 				return;
 			}
 
-			if ( !is_internal() && !other.is_internal() )
+			if ( !is_internal() && !other.is_internal() && allocators_equal( other ) )
 			{
 				std::swap( m_data, other.m_data );
 				std::swap( m_size, other.m_size );
@@ -182,6 +203,11 @@ namespace mclo
 		using base::max_size;
 		using base::size;
 
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return m_allocator;
+		}
+
 		[[nodiscard]] reference operator[]( const size_type index ) noexcept
 		{
 			MCLO_DEBUG_ASSERT( index < m_size, "Index out of range" );
@@ -312,11 +338,12 @@ namespace mclo
 			else
 			{
 				iterator dest = begin();
-				for ( ; first != last; ++first, ++dest )
+				const iterator old_end = end();
+				for ( ; first != last && dest != old_end; ++first, ++dest )
 				{
 					*dest = *first;
 				}
-				std::destroy( dest, end() );
+				std::destroy( dest, old_end );
 				m_size = static_cast<size_type>( std::distance( begin(), dest ) );
 				insert( end(), std::move( first ), std::move( last ) );
 			}
@@ -345,7 +372,14 @@ namespace mclo
 
 			const iterator insertPos = unwrap_iterator( pos );
 
+			// Construct first as args may refer to values that are about to be shifted
 			value_type temp( std::forward<Args>( args )... );
+			if constexpr ( relocate_trivially )
+			{
+				return insert_relocating( insertPos, 1, [ &temp ]( const pointer ptr ) {
+					std::construct_at( ptr, std::move( temp ) );
+				} );
+			}
 			emplace_back_no_allocate( std::move( back() ) );
 			std::move_backward( insertPos, oldEnd - 1, oldEnd );
 			*insertPos = std::move( temp );
@@ -384,6 +418,13 @@ namespace mclo
 				{
 					emplace_back_no_allocate( value );
 				}
+				else if constexpr ( relocate_trivially )
+				{
+					const value_type temp( value );
+					insert_relocating( insert_pos, amount, [ amount, &temp ]( const pointer ptr ) {
+						std::uninitialized_fill_n( ptr, amount, temp );
+					} );
+				}
 				else
 				{
 					const size_type existing_modified = static_cast<size_type>( std::distance( insert_pos, old_end ) );
@@ -460,7 +501,16 @@ namespace mclo
 		{
 			MCLO_DEBUG_ASSERT( pos >= begin() && pos <= end(), "pos must be an iterator in this container" );
 			const iterator it = unwrap_iterator( pos );
-			std::move( it + 1, end(), it );
+			if constexpr ( relocate_trivially )
+			{
+				std::destroy_at( it );
+				mclo::uninitialized_relocate_n( it + 1, static_cast<size_type>( end() - it - 1 ), it );
+			}
+			else
+			{
+				std::move( it + 1, end(), it );
+				std::destroy_at( end() - 1 );
+			}
 			--m_size;
 			return it;
 		}
@@ -475,7 +525,18 @@ namespace mclo
 			const iterator first_mut = unwrap_iterator( first );
 			const iterator last_mut = unwrap_iterator( last );
 
-			if ( first_mut != last_mut )
+			if ( first_mut == last_mut )
+			{
+				return first_mut;
+			}
+
+			if constexpr ( relocate_trivially )
+			{
+				std::destroy( first_mut, last_mut );
+				mclo::uninitialized_relocate_n( last_mut, static_cast<size_type>( end() - last_mut ), first_mut );
+				m_size -= static_cast<size_type>( last_mut - first_mut );
+			}
+			else
 			{
 				const iterator newLast = std::move( last_mut, end(), first_mut );
 				std::destroy( newLast, end() );
@@ -554,17 +615,15 @@ namespace mclo
 		}
 
 	protected:
-		explicit small_vector_base( const size_type capacity ) noexcept
+		small_vector_base( const size_type capacity, const allocator_type& alloc ) noexcept
 			: base( get_first_element(), capacity )
+			, m_allocator( alloc )
 		{
 		}
 
 		~small_vector_base()
 		{
-			if ( !is_internal() )
-			{
-				::operator delete( static_cast<void*>( this->m_data ) );
-			}
+			deallocate_storage();
 		}
 
 	private:
@@ -610,13 +669,18 @@ namespace mclo
 		class [[nodiscard]] uninitialized_unique_ptr
 		{
 		public:
-			explicit uninitialized_unique_ptr( const pointer ptr ) noexcept
-				: m_ptr( ptr )
+			uninitialized_unique_ptr( allocator_type& alloc, const size_type capacity )
+				: m_allocator( alloc )
+				, m_ptr( alloc_traits::allocate( alloc, capacity ) )
+				, m_capacity( capacity )
 			{
 			}
 			~uninitialized_unique_ptr() noexcept
 			{
-				::operator delete( static_cast<void*>( this->m_ptr ) );
+				if ( m_ptr )
+				{
+					alloc_traits::deallocate( m_allocator, m_ptr, m_capacity );
+				}
 			}
 
 			uninitialized_unique_ptr( const uninitialized_unique_ptr& ) = delete;
@@ -633,12 +697,63 @@ namespace mclo
 			}
 
 		private:
+			allocator_type& m_allocator;
 			pointer m_ptr;
+			size_type m_capacity;
 		};
 
-		[[nodiscard]] static uninitialized_unique_ptr allocate_uninitialized( const size_type amount )
+		static constexpr bool relocate_trivially = is_trivially_relocatable_v<value_type>;
+
+		[[nodiscard]] uninitialized_unique_ptr allocate_uninitialized( const size_type amount )
+		{
+			return uninitialized_unique_ptr{ m_allocator, amount };
+		}
+
+		[[nodiscard]] bool allocators_equal( const small_vector_base& other ) const noexcept
+		{
+			if constexpr ( alloc_traits::is_always_equal::value )
+			{
+				return true;
+			}
+			else
+			{
+				return m_allocator == other.m_allocator;
+			}
+		}
+
+		/// @brief Grow the heap storage to new_capacity without moving it if the allocator supports it
+		[[nodiscard]] bool try_extend( const size_type new_capacity ) noexcept
+		{
+			if constexpr ( detail::extendable_allocator<allocator_type, value_type> )
+			{
+				if ( !is_internal() && this->m_data && m_allocator.try_extend( data(), m_capacity, new_capacity ) )
+				{
+					this->m_capacity = new_capacity;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/// @brief Relocate the values from pos count places back then construct new values into the gap
+		/// @details construct must leave no values constructed if it throws, the values are then relocated back
+		template <typename ConstructFunc>
+		iterator insert_relocating( const iterator pos, const size_type count, ConstructFunc construct )
 		{
-			return uninitialized_unique_ptr{ static_cast<pointer>( ::operator new( sizeof( value_type ) * amount ) ) };
+			MCLO_DEBUG_ASSERT( count <= m_capacity - m_size, "Not enough capacity to insert" );
+			const size_type tail_size = static_cast<size_type>( end() - pos );
+			mclo::uninitialized_relocate_n( pos, tail_size, pos + count );
+			try
+			{
+				construct( pos );
+			}
+			catch ( ... )
+			{
+				mclo::uninitialized_relocate_n( pos + count, tail_size, pos );
+				throw;
+			}
+			m_size += count;
+			return pos;
 		}
 
 		[[nodiscard]] static iterator unwrap_iterator( const const_iterator it ) noexcept
@@ -649,9 +764,20 @@ namespace mclo
 
 		void reallocate( const size_type new_capacity )
 		{
+			if ( new_capacity > m_capacity && try_extend( new_capacity ) )
+			{
+				return;
+			}
+
 			uninitialized_unique_ptr new_data = allocate_uninitialized( new_capacity );
 
-			if constexpr ( std::is_nothrow_move_constructible_v<value_type> ||
+			if constexpr ( relocate_trivially )
+			{
+				mclo::uninitialized_relocate_n( begin(), m_size, new_data.get() );
+				adopt_data( new_data.release(), new_capacity, m_size );
+				return;
+			}
+			else if constexpr ( std::is_nothrow_move_constructible_v<value_type> ||
 						   !std::is_copy_constructible_v<value_type> )
 			{
 				std::uninitialized_move( begin(), end(), new_data.get() );
@@ -666,17 +792,10 @@ namespace mclo
 
 		[[nodiscard]] size_type calculate_new_capacity( const size_type new_size ) const noexcept
 		{
-			const size_type old_capacity = m_capacity;
-			const size_type max_capacity = max_size();
-
-			// Growing would overflow
-			if ( old_capacity > max_capacity - static_cast<size_type>( old_capacity / growth_factor ) ) [[unlikely]]
-			{
-				return max_capacity;
-			}
-
-			const size_type new_capacity = static_cast<size_type>( old_capacity * growth_factor );
-			return std::max( new_capacity, new_size );
+			const std::size_t new_capacity = growth_policy::next_capacity( m_capacity, new_size, max_size() );
+			MCLO_DEBUG_ASSERT( new_capacity >= new_size && new_capacity <= max_size(),
+							   "Growth policy must return a capacity between the new size and max_size" );
+			return static_cast<size_type>( new_capacity );
 		}
 
 		template <typename TInsertCallback>
@@ -694,6 +813,16 @@ namespace mclo
 			const iterator insert_pos = unwrap_iterator( pos );
 			const size_type where_index = static_cast<size_type>( std::distance( begin(), insert_pos ) );
 
+			if ( try_extend( new_capacity ) )
+			{
+				// Construct at the end before moving anything as the callback may refer to values in the tail
+				const size_type old_size = m_size;
+				insert_callback( end() );
+				m_size = new_size;
+				std::rotate( begin() + where_index, begin() + old_size, end() );
+				return begin() + where_index;
+			}
+
 			uninitialized_unique_ptr new_owned_data = allocate_uninitialized( new_capacity );
 			const pointer new_data = new_owned_data.get();
 			const pointer first_new_element = new_data + where_index;
@@ -702,7 +831,15 @@ namespace mclo
 			insert_callback( first_new_element );
 			uninit_range.set_begin( first_new_element );
 
-			if ( insert_pos == end() )
+			if constexpr ( relocate_trivially )
+			{
+				mclo::uninitialized_relocate_n( begin(), where_index, new_data );
+				mclo::uninitialized_relocate_n( insert_pos, m_size - where_index, first_new_element + count );
+				uninit_range.release();
+				adopt_data( new_owned_data.release(), new_capacity, new_size );
+				return first_new_element;
+			}
+			else if ( insert_pos == end() )
 			{
 				if constexpr ( std::is_nothrow_move_constructible_v<value_type> ||
 							   !std::is_copy_constructible_v<value_type> )
@@ -816,6 +953,14 @@ namespace mclo
 			const iterator insert_pos = unwrap_iterator( pos );
 			const iterator old_end = end();
 
+			if constexpr ( relocate_trivially )
+			{
+				insert_relocating( insert_pos, count, [ count, &first ]( const pointer ptr ) {
+					std::uninitialized_copy_n( std::move( first ), count, ptr );
+				} );
+				return;
+			}
+
 			const size_type existing_modified = static_cast<size_type>( std::distance( insert_pos, old_end ) );
 
 			if ( count < existing_modified )
@@ -882,24 +1027,37 @@ namespace mclo
 			larger.m_size = overlap_size;
 		}
 
-		void set_data( const pointer new_data, const size_type new_capacity, const size_type new_size ) noexcept
+		void set_data( std::byte* const new_data, const size_type new_capacity, const size_type new_size ) noexcept
 		{
-			set_data( reinterpret_cast<std::byte*>( new_data ), new_capacity, new_size );
+			set_data( reinterpret_cast<pointer>( new_data ), new_capacity, new_size );
 		}
 
-		void set_data( std::byte* const new_data, const size_type new_capacity, const size_type new_size ) noexcept
+		void set_data( const pointer new_data, const size_type new_capacity, const size_type new_size ) noexcept
 		{
 			std::destroy( begin(), end() );
-			if ( !is_internal() )
-			{
-				::operator delete( static_cast<void*>( this->m_data ) );
-			}
-			this->m_data = new_data;
+			adopt_data( new_data, new_capacity, new_size );
+		}
+
+		/// @brief Take ownership of new storage holding new_size values, the current values must already have been
+		/// destroyed or relocated into it
+		void adopt_data( const pointer new_data, const size_type new_capacity, const size_type new_size ) noexcept
+		{
+			deallocate_storage();
+			this->m_data = reinterpret_cast<std::byte*>( new_data );
 			this->m_capacity = new_capacity;
 			this->m_size = new_size;
 		}
 
-		static constexpr std::size_t offset = offsetof( detail::small_vector_offset_helper<T>, m_data );
+		void deallocate_storage() noexcept
+		{
+			if ( !is_internal() && this->m_data )
+			{
+				alloc_traits::deallocate( m_allocator, data(), m_capacity );
+			}
+		}
+
+		using offset_helper = detail::small_vector_offset_helper<T, Allocator>;
+		static constexpr std::size_t offset = offsetof( offset_helper, m_data );
 
 		[[nodiscard]] std::byte* get_first_element() noexcept
 		{
@@ -914,28 +1072,41 @@ namespace mclo
 		{
 			return get_first_element() == this->m_data;
 		}
+
+		MCLO_NO_UNIQUE_ADDRESS allocator_type m_allocator;
 	};
 
-	template <typename T>
-	[[nodiscard]] bool operator==( const small_vector_base<T>& lhs, const small_vector_base<T>& rhs )
+	template <typename T, typename Allocator, typename GrowthPolicy>
+	[[nodiscard]] bool operator==( const small_vector_base<T, Allocator, GrowthPolicy>& lhs,
+								   const small_vector_base<T, Allocator, GrowthPolicy>& rhs )
 	{
 		return lhs.size() == rhs.size() && std::equal( lhs.begin(), lhs.end(), rhs.begin() );
 	}
 
-	template <typename T>
-	[[nodiscard]] mclo::synth_three_way_result<T> operator<=>( const small_vector_base<T>& lhs,
-															   const small_vector_base<T>& rhs )
+	template <typename T, typename Allocator, typename GrowthPolicy>
+	[[nodiscard]] mclo::synth_three_way_result<T> operator<=>(
+		const small_vector_base<T, Allocator, GrowthPolicy>& lhs,
+		const small_vector_base<T, Allocator, GrowthPolicy>& rhs )
 	{
 		return std::lexicographical_compare_three_way(
 			lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), mclo::synth_three_way{} );
 	}
 
+	/// @brief The inline capacity that keeps a small_vector of T using Allocator within one cache line, at least one.
+	/// @details Use with a stateful allocator, whose size takes from the inline capacity, to keep the default sizing
+	/// such as @c small_vector<T, small_vector_cache_line_capacity<T, arena_allocator<T>>, arena_allocator<T>>.
+	template <typename T, typename Allocator = std::allocator<T>>
+	inline constexpr std::uint32_t small_vector_cache_line_capacity = [] {
+		using offset_helper = detail::small_vector_offset_helper<T, Allocator>;
+		constexpr std::size_t offset = offsetof( offset_helper, m_data );
+		constexpr std::size_t bytes =
+			offset < std::hardware_destructive_interference_size ? std::hardware_destructive_interference_size - offset
+																 : 0;
+		return std::max<std::uint32_t>( 1, static_cast<std::uint32_t>( bytes / sizeof( T ) ) );
+	}();
+
 	namespace detail
 	{
-		template <typename T>
-		constexpr std::size_t default_inline_capacity_bytes =
-			std::hardware_destructive_interference_size - sizeof( small_vector_header );
-
 		template <typename T>
 		constexpr std::uint32_t default_inline_capacity = [] {
 			static_assert( sizeof( T ) <= 256,
@@ -946,7 +1117,7 @@ namespace mclo
 			// Give capacity for at least one element as long as static assert passes
 			// Allows a small_vector<small_vector<T>> to have at least one element which is
 			// not an unreasonable case. Any larger requires manual sizes so you think about it.
-			return std::max<std::uint32_t>( 1, default_inline_capacity_bytes<T> / sizeof( T ) );
+			return small_vector_cache_line_capacity<T>;
 		}();
 	}
 
@@ -956,11 +1127,17 @@ namespace mclo
 	/// over size
 	/// @tparam T Type of objects stored
 	/// @tparam Capacity Number of elements to store inline, if not provided defaults to try and keep the overall stack
-	/// size to one cache line (64 bytes)
-	template <typename T, std::uint32_t Capacity = detail::default_inline_capacity<T>>
-	class small_vector : public small_vector_base<T>
+	/// size to one cache line (64 bytes), see @ref small_vector_cache_line_capacity
+	/// @tparam Allocator Allocator for the heap storage, used once the inline capacity is exceeded
+	/// @tparam GrowthPolicy How much to grow the capacity when it is exceeded
+	template <typename T,
+			  std::uint32_t Capacity = detail::default_inline_capacity<T>,
+			  typename Allocator = std::allocator<T>,
+			  typename GrowthPolicy = geometric_growth<3, 2>>
+	class small_vector : public small_vector_base<T, Allocator, GrowthPolicy>
 	{
-		using base = small_vector_base<T>;
+		using base = small_vector_base<T, Allocator, GrowthPolicy>;
+		using alloc_traits = std::allocator_traits<Allocator>;
 
 	public:
 		static_assert( Capacity > 0, "Inline capacity must be larger than zero" );
@@ -976,22 +1153,28 @@ namespace mclo
 		using typename base::reverse_iterator;
 		using typename base::size_type;
 		using typename base::value_type;
+		using typename base::allocator_type;
+
+		small_vector() noexcept( std::is_nothrow_default_constructible_v<allocator_type> )
+			: small_vector( allocator_type() )
+		{
+		}
 
 		MCLO_DISABLE_WARNINGS( MCLO_WARNING_UNINITIALIZED_MEMBER )
-		small_vector() noexcept
-			: base( Capacity )
+		explicit small_vector( const allocator_type& alloc ) noexcept
+			: base( Capacity, alloc )
 		{
 		}
 		MCLO_RESTORE_WARNINGS
 
 		small_vector( const small_vector& other )
-			: small_vector()
+			: small_vector( alloc_traits::select_on_container_copy_construction( other.get_allocator() ) )
 		{
 			base::operator=( other );
 		}
 
 		small_vector( small_vector&& other ) noexcept
-			: small_vector()
+			: small_vector( other.get_allocator() )
 		{
 			base::operator=( std::move( other ) );
 		}
@@ -1008,27 +1191,27 @@ namespace mclo
 			return *this;
 		}
 
-		explicit small_vector( const size_type count )
-			: small_vector()
+		explicit small_vector( const size_type count, const allocator_type& alloc = allocator_type() )
+			: small_vector( alloc )
 		{
 			base::resize( count );
 		}
 
-		small_vector( const size_type count, const_reference value )
-			: small_vector()
+		small_vector( const size_type count, const_reference value, const allocator_type& alloc = allocator_type() )
+			: small_vector( alloc )
 		{
 			base::resize( count, value );
 		}
 
 		template <std::input_iterator It>
-		small_vector( It first, It last )
-			: small_vector()
+		small_vector( It first, It last, const allocator_type& alloc = allocator_type() )
+			: small_vector( alloc )
 		{
 			base::assign( first, last );
 		}
 
-		small_vector( std::initializer_list<value_type> init_list )
-			: small_vector()
+		small_vector( std::initializer_list<value_type> init_list, const allocator_type& alloc = allocator_type() )
+			: small_vector( alloc )
 		{
 			base::assign( init_list );
 		}
@@ -1045,8 +1228,8 @@ namespace mclo
 
 namespace std
 {
-	template <typename T, typename U>
-	constexpr auto erase( mclo::small_vector_base<T>& vec, const U& value )
+	template <typename T, typename Allocator, typename GrowthPolicy, typename U>
+	constexpr auto erase( mclo::small_vector_base<T, Allocator, GrowthPolicy>& vec, const U& value )
 	{
 		const auto old_size = vec.size();
 		auto last = vec.end();
@@ -1054,8 +1237,8 @@ namespace std
 		return old_size - vec.size();
 	}
 
-	template <typename T, typename Predicate>
-	constexpr auto erase_if( mclo::small_vector_base<T>& vec, Predicate pred )
+	template <typename T, typename Allocator, typename GrowthPolicy, typename Predicate>
+	constexpr auto erase_if( mclo::small_vector_base<T, Allocator, GrowthPolicy>& vec, Predicate pred )
 	{
 		const auto old_size = vec.size();
 		auto last = vec.end();
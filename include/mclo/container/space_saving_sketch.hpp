@@ -0,0 +1,316 @@
+#pragma once
+
+#include "mclo/debug/assert.hpp"
+#include "mclo/hash/hash.hpp"
+#include "mclo/hash/rapidhash.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A Space-Saving sketch, tracking the most frequent keys of a stream with a fixed number of counters.
+	/// @details Keeps @c capacity counters each owned by a key. A key without a counter takes over the smallest one,
+	/// inheriting its count as the new key's possible error. Every key occurring more than @c total/capacity times is
+	/// guaranteed a counter, and a counted key's true count is within [@c count - @c error, @c count].
+	///
+	/// Counters are kept in a binary min heap with a hash map from key to position, so an update costs a hash lookup
+	/// and O(log capacity) heap moves. Heap slots point at their key's map node so moving them never rehashes.
+	///
+	/// Sketches of the same capacity @ref merge into a sketch of both streams with the same guarantees, adding the
+	/// counts of keys in both and charging keys missing from one sketch that sketch's smallest count.
+	/// @tparam Key The key type, must be copyable and equality comparable.
+	/// @tparam Hasher The hasher used to hash keys in the counter map.
+	template <std::copyable Key, hasher Hasher = mclo::rapidhash>
+		requires( hashable_with<Key, Hasher> && std::default_initializable<Hasher> && std::equality_comparable<Key> )
+	class space_saving_sketch
+	{
+	public:
+		using key_type = Key;
+		using hasher_type = Hasher;
+		using size_type = std::size_t;
+		using count_type = std::uint64_t;
+
+		/// @brief A counted key.
+		struct entry
+		{
+			/// @brief The key.
+			Key key;
+
+			/// @brief The estimated count, at least the true count.
+			count_type count;
+
+			/// @brief The largest amount @ref count may overestimate by.
+			count_type error;
+
+			[[nodiscard]] friend bool operator==( const entry&, const entry& ) = default;
+		};
+
+		/// @brief Construct an empty sketch.
+		/// @param capacity The number of counters, must not be zero.
+		explicit space_saving_sketch( const size_type capacity )
+			: m_capacity( capacity )
+		{
+			MCLO_DEBUG_ASSERT( capacity != 0, "A Space-Saving sketch needs counters" );
+			m_heap.reserve( capacity );
+			m_positions.reserve( capacity );
+		}
+
+		space_saving_sketch( const space_saving_sketch& other )
+			: m_capacity( other.m_capacity )
+			, m_total( other.m_total )
+		{
+			m_heap.reserve( m_capacity );
+			m_positions.reserve( m_capacity );
+			rebuild( other.unordered_entries() );
+		}
+
+		space_saving_sketch( space_saving_sketch&& other ) = default;
+
+		space_saving_sketch& operator=( const space_saving_sketch& other )
+		{
+			if ( this != &other )
+			{
+				space_saving_sketch copy( other );
+				*this = std::move( copy );
+			}
+			return *this;
+		}
+
+		space_saving_sketch& operator=( space_saving_sketch&& other ) = default;
+
+		/// @brief Add to the count of a key.
+		/// @param key The key to count.
+		/// @param count The number of occurrences to add.
+		void insert( const Key& key, const count_type count = 1 )
+		{
+			m_total += count;
+			if ( const auto it = m_positions.find( key ); it != m_positions.end() )
+			{
+				m_heap[ it->second ].count += count;
+				sift_down( it->second );
+				return;
+			}
+			if ( m_heap.size() < m_capacity )
+			{
+				const auto it = m_positions.emplace( key, m_heap.size() ).first;
+				m_heap.push_back( { count, 0, it } );
+				sift_up( m_heap.size() - 1 );
+				return;
+			}
+
+			// Replace the smallest counter, whose count may all have belonged to other keys. Its map node is reused
+			// for the new key so a steady stream of new keys does not allocate.
+			counter& smallest = m_heap.front();
+			auto node = m_positions.extract( smallest.position );
+			node.key() = key;
+			smallest.position = m_positions.insert( std::move( node ) ).position;
+			smallest.error = smallest.count;
+			smallest.count += count;
+			sift_down( 0 );
+		}
+
+		/// @brief Estimate the count of a key.
+		/// @return The count of @p key if it has a counter, otherwise the most it can have occurred.
+		[[nodiscard]] count_type estimate( const Key& key ) const
+		{
+			if ( const auto it = m_positions.find( key ); it != m_positions.end() )
+			{
+				return m_heap[ it->second ].count;
+			}
+			return min_count();
+		}
+
+		/// @brief Get the counted keys with the highest counts.
+		/// @param k The maximum number of keys to return.
+		/// @return Up to @p k entries, highest count first.
+		[[nodiscard]] std::vector<entry> top( const size_type k ) const
+		{
+			std::vector<entry> result = unordered_entries();
+			const size_type size = std::min( k, result.size() );
+			std::partial_sort( result.begin(), result.begin() + size, result.end(), higher_count );
+			result.resize( size );
+			return result;
+		}
+
+		/// @brief Get every counted key, highest count first.
+		[[nodiscard]] std::vector<entry> entries() const
+		{
+			return top( m_heap.size() );
+		}
+
+		/// @brief Merge another sketch into this one, giving a sketch of both streams.
+		/// @param other The sketch to merge, must have the same capacity.
+		void merge( const space_saving_sketch& other )
+		{
+			MCLO_DEBUG_ASSERT( m_capacity == other.m_capacity,
+							   "Can only merge Space-Saving sketches of the same capacity",
+							   m_capacity,
+							   other.m_capacity );
+
+			// A key missing from a full sketch may have occurred as often as its smallest count
+			const count_type min_this = min_count();
+			const count_type min_other = other.min_count();
+
+			std::vector<entry> merged;
+			merged.reserve( m_heap.size() + other.m_heap.size() );
+			for ( const counter& mine : m_heap )
+			{
+				const Key& key = mine.position->first;
+				if ( const auto it = other.m_positions.find( key ); it != other.m_positions.end() )
+				{
+					const counter& theirs = other.m_heap[ it->second ];
+					merged.push_back( { key, mine.count + theirs.count, mine.error + theirs.error } );
+				}
+				else
+				{
+					merged.push_back( { key, mine.count + min_other, mine.error + min_other } );
+				}
+			}
+			for ( const counter& theirs : other.m_heap )
+			{
+				const Key& key = theirs.position->first;
+				if ( !m_positions.contains( key ) )
+				{
+					merged.push_back( { key, theirs.count + min_this, theirs.error + min_this } );
+				}
+			}
+
+			if ( merged.size() > m_capacity )
+			{
+				std::nth_element( merged.begin(), merged.begin() + m_capacity, merged.end(), higher_count );
+				merged.resize( m_capacity );
+			}
+			m_total += other.m_total;
+			rebuild( merged );
+		}
+
+		/// @brief Remove every key.
+		void clear() noexcept
+		{
+			m_heap.clear();
+			m_positions.clear();
+			m_total = 0;
+		}
+
+		/// @brief Get the number of counted keys.
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_heap.size();
+		}
+
+		/// @brief Get the number of counters.
+		[[nodiscard]] size_type capacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		/// @brief Get the sum of every count added.
+		[[nodiscard]] count_type total() const noexcept
+		{
+			return m_total;
+		}
+
+	private:
+		using position_map = std::unordered_map<Key, size_type, mclo::hash<Key, Hasher>>;
+
+		/// @brief A heap slot, the key lives in its map node which holds the slot's index
+		struct counter
+		{
+			count_type count;
+			count_type error;
+			typename position_map::iterator position;
+		};
+
+		[[nodiscard]] static bool higher_count( const entry& lhs, const entry& rhs ) noexcept
+		{
+			return lhs.count > rhs.count;
+		}
+
+		/// @brief The smallest count once every counter is in use, a key without a counter occurred at most this often
+		[[nodiscard]] count_type min_count() const noexcept
+		{
+			return m_heap.size() < m_capacity ? 0 : m_heap.front().count;
+		}
+
+		[[nodiscard]] std::vector<entry> unordered_entries() const
+		{
+			std::vector<entry> result;
+			result.reserve( m_heap.size() );
+			for ( const counter& slot : m_heap )
+			{
+				result.push_back( { slot.position->first, slot.count, slot.error } );
+			}
+			return result;
+		}
+
+		void rebuild( const std::vector<entry>& entries )
+		{
+			m_heap.clear();
+			m_positions.clear();
+			for ( const entry& counted : entries )
+			{
+				const auto it = m_positions.emplace( counted.key, m_heap.size() ).first;
+				m_heap.push_back( { counted.count, counted.error, it } );
+				sift_up( m_heap.size() - 1 );
+			}
+		}
+
+		void move_to( const counter& slot, const size_type index ) noexcept
+		{
+			m_heap[ index ] = slot;
+			slot.position->second = index;
+		}
+
+		void sift_up( size_type index ) noexcept
+		{
+			const counter slot = m_heap[ index ];
+			while ( index != 0 )
+			{
+				const size_type parent = ( index - 1 ) / 2;
+				if ( m_heap[ parent ].count <= slot.count )
+				{
+					break;
+				}
+				move_to( m_heap[ parent ], index );
+				index = parent;
+			}
+			move_to( slot, index );
+		}
+
+		void sift_down( size_type index ) noexcept
+		{
+			const counter slot = m_heap[ index ];
+			const size_type size = m_heap.size();
+			for ( ;; )
+			{
+				size_type child = index * 2 + 1;
+				if ( child >= size )
+				{
+					break;
+				}
+				if ( child + 1 < size && m_heap[ child + 1 ].count < m_heap[ child ].count )
+				{
+					++child;
+				}
+				if ( slot.count <= m_heap[ child ].count )
+				{
+					break;
+				}
+				move_to( m_heap[ child ], index );
+				index = child;
+			}
+			move_to( slot, index );
+		}
+
+		std::vector<counter> m_heap;
+		position_map m_positions;
+		size_type m_capacity;
+		count_type m_total = 0;
+	};
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/platform/attributes.hpp"
+#include "mclo/platform/warnings.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mclo
+{
+	MCLO_DISABLE_WARNINGS( MCLO_WARNING_ALIGNMENT_PADDING )
+	/// @brief A fixed capacity lock-free ring for handing values from one producer thread to one consumer thread.
+	/// @details The concurrent counterpart of @ref circular_buffer. Head and tail are free running counters, each
+	/// written by only one side and each on its own cache line alongside that side's cached copy of the other counter,
+	/// so the shared counter is only reloaded when the cached copy says the ring looks full or empty.
+	///
+	/// Unlike @ref circular_buffer a full ring rejects pushes instead of overwriting, the consumer may still be reading
+	/// the oldest values.
+	///
+	/// Bulk operations work a contiguous segment at a time. Producers of trivially copyable values can also write into
+	/// the ring in place with @ref writable_spans and @ref commit_write, such as by passing the segments to @c read(),
+	/// and consumers can read in place with @ref readable_spans and @ref commit_read.
+	/// @warning Producer functions must only be called from one thread at a time, as must consumer functions.
+	/// @tparam T The type of values.
+	/// @tparam Allocator The allocator for the ring storage.
+	template <typename T, typename Allocator = std::allocator<T>>
+	class spsc_circular_buffer
+	{
+		using alloc_traits = std::allocator_traits<Allocator>;
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using allocator_type = Allocator;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+		/// @brief Construct an empty ring.
+		/// @param capacity The minimum number of values the ring can hold, rounded up to the next power of two.
+		/// @param alloc The allocator to use.
+		explicit spsc_circular_buffer( const size_type capacity, const allocator_type& alloc = allocator_type() )
+			: m_allocator( alloc )
+			, m_mask( std::bit_ceil( std::max<size_type>( capacity, 1 ) ) - 1 )
+			, m_data( m_allocator.allocate( m_mask + 1 ) )
+		{
+		}
+
+		spsc_circular_buffer( const spsc_circular_buffer& ) = delete;
+		spsc_circular_buffer& operator=( const spsc_circular_buffer& ) = delete;
+
+		~spsc_circular_buffer()
+		{
+			m_cached_tail = m_tail.load( std::memory_order_acquire );
+			commit_read( m_cached_tail - m_head.load( std::memory_order_relaxed ) );
+			m_allocator.deallocate( m_data, capacity() );
+		}
+
+		/// @brief Get the number of values the ring can hold.
+		[[nodiscard]] size_type capacity() const noexcept
+		{
+			return m_mask + 1;
+		}
+
+		/// @brief Get the number of values in the ring.
+		/// @warning Approximate as the other side may be modifying the ring concurrently.
+		[[nodiscard]] size_type size() const noexcept
+		{
+			const size_type head = m_head.load( std::memory_order_acquire );
+			const size_type tail = m_tail.load( std::memory_order_acquire );
+			return tail - head;
+		}
+
+		/// @brief Check if the ring is empty.
+		/// @warning Approximate as the other side may be modifying the ring concurrently.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return m_allocator;
+		}
+
+		// Producer
+
+		/// @brief Construct a value at the back of the ring if there is space.
+		/// @param args Arguments to construct the value with.
+		/// @return True if the value was pushed, false if the ring was full.
+		template <typename... Args>
+		bool try_emplace_back( Args&&... args )
+		{
+			const size_type tail = m_tail.load( std::memory_order_relaxed );
+			if ( writable_count( tail, 1 ) == 0 )
+			{
+				return false;
+			}
+			alloc_traits::construct( m_allocator, m_data + ( tail & m_mask ), std::forward<Args>( args )... );
+			m_tail.store( tail + 1, std::memory_order_release );
+			return true;
+		}
+
+		/// @copydoc try_emplace_back
+		bool try_push_back( const T& value )
+		{
+			return try_emplace_back( value );
+		}
+
+		/// @copydoc try_emplace_back
+		bool try_push_back( T&& value )
+		{
+			return try_emplace_back( std::move( value ) );
+		}
+
+		/// @brief Copy as many values as there is space for onto the back of the ring.
+		/// @details Values are copied a contiguous segment at a time and published to the consumer together.
+		/// @param values The values to push, pushed in order from the front.
+		/// @return The number of values pushed.
+		size_type push_back_n( mclo::span<const value_type> values )
+		{
+			const size_type tail = m_tail.load( std::memory_order_relaxed );
+			const size_type num_pushed = std::min( writable_count( tail, values.size() ), values.size() );
+			const auto [ first, second ] = segments( tail, num_pushed );
+			std::uninitialized_copy_n( values.data(), first.size(), first.data() );
+			try
+			{
+				std::uninitialized_copy_n( values.data() + first.size(), second.size(), second.data() );
+			}
+			catch ( ... )
+			{
+				std::destroy( first.begin(), first.end() );
+				throw;
+			}
+			m_tail.store( tail + num_pushed, std::memory_order_release );
+			return num_pushed;
+		}
+
+		/// @brief Get the free space at the back of the ring to write values into in place.
+		/// @details Publish written values with @ref commit_write. The first segment is filled before the second.
+		/// @return The free space as up to two contiguous segments, the second empty unless the space wraps around.
+		[[nodiscard]] std::pair<span<value_type>, span<value_type>> writable_spans() noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			const size_type tail = m_tail.load( std::memory_order_relaxed );
+			return segments( tail, writable_count( tail, capacity() ) );
+		}
+
+		/// @brief Publish values written in place to the consumer.
+		/// @param count The number of values written to the start of @ref writable_spans.
+		void commit_write( const size_type count ) noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			const size_type tail = m_tail.load( std::memory_order_relaxed );
+			MCLO_DEBUG_ASSERT( count <= capacity() - ( tail - m_cached_head ), "Committing more than was writable" );
+			m_tail.store( tail + count, std::memory_order_release );
+		}
+
+		// Consumer
+
+		/// @brief Pop the value at the front of the ring if there is one.
+		/// @return The value, or std::nullopt if the ring was empty.
+		[[nodiscard]] std::optional<value_type> try_pop_front() noexcept(
+			std::is_nothrow_move_constructible_v<value_type> )
+		{
+			const size_type head = m_head.load( std::memory_order_relaxed );
+			if ( readable_count( head, 1 ) == 0 )
+			{
+				return std::nullopt;
+			}
+			const pointer value = m_data + ( head & m_mask );
+			std::optional<value_type> result( std::move( *value ) );
+			alloc_traits::destroy( m_allocator, value );
+			m_head.store( head + 1, std::memory_order_release );
+			return result;
+		}
+
+		/// @brief Move values from the front of the ring into out and pop them, a contiguous segment at a time.
+		/// @param out Where to move the values to, at most out.size() values are popped.
+		/// @return The number of values popped.
+		size_type pop_front_n( const mclo::span<value_type> out ) noexcept(
+			std::is_nothrow_move_assignable_v<value_type> )
+		{
+			const size_type head = m_head.load( std::memory_order_relaxed );
+			const size_type num_popped = std::min( readable_count( head, out.size() ), out.size() );
+			const auto [ first, second ] = segments( head, num_popped );
+			std::move( first.begin(), first.end(), out.data() );
+			std::move( second.begin(), second.end(), out.data() + first.size() );
+			commit_read( num_popped );
+			return num_popped;
+		}
+
+		/// @brief Get the values at the front of the ring to read in place.
+		/// @details Pop read values with @ref commit_read.
+		/// @return The values as up to two contiguous segments in order, the second empty unless they wrap around.
+		[[nodiscard]] std::pair<span<value_type>, span<value_type>> readable_spans() noexcept
+		{
+			const size_type head = m_head.load( std::memory_order_relaxed );
+			return segments( head, readable_count( head, capacity() ) );
+		}
+
+		/// @brief Destroy and pop values from the front of the ring, freeing their space for the producer.
+		/// @param count The number of values to pop from the start of @ref readable_spans.
+		void commit_read( const size_type count ) noexcept
+		{
+			const size_type head = m_head.load( std::memory_order_relaxed );
+			MCLO_DEBUG_ASSERT( count <= m_cached_tail - head, "Committing more than was readable" );
+			if constexpr ( !std::is_trivially_destructible_v<value_type> )
+			{
+				const auto [ first, second ] = segments( head, count );
+				std::destroy( first.begin(), first.end() );
+				std::destroy( second.begin(), second.end() );
+			}
+			m_head.store( head + count, std::memory_order_release );
+		}
+
+	private:
+		/// @brief Get the free space for the producer, only reloading the shared head when the cached one says there
+		/// is less than wanted
+		[[nodiscard]] size_type writable_count( const size_type tail, const size_type wanted ) noexcept
+		{
+			size_type free = capacity() - ( tail - m_cached_head );
+			if ( free < wanted )
+			{
+				m_cached_head = m_head.load( std::memory_order_acquire );
+				free = capacity() - ( tail - m_cached_head );
+			}
+			return free;
+		}
+
+		/// @brief Get the number of values for the consumer, only reloading the shared tail when the cached one says
+		/// there are fewer than wanted
+		[[nodiscard]] size_type readable_count( const size_type head, const size_type wanted ) noexcept
+		{
+			size_type available = m_cached_tail - head;
+			if ( available < wanted )
+			{
+				m_cached_tail = m_tail.load( std::memory_order_acquire );
+				available = m_cached_tail - head;
+			}
+			return available;
+		}
+
+		/// @brief Split count slots starting at the free running position into contiguous segments
+		[[nodiscard]] std::pair<span<value_type>, span<value_type>> segments( const size_type position,
+																			   const size_type count ) const noexcept
+		{
+			const size_type index = position & m_mask;
+			const size_type first_count = std::min( count, capacity() - index );
+			return { span<value_type>( m_data + index, first_count ), span<value_type>( m_data, count - first_count ) };
+		}
+
+		// Read only after construction so shared by both sides without contention
+		MCLO_NO_UNIQUE_ADDRESS allocator_type m_allocator;
+		size_type m_mask = 0;
+		pointer m_data = nullptr;
+
+		// Consumer side
+		alignas( std::hardware_destructive_interference_size ) std::atomic<size_type> m_head{ 0 };
+		size_type m_cached_tail = 0;
+
+		// Producer side
+		alignas( std::hardware_destructive_interference_size ) std::atomic<size_type> m_tail{ 0 };
+		size_type m_cached_head = 0;
+	};
+	MCLO_RESTORE_WARNINGS
+}
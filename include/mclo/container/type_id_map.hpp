@@ -0,0 +1,231 @@
+#pragma once
+
+#include "mclo/container/flat_type_id_set.hpp"
+#include "mclo/container/span.hpp"
+#include "mclo/debug/assert.hpp"
+#include "mclo/meta/type_id.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief A map from types to values, keyed by type rather than by a runtime value.
+	/// @details The map counterpart of @ref type_id_set. Values are stored densely in the same order as the keys of a
+	/// @ref type_id_hash_index, so a lookup is usually one probe of the index and one array access.
+	///
+	/// Erasing moves the last entry into the erased one's place, so erasing invalidates references to the last value.
+	/// @tparam Value The mapped value type.
+	/// @tparam Allocator The allocator for the values, rebound for the index.
+	template <typename Value, typename Allocator = std::allocator<Value>>
+	class type_id_map
+	{
+		using index_type =
+			type_id_hash_index<typename std::allocator_traits<Allocator>::template rebind_alloc<meta::type_id_t>>;
+
+	public:
+		using key_type = meta::type_id_t;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using allocator_type = Allocator;
+
+		type_id_map() = default;
+
+		explicit type_id_map( const allocator_type& alloc )
+			: m_index( alloc )
+			, m_values( alloc )
+		{
+		}
+
+		/// @brief Constructs the value for type @p T in place if @p T is not present.
+		/// @tparam T The type to key the value by.
+		/// @param args Arguments to construct the value with.
+		/// @return The value for @p T, and true if it was inserted or false if it was already present.
+		template <typename T, typename... Args>
+		std::pair<mapped_type&, bool> try_emplace( Args&&... args )
+		{
+			return try_emplace( meta::type_id<T>, std::forward<Args>( args )... );
+		}
+
+		/// @brief Constructs the value for the type with identity id in place if it is not present.
+		/// @param id The identity of the type to key the value by.
+		/// @param args Arguments to construct the value with.
+		/// @return The value for the type, and true if it was inserted or false if it was already present.
+		template <typename... Args>
+		std::pair<mapped_type&, bool> try_emplace( const key_type id, Args&&... args )
+		{
+			const auto [ it, inserted ] = m_index.insert( id );
+			if ( !inserted )
+			{
+				return { m_values[ static_cast<size_type>( it - m_index.begin() ) ], false };
+			}
+			try
+			{
+				m_values.emplace_back( std::forward<Args>( args )... );
+			}
+			catch ( ... )
+			{
+				m_index.erase( id );
+				throw;
+			}
+			return { m_values.back(), true };
+		}
+
+		/// @brief Sets the value for type @p T, inserting it if @p T is not present.
+		/// @return True if the value was inserted, false if an existing value was assigned.
+		template <typename T, typename V>
+		bool insert_or_assign( V&& value )
+		{
+			auto [ existing, inserted ] = try_emplace<T>( std::forward<V>( value ) );
+			if ( !inserted )
+			{
+				existing = std::forward<V>( value );
+			}
+			return inserted;
+		}
+
+		/// @brief Finds the value for type @p T.
+		/// @return The value, or nullptr if @p T is not present.
+		template <typename T>
+		[[nodiscard]] mapped_type* find() noexcept
+		{
+			return find( meta::type_id<T> );
+		}
+		/// @copydoc find()
+		template <typename T>
+		[[nodiscard]] const mapped_type* find() const noexcept
+		{
+			return find( meta::type_id<T> );
+		}
+
+		/// @brief Finds the value for the type with identity id, for dispatching on identities only known at runtime.
+		/// @return The value, or nullptr if the type is not present.
+		[[nodiscard]] mapped_type* find( const key_type id ) noexcept
+		{
+			const size_type index = m_index.index_of( id );
+			return index != index_type::npos ? &m_values[ index ] : nullptr;
+		}
+		/// @copydoc find( key_type )
+		[[nodiscard]] const mapped_type* find( const key_type id ) const noexcept
+		{
+			const size_type index = m_index.index_of( id );
+			return index != index_type::npos ? &m_values[ index ] : nullptr;
+		}
+
+		/// @brief Gets the value for type @p T, which must be present.
+		template <typename T>
+		[[nodiscard]] mapped_type& get() noexcept
+		{
+			mapped_type* const value = find<T>();
+			MCLO_DEBUG_ASSERT( value, "Type is not in the type_id_map" );
+			return *value;
+		}
+		/// @copydoc get()
+		template <typename T>
+		[[nodiscard]] const mapped_type& get() const noexcept
+		{
+			const mapped_type* const value = find<T>();
+			MCLO_DEBUG_ASSERT( value, "Type is not in the type_id_map" );
+			return *value;
+		}
+
+		/// @brief Checks whether the identities of all of @p Ts are in the map.
+		/// @details Every lookup is made without short circuiting, as in @ref type_id_set.
+		template <typename... Ts>
+			requires( sizeof...( Ts ) > 0 )
+		[[nodiscard]] bool contains() const noexcept
+		{
+			return ( m_index.contains( meta::type_id<Ts> ) & ... );
+		}
+
+		/// @brief Checks whether the type with identity id is in the map.
+		[[nodiscard]] bool contains( const key_type id ) const noexcept
+		{
+			return m_index.contains( id );
+		}
+
+		/// @brief Erases the value for type @p T.
+		/// @return True if @p T was present and erased.
+		template <typename T>
+		bool erase() noexcept( std::is_nothrow_move_assignable_v<mapped_type> )
+		{
+			return erase( meta::type_id<T> );
+		}
+
+		/// @brief Erases the value for the type with identity id.
+		/// @return True if the type was present and erased.
+		bool erase( const key_type id ) noexcept( std::is_nothrow_move_assignable_v<mapped_type> )
+		{
+			const size_type index = m_index.index_of( id );
+			if ( index == index_type::npos )
+			{
+				return false;
+			}
+
+			// Mirror the index, which moves its last key into the erased one's place
+			if ( index != m_values.size() - 1 )
+			{
+				m_values[ index ] = std::move( m_values.back() );
+			}
+			m_values.pop_back();
+			m_index.erase( id );
+			return true;
+		}
+
+		/// @brief Reserves storage for count values so inserting up to count does not allocate.
+		void reserve( const size_type count )
+		{
+			m_index.reserve( count );
+			m_values.reserve( count );
+		}
+
+		void clear() noexcept
+		{
+			m_index.clear();
+			m_values.clear();
+		}
+
+		void swap( type_id_map& other ) noexcept
+		{
+			m_index.swap( other.m_index );
+			m_values.swap( other.m_values );
+		}
+
+		friend void swap( type_id_map& lhs, type_id_map& rhs ) noexcept
+		{
+			lhs.swap( rhs );
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_values.empty();
+		}
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return m_values.size();
+		}
+
+		/// @brief Returns the identities of the types in the map, @c keys()[ i ] is the key of @c values()[ i ].
+		[[nodiscard]] mclo::span<const key_type> keys() const noexcept
+		{
+			return m_index.keys();
+		}
+
+		/// @brief Returns the values in the map, @c values()[ i ] is the value of @c keys()[ i ].
+		[[nodiscard]] mclo::span<mapped_type> values() noexcept
+		{
+			return { m_values.data(), m_values.size() };
+		}
+		/// @copydoc values()
+		[[nodiscard]] mclo::span<const mapped_type> values() const noexcept
+		{
+			return { m_values.data(), m_values.size() };
+		}
+
+	private:
+		index_type m_index;
+		std::vector<mapped_type, Allocator> m_values;
+	};
+}
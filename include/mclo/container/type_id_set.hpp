@@ -12,7 +12,8 @@ namespace mclo
 	/// mclo::meta::type_id lookup is generated by the compiler. Useful for tracking which types are present, such as a
 	/// set of component or event types.
 	/// @note If the domain of types is fixed and known up front, prefer assigning each type an enumerator and using an
-	/// @ref mclo::enum_set, which is far more efficient than a set of runtime type identities.
+	/// @ref mclo::enum_set, which is far more efficient than a set of runtime type identities. For sets queried far
+	/// more often than they are modified, such as registries checked on every dispatch, prefer @ref flat_type_id_set.
 	/// @tparam Container The underlying set container; its key type must be @ref mclo::meta::type_id_t.
 	template <typename Container = std::unordered_set<meta::type_id_t>>
 	class type_id_set
@@ -58,13 +59,15 @@ namespace mclo
 		}
 
 		/// @brief Checks whether the identities of all of @p Ts are in the set.
+		/// @details Every lookup is made without short circuiting, so they are independent and overlap instead of each
+		/// waiting on the branch of the one before.
 		/// @tparam Ts The types whose identities to look for.
 		/// @return @c true only if every type in @p Ts is present.
 		template <typename... Ts>
 			requires( sizeof...( Ts ) > 1 )
 		[[nodiscard]] bool contains() const noexcept
 		{
-			return ( contains<Ts>() && ... );
+			return ( contains<Ts>() & ... );
 		}
 
 		/// @brief Removes all type identities from the set.
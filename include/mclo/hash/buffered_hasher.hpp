@@ -0,0 +1,105 @@
+#pragma once
+
+#include "mclo/container/span.hpp"
+#include "mclo/hash/hasher.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace mclo
+{
+	/// @brief A hasher adaptor that gathers small writes into a block on the stack before passing them on.
+	/// @details Hashing a type with many small members makes a @c write per member, each paying the per call cost of
+	/// @p Hasher. This adaptor copies writes into a buffer instead and only writes whole blocks of @p BlockSize bytes
+	/// to @p Hasher, plus whatever is left over on @c finish. Writes of a block or more skip the buffer, writing their
+	/// whole blocks straight from the source.
+	///
+	/// Blocks are always cut at the same offsets of the stream, so the result only depends on the bytes written and
+	/// not on how they were split between writes. For hashers that already behave that way, such as
+	/// @ref murmur_hash_3 and @ref xxhash_64, the result is the same as the unbuffered hasher. Others, such as
+	/// @ref rapidhash, give a different result to the unbuffered hasher as it depends on where writes are split.
+	/// @tparam Hasher The hasher to buffer writes for.
+	/// @tparam BlockSize The size in bytes of the blocks written to @p Hasher.
+	template <hasher Hasher, std::size_t BlockSize = 64>
+	class buffered_hasher
+	{
+		static_assert( BlockSize > 0, "Blocks must not be empty" );
+
+	public:
+		/// @brief Default constructs the underlying hasher.
+		buffered_hasher() noexcept( std::is_nothrow_default_constructible_v<Hasher> )
+			requires std::default_initializable<Hasher>
+		= default;
+
+		/// @brief Constructs the underlying hasher from @p args, e.g. a seed.
+		/// @param arg The first argument forwarded to the hasher's constructor.
+		/// @param args The remaining arguments forwarded to the hasher's constructor.
+		template <typename Arg, typename... Args>
+			requires( !std::same_as<std::remove_cvref_t<Arg>, buffered_hasher> &&
+					  std::constructible_from<Hasher, Arg, Args...> )
+		explicit buffered_hasher( Arg&& arg,
+								  Args&&... args ) noexcept( std::is_nothrow_constructible_v<Hasher, Arg, Args...> )
+			: m_hasher( std::forward<Arg>( arg ), std::forward<Args>( args )... )
+		{
+		}
+
+		/// @brief Buffers @p data, writing every block it fills to the underlying hasher.
+		/// @param data The bytes to hash.
+		void write( const mclo::span<const std::byte> data ) noexcept
+		{
+			const std::size_t free = BlockSize - m_size;
+			if ( data.size() < free ) [[likely]]
+			{
+				copy_to_buffer( data.data(), data.size() );
+				return;
+			}
+
+			const std::byte* source = data.data();
+			std::size_t remaining = data.size();
+			if ( m_size != 0 )
+			{
+				copy_to_buffer( source, free );
+				m_hasher.write( m_buffer );
+				source += free;
+				remaining -= free;
+				m_size = 0;
+			}
+			for ( ; remaining >= BlockSize; source += BlockSize, remaining -= BlockSize )
+			{
+				m_hasher.write( { source, BlockSize } );
+			}
+			copy_to_buffer( source, remaining );
+		}
+
+		/// @brief Writes any buffered bytes to the underlying hasher then finalises it.
+		/// @return The hash of the underlying hasher.
+		[[nodiscard]] std::size_t finish() noexcept
+		{
+			if ( m_size != 0 )
+			{
+				m_hasher.write( { m_buffer.data(), m_size } );
+				m_size = 0;
+			}
+			return m_hasher.finish();
+		}
+
+	private:
+		void copy_to_buffer( const std::byte* const source, const std::size_t size ) noexcept
+		{
+			// Empty writes may come from empty ranges whose data is null, which memcpy does not allow
+			if ( size != 0 )
+			{
+				std::memcpy( m_buffer.data() + m_size, source, size );
+				m_size += size;
+			}
+		}
+
+		Hasher m_hasher;
+		std::size_t m_size = 0;
+		std::array<std::byte, BlockSize> m_buffer;
+	};
+}
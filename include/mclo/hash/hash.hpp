@@ -4,8 +4,14 @@
 #include "mclo/hash/hash_append_range.hpp"
 #include "mclo/hash/rapidhash.hpp"
 
+#include "mclo/debug/assert.hpp"
 #include "mclo/platform/attributes.hpp"
 
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
 namespace mclo
 {
 	/// @brief A hash functor compatible with the standard library's hash-based containers.
@@ -61,4 +67,49 @@ namespace mclo
 		hash_append_range( h, std::forward<Range>( range ) );
 		return h.finish();
 	}
+
+	namespace detail
+	{
+		template <typename Hasher, typename... Args>
+		concept batch_hasher = requires( const mclo::span<const std::byte> data,
+										 const std::size_t key_size,
+										 const mclo::span<std::size_t> hashes,
+										 Args&&... args ) {
+			Hasher::hash_many( data, key_size, hashes, std::forward<Args>( args )... );
+		};
+	}
+
+	/// @brief Computes the hash of every element of a range, each the same as @ref hash_object would give it.
+	/// @details When the range is contiguous, its elements are @ref is_contiguously_hashable and @p Hasher provides a
+	/// static @c hash_many taking the keys as packed bytes then the constructor arguments, the whole range is handed
+	/// to it to hash in bulk. Otherwise each element is hashed by @ref hash_object in turn.
+	/// @tparam Hasher The hasher algorithm to use, defaulting to @ref rapidhash.
+	/// @param values The range of elements to hash.
+	/// @param hashes Where to write the hash of each element, at least as many as there are elements.
+	/// @param args Arguments forwarded to the hasher's constructor, e.g. a seed.
+	template <hasher Hasher = mclo::rapidhash, std::ranges::forward_range Range, typename... Args>
+		requires( hashable_with<std::ranges::range_value_t<Range>, Hasher> && std::is_constructible_v<Hasher, Args...> )
+	void hash_many( Range&& values, const mclo::span<std::size_t> hashes, Args&&... args ) noexcept(
+		std::is_nothrow_constructible_v<Hasher, Args...> )
+	{
+		using value_type = std::ranges::range_value_t<Range>;
+		MCLO_DEBUG_ASSERT( hashes.size() >= static_cast<std::size_t>( std::ranges::distance( values ) ),
+						   "Not enough space for the hashes" );
+		if constexpr ( std::ranges::contiguous_range<Range> && is_contiguously_hashable_v<value_type> &&
+					   detail::batch_hasher<Hasher, Args...> )
+		{
+			Hasher::hash_many( mclo::as_bytes( mclo::span( values ) ),
+							   sizeof( value_type ),
+							   hashes,
+							   std::forward<Args>( args )... );
+		}
+		else
+		{
+			std::size_t index = 0;
+			for ( const auto& value : values )
+			{
+				hashes[ index++ ] = hash_object<Hasher>( value, args... );
+			}
+		}
+	}
 }
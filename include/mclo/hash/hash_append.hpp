@@ -2,6 +2,9 @@
 
 #include "mclo/hash/hasher.hpp"
 
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <type_traits>
 
 namespace mclo
@@ -27,6 +30,95 @@ namespace mclo
 		hash_append( hasher, value );
 	}
 
+	/// @brief Trait for types whose @ref hash_append writes exactly their object bytes in a single write.
+	/// @details Lets bulk hashing such as @ref hash_many hash many values as raw bytes without calling
+	/// @ref hash_append on each one. True for integers, enums and pointers with unique object representations and
+	/// arrays of them. Specialize it as true for other types only if their @ref hash_append is the default bitwise one.
+	/// @tparam T The type to query.
+	template <typename T>
+	struct is_contiguously_hashable
+		: std::bool_constant<std::has_unique_object_representations_v<T> &&
+							 ( std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> )>
+	{
+	};
+
+	template <typename T, std::size_t N>
+	struct is_contiguously_hashable<T[ N ]> : is_contiguously_hashable<T>
+	{
+	};
+
+	template <typename T, std::size_t N>
+	struct is_contiguously_hashable<std::array<T, N>>
+		: std::bool_constant<is_contiguously_hashable<T>::value && sizeof( std::array<T, N> ) == sizeof( T ) * N>
+	{
+	};
+
+	template <typename T>
+	inline constexpr bool is_contiguously_hashable_v = is_contiguously_hashable<T>::value;
+
+	namespace detail
+	{
+		/// @brief Bytes of fields found to be adjacent in memory, written as one once the run ends
+		struct field_run
+		{
+			const std::byte* data = nullptr;
+			std::size_t size = 0;
+		};
+
+		template <hasher Hasher>
+		void end_field_run( Hasher& hasher, field_run& run ) noexcept
+		{
+			if ( run.size != 0 )
+			{
+				hasher.write( { run.data, run.size } );
+				run.size = 0;
+			}
+		}
+
+		template <hasher Hasher, typename T>
+		void append_field( Hasher& hasher, field_run& run, const T& field ) noexcept
+		{
+			if constexpr ( is_contiguously_hashable_v<T> )
+			{
+				const auto* const bytes = reinterpret_cast<const std::byte*>( std::addressof( field ) );
+				if ( run.size != 0 && run.data + run.size == bytes )
+				{
+					run.size += sizeof( T );
+				}
+				else
+				{
+					end_field_run( hasher, run );
+					run = { bytes, sizeof( T ) };
+				}
+			}
+			else
+			{
+				end_field_run( hasher, run );
+				hash_append( hasher, field );
+			}
+		}
+	}
+
+	/// @brief Feeds each of @p fields into @p hasher, merging neighbouring fields into a single write where it can.
+	/// @details Meant for the @ref hash_append of a type with many small members, which would otherwise make a
+	/// @c write per member. Which fields can merge is decided at compile time: consecutive
+	/// @ref is_contiguously_hashable fields merge when each directly follows the previous one in memory, with no
+	/// padding between them. For members of the same object that check is on constant offsets and compiles away.
+	/// Other fields end the run and are hashed with @ref hash_append as usual.
+	///
+	/// Hashers whose result only depends on the bytes written give the same result as hashing each field in turn.
+	/// For others, like @ref rapidhash, the result depends on the layout of the fields, as the default bitwise
+	/// @ref hash_append already does.
+	/// @param hasher The hasher to write into.
+	/// @param fields The fields to hash, in order.
+	template <hasher Hasher, typename... Ts>
+	void hash_append_fields( Hasher& hasher, const Ts&... fields ) noexcept
+	{
+		detail::field_run run;
+		( detail::append_field( hasher, run, fields ), ... );
+		detail::end_field_run( hasher, run );
+	}
+
 	/// @brief Concept satisfied when @p T can be hashed into @p Hasher via a @c noexcept @ref hash_append.
 	/// @tparam T The type to hash.
 	/// @tparam Hasher The hasher type.
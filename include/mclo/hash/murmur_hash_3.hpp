@@ -20,6 +20,19 @@ namespace mclo
 		{
 		}
 
+		/// @brief Hashes many keys of the same size, each as if by a fresh hasher given one @c write of the key.
+		/// @details Keys of 4, 8, 12 or 16 bytes are hashed a SIMD register of keys at a time, one key per lane, with
+		/// the widest registers the CPU supports, see @ref simd_target. Other sizes and the keys left over are hashed
+		/// one at a time.
+		/// @param data The keys packed back to back, a multiple of @p key_size bytes.
+		/// @param key_size The size of each key in bytes, must not be zero.
+		/// @param hashes Where to write the hash of each key, at least as many as there are keys.
+		/// @param seed The seed value mixed into every hash.
+		static void hash_many( const mclo::span<const std::byte> data,
+							   const std::size_t key_size,
+							   const mclo::span<std::size_t> hashes,
+							   const std::uint32_t seed = 0 ) noexcept;
+
 		/// @brief Mixes @p data into the running hash.
 		/// @param data The bytes to hash.
 		void write( const mclo::span<const std::byte> data ) noexcept;
@@ -13,9 +13,25 @@ namespace mclo
 	class rapidhash
 	{
 	public:
+		/// @brief The seed used when none is given.
+		static constexpr std::uint64_t default_seed = 0xbdd89aa982704029;
+
 		/// @brief Constructs the hasher with an optional seed.
 		/// @param seed The seed value mixed into the hash.
-		rapidhash( const std::uint64_t seed = 0xbdd89aa982704029 ) noexcept;
+		rapidhash( const std::uint64_t seed = default_seed ) noexcept;
+
+		/// @brief Hashes many keys of the same size, each as if by a fresh hasher given one @c write of the key.
+		/// @details The seed mixing done by every @c write is done once for the whole batch, and keys of 4 to 16
+		/// bytes skip the hasher state entirely, with 4, 8, 12 and 16 bytes compiled for their size. Keys are
+		/// independent so the multiplies of neighbouring keys overlap in the pipeline.
+		/// @param data The keys packed back to back, a multiple of @p key_size bytes.
+		/// @param key_size The size of each key in bytes, must not be zero.
+		/// @param hashes Where to write the hash of each key, at least as many as there are keys.
+		/// @param seed The seed value mixed into every hash.
+		static void hash_many( const mclo::span<const std::byte> data,
+							   const std::size_t key_size,
+							   const mclo::span<std::size_t> hashes,
+							   const std::uint64_t seed = default_seed ) noexcept;
 
 		/// @brief Mixes @p data into the running hash.
 		/// @param data The bytes to hash.
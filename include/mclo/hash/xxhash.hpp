@@ -21,6 +21,17 @@ namespace mclo
 		/// @param seed The seed value mixed into the hash.
 		explicit xxhash_64( const XXH64_hash_t seed = 0 ) noexcept;
 
+		/// @brief Hashes many keys of the same size, each as if by a fresh hasher given one @c write of the key.
+		/// @details Uses the one shot XXH64 on each key, which skips buffering the input in the streaming state.
+		/// @param data The keys packed back to back, a multiple of @p key_size bytes.
+		/// @param key_size The size of each key in bytes, must not be zero.
+		/// @param hashes Where to write the hash of each key, at least as many as there are keys.
+		/// @param seed The seed value mixed into every hash.
+		static void hash_many( const mclo::span<const std::byte> data,
+							   const std::size_t key_size,
+							   const mclo::span<std::size_t> hashes,
+							   const XXH64_hash_t seed = 0 ) noexcept;
+
 		/// @brief Mixes @p data into the running hash.
 		/// @param data The bytes to hash.
 		void write( const mclo::span<const std::byte> data ) noexcept;
@@ -43,6 +54,18 @@ namespace mclo
 		/// @param seed The seed value mixed into the hash.
 		explicit xxhash_3( const XXH64_hash_t seed = 0 );
 
+		/// @brief Hashes many keys of the same size, each as if by a fresh hasher given one @c write of the key.
+		/// @details Uses the one shot XXH3 on each key, so no state is allocated and small keys take the dedicated
+		/// short input paths of XXH3.
+		/// @param data The keys packed back to back, a multiple of @p key_size bytes.
+		/// @param key_size The size of each key in bytes, must not be zero.
+		/// @param hashes Where to write the hash of each key, at least as many as there are keys.
+		/// @param seed The seed value mixed into every hash.
+		static void hash_many( const mclo::span<const std::byte> data,
+							   const std::size_t key_size,
+							   const mclo::span<std::size_t> hashes,
+							   const XXH64_hash_t seed = 0 ) noexcept;
+
 		/// @brief Mixes @p data into the running hash.
 		/// @param data The bytes to hash.
 		void write( const mclo::span<const std::byte> data ) noexcept;
@@ -2,6 +2,7 @@
 
 #include "mclo/debug/assert.hpp"
 #include "mclo/hash/hash.hpp"
+#include "mclo/memory/relocate.hpp"
 
 #include <concepts>
 
@@ -282,4 +283,10 @@ namespace mclo
 
 		T* m_ptr = nullptr;
 	};
+
+	/// @brief An intrusive_ptr is only a pointer to the pointee, so can be relocated without touching the count.
+	template <typename T>
+	struct is_trivially_relocatable<intrusive_ptr<T>> : std::true_type
+	{
+	};
 }
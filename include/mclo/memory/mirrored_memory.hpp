@@ -0,0 +1,89 @@
+#pragma once
+
+#include "mclo/utility/expected.hpp"
+
+#include <cstddef>
+#include <system_error>
+#include <utility>
+
+namespace mclo
+{
+	/// @brief An owned region of virtual memory mapped twice back to back onto the same physical pages.
+	/// @details Writing to @c data()[ i ] is visible at @c data()[ i + size() ] and vice versa, so any window of up to
+	/// size() bytes starting in the first half is contiguous even where it wraps past the end, which lets a ring buffer
+	/// hand out views across its wrap point without copying.
+	///
+	/// Uses an anonymous shared memory object mapped twice, @c memfd_create on Linux, @c shm_open on other POSIX
+	/// platforms and a pagefile backed file mapping on Windows. The size is a multiple of @ref granularity.
+	class mirrored_memory
+	{
+	public:
+		/// @brief Constructs an empty region that owns no memory.
+		mirrored_memory() noexcept = default;
+
+		/// @brief Constructs a region of at least min_size bytes.
+		/// @details Equivalent to default construction followed by a call to @ref allocate.
+		/// @param min_size The minimum size in bytes of each half, rounded up to a multiple of @ref granularity.
+		/// @throws std::system_error if the memory could not be mapped.
+		explicit mirrored_memory( std::size_t min_size );
+
+		mirrored_memory( const mirrored_memory& ) = delete;
+		mirrored_memory& operator=( const mirrored_memory& ) = delete;
+
+		mirrored_memory( mirrored_memory&& other ) noexcept
+			: m_data( std::exchange( other.m_data, nullptr ) )
+			, m_size( std::exchange( other.m_size, 0 ) )
+		{
+		}
+
+		mirrored_memory& operator=( mirrored_memory&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				release();
+				m_data = std::exchange( other.m_data, nullptr );
+				m_size = std::exchange( other.m_size, 0 );
+			}
+			return *this;
+		}
+
+		~mirrored_memory()
+		{
+			release();
+		}
+
+		/// @brief Maps a region of at least min_size bytes, replacing any currently owned region.
+		/// @details On failure this object is left empty.
+		/// @param min_size The minimum size in bytes of each half, rounded up to a multiple of @ref granularity.
+		/// @return Nothing on success, or the platform error code describing why mapping failed.
+		expected<void, std::error_code> allocate( std::size_t min_size );
+
+		/// @brief Unmaps the owned region, leaving this object empty.
+		void release() noexcept;
+
+		/// @brief Get the start of the region, the mirror of it begins at data() + size().
+		[[nodiscard]] std::byte* data() const noexcept
+		{
+			return m_data;
+		}
+
+		/// @brief Get the size in bytes of one half of the region.
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return m_size;
+		}
+
+		/// @brief Check if this object owns no memory.
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return m_data == nullptr;
+		}
+
+		/// @brief Get the granularity sizes are rounded up to, the page size or Windows allocation granularity.
+		[[nodiscard]] static std::size_t granularity() noexcept;
+
+	private:
+		std::byte* m_data = nullptr;
+		std::size_t m_size = 0;
+	};
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "mclo/platform/arch_detection.hpp"
+#include "mclo/platform/attributes.hpp"
+#include "mclo/platform/compiler_detection.hpp"
+
+#if defined( MCLO_COMPILER_MSVC ) && defined( MCLO_ARCH_X86 )
+#include <immintrin.h>
+#endif
+
+namespace mclo
+{
+	/// @brief Hints to the CPU that the cache line holding @p address will soon be read.
+	/// @details Issues a software prefetch into all levels of the cache and returns immediately, the load happens in
+	/// the background so independent work can hide its latency. Batched lookups use this to start the memory accesses
+	/// of a group of keys before resolving any of them, so the cache misses overlap instead of stalling one at a time.
+	/// @note Prefetching never faults, @p address may be any value although a useless prefetch still costs bandwidth.
+	/// Does nothing on compilers without a prefetch intrinsic.
+	/// @param address An address in the cache line to fetch.
+	MCLO_FORCE_INLINE void prefetch( [[maybe_unused]] const void* const address ) noexcept
+	{
+#ifdef MCLO_COMPILER_MSVC
+#ifdef MCLO_ARCH_X86
+		_mm_prefetch( static_cast<const char*>( address ), _MM_HINT_T0 );
+#elif defined( MCLO_ARCH_ARM )
+		__prefetch( address );
+#endif
+#elif defined( MCLO_COMPILER_GCC_COMPATIBLE )
+		__builtin_prefetch( address, 0, 3 );
+#endif
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace mclo
+{
+	/// @brief Trait for types that can be relocated, moved to a new address and the original destroyed, by copying
+	/// their bytes.
+	/// @details True by default for types that are trivially move constructible and trivially destructible. Specialize
+	/// to true for types that own a resource through a pointer but never point into themselves, such as
+	/// @ref intrusive_ptr, so containers can @c memcpy them when growing or shifting them instead of moving and
+	/// destroying one at a time.
+	/// @warning A type that stores a pointer into itself, such as @ref small_vector with inline storage, must not be
+	/// marked trivially relocatable.
+	/// @tparam T The type to check.
+	template <typename T>
+	struct is_trivially_relocatable
+		: std::bool_constant<std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>>
+	{
+	};
+
+	template <typename T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	/// @brief Relocate count objects from first into the uninitialized memory at dest, ending their lifetimes at first.
+	/// @details Trivially relocatable types are copied as bytes and the ranges may overlap. Other types are move
+	/// constructed then destroyed one at a time and the ranges must not overlap.
+	/// @param first The start of the objects to relocate.
+	/// @param count The number of objects.
+	/// @param dest The start of the uninitialized memory to relocate to.
+	/// @return The end of the relocated objects at dest.
+	template <typename T>
+	T* uninitialized_relocate_n( T* const first, const std::size_t count, T* const dest ) noexcept(
+		is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T> )
+	{
+		if constexpr ( is_trivially_relocatable_v<T> )
+		{
+			if ( count != 0 )
+			{
+				std::memmove( static_cast<void*>( dest ), static_cast<const void*>( first ), count * sizeof( T ) );
+			}
+			return dest + count;
+		}
+		else
+		{
+			T* const result = std::uninitialized_move_n( first, count, dest ).second;
+			std::destroy_n( first, count );
+			return result;
+		}
+	}
+}
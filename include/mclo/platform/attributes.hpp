@@ -14,7 +14,7 @@
 #define MCLO_DETAIL_NO_UNIQUE_ADDRESS [[no_unique_address]]
 #define MCLO_DETAIL_NO_VTABLE
 #ifdef MCLO_COMPILER_GCC_COMPATIBLE
-#define MCLO_DETAIL_FORCE_INLINE inline [[gnu::always_inline]]
+#define MCLO_DETAIL_FORCE_INLINE [[gnu::always_inline]] inline
 #else
 #define MCLO_DETAIL_FORCE_INLINE inline
 #endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace mclo
+{
+	/// @brief The instruction set extensions of the running CPU that the library can make use of.
+	/// @details Detected once with @c cpuid on first use. The vector extensions also require the operating system to
+	/// save their registers on a context switch, so they are only reported when it does. On other architectures
+	/// everything is false.
+	struct cpu_features
+	{
+		/// @brief SSE2, always present on x86-64.
+		bool sse2 = false;
+
+		/// @brief SSE4.2.
+		bool sse4_2 = false;
+
+		/// @brief AVX2 with operating system support for the 256-bit registers.
+		bool avx2 = false;
+
+		/// @brief BMI2, the @c PEXT and @c PDEP instructions used by @ref bit_compress and @ref bit_expand.
+		bool bmi2 = false;
+
+		/// @brief AVX-512 Foundation with operating system support for the 512-bit and mask registers.
+		bool avx512f = false;
+
+		/// @brief AVX-512 Conflict Detection.
+		bool avx512cd = false;
+
+		/// @brief AVX-512 Doubleword and Quadword, the 32 and 64-bit integer and floating point operations.
+		bool avx512dq = false;
+
+		/// @brief AVX-512 Byte and Word, the 8 and 16-bit integer operations.
+		bool avx512bw = false;
+	};
+
+	/// @brief Get the instruction set extensions of the CPU the process is running on.
+	[[nodiscard]] const cpu_features& host_cpu_features() noexcept;
+
+	/// @brief An instruction set the library's SIMD kernels are compiled for.
+	/// @details The SIMD string and hashing kernels are compiled once per target and the best the CPU supports is
+	/// picked at startup, so a portable build still uses the full vector width of the machine it runs on. Targets
+	/// above @c baseline are only built for x86-64 with @c MCLO_SIMD_DISPATCH enabled.
+	enum class simd_target : std::uint8_t
+	{
+		/// @brief The instruction set the library is built for, SSE2 for a portable x86-64 build.
+		baseline,
+		/// @brief AVX2, 256-bit vectors.
+		avx2,
+		/// @brief AVX-512 Foundation, Conflict Detection, Doubleword and Quadword, and Byte and Word, 512-bit vectors.
+		avx512,
+	};
+
+	/// @brief The number of @ref simd_target values.
+	inline constexpr std::size_t simd_target_count = 3;
+
+	/// @brief Get the display name of a target.
+	[[nodiscard]] std::string_view to_string( simd_target target ) noexcept;
+
+	/// @brief Check if a target is compiled into the library and supported by the CPU.
+	[[nodiscard]] bool is_simd_target_supported( simd_target target ) noexcept;
+
+	/// @brief Get the best target compiled into the library that the CPU supports.
+	[[nodiscard]] simd_target best_simd_target() noexcept;
+
+	/// @brief Get the target the SIMD kernels currently dispatch to, @ref best_simd_target unless changed.
+	[[nodiscard]] simd_target active_simd_target() noexcept;
+
+	/// @brief Change the target the SIMD kernels dispatch to, for benchmarking or testing each target.
+	/// @details Not synchronized with kernels running on other threads, which may finish with either target.
+	/// @param target The target to use, must be supported.
+	/// @return The previously active target.
+	simd_target set_active_simd_target( simd_target target ) noexcept;
+}
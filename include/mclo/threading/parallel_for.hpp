@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace mclo
+{
+	/// @brief Resolve a requested thread count, 0 meaning every hardware thread
+	/// @param num_threads The requested number of threads
+	/// @return The number of threads to use, always at least 1
+	[[nodiscard]] inline std::size_t resolve_thread_count( const std::size_t num_threads ) noexcept
+	{
+		if ( num_threads != 0 )
+		{
+			return num_threads;
+		}
+		return std::max<std::size_t>( std::thread::hardware_concurrency(), 1 );
+	}
+
+	namespace detail
+	{
+		/// @brief Run func( thread_index ) on num_threads threads, the calling thread is thread 0
+		/// @details The first exception thrown by any thread is rethrown on the calling thread once all have joined.
+		template <typename Func>
+		void run_on_threads( const std::size_t num_threads, Func& func )
+		{
+			if ( num_threads <= 1 )
+			{
+				func( std::size_t{ 0 } );
+				return;
+			}
+
+			std::vector<std::exception_ptr> errors( num_threads );
+			const auto run = [ & ]( const std::size_t thread_index ) noexcept {
+				try
+				{
+					func( thread_index );
+				}
+				catch ( ... )
+				{
+					errors[ thread_index ] = std::current_exception();
+				}
+			};
+
+			std::vector<std::thread> threads;
+			threads.reserve( num_threads - 1 );
+			try
+			{
+				for ( std::size_t thread_index = 1; thread_index < num_threads; ++thread_index )
+				{
+					threads.emplace_back( run, thread_index );
+				}
+			}
+			catch ( ... )
+			{
+				// Failed to start a thread, run the rest of the work here instead
+				for ( std::size_t thread_index = threads.size() + 1; thread_index < num_threads; ++thread_index )
+				{
+					run( thread_index );
+				}
+			}
+			run( 0 );
+
+			for ( std::thread& thread : threads )
+			{
+				thread.join();
+			}
+			for ( const std::exception_ptr& error : errors )
+			{
+				if ( error )
+				{
+					std::rethrow_exception( error );
+				}
+			}
+		}
+	}
+
+	/// @brief Split [0, count) into one contiguous chunk per thread and process them in parallel
+	/// @details Chunks are as even as possible, suited to work that costs the same per index. The calling thread
+	/// processes the first chunk. Exceptions thrown by func are rethrown once every chunk is done.
+	/// @param num_threads Number of threads to use, 0 for every hardware thread
+	/// @param count Number of indices to process
+	/// @param func Invoked as func( chunk_index, begin, end ) once per chunk, chunk_index < the number of chunks
+	/// @return The number of chunks used, at most num_threads and count
+	template <typename Func>
+	std::size_t parallel_for_chunks( const std::size_t num_threads, const std::size_t count, Func func )
+	{
+		const std::size_t num_chunks =
+			std::min( resolve_thread_count( num_threads ), std::max<std::size_t>( count, 1 ) );
+		const auto process_chunk = [ & ]( const std::size_t chunk_index ) {
+			func( chunk_index, count * chunk_index / num_chunks, count * ( chunk_index + 1 ) / num_chunks );
+		};
+		detail::run_on_threads( num_chunks, process_chunk );
+		return num_chunks;
+	}
+
+	/// @brief Process every index in [0, count) in parallel, threads take the next index as they finish
+	/// @details Suited to fewer, larger tasks of uneven cost. Exceptions thrown by func are rethrown once every
+	/// thread is done, an index may be skipped after another index threw.
+	/// @param num_threads Number of threads to use, 0 for every hardware thread
+	/// @param count Number of indices to process
+	/// @param func Invoked as func( index ) once per index
+	template <typename Func>
+	void parallel_for( const std::size_t num_threads, const std::size_t count, Func func )
+	{
+		std::atomic_size_t next_index = 0;
+		std::atomic_bool failed = false;
+		const auto process_indices = [ & ]( std::size_t ) {
+			try
+			{
+				for ( std::size_t index = next_index.fetch_add( 1, std::memory_order_relaxed );
+					  index < count && !failed.load( std::memory_order_relaxed );
+					  index = next_index.fetch_add( 1, std::memory_order_relaxed ) )
+				{
+					func( index );
+				}
+			}
+			catch ( ... )
+			{
+				failed.store( true, std::memory_order_relaxed );
+				throw;
+			}
+		};
+		detail::run_on_threads( std::min( resolve_thread_count( num_threads ), count ), process_indices );
+	}
+
+	/// @brief An executor that parallel algorithms can hand a fixed number of tasks to run concurrently
+	/// @details concurrency() is how many tasks the executor can usefully run at once, algorithms split their work
+	/// into at most that many tasks. bulk_execute( count, func ) invokes func( task_index ) once for every task index
+	/// in [0, count), possibly concurrently, and returns once all have finished, rethrowing any exception they threw.
+	/// Tasks never wait on each other, so an executor may run them on fewer threads or inline in any order.
+	template <typename Executor>
+	concept bulk_executor = requires( const Executor& executor, void ( &func )( std::size_t ) ) {
+		{ executor.concurrency() } -> std::convertible_to<std::size_t>;
+		executor.bulk_execute( std::size_t{}, func );
+	};
+
+	/// @brief A @ref bulk_executor that runs each task on its own thread, the calling thread runs the first task
+	struct thread_executor
+	{
+		/// @brief Number of threads to use, 0 for every hardware thread
+		std::size_t num_threads = 0;
+
+		[[nodiscard]] std::size_t concurrency() const noexcept
+		{
+			return resolve_thread_count( num_threads );
+		}
+
+		template <typename Func>
+		void bulk_execute( const std::size_t count, Func&& func ) const
+		{
+			// run_on_threads always runs thread 0, but there may be no tasks at all
+			if ( count == 0 )
+			{
+				return;
+			}
+			detail::run_on_threads( count, func );
+		}
+	};
+}
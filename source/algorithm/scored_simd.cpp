@@ -0,0 +1,217 @@
+#include "mclo/algorithm/detail/scored_simd.hpp"
+
+#include <xsimd/xsimd.hpp>
+
+#include <bit>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+	// Lanes track the offset of their best element in an unsigned integer of the same width as the score, so the
+	// comparison mask can select offsets directly
+	template <typename T>
+	using offset_t = std::conditional_t<sizeof( T ) == 4, std::uint32_t, std::uint64_t>;
+
+	// Lane offsets are relative to the start of a chunk small enough that they cannot reach the no match sentinel
+	template <typename T>
+	constexpr std::size_t max_chunk_size = std::size_t{ std::numeric_limits<offset_t<T>>::max() / 2 };
+
+	template <typename T>
+	constexpr offset_t<T> no_offset = std::numeric_limits<offset_t<T>>::max();
+
+	template <typename T>
+	struct lane_best
+	{
+		using value_batch = xsimd::batch<T>;
+		using offset_batch = xsimd::batch<offset_t<T>>;
+
+		explicit lane_best( const T bound ) noexcept
+			: value( bound )
+			, offset( no_offset<T> )
+		{
+		}
+
+		template <typename Better>
+		void update( const value_batch values, const offset_batch offsets, Better better ) noexcept
+		{
+			const auto mask = better( values, value );
+			value = xsimd::select( mask, values, value );
+			offset = xsimd::select( xsimd::batch_bool_cast<offset_t<T>>( mask ), offsets, offset );
+		}
+
+		// Reduce the lanes to the first best offset, then carry on scalar over the tail
+		template <typename Better>
+		[[nodiscard]] std::size_t finish( const T* const data,
+										  const std::size_t simd_end,
+										  const std::size_t size,
+										  T bound,
+										  Better better ) const noexcept
+		{
+			alignas( value_batch::arch_type::alignment() ) std::array<T, value_batch::size> values;
+			alignas( offset_batch::arch_type::alignment() ) std::array<offset_t<T>, offset_batch::size> offsets;
+			value.store_aligned( values.data() );
+			offset.store_aligned( offsets.data() );
+
+			// Lanes only hold values that beat the bound, so none are NaN and ties compare equal
+			std::size_t result = size;
+			for ( std::size_t lane = 0; lane < value_batch::size; ++lane )
+			{
+				if ( offsets[ lane ] == no_offset<T> )
+				{
+					continue;
+				}
+				if ( result == size || better( values[ lane ], bound ) ||
+					 ( values[ lane ] == bound && offsets[ lane ] < result ) )
+				{
+					result = offsets[ lane ];
+					bound = values[ lane ];
+				}
+			}
+
+			for ( std::size_t index = simd_end; index != size; ++index )
+			{
+				if ( better( data[ index ], bound ) )
+				{
+					result = index;
+					bound = data[ index ];
+				}
+			}
+			return result;
+		}
+
+		value_batch value;
+		offset_batch offset;
+	};
+
+	template <typename T>
+	[[nodiscard]] xsimd::batch<offset_t<T>> first_lane_offsets() noexcept
+	{
+		std::array<offset_t<T>, xsimd::batch<offset_t<T>>::size> offsets;
+		std::iota( offsets.begin(), offsets.end(), offset_t<T>{ 0 } );
+		return xsimd::batch<offset_t<T>>::load_unaligned( offsets.data() );
+	}
+
+	constexpr auto less = []( const auto lhs, const auto rhs ) noexcept { return lhs < rhs; };
+	constexpr auto greater = []( const auto lhs, const auto rhs ) noexcept { return lhs > rhs; };
+
+	template <typename T, std::size_t... Indices, typename... Better>
+	[[nodiscard]] std::array<std::size_t, sizeof...( Better )> best_in_chunk( const T* const data,
+																			   const std::size_t size,
+																			   const std::array<T, sizeof...( Better )>&
+																				   bounds,
+																			   std::index_sequence<Indices...>,
+																			   const Better... better ) noexcept
+	{
+		using value_batch = xsimd::batch<T>;
+		using offset_batch = xsimd::batch<offset_t<T>>;
+		static_assert( value_batch::size == offset_batch::size );
+
+		const std::size_t simd_end = size - ( size % value_batch::size );
+		const offset_batch step( static_cast<offset_t<T>>( value_batch::size ) );
+		offset_batch offsets = first_lane_offsets<T>();
+
+		std::array<lane_best<T>, sizeof...( Better )> lanes{ lane_best<T>( bounds[ Indices ] )... };
+		for ( std::size_t index = 0; index != simd_end; index += value_batch::size )
+		{
+			const value_batch values = value_batch::load_unaligned( data + index );
+			( lanes[ Indices ].update( values, offsets, better ), ... );
+			offsets += step;
+		}
+
+		return { lanes[ Indices ].finish( data, simd_end, size, bounds[ Indices ], better )... };
+	}
+
+	// Offsets only fit the lanes within a chunk, so larger inputs carry the best so far from chunk to chunk
+	template <typename T, typename... Better>
+	[[nodiscard]] std::array<std::size_t, sizeof...( Better )> best_offsets( const T* const data,
+																			  const std::size_t size,
+																			  std::array<T, sizeof...( Better )> bounds,
+																			  const Better... better ) noexcept
+	{
+		std::array<std::size_t, sizeof...( Better )> result;
+		result.fill( size );
+		for ( std::size_t chunk_begin = 0; chunk_begin < size; chunk_begin += max_chunk_size<T> )
+		{
+			const std::size_t chunk_size = std::min( size - chunk_begin, max_chunk_size<T> );
+			const auto chunk_result = best_in_chunk(
+				data + chunk_begin, chunk_size, bounds, std::index_sequence_for<Better...>{}, better... );
+			for ( std::size_t index = 0; index < result.size(); ++index )
+			{
+				if ( chunk_result[ index ] != chunk_size )
+				{
+					result[ index ] = chunk_begin + chunk_result[ index ];
+					bounds[ index ] = data[ result[ index ] ];
+				}
+			}
+		}
+		return result;
+	}
+}
+
+namespace mclo::detail
+{
+	template <scored_simd_value T>
+	std::size_t find_greater_simd( const T* const data, const std::size_t size, const T threshold ) noexcept
+	{
+		using value_batch = xsimd::batch<T>;
+
+		const std::size_t simd_end = size - ( size % value_batch::size );
+		const value_batch thresholds( threshold );
+		std::size_t index = 0;
+		for ( ; index != simd_end; index += value_batch::size )
+		{
+			const auto mask = value_batch::load_unaligned( data + index ) > thresholds;
+			if ( xsimd::any( mask ) )
+			{
+				return index + static_cast<std::size_t>( std::countr_zero( mask.mask() ) );
+			}
+		}
+		for ( ; index != size; ++index )
+		{
+			if ( data[ index ] > threshold )
+			{
+				return index;
+			}
+		}
+		return size;
+	}
+
+	template <scored_simd_value T>
+	std::size_t min_below_simd( const T* const data, const std::size_t size, const T bound ) noexcept
+	{
+		return best_offsets( data, size, std::array{ bound }, less )[ 0 ];
+	}
+
+	template <scored_simd_value T>
+	std::size_t max_above_simd( const T* const data, const std::size_t size, const T bound ) noexcept
+	{
+		return best_offsets( data, size, std::array{ bound }, greater )[ 0 ];
+	}
+
+	template <scored_simd_value T>
+	std::pair<std::size_t, std::size_t> minmax_beyond_simd( const T* const data,
+															const std::size_t size,
+															const T low_bound,
+															const T high_bound ) noexcept
+	{
+		const auto [ min_offset, max_offset ] =
+			best_offsets( data, size, std::array{ low_bound, high_bound }, less, greater );
+		return { min_offset, max_offset };
+	}
+
+#define MCLO_INSTANTIATE_SCORED_SIMD( T )                                                                              \
+	template std::size_t find_greater_simd<T>( const T*, std::size_t, T ) noexcept;                                    \
+	template std::size_t min_below_simd<T>( const T*, std::size_t, T ) noexcept;                                       \
+	template std::size_t max_above_simd<T>( const T*, std::size_t, T ) noexcept;                                       \
+	template std::pair<std::size_t, std::size_t> minmax_beyond_simd<T>( const T*, std::size_t, T, T ) noexcept;
+
+	MCLO_INSTANTIATE_SCORED_SIMD( std::int32_t )
+	MCLO_INSTANTIATE_SCORED_SIMD( std::uint32_t )
+	MCLO_INSTANTIATE_SCORED_SIMD( std::int64_t )
+	MCLO_INSTANTIATE_SCORED_SIMD( std::uint64_t )
+	MCLO_INSTANTIATE_SCORED_SIMD( float )
+	MCLO_INSTANTIATE_SCORED_SIMD( double )
+
+#undef MCLO_INSTANTIATE_SCORED_SIMD
+}
@@ -46,6 +46,19 @@ namespace mclo
 		return ptr;
 	}
 
+	bool memory_arena::try_extend( void* const ptr, const std::size_t old_size, const std::size_t new_size ) noexcept
+	{
+		std::byte* const first = static_cast<std::byte*>( ptr );
+		if ( !m_current_chunk || first + old_size != m_current ||
+			 new_size > static_cast<std::size_t>( m_current_chunk->end() - first ) )
+		{
+			return false;
+		}
+
+		m_current = first + new_size;
+		return true;
+	}
+
 	void memory_arena::reset() noexcept
 	{
 		m_current_chunk = m_head;
@@ -0,0 +1,217 @@
+#include "mclo/container/detail/bitset_simd.hpp"
+
+#include <xsimd/xsimd.hpp>
+
+#include <bit>
+
+namespace
+{
+	using byte_batch = xsimd::batch<std::uint8_t>;
+	using word_batch = xsimd::batch<std::uint64_t>;
+
+	constexpr std::size_t batch_bytes = byte_batch::size;
+
+	// Per byte counts are at most 8 so 31 of them can be summed before a byte could overflow
+	constexpr std::size_t max_byte_accumulations = 31;
+
+	[[nodiscard]] word_batch load_words( const std::uint8_t* ptr ) noexcept
+	{
+		return xsimd::bitwise_cast<std::uint64_t>( byte_batch::load_unaligned( ptr ) );
+	}
+
+	void store_words( std::uint8_t* ptr, const word_batch words ) noexcept
+	{
+		xsimd::bitwise_cast<std::uint8_t>( words ).store_unaligned( ptr );
+	}
+
+	// SWAR population count of every byte within the 64 bit lanes, each byte ends up holding its own count
+	[[nodiscard]] word_batch popcount_bytes( word_batch value ) noexcept
+	{
+		const word_batch m1( 0x5555555555555555ull );
+		const word_batch m2( 0x3333333333333333ull );
+		const word_batch m4( 0x0F0F0F0F0F0F0F0Full );
+
+		value = value - ( ( value >> 1 ) & m1 );
+		value = ( value & m2 ) + ( ( value >> 2 ) & m2 );
+		return ( value + ( value >> 4 ) ) & m4;
+	}
+
+	// Horizontally add the per byte counts of each lane into a single count per lane
+	[[nodiscard]] word_batch sum_bytes( word_batch value ) noexcept
+	{
+		const word_batch m8( 0x00FF00FF00FF00FFull );
+		const word_batch m16( 0x0000FFFF0000FFFFull );
+		const word_batch m32( 0x00000000FFFFFFFFull );
+
+		value = ( value & m8 ) + ( ( value >> 8 ) & m8 );
+		value = ( value & m16 ) + ( ( value >> 16 ) & m16 );
+		return ( value & m32 ) + ( value >> 32 );
+	}
+
+	template <typename Op>
+	void binary_op_simd( std::uint8_t* lhs, const std::uint8_t* rhs, const std::size_t num_bytes, Op op ) noexcept
+	{
+		const std::size_t simd_end = num_bytes - ( num_bytes % batch_bytes );
+		std::size_t index = 0;
+		for ( ; index != simd_end; index += batch_bytes )
+		{
+			store_words( lhs + index, op( load_words( lhs + index ), load_words( rhs + index ) ) );
+		}
+		for ( ; index != num_bytes; ++index )
+		{
+			lhs[ index ] = static_cast<std::uint8_t>( op( lhs[ index ], rhs[ index ] ) );
+		}
+	}
+
+	template <typename Load>
+	[[nodiscard]] std::size_t count_simd( const std::size_t num_bytes, Load load ) noexcept
+	{
+		const std::size_t simd_end = num_bytes - ( num_bytes % batch_bytes );
+		word_batch total( std::uint64_t{ 0 } );
+		std::size_t index = 0;
+
+		while ( index != simd_end )
+		{
+			// Accumulate per byte counts for as long as they cannot overflow, then widen into the lane totals
+			word_batch byte_counts( std::uint64_t{ 0 } );
+			for ( std::size_t i = 0; i < max_byte_accumulations && index != simd_end; ++i, index += batch_bytes )
+			{
+				byte_counts += popcount_bytes( load( index ) );
+			}
+			total += sum_bytes( byte_counts );
+		}
+
+		std::size_t result = xsimd::reduce_add( total );
+		for ( ; index != num_bytes; ++index )
+		{
+			result += static_cast<std::size_t>( std::popcount( load.scalar( index ) ) );
+		}
+		return result;
+	}
+
+	template <typename Op>
+	struct binary_load
+	{
+		const std::uint8_t* lhs;
+		const std::uint8_t* rhs;
+		Op op;
+
+		[[nodiscard]] word_batch operator()( const std::size_t index ) const noexcept
+		{
+			return op( load_words( lhs + index ), load_words( rhs + index ) );
+		}
+
+		[[nodiscard]] std::uint8_t scalar( const std::size_t index ) const noexcept
+		{
+			return static_cast<std::uint8_t>( op( lhs[ index ], rhs[ index ] ) );
+		}
+	};
+
+	struct unary_load
+	{
+		const std::uint8_t* data;
+
+		[[nodiscard]] word_batch operator()( const std::size_t index ) const noexcept
+		{
+			return load_words( data + index );
+		}
+
+		[[nodiscard]] std::uint8_t scalar( const std::size_t index ) const noexcept
+		{
+			return data[ index ];
+		}
+	};
+
+	constexpr auto and_op = []( const auto lhs, const auto rhs ) noexcept { return lhs & rhs; };
+	constexpr auto or_op = []( const auto lhs, const auto rhs ) noexcept { return lhs | rhs; };
+	constexpr auto xor_op = []( const auto lhs, const auto rhs ) noexcept { return lhs ^ rhs; };
+	constexpr auto and_not_op = []( const auto lhs, const auto rhs ) noexcept { return lhs & ~rhs; };
+
+	template <typename Op>
+	[[nodiscard]] std::size_t binary_count_simd( const std::uint8_t* lhs,
+												 const std::uint8_t* rhs,
+												 const std::size_t num_bytes,
+												 Op op ) noexcept
+	{
+		return count_simd( num_bytes, binary_load<Op>{ lhs, rhs, op } );
+	}
+}
+
+namespace mclo::detail
+{
+	void bitset_and_simd( std::uint8_t* lhs, const std::uint8_t* rhs, const std::size_t num_bytes ) noexcept
+	{
+		binary_op_simd( lhs, rhs, num_bytes, and_op );
+	}
+
+	void bitset_or_simd( std::uint8_t* lhs, const std::uint8_t* rhs, const std::size_t num_bytes ) noexcept
+	{
+		binary_op_simd( lhs, rhs, num_bytes, or_op );
+	}
+
+	void bitset_xor_simd( std::uint8_t* lhs, const std::uint8_t* rhs, const std::size_t num_bytes ) noexcept
+	{
+		binary_op_simd( lhs, rhs, num_bytes, xor_op );
+	}
+
+	void bitset_and_not_simd( std::uint8_t* lhs, const std::uint8_t* rhs, const std::size_t num_bytes ) noexcept
+	{
+		binary_op_simd( lhs, rhs, num_bytes, and_not_op );
+	}
+
+	std::size_t bitset_count_simd( const std::uint8_t* data, const std::size_t num_bytes ) noexcept
+	{
+		return count_simd( num_bytes, unary_load{ data } );
+	}
+
+	std::size_t bitset_and_count_simd( const std::uint8_t* lhs,
+									   const std::uint8_t* rhs,
+									   const std::size_t num_bytes ) noexcept
+	{
+		return binary_count_simd( lhs, rhs, num_bytes, and_op );
+	}
+
+	std::size_t bitset_or_count_simd( const std::uint8_t* lhs,
+									  const std::uint8_t* rhs,
+									  const std::size_t num_bytes ) noexcept
+	{
+		return binary_count_simd( lhs, rhs, num_bytes, or_op );
+	}
+
+	std::size_t bitset_xor_count_simd( const std::uint8_t* lhs,
+									   const std::uint8_t* rhs,
+									   const std::size_t num_bytes ) noexcept
+	{
+		return binary_count_simd( lhs, rhs, num_bytes, xor_op );
+	}
+
+	std::size_t bitset_and_not_count_simd( const std::uint8_t* lhs,
+										   const std::uint8_t* rhs,
+										   const std::size_t num_bytes ) noexcept
+	{
+		return binary_count_simd( lhs, rhs, num_bytes, and_not_op );
+	}
+
+	std::size_t bitset_find_non_zero_simd( const std::uint8_t* data, const std::size_t num_bytes ) noexcept
+	{
+		const std::size_t simd_end = num_bytes - ( num_bytes % batch_bytes );
+		const byte_batch zero( std::uint8_t{ 0 } );
+		std::size_t index = 0;
+
+		for ( ; index != simd_end; index += batch_bytes )
+		{
+			if ( xsimd::any( byte_batch::load_unaligned( data + index ) != zero ) )
+			{
+				break;
+			}
+		}
+		for ( ; index != num_bytes; ++index )
+		{
+			if ( data[ index ] != 0 )
+			{
+				return index;
+			}
+		}
+		return num_bytes;
+	}
+}
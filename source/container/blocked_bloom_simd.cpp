@@ -0,0 +1,100 @@
+#include "mclo/container/detail/blocked_bloom_simd.hpp"
+
+#include "mclo/memory/prefetch.hpp"
+
+#include <xsimd/xsimd.hpp>
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+	using mclo::detail::blocked_bloom_block;
+	using mclo::detail::blocked_bloom_words;
+
+	// A whole block in one register where the target has 256 bit integers, otherwise the block in several registers
+	using sized_word_batch = xsimd::make_sized_batch_t<std::uint32_t, blocked_bloom_words>;
+	using word_batch =
+		std::conditional_t<std::is_void_v<sized_word_batch>, xsimd::batch<std::uint32_t>, sized_word_batch>;
+	static_assert( blocked_bloom_words % word_batch::size == 0, "A block must be a whole number of batches" );
+
+	// How far ahead of the key being processed to prefetch its block
+	constexpr std::size_t prefetch_distance = 16;
+
+	// The bits a key sets in the words of a block starting at offset
+	[[nodiscard]] word_batch key_bits( const word_batch key, const std::size_t offset ) noexcept
+	{
+		const word_batch salts = word_batch::load_unaligned( mclo::detail::blocked_bloom_salts.data() + offset );
+		return word_batch( 1 ) << ( ( key * salts ) >> 27 );
+	}
+
+	template <typename Block, typename Func>
+	void for_each_key( Block* const blocks,
+					   const std::uint64_t num_blocks,
+					   const std::size_t* const hashes,
+					   const std::size_t count,
+					   Func func ) noexcept
+	{
+		const auto block_of = [ & ]( const std::size_t index ) {
+			const auto position = mclo::detail::blocked_bloom_locate( hashes[ index ], num_blocks );
+			return std::pair{ blocks + position.block, position.key };
+		};
+		const std::size_t prefetch_count = std::min( count, prefetch_distance );
+		for ( std::size_t index = 0; index < prefetch_count; ++index )
+		{
+			mclo::prefetch( block_of( index ).first );
+		}
+		for ( std::size_t index = 0; index < count; ++index )
+		{
+			if ( index + prefetch_distance < count )
+			{
+				mclo::prefetch( block_of( index + prefetch_distance ).first );
+			}
+			const auto [ block, key ] = block_of( index );
+			func( index, *block, word_batch( key ) );
+		}
+	}
+}
+
+void mclo::detail::blocked_bloom_insert_simd( blocked_bloom_block* const blocks,
+											  const std::uint64_t num_blocks,
+											  const std::size_t* const hashes,
+											  const std::size_t count ) noexcept
+{
+	for_each_key( blocks,
+				  num_blocks,
+				  hashes,
+				  count,
+				  []( std::size_t, blocked_bloom_block& block, const word_batch key ) noexcept {
+					  for ( std::size_t offset = 0; offset < blocked_bloom_words; offset += word_batch::size )
+					  {
+						  std::uint32_t* const words = block.words.data() + offset;
+						  ( word_batch::load_aligned( words ) | key_bits( key, offset ) ).store_aligned( words );
+					  }
+				  } );
+}
+
+void mclo::detail::blocked_bloom_contains_simd( const blocked_bloom_block* const blocks,
+												const std::uint64_t num_blocks,
+												const std::size_t* const hashes,
+												const std::size_t count,
+												bool* const results ) noexcept
+{
+	for_each_key( blocks,
+				  num_blocks,
+				  hashes,
+				  count,
+				  [ results ](
+					  const std::size_t index, const blocked_bloom_block& block, const word_batch key ) noexcept {
+					  // Any bit of the key missing from the block leaves a non-zero lane
+					  word_batch missing( 0 );
+					  for ( std::size_t offset = 0; offset < blocked_bloom_words; offset += word_batch::size )
+					  {
+						  const word_batch bits = key_bits( key, offset );
+						  const word_batch words = word_batch::load_aligned( block.words.data() + offset );
+						  missing |= xsimd::bitwise_andnot( bits, words );
+					  }
+					  results[ index ] = xsimd::all( missing == word_batch( 0 ) );
+				  } );
+}
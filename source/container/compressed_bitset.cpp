@@ -0,0 +1,1174 @@
+#include "mclo/container/compressed_bitset.hpp"
+
+#include "mclo/debug/assert.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+
+namespace
+{
+	using array_container = mclo::detail::compressed_array_container;
+	using bitmap_container = mclo::detail::compressed_bitmap_container;
+	using run_container = mclo::detail::compressed_run_container;
+	using run = mclo::detail::compressed_run;
+	using container = mclo::detail::compressed_container;
+	using chunk_bitset = mclo::detail::compressed_chunk_bitset;
+
+	constexpr std::uint32_t chunk_bits = mclo::detail::compressed_chunk_bits;
+	constexpr std::uint32_t max_array_cardinality = mclo::detail::compressed_max_array_cardinality;
+	constexpr std::size_t bitmap_words = mclo::detail::compressed_chunk_size / 64;
+	constexpr std::size_t bitmap_bytes = bitmap_words * sizeof( std::uint64_t );
+
+	// Portable roaring format cookies, the run variant stores the container count in its upper 16 bits
+	constexpr std::uint32_t serial_cookie_no_runs = 12346;
+	constexpr std::uint32_t serial_cookie_runs = 12347;
+
+	// With runs present the offset header is only written from this many containers onwards
+	constexpr std::size_t no_offset_threshold = 4;
+
+	[[nodiscard]] std::uint16_t high_bits( const std::uint32_t value ) noexcept
+	{
+		return static_cast<std::uint16_t>( value >> chunk_bits );
+	}
+
+	[[nodiscard]] std::uint16_t low_bits( const std::uint32_t value ) noexcept
+	{
+		return static_cast<std::uint16_t>( value );
+	}
+
+	[[nodiscard]] std::uint32_t run_length( const run value ) noexcept
+	{
+		return std::uint32_t{ value.last } - value.start + 1;
+	}
+
+	// Set the inclusive range [first, last] of bits
+	void set_bit_range( chunk_bitset& bits, const std::uint32_t first, const std::uint32_t last ) noexcept
+	{
+		std::uint64_t* const words = bits.underlying().data();
+		const std::size_t first_word = first / 64;
+		const std::size_t last_word = last / 64;
+		const std::uint64_t first_mask = ~std::uint64_t{ 0 } << ( first % 64 );
+		const std::uint64_t last_mask = ~std::uint64_t{ 0 } >> ( 63 - last % 64 );
+
+		if ( first_word == last_word )
+		{
+			words[ first_word ] |= first_mask & last_mask;
+			return;
+		}
+		words[ first_word ] |= first_mask;
+		std::fill( words + first_word + 1, words + last_word, ~std::uint64_t{ 0 } );
+		words[ last_word ] |= last_mask;
+	}
+
+	[[nodiscard]] std::uint32_t cardinality( const container& value ) noexcept
+	{
+		return std::visit( mclo::overloaded{
+							   []( const array_container& c ) { return static_cast<std::uint32_t>( c.values.size() ); },
+							   []( const bitmap_container& c ) { return c.cardinality; },
+							   []( const run_container& c ) { return c.cardinality; },
+						   },
+						   value );
+	}
+
+	[[nodiscard]] std::uint32_t count_bitmap( const chunk_bitset& bits ) noexcept
+	{
+		return static_cast<std::uint32_t>( bits.count() );
+	}
+
+	[[nodiscard]] bitmap_container make_bitmap( const container& value )
+	{
+		if ( const bitmap_container* const bitmap = std::get_if<bitmap_container>( &value ) )
+		{
+			return *bitmap;
+		}
+
+		bitmap_container result;
+		std::visit( mclo::overloaded{
+						[ & ]( const array_container& c ) {
+							for ( const std::uint16_t bit : c.values )
+							{
+								result.bits->set( bit );
+							}
+						},
+						[]( const bitmap_container& ) {},
+						[ & ]( const run_container& c ) {
+							for ( const run r : c.runs )
+							{
+								set_bit_range( *result.bits, r.start, r.last );
+							}
+						},
+					},
+					value );
+		result.cardinality = cardinality( value );
+		return result;
+	}
+
+	[[nodiscard]] array_container make_array( const container& value )
+	{
+		if ( const array_container* const array = std::get_if<array_container>( &value ) )
+		{
+			return *array;
+		}
+
+		array_container result;
+		result.values.reserve( cardinality( value ) );
+		std::visit( mclo::overloaded{
+						[]( const array_container& ) {},
+						[ & ]( const bitmap_container& c ) {
+							c.bits->for_each_set( [ & ]( const std::size_t bit ) {
+								result.values.push_back( static_cast<std::uint16_t>( bit ) );
+							} );
+						},
+						[ & ]( const run_container& c ) {
+							for ( const run r : c.runs )
+							{
+								for ( std::uint32_t bit = r.start; bit <= r.last; ++bit )
+								{
+									result.values.push_back( static_cast<std::uint16_t>( bit ) );
+								}
+							}
+						},
+					},
+					value );
+		return result;
+	}
+
+	// Append a run, coalescing it with the previous one if they overlap or touch
+	void append_run( std::vector<run>& runs, const run value )
+	{
+		if ( !runs.empty() && std::uint32_t{ value.start } <= std::uint32_t{ runs.back().last } + 1 )
+		{
+			runs.back().last = std::max( runs.back().last, value.last );
+		}
+		else
+		{
+			runs.push_back( value );
+		}
+	}
+
+	[[nodiscard]] run_container finish_runs( std::vector<run>&& runs ) noexcept
+	{
+		run_container result{ std::move( runs ) };
+		for ( const run r : result.runs )
+		{
+			result.cardinality += run_length( r );
+		}
+		return result;
+	}
+
+	[[nodiscard]] run_container make_runs( const container& value )
+	{
+		if ( const run_container* const runs = std::get_if<run_container>( &value ) )
+		{
+			return *runs;
+		}
+
+		std::vector<run> runs;
+		const auto add = [ & ]( const std::size_t bit ) {
+			const std::uint16_t bit16 = static_cast<std::uint16_t>( bit );
+			append_run( runs, run{ bit16, bit16 } );
+		};
+		if ( const array_container* const array = std::get_if<array_container>( &value ) )
+		{
+			std::ranges::for_each( array->values, add );
+		}
+		else
+		{
+			std::get<bitmap_container>( value ).bits->for_each_set( add );
+		}
+		return finish_runs( std::move( runs ) );
+	}
+
+	[[nodiscard]] std::size_t count_runs( const container& value ) noexcept
+	{
+		return std::visit( mclo::overloaded{
+							   []( const array_container& c ) {
+								   std::size_t runs = 0;
+								   std::uint32_t next = 0;
+								   for ( const std::uint16_t bit : c.values )
+								   {
+									   runs += ( runs == 0 || bit != next );
+									   next = std::uint32_t{ bit } + 1;
+								   }
+								   return runs;
+							   },
+							   []( const bitmap_container& c ) {
+								   // A run starts at every set bit whose lower neighbour is unset
+								   std::size_t runs = 0;
+								   std::uint64_t carry = 0;
+								   for ( const std::uint64_t word : c.bits->underlying() )
+								   {
+									   const std::uint64_t starts = word & ~( ( word << 1 ) | carry );
+									   runs += static_cast<std::size_t>( std::popcount( starts ) );
+									   carry = word >> 63;
+								   }
+								   return runs;
+							   },
+							   []( const run_container& c ) { return c.runs.size(); },
+						   },
+						   value );
+	}
+
+	[[nodiscard]] std::size_t run_serialized_bytes( const std::size_t num_runs ) noexcept
+	{
+		return sizeof( std::uint16_t ) + num_runs * 2 * sizeof( std::uint16_t );
+	}
+
+	[[nodiscard]] std::size_t non_run_serialized_bytes( const std::uint32_t cardinality ) noexcept
+	{
+		return cardinality <= max_array_cardinality ? cardinality * sizeof( std::uint16_t ) : bitmap_bytes;
+	}
+
+	[[nodiscard]] std::size_t serialized_bytes( const container& value ) noexcept
+	{
+		if ( const run_container* const runs = std::get_if<run_container>( &value ) )
+		{
+			return run_serialized_bytes( runs->runs.size() );
+		}
+		return non_run_serialized_bytes( cardinality( value ) );
+	}
+
+	// Pick between array and bitmap by cardinality, runs are only ever chosen by optimize
+	void normalize( container& value )
+	{
+		const std::uint32_t card = cardinality( value );
+		if ( card <= max_array_cardinality && std::holds_alternative<bitmap_container>( value ) )
+		{
+			value = make_array( value );
+		}
+		else if ( card > max_array_cardinality && std::holds_alternative<array_container>( value ) )
+		{
+			value = make_bitmap( value );
+		}
+	}
+
+	// Pick whichever of the three representations is smallest
+	void optimize( container& value )
+	{
+		const std::uint32_t card = cardinality( value );
+		if ( run_serialized_bytes( count_runs( value ) ) < non_run_serialized_bytes( card ) )
+		{
+			if ( !std::holds_alternative<run_container>( value ) )
+			{
+				value = make_runs( value );
+			}
+		}
+		else if ( std::holds_alternative<run_container>( value ) )
+		{
+			if ( card <= max_array_cardinality )
+			{
+				value = make_array( value );
+			}
+			else
+			{
+				value = make_bitmap( value );
+			}
+		}
+		else
+		{
+			normalize( value );
+		}
+	}
+
+	[[nodiscard]] bool contains( const std::vector<run>& runs, const std::uint16_t bit ) noexcept
+	{
+		const auto it = std::ranges::upper_bound( runs, bit, {}, &run::start );
+		return it != runs.begin() && std::prev( it )->last >= bit;
+	}
+
+	[[nodiscard]] bool test( const container& value, const std::uint16_t bit ) noexcept
+	{
+		return std::visit( mclo::overloaded{
+							   [ bit ]( const array_container& c ) {
+								   return std::ranges::binary_search( c.values, bit );
+							   },
+							   [ bit ]( const bitmap_container& c ) { return c.bits->test( bit ); },
+							   [ bit ]( const run_container& c ) { return contains( c.runs, bit ); },
+						   },
+						   value );
+	}
+
+	[[nodiscard]] std::uint32_t rank( const container& value, const std::uint16_t bit ) noexcept
+	{
+		return std::visit(
+			mclo::overloaded{
+				[ bit ]( const array_container& c ) {
+					return static_cast<std::uint32_t>( std::ranges::upper_bound( c.values, bit ) - c.values.begin() );
+				},
+				[ bit ]( const bitmap_container& c ) {
+					const auto words = c.bits->underlying();
+					const std::size_t last_word = bit / 64;
+					std::uint32_t result = 0;
+					for ( std::size_t index = 0; index < last_word; ++index )
+					{
+						result += static_cast<std::uint32_t>( std::popcount( words[ index ] ) );
+					}
+					const std::uint64_t mask = ~std::uint64_t{ 0 } >> ( 63 - bit % 64 );
+					return result + static_cast<std::uint32_t>( std::popcount( words[ last_word ] & mask ) );
+				},
+				[ bit ]( const run_container& c ) {
+					std::uint32_t result = 0;
+					for ( const run r : c.runs )
+					{
+						if ( r.start > bit )
+						{
+							break;
+						}
+						result += std::uint32_t{ std::min( r.last, bit ) } - r.start + 1;
+					}
+					return result;
+				},
+			},
+			value );
+	}
+
+	// Returns true if the bit was not already set
+	[[nodiscard]] bool add( container& value, const std::uint16_t bit )
+	{
+		if ( array_container* const array = std::get_if<array_container>( &value ) )
+		{
+			const auto it = std::ranges::lower_bound( array->values, bit );
+			if ( it != array->values.end() && *it == bit )
+			{
+				return false;
+			}
+			if ( array->values.size() < max_array_cardinality )
+			{
+				array->values.insert( it, bit );
+				return true;
+			}
+			value = make_bitmap( value );
+		}
+
+		if ( bitmap_container* const bitmap = std::get_if<bitmap_container>( &value ) )
+		{
+			if ( bitmap->bits->test_set( bit ) )
+			{
+				return false;
+			}
+			++bitmap->cardinality;
+			return true;
+		}
+
+		run_container& runs = std::get<run_container>( value );
+		const auto next = std::ranges::upper_bound( runs.runs, bit, {}, &run::start );
+		const bool has_prev = next != runs.runs.begin();
+		if ( has_prev && std::prev( next )->last >= bit )
+		{
+			return false;
+		}
+
+		const bool joins_prev = has_prev && std::uint32_t{ std::prev( next )->last } + 1 == bit;
+		const bool joins_next = next != runs.runs.end() && std::uint32_t{ bit } + 1 == next->start;
+		if ( joins_prev && joins_next )
+		{
+			std::prev( next )->last = next->last;
+			runs.runs.erase( next );
+		}
+		else if ( joins_prev )
+		{
+			std::prev( next )->last = bit;
+		}
+		else if ( joins_next )
+		{
+			next->start = bit;
+		}
+		else
+		{
+			runs.runs.insert( next, run{ bit, bit } );
+		}
+		++runs.cardinality;
+		return true;
+	}
+
+	// Returns true if the bit was set
+	[[nodiscard]] bool remove( container& value, const std::uint16_t bit )
+	{
+		if ( array_container* const array = std::get_if<array_container>( &value ) )
+		{
+			const auto it = std::ranges::lower_bound( array->values, bit );
+			if ( it == array->values.end() || *it != bit )
+			{
+				return false;
+			}
+			array->values.erase( it );
+			return true;
+		}
+
+		if ( bitmap_container* const bitmap = std::get_if<bitmap_container>( &value ) )
+		{
+			if ( !bitmap->bits->test_set( bit, false ) )
+			{
+				return false;
+			}
+			--bitmap->cardinality;
+			normalize( value );
+			return true;
+		}
+
+		run_container& runs = std::get<run_container>( value );
+		const auto next = std::ranges::upper_bound( runs.runs, bit, {}, &run::start );
+		if ( next == runs.runs.begin() || std::prev( next )->last < bit )
+		{
+			return false;
+		}
+
+		const auto it = std::prev( next );
+		if ( it->start == it->last )
+		{
+			runs.runs.erase( it );
+		}
+		else if ( it->start == bit )
+		{
+			++it->start;
+		}
+		else if ( it->last == bit )
+		{
+			--it->last;
+		}
+		else
+		{
+			const run upper{ static_cast<std::uint16_t>( bit + 1 ), it->last };
+			it->last = static_cast<std::uint16_t>( bit - 1 );
+			runs.runs.insert( next, upper );
+		}
+		--runs.cardinality;
+		return true;
+	}
+
+	[[nodiscard]] std::vector<run> union_runs( const std::vector<run>& lhs, const std::vector<run>& rhs )
+	{
+		std::vector<run> result;
+		result.reserve( lhs.size() + rhs.size() );
+		auto lhs_it = lhs.begin();
+		auto rhs_it = rhs.begin();
+		while ( lhs_it != lhs.end() || rhs_it != rhs.end() )
+		{
+			if ( rhs_it == rhs.end() || ( lhs_it != lhs.end() && lhs_it->start <= rhs_it->start ) )
+			{
+				append_run( result, *lhs_it++ );
+			}
+			else
+			{
+				append_run( result, *rhs_it++ );
+			}
+		}
+		return result;
+	}
+
+	[[nodiscard]] std::vector<run> intersect_runs( const std::vector<run>& lhs, const std::vector<run>& rhs )
+	{
+		std::vector<run> result;
+		auto lhs_it = lhs.begin();
+		auto rhs_it = rhs.begin();
+		while ( lhs_it != lhs.end() && rhs_it != rhs.end() )
+		{
+			const std::uint16_t start = std::max( lhs_it->start, rhs_it->start );
+			const std::uint16_t last = std::min( lhs_it->last, rhs_it->last );
+			if ( start <= last )
+			{
+				result.push_back( run{ start, last } );
+			}
+			if ( lhs_it->last < rhs_it->last )
+			{
+				++lhs_it;
+			}
+			else
+			{
+				++rhs_it;
+			}
+		}
+		return result;
+	}
+
+	// Union of every pairing of container types, the mixed cases only handle one argument order and forward the
+	// other to it
+	struct union_visitor
+	{
+		[[nodiscard]] container operator()( const array_container& lhs, const array_container& rhs ) const
+		{
+			array_container result;
+			result.values.reserve( lhs.values.size() + rhs.values.size() );
+			std::ranges::set_union( lhs.values, rhs.values, std::back_inserter( result.values ) );
+			container value( std::move( result ) );
+			normalize( value );
+			return value;
+		}
+
+		[[nodiscard]] container operator()( const bitmap_container& lhs, const bitmap_container& rhs ) const
+		{
+			bitmap_container result = lhs;
+			*result.bits |= *rhs.bits;
+			result.cardinality = count_bitmap( *result.bits );
+			return result;
+		}
+
+		[[nodiscard]] container operator()( const run_container& lhs, const run_container& rhs ) const
+		{
+			container value( finish_runs( union_runs( lhs.runs, rhs.runs ) ) );
+			optimize( value );
+			return value;
+		}
+
+		[[nodiscard]] container operator()( const bitmap_container& lhs, const array_container& rhs ) const
+		{
+			bitmap_container result = lhs;
+			for ( const std::uint16_t bit : rhs.values )
+			{
+				result.cardinality += !result.bits->test_set( bit );
+			}
+			return result;
+		}
+
+		[[nodiscard]] container operator()( const bitmap_container& lhs, const run_container& rhs ) const
+		{
+			bitmap_container result = lhs;
+			for ( const run r : rhs.runs )
+			{
+				set_bit_range( *result.bits, r.start, r.last );
+			}
+			result.cardinality = count_bitmap( *result.bits );
+			return result;
+		}
+
+		[[nodiscard]] container operator()( const run_container& lhs, const array_container& rhs ) const
+		{
+			return ( *this )( lhs, make_runs( container( rhs ) ) );
+		}
+
+		template <typename Lhs, typename Rhs>
+		[[nodiscard]] container operator()( const Lhs& lhs, const Rhs& rhs ) const
+		{
+			return ( *this )( rhs, lhs );
+		}
+	};
+
+	struct intersection_visitor
+	{
+		[[nodiscard]] container operator()( const array_container& lhs, const array_container& rhs ) const
+		{
+			array_container result;
+			result.values.reserve( std::min( lhs.values.size(), rhs.values.size() ) );
+			std::ranges::set_intersection( lhs.values, rhs.values, std::back_inserter( result.values ) );
+			return result;
+		}
+
+		[[nodiscard]] container operator()( const bitmap_container& lhs, const bitmap_container& rhs ) const
+		{
+			bitmap_container result = lhs;
+			*result.bits &= *rhs.bits;
+			result.cardinality = count_bitmap( *result.bits );
+			container value( std::move( result ) );
+			normalize( value );
+			return value;
+		}
+
+		[[nodiscard]] container operator()( const run_container& lhs, const run_container& rhs ) const
+		{
+			container value( finish_runs( intersect_runs( lhs.runs, rhs.runs ) ) );
+			optimize( value );
+			return value;
+		}
+
+		[[nodiscard]] container operator()( const array_container& lhs, const bitmap_container& rhs ) const
+		{
+			array_container result;
+			std::ranges::copy_if(
+				lhs.values, std::back_inserter( result.values ), [ & ]( const std::uint16_t bit ) {
+					return rhs.bits->test( bit );
+				} );
+			return result;
+		}
+
+		[[nodiscard]] container operator()( const array_container& lhs, const run_container& rhs ) const
+		{
+			array_container result;
+			std::ranges::copy_if( lhs.values, std::back_inserter( result.values ), [ & ]( const std::uint16_t bit ) {
+				return contains( rhs.runs, bit );
+			} );
+			return result;
+		}
+
+		[[nodiscard]] container operator()( const bitmap_container& lhs, const run_container& rhs ) const
+		{
+			bitmap_container result = make_bitmap( container( rhs ) );
+			*result.bits &= *lhs.bits;
+			result.cardinality = count_bitmap( *result.bits );
+			container value( std::move( result ) );
+			normalize( value );
+			return value;
+		}
+
+		template <typename Lhs, typename Rhs>
+		[[nodiscard]] container operator()( const Lhs& lhs, const Rhs& rhs ) const
+		{
+			return ( *this )( rhs, lhs );
+		}
+	};
+
+	[[nodiscard]] bool equal_containers( const container& lhs, const container& rhs )
+	{
+		if ( cardinality( lhs ) != cardinality( rhs ) )
+		{
+			return false;
+		}
+		if ( lhs.index() == rhs.index() )
+		{
+			return std::visit( mclo::overloaded{
+								   [ & ]( const array_container& c ) {
+									   return c.values == std::get<array_container>( rhs ).values;
+								   },
+								   [ & ]( const bitmap_container& c ) {
+									   return *c.bits == *std::get<bitmap_container>( rhs ).bits;
+								   },
+								   [ & ]( const run_container& c ) {
+									   return c.runs == std::get<run_container>( rhs ).runs;
+								   },
+							   },
+							   lhs );
+		}
+		return *make_bitmap( lhs ).bits == *make_bitmap( rhs ).bits;
+	}
+
+	std::byte* write_u16( std::byte* out, const std::uint16_t value ) noexcept
+	{
+		out[ 0 ] = static_cast<std::byte>( value );
+		out[ 1 ] = static_cast<std::byte>( value >> 8 );
+		return out + 2;
+	}
+
+	std::byte* write_u32( std::byte* out, const std::uint32_t value ) noexcept
+	{
+		out = write_u16( out, static_cast<std::uint16_t>( value ) );
+		return write_u16( out, static_cast<std::uint16_t>( value >> 16 ) );
+	}
+
+	std::byte* write_u64( std::byte* out, const std::uint64_t value ) noexcept
+	{
+		out = write_u32( out, static_cast<std::uint32_t>( value ) );
+		return write_u32( out, static_cast<std::uint32_t>( value >> 32 ) );
+	}
+
+	[[nodiscard]] std::uint16_t read_u16( const std::byte* in ) noexcept
+	{
+		return static_cast<std::uint16_t>( std::to_integer<std::uint16_t>( in[ 0 ] ) |
+										   std::to_integer<std::uint16_t>( in[ 1 ] ) << 8 );
+	}
+
+	[[nodiscard]] std::uint32_t read_u32( const std::byte* in ) noexcept
+	{
+		return std::uint32_t{ read_u16( in ) } | std::uint32_t{ read_u16( in + 2 ) } << 16;
+	}
+
+	[[nodiscard]] std::uint64_t read_u64( const std::byte* in ) noexcept
+	{
+		return std::uint64_t{ read_u32( in ) } | std::uint64_t{ read_u32( in + 4 ) } << 32;
+	}
+
+	[[nodiscard]] bool has_runs( const std::vector<container>& containers ) noexcept
+	{
+		return std::ranges::any_of( containers,
+									[]( const container& c ) { return std::holds_alternative<run_container>( c ); } );
+	}
+
+	[[nodiscard]] std::size_t header_bytes( const std::size_t num_containers, const bool runs ) noexcept
+	{
+		const std::size_t cookie =
+			runs ? sizeof( std::uint32_t ) + ( num_containers + 7 ) / 8 : 2 * sizeof( std::uint32_t );
+		const std::size_t descriptive = num_containers * 2 * sizeof( std::uint16_t );
+		const bool has_offsets = !runs || num_containers >= no_offset_threshold;
+		return cookie + descriptive + ( has_offsets ? num_containers * sizeof( std::uint32_t ) : 0 );
+	}
+
+	std::byte* serialize_container( std::byte* out, const container& value )
+	{
+		if ( const run_container* const runs = std::get_if<run_container>( &value ) )
+		{
+			out = write_u16( out, static_cast<std::uint16_t>( runs->runs.size() ) );
+			for ( const run r : runs->runs )
+			{
+				out = write_u16( out, r.start );
+				out = write_u16( out, static_cast<std::uint16_t>( r.last - r.start ) );
+			}
+			return out;
+		}
+
+		if ( cardinality( value ) <= max_array_cardinality )
+		{
+			if ( const array_container* const array = std::get_if<array_container>( &value ) )
+			{
+				for ( const std::uint16_t bit : array->values )
+				{
+					out = write_u16( out, bit );
+				}
+			}
+			else
+			{
+				std::get<bitmap_container>( value ).bits->for_each_set(
+					[ & ]( const std::size_t bit ) { out = write_u16( out, static_cast<std::uint16_t>( bit ) ); } );
+			}
+			return out;
+		}
+
+		const bitmap_container bitmap = make_bitmap( value );
+		for ( const std::uint64_t word : bitmap.bits->underlying() )
+		{
+			out = write_u64( out, word );
+		}
+		return out;
+	}
+
+	[[nodiscard]] std::optional<container> deserialize_container( mclo::span<const std::byte> data,
+																  std::size_t& offset,
+																  const std::uint32_t card,
+																  const bool is_run )
+	{
+		const auto remaining = [ & ] { return data.size() - offset; };
+		const std::byte* in = data.data() + offset;
+
+		if ( is_run )
+		{
+			if ( remaining() < sizeof( std::uint16_t ) )
+			{
+				return std::nullopt;
+			}
+			const std::size_t num_runs = read_u16( in );
+			const std::size_t bytes = run_serialized_bytes( num_runs );
+			if ( num_runs == 0 || remaining() < bytes )
+			{
+				return std::nullopt;
+			}
+			in += sizeof( std::uint16_t );
+
+			std::vector<run> runs;
+			runs.reserve( num_runs );
+			for ( std::size_t index = 0; index < num_runs; ++index, in += 2 * sizeof( std::uint16_t ) )
+			{
+				const std::uint32_t start = read_u16( in );
+				const std::uint32_t last = start + read_u16( in + sizeof( std::uint16_t ) );
+				if ( last > std::numeric_limits<std::uint16_t>::max() ||
+					 ( !runs.empty() && start <= runs.back().last ) )
+				{
+					return std::nullopt;
+				}
+				append_run( runs, run{ static_cast<std::uint16_t>( start ), static_cast<std::uint16_t>( last ) } );
+			}
+			offset += bytes;
+			return finish_runs( std::move( runs ) );
+		}
+
+		if ( card <= max_array_cardinality )
+		{
+			const std::size_t bytes = card * sizeof( std::uint16_t );
+			if ( remaining() < bytes )
+			{
+				return std::nullopt;
+			}
+
+			array_container result;
+			result.values.reserve( card );
+			for ( std::uint32_t index = 0; index < card; ++index, in += sizeof( std::uint16_t ) )
+			{
+				const std::uint16_t bit = read_u16( in );
+				if ( !result.values.empty() && bit <= result.values.back() )
+				{
+					return std::nullopt;
+				}
+				result.values.push_back( bit );
+			}
+			offset += bytes;
+			return result;
+		}
+
+		if ( remaining() < bitmap_bytes )
+		{
+			return std::nullopt;
+		}
+
+		bitmap_container result;
+		for ( std::uint64_t& word : result.bits->underlying() )
+		{
+			word = read_u64( in );
+			in += sizeof( std::uint64_t );
+		}
+		result.cardinality = count_bitmap( *result.bits );
+		if ( result.cardinality != card )
+		{
+			return std::nullopt;
+		}
+		offset += bitmap_bytes;
+		return result;
+	}
+}
+
+namespace mclo
+{
+	bool compressed_bitset::test( const value_type pos ) const noexcept
+	{
+		const std::uint16_t key = high_bits( pos );
+		const std::size_t index = lower_bound_key( key );
+		return index != m_keys.size() && m_keys[ index ] == key && ::test( m_containers[ index ], low_bits( pos ) );
+	}
+
+	compressed_bitset& compressed_bitset::set( const value_type pos )
+	{
+		const std::uint16_t key = high_bits( pos );
+		const std::size_t index = lower_bound_key( key );
+		if ( index == m_keys.size() || m_keys[ index ] != key )
+		{
+			m_keys.insert( m_keys.begin() + index, key );
+			m_containers.insert( m_containers.begin() + index, array_container{ { low_bits( pos ) } } );
+		}
+		else
+		{
+			(void)add( m_containers[ index ], low_bits( pos ) );
+		}
+		return *this;
+	}
+
+	compressed_bitset& compressed_bitset::set( const value_type pos, const bool value )
+	{
+		return value ? set( pos ) : reset( pos );
+	}
+
+	compressed_bitset& compressed_bitset::set_range( const value_type first, const size_type last )
+	{
+		MCLO_ASSERT( first <= last && last <= size(), "Range out of bounds of bitset" );
+		if ( first == last )
+		{
+			return *this;
+		}
+
+		const value_type final_pos = static_cast<value_type>( last - 1 );
+		const std::uint32_t first_key = high_bits( first );
+		const std::uint32_t last_key = high_bits( final_pos );
+		for ( std::uint32_t key = first_key; key <= last_key; ++key )
+		{
+			const std::uint16_t start = key == first_key ? low_bits( first ) : 0;
+			const std::uint16_t end =
+				key == last_key ? low_bits( final_pos ) : std::numeric_limits<std::uint16_t>::max();
+			container range( finish_runs( { run{ start, end } } ) );
+
+			const std::uint16_t key16 = static_cast<std::uint16_t>( key );
+			const std::size_t index = lower_bound_key( key16 );
+			if ( index == m_keys.size() || m_keys[ index ] != key16 )
+			{
+				optimize( range );
+				m_keys.insert( m_keys.begin() + index, key16 );
+				m_containers.insert( m_containers.begin() + index, std::move( range ) );
+			}
+			else
+			{
+				m_containers[ index ] = std::visit( union_visitor{}, m_containers[ index ], range );
+			}
+		}
+		return *this;
+	}
+
+	compressed_bitset& compressed_bitset::reset( const value_type pos )
+	{
+		const std::uint16_t key = high_bits( pos );
+		const std::size_t index = lower_bound_key( key );
+		if ( index != m_keys.size() && m_keys[ index ] == key && remove( m_containers[ index ], low_bits( pos ) ) &&
+			 cardinality( m_containers[ index ] ) == 0 )
+		{
+			erase_chunk( index );
+		}
+		return *this;
+	}
+
+	compressed_bitset& compressed_bitset::reset() noexcept
+	{
+		m_keys.clear();
+		m_containers.clear();
+		return *this;
+	}
+
+	compressed_bitset::size_type compressed_bitset::count() const noexcept
+	{
+		size_type result = 0;
+		for ( const container& value : m_containers )
+		{
+			result += cardinality( value );
+		}
+		return result;
+	}
+
+	compressed_bitset::size_type compressed_bitset::rank( const value_type pos ) const noexcept
+	{
+		const std::uint16_t key = high_bits( pos );
+		size_type result = 0;
+		for ( std::size_t index = 0; index < m_keys.size() && m_keys[ index ] <= key; ++index )
+		{
+			result += m_keys[ index ] == key ? ::rank( m_containers[ index ], low_bits( pos ) )
+											 : cardinality( m_containers[ index ] );
+		}
+		return result;
+	}
+
+	std::optional<compressed_bitset::value_type> compressed_bitset::find_first_set() const noexcept
+	{
+		if ( m_keys.empty() )
+		{
+			return std::nullopt;
+		}
+		const value_type low = std::visit(
+			mclo::overloaded{
+				[]( const array_container& c ) { return value_type{ c.values.front() }; },
+				[]( const bitmap_container& c ) { return static_cast<value_type>( c.bits->find_first_set() ); },
+				[]( const run_container& c ) { return value_type{ c.runs.front().start }; },
+			},
+			m_containers.front() );
+		return value_type{ m_keys.front() } << chunk_bits | low;
+	}
+
+	compressed_bitset& compressed_bitset::operator|=( const compressed_bitset& other )
+	{
+		*this = union_of( *this, other );
+		return *this;
+	}
+
+	compressed_bitset& compressed_bitset::operator&=( const compressed_bitset& other )
+	{
+		*this = intersection_of( *this, other );
+		return *this;
+	}
+
+	bool compressed_bitset::operator==( const compressed_bitset& other ) const
+	{
+		return m_keys == other.m_keys && std::ranges::equal( m_containers, other.m_containers, equal_containers );
+	}
+
+	void compressed_bitset::run_optimize()
+	{
+		std::ranges::for_each( m_containers, optimize );
+	}
+
+	void compressed_bitset::shrink_to_fit()
+	{
+		m_keys.shrink_to_fit();
+		m_containers.shrink_to_fit();
+		for ( container& value : m_containers )
+		{
+			if ( array_container* const array = std::get_if<array_container>( &value ) )
+			{
+				array->values.shrink_to_fit();
+			}
+			else if ( run_container* const runs = std::get_if<run_container>( &value ) )
+			{
+				runs->runs.shrink_to_fit();
+			}
+		}
+	}
+
+	std::size_t compressed_bitset::serialized_size() const noexcept
+	{
+		std::size_t result = header_bytes( m_containers.size(), has_runs( m_containers ) );
+		for ( const container& value : m_containers )
+		{
+			result += serialized_bytes( value );
+		}
+		return result;
+	}
+
+	std::size_t compressed_bitset::serialize( const mclo::span<std::byte> out ) const noexcept
+	{
+		MCLO_ASSERT( out.size() >= serialized_size(), "Output buffer too small to serialize bitset" );
+
+		const std::size_t num_containers = m_containers.size();
+		const bool runs = has_runs( m_containers );
+		std::byte* const begin = out.data();
+		std::byte* it = begin;
+
+		if ( runs )
+		{
+			it = write_u32( it, serial_cookie_runs | static_cast<std::uint32_t>( num_containers - 1 ) << 16 );
+			std::byte* const run_flags = it;
+			it += ( num_containers + 7 ) / 8;
+			std::fill( run_flags, it, std::byte{ 0 } );
+			for ( std::size_t index = 0; index < num_containers; ++index )
+			{
+				if ( std::holds_alternative<run_container>( m_containers[ index ] ) )
+				{
+					run_flags[ index / 8 ] |= std::byte{ 1 } << ( index % 8 );
+				}
+			}
+		}
+		else
+		{
+			it = write_u32( it, serial_cookie_no_runs );
+			it = write_u32( it, static_cast<std::uint32_t>( num_containers ) );
+		}
+
+		for ( std::size_t index = 0; index < num_containers; ++index )
+		{
+			it = write_u16( it, m_keys[ index ] );
+			it = write_u16( it, static_cast<std::uint16_t>( cardinality( m_containers[ index ] ) - 1 ) );
+		}
+
+		if ( !runs || num_containers >= no_offset_threshold )
+		{
+			std::size_t offset = header_bytes( num_containers, runs );
+			for ( const container& value : m_containers )
+			{
+				it = write_u32( it, static_cast<std::uint32_t>( offset ) );
+				offset += serialized_bytes( value );
+			}
+		}
+
+		for ( const container& value : m_containers )
+		{
+			it = serialize_container( it, value );
+		}
+		return static_cast<std::size_t>( it - begin );
+	}
+
+	std::vector<std::byte> compressed_bitset::serialize() const
+	{
+		std::vector<std::byte> result( serialized_size() );
+		(void)serialize( mclo::span<std::byte>( result ) );
+		return result;
+	}
+
+	std::optional<compressed_bitset> compressed_bitset::deserialize( const mclo::span<const std::byte> data )
+	{
+		if ( data.size() < sizeof( std::uint32_t ) )
+		{
+			return std::nullopt;
+		}
+
+		const std::uint32_t cookie = read_u32( data.data() );
+		const bool runs = ( cookie & 0xFFFF ) == serial_cookie_runs;
+		std::size_t num_containers = 0;
+		std::size_t offset = 0;
+		if ( runs )
+		{
+			num_containers = ( cookie >> 16 ) + 1;
+			offset = sizeof( std::uint32_t );
+		}
+		else if ( cookie == serial_cookie_no_runs && data.size() >= 2 * sizeof( std::uint32_t ) )
+		{
+			num_containers = read_u32( data.data() + sizeof( std::uint32_t ) );
+			offset = 2 * sizeof( std::uint32_t );
+		}
+		else
+		{
+			return std::nullopt;
+		}
+
+		if ( num_containers > mclo::detail::compressed_chunk_size ||
+			 data.size() < header_bytes( num_containers, runs ) )
+		{
+			return std::nullopt;
+		}
+
+		const std::byte* const run_flags = data.data() + offset;
+		if ( runs )
+		{
+			offset += ( num_containers + 7 ) / 8;
+		}
+		const std::byte* const descriptive = data.data() + offset;
+		offset = header_bytes( num_containers, runs );
+
+		compressed_bitset result;
+		result.m_keys.reserve( num_containers );
+		result.m_containers.reserve( num_containers );
+		for ( std::size_t index = 0; index < num_containers; ++index )
+		{
+			const std::byte* const entry = descriptive + index * 2 * sizeof( std::uint16_t );
+			const std::uint16_t key = read_u16( entry );
+			const std::uint32_t card = std::uint32_t{ read_u16( entry + sizeof( std::uint16_t ) ) } + 1;
+			const std::byte run_flag = std::byte{ 1 } << ( index % 8 );
+			const bool is_run = runs && ( run_flags[ index / 8 ] & run_flag ) != std::byte{ 0 };
+			if ( !result.m_keys.empty() && key <= result.m_keys.back() )
+			{
+				return std::nullopt;
+			}
+
+			std::optional<container> value = deserialize_container( data, offset, card, is_run );
+			if ( !value )
+			{
+				return std::nullopt;
+			}
+			result.m_keys.push_back( key );
+			result.m_containers.push_back( std::move( *value ) );
+		}
+		return result;
+	}
+
+	compressed_bitset compressed_bitset::union_of( const compressed_bitset& lhs, const compressed_bitset& rhs )
+	{
+		compressed_bitset result;
+		result.m_keys.reserve( lhs.m_keys.size() + rhs.m_keys.size() );
+		result.m_containers.reserve( lhs.m_keys.size() + rhs.m_keys.size() );
+
+		std::size_t lhs_index = 0;
+		std::size_t rhs_index = 0;
+		while ( lhs_index < lhs.m_keys.size() || rhs_index < rhs.m_keys.size() )
+		{
+			const bool lhs_done = lhs_index == lhs.m_keys.size();
+			const bool rhs_done = rhs_index == rhs.m_keys.size();
+			if ( !lhs_done && ( rhs_done || lhs.m_keys[ lhs_index ] < rhs.m_keys[ rhs_index ] ) )
+			{
+				result.m_keys.push_back( lhs.m_keys[ lhs_index ] );
+				result.m_containers.push_back( lhs.m_containers[ lhs_index++ ] );
+			}
+			else if ( lhs_done || rhs.m_keys[ rhs_index ] < lhs.m_keys[ lhs_index ] )
+			{
+				result.m_keys.push_back( rhs.m_keys[ rhs_index ] );
+				result.m_containers.push_back( rhs.m_containers[ rhs_index++ ] );
+			}
+			else
+			{
+				result.m_keys.push_back( lhs.m_keys[ lhs_index ] );
+				result.m_containers.push_back(
+					std::visit( union_visitor{}, lhs.m_containers[ lhs_index++ ], rhs.m_containers[ rhs_index++ ] ) );
+			}
+		}
+		return result;
+	}
+
+	compressed_bitset compressed_bitset::intersection_of( const compressed_bitset& lhs, const compressed_bitset& rhs )
+	{
+		compressed_bitset result;
+		std::size_t lhs_index = 0;
+		std::size_t rhs_index = 0;
+		while ( lhs_index < lhs.m_keys.size() && rhs_index < rhs.m_keys.size() )
+		{
+			const std::uint16_t lhs_key = lhs.m_keys[ lhs_index ];
+			const std::uint16_t rhs_key = rhs.m_keys[ rhs_index ];
+			if ( lhs_key < rhs_key )
+			{
+				++lhs_index;
+			}
+			else if ( rhs_key < lhs_key )
+			{
+				++rhs_index;
+			}
+			else
+			{
+				container value = std::visit(
+					intersection_visitor{}, lhs.m_containers[ lhs_index++ ], rhs.m_containers[ rhs_index++ ] );
+				if ( cardinality( value ) != 0 )
+				{
+					result.m_keys.push_back( lhs_key );
+					result.m_containers.push_back( std::move( value ) );
+				}
+			}
+		}
+		return result;
+	}
+
+	std::size_t compressed_bitset::lower_bound_key( const std::uint16_t key ) const noexcept
+	{
+		return static_cast<std::size_t>( std::ranges::lower_bound( m_keys, key ) - m_keys.begin() );
+	}
+
+	void compressed_bitset::erase_chunk( const std::size_t index ) noexcept
+	{
+		m_keys.erase( m_keys.begin() + index );
+		m_containers.erase( m_containers.begin() + index );
+	}
+}
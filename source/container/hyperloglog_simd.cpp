@@ -0,0 +1,28 @@
+#include "mclo/container/detail/hyperloglog_simd.hpp"
+
+#include <xsimd/xsimd.hpp>
+
+#include <algorithm>
+
+namespace
+{
+	using register_batch = xsimd::batch<std::uint8_t>;
+}
+
+void mclo::detail::hyperloglog_merge_simd( std::uint8_t* const registers,
+										   const std::uint8_t* const other,
+										   const std::size_t count ) noexcept
+{
+	const std::size_t simd_end = count - ( count % register_batch::size );
+	std::size_t index = 0;
+	for ( ; index != simd_end; index += register_batch::size )
+	{
+		const register_batch lhs = register_batch::load_unaligned( registers + index );
+		const register_batch rhs = register_batch::load_unaligned( other + index );
+		xsimd::max( lhs, rhs ).store_unaligned( registers + index );
+	}
+	for ( ; index != count; ++index )
+	{
+		registers[ index ] = std::max( registers[ index ], other[ index ] );
+	}
+}
@@ -0,0 +1,647 @@
+#include "mclo/container/minimal_perfect_hash.hpp"
+
+#include "mclo/debug/assert.hpp"
+#include "mclo/threading/parallel_for.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	constexpr std::uint64_t magic = UINT64_C( 0x3148504d4f4c434d ); // "MCLOMPH1" little endian
+
+	// Header word indices, followed by the partition table, the pilots and then the remap table
+	enum header_word : std::size_t
+	{
+		magic_word,
+		num_keys_word,
+		seed_word,
+		num_partitions_word,
+		buckets_per_partition_word,
+		dense_buckets_word,
+		dense_multiplier_word,
+		sparse_multiplier_word,
+		pilot_width_word,
+		num_pilot_words_word,
+		num_remap_words_word,
+		header_words,
+	};
+
+	// Partition key counts and remap entries are stored in 32 bits
+	constexpr std::size_t max_partition_size = std::size_t{ 1 } << 31;
+
+	// Far beyond what a bucket needs with any sensible load factor, reaching it means the partition is not solvable
+	// with these hashes
+	constexpr std::uint64_t max_pilot = std::uint64_t{ 1 } << 24;
+
+	[[nodiscard]] std::size_t words_for_bits( const std::uint64_t bits ) noexcept
+	{
+		return static_cast<std::size_t>( ( bits + 63 ) / 64 );
+	}
+}
+
+namespace mclo
+{
+	class mph_builder
+	{
+	public:
+		using function = minimal_perfect_hash;
+		static constexpr std::size_t partition_words = function::partition_words;
+
+		struct layout
+		{
+			std::uint64_t num_partitions = 0;
+			std::uint64_t buckets_per_partition = 0;
+			std::uint64_t dense_buckets = 0;
+			std::uint64_t dense_multiplier = 0;
+			std::uint64_t sparse_multiplier = 0;
+		};
+
+		struct partition_result
+		{
+			std::vector<std::uint32_t> pilots;
+			std::vector<std::uint32_t> remap;
+			std::uint64_t table_size = 0;
+			bool solved = false;
+		};
+
+		[[nodiscard]] static layout make_layout( const std::size_t num_keys, const mph_build_options& options )
+		{
+			layout result;
+			if ( num_keys == 0 )
+			{
+				// Nothing to look up but keep the bucket layout valid for deserialization
+				result.buckets_per_partition = 2;
+				result.dense_buckets = 1;
+				return result;
+			}
+
+			const std::size_t partition_size = std::clamp<std::size_t>( options.partition_size, 1, max_partition_size );
+			result.num_partitions = ( num_keys + partition_size - 1 ) / partition_size;
+
+			// PTHash sizes buckets as c * n / log2( n ), fewer keys per bucket the larger the partition
+			const double average_keys = static_cast<double>( num_keys ) / static_cast<double>( result.num_partitions );
+			const double buckets =
+				std::ceil( options.bucket_density * average_keys / std::max( std::log2( average_keys ), 1.0 ) );
+			result.buckets_per_partition = std::max<std::uint64_t>( static_cast<std::uint64_t>( buckets ), 2 );
+
+			result.dense_buckets = std::max<std::uint64_t>( result.buckets_per_partition * 3 / 10, 1 );
+			const std::uint64_t sparse_buckets = result.buckets_per_partition - result.dense_buckets;
+
+			// Scale the 60% and 40% ranges of the hash to the dense and sparse bucket counts
+			result.dense_multiplier = result.dense_buckets * 5 / 3;
+			result.sparse_multiplier = sparse_buckets * 5 / 2;
+			return result;
+		}
+
+		[[nodiscard]] static std::uint64_t partition_of( const layout& layout, const std::uint64_t hash ) noexcept
+		{
+			return function::mul_high( mclo::avalanche_bits( hash ), layout.num_partitions );
+		}
+
+		[[nodiscard]] static std::uint64_t bucket_of( const layout& layout, const std::uint64_t hash ) noexcept
+		{
+			const std::uint64_t in_partition = mclo::avalanche_bits( hash ) * layout.num_partitions;
+			return in_partition < function::dense_bucket_threshold
+					   ? function::mul_high( in_partition, layout.dense_multiplier )
+					   : layout.dense_buckets +
+							 function::mul_high( in_partition - function::dense_bucket_threshold,
+												 layout.sparse_multiplier );
+		}
+
+		[[nodiscard]] static partition_result build_partition( const layout& layout,
+															   const mclo::span<const std::uint64_t> hashes,
+															   const double load_factor )
+		{
+			partition_result result;
+			const std::size_t num_keys = hashes.size();
+			if ( num_keys == 0 )
+			{
+				// Lookups of unknown keys could still land here and must map in range, vanishingly unlikely so
+				// retrying with another seed is simplest
+				return result;
+			}
+
+			result.table_size = std::max<std::uint64_t>(
+				static_cast<std::uint64_t>( std::ceil( static_cast<double>( num_keys ) / load_factor ) ), num_keys );
+			const std::size_t num_buckets = static_cast<std::size_t>( layout.buckets_per_partition );
+
+			// Counting sort the hashes by bucket
+			std::vector<std::uint32_t> bucket_starts( num_buckets + 1, 0 );
+			for ( const std::uint64_t hash : hashes )
+			{
+				++bucket_starts[ bucket_of( layout, hash ) + 1 ];
+			}
+			std::uint32_t max_bucket_size = 0;
+			for ( std::size_t bucket = 0; bucket < num_buckets; ++bucket )
+			{
+				max_bucket_size = std::max( max_bucket_size, bucket_starts[ bucket + 1 ] );
+				bucket_starts[ bucket + 1 ] += bucket_starts[ bucket ];
+			}
+			std::vector<std::uint64_t> bucket_hashes( num_keys );
+			{
+				std::vector<std::uint32_t> insert_at( bucket_starts.begin(), bucket_starts.end() - 1 );
+				for ( const std::uint64_t hash : hashes )
+				{
+					bucket_hashes[ insert_at[ bucket_of( layout, hash ) ]++ ] = hash;
+				}
+			}
+
+			// Equal hashes can never be separated by a pilot so reject them up front
+			for ( std::size_t bucket = 0; bucket < num_buckets; ++bucket )
+			{
+				const auto first = bucket_hashes.begin() + bucket_starts[ bucket ];
+				const auto last = bucket_hashes.begin() + bucket_starts[ bucket + 1 ];
+				std::sort( first, last );
+				if ( std::adjacent_find( first, last ) != last )
+				{
+					return result;
+				}
+			}
+
+			// Order buckets largest first, counting sort by size
+			std::vector<std::uint32_t> size_starts( max_bucket_size + 2, 0 );
+			for ( std::size_t bucket = 0; bucket < num_buckets; ++bucket )
+			{
+				++size_starts[ max_bucket_size - ( bucket_starts[ bucket + 1 ] - bucket_starts[ bucket ] ) + 1 ];
+			}
+			for ( std::size_t index = 1; index < size_starts.size(); ++index )
+			{
+				size_starts[ index ] += size_starts[ index - 1 ];
+			}
+			std::vector<std::uint32_t> bucket_order( num_buckets );
+			for ( std::size_t bucket = 0; bucket < num_buckets; ++bucket )
+			{
+				const std::uint32_t size = bucket_starts[ bucket + 1 ] - bucket_starts[ bucket ];
+				bucket_order[ size_starts[ max_bucket_size - size ]++ ] = static_cast<std::uint32_t>( bucket );
+			}
+
+			// Place each bucket at the first pilot that moves all of its keys into free slots
+			std::vector<std::uint64_t> taken( words_for_bits( result.table_size ), 0 );
+			const auto is_taken = [ &taken ]( const std::uint64_t slot ) noexcept {
+				return ( taken[ slot / 64 ] >> ( slot % 64 ) ) & 1;
+			};
+			const auto flip_taken = [ &taken ]( const std::uint64_t slot ) noexcept {
+				taken[ slot / 64 ] ^= std::uint64_t{ 1 } << ( slot % 64 );
+			};
+
+			result.pilots.assign( num_buckets, 0 );
+			std::vector<std::uint64_t> slots( max_bucket_size );
+			for ( const std::uint32_t bucket : bucket_order )
+			{
+				const std::uint32_t first = bucket_starts[ bucket ];
+				const std::uint32_t size = bucket_starts[ bucket + 1 ] - first;
+				if ( size == 0 )
+				{
+					// Sorted by size so the rest are empty too
+					break;
+				}
+
+				std::uint64_t pilot = 0;
+				for ( ;; ++pilot )
+				{
+					if ( pilot == max_pilot ) [[unlikely]]
+					{
+						return result;
+					}
+
+					std::uint32_t placed = 0;
+					for ( ; placed < size; ++placed )
+					{
+						const std::uint64_t slot =
+							function::position( bucket_hashes[ first + placed ], pilot, result.table_size );
+						if ( is_taken( slot ) )
+						{
+							break;
+						}
+						// Mark straight away so keys in the same bucket cannot share a slot
+						flip_taken( slot );
+						slots[ placed ] = slot;
+					}
+					if ( placed == size )
+					{
+						break;
+					}
+					for ( std::uint32_t index = 0; index < placed; ++index )
+					{
+						flip_taken( slots[ index ] );
+					}
+				}
+				result.pilots[ bucket ] = static_cast<std::uint32_t>( pilot );
+			}
+
+			// Slots past num_keys are remapped in order to the holes left below num_keys
+			result.remap.assign( static_cast<std::size_t>( result.table_size - num_keys ), 0 );
+			std::uint64_t next_hole = 0;
+			for ( std::uint64_t slot = num_keys; slot < result.table_size; ++slot )
+			{
+				if ( is_taken( slot ) )
+				{
+					while ( is_taken( next_hole ) )
+					{
+						++next_hole;
+					}
+					const std::size_t remap_index = static_cast<std::size_t>( slot - num_keys );
+					result.remap[ remap_index ] = static_cast<std::uint32_t>( next_hole );
+					++next_hole;
+				}
+			}
+
+			result.solved = true;
+			return result;
+		}
+
+		[[nodiscard]] static std::optional<function> build( const mclo::span<const std::uint64_t> hashes,
+															const std::uint64_t seed,
+															const mph_build_options& options )
+		{
+			MCLO_DEBUG_ASSERT( options.load_factor > 0 && options.load_factor <= 1,
+							   "Load factor must be in (0, 1]",
+							   options.load_factor );
+			MCLO_DEBUG_ASSERT( options.bucket_density > 0, "Bucket density must be positive", options.bucket_density );
+
+			const std::size_t num_keys = hashes.size();
+			const layout layout = make_layout( num_keys, options );
+			const std::size_t num_partitions = static_cast<std::size_t>( layout.num_partitions );
+			const double load_factor = std::clamp( options.load_factor, 0.01, 1.0 );
+
+			// Group the hashes by partition, each thread counts then scatters its own chunk
+			std::vector<std::uint64_t> partition_hashes( num_keys );
+			std::vector<std::size_t> partition_starts( num_partitions + 1, 0 );
+			if ( num_partitions == 1 )
+			{
+				std::copy( hashes.begin(), hashes.end(), partition_hashes.begin() );
+				partition_starts[ 1 ] = num_keys;
+			}
+			else if ( num_partitions > 1 )
+			{
+				const std::size_t max_chunks = resolve_thread_count( options.num_threads );
+				std::vector<std::vector<std::size_t>> chunk_counts( max_chunks );
+				const std::size_t num_chunks = parallel_for_chunks(
+					options.num_threads,
+					num_keys,
+					[ & ]( const std::size_t chunk, const std::size_t begin, const std::size_t end ) {
+						std::vector<std::size_t>& counts = chunk_counts[ chunk ];
+						counts.assign( num_partitions, 0 );
+						for ( std::size_t index = begin; index < end; ++index )
+						{
+							++counts[ partition_of( layout, hashes[ index ] ) ];
+						}
+					} );
+
+				// Exclusive prefix over partitions then chunks gives each chunk its write position per partition
+				std::size_t total = 0;
+				for ( std::size_t partition = 0; partition < num_partitions; ++partition )
+				{
+					partition_starts[ partition ] = total;
+					for ( std::size_t chunk = 0; chunk < num_chunks; ++chunk )
+					{
+						const std::size_t count = chunk_counts[ chunk ][ partition ];
+						chunk_counts[ chunk ][ partition ] = total;
+						total += count;
+					}
+				}
+				partition_starts[ num_partitions ] = total;
+
+				parallel_for_chunks(
+					options.num_threads,
+					num_keys,
+					[ & ]( const std::size_t chunk, const std::size_t begin, const std::size_t end ) {
+						std::vector<std::size_t>& insert_at = chunk_counts[ chunk ];
+						for ( std::size_t index = begin; index < end; ++index )
+						{
+							const std::uint64_t hash = hashes[ index ];
+							partition_hashes[ insert_at[ partition_of( layout, hash ) ]++ ] = hash;
+						}
+					} );
+			}
+
+			std::vector<partition_result> partitions( num_partitions );
+			std::atomic_bool failed = false;
+			parallel_for( options.num_threads, num_partitions, [ & ]( const std::size_t partition ) {
+				if ( failed.load( std::memory_order_relaxed ) )
+				{
+					return;
+				}
+				const mclo::span<const std::uint64_t> keys( partition_hashes.data() + partition_starts[ partition ],
+															 partition_starts[ partition + 1 ] -
+																 partition_starts[ partition ] );
+				partitions[ partition ] = build_partition( layout, keys, load_factor );
+				if ( !partitions[ partition ].solved )
+				{
+					failed.store( true, std::memory_order_relaxed );
+				}
+			} );
+			if ( failed )
+			{
+				return std::nullopt;
+			}
+
+			// Pack everything into the serialized layout
+			std::uint32_t max_pilot_value = 0;
+			std::size_t num_remap = 0;
+			for ( const partition_result& partition : partitions )
+			{
+				for ( const std::uint32_t pilot : partition.pilots )
+				{
+					max_pilot_value = std::max( max_pilot_value, pilot );
+				}
+				num_remap += partition.remap.size();
+			}
+
+			const std::uint64_t pilot_width = static_cast<std::uint64_t>( std::bit_width( max_pilot_value ) );
+			const std::uint64_t num_pilots = layout.num_partitions * layout.buckets_per_partition;
+			const std::size_t num_pilot_words = words_for_bits( num_pilots * pilot_width ) + 1;
+			const std::size_t num_remap_words = ( num_remap + 1 ) / 2;
+
+			std::vector<std::uint64_t> words(
+				header_words + num_partitions * partition_words + num_pilot_words + num_remap_words, 0 );
+			words[ magic_word ] = magic;
+			words[ num_keys_word ] = num_keys;
+			words[ seed_word ] = seed;
+			words[ num_partitions_word ] = layout.num_partitions;
+			words[ buckets_per_partition_word ] = layout.buckets_per_partition;
+			words[ dense_buckets_word ] = layout.dense_buckets;
+			words[ dense_multiplier_word ] = layout.dense_multiplier;
+			words[ sparse_multiplier_word ] = layout.sparse_multiplier;
+			words[ pilot_width_word ] = pilot_width;
+			words[ num_pilot_words_word ] = num_pilot_words;
+			words[ num_remap_words_word ] = num_remap_words;
+
+			std::uint64_t* const partition_table = words.data() + header_words;
+			std::uint64_t* const pilots = partition_table + num_partitions * partition_words;
+			std::uint64_t* const remap = pilots + num_pilot_words;
+
+			std::uint64_t pilot_bit = 0;
+			std::uint64_t remap_index = 0;
+			for ( std::size_t partition = 0; partition < num_partitions; ++partition )
+			{
+				const partition_result& result = partitions[ partition ];
+				const std::uint64_t partition_keys = partition_starts[ partition + 1 ] - partition_starts[ partition ];
+				std::uint64_t* const meta = partition_table + partition * partition_words;
+				meta[ 0 ] = partition_starts[ partition ];
+				meta[ 1 ] = ( result.table_size << 32 ) | partition_keys;
+				meta[ 2 ] = remap_index;
+
+				for ( const std::uint64_t pilot : result.pilots )
+				{
+					if ( pilot_width != 0 )
+					{
+						const unsigned shift = static_cast<unsigned>( pilot_bit % 64 );
+						pilots[ pilot_bit / 64 ] |= pilot << shift;
+						if ( shift + pilot_width > 64 )
+						{
+							pilots[ pilot_bit / 64 + 1 ] |= pilot >> ( 64 - shift );
+						}
+					}
+					pilot_bit += pilot_width;
+				}
+
+				for ( const std::uint64_t entry : result.remap )
+				{
+					remap[ remap_index / 2 ] |= entry << ( ( remap_index % 2 ) * 32 );
+					++remap_index;
+				}
+			}
+
+			function result;
+			result.m_words = std::move( words );
+			result.bind_words( result.m_words );
+			return result;
+		}
+	};
+}
+
+mclo::span<const std::uint64_t> mclo::minimal_perfect_hash::empty_words() noexcept
+{
+	static const minimal_perfect_hash empty = *mph_builder::build( {}, 0, {} );
+	return empty.m_data;
+}
+
+std::optional<mclo::minimal_perfect_hash> mclo::minimal_perfect_hash::build(
+	const mclo::span<const std::uint64_t> hashes, const std::uint64_t seed, const mph_build_options& options )
+{
+	return mph_builder::build( hashes, seed, options );
+}
+
+mclo::minimal_perfect_hash::minimal_perfect_hash( const minimal_perfect_hash& other )
+	: m_words( other.m_words )
+{
+	bind_words( m_words.empty() ? other.m_data : mclo::span<const std::uint64_t>( m_words ) );
+}
+
+mclo::minimal_perfect_hash::minimal_perfect_hash( minimal_perfect_hash&& other ) noexcept
+	: m_words( std::move( other.m_words ) )
+{
+	bind_words( m_words.empty() ? other.m_data : mclo::span<const std::uint64_t>( m_words ) );
+	other.m_words.clear();
+	other.bind_words( {} );
+}
+
+mclo::minimal_perfect_hash& mclo::minimal_perfect_hash::operator=( const minimal_perfect_hash& other )
+{
+	if ( this != &other )
+	{
+		minimal_perfect_hash copy( other );
+		*this = std::move( copy );
+	}
+	return *this;
+}
+
+mclo::minimal_perfect_hash& mclo::minimal_perfect_hash::operator=( minimal_perfect_hash&& other ) noexcept
+{
+	if ( this != &other )
+	{
+		m_words = std::move( other.m_words );
+		bind_words( m_words.empty() ? other.m_data : mclo::span<const std::uint64_t>( m_words ) );
+		other.m_words.clear();
+		other.bind_words( {} );
+	}
+	return *this;
+}
+
+double mclo::minimal_perfect_hash::bits_per_key() const noexcept
+{
+	if ( m_num_keys == 0 )
+	{
+		return 0;
+	}
+	return static_cast<double>( m_data.size() * 64 ) / static_cast<double>( m_num_keys );
+}
+
+std::size_t mclo::minimal_perfect_hash::serialized_size() const noexcept
+{
+	return ( m_data.empty() ? empty_words().size() : m_data.size() ) * sizeof( std::uint64_t );
+}
+
+std::size_t mclo::minimal_perfect_hash::serialize( const mclo::span<std::byte> out ) const noexcept
+{
+	if ( m_data.empty() )
+	{
+		// A default constructed function still serializes as a valid function over no keys
+		const mclo::span<const std::uint64_t> words = empty_words();
+		MCLO_DEBUG_ASSERT(
+			out.size() >= words.size_bytes(), "Output buffer too small", out.size(), words.size_bytes() );
+		std::memcpy( out.data(), words.data(), words.size_bytes() );
+		return words.size_bytes();
+	}
+	const std::size_t size = serialized_size();
+	MCLO_DEBUG_ASSERT( out.size() >= size, "Output buffer too small", out.size(), size );
+	if ( size != 0 )
+	{
+		std::memcpy( out.data(), m_data.data(), size );
+	}
+	return size;
+}
+
+std::vector<std::byte> mclo::minimal_perfect_hash::serialize() const
+{
+	std::vector<std::byte> result( serialized_size() );
+	serialize( result );
+	return result;
+}
+
+std::optional<mclo::minimal_perfect_hash> mclo::minimal_perfect_hash::deserialize(
+	const mclo::span<const std::byte> data )
+{
+	std::vector<std::uint64_t> words( data.size() / sizeof( std::uint64_t ) );
+	if ( !words.empty() )
+	{
+		std::memcpy( words.data(), data.data(), words.size() * sizeof( std::uint64_t ) );
+	}
+	std::optional<minimal_perfect_hash> result = from_words( words );
+	if ( result )
+	{
+		// Copy the validated words so trailing data is not kept
+		words.resize( result->m_data.size() );
+		result->m_words = std::move( words );
+		result->bind_words( result->m_words );
+	}
+	return result;
+}
+
+std::optional<mclo::minimal_perfect_hash> mclo::minimal_perfect_hash::view( const mclo::span<const std::byte> data )
+{
+	if ( reinterpret_cast<std::uintptr_t>( data.data() ) % alignof( std::uint64_t ) != 0 )
+	{
+		return std::nullopt;
+	}
+	return from_words( mclo::span<const std::uint64_t>( reinterpret_cast<const std::uint64_t*>( data.data() ),
+														data.size() / sizeof( std::uint64_t ) ) );
+}
+
+std::optional<mclo::minimal_perfect_hash> mclo::minimal_perfect_hash::from_words(
+	const mclo::span<const std::uint64_t> words )
+{
+	if ( words.size() < header_words || words[ magic_word ] != magic )
+	{
+		return std::nullopt;
+	}
+
+	const std::uint64_t num_keys = words[ num_keys_word ];
+	const std::uint64_t num_partitions = words[ num_partitions_word ];
+	const std::uint64_t buckets_per_partition = words[ buckets_per_partition_word ];
+	const std::uint64_t dense_buckets = words[ dense_buckets_word ];
+	const std::uint64_t pilot_width = words[ pilot_width_word ];
+	const std::uint64_t num_pilot_words = words[ num_pilot_words_word ];
+	const std::uint64_t num_remap_words = words[ num_remap_words_word ];
+
+	// Bound every count before multiplying so nothing can overflow
+	const std::uint64_t max_words = words.size();
+	if ( num_partitions > max_words / partition_words || num_pilot_words > max_words ||
+		 num_remap_words > max_words || pilot_width > 32 || buckets_per_partition < 2 || dense_buckets == 0 ||
+		 dense_buckets >= buckets_per_partition || ( num_keys == 0 ) != ( num_partitions == 0 ) )
+	{
+		return std::nullopt;
+	}
+	const std::uint64_t total_words =
+		header_words + num_partitions * partition_words + num_pilot_words + num_remap_words;
+	if ( total_words > max_words )
+	{
+		return std::nullopt;
+	}
+
+	// The pilots must exactly fill their words plus the padding word
+	const std::uint64_t max_pilot_bits = ( num_pilot_words - 1 ) * 64;
+	if ( num_pilot_words == 0 || ( pilot_width != 0 && num_partitions != 0 &&
+								   buckets_per_partition > max_pilot_bits / pilot_width / num_partitions ) )
+	{
+		return std::nullopt;
+	}
+	if ( num_pilot_words != words_for_bits( num_partitions * buckets_per_partition * pilot_width ) + 1 )
+	{
+		return std::nullopt;
+	}
+
+	// Every bucket index computed must be in range of the partition's pilots
+	if ( mul_high( dense_bucket_threshold - 1, words[ dense_multiplier_word ] ) >= dense_buckets ||
+		 dense_buckets + mul_high( std::numeric_limits<std::uint64_t>::max() - dense_bucket_threshold,
+								   words[ sparse_multiplier_word ] ) >=
+			 buckets_per_partition )
+	{
+		return std::nullopt;
+	}
+
+	// Partitions must tile the keys and every slot must resolve to a key in its partition
+	const std::uint64_t* const partitions = words.data() + header_words;
+	const std::uint64_t* const remap = partitions + num_partitions * partition_words + num_pilot_words;
+	std::uint64_t next_key = 0;
+	std::uint64_t next_remap = 0;
+	for ( std::uint64_t partition = 0; partition < num_partitions; ++partition )
+	{
+		const std::uint64_t* const meta = partitions + partition * partition_words;
+		const std::uint64_t partition_keys = meta[ 1 ] & num_keys_mask;
+		const std::uint64_t table_size = meta[ 1 ] >> 32;
+		if ( meta[ 0 ] != next_key || partition_keys == 0 || table_size < partition_keys ||
+			 meta[ 2 ] != next_remap || table_size - partition_keys > num_remap_words * 2 - next_remap )
+		{
+			return std::nullopt;
+		}
+		for ( std::uint64_t index = next_remap; index < next_remap + table_size - partition_keys; ++index )
+		{
+			if ( ( ( remap[ index / 2 ] >> ( ( index % 2 ) * 32 ) ) & num_keys_mask ) >= partition_keys )
+			{
+				return std::nullopt;
+			}
+		}
+		next_key += partition_keys;
+		next_remap += table_size - partition_keys;
+	}
+	if ( next_key != num_keys )
+	{
+		return std::nullopt;
+	}
+
+	minimal_perfect_hash result;
+	result.bind_words( words.first( static_cast<std::size_t>( total_words ) ) );
+	return result;
+}
+
+void mclo::minimal_perfect_hash::bind_words( const mclo::span<const std::uint64_t> words ) noexcept
+{
+	m_data = words;
+	if ( words.empty() )
+	{
+		m_num_keys = m_seed = m_num_partitions = m_buckets_per_partition = 0;
+		m_dense_buckets = m_dense_multiplier = m_sparse_multiplier = 0;
+		m_pilot_width = m_pilot_mask = 0;
+		m_partitions = m_pilots = m_remap = nullptr;
+		return;
+	}
+
+	m_num_keys = words[ num_keys_word ];
+	m_seed = words[ seed_word ];
+	m_num_partitions = words[ num_partitions_word ];
+	m_buckets_per_partition = words[ buckets_per_partition_word ];
+	m_dense_buckets = words[ dense_buckets_word ];
+	m_dense_multiplier = words[ dense_multiplier_word ];
+	m_sparse_multiplier = words[ sparse_multiplier_word ];
+	m_pilot_width = words[ pilot_width_word ];
+	m_pilot_mask = m_pilot_width == 64 ? ~std::uint64_t{ 0 } : ( std::uint64_t{ 1 } << m_pilot_width ) - 1;
+	m_partitions = words.data() + header_words;
+	m_pilots = m_partitions + m_num_partitions * partition_words;
+	m_remap = m_pilots + words[ num_pilot_words_word ];
+}
@@ -3,6 +3,10 @@
 #include "mclo/debug/assert.hpp"
 #include "mclo/platform/attributes.hpp"
 
+#include "murmur_hash_3_simd.hpp"
+#include "platform/simd_dispatch.hpp"
+
+#include <cstring>
 #include <limits>
 
 // Look at end of the file for the hasher using the open source code copied here
@@ -313,3 +317,47 @@ std::size_t mclo::murmur_hash_3::finish() noexcept
 {
 	return PMurHash32_Result( m_hash, m_carry, m_total_length );
 }
+
+namespace
+{
+	std::uint32_t hash_key( const std::byte* const key, const std::size_t key_size, const std::uint32_t seed ) noexcept
+	{
+		std::uint32_t hash = seed;
+		std::uint32_t carry = 0;
+		PMurHash32_Process( &hash, &carry, reinterpret_cast<const std::uint8_t*>( key ), key_size );
+		return PMurHash32_Result( hash, carry, static_cast<std::uint32_t>( key_size ) );
+	}
+}
+
+namespace mclo::detail
+{
+	constinit const murmur_hash_3_kernels murmur_hash_3_kernels_baseline =
+		make_murmur_hash_3_kernels<xsimd::default_arch>();
+
+	const murmur_hash_3_kernels& active_murmur_hash_3_kernels() noexcept
+	{
+		static constexpr simd_kernel_table<murmur_hash_3_kernels> table =
+			MCLO_SIMD_KERNEL_TABLE( murmur_hash_3_kernels );
+		return active_simd_kernels( table );
+	}
+}
+
+void mclo::murmur_hash_3::hash_many( const mclo::span<const std::byte> data,
+									 const std::size_t key_size,
+									 const mclo::span<std::size_t> hashes,
+									 const std::uint32_t seed ) noexcept
+{
+	MCLO_DEBUG_ASSERT( key_size != 0, "Keys must not be empty" );
+	MCLO_DEBUG_ASSERT( data.size() % key_size == 0, "Data must be a whole number of keys", data.size(), key_size );
+	MCLO_DEBUG_ASSERT( key_size <= std::numeric_limits<std::uint32_t>::max(),
+					   "MurmurHash3 can only process up to uint32_t max data" );
+	const std::size_t count = data.size() / key_size;
+	MCLO_DEBUG_ASSERT( hashes.size() >= count, "Not enough space for the hashes", hashes.size(), count );
+
+	std::size_t index =
+		detail::active_murmur_hash_3_kernels().hash_many( data.data(), key_size, count, hashes.data(), seed );
+	for ( ; index < count; ++index )
+	{
+		hashes[ index ] = hash_key( data.data() + index * key_size, key_size, seed );
+	}
+}
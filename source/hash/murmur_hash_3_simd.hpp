@@ -0,0 +1,122 @@
+#pragma once
+
+#include <xsimd/xsimd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace mclo::detail
+{
+	// The SIMD kernels of murmur_hash_3, compiled for each simd_target by murmur_hash_3.cpp and the
+	// murmur_hash_3_simd_*.cpp files
+	struct murmur_hash_3_kernels
+	{
+		// Hashes the keys a whole register of keys at a time for the key sizes with a lane kernel, returning how many
+		// were hashed so the caller can finish the rest one at a time
+		std::size_t ( *hash_many )( const std::byte* data,
+									std::size_t key_size,
+									std::size_t count,
+									std::size_t* hashes,
+									std::uint32_t seed ) noexcept;
+	};
+
+	extern const murmur_hash_3_kernels murmur_hash_3_kernels_baseline;
+	extern const murmur_hash_3_kernels murmur_hash_3_kernels_avx2;
+	extern const murmur_hash_3_kernels murmur_hash_3_kernels_avx512;
+
+	[[nodiscard]] const murmur_hash_3_kernels& active_murmur_hash_3_kernels() noexcept;
+
+	// Each lane hashes its own key, keys of whole words never carry so this is DOBLOCK per word then the result
+	template <typename Arch, std::size_t Words>
+	[[nodiscard]] std::size_t murmur_hash_3_lanes( const std::byte* const data,
+												   const std::size_t count,
+												   std::size_t* const hashes,
+												   const std::uint32_t seed ) noexcept
+	{
+		using batch = xsimd::batch<std::uint32_t, Arch>;
+		constexpr std::size_t key_size = Words * 4;
+		constexpr std::size_t lanes = batch::size;
+
+		const auto rotl = []( const batch value, const std::int32_t bits ) noexcept {
+			return ( value << bits ) | ( value >> ( 32 - bits ) );
+		};
+		const batch c1( 0xcc9e2d51 );
+		const batch c2( 0x1b873593 );
+		const batch five( 5 );
+		const batch block_add( 0xe6546b64 );
+		const batch length( static_cast<std::uint32_t>( key_size ) );
+		const batch mix1( 0x85ebca6b );
+		const batch mix2( 0xc2b2ae35 );
+
+		alignas( Arch::alignment() ) std::uint32_t words[ lanes ];
+		std::size_t index = 0;
+		for ( ; index + lanes <= count; index += lanes )
+		{
+			const std::byte* const keys = data + index * key_size;
+			batch h( seed );
+			for ( std::size_t word = 0; word < Words; ++word )
+			{
+				for ( std::size_t lane = 0; lane < lanes; ++lane )
+				{
+					// Keys are packed at any alignment so copy the bytes before reading them little endian
+					std::uint8_t bytes[ 4 ];
+					std::memcpy( bytes, keys + lane * key_size + word * 4, sizeof( bytes ) );
+					words[ lane ] = static_cast<std::uint32_t>( bytes[ 0 ] ) |
+									static_cast<std::uint32_t>( bytes[ 1 ] ) << 8 |
+									static_cast<std::uint32_t>( bytes[ 2 ] ) << 16 |
+									static_cast<std::uint32_t>( bytes[ 3 ] ) << 24;
+				}
+				batch k = batch::load_aligned( words );
+				k *= c1;
+				k = rotl( k, 15 );
+				k *= c2;
+				h ^= k;
+				h = rotl( h, 13 );
+				h = h * five + block_add;
+			}
+
+			h ^= length;
+			h ^= h >> 16;
+			h *= mix1;
+			h ^= h >> 13;
+			h *= mix2;
+			h ^= h >> 16;
+
+			h.store_aligned( words );
+			for ( std::size_t lane = 0; lane < lanes; ++lane )
+			{
+				hashes[ index + lane ] = words[ lane ];
+			}
+		}
+		return index;
+	}
+
+	template <typename Arch>
+	[[nodiscard]] std::size_t murmur_hash_3_many_kernel( const std::byte* const data,
+														 const std::size_t key_size,
+														 const std::size_t count,
+														 std::size_t* const hashes,
+														 const std::uint32_t seed ) noexcept
+	{
+		switch ( key_size )
+		{
+			case 4:
+				return murmur_hash_3_lanes<Arch, 1>( data, count, hashes, seed );
+			case 8:
+				return murmur_hash_3_lanes<Arch, 2>( data, count, hashes, seed );
+			case 12:
+				return murmur_hash_3_lanes<Arch, 3>( data, count, hashes, seed );
+			case 16:
+				return murmur_hash_3_lanes<Arch, 4>( data, count, hashes, seed );
+			default:
+				return 0;
+		}
+	}
+
+	template <typename Arch>
+	[[nodiscard]] constexpr murmur_hash_3_kernels make_murmur_hash_3_kernels() noexcept
+	{
+		return { &murmur_hash_3_many_kernel<Arch> };
+	}
+}
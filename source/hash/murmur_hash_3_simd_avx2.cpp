@@ -0,0 +1,7 @@
+// Compiled with AVX2 enabled and only called when the CPU supports it, see source/CMakeLists.txt
+#include "murmur_hash_3_simd.hpp"
+
+namespace mclo::detail
+{
+	constinit const murmur_hash_3_kernels murmur_hash_3_kernels_avx2 = make_murmur_hash_3_kernels<xsimd::avx2>();
+}
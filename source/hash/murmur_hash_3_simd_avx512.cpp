@@ -0,0 +1,8 @@
+// Compiled with AVX-512 F, CD, DQ and BW enabled and only called when the CPU supports them, see source/CMakeLists.txt
+#include "murmur_hash_3_simd.hpp"
+
+namespace mclo::detail
+{
+	constinit const murmur_hash_3_kernels murmur_hash_3_kernels_avx512 =
+		make_murmur_hash_3_kernels<xsimd::avx512bw>();
+}
@@ -252,6 +252,38 @@ namespace
 		return ( ( ( uint64_t )p[ 0 ] ) << 56 ) | ( ( ( uint64_t )p[ k >> 1 ] ) << 32 ) |
 			   std::to_integer<std::uint8_t>( p[ k - 1 ] );
 	}
+
+	/*
+	 *  Hashes a whole key of 4 to 16 bytes, the same as a single write then finish.
+	 *
+	 *  @param p     Key to hash.
+	 *  @param len   Length of @p, in bytes.
+	 *  @param seed  Seed already mixed with len by rapidhash_seed.
+	 */
+	RAPIDHASH_INLINE std::size_t rapidhash_small_key( const std::byte* p,
+													  const std::size_t len,
+													  const uint64_t seed ) RAPIDHASH_NOEXCEPT
+	{
+		const std::byte* plast = p + len - 4;
+		const uint64_t delta = ( ( len & 24 ) >> ( len >> 3 ) );
+		uint64_t a = ( ( rapid_read32( p ) << 32 ) | rapid_read32( plast ) ) ^ RAPID_SECRET[ 1 ];
+		uint64_t b = ( ( rapid_read32( p + delta ) << 32 ) | rapid_read32( plast - delta ) ) ^ seed;
+		rapid_mum( &a, &b );
+		return rapid_mix( a ^ RAPID_SECRET[ 0 ] ^ len, b ^ RAPID_SECRET[ 1 ] );
+	}
+
+	// A constant size folds the read offsets, leaving two multiplies per key
+	template <std::size_t Size>
+	void rapidhash_many_fixed( const std::byte* data,
+							   const std::size_t count,
+							   std::size_t* hashes,
+							   const uint64_t seed ) RAPIDHASH_NOEXCEPT
+	{
+		for ( std::size_t index = 0; index < count; ++index, data += Size )
+		{
+			hashes[ index ] = rapidhash_small_key( data, Size, seed );
+		}
+	}
 }
 
 namespace mclo
@@ -261,10 +293,62 @@ namespace mclo
 	{
 	}
 
+	void rapidhash::hash_many( const mclo::span<const std::byte> data,
+							   const std::size_t key_size,
+							   const mclo::span<std::size_t> hashes,
+							   const std::uint64_t seed ) noexcept
+	{
+		MCLO_DEBUG_ASSERT( key_size != 0, "Keys must not be empty" );
+		MCLO_DEBUG_ASSERT( data.size() % key_size == 0, "Data must be a whole number of keys", data.size(), key_size );
+		const std::size_t count = data.size() / key_size;
+		MCLO_DEBUG_ASSERT( hashes.size() >= count, "Not enough space for the hashes", hashes.size(), count );
+
+		if ( key_size < 4 || key_size > 16 )
+		{
+			for ( std::size_t index = 0; index < count; ++index )
+			{
+				rapidhash hasher( seed );
+				hasher.write( data.subspan( index * key_size, key_size ) );
+				hashes[ index ] = hasher.finish();
+			}
+			return;
+		}
+
+		// Every key mixes the same length into the seed so it only needs mixing once
+		const std::uint64_t key_seed = rapidhash_seed( seed, key_size );
+		switch ( key_size )
+		{
+			case 4:
+				rapidhash_many_fixed<4>( data.data(), count, hashes.data(), key_seed );
+				break;
+			case 8:
+				rapidhash_many_fixed<8>( data.data(), count, hashes.data(), key_seed );
+				break;
+			case 12:
+				rapidhash_many_fixed<12>( data.data(), count, hashes.data(), key_seed );
+				break;
+			case 16:
+				rapidhash_many_fixed<16>( data.data(), count, hashes.data(), key_seed );
+				break;
+			default:
+				for ( std::size_t index = 0; index < count; ++index )
+				{
+					hashes[ index ] = rapidhash_small_key( data.data() + index * key_size, key_size, key_seed );
+				}
+				break;
+		}
+	}
+
 	void rapidhash::write( const mclo::span<const std::byte> data ) noexcept
 	{
 		const std::byte* p = data.data();
 		const std::size_t len = data.size();
+
+		// Each write overwrites m_a and m_b, so fold the previous write's into the seed to keep its tail bytes
+		if ( m_size != 0 )
+		{
+			m_seed = rapid_mix( m_a ^ RAPID_SECRET[ 2 ], m_b ^ m_seed );
+		}
 		m_size += len;
 
 		m_seed ^= rapid_mix( m_seed ^ RAPID_SECRET[ 0 ], RAPID_SECRET[ 1 ] ) ^ len;
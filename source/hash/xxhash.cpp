@@ -15,6 +15,22 @@ mclo::xxhash_64::xxhash_64( const XXH64_hash_t seed ) noexcept
 	MCLO_DEBUG_ASSERT( result == XXH_OK, "Failed to reset state with seed", seed );
 }
 
+void mclo::xxhash_64::hash_many( const mclo::span<const std::byte> data,
+								 const std::size_t key_size,
+								 const mclo::span<std::size_t> hashes,
+								 const XXH64_hash_t seed ) noexcept
+{
+	MCLO_DEBUG_ASSERT( key_size != 0, "Keys must not be empty" );
+	MCLO_DEBUG_ASSERT( data.size() % key_size == 0, "Data must be a whole number of keys", data.size(), key_size );
+	const std::size_t count = data.size() / key_size;
+	MCLO_DEBUG_ASSERT( hashes.size() >= count, "Not enough space for the hashes", hashes.size(), count );
+
+	for ( std::size_t index = 0; index < count; ++index )
+	{
+		hashes[ index ] = XXH64( data.data() + index * key_size, key_size, seed );
+	}
+}
+
 void mclo::xxhash_64::write( const mclo::span<const std::byte> data ) noexcept
 {
 	[[maybe_unused]] const XXH_errorcode result = XXH64_update( &m_state, data.data(), data.size() );
@@ -37,6 +53,22 @@ mclo::xxhash_3::xxhash_3( const XXH64_hash_t seed )
 	MCLO_DEBUG_ASSERT( result == XXH_OK, "Failed to reset state with seed", seed );
 }
 
+void mclo::xxhash_3::hash_many( const mclo::span<const std::byte> data,
+								const std::size_t key_size,
+								const mclo::span<std::size_t> hashes,
+								const XXH64_hash_t seed ) noexcept
+{
+	MCLO_DEBUG_ASSERT( key_size != 0, "Keys must not be empty" );
+	MCLO_DEBUG_ASSERT( data.size() % key_size == 0, "Data must be a whole number of keys", data.size(), key_size );
+	const std::size_t count = data.size() / key_size;
+	MCLO_DEBUG_ASSERT( hashes.size() >= count, "Not enough space for the hashes", hashes.size(), count );
+
+	for ( std::size_t index = 0; index < count; ++index )
+	{
+		hashes[ index ] = XXH3_64bits_withSeed( data.data() + index * key_size, key_size, seed );
+	}
+}
+
 void mclo::xxhash_3::write( const mclo::span<const std::byte> data ) noexcept
 {
 	[[maybe_unused]] const XXH_errorcode result = XXH3_64bits_update( m_state.get(), data.data(), data.size() );
@@ -0,0 +1,227 @@
+#include "mclo/memory/mirrored_memory.hpp"
+
+#include "mclo/platform/os_detection.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+#ifdef MCLO_OS_WINDOWS
+
+#include "mclo/platform/windows_wrapper.h"
+
+namespace
+{
+	// Another thread can map into the reserved range between releasing it and mapping the views, so retry a few times
+	constexpr int max_map_attempts = 8;
+
+	[[nodiscard]] std::size_t system_granularity() noexcept
+	{
+		SYSTEM_INFO info;
+		::GetSystemInfo( &info );
+		return info.dwAllocationGranularity;
+	}
+
+	[[nodiscard]] mclo::expected<std::byte*, std::error_code> map_mirrored( const std::size_t size )
+	{
+		const std::uint64_t mapping_size = size;
+		const HANDLE mapping = ::CreateFileMappingW( INVALID_HANDLE_VALUE,
+													nullptr,
+													PAGE_READWRITE,
+													static_cast<DWORD>( mapping_size >> 32 ),
+													static_cast<DWORD>( mapping_size ),
+													nullptr );
+		if ( mapping == nullptr )
+		{
+			return mclo::unexpected( mclo::last_error_code() );
+		}
+
+		std::error_code error = std::make_error_code( std::errc::not_enough_memory );
+		std::byte* result = nullptr;
+		for ( int attempt = 0; attempt < max_map_attempts && !result; ++attempt )
+		{
+			// Find a free range large enough for both views then release it so the views can be mapped there
+			void* const address = ::VirtualAlloc( nullptr, size * 2, MEM_RESERVE, PAGE_NOACCESS );
+			if ( address == nullptr )
+			{
+				error = mclo::last_error_code();
+				break;
+			}
+			::VirtualFree( address, 0, MEM_RELEASE );
+
+			void* const first = ::MapViewOfFileEx( mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, address );
+			void* const second = first ? ::MapViewOfFileEx( mapping,
+															FILE_MAP_ALL_ACCESS,
+															0,
+															0,
+															size,
+															static_cast<std::byte*>( address ) + size )
+									   : nullptr;
+			if ( second )
+			{
+				result = static_cast<std::byte*>( first );
+			}
+			else
+			{
+				error = mclo::last_error_code();
+				if ( first )
+				{
+					::UnmapViewOfFile( first );
+				}
+			}
+		}
+
+		// The views keep the mapping alive
+		::CloseHandle( mapping );
+		if ( !result )
+		{
+			return mclo::unexpected( error );
+		}
+		return result;
+	}
+
+	void unmap_mirrored( std::byte* const data, const std::size_t size ) noexcept
+	{
+		::UnmapViewOfFile( data + size );
+		::UnmapViewOfFile( data );
+	}
+}
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+namespace
+{
+	[[nodiscard]] std::error_code last_errno_code() noexcept
+	{
+		return std::error_code( errno, std::system_category() );
+	}
+
+	[[nodiscard]] std::size_t system_granularity() noexcept
+	{
+		return static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+	}
+
+	/// @brief Create an anonymous shared memory object with no name in the file system
+	[[nodiscard]] int create_shared_memory() noexcept
+	{
+#ifdef MCLO_OS_LINUX
+		return ::memfd_create( "mclo_mirrored_memory", MFD_CLOEXEC );
+#else
+		// Unique per process and call, unlinked straight away so only the descriptor refers to it
+		static std::atomic<std::uint64_t> counter = 0;
+		const std::string name = "/mclo_mirrored_" + std::to_string( ::getpid() ) + "_" +
+								 std::to_string( counter.fetch_add( 1, std::memory_order_relaxed ) );
+		const int fd = ::shm_open( name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR );
+		if ( fd != -1 )
+		{
+			::shm_unlink( name.c_str() );
+		}
+		return fd;
+#endif
+	}
+
+	[[nodiscard]] mclo::expected<std::byte*, std::error_code> map_mirrored( const std::size_t size )
+	{
+		const int fd = create_shared_memory();
+		if ( fd == -1 )
+		{
+			return mclo::unexpected( last_errno_code() );
+		}
+		if ( ::ftruncate( fd, static_cast<off_t>( size ) ) != 0 )
+		{
+			const std::error_code error = last_errno_code();
+			::close( fd );
+			return mclo::unexpected( error );
+		}
+
+		// Reserve both halves so the fixed mappings replace our own reservation and never another mapping
+		void* const reserved = ::mmap( nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+		if ( reserved == MAP_FAILED )
+		{
+			const std::error_code error = last_errno_code();
+			::close( fd );
+			return mclo::unexpected( error );
+		}
+
+		std::byte* const data = static_cast<std::byte*>( reserved );
+		for ( std::byte* const half : { data, data + size } )
+		{
+			if ( ::mmap( half, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0 ) == MAP_FAILED )
+			{
+				const std::error_code error = last_errno_code();
+				::munmap( reserved, size * 2 );
+				::close( fd );
+				return mclo::unexpected( error );
+			}
+		}
+
+		// The mappings keep the memory alive
+		::close( fd );
+		return data;
+	}
+
+	void unmap_mirrored( std::byte* const data, const std::size_t size ) noexcept
+	{
+		::munmap( data, size * 2 );
+	}
+}
+
+#endif
+
+namespace mclo
+{
+	mirrored_memory::mirrored_memory( const std::size_t min_size )
+	{
+		const expected<void, std::error_code> result = allocate( min_size );
+		if ( !result )
+		{
+			throw std::system_error( result.error(), "Failed to map mirrored memory" );
+		}
+	}
+
+	expected<void, std::error_code> mirrored_memory::allocate( const std::size_t min_size )
+	{
+		release();
+
+		const std::size_t alignment = granularity();
+		if ( min_size > std::numeric_limits<std::size_t>::max() / 2 - alignment )
+		{
+			return mclo::unexpected( std::make_error_code( std::errc::value_too_large ) );
+		}
+		const std::size_t size = ( std::max<std::size_t>( min_size, 1 ) + alignment - 1 ) / alignment * alignment;
+
+		expected<std::byte*, std::error_code> data = map_mirrored( size );
+		if ( !data )
+		{
+			return mclo::unexpected( data.error() );
+		}
+		m_data = *data;
+		m_size = size;
+		return {};
+	}
+
+	void mirrored_memory::release() noexcept
+	{
+		if ( m_data )
+		{
+			unmap_mirrored( m_data, m_size );
+			m_data = nullptr;
+			m_size = 0;
+		}
+	}
+
+	std::size_t mirrored_memory::granularity() noexcept
+	{
+		static const std::size_t result = system_granularity();
+		return result;
+	}
+}
@@ -0,0 +1,165 @@
+#include "mclo/platform/cpu_features.hpp"
+
+#include "mclo/debug/assert.hpp"
+#include "mclo/platform/arch_detection.hpp"
+#include "mclo/platform/compiler_detection.hpp"
+
+#include <atomic>
+
+#ifdef MCLO_ARCH_X86
+#ifdef MCLO_COMPILER_MSVC
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+#ifdef MCLO_ARCH_X86
+	struct cpuid_registers
+	{
+		unsigned eax = 0;
+		unsigned ebx = 0;
+		unsigned ecx = 0;
+		unsigned edx = 0;
+	};
+
+	cpuid_registers cpuid( const unsigned leaf, const unsigned subleaf ) noexcept
+	{
+		cpuid_registers result;
+#ifdef MCLO_COMPILER_MSVC
+		int regs[ 4 ];
+		__cpuid( regs, 0 );
+		if ( static_cast<unsigned>( regs[ 0 ] ) >= leaf )
+		{
+			__cpuidex( regs, static_cast<int>( leaf ), static_cast<int>( subleaf ) );
+			result = { static_cast<unsigned>( regs[ 0 ] ),
+					   static_cast<unsigned>( regs[ 1 ] ),
+					   static_cast<unsigned>( regs[ 2 ] ),
+					   static_cast<unsigned>( regs[ 3 ] ) };
+		}
+#else
+		__get_cpuid_count( leaf, subleaf, &result.eax, &result.ebx, &result.ecx, &result.edx );
+#endif
+		return result;
+	}
+
+	// The register state the operating system saves on a context switch, only valid when OSXSAVE is set
+	std::uint64_t xgetbv() noexcept
+	{
+#ifdef MCLO_COMPILER_MSVC
+		return _xgetbv( 0 );
+#else
+		unsigned eax, edx;
+		__asm__( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+		return ( static_cast<std::uint64_t>( edx ) << 32 ) | eax;
+#endif
+	}
+
+	constexpr bool has_bit( const unsigned reg, const int bit ) noexcept
+	{
+		return ( reg & ( 1u << bit ) ) != 0;
+	}
+
+	mclo::cpu_features detect_cpu_features() noexcept
+	{
+		const cpuid_registers leaf1 = cpuid( 1, 0 );
+		const cpuid_registers leaf7 = cpuid( 7, 0 );
+
+		// XMM and YMM state for AVX, plus the opmask and both halves of the ZMM state for AVX-512
+		constexpr std::uint64_t avx_state = 0x6;
+		constexpr std::uint64_t avx512_state = 0xe6;
+		const std::uint64_t os_state = has_bit( leaf1.ecx, 27 ) ? xgetbv() : 0;
+		const bool os_avx = ( os_state & avx_state ) == avx_state;
+		const bool os_avx512 = ( os_state & avx512_state ) == avx512_state;
+
+		mclo::cpu_features result;
+		result.sse2 = has_bit( leaf1.edx, 26 );
+		result.sse4_2 = has_bit( leaf1.ecx, 20 );
+		result.avx2 = os_avx && has_bit( leaf1.ecx, 28 ) && has_bit( leaf7.ebx, 5 );
+		result.bmi2 = has_bit( leaf7.ebx, 8 );
+		result.avx512f = os_avx512 && has_bit( leaf7.ebx, 16 );
+		result.avx512dq = result.avx512f && has_bit( leaf7.ebx, 17 );
+		result.avx512cd = result.avx512f && has_bit( leaf7.ebx, 28 );
+		result.avx512bw = result.avx512f && has_bit( leaf7.ebx, 30 );
+		return result;
+	}
+#else
+	mclo::cpu_features detect_cpu_features() noexcept
+	{
+		return {};
+	}
+#endif
+
+	std::atomic<mclo::simd_target>& active_target() noexcept
+	{
+		static std::atomic<mclo::simd_target> target = mclo::best_simd_target();
+		return target;
+	}
+}
+
+const mclo::cpu_features& mclo::host_cpu_features() noexcept
+{
+	static const cpu_features features = detect_cpu_features();
+	return features;
+}
+
+std::string_view mclo::to_string( const simd_target target ) noexcept
+{
+	switch ( target )
+	{
+		case simd_target::baseline:
+			return "baseline";
+		case simd_target::avx2:
+			return "avx2";
+		case simd_target::avx512:
+			return "avx512";
+	}
+	return "unknown";
+}
+
+bool mclo::is_simd_target_supported( const simd_target target ) noexcept
+{
+	// MCLO_SIMD_DISPATCH is defined when the kernels are also compiled for the targets above baseline
+#ifdef MCLO_SIMD_DISPATCH
+	const cpu_features& features = host_cpu_features();
+	switch ( target )
+	{
+		case simd_target::baseline:
+			return true;
+		case simd_target::avx2:
+			return features.avx2;
+		case simd_target::avx512:
+			// xsimd's avx512bw architecture builds on its avx512dq and avx512cd ones
+			return features.avx512f && features.avx512cd && features.avx512dq && features.avx512bw;
+	}
+	return false;
+#else
+	return target == simd_target::baseline;
+#endif
+}
+
+mclo::simd_target mclo::best_simd_target() noexcept
+{
+	for ( const simd_target target : { simd_target::avx512, simd_target::avx2 } )
+	{
+		if ( is_simd_target_supported( target ) )
+		{
+			return target;
+		}
+	}
+	return simd_target::baseline;
+}
+
+mclo::simd_target mclo::active_simd_target() noexcept
+{
+	return active_target().load( std::memory_order_relaxed );
+}
+
+mclo::simd_target mclo::set_active_simd_target( const simd_target target ) noexcept
+{
+	MCLO_DEBUG_ASSERT( is_simd_target_supported( target ), "SIMD target is not supported", to_string( target ) );
+	return active_target().exchange( target, std::memory_order_relaxed );
+}
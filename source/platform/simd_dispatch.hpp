@@ -0,0 +1,33 @@
+#pragma once
+
+#include "mclo/platform/cpu_features.hpp"
+
+#include <array>
+
+// Runtime dispatch of SIMD kernels. A module's kernels are templated on the xsimd architecture and gathered into a
+// struct of function pointers, one struct per simd_target. The baseline struct is compiled with the library's flags,
+// the others in their own translation unit compiled for that instruction set, see source/CMakeLists.txt.
+//
+// Code in the per-target translation units must stay out of any inline function or template shared with the rest of
+// the library, as the linker may keep the copy using the wider instructions. Templating every kernel on the xsimd
+// architecture keeps each instantiation in exactly one translation unit.
+
+namespace mclo::detail
+{
+	template <typename Kernels>
+	using simd_kernel_table = std::array<const Kernels*, simd_target_count>;
+
+	// The kernels for the active target, targets that are not compiled in are never active
+	template <typename Kernels>
+	[[nodiscard]] const Kernels& active_simd_kernels( const simd_kernel_table<Kernels>& table ) noexcept
+	{
+		return *table[ static_cast<std::size_t>( active_simd_target() ) ];
+	}
+}
+
+// Builds a simd_kernel_table from the kernels named PREFIX_baseline, PREFIX_avx2 and PREFIX_avx512
+#ifdef MCLO_SIMD_DISPATCH
+#define MCLO_SIMD_KERNEL_TABLE( PREFIX ) { &PREFIX##_baseline, &PREFIX##_avx2, &PREFIX##_avx512 }
+#else
+#define MCLO_SIMD_KERNEL_TABLE( PREFIX ) { &PREFIX##_baseline, nullptr, nullptr }
+#endif
@@ -2,10 +2,119 @@
 
 #include <xsimd/xsimd.hpp>
 
+#include <bit>
+#include <cstddef>
+
 namespace mclo::detail
 {
-	using char_batch = xsimd::batch<char>;
+	// The SIMD kernels of the ASCII string functions, compiled for each simd_target by ascii_string_simd.cpp and the
+	// ascii_string_simd_*.cpp files
+	struct ascii_string_kernels
+	{
+		void ( *to_upper )( char* first, char* last ) noexcept;
+		void ( *to_lower )( char* first, char* last ) noexcept;
+		int ( *compare_ignore_case )( const char* lhs, const char* rhs, std::size_t size ) noexcept;
+	};
+
+	extern const ascii_string_kernels ascii_string_kernels_baseline;
+	extern const ascii_string_kernels ascii_string_kernels_avx2;
+	extern const ascii_string_kernels ascii_string_kernels_avx512;
+
+	[[nodiscard]] const ascii_string_kernels& active_ascii_string_kernels() noexcept;
+
+	template <typename Arch, bool Upper>
+	[[nodiscard]] xsimd::batch<char, Arch> convert_case_batch( const char* ptr ) noexcept
+	{
+		using char_batch = xsimd::batch<char, Arch>;
+
+		//// SSE has no unsigned comparisons, so we must do the unsigned trick by shifting the chars
+		//// into -128 to -128 + ('a' - 'z' )
+
+		static constexpr char start_char = Upper ? 'a' : 'A';
+		static constexpr char end_char = Upper ? 'z' : 'Z';
+
+		const char_batch value = char_batch::load_unaligned( ptr );
+		const char_batch shifted = value - char_batch( start_char - 128 );
+
+		// 0 = lower case, -1 = anything else
+		const char_batch nomodify = xsimd::bitwise_cast( shifted > char_batch( -128 + end_char - start_char ) );
+
+		const char_batch flip = xsimd::bitwise_andnot( char_batch( 0x20 ), nomodify );
+
+		//// just mask the XOR-mask so elements are XORed with 0 instead of 0x20
+		//// XOR's identity value is 0, same as addition's
+		return xsimd::bitwise_xor( value, flip );
+	}
+
+	// The scalar tails use this rather than the inline scalar functions, whose copy compiled here could be the one the
+	// linker keeps, templating on Arch keeps each target's copy in its own translation unit, see
+	// platform/simd_dispatch.hpp
+	template <typename Arch, bool Upper>
+	[[nodiscard]] char convert_case_char( const char c ) noexcept
+	{
+		constexpr char start_char = Upper ? 'a' : 'A';
+		constexpr char end_char = Upper ? 'z' : 'Z';
+		return ( c >= start_char && c <= end_char ) ? static_cast<char>( c ^ 0x20 ) : c;
+	}
+
+	template <typename Arch, bool Upper>
+	void convert_case_kernel( char* first, char* const last ) noexcept
+	{
+		using char_batch = xsimd::batch<char, Arch>;
+		for ( ; static_cast<std::size_t>( last - first ) >= char_batch::size; first += char_batch::size )
+		{
+			convert_case_batch<Arch, Upper>( first ).store_unaligned( first );
+		}
+
+		for ( ; first != last; ++first )
+		{
+			*first = convert_case_char<Arch, Upper>( *first );
+		}
+	}
+
+	template <typename Arch>
+	[[nodiscard]] int compare_ignore_case_kernel( const char* lhs, const char* rhs, std::size_t size ) noexcept
+	{
+		using char_batch = xsimd::batch<char, Arch>;
+		while ( size >= char_batch::size )
+		{
+			const char_batch lhs_data = convert_case_batch<Arch, true>( lhs );
+			const char_batch rhs_data = convert_case_batch<Arch, true>( rhs );
+
+			const auto mask = ( lhs_data == rhs_data ).mask();
+			const std::size_t first_not_equal = static_cast<std::size_t>( std::countr_one( mask ) );
+
+			if ( first_not_equal < char_batch::size )
+			{
+				// It is quicker to compute the difference here ourselves than to use the batch.get function as that
+				// performs an aligned store into a buffer just to extract out the data, whereas with this the two
+				// pointers are already in cache and this is very simple branchless CPU wise code as to_upper becomes a
+				// conditional move
+				return convert_case_char<Arch, true>( lhs[ first_not_equal ] ) -
+					   convert_case_char<Arch, true>( rhs[ first_not_equal ] );
+			}
+
+			lhs += char_batch::size;
+			rhs += char_batch::size;
+			size -= char_batch::size;
+		}
+
+		for ( ; size != 0; --size )
+		{
+			const int result = convert_case_char<Arch, false>( *lhs++ ) - convert_case_char<Arch, false>( *rhs++ );
+			if ( result != 0 )
+			{
+				return result;
+			}
+		}
+		return 0;
+	}
 
-	[[nodiscard]] char_batch to_upper_simd( const char* ptr ) noexcept;
-	[[nodiscard]] char_batch to_lower_simd( const char* ptr ) noexcept;
+	template <typename Arch>
+	[[nodiscard]] constexpr ascii_string_kernels make_ascii_string_kernels() noexcept
+	{
+		return { &convert_case_kernel<Arch, true>,
+				 &convert_case_kernel<Arch, false>,
+				 &compare_ignore_case_kernel<Arch> };
+	}
 }
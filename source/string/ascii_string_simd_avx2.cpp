@@ -0,0 +1,7 @@
+// Compiled with AVX2 enabled and only called when the CPU supports it, see source/CMakeLists.txt
+#include "ascii_string_simd.hpp"
+
+namespace mclo::detail
+{
+	constinit const ascii_string_kernels ascii_string_kernels_avx2 = make_ascii_string_kernels<xsimd::avx2>();
+}
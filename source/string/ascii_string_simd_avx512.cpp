@@ -0,0 +1,7 @@
+// Compiled with AVX-512 F, CD, DQ and BW enabled and only called when the CPU supports them, see source/CMakeLists.txt
+#include "ascii_string_simd.hpp"
+
+namespace mclo::detail
+{
+	constinit const ascii_string_kernels ascii_string_kernels_avx512 = make_ascii_string_kernels<xsimd::avx512bw>();
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/atomic_bitset.hpp"
+#include "mclo/container/atomic_dynamic_bitset.hpp"
+#include "mclo/meta/type_list.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+	constexpr std::size_t bitset_size = 100;
+	constexpr std::size_t num_threads = 4;
+
+	template <std::unsigned_integral UnderlyingType>
+	class atomic_dynamic_bitset_wrapper : public mclo::atomic_dynamic_bitset<UnderlyingType>
+	{
+	public:
+		atomic_dynamic_bitset_wrapper()
+			: mclo::atomic_dynamic_bitset<UnderlyingType>( bitset_size )
+		{
+		}
+	};
+
+	using test_types = mclo::meta::type_list<mclo::atomic_bitset<bitset_size, std::uint8_t>,
+											 mclo::atomic_bitset<bitset_size, std::uint32_t>,
+											 mclo::atomic_bitset<bitset_size, std::uint64_t>,
+											 atomic_dynamic_bitset_wrapper<std::uint16_t>,
+											 atomic_dynamic_bitset_wrapper<std::uint64_t>>;
+
+	template <typename Func>
+	void run_threads( Func func )
+	{
+		std::vector<std::thread> threads;
+		for ( std::size_t index = 0; index < num_threads; ++index )
+		{
+			threads.emplace_back( func, index );
+		}
+		for ( std::thread& thread : threads )
+		{
+			thread.join();
+		}
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "atomic_bitset default, is empty", "[atomic_bitset]", test_types )
+{
+	const TestType set;
+
+	CHECK( set.size() == bitset_size );
+	CHECK( set.none() );
+	CHECK_FALSE( set.any() );
+	CHECK( set.count() == 0 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "atomic_bitset test_and_set, returns previous value", "[atomic_bitset]", test_types )
+{
+	TestType set;
+
+	CHECK_FALSE( set.test_and_set( 42 ) );
+	CHECK( set.test_and_set( 42 ) );
+	CHECK( set.test( 42 ) );
+	CHECK_FALSE( set.test( 41 ) );
+	CHECK( set.count() == 1 );
+	CHECK( set.any() );
+}
+
+TEMPLATE_LIST_TEST_CASE( "atomic_bitset test_and_reset, returns previous value", "[atomic_bitset]", test_types )
+{
+	TestType set;
+	set.set( 7 );
+	set.set( 99 );
+
+	CHECK( set.test_and_reset( 7 ) );
+	CHECK_FALSE( set.test_and_reset( 7 ) );
+	CHECK_FALSE( set.test( 7 ) );
+	CHECK( set.test( 99 ) );
+
+	set.reset( 99 );
+	CHECK( set.none() );
+}
+
+TEMPLATE_LIST_TEST_CASE( "atomic_bitset find_first_unset_and_set, claims lowest unset bits then npos",
+						 "[atomic_bitset]",
+						 test_types )
+{
+	TestType set;
+	set.set( 0 );
+	set.set( 2 );
+
+	CHECK( set.find_first_unset_and_set() == 1 );
+	CHECK( set.find_first_unset_and_set() == 3 );
+	CHECK( set.find_first_unset_and_set( 50 ) == 50 );
+	CHECK( set.find_first_unset_and_set( 50 ) == 51 );
+
+	while ( set.find_first_unset_and_set() != TestType::npos )
+	{
+	}
+	CHECK( set.count() == bitset_size );
+	CHECK( set.find_first_unset_and_set( 10 ) == TestType::npos );
+}
+
+TEMPLATE_LIST_TEST_CASE( "atomic_bitset load and unsafe_bitset, see the same bits", "[atomic_bitset]", test_types )
+{
+	TestType set;
+	set.set( 3 );
+	set.set( 64 );
+	set.set( 98 );
+
+	const typename TestType::bitset_type loaded = set.load();
+	CHECK( loaded == set.unsafe_bitset() );
+
+	std::vector<std::size_t> positions;
+	loaded.for_each_set( [ &positions ]( const std::size_t pos ) { positions.push_back( pos ); } );
+	CHECK_THAT( positions, RangeEquals( std::vector<std::size_t>{ 3, 64, 98 } ) );
+
+	set.reset_all();
+	CHECK( set.none() );
+	CHECK( loaded.count() == 3 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "atomic_bitset test_and_set from many threads, each bit claimed once",
+						 "[atomic_bitset]",
+						 test_types )
+{
+	TestType set;
+	std::vector<std::size_t> claimed( num_threads );
+
+	run_threads( [ &set, &claimed ]( const std::size_t thread_index ) {
+		for ( std::size_t pos = 0; pos < bitset_size; ++pos )
+		{
+			if ( !set.test_and_set( ( pos + thread_index * 13 ) % bitset_size ) )
+			{
+				++claimed[ thread_index ];
+			}
+		}
+	} );
+
+	CHECK( std::accumulate( claimed.begin(), claimed.end(), std::size_t{ 0 } ) == bitset_size );
+	CHECK( set.count() == bitset_size );
+}
+
+TEMPLATE_LIST_TEST_CASE( "atomic_bitset find_first_unset_and_set from many threads, allocates unique slots",
+						 "[atomic_bitset]",
+						 test_types )
+{
+	TestType set;
+	std::vector<std::vector<std::size_t>> slots( num_threads );
+
+	run_threads( [ &set, &slots ]( const std::size_t thread_index ) {
+		for ( ;; )
+		{
+			const std::size_t slot = set.find_first_unset_and_set();
+			if ( slot == TestType::npos )
+			{
+				break;
+			}
+			slots[ thread_index ].push_back( slot );
+		}
+	} );
+
+	std::vector<std::size_t> all_slots;
+	for ( const std::vector<std::size_t>& thread_slots : slots )
+	{
+		all_slots.insert( all_slots.end(), thread_slots.begin(), thread_slots.end() );
+	}
+	std::ranges::sort( all_slots );
+
+	std::vector<std::size_t> expected( bitset_size );
+	std::iota( expected.begin(), expected.end(), std::size_t{ 0 } );
+	CHECK_THAT( all_slots, RangeEquals( expected ) );
+	CHECK( set.count() == bitset_size );
+}
@@ -341,6 +341,46 @@ TEMPLATE_LIST_TEST_CASE( "bitset operator^", "[bitset]", test_types )
 	check_only_these_set( set ^ other, index_array<2, 4, 16, 33>() );
 }
 
+TEMPLATE_LIST_TEST_CASE( "bitset and_not", "[bitset]", test_types )
+{
+	TestType set;
+	set.set( 4 ).set( 32 ).set( 33 );
+
+	TestType other;
+	other.set( 2 ).set( 16 ).set( 32 );
+
+	set.and_not( other );
+	check_only_these_set( set, index_array<4, 33>() );
+}
+
+TEMPLATE_LIST_TEST_CASE( "bitset fused counts, match count of materialized result", "[bitset]", test_types )
+{
+	TestType set;
+	set.set( 4 ).set( 32 ).set( 33 );
+
+	TestType other;
+	other.set( 2 ).set( 16 ).set( 32 );
+
+	CHECK( and_count( set, other ) == 1 );
+	CHECK( or_count( set, other ) == 5 );
+	CHECK( xor_count( set, other ) == 4 );
+	CHECK( and_not_count( set, other ) == 2 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "bitset for_each_set_batch, visits set bits in order", "[bitset]", test_types )
+{
+	using size_type = typename TestType::size_type;
+	TestType set;
+	set.set( 0 ).set( 1 ).set( 4 ).set( 32 ).set( 33 );
+
+	std::vector<size_type> visited;
+	set.for_each_set_batch( [ & ]( const mclo::span<const size_type> positions ) {
+		visited.insert( visited.end(), positions.begin(), positions.end() );
+	} );
+
+	CHECK_THAT( visited, RangeEquals( std::vector<size_type>{ 0, 1, 4, 32, 33 } ) );
+}
+
 TEMPLATE_LIST_TEST_CASE( "bitset operator~", "[bitset]", test_types )
 {
 	TestType set;
@@ -510,3 +550,136 @@ TEST_CASE( "Dynamic bitset copy from underlying container", "[bitset]" )
 	CHECK( set.size() == 10 );
 	CHECK( set.count() == 8 );
 }
+
+namespace
+{
+	using large_test_types = mclo::meta::type_list<mclo::dynamic_bitset<std::uint8_t>,
+												   mclo::dynamic_bitset<std::uint16_t>,
+												   mclo::dynamic_bitset<std::uint32_t>,
+												   mclo::dynamic_bitset<std::uint64_t>>;
+
+	// Sizes large enough to take the SIMD paths, with and without a partial vector and partial value at the end
+	constexpr std::size_t large_bitset_sizes[] = { 1024, 4099, 20000 };
+
+	template <typename Bitset>
+	Bitset make_patterned_bitset( const std::size_t size, const std::size_t stride, const std::size_t offset )
+	{
+		Bitset set( size );
+		for ( std::size_t index = offset; index < size; index += stride )
+		{
+			set.set( index );
+		}
+		return set;
+	}
+
+	template <typename Bitset, typename Op>
+	Bitset apply_per_bit( const Bitset& lhs, const Bitset& rhs, Op op )
+	{
+		Bitset result( lhs.size() );
+		for ( std::size_t index = 0; index < lhs.size(); ++index )
+		{
+			result.set( index, op( lhs.test( index ), rhs.test( index ) ) );
+		}
+		return result;
+	}
+
+	template <typename Bitset>
+	std::size_t count_per_bit( const Bitset& set )
+	{
+		std::size_t total = 0;
+		for ( std::size_t index = 0; index < set.size(); ++index )
+		{
+			total += set.test( index );
+		}
+		return total;
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "large dynamic_bitset, set algebra, matches per bit result", "[bitset]", large_test_types )
+{
+	for ( const std::size_t size : large_bitset_sizes )
+	{
+		const TestType lhs = make_patterned_bitset<TestType>( size, 3, 1 );
+		const TestType rhs = make_patterned_bitset<TestType>( size, 7, 2 );
+
+		CHECK( ( lhs & rhs ) == apply_per_bit( lhs, rhs, []( bool l, bool r ) { return l && r; } ) );
+		CHECK( ( lhs | rhs ) == apply_per_bit( lhs, rhs, []( bool l, bool r ) { return l || r; } ) );
+		CHECK( ( lhs ^ rhs ) == apply_per_bit( lhs, rhs, []( bool l, bool r ) { return l != r; } ) );
+		CHECK( TestType( lhs ).and_not( rhs ) == apply_per_bit( lhs, rhs, []( bool l, bool r ) { return l && !r; } ) );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "large dynamic_bitset, count and fused counts, match per bit count",
+						 "[bitset]",
+						 large_test_types )
+{
+	for ( const std::size_t size : large_bitset_sizes )
+	{
+		TestType lhs = make_patterned_bitset<TestType>( size, 3, 1 );
+		lhs.set( size - 1 );
+		const TestType rhs = make_patterned_bitset<TestType>( size, 7, 2 );
+
+		CHECK( lhs.count() == count_per_bit( lhs ) );
+		CHECK( TestType( size ).set().count() == size );
+		CHECK( and_count( lhs, rhs ) == ( lhs & rhs ).count() );
+		CHECK( or_count( lhs, rhs ) == ( lhs | rhs ).count() );
+		CHECK( xor_count( lhs, rhs ) == ( lhs ^ rhs ).count() );
+		CHECK( and_not_count( lhs, rhs ) == TestType( lhs ).and_not( rhs ).count() );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "large sparse dynamic_bitset, iterate set bits, visits every set bit",
+						 "[bitset]",
+						 large_test_types )
+{
+	using size_type = typename TestType::size_type;
+	for ( const std::size_t size : large_bitset_sizes )
+	{
+		TestType set( size );
+		const std::vector<size_type> expected{ 0, 9, 700, 701, size - 2, size - 1 };
+		for ( const size_type index : expected )
+		{
+			set.set( index );
+		}
+
+		std::vector<size_type> for_each_visited;
+		set.for_each_set( [ & ]( const size_type index ) { for_each_visited.push_back( index ); } );
+
+		std::vector<size_type> batch_visited;
+		set.for_each_set_batch( [ & ]( const mclo::span<const size_type> positions ) {
+			batch_visited.insert( batch_visited.end(), positions.begin(), positions.end() );
+		} );
+
+		std::vector<size_type> find_visited;
+		for ( size_type index = set.find_first_set(); index != TestType::npos; index = set.find_first_set( index + 1 ) )
+		{
+			find_visited.push_back( index );
+		}
+
+		CHECK_THAT( for_each_visited, RangeEquals( expected ) );
+		CHECK_THAT( batch_visited, RangeEquals( expected ) );
+		CHECK_THAT( find_visited, RangeEquals( expected ) );
+		CHECK( set.any() );
+		CHECK_FALSE( TestType( size ).any() );
+	}
+}
+
+TEST_CASE( "full dynamic_bitset, for_each_set_batch, batches are bounded and ordered", "[bitset]" )
+{
+	using bitset = mclo::dynamic_bitset<>;
+	using size_type = bitset::size_type;
+	bitset set( 1000 );
+	set.set();
+
+	size_type next = 0;
+	set.for_each_set_batch( [ & ]( const mclo::span<const size_type> positions ) {
+		CHECK_FALSE( positions.empty() );
+		CHECK( positions.size() <= bitset::for_each_set_batch_size );
+		for ( const size_type index : positions )
+		{
+			CHECK( index == next++ );
+		}
+	} );
+
+	CHECK( next == 1000 );
+}
@@ -5,6 +5,7 @@
 #include "mclo/container/circular_buffer.hpp"
 
 #include <array>
+#include <string>
 #include <unordered_set>
 
 using namespace Catch::Matchers;
@@ -89,6 +90,45 @@ TEST_CASE( "circular_buffer push back over capacity overwrites", "[circular_buff
 	check_equals( buffer, { 1, 2, 3, 4, 5 } );
 }
 
+TEST_CASE( "circular_buffer push back n wrapping around, contains values", "[circular_buffer]" )
+{
+	mclo::circular_buffer<int> buffer( 5 );
+	buffer.push_back_n( std::array{ 0, 1, 2 } );
+	std::array<int, 2> popped{};
+	CHECK( buffer.pop_front_n( popped ) == 2 );
+	CHECK_THAT( popped, RangeEquals( std::array{ 0, 1 } ) );
+
+	buffer.push_back_n( std::array{ 3, 4, 5 } );
+
+	check_equals( buffer, { 2, 3, 4, 5 } );
+}
+
+TEST_CASE( "circular_buffer push back n over capacity, overwrites like push back", "[circular_buffer]" )
+{
+	mclo::circular_buffer<int> buffer( 5 );
+	buffer.push_back_n( std::array{ 0, 1, 2, 3 } );
+	buffer.push_back_n( std::array{ 4, 5, 6 } );
+
+	check_equals( buffer, { 2, 3, 4, 5, 6 } );
+
+	buffer.push_back_n( std::array{ 7, 8, 9, 10, 11, 12, 13 } );
+
+	check_equals( buffer, { 9, 10, 11, 12, 13 } );
+}
+
+TEST_CASE( "circular_buffer pop front n more than size, pops everything", "[circular_buffer]" )
+{
+	mclo::circular_buffer<std::string> buffer( 4 );
+	buffer.push_back( "a" );
+	buffer.push_back( "b" );
+	std::array<std::string, 3> popped;
+
+	CHECK( buffer.pop_front_n( popped ) == 2 );
+
+	CHECK_THAT( popped, RangeEquals( std::array<std::string, 3>{ "a", "b", "" } ) );
+	CHECK( buffer.empty() );
+}
+
 // TEST_CASE( "Quick test" )
 //{
 //	mclo::circular_buffer<int> buffer( 5 );
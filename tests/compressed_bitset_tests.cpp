@@ -0,0 +1,343 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/compressed_bitset.hpp"
+
+#include <random>
+#include <set>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+	std::vector<std::uint32_t> to_vector( const mclo::compressed_bitset& bitset )
+	{
+		std::vector<std::uint32_t> result;
+		bitset.for_each_set( [ & ]( const std::uint32_t pos ) { result.push_back( pos ); } );
+		return result;
+	}
+
+	// Random positions spread over a few chunks, density is the chance each position within those chunks is set
+	std::set<std::uint32_t> make_random_positions( const double density, const std::uint32_t seed )
+	{
+		std::mt19937 rng( seed );
+		std::bernoulli_distribution set_dist( density );
+		std::set<std::uint32_t> result;
+		for ( const std::uint32_t chunk : { 0u, 1u, 7u, 65535u } )
+		{
+			for ( std::uint32_t low = 0; low < 65536; ++low )
+			{
+				if ( set_dist( rng ) )
+				{
+					result.insert( chunk << 16 | low );
+				}
+			}
+		}
+		return result;
+	}
+
+	mclo::compressed_bitset make_bitset( const std::set<std::uint32_t>& positions )
+	{
+		mclo::compressed_bitset result;
+		for ( const std::uint32_t pos : positions )
+		{
+			result.set( pos );
+		}
+		return result;
+	}
+
+	std::span<const std::byte> as_bytes( const std::vector<std::uint8_t>& data )
+	{
+		return std::as_bytes( std::span( data ) );
+	}
+}
+
+TEST_CASE( "default constructed compressed_bitset, is empty", "[compressed_bitset]" )
+{
+	const mclo::compressed_bitset bitset;
+
+	CHECK( bitset.none() );
+	CHECK_FALSE( bitset.any() );
+	CHECK( bitset.count() == 0 );
+	CHECK( bitset.num_chunks() == 0 );
+	CHECK_FALSE( bitset.find_first_set() );
+	CHECK_FALSE( bitset.test( 0 ) );
+	CHECK( bitset.size() == std::uint64_t{ 1 } << 32 );
+}
+
+TEST_CASE( "compressed_bitset, set bits across chunks, test and for_each_set see them in order",
+		   "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	bitset.set( 4000000000u ).set( 3 ).set( 70000 ).set( 1 ).set( 3 );
+
+	CHECK( bitset.count() == 4 );
+	CHECK( bitset.num_chunks() == 3 );
+	CHECK( bitset.test( 1 ) );
+	CHECK( bitset.test( 70000 ) );
+	CHECK_FALSE( bitset.test( 2 ) );
+	CHECK_FALSE( bitset.test( 70001 ) );
+	CHECK( bitset.find_first_set() == 1u );
+	CHECK_THAT( to_vector( bitset ), RangeEquals( std::vector<std::uint32_t>{ 1, 3, 70000, 4000000000u } ) );
+}
+
+TEST_CASE( "compressed_bitset, reset last bit in chunk, releases chunk", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	bitset.set( 5 ).set( 70000 );
+
+	bitset.reset( 5 );
+	bitset.reset( 6 );
+
+	CHECK( bitset.count() == 1 );
+	CHECK( bitset.num_chunks() == 1 );
+	CHECK( bitset.find_first_set() == 70000u );
+
+	bitset.set( 70000, false );
+	CHECK( bitset.none() );
+}
+
+TEST_CASE( "compressed_bitset, grow past array limit and shrink back, contents preserved", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	for ( std::uint32_t pos = 0; pos < 10000; pos += 2 )
+	{
+		bitset.set( pos );
+	}
+	CHECK( bitset.count() == 5000 );
+	CHECK( bitset.rank( 9998 ) == 5000 );
+
+	for ( std::uint32_t pos = 0; pos < 4000; pos += 2 )
+	{
+		bitset.reset( pos );
+	}
+	CHECK( bitset.count() == 3000 );
+	CHECK( bitset.find_first_set() == 4000u );
+	CHECK_FALSE( bitset.test( 3998 ) );
+	CHECK( bitset.test( 4000 ) );
+	CHECK( bitset.rank( 4001 ) == 1 );
+}
+
+TEST_CASE( "compressed_bitset, set_range spanning chunks, sets exactly the range", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	bitset.set_range( 65530, 65536 * 3 + 5 );
+
+	CHECK( bitset.count() == 65536 * 3 + 5 - 65530 );
+	CHECK( bitset.num_chunks() == 4 );
+	CHECK_FALSE( bitset.test( 65529 ) );
+	CHECK( bitset.test( 65530 ) );
+	CHECK( bitset.test( 65536 * 2 ) );
+	CHECK( bitset.test( 65536 * 3 + 4 ) );
+	CHECK_FALSE( bitset.test( 65536 * 3 + 5 ) );
+	CHECK( bitset.rank( 65536 * 2 ) == 65536 + 7 );
+}
+
+TEST_CASE( "compressed_bitset, set_range over full space, counts every bit", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	bitset.set_range( 0, mclo::compressed_bitset::size() );
+
+	CHECK( bitset.count() == mclo::compressed_bitset::size() );
+	CHECK( bitset.test( 0xFFFFFFFFu ) );
+	CHECK( bitset.rank( 0xFFFFFFFFu ) == mclo::compressed_bitset::size() );
+}
+
+TEST_CASE( "compressed_bitset, set and reset inside runs, splits and merges runs", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	bitset.set_range( 100, 200 );
+
+	bitset.reset( 150 ).reset( 100 ).reset( 199 );
+	CHECK( bitset.count() == 97 );
+	CHECK_FALSE( bitset.test( 150 ) );
+	CHECK( bitset.test( 149 ) );
+	CHECK( bitset.test( 151 ) );
+
+	bitset.set( 150 ).set( 100 ).set( 200 ).set( 98 );
+	CHECK( bitset.count() == 101 );
+	CHECK( bitset.rank( 200 ) == 101 );
+	CHECK_FALSE( bitset.test( 99 ) );
+
+	mclo::compressed_bitset expected;
+	expected.set( 98 );
+	for ( std::uint32_t pos = 100; pos < 199; ++pos )
+	{
+		expected.set( pos );
+	}
+	expected.set( 200 );
+	CHECK( bitset == expected );
+}
+
+TEST_CASE( "compressed_bitset, run_optimize, keeps contents and shrinks serialization", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	for ( std::uint32_t pos = 1000; pos < 60000; ++pos )
+	{
+		bitset.set( pos );
+	}
+	const mclo::compressed_bitset original = bitset;
+	const std::size_t original_size = bitset.serialized_size();
+
+	bitset.run_optimize();
+
+	CHECK( bitset == original );
+	CHECK( bitset.count() == 59000 );
+	CHECK( bitset.serialized_size() < original_size );
+}
+
+TEST_CASE( "compressed_bitset, union and intersection, match set algebra across densities", "[compressed_bitset]" )
+{
+	const double lhs_density = GENERATE( 0.001, 0.05, 0.5 );
+	const double rhs_density = GENERATE( 0.001, 0.05, 0.5 );
+	const bool optimize = GENERATE( false, true );
+
+	const std::set<std::uint32_t> lhs_positions = make_random_positions( lhs_density, 1 );
+	const std::set<std::uint32_t> rhs_positions = make_random_positions( rhs_density, 2 );
+	mclo::compressed_bitset lhs = make_bitset( lhs_positions );
+	mclo::compressed_bitset rhs = make_bitset( rhs_positions );
+	rhs.set_range( 65536 * 7 + 100, 65536 * 7 + 30000 );
+	if ( optimize )
+	{
+		lhs.run_optimize();
+		rhs.run_optimize();
+	}
+
+	std::set<std::uint32_t> rhs_expected = rhs_positions;
+	for ( std::uint32_t pos = 65536 * 7 + 100; pos < 65536 * 7 + 30000; ++pos )
+	{
+		rhs_expected.insert( pos );
+	}
+	std::vector<std::uint32_t> expected_union;
+	std::ranges::set_union( lhs_positions, rhs_expected, std::back_inserter( expected_union ) );
+	std::vector<std::uint32_t> expected_intersection;
+	std::ranges::set_intersection( lhs_positions, rhs_expected, std::back_inserter( expected_intersection ) );
+
+	const mclo::compressed_bitset union_result = lhs | rhs;
+	const mclo::compressed_bitset intersection_result = lhs & rhs;
+
+	CHECK_THAT( to_vector( union_result ), RangeEquals( expected_union ) );
+	CHECK( union_result.count() == expected_union.size() );
+	CHECK_THAT( to_vector( intersection_result ), RangeEquals( expected_intersection ) );
+	CHECK( intersection_result.count() == expected_intersection.size() );
+
+	lhs |= rhs;
+	CHECK( lhs == union_result );
+	lhs &= rhs;
+	CHECK( lhs == rhs );
+}
+
+TEST_CASE( "compressed_bitset, rank, matches counting set positions", "[compressed_bitset]" )
+{
+	const double density = GENERATE( 0.01, 0.3 );
+	const std::set<std::uint32_t> positions = make_random_positions( density, 3 );
+	mclo::compressed_bitset bitset = make_bitset( positions );
+	bitset.set_range( 65536 * 2 + 5, 65536 * 2 + 500 );
+	bitset.run_optimize();
+
+	std::set<std::uint32_t> expected = positions;
+	for ( std::uint32_t pos = 65536 * 2 + 5; pos < 65536 * 2 + 500; ++pos )
+	{
+		expected.insert( pos );
+	}
+
+	for ( const std::uint32_t pos : { 0u, 1u, 65535u, 65536u, 65536u * 2 + 5, 65536u * 2 + 250, 100000u, 0xFFFFFFFFu } )
+	{
+		const auto expected_rank = static_cast<std::uint64_t>(
+			std::distance( expected.begin(), expected.upper_bound( pos ) ) );
+		CHECK( bitset.rank( pos ) == expected_rank );
+	}
+}
+
+TEST_CASE( "compressed_bitset, serialize and deserialize, round trips", "[compressed_bitset]" )
+{
+	const double density = GENERATE( 0.0, 0.001, 0.05, 0.5 );
+	const bool with_runs = GENERATE( false, true );
+
+	mclo::compressed_bitset bitset = make_bitset( make_random_positions( density, 4 ) );
+	if ( with_runs )
+	{
+		bitset.set_range( 65536 * 3, 65536 * 4 );
+		bitset.set_range( 65536 * 9 + 10, 65536 * 9 + 20 );
+	}
+
+	const std::vector<std::byte> bytes = bitset.serialize();
+	CHECK( bytes.size() == bitset.serialized_size() );
+
+	const std::optional<mclo::compressed_bitset> result = mclo::compressed_bitset::deserialize( bytes );
+	REQUIRE( result );
+	CHECK( *result == bitset );
+	CHECK( result->serialized_size() == bytes.size() );
+}
+
+TEST_CASE( "compressed_bitset, serialize small array, matches portable roaring format", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	bitset.set( 1 ).set( 2 ).set( 3 );
+
+	const std::vector<std::uint8_t> expected{
+		0x3A, 0x30, 0x00, 0x00, // cookie without runs
+		0x01, 0x00, 0x00, 0x00, // one container
+		0x00, 0x00, 0x02, 0x00, // key 0, cardinality - 1
+		0x10, 0x00, 0x00, 0x00, // offset of the container data
+		0x01, 0x00, 0x02, 0x00, 0x03, 0x00,
+	};
+
+	CHECK_THAT( bitset.serialize(), RangeEquals( as_bytes( expected ) ) );
+}
+
+TEST_CASE( "compressed_bitset, deserialize portable roaring run container, reads runs", "[compressed_bitset]" )
+{
+	const std::vector<std::uint8_t> data{
+		0x3B, 0x30, 0x00, 0x00, // cookie with runs, one container
+		0x01,                   // run flags
+		0x01, 0x00, 0x13, 0x00, // key 1, cardinality - 1
+		0x02, 0x00,             // two runs
+		0x05, 0x00, 0x09, 0x00, // [5, 14]
+		0x64, 0x00, 0x09, 0x00, // [100, 109]
+	};
+
+	const std::optional<mclo::compressed_bitset> result = mclo::compressed_bitset::deserialize( as_bytes( data ) );
+	REQUIRE( result );
+	CHECK( result->count() == 20 );
+	CHECK( result->test( 65536 + 5 ) );
+	CHECK( result->test( 65536 + 14 ) );
+	CHECK_FALSE( result->test( 65536 + 15 ) );
+	CHECK( result->test( 65536 + 109 ) );
+	CHECK_THAT( result->serialize(), RangeEquals( as_bytes( data ) ) );
+}
+
+TEST_CASE( "compressed_bitset, deserialize malformed data, returns nullopt", "[compressed_bitset]" )
+{
+	mclo::compressed_bitset bitset;
+	bitset.set( 1 ).set( 2 ).set( 3 ).set( 70000 );
+	const std::vector<std::byte> bytes = bitset.serialize();
+
+	SECTION( "empty" )
+	{
+		CHECK_FALSE( mclo::compressed_bitset::deserialize( {} ) );
+	}
+	SECTION( "truncated" )
+	{
+		CHECK_FALSE( mclo::compressed_bitset::deserialize( std::span( bytes ).first( bytes.size() - 1 ) ) );
+	}
+	SECTION( "bad cookie" )
+	{
+		std::vector<std::byte> corrupt = bytes;
+		corrupt[ 0 ] = std::byte{ 0 };
+		CHECK_FALSE( mclo::compressed_bitset::deserialize( corrupt ) );
+	}
+	SECTION( "unsorted values" )
+	{
+		std::vector<std::byte> corrupt = bytes;
+		corrupt[ corrupt.size() - 6 ] = std::byte{ 9 };
+		CHECK_FALSE( mclo::compressed_bitset::deserialize( corrupt ) );
+	}
+	SECTION( "unsorted keys" )
+	{
+		std::vector<std::byte> corrupt = bytes;
+		corrupt[ 8 ] = std::byte{ 5 };
+		CHECK_FALSE( mclo::compressed_bitset::deserialize( corrupt ) );
+	}
+}
@@ -0,0 +1,284 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/concurrent_slot_map.hpp"
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+	using test_map = mclo::concurrent_slot_map<std::string>;
+
+	constexpr std::size_t num_threads = 4;
+
+	struct throwing_tester
+	{
+		explicit throwing_tester( const int val )
+			: i( val )
+		{
+			if ( i == 5 )
+			{
+				throw std::runtime_error( "Error" );
+			}
+		}
+		int i;
+	};
+
+	template <typename Func>
+	void run_threads( Func func )
+	{
+		std::vector<std::thread> threads;
+		for ( std::size_t index = 0; index < num_threads; ++index )
+		{
+			threads.emplace_back( func, index );
+		}
+		for ( std::thread& thread : threads )
+		{
+			thread.join();
+		}
+	}
+}
+
+TEST_CASE( "concurrent_slot_map default, is empty", "[slot_map]" )
+{
+	const test_map map;
+
+	CHECK( map.empty() );
+	CHECK( map.size() == 0 );
+	CHECK_FALSE( map.is_valid( test_map::handle_type{} ) );
+	CHECK( map.lookup( test_map::handle_type{} ) == nullptr );
+}
+
+TEST_CASE( "concurrent_slot_map insert, value found by handle", "[slot_map]" )
+{
+	test_map map;
+
+	const test_map::handle_type first = map.insert( "first" );
+	const test_map::handle_type second = map.emplace( 3, 'a' );
+
+	CHECK( map.size() == 2 );
+	CHECK( first != second );
+	REQUIRE( map.lookup( first ) );
+	CHECK( *map.lookup( first ) == "first" );
+	REQUIRE( map.lookup( second ) );
+	CHECK( *map.lookup( second ) == "aaa" );
+}
+
+TEST_CASE( "concurrent_slot_map erase, handle invalidated others unaffected", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type first = map.insert( "first" );
+	const test_map::handle_type second = map.insert( "second" );
+
+	CHECK( map.erase( first ) );
+
+	CHECK( map.size() == 1 );
+	CHECK_FALSE( map.is_valid( first ) );
+	CHECK( map.lookup( first ) == nullptr );
+	CHECK( *map.lookup( second ) == "second" );
+	CHECK_FALSE( map.erase( first ) );
+}
+
+TEST_CASE( "concurrent_slot_map insert after erase, reused slot has new generation", "[slot_map]" )
+{
+	mclo::concurrent_slot_map<int, 32, 8, 1> map;
+	const auto old_handle = map.insert( 1 );
+	map.erase( old_handle );
+
+	const auto new_handle = map.insert( 2 );
+
+	CHECK( new_handle.index == old_handle.index );
+	CHECK( new_handle.generation != old_handle.generation );
+	CHECK_FALSE( map.is_valid( old_handle ) );
+	CHECK( *map.lookup( new_handle ) == 2 );
+}
+
+TEST_CASE( "concurrent_slot_map pop, returns value and erases", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type handle = map.insert( "popped" );
+
+	const std::optional<std::string> popped = map.pop( handle );
+
+	CHECK( popped == "popped" );
+	CHECK( map.empty() );
+	CHECK_FALSE( map.pop( handle ) );
+}
+
+TEST_CASE( "concurrent_slot_map lookup, pointer stable across inserts", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type handle = map.insert( "stable" );
+	const std::string* const ptr = map.lookup( handle );
+
+	for ( int index = 0; index < 10000; ++index )
+	{
+		(void)map.insert( std::to_string( index ) );
+	}
+
+	CHECK( map.lookup( handle ) == ptr );
+	CHECK( *ptr == "stable" );
+}
+
+TEST_CASE( "concurrent_slot_map clear, destroys entries and invalidates handles", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type handle = map.insert( "a" );
+
+	map.clear();
+
+	CHECK( map.empty() );
+	CHECK_FALSE( map.is_valid( handle ) );
+	const test_map::handle_type new_handle = map.insert( "b" );
+	CHECK_FALSE( map.is_valid( handle ) );
+	CHECK( *map.lookup( new_handle ) == "b" );
+}
+
+TEST_CASE( "concurrent_slot_map for_each, visits every entry with its handle", "[slot_map]" )
+{
+	test_map map;
+	std::set<test_map::handle_type> expected;
+	for ( int index = 0; index < 200; ++index )
+	{
+		expected.insert( map.insert( std::to_string( index ) ) );
+	}
+
+	std::set<test_map::handle_type> visited;
+	map.for_each( [ & ]( const test_map::handle_type handle, std::string& value ) {
+		CHECK( map.lookup( handle ) == &value );
+		visited.insert( handle );
+	} );
+
+	CHECK( visited == expected );
+}
+
+TEST_CASE( "concurrent_slot_map emplace throwing, no entry added", "[slot_map]" )
+{
+	mclo::concurrent_slot_map<throwing_tester> map;
+	const auto handle = map.emplace( 0 );
+
+	CHECK_THROWS_AS( map.emplace( 5 ), std::runtime_error );
+
+	CHECK( map.size() == 1 );
+	CHECK( map.is_valid( handle ) );
+}
+
+TEST_CASE( "concurrent_slot_map insert more than max size, throws length error", "[slot_map]" )
+{
+	mclo::concurrent_slot_map<int, 8, 4, 2> map;
+	while ( map.size() < map.max_size() )
+	{
+		(void)map.insert( 0 );
+	}
+	CHECK_THROWS_AS( map.insert( 0 ), std::length_error );
+	CHECK_THROWS_AS( map.reserve_slots( map.max_size() + 1 ), std::length_error );
+}
+
+TEST_CASE( "concurrent_slot_map concurrent insert and erase, every handle unique and valid", "[slot_map]" )
+{
+	constexpr std::size_t per_thread = 5000;
+	test_map map;
+	std::vector<std::vector<test_map::handle_type>> kept( num_threads );
+	std::atomic_size_t failed_erases = 0;
+
+	run_threads( [ & ]( const std::size_t thread_index ) {
+		for ( std::size_t index = 0; index < per_thread; ++index )
+		{
+			const test_map::handle_type handle = map.insert( std::to_string( index ) );
+			// Erase every other entry straight away to churn the free lists
+			if ( index % 2 == 0 )
+			{
+				if ( !map.erase( handle ) )
+				{
+					failed_erases.fetch_add( 1, std::memory_order_relaxed );
+				}
+			}
+			else
+			{
+				kept[ thread_index ].push_back( handle );
+			}
+		}
+	} );
+
+	CHECK( failed_erases == 0 );
+	std::set<test_map::handle_type> unique;
+	for ( const std::vector<test_map::handle_type>& handles : kept )
+	{
+		for ( std::size_t index = 0; index < handles.size(); ++index )
+		{
+			REQUIRE( map.lookup( handles[ index ] ) );
+			CHECK( *map.lookup( handles[ index ] ) == std::to_string( index * 2 + 1 ) );
+			unique.insert( handles[ index ] );
+		}
+	}
+	CHECK( unique.size() == num_threads * per_thread / 2 );
+	CHECK( map.size() == unique.size() );
+}
+
+TEST_CASE( "concurrent_slot_map concurrent erase of same handles, exactly one erase wins", "[slot_map]" )
+{
+	constexpr std::size_t num_entries = 2000;
+	mclo::concurrent_slot_map<int> map;
+	std::vector<mclo::concurrent_slot_map<int>::handle_type> handles;
+	for ( std::size_t index = 0; index < num_entries; ++index )
+	{
+		handles.push_back( map.insert( static_cast<int>( index ) ) );
+	}
+
+	std::atomic_size_t num_erased = 0;
+	run_threads( [ & ]( std::size_t ) {
+		for ( const auto handle : handles )
+		{
+			if ( map.erase( handle ) )
+			{
+				num_erased.fetch_add( 1, std::memory_order_relaxed );
+			}
+		}
+	} );
+
+	CHECK( num_erased == num_entries );
+	CHECK( map.empty() );
+}
+
+TEST_CASE( "concurrent_slot_map readers during writes, stable entries always valid", "[slot_map]" )
+{
+	mclo::concurrent_slot_map<int> map;
+	std::vector<mclo::concurrent_slot_map<int>::handle_type> stable;
+	for ( int index = 0; index < 100; ++index )
+	{
+		stable.push_back( map.insert( index ) );
+	}
+
+	std::atomic_bool done = false;
+	std::atomic_size_t failures = 0;
+	std::thread writer( [ & ] {
+		for ( int index = 0; index < 20000; ++index )
+		{
+			map.erase( map.insert( index ) );
+		}
+		done = true;
+	} );
+	run_threads( [ & ]( std::size_t ) {
+		while ( !done )
+		{
+			for ( std::size_t index = 0; index < stable.size(); ++index )
+			{
+				const int* const value = map.lookup( stable[ index ] );
+				if ( !value || *value != static_cast<int>( index ) )
+				{
+					failures.fetch_add( 1, std::memory_order_relaxed );
+				}
+			}
+		}
+	} );
+	writer.join();
+
+	CHECK( failures == 0 );
+	CHECK( map.size() == stable.size() );
+}
@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "mclo/container/span.hpp"
+#include "mclo/hash/murmur_hash_3.hpp"
+#include "mclo/platform/cpu_features.hpp"
+#include "mclo/string/ascii_string_utils.hpp"
+#include "mclo/string/compare_ignore_case.hpp"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Switches the SIMD kernels to a target for the lifetime of the scope
+	class scoped_simd_target
+	{
+	public:
+		explicit scoped_simd_target( const mclo::simd_target target ) noexcept
+			: m_previous( mclo::set_active_simd_target( target ) )
+		{
+		}
+
+		scoped_simd_target( const scoped_simd_target& ) = delete;
+		scoped_simd_target& operator=( const scoped_simd_target& ) = delete;
+
+		~scoped_simd_target()
+		{
+			mclo::set_active_simd_target( m_previous );
+		}
+
+	private:
+		mclo::simd_target m_previous;
+	};
+
+	mclo::simd_target generate_supported_target()
+	{
+		return GENERATE( mclo::simd_target::baseline, mclo::simd_target::avx2, mclo::simd_target::avx512 );
+	}
+
+	// Letters of both cases and the characters either side of them, long enough for several of the widest registers
+	std::string make_mixed_string( const std::size_t size )
+	{
+		static constexpr std::string_view alphabet = "@AZ[`az{09 ~\x7f\x80\xff";
+		std::mt19937 rng( static_cast<unsigned>( size ) );
+		std::uniform_int_distribution<std::size_t> distribution( 0, alphabet.size() - 1 );
+		std::string result( size, ' ' );
+		for ( char& c : result )
+		{
+			c = alphabet[ distribution( rng ) ];
+		}
+		return result;
+	}
+
+	int sign( const int value )
+	{
+		return ( value > 0 ) - ( value < 0 );
+	}
+}
+
+TEST_CASE( "cpu_features", "[cpu_features]" )
+{
+	const mclo::cpu_features& features = mclo::host_cpu_features();
+	CHECK( &features == &mclo::host_cpu_features() );
+	if ( features.avx512bw )
+	{
+		CHECK( features.avx512f );
+	}
+	if ( mclo::is_simd_target_supported( mclo::simd_target::avx512 ) )
+	{
+		CHECK( features.avx512cd );
+		CHECK( features.avx512dq );
+		CHECK( features.avx512bw );
+	}
+	CHECK( mclo::is_simd_target_supported( mclo::simd_target::baseline ) );
+	CHECK( mclo::is_simd_target_supported( mclo::best_simd_target() ) );
+	CHECK( mclo::active_simd_target() == mclo::best_simd_target() );
+	CHECK( mclo::to_string( mclo::simd_target::avx512 ) == "avx512" );
+}
+
+TEST_CASE( "set_active_simd_target", "[cpu_features]" )
+{
+	const mclo::simd_target best = mclo::best_simd_target();
+	{
+		const scoped_simd_target scope( mclo::simd_target::baseline );
+		CHECK( mclo::active_simd_target() == mclo::simd_target::baseline );
+	}
+	CHECK( mclo::active_simd_target() == best );
+}
+
+TEST_CASE( "ASCII string kernels match scalar on every target", "[cpu_features][string]" )
+{
+	const mclo::simd_target target = generate_supported_target();
+	if ( !mclo::is_simd_target_supported( target ) )
+	{
+		return;
+	}
+	const scoped_simd_target scope( target );
+	CAPTURE( mclo::to_string( target ) );
+
+	for ( std::size_t size = 0; size <= 200; ++size )
+	{
+		CAPTURE( size );
+		const std::string original = make_mixed_string( size );
+
+		std::string upper = original;
+		std::string expected_upper = original;
+		mclo::to_upper( upper.data(), upper.data() + upper.size() );
+		mclo::detail::to_upper_scalar( expected_upper.data(), expected_upper.data() + expected_upper.size() );
+		REQUIRE( upper == expected_upper );
+
+		std::string lower = original;
+		std::string expected_lower = original;
+		mclo::to_lower( lower.data(), lower.data() + lower.size() );
+		mclo::detail::to_lower_scalar( expected_lower.data(), expected_lower.data() + expected_lower.size() );
+		REQUIRE( lower == expected_lower );
+
+		REQUIRE( mclo::compare_ignore_case( upper, lower ) == 0 );
+		for ( std::size_t index = 0; index < size; index += 7 )
+		{
+			std::string different = lower;
+			different[ index ] = '#';
+			REQUIRE( sign( mclo::detail::compare_ignore_case_simd( upper.data(), different.data(), size ) ) ==
+					 sign( mclo::detail::compare_ignore_case_scalar( upper.data(), different.data(), size ) ) );
+		}
+	}
+}
+
+TEST_CASE( "murmur_hash_3 hash_many matches on every target", "[cpu_features][hash]" )
+{
+	const mclo::simd_target target = generate_supported_target();
+	if ( !mclo::is_simd_target_supported( target ) )
+	{
+		return;
+	}
+	const scoped_simd_target scope( target );
+	CAPTURE( mclo::to_string( target ) );
+
+	// Every key size with a lane kernel, with keys left over from whole registers of the widest target
+	std::vector<std::byte> data( 37 * 16 );
+	std::mt19937 rng( 1 );
+	for ( std::byte& byte : data )
+	{
+		byte = static_cast<std::byte>( rng() );
+	}
+	const mclo::span<const std::byte> bytes( data );
+	for ( const std::size_t key_size : { 4, 8, 12, 16 } )
+	{
+		CAPTURE( key_size );
+		const std::size_t count = bytes.size() / key_size;
+		std::vector<std::size_t> hashes( count );
+		mclo::murmur_hash_3::hash_many( bytes.first( count * key_size ), key_size, hashes, 42 );
+		for ( std::size_t index = 0; index < count; ++index )
+		{
+			mclo::murmur_hash_3 hasher( 42 );
+			hasher.write( bytes.subspan( index * key_size, key_size ) );
+			REQUIRE( hashes[ index ] == hasher.finish() );
+		}
+	}
+}
@@ -0,0 +1,277 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/dense_soa_slot_map.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+	struct position
+	{
+		float x = 0;
+		float y = 0;
+
+		[[nodiscard]] bool operator==( const position& other ) const noexcept = default;
+	};
+
+	using test_map = mclo::dense_soa_slot_map<std::tuple<position, std::string, int>>;
+
+	struct throwing_tester
+	{
+		explicit throwing_tester( const int val )
+			: i( val )
+		{
+			if ( i == 5 )
+			{
+				throw std::runtime_error( "Error" );
+			}
+		}
+		int i;
+	};
+}
+
+TEST_CASE( "dense_soa_slot_map default, is empty", "[slot_map]" )
+{
+	const test_map map;
+
+	CHECK( map.empty() );
+	CHECK( map.size() == 0 );
+	CHECK( map.slot_count() == 0 );
+	CHECK( map.column<position>().empty() );
+	CHECK( map.column<1>().empty() );
+	CHECK_FALSE( map.is_valid( test_map::handle_type{} ) );
+	CHECK( map.lookup<int>( test_map::handle_type{} ) == nullptr );
+}
+
+TEST_CASE( "dense_soa_slot_map emplace, every component stored and found by handle", "[slot_map]" )
+{
+	test_map map;
+
+	const test_map::handle_type first = map.emplace( position{ 1, 2 }, "first", 10 );
+	const test_map::handle_type second = map.insert( { position{ 3, 4 }, "second", 20 } );
+
+	CHECK( map.size() == 2 );
+	CHECK( map.is_valid( first ) );
+	CHECK( map.is_valid( second ) );
+	CHECK( first != second );
+
+	REQUIRE( map.lookup<std::string>( first ) );
+	CHECK( *map.lookup<std::string>( first ) == "first" );
+	REQUIRE( map.lookup<0>( second ) );
+	CHECK( *map.lookup<0>( second ) == position{ 3, 4 } );
+
+	const auto components = map.lookup_all( second );
+	REQUIRE( components );
+	CHECK( std::get<1>( *components ) == "second" );
+	CHECK( std::get<2>( *components ) == 20 );
+
+	CHECK_THAT( map.column<int>(), RangeEquals( std::vector{ 10, 20 } ) );
+	CHECK_THAT( map.column<std::string>(), RangeEquals( std::vector<std::string>{ "first", "second" } ) );
+	CHECK( map.get_handle( 1 ) == second );
+}
+
+TEST_CASE( "dense_soa_slot_map modify through column, visible through lookup", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type handle = map.emplace( position{}, "a", 1 );
+	(void)map.emplace( position{}, "b", 2 );
+
+	for ( int& value : map.column<int>() )
+	{
+		value *= 3;
+	}
+	map.for_each( []( position& pos, const std::string&, const int value ) { pos.x = static_cast<float>( value ); } );
+
+	CHECK( *map.lookup<int>( handle ) == 3 );
+	CHECK( map.lookup<position>( handle )->x == 3.0f );
+}
+
+TEST_CASE( "dense_soa_slot_map erase, swaps last entry into place in every column", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type a = map.emplace( position{ 1, 1 }, "a", 1 );
+	const test_map::handle_type b = map.emplace( position{ 2, 2 }, "b", 2 );
+	const test_map::handle_type c = map.emplace( position{ 3, 3 }, "c", 3 );
+
+	map.erase( a );
+
+	CHECK( map.size() == 2 );
+	CHECK_FALSE( map.is_valid( a ) );
+	CHECK( map.lookup<int>( a ) == nullptr );
+	CHECK_FALSE( map.lookup_all( a ) );
+	CHECK_THAT( map.column<int>(), RangeEquals( std::vector{ 3, 2 } ) );
+	CHECK_THAT( map.column<std::string>(), RangeEquals( std::vector<std::string>{ "c", "b" } ) );
+	CHECK( *map.lookup<position>( c ) == position{ 3, 3 } );
+	CHECK( *map.lookup<std::string>( b ) == "b" );
+	CHECK( map.get_handle( 0 ) == c );
+
+	map.erase( a );
+	CHECK( map.size() == 2 );
+}
+
+TEST_CASE( "dense_soa_slot_map insert after erase, same index higher generation", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type old_handle = map.emplace( position{}, "old", 1 );
+	map.erase( old_handle );
+
+	const test_map::handle_type new_handle = map.emplace( position{}, "new", 2 );
+
+	CHECK( new_handle.index == old_handle.index );
+	CHECK( new_handle.generation != old_handle.generation );
+	CHECK_FALSE( map.is_valid( old_handle ) );
+	CHECK( *map.lookup<std::string>( new_handle ) == "new" );
+}
+
+TEST_CASE( "dense_soa_slot_map pop, returns components and erases", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type handle = map.emplace( position{ 5, 6 }, "popped", 7 );
+
+	const std::optional<test_map::value_type> popped = map.pop( handle );
+
+	REQUIRE( popped );
+	CHECK( *popped == test_map::value_type{ position{ 5, 6 }, "popped", 7 } );
+	CHECK( map.empty() );
+	CHECK_FALSE( map.pop( handle ) );
+}
+
+TEST_CASE( "dense_soa_slot_map duplicate component types, accessed by index", "[slot_map]" )
+{
+	using int_pair_map = mclo::dense_soa_slot_map<std::tuple<int, int>>;
+	int_pair_map map;
+	const int_pair_map::handle_type first = map.emplace( 1, 2 );
+	const int_pair_map::handle_type second = map.insert( int_pair_map::value_type{ 3, 4 } );
+
+	const auto entry = map.lookup_all( second );
+	REQUIRE( entry );
+	CHECK( *entry == std::tuple{ 3, 4 } );
+	CHECK( *map.lookup<1>( first ) == 2 );
+	CHECK_THAT( map.column<0>(), RangeEquals( { 1, 3 } ) );
+	CHECK_THAT( map.column<1>(), RangeEquals( { 2, 4 } ) );
+
+	int sum = 0;
+	std::as_const( map ).for_each( [ &sum ]( const int a, const int b ) { sum += a * b; } );
+	CHECK( sum == 14 );
+
+	const std::optional<int_pair_map::value_type> popped = map.pop( first );
+	REQUIRE( popped );
+	CHECK( *popped == int_pair_map::value_type{ 1, 2 } );
+	CHECK( map.size() == 1 );
+}
+
+TEST_CASE( "dense_soa_slot_map clear and reset, destroy entries and invalidate handles", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type handle = map.emplace( position{}, "a", 1 );
+
+	SECTION( "clear" )
+	{
+		map.clear();
+		CHECK( map.empty() );
+		CHECK( map.slot_count() == 1 );
+		CHECK_FALSE( map.is_valid( handle ) );
+		const test_map::handle_type new_handle = map.emplace( position{}, "b", 2 );
+		CHECK_FALSE( map.is_valid( handle ) );
+		CHECK( map.is_valid( new_handle ) );
+	}
+	SECTION( "reset" )
+	{
+		map.reset();
+		CHECK( map.empty() );
+		CHECK( map.slot_count() == 0 );
+	}
+}
+
+TEST_CASE( "dense_soa_slot_map emplace throwing component, strong exception guarantee held", "[slot_map]" )
+{
+	mclo::dense_soa_slot_map<std::tuple<std::string, throwing_tester>> map;
+	const auto handle = map.emplace( "ok", 0 );
+
+	CHECK_THROWS_AS( map.emplace( "bad", 5 ), std::runtime_error );
+
+	CHECK( map.size() == 1 );
+	CHECK( map.column<std::string>().size() == 1 );
+	CHECK( map.is_valid( handle ) );
+	CHECK( *map.lookup<std::string>( handle ) == "ok" );
+}
+
+TEST_CASE( "dense_soa_slot_map insert more than max size, throws length error", "[slot_map]" )
+{
+	using map_type = mclo::dense_soa_slot_map<std::tuple<int>, 8, 4>;
+	map_type map;
+	for ( map_type::size_type index = 0; index < map.max_size(); ++index )
+	{
+		(void)map.emplace( 0 );
+	}
+	CHECK_THROWS_AS( map.emplace( 0 ), std::length_error );
+	CHECK_THROWS_AS( map.reserve_slots( map.max_size() + 1 ), std::length_error );
+}
+
+TEST_CASE( "dense_soa_slot_map copy and swap, independent copies", "[slot_map]" )
+{
+	test_map map;
+	const test_map::handle_type handle = map.emplace( position{}, "a", 1 );
+
+	test_map copy = map;
+	*copy.lookup<int>( handle ) = 2;
+	CHECK( *map.lookup<int>( handle ) == 1 );
+
+	test_map other;
+	swap( map, other );
+	CHECK( map.empty() );
+	CHECK( *other.lookup<int>( handle ) == 1 );
+}
+
+TEST_CASE( "dense_soa_slot_map pmr allocator, columns use resource", "[slot_map]" )
+{
+	std::pmr::monotonic_buffer_resource resource;
+	mclo::pmr::dense_soa_slot_map<std::tuple<int, double>> map( &resource );
+	const auto handle = map.emplace( 1, 2.0 );
+
+	CHECK( map.get_allocator().resource() == &resource );
+	CHECK( *map.lookup<double>( handle ) == 2.0 );
+}
+
+TEST_CASE( "dense_soa_slot_map fuzz testing, columns stay in lockstep with handles", "[slot_map]" )
+{
+	test_map map;
+	std::map<test_map::handle_type, int> expected;
+	std::mt19937_64 rng{ 0 };
+	std::uniform_int_distribution<int> dist{ 0, 99 };
+	for ( int index = 0; index < 5000; ++index )
+	{
+		const int random = dist( rng );
+		if ( random < 40 && !expected.empty() )
+		{
+			const auto it = std::next( expected.begin(), random % expected.size() );
+			map.erase( it->first );
+			expected.erase( it );
+		}
+		else
+		{
+			expected.emplace( map.emplace( position{ static_cast<float>( index ), 0 }, std::to_string( index ), index ),
+							  index );
+		}
+	}
+
+	REQUIRE( map.size() == expected.size() );
+	for ( const auto& [ handle, value ] : expected )
+	{
+		const auto components = map.lookup_all( handle );
+		REQUIRE( components );
+		CHECK( std::get<0>( *components ).x == static_cast<float>( value ) );
+		CHECK( std::get<1>( *components ) == std::to_string( value ) );
+		CHECK( std::get<2>( *components ) == value );
+	}
+	for ( std::size_t index = 0; index < map.size(); ++index )
+	{
+		CHECK( expected.at( map.get_handle( static_cast<test_map::size_type>( index ) ) ) ==
+			   map.column<int>()[ index ] );
+	}
+}
@@ -0,0 +1,408 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "unique_values.hpp"
+
+#include "mclo/container/dynamic_mph_map.hpp"
+#include "mclo/container/dynamic_mph_set.hpp"
+#include "mclo/container/minimal_perfect_hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	void check_bijection( const mclo::minimal_perfect_hash& function, const std::vector<std::uint64_t>& hashes )
+	{
+		REQUIRE( function.size() == hashes.size() );
+		std::vector<bool> seen( hashes.size() );
+		for ( const std::uint64_t hash : hashes )
+		{
+			const std::size_t index = function( hash );
+			REQUIRE( index < hashes.size() );
+			REQUIRE_FALSE( seen[ index ] );
+			seen[ index ] = true;
+		}
+	}
+
+	// Copies into 8 byte aligned storage as view requires
+	std::vector<std::uint64_t> aligned_copy( const std::vector<std::byte>& bytes )
+	{
+		std::vector<std::uint64_t> result( ( bytes.size() + 7 ) / 8 );
+		std::memcpy( result.data(), bytes.data(), bytes.size() );
+		return result;
+	}
+
+	mclo::span<const std::byte> as_bytes( const std::vector<std::uint64_t>& words, const std::size_t size )
+	{
+		return { reinterpret_cast<const std::byte*>( words.data() ), size };
+	}
+}
+
+TEST_CASE( "minimal_perfect_hash default, is empty", "[mph]" )
+{
+	const mclo::minimal_perfect_hash function;
+
+	CHECK( function.empty() );
+	CHECK( function.size() == 0 );
+	CHECK( function.bits_per_key() == 0 );
+}
+
+TEST_CASE( "minimal_perfect_hash build with no hashes, is empty", "[mph]" )
+{
+	const auto function = mclo::minimal_perfect_hash::build( {}, 42 );
+
+	REQUIRE( function );
+	CHECK( function->empty() );
+	CHECK( function->seed() == 42 );
+}
+
+TEST_CASE( "minimal_perfect_hash build single partition, is bijection", "[mph]" )
+{
+	const std::vector<std::uint64_t> hashes = make_unique_values( 1000, 1 );
+
+	const auto function = mclo::minimal_perfect_hash::build( hashes, 7 );
+
+	REQUIRE( function );
+	CHECK( function->seed() == 7 );
+	check_bijection( *function, hashes );
+}
+
+TEST_CASE( "minimal_perfect_hash build many partitions in parallel, is bijection", "[mph]" )
+{
+	const std::vector<std::uint64_t> hashes = make_unique_values( 200'000, 2 );
+	mclo::mph_build_options options;
+	options.num_threads = 4;
+	options.partition_size = 10'000;
+
+	const auto function = mclo::minimal_perfect_hash::build( hashes, 0, options );
+
+	REQUIRE( function );
+	check_bijection( *function, hashes );
+	CHECK( function->bits_per_key() < 8 );
+}
+
+TEST_CASE( "minimal_perfect_hash build, same result for any thread count", "[mph]" )
+{
+	const std::vector<std::uint64_t> hashes = make_unique_values( 50'000, 3 );
+	mclo::mph_build_options options;
+	options.partition_size = 5'000;
+
+	const auto single = mclo::minimal_perfect_hash::build( hashes, 0, options );
+	options.num_threads = 3;
+	const auto multi = mclo::minimal_perfect_hash::build( hashes, 0, options );
+
+	REQUIRE( single );
+	REQUIRE( multi );
+	CHECK( single->serialize() == multi->serialize() );
+}
+
+TEST_CASE( "minimal_perfect_hash build duplicate hashes, fails", "[mph]" )
+{
+	std::vector<std::uint64_t> hashes = make_unique_values( 100, 4 );
+	hashes.push_back( hashes.front() );
+
+	CHECK_FALSE( mclo::minimal_perfect_hash::build( hashes, 0 ) );
+}
+
+TEST_CASE( "minimal_perfect_hash deserialize, round trips", "[mph]" )
+{
+	const std::vector<std::uint64_t> hashes = make_unique_values( 20'000, 5 );
+	mclo::mph_build_options options;
+	options.partition_size = 3'000;
+	const auto function = mclo::minimal_perfect_hash::build( hashes, 99, options );
+	REQUIRE( function );
+
+	std::vector<std::byte> bytes = function->serialize();
+	REQUIRE( bytes.size() == function->serialized_size() );
+	bytes.resize( bytes.size() + 5 );
+
+	const auto loaded = mclo::minimal_perfect_hash::deserialize( bytes );
+
+	REQUIRE( loaded );
+	CHECK( loaded->seed() == 99 );
+	CHECK( loaded->serialized_size() == function->serialized_size() );
+	for ( const std::uint64_t hash : hashes )
+	{
+		REQUIRE( ( *loaded )( hash ) == ( *function )( hash ) );
+	}
+}
+
+TEST_CASE( "minimal_perfect_hash view, uses data in place", "[mph]" )
+{
+	const std::vector<std::uint64_t> hashes = make_unique_values( 5'000, 6 );
+	const auto function = mclo::minimal_perfect_hash::build( hashes, 0 );
+	REQUIRE( function );
+	const std::vector<std::byte> bytes = function->serialize();
+	const std::vector<std::uint64_t> words = aligned_copy( bytes );
+
+	const auto viewed = mclo::minimal_perfect_hash::view( as_bytes( words, bytes.size() ) );
+
+	REQUIRE( viewed );
+	CHECK( viewed->serialized_size() == bytes.size() );
+	for ( const std::uint64_t hash : hashes )
+	{
+		REQUIRE( ( *viewed )( hash ) == ( *function )( hash ) );
+	}
+
+	const mclo::minimal_perfect_hash copy = *viewed;
+	CHECK( copy( hashes.front() ) == ( *function )( hashes.front() ) );
+}
+
+TEST_CASE( "minimal_perfect_hash view misaligned, fails", "[mph]" )
+{
+	const auto function = mclo::minimal_perfect_hash::build( make_unique_values( 100, 7 ), 0 );
+	REQUIRE( function );
+	const std::vector<std::byte> bytes = function->serialize();
+	std::vector<std::uint64_t> words( bytes.size() / 8 + 1 );
+	std::byte* const misaligned = reinterpret_cast<std::byte*>( words.data() ) + 1;
+	std::memcpy( misaligned, bytes.data(), bytes.size() );
+
+	CHECK_FALSE( mclo::minimal_perfect_hash::view( { misaligned, bytes.size() } ) );
+	CHECK( mclo::minimal_perfect_hash::deserialize( { misaligned, bytes.size() } ) );
+}
+
+TEST_CASE( "minimal_perfect_hash deserialize invalid data, fails", "[mph]" )
+{
+	const auto function = mclo::minimal_perfect_hash::build( make_unique_values( 1'000, 8 ), 0 );
+	REQUIRE( function );
+	const std::vector<std::byte> bytes = function->serialize();
+
+	SECTION( "empty" )
+	{
+		CHECK_FALSE( mclo::minimal_perfect_hash::deserialize( {} ) );
+	}
+	SECTION( "truncated" )
+	{
+		CHECK_FALSE( mclo::minimal_perfect_hash::deserialize( { bytes.data(), bytes.size() - 8 } ) );
+	}
+	SECTION( "bad magic" )
+	{
+		std::vector<std::byte> corrupt = bytes;
+		corrupt[ 0 ] ^= std::byte{ 1 };
+		CHECK_FALSE( mclo::minimal_perfect_hash::deserialize( corrupt ) );
+	}
+	SECTION( "bad header" )
+	{
+		// Every header word past the magic corrupted to an oversized count
+		for ( std::size_t word = 1; word < 11; ++word )
+		{
+			std::vector<std::byte> corrupt = bytes;
+			std::memset( corrupt.data() + word * 8 + 4, 0xff, 4 );
+			if ( word == 2 )
+			{
+				// The seed can be any value
+				continue;
+			}
+			CHECK_FALSE( mclo::minimal_perfect_hash::deserialize( corrupt ) );
+		}
+	}
+}
+
+TEST_CASE( "minimal_perfect_hash default serialize, deserializes as empty", "[mph]" )
+{
+	const mclo::minimal_perfect_hash function;
+
+	const std::vector<std::byte> bytes = function.serialize();
+	const auto loaded = mclo::minimal_perfect_hash::deserialize( bytes );
+
+	REQUIRE( loaded );
+	CHECK( loaded->empty() );
+}
+
+TEST_CASE( "dynamic_mph_map default, is empty", "[mph]" )
+{
+	const mclo::dynamic_mph_map<int, int> map;
+
+	CHECK( map.empty() );
+	CHECK( map.size() == 0 );
+	CHECK_FALSE( map.contains( 0 ) );
+	CHECK( map.lookup( 0 ) == nullptr );
+	CHECK( map.index_of( 0 ) == map.npos );
+}
+
+TEST_CASE( "dynamic_mph_map string keys, finds every key", "[mph]" )
+{
+	const mclo::dynamic_mph_map<std::string, int> map{ { "one", 1 }, { "two", 2 }, { "three", 3 } };
+
+	REQUIRE( map.size() == 3 );
+	REQUIRE( map.lookup( "one" ) );
+	CHECK( *map.lookup( "one" ) == 1 );
+	REQUIRE( map.lookup( "two" ) );
+	CHECK( *map.lookup( "two" ) == 2 );
+	REQUIRE( map.lookup( "three" ) );
+	CHECK( *map.lookup( "three" ) == 3 );
+	CHECK( map.lookup( "four" ) == nullptr );
+	CHECK_FALSE( map.contains( "" ) );
+}
+
+TEST_CASE( "dynamic_mph_map many keys in parallel, finds every key", "[mph]" )
+{
+	const std::vector<std::uint64_t> keys = make_unique_values( 100'000, 9 );
+	std::vector<std::pair<std::uint64_t, std::size_t>> pairs;
+	for ( std::size_t index = 0; index < keys.size(); ++index )
+	{
+		pairs.emplace_back( keys[ index ], index );
+	}
+	mclo::mph_build_options options;
+	options.num_threads = 4;
+	options.partition_size = 8'000;
+
+	const mclo::dynamic_mph_map<std::uint64_t, std::size_t> map( pairs, options );
+
+	REQUIRE( map.size() == keys.size() );
+	for ( std::size_t index = 0; index < keys.size(); ++index )
+	{
+		const std::size_t* const value = map.lookup( keys[ index ] );
+		REQUIRE( value );
+		REQUIRE( *value == index );
+		REQUIRE( map.keys()[ map.index_of( keys[ index ] ) ] == keys[ index ] );
+	}
+	for ( const std::uint64_t absent : make_unique_values( 1'000, 10 ) )
+	{
+		CHECK( map.contains( absent ) == ( std::ranges::find( keys, absent ) != keys.end() ) );
+	}
+}
+
+TEST_CASE( "dynamic_mph_map lookup_many, same results as lookup", "[mph]" )
+{
+	const std::vector<std::uint64_t> keys = make_unique_values( 1'000, 11 );
+	std::vector<std::pair<std::uint64_t, std::size_t>> pairs;
+	for ( std::size_t index = 0; index < keys.size(); ++index )
+	{
+		pairs.emplace_back( keys[ index ], index );
+	}
+	const mclo::dynamic_mph_map<std::uint64_t, std::size_t> map( pairs );
+
+	// Every other lookup is almost certainly absent and the batch is not a multiple of the group size
+	std::vector<std::uint64_t> lookups;
+	for ( std::size_t index = 0; index < 333; ++index )
+	{
+		lookups.push_back( index % 2 ? keys[ index ] : ~keys[ index ] );
+	}
+	std::vector<const std::size_t*> values( lookups.size() );
+	std::vector<std::size_t> indices( lookups.size() );
+
+	CHECK( map.lookup_many( lookups, values ) == 166 );
+	CHECK( map.index_of_many( lookups, indices ) == 166 );
+	for ( std::size_t index = 0; index < lookups.size(); ++index )
+	{
+		CHECK( values[ index ] == map.lookup( lookups[ index ] ) );
+		CHECK( indices[ index ] == map.index_of( lookups[ index ] ) );
+	}
+}
+
+TEST_CASE( "dynamic_mph_map lookup_many when empty, finds nothing", "[mph]" )
+{
+	const mclo::dynamic_mph_map<int, int> map;
+	const std::array<int, 2> keys{ 1, 2 };
+	std::array<const int*, 2> values{ &keys[ 0 ], &keys[ 1 ] };
+
+	CHECK( map.lookup_many( keys, values ) == 0 );
+	CHECK( values[ 0 ] == nullptr );
+	CHECK( values[ 1 ] == nullptr );
+}
+
+TEST_CASE( "dynamic_mph_map duplicate keys, throws", "[mph]" )
+{
+	using map_type = mclo::dynamic_mph_map<int, int>;
+	CHECK_THROWS_AS( ( map_type{ { 1, 1 }, { 2, 2 }, { 1, 3 } } ), std::invalid_argument );
+}
+
+TEST_CASE( "dynamic_mph_map copy and move, finds every key", "[mph]" )
+{
+	mclo::dynamic_mph_map<int, std::string> map{ { 1, "a" }, { 2, "b" } };
+
+	const mclo::dynamic_mph_map<int, std::string> copy = map;
+	const mclo::dynamic_mph_map<int, std::string> moved = std::move( map );
+
+	REQUIRE( copy.lookup( 1 ) );
+	CHECK( *copy.lookup( 1 ) == "a" );
+	REQUIRE( moved.lookup( 2 ) );
+	CHECK( *moved.lookup( 2 ) == "b" );
+	CHECK( map.empty() );
+	CHECK( map.lookup( 1 ) == nullptr );
+}
+
+TEST_CASE( "dynamic_mph_map deserialize and view, finds every key", "[mph]" )
+{
+	std::vector<std::pair<std::uint32_t, std::uint16_t>> pairs;
+	for ( std::uint16_t index = 0; index < 1'001; ++index )
+	{
+		pairs.emplace_back( index * 7919u, index );
+	}
+	const mclo::dynamic_mph_map<std::uint32_t, std::uint16_t> map( pairs );
+	const std::vector<std::byte> bytes = map.serialize();
+	REQUIRE( bytes.size() == map.serialized_size() );
+	const std::vector<std::uint64_t> words = aligned_copy( bytes );
+
+	const auto loaded = mclo::dynamic_mph_map<std::uint32_t, std::uint16_t>::deserialize( bytes );
+	const auto viewed = mclo::dynamic_mph_map<std::uint32_t, std::uint16_t>::view( as_bytes( words, bytes.size() ) );
+
+	REQUIRE( loaded );
+	REQUIRE( viewed );
+	CHECK_FALSE( loaded->is_view() );
+	CHECK( viewed->is_view() );
+	CHECK( reinterpret_cast<const std::byte*>( viewed->values().data() ) >=
+		   reinterpret_cast<const std::byte*>( words.data() ) );
+	for ( const auto& [ key, value ] : pairs )
+	{
+		REQUIRE( loaded->lookup( key ) );
+		REQUIRE( *loaded->lookup( key ) == value );
+		REQUIRE( viewed->lookup( key ) );
+		REQUIRE( *viewed->lookup( key ) == value );
+	}
+	CHECK_FALSE( viewed->contains( 1 ) );
+
+	const auto copy = *viewed;
+	CHECK( copy.is_view() );
+	CHECK( copy.lookup( pairs.back().first ) );
+
+	CHECK_FALSE( mclo::dynamic_mph_map<std::uint32_t, std::uint16_t>::deserialize(
+		{ bytes.data(), bytes.size() - 8 } ) );
+}
+
+TEST_CASE( "dynamic_mph_map default serialize, deserializes as empty", "[mph]" )
+{
+	const mclo::dynamic_mph_map<int, int> map;
+
+	const auto loaded = mclo::dynamic_mph_map<int, int>::deserialize( map.serialize() );
+
+	REQUIRE( loaded );
+	CHECK( loaded->empty() );
+}
+
+TEST_CASE( "dynamic_mph_set, contains every key", "[mph]" )
+{
+	const std::vector<std::string> keys{ "alpha", "beta", "gamma", "delta", "epsilon" };
+
+	const mclo::dynamic_mph_set<std::string> set( keys );
+
+	CHECK( set.size() == keys.size() );
+	for ( const std::string& key : keys )
+	{
+		CHECK( set.contains( key ) );
+	}
+	CHECK_FALSE( set.contains( "zeta" ) );
+	CHECK( std::ranges::is_permutation( set, keys ) );
+}
+
+TEST_CASE( "dynamic_mph_set view, contains every key", "[mph]" )
+{
+	const mclo::dynamic_mph_set<int> set{ 3, 1, 4, 15, 9, 2, 6 };
+	const std::vector<std::byte> bytes = set.serialize();
+	const std::vector<std::uint64_t> words = aligned_copy( bytes );
+
+	const auto viewed = mclo::dynamic_mph_set<int>::view( as_bytes( words, bytes.size() ) );
+
+	REQUIRE( viewed );
+	for ( const int key : set )
+	{
+		CHECK( viewed->contains( key ) );
+		CHECK( viewed->index_of( key ) == set.index_of( key ) );
+	}
+	CHECK_FALSE( viewed->contains( 5 ) );
+}
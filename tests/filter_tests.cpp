@@ -0,0 +1,370 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "unique_values.hpp"
+
+#include "mclo/container/blocked_bloom_filter.hpp"
+#include "mclo/container/bloom_filter.hpp"
+#include "mclo/container/cuckoo_filter.hpp"
+#include "mclo/hash/murmur_hash_3.hpp"
+#include "mclo/hash/rapidhash.hpp"
+#include "mclo/hash/xxhash.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	using hasher_types = std::tuple<mclo::rapidhash, mclo::murmur_hash_3, mclo::xxhash_64>;
+
+	template <typename Filter>
+	double measure_false_positive_rate( const Filter& filter, const std::vector<std::uint64_t>& absent )
+	{
+		const auto false_positives = std::count_if(
+			absent.begin(), absent.end(), [ &filter ]( const std::uint64_t key ) { return filter.contains( key ); } );
+		return static_cast<double>( false_positives ) / static_cast<double>( absent.size() );
+	}
+
+	// Serialized bytes are read from an 8 byte aligned copy as the filters copy out of them
+	std::vector<std::uint64_t> aligned_copy( const std::vector<std::byte>& bytes )
+	{
+		std::vector<std::uint64_t> result( ( bytes.size() + 7 ) / 8 );
+		std::memcpy( result.data(), bytes.data(), bytes.size() );
+		return result;
+	}
+
+	mclo::span<const std::byte> as_bytes( const std::vector<std::uint64_t>& words, const std::size_t size )
+	{
+		return { reinterpret_cast<const std::byte*>( words.data() ), size };
+	}
+
+	template <typename Filter>
+	void check_rejects_bad_data( const Filter& filter )
+	{
+		const std::vector<std::byte> bytes = filter.serialize();
+		const auto words = aligned_copy( bytes );
+
+		CHECK_FALSE( Filter::deserialize( {} ) );
+		CHECK_FALSE( Filter::deserialize( as_bytes( words, 8 ) ) );
+		CHECK_FALSE( Filter::deserialize( as_bytes( words, bytes.size() - 8 ) ) );
+
+		auto bad_magic = words;
+		bad_magic[ 0 ] ^= 1;
+		CHECK_FALSE( Filter::deserialize( as_bytes( bad_magic, bytes.size() ) ) );
+
+		auto bad_size = words;
+		bad_size[ 1 ] = 0;
+		CHECK_FALSE( Filter::deserialize( as_bytes( bad_size, bytes.size() ) ) );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "bloom_filter has no false negatives", "[bloom_filter]", hasher_types )
+{
+	const auto keys = make_unique_values( 10000, 1 );
+	auto filter = mclo::bloom_filter<std::uint64_t, TestType>::with_false_positive_rate( keys.size(), 0.01 );
+	for ( const std::uint64_t key : keys )
+	{
+		filter.insert( key );
+	}
+	CHECK( std::all_of( keys.begin(), keys.end(), [ &filter ]( const std::uint64_t key ) {
+		return filter.contains( key );
+	} ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "bloom_filter false positive rate is near the target", "[bloom_filter]", hasher_types )
+{
+	const auto keys = make_unique_values( 40000, 2 );
+	const std::vector<std::uint64_t> present( keys.begin(), keys.begin() + 10000 );
+	const std::vector<std::uint64_t> absent( keys.begin() + 10000, keys.end() );
+	auto filter = mclo::bloom_filter<std::uint64_t, TestType>::with_false_positive_rate( present.size(), 0.01 );
+	for ( const std::uint64_t key : present )
+	{
+		filter.insert( key );
+	}
+	CHECK( measure_false_positive_rate( filter, absent ) < 0.015 );
+}
+
+TEST_CASE( "bloom_filter with_false_positive_rate sizes optimally", "[bloom_filter]" )
+{
+	const auto filter = mclo::bloom_filter<int>::with_false_positive_rate( 1000, 0.01 );
+	CHECK( filter.num_hashes() == 7 );
+	CHECK( filter.num_bits() >= 9585 );
+	CHECK( filter.num_bits() % 64 == 0 );
+}
+
+TEST_CASE( "bloom_filter clear", "[bloom_filter]" )
+{
+	mclo::bloom_filter<int> filter( 1024, 4 );
+	filter.insert( 42 );
+	CHECK( filter.contains( 42 ) );
+	filter.clear();
+	CHECK_FALSE( filter.contains( 42 ) );
+}
+
+TEST_CASE( "bloom_filter serialize round trip", "[bloom_filter]" )
+{
+	const auto keys = make_unique_values( 1000, 3 );
+	auto filter = mclo::bloom_filter<std::uint64_t>::with_false_positive_rate( keys.size(), 0.01 );
+	for ( const std::uint64_t key : keys )
+	{
+		filter.insert( key );
+	}
+	const std::vector<std::byte> bytes = filter.serialize();
+	REQUIRE( bytes.size() == filter.serialized_size() );
+
+	const auto copy = mclo::bloom_filter<std::uint64_t>::deserialize( bytes );
+	REQUIRE( copy );
+	CHECK( copy->num_bits() == filter.num_bits() );
+	CHECK( copy->num_hashes() == filter.num_hashes() );
+	CHECK( copy->serialize() == bytes );
+	check_rejects_bad_data( filter );
+
+	auto bad_hashes = aligned_copy( bytes );
+	bad_hashes[ 2 ] = std::uint64_t{ 1 } << 62;
+	CHECK_FALSE( mclo::bloom_filter<std::uint64_t>::deserialize( as_bytes( bad_hashes, bytes.size() ) ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "blocked_bloom_filter has no false negatives", "[blocked_bloom_filter]", hasher_types )
+{
+	const auto keys = make_unique_values( 10000, 4 );
+	auto filter = mclo::blocked_bloom_filter<std::uint64_t, TestType>::with_false_positive_rate( keys.size(), 0.01 );
+	for ( const std::uint64_t key : keys )
+	{
+		filter.insert( key );
+	}
+	CHECK( std::all_of( keys.begin(), keys.end(), [ &filter ]( const std::uint64_t key ) {
+		return filter.contains( key );
+	} ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "blocked_bloom_filter false positive rate matches the estimate",
+						 "[blocked_bloom_filter]",
+						 hasher_types )
+{
+	const auto keys = make_unique_values( 110000, 5 );
+	const std::vector<std::uint64_t> present( keys.begin(), keys.begin() + 10000 );
+	const std::vector<std::uint64_t> absent( keys.begin() + 10000, keys.end() );
+	auto filter = mclo::blocked_bloom_filter<std::uint64_t, TestType>::with_false_positive_rate( present.size(), 0.01 );
+	const double estimate = decltype( filter )::estimated_false_positive_rate( present.size(), filter.num_bits() );
+	CHECK( estimate <= 0.01 );
+	filter.insert_many( present );
+
+	const double rate = measure_false_positive_rate( filter, absent );
+	CHECK( rate < estimate * 1.25 );
+	CHECK( rate > estimate * 0.75 );
+}
+
+TEST_CASE( "blocked_bloom_filter estimated_false_positive_rate", "[blocked_bloom_filter]" )
+{
+	using filter_type = mclo::blocked_bloom_filter<int>;
+	CHECK( filter_type::estimated_false_positive_rate( 0, 256 ) == 0 );
+
+	// Fewer keys or more bits only lowers the rate
+	const double rate = filter_type::estimated_false_positive_rate( 1000, 10000 );
+	CHECK( filter_type::estimated_false_positive_rate( 500, 10000 ) < rate );
+	CHECK( filter_type::estimated_false_positive_rate( 1000, 20000 ) < rate );
+
+	// Uneven blocks cost more than a standard Bloom filter with the optimal number of hashes at the same size
+	CHECK( filter_type::estimated_false_positive_rate( 1000, 10000 ) > 0.0082 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "blocked_bloom_filter bulk functions match single keys",
+						 "[blocked_bloom_filter]",
+						 hasher_types )
+{
+	const auto keys = make_unique_values( 3000, 6 );
+	const std::vector<std::uint64_t> present( keys.begin(), keys.begin() + 1000 );
+
+	auto single = mclo::blocked_bloom_filter<std::uint64_t, TestType>( 4096 );
+	auto bulk = single;
+	for ( const std::uint64_t key : present )
+	{
+		single.insert( key );
+	}
+	bulk.insert_many( present );
+	CHECK( bulk.serialize() == single.serialize() );
+
+	// Both contiguous and non contiguous ranges, across partial batches
+	const std::list<std::uint64_t> keys_list( keys.begin(), keys.end() );
+	const auto results = std::make_unique<bool[]>( keys.size() );
+	const auto list_results = std::make_unique<bool[]>( keys.size() );
+	single.contains_many( keys, { results.get(), keys.size() } );
+	single.contains_many( keys_list, { list_results.get(), keys.size() } );
+	for ( std::size_t index = 0; index < keys.size(); ++index )
+	{
+		CHECK( results[ index ] == single.contains( keys[ index ] ) );
+		CHECK( list_results[ index ] == results[ index ] );
+	}
+}
+
+TEST_CASE( "blocked_bloom_filter rounds up to whole blocks", "[blocked_bloom_filter]" )
+{
+	CHECK( mclo::blocked_bloom_filter<int>( 0 ).num_bits() == 256 );
+	CHECK( mclo::blocked_bloom_filter<int>( 257 ).num_bits() == 512 );
+}
+
+TEST_CASE( "blocked_bloom_filter clear", "[blocked_bloom_filter]" )
+{
+	mclo::blocked_bloom_filter<int> filter( 1024 );
+	filter.insert( 42 );
+	CHECK( filter.contains( 42 ) );
+	filter.clear();
+	CHECK_FALSE( filter.contains( 42 ) );
+}
+
+TEST_CASE( "blocked_bloom_filter serialize round trip", "[blocked_bloom_filter]" )
+{
+	const auto keys = make_unique_values( 1000, 7 );
+	auto filter = mclo::blocked_bloom_filter<std::uint64_t>::with_false_positive_rate( keys.size(), 0.01 );
+	filter.insert_many( keys );
+	const std::vector<std::byte> bytes = filter.serialize();
+	REQUIRE( bytes.size() == filter.serialized_size() );
+
+	const auto copy = mclo::blocked_bloom_filter<std::uint64_t>::deserialize( bytes );
+	REQUIRE( copy );
+	CHECK( copy->num_bits() == filter.num_bits() );
+	CHECK( copy->serialize() == bytes );
+	check_rejects_bad_data( filter );
+}
+
+TEMPLATE_LIST_TEST_CASE( "cuckoo_filter has no false negatives", "[cuckoo_filter]", hasher_types )
+{
+	const auto keys = make_unique_values( 10000, 8 );
+	mclo::cuckoo_filter<std::uint64_t, TestType> filter( keys.size() );
+	for ( const std::uint64_t key : keys )
+	{
+		REQUIRE( filter.insert( key ) );
+	}
+	CHECK( filter.size() == keys.size() );
+	CHECK( std::all_of( keys.begin(), keys.end(), [ &filter ]( const std::uint64_t key ) {
+		return filter.contains( key );
+	} ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "cuckoo_filter false positive rate", "[cuckoo_filter]", hasher_types )
+{
+	const auto keys = make_unique_values( 110000, 9 );
+	const std::vector<std::uint64_t> present( keys.begin(), keys.begin() + 10000 );
+	const std::vector<std::uint64_t> absent( keys.begin() + 10000, keys.end() );
+
+	// About 8 / 2^bits at full load, less when not full
+	mclo::cuckoo_filter<std::uint64_t, TestType, std::uint8_t> filter( present.size() );
+	for ( const std::uint64_t key : present )
+	{
+		REQUIRE( filter.insert( key ) );
+	}
+	CHECK( measure_false_positive_rate( filter, absent ) < 8.0 / 256 );
+}
+
+TEST_CASE( "cuckoo_filter erase", "[cuckoo_filter]" )
+{
+	const auto keys = make_unique_values( 1000, 10 );
+	mclo::cuckoo_filter<std::uint64_t> filter( keys.size() );
+	for ( const std::uint64_t key : keys )
+	{
+		REQUIRE( filter.insert( key ) );
+	}
+	for ( std::size_t index = 0; index < keys.size(); index += 2 )
+	{
+		CHECK( filter.erase( keys[ index ] ) );
+	}
+	CHECK( filter.size() == keys.size() / 2 );
+	for ( std::size_t index = 1; index < keys.size(); index += 2 )
+	{
+		CHECK( filter.contains( keys[ index ] ) );
+	}
+
+	const auto erased_still_found = std::count_if(
+		keys.begin(), keys.end(), [ &filter ]( const std::uint64_t key ) { return filter.contains( key ); } );
+	CHECK( static_cast<std::size_t>( erased_still_found ) < keys.size() / 2 + 5 );
+}
+
+TEST_CASE( "cuckoo_filter duplicate keys", "[cuckoo_filter]" )
+{
+	mclo::cuckoo_filter<int> filter( 16 );
+	REQUIRE( filter.insert( 42 ) );
+	REQUIRE( filter.insert( 42 ) );
+	CHECK( filter.size() == 2 );
+	CHECK( filter.erase( 42 ) );
+	CHECK( filter.contains( 42 ) );
+	CHECK( filter.erase( 42 ) );
+	CHECK_FALSE( filter.contains( 42 ) );
+	CHECK_FALSE( filter.erase( 42 ) );
+	CHECK( filter.empty() );
+}
+
+TEST_CASE( "cuckoo_filter becomes full and recovers after erase", "[cuckoo_filter]" )
+{
+	const auto keys = make_unique_values( 1000, 11 );
+	mclo::cuckoo_filter<std::uint64_t> filter( 64 );
+
+	std::vector<std::uint64_t> inserted;
+	for ( const std::uint64_t key : keys )
+	{
+		if ( !filter.insert( key ) )
+		{
+			break;
+		}
+		inserted.push_back( key );
+	}
+	REQUIRE( filter.full() );
+	CHECK( filter.size() == inserted.size() );
+	CHECK( inserted.size() <= filter.capacity() + 1 );
+	CHECK( filter.load_factor() > 0.9 );
+
+	// Keys inserted before the filter filled, including the homeless one, are all still found
+	CHECK( std::all_of( inserted.begin(), inserted.end(), [ &filter ]( const std::uint64_t key ) {
+		return filter.contains( key );
+	} ) );
+
+	// A single free slot may not be reachable from the homeless fingerprint's buckets, freeing many always is
+	const std::size_t half = inserted.size() / 2;
+	for ( std::size_t index = 0; index < half; ++index )
+	{
+		CHECK( filter.erase( inserted[ index ] ) );
+	}
+	CHECK_FALSE( filter.full() );
+	for ( std::size_t index = 0; index < half; ++index )
+	{
+		CHECK( filter.insert( inserted[ index ] ) );
+	}
+	CHECK( std::all_of( inserted.begin(), inserted.end(), [ &filter ]( const std::uint64_t key ) {
+		return filter.contains( key );
+	} ) );
+}
+
+TEST_CASE( "cuckoo_filter clear", "[cuckoo_filter]" )
+{
+	mclo::cuckoo_filter<int> filter( 16 );
+	REQUIRE( filter.insert( 42 ) );
+	filter.clear();
+	CHECK( filter.empty() );
+	CHECK_FALSE( filter.contains( 42 ) );
+}
+
+TEST_CASE( "cuckoo_filter serialize round trip", "[cuckoo_filter]" )
+{
+	const auto keys = make_unique_values( 1000, 12 );
+	mclo::cuckoo_filter<std::uint64_t> filter( keys.size() );
+	for ( const std::uint64_t key : keys )
+	{
+		REQUIRE( filter.insert( key ) );
+	}
+	const std::vector<std::byte> bytes = filter.serialize();
+	REQUIRE( bytes.size() == filter.serialized_size() );
+
+	const auto copy = mclo::cuckoo_filter<std::uint64_t>::deserialize( bytes );
+	REQUIRE( copy );
+	CHECK( copy->size() == filter.size() );
+	CHECK( copy->capacity() == filter.capacity() );
+	CHECK( copy->serialize() == bytes );
+	check_rejects_bad_data( filter );
+
+	// Fingerprint size must match
+	CHECK_FALSE( ( mclo::cuckoo_filter<std::uint64_t, mclo::rapidhash, std::uint32_t>::deserialize( bytes ) ) );
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "mclo/container/flat_map.hpp"
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	template <typename Key, typename T>
+	using eytzinger_flat_map = mclo::flat_map<Key, T, std::less<Key>, mclo::eytzinger_layout>;
+
+	template <typename Map>
+	std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>> entries_of( const Map& map )
+	{
+		std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>> result;
+		for ( const auto& [ key, value ] : map )
+		{
+			result.emplace_back( key, value );
+		}
+		return result;
+	}
+}
+
+TEMPLATE_TEST_CASE( "default constructed flat_map, is empty",
+					"[flat_map]",
+					( mclo::flat_map<int, std::string> ),
+					( eytzinger_flat_map<int, std::string> ) )
+{
+	const TestType map;
+
+	CHECK( map.empty() );
+	CHECK( map.size() == 0 );
+	CHECK( map.begin() == map.end() );
+	CHECK( map.find( 1 ) == map.end() );
+	CHECK_THROWS_AS( map.at( 1 ), std::out_of_range );
+}
+
+TEMPLATE_TEST_CASE( "flat_map constructed from pairs, sorted by key with first duplicate kept",
+					"[flat_map]",
+					( mclo::flat_map<int, std::string> ),
+					( eytzinger_flat_map<int, std::string> ) )
+{
+	const TestType map{ { 3, "three" }, { 1, "one" }, { 3, "other" }, { 2, "two" } };
+
+	CHECK( map.size() == 3 );
+	CHECK( entries_of( map ) ==
+		   std::vector<std::pair<int, std::string>>{ { 1, "one" }, { 2, "two" }, { 3, "three" } } );
+	CHECK( map.keys().size() == map.values().size() );
+	CHECK( map.values()[ 2 ] == "three" );
+}
+
+TEMPLATE_TEST_CASE( "flat_map try_emplace and operator[], insert or find values",
+					"[flat_map]",
+					( mclo::flat_map<int, std::string> ),
+					( eytzinger_flat_map<int, std::string> ) )
+{
+	TestType map;
+
+	const auto [ it, inserted ] = map.try_emplace( 5, "five" );
+	CHECK( inserted );
+	CHECK( it->first == 5 );
+	CHECK( it->second == "five" );
+	CHECK_FALSE( map.try_emplace( 5, "other" ).second );
+	map[ 1 ] = "one";
+	map[ 5 ] += "!";
+
+	CHECK( map.at( 5 ) == "five!" );
+	CHECK( map.at( 1 ) == "one" );
+	CHECK( map[ 9 ].empty() );
+	CHECK( map.size() == 3 );
+	CHECK( map.begin()->first == 1 );
+}
+
+TEMPLATE_TEST_CASE( "flat_map insert_or_assign, assigns present keys",
+					"[flat_map]",
+					( mclo::flat_map<int, int> ),
+					( eytzinger_flat_map<int, int> ) )
+{
+	TestType map;
+
+	CHECK( map.insert_or_assign( 1, 10 ).second );
+	CHECK_FALSE( map.insert_or_assign( 1, 20 ).second );
+
+	CHECK( map.at( 1 ) == 20 );
+}
+
+TEMPLATE_TEST_CASE( "flat_map bounds, find neighbouring entries",
+					"[flat_map]",
+					( mclo::flat_map<int, int> ),
+					( eytzinger_flat_map<int, int> ) )
+{
+	const TestType map{ { 10, 1 }, { 20, 2 }, { 30, 3 } };
+
+	CHECK( map.lower_bound( 15 )->first == 20 );
+	CHECK( map.upper_bound( 20 )->first == 30 );
+	CHECK( map.lower_bound( 31 ) == map.end() );
+	const auto [ first, last ] = map.equal_range( 10 );
+	CHECK( last - first == 1 );
+	CHECK( first->second == 1 );
+	CHECK( map.contains( 30 ) );
+	CHECK_FALSE( map.contains( 25 ) );
+}
+
+TEMPLATE_TEST_CASE( "flat_map large random insert_range, matches std::map",
+					"[flat_map]",
+					( mclo::flat_map<std::int64_t, int> ),
+					( eytzinger_flat_map<std::int64_t, int> ),
+					( mclo::flat_map<std::string, int> ) )
+{
+	using key_type = typename TestType::key_type;
+	std::mt19937_64 rng( 1 );
+	std::vector<std::pair<key_type, int>> entries;
+	for ( int index = 0; index < 5000; ++index )
+	{
+		const std::int64_t key = static_cast<std::int64_t>( rng() % 4000 ) - 2000;
+		if constexpr ( std::same_as<key_type, std::string> )
+		{
+			entries.emplace_back( std::to_string( key ), index );
+		}
+		else
+		{
+			entries.emplace_back( key, index );
+		}
+	}
+
+	TestType map( std::vector( entries.begin(), entries.begin() + 1000 ) );
+	map.insert_range( std::vector( entries.begin() + 1000, entries.end() ) );
+	std::map<key_type, int> expected;
+	for ( const auto& [ key, value ] : entries )
+	{
+		expected.try_emplace( key, value );
+	}
+
+	REQUIRE( map.size() == expected.size() );
+	CHECK( entries_of( map ) == std::vector<std::pair<key_type, int>>( expected.begin(), expected.end() ) );
+	for ( const auto& [ key, value ] : expected )
+	{
+		CHECK( map.at( key ) == value );
+	}
+}
+
+TEMPLATE_TEST_CASE( "flat_map erase, keeps keys and values paired",
+					"[flat_map]",
+					( mclo::flat_map<int, std::string> ),
+					( eytzinger_flat_map<int, std::string> ) )
+{
+	TestType map{ { 1, "a" }, { 2, "b" }, { 3, "c" }, { 4, "d" }, { 5, "e" } };
+
+	CHECK( map.erase( 2 ) == 1 );
+	CHECK( map.erase( 2 ) == 0 );
+	const auto it = map.erase( map.find( 4 ) );
+	CHECK( it->first == 5 );
+	CHECK( std::erase_if( map, []( const auto& entry ) { return entry.second == "e"; } ) == 1 );
+
+	CHECK( entries_of( map ) == std::vector<std::pair<int, std::string>>{ { 1, "a" }, { 3, "c" } } );
+	CHECK( map.at( 3 ) == "c" );
+	CHECK_FALSE( map.contains( 5 ) );
+}
+
+TEST_CASE( "flat_map iterators, mutable values and const conversion", "[flat_map]" )
+{
+	mclo::flat_map<int, int> map{ { 1, 1 }, { 2, 2 }, { 3, 3 } };
+
+	for ( auto [ key, value ] : map )
+	{
+		value *= 10;
+	}
+	mclo::flat_map<int, int>::const_iterator it = map.begin();
+	++it;
+
+	CHECK( it->second == 20 );
+	CHECK( ( map.rbegin() )->first == 3 );
+	CHECK( map.end() - map.begin() == 3 );
+	CHECK( map.values()[ 0 ] == 10 );
+}
@@ -0,0 +1,172 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/flat_set.hpp"
+
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+	template <typename Key, typename Compare = std::less<Key>>
+	using eytzinger_flat_set = mclo::flat_set<Key, Compare, mclo::eytzinger_layout>;
+}
+
+TEMPLATE_TEST_CASE( "default constructed flat_set, is empty",
+					"[flat_set]",
+					mclo::flat_set<int>,
+					eytzinger_flat_set<int> )
+{
+	const TestType set;
+
+	CHECK( set.empty() );
+	CHECK( set.size() == 0 );
+	CHECK( set.begin() == set.end() );
+	CHECK( set.find( 1 ) == set.end() );
+	CHECK_FALSE( set.contains( 1 ) );
+	CHECK( set.lower_bound( 1 ) == set.end() );
+}
+
+TEMPLATE_TEST_CASE( "flat_set constructed from unsorted range with duplicates, is sorted and unique",
+					"[flat_set]",
+					mclo::flat_set<int>,
+					eytzinger_flat_set<int> )
+{
+	const TestType set( std::vector{ 5, 3, 9, 3, 1, 5, -2 } );
+
+	CHECK( set.size() == 5 );
+	CHECK_THAT( set, RangeEquals( std::vector{ -2, 1, 3, 5, 9 } ) );
+}
+
+TEMPLATE_TEST_CASE( "flat_set insert, keeps sorted and rejects duplicates",
+					"[flat_set]",
+					mclo::flat_set<int>,
+					eytzinger_flat_set<int> )
+{
+	TestType set;
+
+	CHECK( set.insert( 5 ).second );
+	CHECK( set.insert( 1 ).second );
+	const auto [ it, inserted ] = set.insert( 3 );
+	CHECK( inserted );
+	CHECK( *it == 3 );
+	CHECK_FALSE( set.insert( 5 ).second );
+	CHECK( set.emplace( 7 ).second );
+
+	CHECK_THAT( set, RangeEquals( std::vector{ 1, 3, 5, 7 } ) );
+}
+
+TEMPLATE_TEST_CASE( "flat_set lookups, find bounds of present and absent keys",
+					"[flat_set]",
+					mclo::flat_set<int>,
+					eytzinger_flat_set<int> )
+{
+	const TestType set{ 10, 20, 30, 40, 50 };
+
+	CHECK( *set.find( 30 ) == 30 );
+	CHECK( set.find( 35 ) == set.end() );
+	CHECK( set.contains( 10 ) );
+	CHECK( set.contains( 50 ) );
+	CHECK_FALSE( set.contains( 5 ) );
+	CHECK_FALSE( set.contains( 55 ) );
+	CHECK( set.count( 20 ) == 1 );
+	CHECK( *set.lower_bound( 25 ) == 30 );
+	CHECK( *set.lower_bound( 30 ) == 30 );
+	CHECK( *set.upper_bound( 30 ) == 40 );
+	CHECK( set.lower_bound( 60 ) == set.end() );
+	CHECK( set.lower_bound( 0 ) == set.begin() );
+
+	const auto [ first, last ] = set.equal_range( 40 );
+	CHECK( std::distance( first, last ) == 1 );
+	CHECK( *first == 40 );
+}
+
+TEMPLATE_TEST_CASE( "flat_set insert_range into non-empty set, merges and keeps existing",
+					"[flat_set]",
+					mclo::flat_set<int>,
+					eytzinger_flat_set<int> )
+{
+	TestType set{ 2, 4, 6 };
+
+	set.insert_range( std::vector{ 7, 1, 4, 3, 7 } );
+
+	CHECK_THAT( set, RangeEquals( std::vector{ 1, 2, 3, 4, 6, 7 } ) );
+	CHECK( set.contains( 3 ) );
+	CHECK( *set.find( 7 ) == 7 );
+}
+
+TEST_CASE( "flat_set insert_range with comparison sorted keys, first equivalent key kept", "[flat_set]" )
+{
+	const auto shorter = []( const std::string& lhs, const std::string& rhs ) { return lhs.size() < rhs.size(); };
+	mclo::flat_set<std::string, decltype( shorter )> set( shorter );
+	set.insert( "bb" );
+
+	set.insert_range( std::vector<std::string>{ "ccc", "a", "xx", "yyy", "d" } );
+
+	CHECK_THAT( set, RangeEquals( std::vector<std::string>{ "a", "bb", "ccc" } ) );
+}
+
+TEMPLATE_TEST_CASE( "flat_set large random insert_range, matches std::set",
+					"[flat_set]",
+					mclo::flat_set<std::uint64_t>,
+					eytzinger_flat_set<std::uint64_t>,
+					( eytzinger_flat_set<std::int32_t, std::greater<>> ) )
+{
+	using key_type = typename TestType::key_type;
+	using compare = typename TestType::key_compare;
+	std::mt19937_64 rng( 1 );
+	std::vector<key_type> keys( 5000 );
+	for ( key_type& key : keys )
+	{
+		key = static_cast<key_type>( rng() % 4000 );
+	}
+
+	TestType set( std::vector<key_type>( keys.begin(), keys.begin() + 1000 ) );
+	set.insert_range( std::vector<key_type>( keys.begin() + 1000, keys.end() ) );
+	const std::set<key_type, compare> expected( keys.begin(), keys.end() );
+
+	CHECK_THAT( set, RangeEquals( expected ) );
+	for ( key_type key = 0; key < 4100; key += 7 )
+	{
+		CHECK( set.contains( key ) == expected.contains( key ) );
+	}
+}
+
+TEMPLATE_TEST_CASE( "flat_set erase, removes keys and lookups still work",
+					"[flat_set]",
+					mclo::flat_set<int>,
+					eytzinger_flat_set<int> )
+{
+	TestType set{ 1, 2, 3, 4, 5, 6 };
+
+	CHECK( set.erase( 3 ) == 1 );
+	CHECK( set.erase( 3 ) == 0 );
+	const auto it = set.erase( set.find( 5 ) );
+	CHECK( *it == 6 );
+	CHECK( std::erase_if( set, []( const int key ) { return key % 2 == 0; } ) == 3 );
+
+	CHECK_THAT( set, RangeEquals( std::vector{ 1 } ) );
+	CHECK( set.contains( 1 ) );
+	CHECK_FALSE( set.contains( 2 ) );
+}
+
+TEMPLATE_TEST_CASE( "flat_set clear and swap", "[flat_set]", mclo::flat_set<int>, eytzinger_flat_set<int> )
+{
+	TestType set{ 1, 2, 3 };
+	TestType other{ 4 };
+
+	swap( set, other );
+	CHECK_THAT( set, RangeEquals( std::vector{ 4 } ) );
+	CHECK( other.contains( 2 ) );
+
+	other.clear();
+	CHECK( other.empty() );
+	CHECK_FALSE( other.contains( 2 ) );
+	CHECK( other.insert( 2 ).second );
+}
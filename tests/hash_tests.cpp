@@ -1,6 +1,8 @@
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
+#include "mclo/hash/buffered_hasher.hpp"
 #include "mclo/hash/fnv1a_hasher.hpp"
 #include "mclo/hash/hash.hpp"
 #include "mclo/hash/murmur_hash_3.hpp"
@@ -12,7 +14,9 @@
 #include "mclo/meta/type_aliases.hpp"
 #include "mclo/meta/type_list.hpp"
 
+#include <array>
 #include <cstdint>
+#include <list>
 #include <optional>
 #include <string>
 #include <vector>
@@ -63,6 +67,164 @@ namespace
 	// fnv1a_hasher is not seedable, so it is excluded from the seed-forwarding tests
 	using seedable_hasher_types =
 		mclo::meta::type_list<mclo::murmur_hash_3, mclo::rapidhash, mclo::xxhash_64, mclo::xxhash_3>;
+
+	// Hashers whose result only depends on the bytes written, not how writes split them
+	using streaming_hasher_types =
+		mclo::meta::type_list<mclo::fnv1a_hasher, mclo::murmur_hash_3, mclo::xxhash_64, mclo::xxhash_3>;
+
+	struct write_recording_hasher
+	{
+		std::vector<std::size_t> write_sizes;
+
+		void write( const mclo::span<const std::byte> data ) noexcept
+		{
+			write_sizes.push_back( data.size() );
+		}
+
+		std::size_t finish() const noexcept
+		{
+			return write_sizes.size();
+		}
+	};
+
+	struct adjacent_fields
+	{
+		std::uint32_t a;
+		std::uint32_t b;
+		std::uint16_t c;
+		std::uint8_t d;
+		std::uint8_t e;
+	};
+
+	struct padded_fields
+	{
+		std::uint8_t a;
+		std::uint32_t b;
+	};
+
+	// Qualified calls so it hashes with hashers outside of mclo too
+	struct nested_fields
+	{
+		std::uint32_t a;
+		std::uint32_t b;
+
+		template <mclo::hasher Hasher>
+		friend void hash_append( Hasher& hasher, const nested_fields& value ) noexcept
+		{
+			mclo::hash_append( hasher, value.a );
+			mclo::hash_append( hasher, value.b );
+		}
+	};
+
+	struct mixed_fields
+	{
+		std::uint32_t a;
+		nested_fields nested;
+		std::uint32_t b;
+		std::uint32_t c;
+	};
+
+	std::vector<std::byte> make_bytes( const std::size_t size )
+	{
+		std::vector<std::byte> result( size );
+		for ( std::size_t index = 0; index < size; ++index )
+		{
+			result[ index ] = static_cast<std::byte>( index * 31 + 7 );
+		}
+		return result;
+	}
+
+	// Writes the bytes split at each of the sizes in turn, then whatever is left
+	template <typename Hasher>
+	std::size_t hash_split( const std::vector<std::byte>& bytes, const std::vector<std::size_t>& split_sizes )
+	{
+		Hasher hasher;
+		mclo::span<const std::byte> remaining( bytes );
+		for ( const std::size_t size : split_sizes )
+		{
+			hasher.write( remaining.first( size ) );
+			remaining = remaining.subspan( size );
+		}
+		hasher.write( remaining );
+		return hasher.finish();
+	}
+
+	static_assert( mclo::is_contiguously_hashable_v<std::uint32_t> );
+	static_assert( mclo::is_contiguously_hashable_v<test_enum> );
+	static_assert( mclo::is_contiguously_hashable_v<std::array<std::uint64_t, 2>> );
+	static_assert( mclo::is_contiguously_hashable_v<std::uint16_t[ 3 ]> );
+	static_assert( !mclo::is_contiguously_hashable_v<float> );
+	static_assert( !mclo::is_contiguously_hashable_v<bitwise_hashable_type> );
+	static_assert( !mclo::is_contiguously_hashable_v<test_type> );
+
+	template <typename T>
+	T make_key( const std::size_t index )
+	{
+		const auto bits = static_cast<std::uint64_t>( index + 1 ) * 0x9e3779b97f4a7c15;
+		if constexpr ( std::is_integral_v<T> )
+		{
+			return static_cast<T>( bits );
+		}
+		else if constexpr ( std::is_same_v<T, test_type> )
+		{
+			return { static_cast<int>( bits ), static_cast<int>( bits >> 32 ) };
+		}
+		else if constexpr ( std::is_same_v<T, std::string> )
+		{
+			return std::string( index % 40, static_cast<char>( 'a' + index % 26 ) );
+		}
+		else
+		{
+			T result{};
+			for ( std::size_t element = 0; element < result.size(); ++element )
+			{
+				result[ element ] = make_key<typename T::value_type>( index * result.size() + element );
+			}
+			return result;
+		}
+	}
+
+	// Every count with keys left over from whole SIMD registers
+	template <typename Hasher, typename T, typename... Args>
+	void check_hash_many( const Args&... args )
+	{
+		for ( const std::size_t count : { 0, 1, 7, 33 } )
+		{
+			std::vector<T> keys;
+			for ( std::size_t index = 0; index < count; ++index )
+			{
+				keys.push_back( make_key<T>( index ) );
+			}
+			std::vector<std::size_t> hashes( count );
+
+			mclo::hash_many<Hasher>( keys, hashes, args... );
+
+			for ( std::size_t index = 0; index < count; ++index )
+			{
+				CHECK( hashes[ index ] == mclo::hash_object<Hasher>( keys[ index ], args... ) );
+			}
+		}
+	}
+
+	template <typename Hasher, typename... Args>
+	void check_hash_many_key_types( const Args&... args )
+	{
+		// Fixed size fast paths
+		check_hash_many<Hasher, std::uint32_t>( args... );
+		check_hash_many<Hasher, std::uint64_t>( args... );
+		check_hash_many<Hasher, std::array<std::uint32_t, 3>>( args... );
+		check_hash_many<Hasher, std::array<std::uint64_t, 2>>( args... );
+
+		// Bulk hashed sizes without a dedicated path
+		check_hash_many<Hasher, std::uint8_t>( args... );
+		check_hash_many<Hasher, std::uint16_t>( args... );
+		check_hash_many<Hasher, std::array<std::uint8_t, 7>>( args... );
+		check_hash_many<Hasher, std::array<std::uint64_t, 3>>( args... );
+
+		// Hashed one at a time
+		check_hash_many<Hasher, test_type>( args... );
+		check_hash_many<Hasher, std::string>( args... );
+	}
 }
 
 TEMPLATE_LIST_TEST_CASE( "hash built in types", "[hash]", mclo::meta::integers )
@@ -197,3 +359,144 @@ TEMPLATE_LIST_TEST_CASE( "hash_range forwards seed to hasher", "[hash]", seedabl
 	CHECK( seeded_result != mclo::hash_range<TestType>( vec ) );
 	CHECK( seeded_result != mclo::hash_range<TestType>( vec, seed + 1 ) );
 }
+
+TEMPLATE_LIST_TEST_CASE( "hash_many matches hash_object", "[hash]", hasher_types )
+{
+	check_hash_many_key_types<TestType>();
+}
+
+TEMPLATE_LIST_TEST_CASE( "hash_many forwards seed to hasher", "[hash]", seedable_hasher_types )
+{
+	constexpr std::uint32_t seed = 0x12345678;
+	check_hash_many_key_types<TestType>( seed );
+
+	const std::vector<std::uint64_t> keys{ 1, 2, 3 };
+	std::vector<std::size_t> hashes( keys.size() );
+	std::vector<std::size_t> unseeded_hashes( keys.size() );
+	mclo::hash_many<TestType>( keys, hashes, seed );
+	mclo::hash_many<TestType>( keys, unseeded_hashes );
+	CHECK( hashes != unseeded_hashes );
+}
+
+TEMPLATE_LIST_TEST_CASE( "hash_many on a non contiguous range", "[hash]", hasher_types )
+{
+	const std::list<std::uint64_t> keys{ 4, 8, 15, 16, 23, 42 };
+	std::vector<std::size_t> hashes( keys.size() );
+
+	mclo::hash_many<TestType>( keys, hashes );
+
+	std::size_t index = 0;
+	for ( const std::uint64_t key : keys )
+	{
+		CHECK( hashes[ index++ ] == mclo::hash_object<TestType>( key ) );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "buffered_hasher matches streaming hashers", "[hash]", streaming_hasher_types )
+{
+	using buffered = mclo::buffered_hasher<TestType, 16>;
+	const std::vector<std::byte> bytes = make_bytes( 200 );
+	const std::vector<std::size_t> split_sizes{ 1, 3, 0, 11, 16, 1, 40, 2, 15 };
+
+	CHECK( hash_split<buffered>( bytes, split_sizes ) == hash_split<TestType>( bytes, {} ) );
+	CHECK( mclo::hash_object<buffered>( test_type{ 42, 7 } ) == mclo::hash_object<TestType>( test_type{ 42, 7 } ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "buffered_hasher result does not depend on how writes split", "[hash]", hasher_types )
+{
+	using buffered = mclo::buffered_hasher<TestType, 16>;
+	const std::size_t size = GENERATE( 0, 5, 16, 17, 200 );
+	const std::vector<std::byte> bytes = make_bytes( size );
+	const std::size_t expected = hash_split<buffered>( bytes, {} );
+
+	for ( const std::size_t split : { 1, 3, 15, 16, 33 } )
+	{
+		std::vector<std::size_t> split_sizes( size / split, split );
+		CHECK( hash_split<buffered>( bytes, split_sizes ) == expected );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "buffered_hasher result depends on every byte", "[hash]", hasher_types )
+{
+	const std::vector<std::byte> bytes = make_bytes( 128 );
+	const std::size_t expected_16 = hash_split<mclo::buffered_hasher<TestType, 16>>( bytes, {} );
+	const std::size_t expected_64 = hash_split<mclo::buffered_hasher<TestType, 64>>( bytes, {} );
+
+	for ( std::size_t index = 0; index < bytes.size(); ++index )
+	{
+		std::vector<std::byte> changed = bytes;
+		changed[ index ] ^= std::byte{ 1 };
+		CHECK( hash_split<mclo::buffered_hasher<TestType, 16>>( changed, {} ) != expected_16 );
+		CHECK( hash_split<mclo::buffered_hasher<TestType, 64>>( changed, {} ) != expected_64 );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "buffered_hasher forwards seed to hasher", "[hash]", seedable_hasher_types )
+{
+	using buffered = mclo::buffered_hasher<TestType>;
+	const test_type value{ 42, 7 };
+	constexpr std::uint32_t seed = 0x12345678;
+
+	buffered hasher( seed );
+	hash_append( hasher, value );
+	const std::size_t seeded_result = mclo::hash_object<buffered>( value, seed );
+
+	CHECK( seeded_result == hasher.finish() );
+	CHECK( seeded_result != mclo::hash_object<buffered>( value ) );
+}
+
+TEST_CASE( "hash_append_fields merges adjacent fields into one write", "[hash]" )
+{
+	const adjacent_fields value{ 1, 2, 3, 4, 5 };
+	write_recording_hasher hasher;
+
+	mclo::hash_append_fields( hasher, value.a, value.b, value.c, value.d, value.e );
+
+	CHECK( hasher.write_sizes == std::vector<std::size_t>{ sizeof( adjacent_fields ) } );
+}
+
+TEST_CASE( "hash_append_fields does not merge over padding", "[hash]" )
+{
+	const padded_fields value{ 1, 2 };
+	write_recording_hasher hasher;
+
+	mclo::hash_append_fields( hasher, value.a, value.b );
+
+	CHECK( hasher.write_sizes == std::vector<std::size_t>{ 1, 4 } );
+}
+
+TEST_CASE( "hash_append_fields does not merge out of order fields", "[hash]" )
+{
+	const adjacent_fields value{ 1, 2, 3, 4, 5 };
+	write_recording_hasher hasher;
+
+	mclo::hash_append_fields( hasher, value.b, value.a, value.c );
+
+	CHECK( hasher.write_sizes == std::vector<std::size_t>{ 4, 4, 2 } );
+}
+
+TEST_CASE( "hash_append_fields hashes other fields with hash_append", "[hash]" )
+{
+	const mixed_fields value{ 1, { 2, 3 }, 4, 5 };
+	write_recording_hasher hasher;
+
+	mclo::hash_append_fields( hasher, value.a, value.nested, value.b, value.c );
+
+	CHECK( hasher.write_sizes == std::vector<std::size_t>{ 4, 4, 4, 8 } );
+}
+
+TEMPLATE_LIST_TEST_CASE( "hash_append_fields matches hashing each field", "[hash]", streaming_hasher_types )
+{
+	const mixed_fields value{ 1, { 2, 3 }, 4, 5 };
+
+	TestType fused;
+	mclo::hash_append_fields( fused, value.a, value.nested, value.b, value.c );
+
+	TestType separate;
+	hash_append( separate, value.a );
+	hash_append( separate, value.nested );
+	hash_append( separate, value.b );
+	hash_append( separate, value.c );
+
+	CHECK( fused.finish() == separate.finish() );
+}
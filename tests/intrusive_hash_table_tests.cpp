@@ -0,0 +1,248 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "mclo/container/intrusive_hash_table.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct test_type : mclo::intrusive_hash_table_hook<>
+	{
+		test_type( int key, std::string value = {} )
+			: key( key )
+			, value( std::move( value ) )
+		{
+		}
+
+		int key = 0;
+		std::string value;
+	};
+
+	struct key_of_test
+	{
+		int operator()( const test_type& value ) const noexcept
+		{
+			return value.key;
+		}
+	};
+
+	// Collides every key into the same bucket to exercise chains
+	struct colliding_hash
+	{
+		std::size_t operator()( int ) const noexcept
+		{
+			return 42;
+		}
+	};
+
+	using table = mclo::intrusive_hash_table<test_type, key_of_test>;
+	using colliding_table = mclo::intrusive_hash_table<test_type, key_of_test, colliding_hash>;
+
+	template <typename Table>
+	std::vector<int> sorted_keys( const Table& table )
+	{
+		std::vector<int> result;
+		for ( const test_type& value : table )
+		{
+			result.push_back( value.key );
+		}
+		std::ranges::sort( result );
+		return result;
+	}
+}
+
+TEST_CASE( "default constructed intrusive_hash_table, is empty", "[intrusive][intrusive_hash_table]" )
+{
+	const table set;
+	CHECK( set.empty() );
+	CHECK( set.size() == 0 );
+	CHECK( set.bucket_count() == 0 );
+	CHECK( set.begin() == set.end() );
+	CHECK( set.find( 1 ) == set.end() );
+	CHECK_FALSE( set.contains( 1 ) );
+}
+
+TEST_CASE( "intrusive_hash_table constructed with bucket count, rounds up to power of two",
+		   "[intrusive][intrusive_hash_table]" )
+{
+	const table set( 100 );
+	CHECK( set.bucket_count() == 128 );
+}
+
+TEST_CASE( "intrusive_hash_table insert, finds values by key", "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { { 1, "one" }, { 2, "two" }, { 3, "three" } };
+	table set;
+
+	for ( test_type& object : objects )
+	{
+		const auto [ it, inserted ] = set.insert( object );
+		CHECK( inserted );
+		CHECK( &*it == &object );
+	}
+
+	CHECK( set.size() == 3 );
+	CHECK( set.find( 2 )->value == "two" );
+	CHECK( set.contains( 3 ) );
+	CHECK( set.count( 1 ) == 1 );
+	CHECK_FALSE( set.contains( 4 ) );
+}
+
+TEST_CASE( "intrusive_hash_table insert duplicate key, returns existing value", "[intrusive][intrusive_hash_table]" )
+{
+	test_type first( 1, "first" );
+	test_type second( 1, "second" );
+	table set;
+	set.insert( first );
+
+	const auto [ it, inserted ] = set.insert( second );
+
+	CHECK_FALSE( inserted );
+	CHECK( &*it == &first );
+	CHECK( set.size() == 1 );
+}
+
+TEST_CASE( "intrusive_hash_table grows, keeps every value", "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects;
+	for ( int i = 0; i < 1000; ++i )
+	{
+		objects.emplace_back( i );
+	}
+	table set;
+
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	CHECK( set.size() == 1000 );
+	CHECK( set.load_factor() <= 1.0f );
+	CHECK( std::ranges::distance( set ) == 1000 );
+	for ( const test_type& object : objects )
+	{
+		CHECK( &*set.find( object.key ) == &object );
+	}
+}
+
+TEST_CASE( "intrusive_hash_table reserve, inserting does not change bucket count",
+		   "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	table set;
+	set.reserve( objects.size() );
+	const std::size_t bucket_count = set.bucket_count();
+
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	CHECK( set.bucket_count() == bucket_count );
+}
+
+TEST_CASE( "intrusive_hash_table erase by key, returns erased value", "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3 };
+	table set;
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	CHECK( set.erase( 2 ) == &objects[ 1 ] );
+	CHECK( set.erase( 2 ) == nullptr );
+	CHECK( set.size() == 2 );
+	CHECK( sorted_keys( set ) == std::vector{ 1, 3 } );
+}
+
+TEST_CASE( "intrusive_hash_table with colliding hashes, erase from middle of chain",
+		   "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4 };
+	colliding_table set;
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	set.erase( objects[ 1 ] );
+	set.erase( objects[ 3 ] );
+
+	CHECK( set.size() == 2 );
+	CHECK( set.contains( 1 ) );
+	CHECK_FALSE( set.contains( 2 ) );
+	CHECK( set.contains( 3 ) );
+	CHECK( sorted_keys( set ) == std::vector{ 1, 3 } );
+}
+
+TEST_CASE( "intrusive_hash_table erase iterator, returns next iterator", "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4, 5 };
+	table set;
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	auto it = set.begin();
+	while ( it != set.end() )
+	{
+		it = it->key % 2 ? set.erase( it ) : std::next( it );
+	}
+
+	CHECK( sorted_keys( set ) == std::vector{ 2, 4 } );
+}
+
+TEST_CASE( "intrusive_hash_table rehash smaller, keeps values", "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3 };
+	table set( 64 );
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	set.rehash( 0 );
+
+	CHECK( set.bucket_count() == 4 );
+	CHECK( sorted_keys( set ) == std::vector{ 1, 2, 3 } );
+}
+
+TEST_CASE( "intrusive_hash_table consume, visits and unlinks every value", "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3 };
+	table set;
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	int sum = 0;
+	set.consume( [ &sum ]( test_type* const value ) noexcept { sum += value->key; } );
+
+	CHECK( sum == 6 );
+	CHECK( set.empty() );
+	CHECK_FALSE( set.contains( 1 ) );
+}
+
+TEST_CASE( "intrusive_hash_table move and swap, transfer values", "[intrusive][intrusive_hash_table]" )
+{
+	std::vector<test_type> objects = { 1, 2 };
+	table set;
+	for ( test_type& object : objects )
+	{
+		set.insert( object );
+	}
+
+	table moved( std::move( set ) );
+	CHECK( set.empty() );
+	CHECK( moved.contains( 1 ) );
+
+	table other;
+	swap( moved, other );
+	CHECK( moved.empty() );
+	CHECK( sorted_keys( other ) == std::vector{ 1, 2 } );
+}
@@ -0,0 +1,242 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/intrusive_list.hpp"
+
+#include <ranges>
+#include <vector>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+	struct test_type : mclo::intrusive_list_hook<>
+	{
+		test_type( int i ) noexcept
+			: i( i )
+		{
+		}
+
+		int i = 0;
+
+		bool operator==( const test_type& other ) const noexcept
+		{
+			return i == other.i;
+		}
+	};
+
+	struct other_tag;
+
+	struct multi_list_type : mclo::intrusive_list_hook<>, mclo::intrusive_list_hook<other_tag>
+	{
+		multi_list_type( int i ) noexcept
+			: i( i )
+		{
+		}
+
+		int i = 0;
+	};
+
+	std::vector<int> values_of( const mclo::intrusive_list<test_type>& list )
+	{
+		std::vector<int> result;
+		for ( const test_type& value : list )
+		{
+			result.push_back( value.i );
+		}
+		return result;
+	}
+}
+
+template <>
+struct Catch::StringMaker<test_type> : Catch::StringMaker<int>
+{
+	static std::string convert( const test_type& value )
+	{
+		return StringMaker<int>::convert( value.i );
+	}
+};
+
+TEST_CASE( "default constructed intrusive_list, is empty", "[intrusive][intrusive_list]" )
+{
+	const mclo::intrusive_list<test_type> list;
+	CHECK( list.empty() );
+	CHECK( list.size() == 0 );
+	CHECK( list.begin() == list.end() );
+}
+
+TEST_CASE( "intrusive_list constructed from range, contains elements in order", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4, 5 };
+
+	const mclo::intrusive_list<test_type> list( objects );
+
+	CHECK( list.size() == 5 );
+	CHECK_THAT( list, RangeEquals( objects ) );
+	CHECK_THAT( list | std::views::reverse, RangeEquals( objects | std::views::reverse ) );
+	CHECK( list.front().i == 1 );
+	CHECK( list.back().i == 5 );
+}
+
+TEST_CASE( "intrusive_list push and pop at both ends", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3 };
+	mclo::intrusive_list<test_type> list;
+
+	list.push_back( objects[ 1 ] );
+	list.push_front( objects[ 0 ] );
+	list.push_back( objects[ 2 ] );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 1, 2, 3 } ) );
+
+	CHECK( list.pop_front() == &objects[ 0 ] );
+	CHECK( list.pop_back() == &objects[ 2 ] );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 2 } ) );
+	CHECK_FALSE( objects[ 0 ].is_linked() );
+	CHECK( objects[ 1 ].is_linked() );
+}
+
+TEST_CASE( "intrusive_list erase by reference, unlinks in constant time", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4 };
+	mclo::intrusive_list<test_type> list( objects );
+
+	list.erase( objects[ 2 ] );
+	list.erase( objects[ 0 ] );
+
+	CHECK( list.size() == 2 );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 2, 4 } ) );
+	CHECK_FALSE( objects[ 2 ].is_linked() );
+}
+
+TEST_CASE( "intrusive_list erase range, returns iterator after range", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4, 5 };
+	mclo::intrusive_list<test_type> list( objects );
+
+	const auto it = list.erase( list.iterator_to( objects[ 1 ] ), list.iterator_to( objects[ 4 ] ) );
+
+	CHECK( &*it == &objects[ 4 ] );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 1, 5 } ) );
+}
+
+TEST_CASE( "intrusive_list insert at position", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3 };
+	std::vector<test_type> more = { 10, 11 };
+	mclo::intrusive_list<test_type> list;
+	list.push_back( objects[ 0 ] );
+	list.push_back( objects[ 2 ] );
+
+	const auto it = list.insert( list.iterator_to( objects[ 2 ] ), objects[ 1 ] );
+	CHECK( &*it == &objects[ 1 ] );
+
+	const auto first = list.insert( list.end(), more );
+	CHECK( &*first == &more[ 0 ] );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 1, 2, 3, 10, 11 } ) );
+}
+
+TEST_CASE( "intrusive_list splice single element within same list", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4 };
+	mclo::intrusive_list<test_type> list( objects );
+
+	list.splice( list.begin(), list, list.iterator_to( objects[ 2 ] ) );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 3, 1, 2, 4 } ) );
+
+	list.splice( list.begin(), list, list.begin() );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 3, 1, 2, 4 } ) );
+	CHECK( list.size() == 4 );
+}
+
+TEST_CASE( "intrusive_list splice from other list, moves elements", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2 };
+	std::vector<test_type> others = { 3, 4, 5 };
+	mclo::intrusive_list<test_type> list( objects );
+	mclo::intrusive_list<test_type> other( others );
+
+	list.splice( list.iterator_to( objects[ 1 ] ), other, other.begin(), std::prev( other.end() ) );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 1, 3, 4, 2 } ) );
+	CHECK_THAT( values_of( other ), RangeEquals( std::vector{ 5 } ) );
+	CHECK( list.size() == 4 );
+	CHECK( other.size() == 1 );
+
+	list.splice( list.end(), other );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 1, 3, 4, 2, 5 } ) );
+	CHECK( other.empty() );
+}
+
+TEST_CASE( "intrusive_list reverse", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4 };
+	mclo::intrusive_list<test_type> list( objects );
+
+	list.reverse();
+
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 4, 3, 2, 1 } ) );
+	CHECK( list.back().i == 1 );
+}
+
+TEST_CASE( "intrusive_list remove_if, returns number removed", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3, 4, 5 };
+	mclo::intrusive_list<test_type> list( objects );
+
+	CHECK( std::erase_if( list, []( const test_type& value ) { return value.i % 2 == 0; } ) == 2 );
+	CHECK_THAT( values_of( list ), RangeEquals( std::vector{ 1, 3, 5 } ) );
+	CHECK( list.size() == 3 );
+}
+
+TEST_CASE( "intrusive_list move constructed, takes elements", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3 };
+	mclo::intrusive_list<test_type> list( objects );
+
+	mclo::intrusive_list<test_type> moved( std::move( list ) );
+
+	CHECK( list.empty() );
+	CHECK_THAT( values_of( moved ), RangeEquals( std::vector{ 1, 2, 3 } ) );
+	moved.erase( objects[ 2 ] );
+	CHECK_THAT( values_of( moved ), RangeEquals( std::vector{ 1, 2 } ) );
+}
+
+TEST_CASE( "intrusive_list swap, including empty lists", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2 };
+	mclo::intrusive_list<test_type> list( objects );
+	mclo::intrusive_list<test_type> other;
+
+	swap( list, other );
+
+	CHECK( list.empty() );
+	CHECK_THAT( values_of( other ), RangeEquals( std::vector{ 1, 2 } ) );
+	other.push_front( *other.pop_back() );
+	CHECK_THAT( values_of( other ), RangeEquals( std::vector{ 2, 1 } ) );
+}
+
+TEST_CASE( "intrusive_list consume, unlinks every element", "[intrusive][intrusive_list]" )
+{
+	std::vector<test_type> objects = { 1, 2, 3 };
+	mclo::intrusive_list<test_type> list( objects );
+
+	std::vector<int> consumed;
+	list.consume( [ &consumed ]( test_type* const value ) noexcept { consumed.push_back( value->i ); } );
+
+	CHECK( list.empty() );
+	CHECK_THAT( consumed, RangeEquals( std::vector{ 1, 2, 3 } ) );
+	CHECK_FALSE( objects[ 1 ].is_linked() );
+}
+
+TEST_CASE( "intrusive_list with tagged hooks, element in two lists", "[intrusive][intrusive_list]" )
+{
+	std::vector<multi_list_type> objects = { 1, 2, 3 };
+	mclo::intrusive_list<multi_list_type> list( objects );
+	mclo::intrusive_list<multi_list_type, other_tag> other( objects | std::views::reverse );
+
+	list.erase( objects[ 1 ] );
+
+	CHECK( list.size() == 2 );
+	CHECK( other.size() == 3 );
+	CHECK( other.front().i == 3 );
+	CHECK( other.back().i == 1 );
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "mclo/container/intrusive_lru.hpp"
+
+#include <vector>
+
+namespace
+{
+	struct entry : mclo::intrusive_list_hook<>, mclo::intrusive_hash_table_hook<>
+	{
+		entry( int key, int value = 0 ) noexcept
+			: key( key )
+			, value( value )
+		{
+		}
+
+		int key = 0;
+		int value = 0;
+	};
+
+	struct key_of_entry
+	{
+		int operator()( const entry& value ) const noexcept
+		{
+			return value.key;
+		}
+	};
+
+	using lru = mclo::intrusive_lru<entry, key_of_entry>;
+
+	std::vector<int> keys_of( const lru& cache )
+	{
+		std::vector<int> result;
+		for ( const entry& value : cache )
+		{
+			result.push_back( value.key );
+		}
+		return result;
+	}
+}
+
+TEST_CASE( "constructed intrusive_lru, is empty with capacity", "[intrusive][intrusive_lru]" )
+{
+	const lru cache( 4 );
+	CHECK( cache.empty() );
+	CHECK_FALSE( cache.full() );
+	CHECK( cache.size() == 0 );
+	CHECK( cache.capacity() == 4 );
+	CHECK( cache.peek( 1 ) == nullptr );
+}
+
+TEST_CASE( "intrusive_lru insert below capacity, evicts nothing", "[intrusive][intrusive_lru]" )
+{
+	std::vector<entry> entries = { 1, 2, 3 };
+	lru cache( 3 );
+
+	for ( entry& value : entries )
+	{
+		CHECK( cache.insert( value ) == nullptr );
+	}
+
+	CHECK( cache.full() );
+	CHECK( keys_of( cache ) == std::vector{ 3, 2, 1 } );
+	CHECK( cache.most_recent().key == 3 );
+	CHECK( cache.least_recent().key == 1 );
+}
+
+TEST_CASE( "intrusive_lru insert when full, evicts least recently used", "[intrusive][intrusive_lru]" )
+{
+	std::vector<entry> entries = { 1, 2, 3, 4 };
+	lru cache( 3 );
+	for ( int i = 0; i < 3; ++i )
+	{
+		(void)cache.insert( entries[ i ] );
+	}
+
+	CHECK( cache.insert( entries[ 3 ] ) == &entries[ 0 ] );
+
+	CHECK( cache.size() == 3 );
+	CHECK_FALSE( cache.contains( 1 ) );
+	CHECK( keys_of( cache ) == std::vector{ 4, 3, 2 } );
+}
+
+TEST_CASE( "intrusive_lru find, marks as most recently used", "[intrusive][intrusive_lru]" )
+{
+	std::vector<entry> entries = { { 1, 10 }, { 2, 20 }, { 3, 30 }, { 4, 40 } };
+	lru cache( 3 );
+	for ( int i = 0; i < 3; ++i )
+	{
+		(void)cache.insert( entries[ i ] );
+	}
+
+	const entry* const found = cache.find( 1 );
+	REQUIRE( found );
+	CHECK( found->value == 10 );
+	CHECK( cache.find( 5 ) == nullptr );
+
+	CHECK( cache.insert( entries[ 3 ] ) == &entries[ 1 ] );
+	CHECK( keys_of( cache ) == std::vector{ 4, 1, 3 } );
+}
+
+TEST_CASE( "intrusive_lru peek, does not change order", "[intrusive][intrusive_lru]" )
+{
+	std::vector<entry> entries = { { 1, 10 }, { 2, 20 } };
+	lru cache( 2 );
+	for ( entry& value : entries )
+	{
+		(void)cache.insert( value );
+	}
+
+	CHECK( cache.peek( 1 )->value == 10 );
+	CHECK( cache.least_recent().key == 1 );
+}
+
+TEST_CASE( "intrusive_lru evicted entry, can be reused for new key", "[intrusive][intrusive_lru]" )
+{
+	std::vector<entry> entries = { 1, 2 };
+	lru cache( 2 );
+	for ( entry& value : entries )
+	{
+		(void)cache.insert( value );
+	}
+
+	entry* const reused = cache.pop_least_recent();
+	REQUIRE( reused == &entries[ 0 ] );
+	reused->key = 5;
+	CHECK( cache.insert( *reused ) == nullptr );
+
+	CHECK( cache.contains( 5 ) );
+	CHECK_FALSE( cache.contains( 1 ) );
+	CHECK( keys_of( cache ) == std::vector{ 5, 2 } );
+}
+
+TEST_CASE( "intrusive_lru erase, unlinks from order and lookup", "[intrusive][intrusive_lru]" )
+{
+	std::vector<entry> entries = { 1, 2, 3 };
+	lru cache( 3 );
+	for ( entry& value : entries )
+	{
+		(void)cache.insert( value );
+	}
+
+	cache.erase( entries[ 1 ] );
+	CHECK( cache.erase( 3 ) == &entries[ 2 ] );
+	CHECK( cache.erase( 3 ) == nullptr );
+
+	CHECK( cache.size() == 1 );
+	CHECK( keys_of( cache ) == std::vector{ 1 } );
+	CHECK_FALSE( cache.contains( 2 ) );
+}
+
+TEST_CASE( "intrusive_lru pop_least_recent on empty, returns nullptr", "[intrusive][intrusive_lru]" )
+{
+	lru cache( 1 );
+	CHECK( cache.pop_least_recent() == nullptr );
+}
+
+TEST_CASE( "intrusive_lru clear, unlinks every entry", "[intrusive][intrusive_lru]" )
+{
+	std::vector<entry> entries = { 1, 2 };
+	lru cache( 2 );
+	for ( entry& value : entries )
+	{
+		(void)cache.insert( value );
+	}
+
+	cache.clear();
+
+	CHECK( cache.empty() );
+	CHECK_FALSE( cache.contains( 1 ) );
+	CHECK_FALSE( entries[ 0 ].is_linked() );
+	CHECK( cache.insert( entries[ 0 ] ) == nullptr );
+}
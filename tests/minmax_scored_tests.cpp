@@ -1,7 +1,16 @@
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include "mclo/algorithm/minmax_scored.hpp"
 
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <random>
+#include <vector>
+
 namespace
 {
 	struct counted_identity
@@ -15,6 +24,40 @@ namespace
 
 		std::size_t& calls;
 	};
+
+	// Few distinct values so ties are common and the first of them must be found
+	template <typename T>
+	std::vector<T> make_values( const std::size_t size )
+	{
+		std::mt19937_64 rng( size );
+		std::vector<T> result( size );
+		for ( T& value : result )
+		{
+			value = static_cast<T>( rng() % 97 );
+		}
+		return result;
+	}
+
+	// A list only has forward iterators so always takes the scalar path, which the SIMD path must match
+	template <typename T, typename Scorer>
+	void check_matches_scalar( const std::vector<T>& values, Scorer score )
+	{
+		const std::list<T> list( values.begin(), values.end() );
+		const auto offset_in_list = [ & ]( const auto it ) {
+			return static_cast<std::ptrdiff_t>( std::distance( list.begin(), it ) );
+		};
+
+		const auto min_it = mclo::min_scored( values.begin(), values.end(), score );
+		const auto max_it = mclo::max_scored( values.begin(), values.end(), score );
+		const auto [ minmax_min_it, minmax_max_it ] = mclo::minmax_scored( values.begin(), values.end(), score );
+
+		const auto expected_min = offset_in_list( mclo::min_scored( list.begin(), list.end(), score ) );
+		const auto expected_max = offset_in_list( mclo::max_scored( list.begin(), list.end(), score ) );
+		CHECK( min_it - values.begin() == expected_min );
+		CHECK( max_it - values.begin() == expected_max );
+		CHECK( minmax_min_it - values.begin() == expected_min );
+		CHECK( minmax_max_it - values.begin() == expected_max );
+	}
 }
 
 TEST_CASE( "min_scored on empty finds last", "[minmax_scored]" )
@@ -167,3 +210,36 @@ TEST_CASE( "minmax_scored calls predicate once per element", "[minmax_scored]" )
 	CHECK( *max_it == 8 );
 	CHECK( calls == values.size() );
 }
+
+TEMPLATE_TEST_CASE( "minmax_scored SIMD path matches scalar",
+					"[minmax_scored]",
+					std::int32_t,
+					std::uint32_t,
+					std::int64_t,
+					std::uint64_t,
+					float,
+					double )
+{
+	const std::size_t size = GENERATE( 1, 2, 15, 16, 17, 255, 256, 257, 1000, 4099 );
+	const std::vector<TestType> values = make_values<TestType>( size );
+
+	SECTION( "identity" )
+	{
+		check_matches_scalar( values, std::identity{} );
+	}
+	SECTION( "scorer" )
+	{
+		check_matches_scalar( values, []( const TestType value ) { return static_cast<TestType>( 100 - value ); } );
+	}
+}
+
+TEMPLATE_TEST_CASE( "minmax_scored SIMD path handles NaN like scalar", "[minmax_scored]", float, double )
+{
+	constexpr TestType nan = std::numeric_limits<TestType>::quiet_NaN();
+	std::vector<TestType> values = make_values<TestType>( 1000 );
+	const std::size_t nan_index = GENERATE( 0, 1, 8, 300, 999 );
+	values[ nan_index ] = nan;
+
+	check_matches_scalar( values, std::identity{} );
+	check_matches_scalar( values, []( const TestType value ) { return value * 2; } );
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/mirrored_circular_buffer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace Catch::Matchers;
+
+TEST_CASE( "mirrored_memory write, visible in mirror", "[mirrored_memory]" )
+{
+	mclo::mirrored_memory memory( 1 );
+
+	REQUIRE_FALSE( memory.empty() );
+	CHECK( memory.size() == mclo::mirrored_memory::granularity() );
+
+	memory.data()[ 0 ] = std::byte{ 42 };
+	memory.data()[ memory.size() * 2 - 1 ] = std::byte{ 7 };
+
+	CHECK( memory.data()[ memory.size() ] == std::byte{ 42 } );
+	CHECK( memory.data()[ memory.size() - 1 ] == std::byte{ 7 } );
+}
+
+TEST_CASE( "mirrored_memory allocate after release, maps new region", "[mirrored_memory]" )
+{
+	mclo::mirrored_memory memory;
+	CHECK( memory.empty() );
+
+	REQUIRE( memory.allocate( mclo::mirrored_memory::granularity() + 1 ) );
+	CHECK( memory.size() == mclo::mirrored_memory::granularity() * 2 );
+
+	memory.release();
+	CHECK( memory.empty() );
+	CHECK( memory.size() == 0 );
+}
+
+TEST_CASE( "mirrored_circular_buffer construct, is empty with page rounded capacity", "[mirrored_circular_buffer]" )
+{
+	const mclo::mirrored_circular_buffer<std::uint32_t> buffer( 5 );
+
+	CHECK( buffer.capacity() == mclo::mirrored_memory::granularity() / sizeof( std::uint32_t ) );
+	CHECK( buffer.size() == 0 );
+	CHECK( buffer.empty() );
+	CHECK_FALSE( buffer.full() );
+	CHECK( buffer.writable_size() == buffer.capacity() );
+}
+
+TEST_CASE( "mirrored_circular_buffer odd sized values, capacity holds whole values", "[mirrored_circular_buffer]" )
+{
+	using value = std::array<char, 3>;
+	const mclo::mirrored_circular_buffer<value> buffer( 1 );
+
+	CHECK( buffer.capacity() * sizeof( value ) % mclo::mirrored_memory::granularity() == 0 );
+}
+
+TEST_CASE( "mirrored_circular_buffer push and pop, in order", "[mirrored_circular_buffer]" )
+{
+	mclo::mirrored_circular_buffer<int> buffer( 1 );
+	const std::array<int, 4> values{ 1, 2, 3, 4 };
+
+	CHECK( buffer.push_back_n( values ) == 4 );
+	CHECK( buffer.size() == 4 );
+	CHECK_THAT( buffer.peek( 2 ), RangeEquals( std::array{ 1, 2 } ) );
+
+	std::array<int, 3> out{};
+	CHECK( buffer.pop_front_n( out ) == 3 );
+	CHECK_THAT( out, RangeEquals( std::array{ 1, 2, 3 } ) );
+	CHECK_THAT( buffer.peek(), RangeEquals( std::array{ 4 } ) );
+}
+
+TEST_CASE( "mirrored_circular_buffer push back when full, pushes what fits", "[mirrored_circular_buffer]" )
+{
+	mclo::mirrored_circular_buffer<int> buffer( 1 );
+	std::vector<int> values( buffer.capacity() + 10 );
+	std::iota( values.begin(), values.end(), 0 );
+
+	CHECK( buffer.push_back_n( values ) == buffer.capacity() );
+	CHECK( buffer.full() );
+	CHECK( buffer.writable_size() == 0 );
+	CHECK( buffer.write_window().empty() );
+	CHECK( buffer.push_back_n( values ) == 0 );
+}
+
+TEST_CASE( "mirrored_circular_buffer wrap around, peek and write window are contiguous", "[mirrored_circular_buffer]" )
+{
+	mclo::mirrored_circular_buffer<int> buffer( 1 );
+	const std::size_t capacity = buffer.capacity();
+
+	// Move the head to just before the end so later values wrap around
+	buffer.commit_write( capacity - 2 );
+	buffer.commit_read( capacity - 2 );
+	CHECK( buffer.empty() );
+
+	const mclo::span<int> window = buffer.write_window( 5 );
+	REQUIRE( window.size() == 5 );
+	std::iota( window.begin(), window.end(), 10 );
+	buffer.commit_write( 5 );
+
+	CHECK_THAT( buffer.peek(), RangeEquals( std::array{ 10, 11, 12, 13, 14 } ) );
+	CHECK( buffer.write_window().size() == capacity - 5 );
+
+	buffer.commit_read( 3 );
+	CHECK_THAT( buffer.peek(), RangeEquals( std::array{ 13, 14 } ) );
+	CHECK( buffer.peek().data() != window.data() + 3 );
+}
+
+TEST_CASE( "mirrored_circular_buffer clear, is empty", "[mirrored_circular_buffer]" )
+{
+	mclo::mirrored_circular_buffer<int> buffer( 1 );
+	const std::array<int, 3> values{ 1, 2, 3 };
+	buffer.push_back_n( values );
+
+	buffer.clear();
+
+	CHECK( buffer.empty() );
+	CHECK( buffer.writable_size() == buffer.capacity() );
+}
+
+TEST_CASE( "mirrored_circular_buffer move, takes values", "[mirrored_circular_buffer]" )
+{
+	mclo::mirrored_circular_buffer<int> buffer( 1 );
+	const std::array<int, 3> values{ 1, 2, 3 };
+	buffer.push_back_n( values );
+
+	mclo::mirrored_circular_buffer<int> other( std::move( buffer ) );
+
+	CHECK( buffer.capacity() == 0 );
+	CHECK( buffer.empty() );
+	CHECK_THAT( other.peek(), RangeEquals( values ) );
+}
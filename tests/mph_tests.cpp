@@ -5,6 +5,10 @@
 #include "mclo/container/mph_set.hpp"
 #include "mclo/meta/type_aliases.hpp"
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 namespace
 {
 	template <typename T>
@@ -35,6 +39,20 @@ namespace
 	}
 
 	using test_types = mclo::meta::type_list<int, std::optional<int>, std::string_view>;
+
+	// Distinct keys from a full period LCG so large tables can be built in a constant expression
+	template <std::size_t Size>
+	constexpr std::array<std::uint32_t, Size> make_keys()
+	{
+		std::array<std::uint32_t, Size> result{};
+		std::uint32_t state = 1;
+		for ( std::uint32_t& key : result )
+		{
+			state = state * 1664525u + 1013904223u;
+			key = state;
+		}
+		return result;
+	}
 }
 
 TEMPLATE_LIST_TEST_CASE( "mph_map::find", "[mph]", test_types )
@@ -72,6 +90,94 @@ TEMPLATE_LIST_TEST_CASE( "mph_set::contains", "[mph]", test_types )
 	STATIC_CHECK( set.contains( mk( "109" ) ) );
 }
 
+TEST_CASE( "mph_set thousands of keys, built at compile time", "[mph]" )
+{
+	static constexpr auto keys = make_keys<4096>();
+	static constexpr mclo::mph_set<std::uint32_t, keys.size()> set( keys );
+	STATIC_CHECK( set.contains( keys.front() ) );
+	STATIC_CHECK( set.contains( keys[ 2000 ] ) );
+	STATIC_CHECK( set.contains( keys.back() ) );
+	STATIC_CHECK_FALSE( set.contains( 0 ) );
+	for ( const std::uint32_t key : keys )
+	{
+		CHECK( *set.find( key ) == key );
+	}
+}
+
+TEST_CASE( "mph_map string keys, finds every key and rejects absent keys", "[mph]" )
+{
+	std::vector<std::string> names;
+	std::array<std::pair<const std::string_view, std::size_t>, 1000> pairs{};
+	names.reserve( pairs.size() );
+	for ( std::size_t index = 0; index < pairs.size(); ++index )
+	{
+		names.push_back( "key_" + std::to_string( index ) );
+	}
+	for ( std::size_t index = 0; index < pairs.size(); ++index )
+	{
+		std::construct_at( &pairs[ index ], names[ index ], index );
+	}
+
+	const mclo::mph_map<std::string_view, std::size_t, pairs.size()> map( pairs );
+
+	for ( std::size_t index = 0; index < pairs.size(); ++index )
+	{
+		const auto it = map.find( names[ index ] );
+		REQUIRE( it != map.end() );
+		CHECK( it->second == index );
+	}
+	CHECK_FALSE( map.contains( "key_1000" ) );
+	CHECK_FALSE( map.contains( "" ) );
+	CHECK( map.find( "key" ) == map.end() );
+}
+
+TEST_CASE( "mph_set find_many, same results as find", "[mph]" )
+{
+	static constexpr auto keys = make_keys<100>();
+	static constexpr mclo::mph_set<std::uint32_t, keys.size()> set( keys );
+	static constexpr std::size_t found_in_constant_expression = [] {
+		std::array<decltype( set )::const_iterator, 3> found{};
+		return set.find_many( std::array<std::uint32_t, 3>{ keys[ 5 ], 0, keys[ 99 ] }, found );
+	}();
+	STATIC_CHECK( found_in_constant_expression == 2 );
+
+	// Every other lookup is absent and the batch is not a multiple of the group size
+	std::vector<std::uint32_t> lookups;
+	for ( std::size_t index = 0; index < 75; ++index )
+	{
+		lookups.push_back( index % 2 ? keys[ index ] : static_cast<std::uint32_t>( index ) );
+	}
+	std::vector<decltype( set )::const_iterator> found( lookups.size() );
+
+	CHECK( set.find_many( lookups, found ) == 37 );
+	for ( std::size_t index = 0; index < lookups.size(); ++index )
+	{
+		CHECK( found[ index ] == set.find( lookups[ index ] ) );
+	}
+}
+
+TEST_CASE( "mph_map find_many, finds mutable values", "[mph]" )
+{
+	using map_type = mclo::mph_map<int, int, 3>;
+	map_type map{ { { { 1, 10 }, { 2, 20 }, { 3, 30 } } } };
+	const std::array<int, 4> keys{ 3, 4, 1, 2 };
+	std::array<map_type::iterator, 4> found;
+
+	CHECK( map.find_many( keys, found ) == 3 );
+	CHECK( found[ 1 ] == map.end() );
+	found[ 0 ]->second = 31;
+	CHECK( map.find( 3 )->second == 31 );
+	CHECK( found[ 2 ]->second == 10 );
+	CHECK( found[ 3 ]->second == 20 );
+}
+
+TEST_CASE( "mph_set duplicate keys, throws", "[mph]" )
+{
+	using set_type = mclo::mph_set<int, 4>;
+	static constexpr std::array<int, 4> keys{ 1, 2, 3, 2 };
+	CHECK_THROWS_AS( set_type( keys ), std::invalid_argument );
+}
+
 auto foo()
 {
 	static constexpr mclo::mph_hash<std::optional<int>> hash;
@@ -0,0 +1,398 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "fancy_pointer.hpp"
+
+#include "mclo/container/paged_slot_map.hpp"
+#include "mclo/meta/type_list.hpp"
+
+#include <array>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace Catch::Matchers;
+
+namespace
+{
+	// Small pages so tests cross page boundaries
+	using test_map = mclo::paged_slot_map<std::string, 32, 8, 4>;
+	using fancy_test_map = mclo::paged_slot_map<std::string, 32, 8, 4, fancy_allocator<std::string>>;
+	using test_types = mclo::meta::type_list<test_map, fancy_test_map>;
+
+	struct throwing_tester
+	{
+		explicit throwing_tester( const int val )
+			: i( val )
+		{
+			if ( i == 5 )
+			{
+				throw std::runtime_error( "Error" );
+			}
+		}
+		int i;
+	};
+
+	template <typename T>
+	void check_empty( const T& map )
+	{
+		CHECK( map.size() == 0 );
+		CHECK( map.empty() );
+		CHECK( map.begin() == map.end() );
+		CHECK( map.cbegin() == map.cend() );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map default, is empty", "[slot_map]", test_types )
+{
+	const TestType map;
+
+	check_empty( map );
+	CHECK( map.slot_count() == 0 );
+	CHECK_FALSE( map.is_valid( typename TestType::handle_type{} ) );
+	CHECK( map.lookup( typename TestType::handle_type{} ) == nullptr );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map reserve slots, rounded up to whole pages", "[slot_map]", test_types )
+{
+	TestType map;
+
+	map.reserve_slots( 5 );
+
+	check_empty( map );
+	CHECK( map.slot_count() == 8 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map insert, value found by handle", "[slot_map]", test_types )
+{
+	TestType map;
+
+	const auto first = map.insert( "first" );
+	const auto second = map.emplace( 3, 'a' );
+	auto [ object, third ] = map.emplace_and_get( "third" );
+
+	CHECK( map.size() == 3 );
+	CHECK( first != second );
+	REQUIRE( map.lookup( first ) );
+	CHECK( *map.lookup( first ) == "first" );
+	REQUIRE( map.lookup( second ) );
+	CHECK( *map.lookup( second ) == "aaa" );
+	CHECK( map.lookup( third ) == &object );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map lookup, pointer stable across inserts and erases", "[slot_map]", test_types )
+{
+	TestType map;
+	const auto handle = map.insert( "stable" );
+	const std::string* const ptr = map.lookup( handle );
+
+	std::vector<typename TestType::handle_type> others;
+	for ( int index = 0; index < 100; ++index )
+	{
+		others.push_back( map.insert( std::to_string( index ) ) );
+	}
+	for ( std::size_t index = 0; index < others.size(); index += 2 )
+	{
+		map.erase( others[ index ] );
+	}
+
+	CHECK( map.lookup( handle ) == ptr );
+	CHECK( *ptr == "stable" );
+	for ( std::size_t index = 1; index < others.size(); index += 2 )
+	{
+		CHECK( *map.lookup( others[ index ] ) == std::to_string( index ) );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map erase, handle invalidated slot reused with new generation",
+						 "[slot_map]",
+						 test_types )
+{
+	TestType map;
+	const auto old_handle = map.insert( "old" );
+	const auto other = map.insert( "other" );
+	// Fill the rest of the page so the free list only has the erased slot
+	( void )map.insert( "filler" );
+	( void )map.insert( "filler" );
+	map.erase( old_handle );
+
+	const auto new_handle = map.insert( "new" );
+
+	CHECK( map.size() == 4 );
+	CHECK_FALSE( map.is_valid( old_handle ) );
+	CHECK( map.lookup( old_handle ) == nullptr );
+	CHECK( new_handle.index == old_handle.index );
+	CHECK( new_handle.generation != old_handle.generation );
+	CHECK( *map.lookup( new_handle ) == "new" );
+	CHECK( *map.lookup( other ) == "other" );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map iterate, erased entries skipped", "[slot_map]", test_types )
+{
+	TestType map;
+	std::vector<typename TestType::handle_type> handles;
+	for ( int index = 0; index < 10; ++index )
+	{
+		handles.push_back( map.insert( std::to_string( index ) ) );
+	}
+	// Empty a whole page and some scattered slots
+	for ( const std::size_t index : { 0, 4, 5, 6, 7, 9 } )
+	{
+		map.erase( handles[ index ] );
+	}
+
+	constexpr std::array expected_values{ "1", "2", "3", "8" };
+	CHECK_THAT( map, UnorderedRangeEquals( expected_values ) );
+	for ( auto it = map.cbegin(); it != map.cend(); ++it )
+	{
+		CHECK( map.lookup( map.get_handle( it ) ) == &*it );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map for_each, visits same entries as iteration", "[slot_map]", test_types )
+{
+	TestType map;
+	std::vector<typename TestType::handle_type> handles;
+	for ( int index = 0; index < 200; ++index )
+	{
+		handles.push_back( map.insert( std::to_string( index ) ) );
+	}
+	for ( std::size_t index = 0; index < handles.size(); index += 3 )
+	{
+		map.erase( handles[ index ] );
+	}
+
+	std::vector<const std::string*> visited;
+	std::as_const( map ).for_each( [ & ]( const std::string& value ) { visited.push_back( &value ); } );
+
+	std::vector<const std::string*> iterated;
+	for ( const std::string& value : map )
+	{
+		iterated.push_back( &value );
+	}
+	CHECK( visited == iterated );
+	CHECK( visited.size() == map.size() );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map erase iterator, returns next", "[slot_map]", test_types )
+{
+	TestType map;
+	( void )map.insert( "a" );
+	( void )map.insert( "b" );
+
+	const std::string first_value = *map.begin();
+
+	auto it = map.erase( map.begin() );
+
+	REQUIRE( it != map.end() );
+	CHECK( *it != first_value );
+	CHECK( map.erase( it ) == map.end() );
+	check_empty( map );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map erase if, erases expected values", "[slot_map]", test_types )
+{
+	TestType map;
+	for ( const char* const value : { "32", "5", "5", "11", "-20", "5" } )
+	{
+		( void )map.insert( value );
+	}
+
+	const auto count = std::erase_if( map, []( const std::string& value ) { return value == "5"; } );
+
+	CHECK( count == 3 );
+	constexpr std::array expected_values{ "32", "11", "-20" };
+	CHECK_THAT( map, UnorderedRangeEquals( expected_values ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map pop, returns value and erases", "[slot_map]", test_types )
+{
+	TestType map;
+	const auto handle = map.insert( "popped" );
+
+	const std::optional<std::string> popped = map.pop( handle );
+
+	CHECK( popped == "popped" );
+	check_empty( map );
+	CHECK_FALSE( map.pop( handle ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map clear, pages kept and handles invalidated", "[slot_map]", test_types )
+{
+	TestType map;
+	const auto handle = map.insert( "a" );
+	( void )map.insert( "b" );
+
+	map.clear();
+
+	check_empty( map );
+	CHECK( map.slot_count() == 4 );
+	CHECK_FALSE( map.is_valid( handle ) );
+	const auto new_handle = map.insert( "c" );
+	CHECK_FALSE( map.is_valid( handle ) );
+	CHECK( *map.lookup( new_handle ) == "c" );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map reset, slots removed", "[slot_map]", test_types )
+{
+	TestType map;
+	( void )map.insert( "a" );
+
+	map.reset();
+
+	check_empty( map );
+	CHECK( map.slot_count() == 0 );
+	CHECK( *map.lookup( map.insert( "b" ) ) == "b" );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map insert_n, every value inserted with its handle", "[slot_map]", test_types )
+{
+	const std::array<std::string, 6> values{ "a", "b", "c", "d", "e", "f" };
+	TestType map;
+	( void )map.insert( "existing" );
+
+	std::array<typename TestType::handle_type, 6> handles;
+	map.insert_n( values.begin(), handles );
+
+	CHECK( map.size() == 7 );
+	CHECK( map.slot_count() == 8 );
+	for ( std::size_t index = 0; index < values.size(); ++index )
+	{
+		REQUIRE( map.lookup( handles[ index ] ) );
+		CHECK( *map.lookup( handles[ index ] ) == values[ index ] );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map erase_many, valid handles erased invalid skipped", "[slot_map]", test_types )
+{
+	using handle_type = typename TestType::handle_type;
+	TestType map;
+	const handle_type first = map.insert( "first" );
+	const handle_type second = map.insert( "second" );
+	const handle_type third = map.insert( "third" );
+	map.erase( second );
+
+	const std::array<handle_type, 4> to_erase{ first, second, third, first };
+	const auto num_erased = map.erase_many( to_erase );
+
+	CHECK( num_erased == 2 );
+	check_empty( map );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map lookup_many, same results as lookup", "[slot_map]", test_types )
+{
+	using handle_type = typename TestType::handle_type;
+	TestType map;
+	const handle_type first = map.insert( "first" );
+	const handle_type second = map.insert( "second" );
+	const handle_type third = map.insert( "third" );
+	map.erase( first );
+
+	const std::array<handle_type, 4> handles{ first, second, third, handle_type{} };
+	std::array<const std::string*, 4> found;
+	const auto num_found = std::as_const( map ).lookup_many( handles, found );
+
+	CHECK( num_found == 2 );
+	for ( std::size_t index = 0; index < handles.size(); ++index )
+	{
+		CHECK( found[ index ] == map.lookup( handles[ index ] ) );
+	}
+}
+
+TEST_CASE( "paged_slot_map emplace throwing, strong exception guarantee held", "[slot_map]" )
+{
+	mclo::paged_slot_map<throwing_tester> map;
+	const auto handle = map.emplace( 0 );
+
+	CHECK_THROWS_AS( map.emplace( 5 ), std::runtime_error );
+
+	CHECK( map.size() == 1 );
+	CHECK( map.is_valid( handle ) );
+	CHECK( std::distance( map.begin(), map.end() ) == 1 );
+}
+
+TEST_CASE( "paged_slot_map insert more than max size, throws length error", "[slot_map]" )
+{
+	mclo::paged_slot_map<int, 8, 4, 4> map;
+	while ( map.size() < map.max_size() )
+	{
+		( void )map.insert( 0 );
+	}
+
+	CHECK_THROWS_AS( map.insert( 0 ), std::length_error );
+	CHECK_THROWS_AS( map.reserve_slots( map.max_size() + 1 ), std::length_error );
+	std::array<int, 1> values{};
+	std::array<mclo::paged_slot_map<int, 8, 4, 4>::handle_type, 1> handles;
+	CHECK_THROWS_AS( map.insert_n( values.begin(), handles ), std::length_error );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map copy, handles valid in both", "[slot_map]", test_types )
+{
+	TestType map;
+	const auto erased = map.insert( "erased" );
+	const auto handle = map.insert( "kept" );
+	map.erase( erased );
+
+	const TestType copy = map;
+	TestType assigned;
+	( void )assigned.insert( "overwritten" );
+	assigned = copy;
+
+	for ( const TestType* const target : std::array<const TestType*, 3>{ &map, &copy, &assigned } )
+	{
+		CHECK( target->size() == 1 );
+		CHECK_FALSE( target->is_valid( erased ) );
+		REQUIRE( target->lookup( handle ) );
+		CHECK( *target->lookup( handle ) == "kept" );
+	}
+	CHECK( copy.lookup( handle ) != map.lookup( handle ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map move, pointers carried over", "[slot_map]", test_types )
+{
+	TestType map;
+	const auto handle = map.insert( "moved" );
+	const std::string* const ptr = map.lookup( handle );
+
+	TestType moved = std::move( map );
+
+	check_empty( map );
+	CHECK( map.slot_count() == 0 );
+	CHECK( moved.lookup( handle ) == ptr );
+
+	map = std::move( moved );
+	CHECK( map.lookup( handle ) == ptr );
+}
+
+TEMPLATE_LIST_TEST_CASE( "paged_slot_map fuzz testing, matches reference map", "[slot_map]", test_types )
+{
+	using handle_type = typename TestType::handle_type;
+	TestType map;
+	std::unordered_map<handle_type, std::string> reference;
+	std::mt19937_64 rng{ 0 };
+	std::uniform_int_distribution<std::size_t> dist{ 0u, 99 };
+	for ( std::size_t index = 0; index < 5000; ++index )
+	{
+		const std::size_t random = dist( rng );
+		if ( random < 40 && !reference.empty() )
+		{
+			const auto it = std::next( reference.begin(), random % reference.size() );
+			map.erase( it->first );
+			reference.erase( it );
+		}
+		else
+		{
+			std::string value = std::to_string( index );
+			reference.emplace( map.insert( value ), std::move( value ) );
+		}
+	}
+
+	CHECK( map.size() == reference.size() );
+	for ( const auto& [ handle, value ] : reference )
+	{
+		REQUIRE( map.lookup( handle ) );
+		CHECK( *map.lookup( handle ) == value );
+	}
+	CHECK( static_cast<std::size_t>( std::distance( map.begin(), map.end() ) ) == reference.size() );
+}
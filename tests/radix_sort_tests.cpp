@@ -1,7 +1,11 @@
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
 
+#include "reverse_inline_executor.hpp"
+
+#include "mclo/algorithm/parallel_radix_sort.hpp"
 #include "mclo/algorithm/radix_sort.hpp"
 #include "mclo/container/span.hpp"
 #include "mclo/meta/type_list.hpp"
@@ -11,6 +15,10 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -120,7 +128,11 @@ namespace
 		radix_sort_test_case<std::uint32_t, std::identity, 255>,
 		radix_sort_test_case<std::uint32_t, std::identity, 256>,
 		radix_sort_test_case<std::uint32_t, std::identity, 65535>,
-		radix_sort_test_case<std::uint32_t, std::identity, 65536>
+		radix_sort_test_case<std::uint32_t, std::identity, 65536>,
+		// 11-bit digits for 64-bit keys in large inputs
+		radix_sort_test_case<std::uint64_t, std::identity, 40000>,
+		radix_sort_test_case<keyed_value<std::int64_t>, extract_key, 70000>,
+		radix_sort_test_case<keyed_value<double>, extract_key, 40000>
 	>;
 	// clang-format on
 }
@@ -166,3 +178,343 @@ TEMPLATE_LIST_TEST_CASE( "radix_sort random input, radix_sort, same result as st
 	const auto& actual = result == mclo::radix_sort_result::in_output ? output : source;
 	CHECK( actual == expected );
 }
+
+TEMPLATE_TEST_CASE( "radix_sort keys differing in one byte, skips other passes, sorted",
+					"[algorithm][radix_sort]",
+					std::uint32_t,
+					std::int64_t )
+{
+	constexpr std::size_t data_size = 1000;
+	for ( const std::size_t shift : { std::size_t{ 0 }, std::size_t{ 8 }, sizeof( TestType ) * 8 - 8 } )
+	{
+		std::vector<keyed_value<TestType>> source( data_size );
+		for ( std::size_t i = 0; i < data_size; ++i )
+		{
+			source[ i ] = { static_cast<TestType>( static_cast<TestType>( ( i * 37 ) % 256 ) << shift ),
+							static_cast<std::uint32_t>( i ) };
+		}
+		std::vector<keyed_value<TestType>> expected = source;
+		std::stable_sort( expected.begin(), expected.end(), []( const auto& lhs, const auto& rhs ) {
+			return lhs.key < rhs.key;
+		} );
+
+		std::vector<keyed_value<TestType>> output( data_size );
+		const auto result = mclo::radix_sort( source.begin(), source.end(), output.begin(), extract_key{} );
+
+		// Only the one pass with differing digits runs
+		CHECK( result == mclo::radix_sort_result::in_output );
+		CHECK( output == expected );
+	}
+}
+
+TEST_CASE( "radix_sort equal keys, skips every pass, left in source", "[algorithm][radix_sort]" )
+{
+	std::vector<keyed_value<std::uint64_t>> source( 100 );
+	for ( std::size_t i = 0; i < source.size(); ++i )
+	{
+		source[ i ] = { 42, static_cast<std::uint32_t>( i ) };
+	}
+	const std::vector<keyed_value<std::uint64_t>> expected = source;
+
+	std::vector<keyed_value<std::uint64_t>> output( source.size() );
+	const auto result = mclo::radix_sort( source.begin(), source.end(), output.begin(), extract_key{} );
+
+	CHECK( result == mclo::radix_sort_result::in_source );
+	CHECK( source == expected );
+}
+
+TEMPLATE_LIST_TEST_CASE( "radix_sort_by_cached_key random input, same result as std::stable_sort",
+						 "[algorithm][radix_sort]",
+						 non_bool_test_cases )
+{
+	using value_type = typename TestType::value_type;
+	using key_extractor = typename TestType::key_extractor;
+	constexpr std::size_t data_size = std::min<std::size_t>( TestType::data_size, 100000 );
+	std::vector<value_type> source( data_size );
+	fill_sequence( source );
+	std::vector<value_type> expected = source;
+
+	std::size_t num_extractions = 0;
+	const auto counting_extractor = [ & ]( const value_type& value ) {
+		++num_extractions;
+		return std::invoke( key_extractor{}, value );
+	};
+	std::vector<value_type> output( data_size );
+	const auto result =
+		mclo::radix_sort_by_cached_key( source.begin(), source.end(), output.begin(), counting_extractor );
+
+	std::stable_sort( expected.begin(), expected.end(), []( const value_type& lhs, const value_type& rhs ) {
+		return std::invoke( key_extractor{}, lhs ) < std::invoke( key_extractor{}, rhs );
+	} );
+	CHECK( result == mclo::radix_sort_result::in_output );
+	CHECK( output == expected );
+	if constexpr ( sizeof( typename TestType::key_type ) > 1 )
+	{
+		CHECK( num_extractions == data_size );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "radix_sort_in_place random input, sorted permutation of input",
+						 "[algorithm][radix_sort]",
+						 non_bool_test_cases )
+{
+	using value_type = typename TestType::value_type;
+	using key_extractor = typename TestType::key_extractor;
+	constexpr std::size_t data_size = TestType::data_size;
+	std::vector<value_type> values( data_size );
+	fill_sequence( values );
+	std::vector<value_type> expected = values;
+
+	mclo::radix_sort_in_place( values.begin(), values.end(), key_extractor{} );
+
+	// Not stable, so compare keys in order and the values as a whole regardless of order
+	CHECK( std::is_sorted( values.begin(), values.end(), []( const value_type& lhs, const value_type& rhs ) {
+		return std::invoke( key_extractor{}, lhs ) < std::invoke( key_extractor{}, rhs );
+	} ) );
+	std::sort( expected.begin(), expected.end() );
+	std::sort( values.begin(), values.end() );
+	CHECK( values == expected );
+}
+
+TEST_CASE( "radix_sort_in_place keys sharing high bytes and duplicates, sorted", "[algorithm][radix_sort]" )
+{
+	std::vector<std::int64_t> values;
+	for ( std::int64_t i = 0; i < 10000; ++i )
+	{
+		values.push_back( ( i * 7919 ) % 3000 - 1500 );
+	}
+	std::vector<std::int64_t> expected = values;
+	std::sort( expected.begin(), expected.end() );
+
+	mclo::radix_sort_in_place( values.begin(), values.end() );
+
+	CHECK( values == expected );
+}
+
+namespace
+{
+	struct record
+	{
+		std::uint32_t tenant_id = 0;
+		std::int64_t timestamp = 0;
+		std::string name;
+		std::uint32_t payload = 0;
+
+		bool operator==( const record& ) const = default;
+	};
+
+	// Names share prefixes, prefix each other and include empty strings and bytes above 127
+	[[nodiscard]] std::vector<record> make_records( const std::size_t size )
+	{
+		std::vector<record> result( size );
+		for ( std::size_t i = 0; i < size; ++i )
+		{
+			const auto mixed = static_cast<std::uint64_t>( i * 0x9E3779B97F4A7C15ull + 0xBF58476D1CE4E5B9ull );
+			record& value = result[ i ];
+			value.tenant_id = static_cast<std::uint32_t>( mixed % 7 );
+			value.timestamp = static_cast<std::int64_t>( mixed >> 20 ) % 1000 - 500;
+			value.name = std::string( ( mixed >> 8 ) % 3, 'a' ) + std::string( ( mixed >> 12 ) % 5, 'b' );
+			value.name += static_cast<char>( 'x' + ( mixed >> 16 ) % 3 );
+			value.name.resize( ( mixed >> 24 ) % 12 );
+			if ( ( mixed >> 30 ) % 5 == 0 )
+			{
+				value.name += static_cast<char>( 0xC0 + ( mixed >> 32 ) % 16 );
+			}
+			value.payload = static_cast<std::uint32_t>( i );
+		}
+		return result;
+	}
+
+	constexpr auto name_of = []( const record& value ) -> const std::string& { return value.name; };
+	constexpr auto name_view_of = []( const record& value ) { return std::string_view( value.name ); };
+	constexpr auto tenant_of = []( const record& value ) { return value.tenant_id; };
+	constexpr auto timestamp_of = []( const record& value ) { return value.timestamp; };
+
+	template <typename Less>
+	[[nodiscard]] std::vector<record> stable_sorted( std::vector<record> values, Less less )
+	{
+		std::stable_sort( values.begin(), values.end(), less );
+		return values;
+	}
+}
+
+TEST_CASE( "radix_sort string keys, same result as std::stable_sort", "[algorithm][radix_sort]" )
+{
+	const std::size_t data_size = GENERATE( 0, 1, 20, 5000 );
+	std::vector<record> source = make_records( data_size );
+	const std::vector<record> expected = stable_sorted( source, []( const record& lhs, const record& rhs ) {
+		return lhs.name < rhs.name;
+	} );
+
+	std::vector<record> output( data_size );
+	SECTION( "reference to string" )
+	{
+		CHECK( mclo::radix_sort( source.begin(), source.end(), output.begin(), name_of ) ==
+			   mclo::radix_sort_result::in_source );
+	}
+	SECTION( "string_view" )
+	{
+		CHECK( mclo::radix_sort( source.begin(), source.end(), output.begin(), name_view_of ) ==
+			   mclo::radix_sort_result::in_source );
+	}
+	CHECK( source == expected );
+}
+
+TEST_CASE( "radix_sort strings with a long shared prefix, sorted", "[algorithm][radix_sort]" )
+{
+	const std::string prefix( 10000, 'p' );
+	std::vector<std::string> source;
+	for ( std::size_t i = 0; i < 100; ++i )
+	{
+		source.push_back( prefix + std::to_string( ( i * 37 ) % 100 ) );
+	}
+	std::vector<std::string> expected = source;
+	std::sort( expected.begin(), expected.end() );
+
+	std::vector<std::string> output( source.size() );
+	CHECK( mclo::radix_sort( source.begin(), source.end(), output.begin() ) == mclo::radix_sort_result::in_source );
+	CHECK( source == expected );
+}
+
+TEST_CASE( "radix_sort tuple of keys, sorted lexicographically and stable", "[algorithm][radix_sort]" )
+{
+	constexpr std::size_t data_size = 5000;
+	std::vector<record> source = make_records( data_size );
+
+	SECTION( "integers" )
+	{
+		const std::vector<record> expected = stable_sorted( source, []( const record& lhs, const record& rhs ) {
+			return std::tie( lhs.tenant_id, lhs.timestamp ) < std::tie( rhs.tenant_id, rhs.timestamp );
+		} );
+		std::vector<record> output( data_size );
+		const auto result =
+			mclo::radix_sort( source.begin(), source.end(), output.begin(), std::tuple( tenant_of, timestamp_of ) );
+		CHECK( ( result == mclo::radix_sort_result::in_output ? output : source ) == expected );
+	}
+	SECTION( "string then integer" )
+	{
+		const std::vector<record> expected = stable_sorted( source, []( const record& lhs, const record& rhs ) {
+			return std::tie( lhs.name, lhs.timestamp ) < std::tie( rhs.name, rhs.timestamp );
+		} );
+		std::vector<record> output( data_size );
+		const auto result =
+			mclo::radix_sort( source.begin(), source.end(), output.begin(), std::tuple( name_of, timestamp_of ) );
+		CHECK( ( result == mclo::radix_sort_result::in_output ? output : source ) == expected );
+	}
+}
+
+TEST_CASE( "radix_argsort, stable sorting permutation and elements untouched", "[algorithm][radix_sort]" )
+{
+	constexpr std::size_t data_size = 5000;
+	const std::vector<record> source = make_records( data_size );
+	std::vector<std::uint32_t> indices( data_size );
+
+	const auto check_permutation = [ & ]( const auto less ) {
+		std::vector<std::uint32_t> expected( data_size );
+		std::iota( expected.begin(), expected.end(), 0u );
+		std::stable_sort( expected.begin(), expected.end(), [ & ]( const std::uint32_t lhs, const std::uint32_t rhs ) {
+			return less( source[ lhs ], source[ rhs ] );
+		} );
+		CHECK( indices == expected );
+	};
+
+	SECTION( "integer key" )
+	{
+		mclo::radix_argsort( source.begin(), source.end(), indices.begin(), timestamp_of );
+		check_permutation( []( const record& lhs, const record& rhs ) { return lhs.timestamp < rhs.timestamp; } );
+	}
+	SECTION( "1-byte key" )
+	{
+		const auto low_byte = []( const record& value ) { return static_cast<std::uint8_t>( value.timestamp ); };
+		mclo::radix_argsort( source.begin(), source.end(), indices.begin(), low_byte );
+		check_permutation( [ & ]( const record& lhs, const record& rhs ) {
+			return low_byte( lhs ) < low_byte( rhs );
+		} );
+	}
+	SECTION( "string key" )
+	{
+		mclo::radix_argsort( source.begin(), source.end(), indices.begin(), name_of );
+		check_permutation( []( const record& lhs, const record& rhs ) { return lhs.name < rhs.name; } );
+	}
+	SECTION( "tuple of keys" )
+	{
+		mclo::radix_argsort( source.begin(), source.end(), indices.begin(), std::tuple( tenant_of, name_view_of ) );
+		check_permutation( []( const record& lhs, const record& rhs ) {
+			return std::tie( lhs.tenant_id, lhs.name ) < std::tie( rhs.tenant_id, rhs.name );
+		} );
+	}
+	CHECK( source == make_records( data_size ) );
+}
+
+TEST_CASE( "radix_sort_by_cached_key string keys, same result as std::stable_sort", "[algorithm][radix_sort]" )
+{
+	std::vector<record> source = make_records( 5000 );
+	const std::vector<record> expected = stable_sorted( source, []( const record& lhs, const record& rhs ) {
+		return lhs.name < rhs.name;
+	} );
+
+	std::vector<record> output( source.size() );
+	CHECK( mclo::radix_sort_by_cached_key( source.begin(), source.end(), output.begin(), name_of ) ==
+		   mclo::radix_sort_result::in_output );
+	CHECK( output == expected );
+}
+
+namespace
+{
+	// clang-format off
+	using parallel_test_cases = mclo::meta::type_list<
+		radix_sort_test_case<keyed_value<bool>, extract_key, 1 << 18>,
+		radix_sort_test_case<keyed_value<std::uint8_t>, extract_key, 1 << 18>,
+		radix_sort_test_case<keyed_value<std::int16_t>, extract_key, 1 << 18>,
+		radix_sort_test_case<keyed_value<std::uint32_t>, extract_key, 1 << 18>,
+		radix_sort_test_case<keyed_value<std::int64_t>, extract_key, 1 << 18>,
+		radix_sort_test_case<keyed_value<float>, extract_key, 1 << 18>,
+		radix_sort_test_case<keyed_value<double>, extract_key, ( 1 << 18 ) + 3>,
+		radix_sort_test_case<std::uint64_t, std::identity, ( 1 << 18 ) + 3>,
+		// Too small to split, falls back to the serial sort
+		radix_sort_test_case<keyed_value<std::uint32_t>, extract_key, 1000>
+	>;
+	// clang-format on
+
+	template <typename TestType, typename Executor>
+	void check_parallel_radix_sort( const Executor& executor )
+	{
+		using value_type = typename TestType::value_type;
+		using key_extractor = typename TestType::key_extractor;
+		constexpr std::size_t data_size = TestType::data_size;
+		std::vector<value_type> source( data_size );
+		fill_sequence( source );
+		std::vector<value_type> expected = source;
+
+		std::vector<value_type> output( data_size );
+		const auto result =
+			mclo::parallel_radix_sort( source.begin(), source.end(), output.begin(), key_extractor{}, executor );
+
+		std::stable_sort( expected.begin(), expected.end(), []( const value_type& lhs, const value_type& rhs ) {
+			return std::invoke( key_extractor{}, lhs ) < std::invoke( key_extractor{}, rhs );
+		} );
+		const auto& actual = result == mclo::radix_sort_result::in_output ? output : source;
+		CHECK( actual == expected );
+	}
+}
+
+TEST_CASE( "thread_executor bulk_execute no tasks, invokes nothing", "[algorithm][radix_sort]" )
+{
+	std::size_t num_calls = 0;
+	mclo::thread_executor{ 4 }.bulk_execute( 0, [ &num_calls ]( std::size_t ) { ++num_calls; } );
+	CHECK( num_calls == 0 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "parallel_radix_sort random input on threads, same result as std::stable_sort",
+						 "[algorithm][radix_sort]",
+						 parallel_test_cases )
+{
+	check_parallel_radix_sort<TestType>( mclo::thread_executor{ 4 } );
+}
+
+TEMPLATE_LIST_TEST_CASE( "parallel_radix_sort random input on custom executor, same result as std::stable_sort",
+						 "[algorithm][radix_sort]",
+						 parallel_test_cases )
+{
+	check_parallel_radix_sort<TestType>( reverse_inline_executor{ 3 } );
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+// A bulk executor running tasks inline in reverse order, checking algorithms do not depend on tasks running
+// concurrently or in order
+struct reverse_inline_executor
+{
+	std::size_t num_tasks = 0;
+
+	[[nodiscard]] std::size_t concurrency() const noexcept
+	{
+		return num_tasks;
+	}
+
+	template <typename Func>
+	void bulk_execute( const std::size_t count, Func&& func ) const
+	{
+		for ( std::size_t task_index = count; task_index-- > 0; )
+		{
+			func( task_index );
+		}
+	}
+};
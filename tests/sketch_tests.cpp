@@ -0,0 +1,319 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "mclo/container/count_min_sketch.hpp"
+#include "mclo/container/hyperloglog.hpp"
+#include "mclo/container/space_saving_sketch.hpp"
+#include "mclo/hash/murmur_hash_3.hpp"
+#include "mclo/hash/rapidhash.hpp"
+#include "mclo/hash/xxhash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	using hasher_types = std::tuple<mclo::rapidhash, mclo::murmur_hash_3, mclo::xxhash_64>;
+
+	std::vector<std::uint64_t> make_keys( const std::size_t count, const std::uint64_t seed )
+	{
+		std::mt19937_64 rng( seed );
+		std::vector<std::uint64_t> result( count );
+		std::generate( result.begin(), result.end(), rng );
+		return result;
+	}
+
+	// Skewed stream where key i occurs roughly in proportion to 1 / (i + 1)
+	std::vector<std::uint32_t> make_zipf_stream( const std::size_t length, const std::uint32_t num_keys )
+	{
+		std::vector<double> weights( num_keys );
+		for ( std::uint32_t key = 0; key < num_keys; ++key )
+		{
+			weights[ key ] = 1.0 / ( key + 1 );
+		}
+		std::discrete_distribution<std::uint32_t> distribution( weights.begin(), weights.end() );
+		std::mt19937 rng( 1 );
+		std::vector<std::uint32_t> result( length );
+		std::generate( result.begin(), result.end(), [ & ] { return distribution( rng ); } );
+		return result;
+	}
+
+	std::unordered_map<std::uint32_t, std::uint64_t> count_keys( const std::vector<std::uint32_t>& stream )
+	{
+		std::unordered_map<std::uint32_t, std::uint64_t> result;
+		for ( const std::uint32_t key : stream )
+		{
+			++result[ key ];
+		}
+		return result;
+	}
+
+	bool within( const double estimate, const double actual, const double relative_error )
+	{
+		return std::abs( estimate - actual ) <= actual * relative_error;
+	}
+}
+
+TEST_CASE( "hyperloglog empty", "[hyperloglog]" )
+{
+	const mclo::hyperloglog<std::uint64_t> sketch;
+	CHECK( sketch.precision() == mclo::hyperloglog<std::uint64_t>::default_precision );
+	CHECK( sketch.is_sparse() );
+	CHECK( sketch.estimate() == 0 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "hyperloglog sparse is nearly exact", "[hyperloglog]", hasher_types )
+{
+	mclo::hyperloglog<std::uint64_t, TestType> sketch;
+	const auto keys = make_keys( 1000, 1 );
+	for ( const std::uint64_t key : keys )
+	{
+		sketch.insert( key );
+		sketch.insert( key );
+	}
+	CHECK( sketch.is_sparse() );
+	CHECK( within( sketch.estimate(), 1000, 0.005 ) );
+}
+
+TEMPLATE_LIST_TEST_CASE( "hyperloglog dense estimate is within the expected error", "[hyperloglog]", hasher_types )
+{
+	// Several standard errors of slack so the test is not flaky, across the range where raw HyperLogLog is biased
+	for ( const std::size_t count : { 5000, 30000, 100000, 1000000 } )
+	{
+		mclo::hyperloglog<std::uint64_t, TestType> sketch( 12 );
+		sketch.insert_many( make_keys( count, count ) );
+		CHECK_FALSE( sketch.is_sparse() );
+		CHECK( within( sketch.estimate(),
+					   static_cast<double>( count ),
+					   4 * mclo::hyperloglog<std::uint64_t>::relative_error( 12 ) ) );
+	}
+}
+
+TEST_CASE( "hyperloglog insert_many matches insert", "[hyperloglog]" )
+{
+	const auto keys = make_keys( 20000, 2 );
+	mclo::hyperloglog<std::uint64_t> single( 10 );
+	mclo::hyperloglog<std::uint64_t> bulk( 10 );
+	mclo::hyperloglog<std::uint64_t> list( 10 );
+	for ( const std::uint64_t key : keys )
+	{
+		single.insert( key );
+	}
+	bulk.insert_many( keys );
+	list.insert_many( std::list<std::uint64_t>( keys.begin(), keys.end() ) );
+	CHECK( bulk.estimate() == single.estimate() );
+	CHECK( list.estimate() == single.estimate() );
+}
+
+TEST_CASE( "hyperloglog merge matches inserting everything", "[hyperloglog]" )
+{
+	// Every combination of sparse and dense, merge is lossless so the estimates are identical
+	const auto keys = make_keys( 40000, 3 );
+	for ( const std::size_t lhs_count : { 100, 40000 } )
+	{
+		for ( const std::size_t rhs_count : { 100, 40000 } )
+		{
+			mclo::hyperloglog<std::uint64_t> lhs( 12 );
+			mclo::hyperloglog<std::uint64_t> rhs( 12 );
+			mclo::hyperloglog<std::uint64_t> both( 12 );
+			for ( std::size_t index = 0; index < lhs_count; ++index )
+			{
+				lhs.insert( keys[ index ] );
+				both.insert( keys[ index ] );
+			}
+			for ( std::size_t index = keys.size() - rhs_count; index < keys.size(); ++index )
+			{
+				rhs.insert( keys[ index ] );
+				both.insert( keys[ index ] );
+			}
+			lhs.merge( rhs );
+			CHECK( lhs.is_sparse() == both.is_sparse() );
+			CHECK( lhs.estimate() == both.estimate() );
+		}
+	}
+}
+
+TEST_CASE( "hyperloglog merge with itself", "[hyperloglog]" )
+{
+	mclo::hyperloglog<std::uint64_t> sketch( 8 );
+	sketch.insert_many( make_keys( 10, 4 ) );
+	const double estimate = sketch.estimate();
+	sketch.merge( sketch );
+	CHECK( sketch.estimate() == estimate );
+}
+
+TEST_CASE( "hyperloglog clear", "[hyperloglog]" )
+{
+	mclo::hyperloglog<std::uint64_t> sketch( 8 );
+	sketch.insert_many( make_keys( 10000, 5 ) );
+	CHECK_FALSE( sketch.is_sparse() );
+	sketch.clear();
+	CHECK( sketch.is_sparse() );
+	CHECK( sketch.estimate() == 0 );
+}
+
+TEMPLATE_LIST_TEST_CASE( "count_min_sketch never underestimates", "[count_min_sketch]", hasher_types )
+{
+	const auto stream = make_zipf_stream( 100000, 10000 );
+	const auto counts = count_keys( stream );
+	auto sketch = mclo::count_min_sketch<std::uint32_t, TestType>::with_error( 0.001, 0.01 );
+	sketch.insert_many( stream );
+	CHECK( sketch.total() == stream.size() );
+
+	// The bound holds for each key with probability 1 - delta, allow a few over it
+	const double bound = 0.001 * static_cast<double>( stream.size() );
+	std::size_t over_bound = 0;
+	for ( const auto& [ key, count ] : counts )
+	{
+		const std::uint32_t estimate = sketch.estimate( key );
+		REQUIRE( estimate >= count );
+		over_bound += static_cast<double>( estimate - count ) > bound;
+	}
+	CHECK( over_bound <= counts.size() / 50 );
+}
+
+TEST_CASE( "count_min_sketch with_error sizes", "[count_min_sketch]" )
+{
+	const auto sketch = mclo::count_min_sketch<int>::with_error( 0.01, 0.01 );
+	CHECK( sketch.width() == 272 );
+	CHECK( sketch.depth() == 5 );
+}
+
+TEST_CASE( "count_min_sketch insert with count", "[count_min_sketch]" )
+{
+	mclo::count_min_sketch<int> sketch( 1024, 4 );
+	sketch.insert( 1, 10 );
+	sketch.insert( 1 );
+	sketch.insert( 2, 3 );
+	CHECK( sketch.estimate( 1 ) == 11 );
+	CHECK( sketch.estimate( 2 ) == 3 );
+	CHECK( sketch.total() == 14 );
+	sketch.clear();
+	CHECK( sketch.estimate( 1 ) == 0 );
+	CHECK( sketch.total() == 0 );
+}
+
+TEST_CASE( "count_min_sketch merge matches inserting everything", "[count_min_sketch]" )
+{
+	const auto stream = make_zipf_stream( 20000, 5000 );
+	mclo::count_min_sketch<std::uint32_t> lhs( 512, 4 );
+	mclo::count_min_sketch<std::uint32_t> rhs( 512, 4 );
+	mclo::count_min_sketch<std::uint32_t> both( 512, 4 );
+	const std::size_t half = stream.size() / 2;
+	lhs.insert_many( mclo::span( stream ).first( half ) );
+	rhs.insert_many( mclo::span( stream ).subspan( half ) );
+	both.insert_many( stream );
+	lhs.merge( rhs );
+	CHECK( lhs.total() == both.total() );
+	for ( std::uint32_t key = 0; key < 5000; ++key )
+	{
+		REQUIRE( lhs.estimate( key ) == both.estimate( key ) );
+	}
+}
+
+TEST_CASE( "space_saving_sketch counts exactly below capacity", "[space_saving_sketch]" )
+{
+	mclo::space_saving_sketch<int> sketch( 8 );
+	for ( int key = 0; key < 5; ++key )
+	{
+		sketch.insert( key, static_cast<std::uint64_t>( key + 1 ) );
+	}
+	sketch.insert( 0, 10 );
+	CHECK( sketch.size() == 5 );
+	CHECK( sketch.total() == 25 );
+	CHECK( sketch.estimate( 0 ) == 11 );
+	CHECK( sketch.estimate( 42 ) == 0 );
+
+	using entry = mclo::space_saving_sketch<int>::entry;
+	CHECK( sketch.top( 3 ) == std::vector<entry>{ { 0, 11, 0 }, { 4, 5, 0 }, { 3, 4, 0 } } );
+	CHECK( sketch.entries().size() == 5 );
+}
+
+TEST_CASE( "space_saving_sketch guarantees", "[space_saving_sketch]" )
+{
+	const auto stream = make_zipf_stream( 100000, 10000 );
+	const auto counts = count_keys( stream );
+	mclo::space_saving_sketch<std::uint32_t> sketch( 100 );
+	for ( const std::uint32_t key : stream )
+	{
+		sketch.insert( key );
+	}
+	CHECK( sketch.size() == 100 );
+	CHECK( sketch.total() == stream.size() );
+
+	for ( const auto& counted : sketch.entries() )
+	{
+		const std::uint64_t actual = counts.at( counted.key );
+		REQUIRE( counted.count >= actual );
+		REQUIRE( counted.count - counted.error <= actual );
+	}
+
+	// Every key above total / capacity has a counter, and the heaviest keys come out on top
+	for ( const auto& [ key, count ] : counts )
+	{
+		if ( count > stream.size() / sketch.capacity() )
+		{
+			CHECK( sketch.estimate( key ) >= count );
+		}
+	}
+	const auto top = sketch.top( 3 );
+	CHECK( top[ 0 ].key == 0 );
+	CHECK( top[ 1 ].key == 1 );
+	CHECK( top[ 2 ].key == 2 );
+}
+
+TEST_CASE( "space_saving_sketch merge keeps guarantees", "[space_saving_sketch]" )
+{
+	const auto stream = make_zipf_stream( 100000, 10000 );
+	const auto counts = count_keys( stream );
+	mclo::space_saving_sketch<std::uint32_t> lhs( 100 );
+	mclo::space_saving_sketch<std::uint32_t> rhs( 100 );
+	for ( std::size_t index = 0; index < stream.size(); ++index )
+	{
+		( index % 3 == 0 ? lhs : rhs ).insert( stream[ index ] );
+	}
+	lhs.merge( rhs );
+	CHECK( lhs.size() == 100 );
+	CHECK( lhs.total() == stream.size() );
+
+	for ( const auto& counted : lhs.entries() )
+	{
+		const std::uint64_t actual = counts.at( counted.key );
+		REQUIRE( counted.count >= actual );
+		REQUIRE( counted.count - counted.error <= actual );
+	}
+	const auto top = lhs.top( 3 );
+	CHECK( top[ 0 ].key == 0 );
+	CHECK( top[ 1 ].key == 1 );
+	CHECK( top[ 2 ].key == 2 );
+}
+
+TEST_CASE( "space_saving_sketch copy is independent", "[space_saving_sketch]" )
+{
+	mclo::space_saving_sketch<int> sketch( 2 );
+	sketch.insert( 1, 5 );
+	sketch.insert( 2, 3 );
+	mclo::space_saving_sketch<int> copy = sketch;
+	sketch.insert( 3 );
+	copy.insert( 2, 10 );
+	CHECK( sketch.entries() == std::vector<mclo::space_saving_sketch<int>::entry>{ { 1, 5, 0 }, { 3, 4, 3 } } );
+	CHECK( copy.entries() == std::vector<mclo::space_saving_sketch<int>::entry>{ { 2, 13, 0 }, { 1, 5, 0 } } );
+	sketch = copy;
+	CHECK( sketch.entries() == copy.entries() );
+}
+
+TEST_CASE( "space_saving_sketch clear", "[space_saving_sketch]" )
+{
+	mclo::space_saving_sketch<int> sketch( 4 );
+	sketch.insert( 1 );
+	sketch.clear();
+	CHECK( sketch.size() == 0 );
+	CHECK( sketch.total() == 0 );
+	CHECK( sketch.estimate( 1 ) == 0 );
+}
@@ -11,7 +11,9 @@
 #include "mclo/meta/type_list.hpp"
 
 #include <random>
+#include <string>
 #include <unordered_set>
+#include <utility>
 
 using namespace Catch::Matchers;
 
@@ -607,3 +609,82 @@ TEMPLATE_LIST_TEST_CASE( "dense_slot_map handle type, hash different handles, di
 	CHECK( null_handle_hash != handle2_hash );
 	CHECK( handle1_hash != handle2_hash );
 }
+
+TEMPLATE_LIST_TEST_CASE( "dense_slot_map insert_n, every value inserted with its handle", "[slot_map]", test_types )
+{
+	using handle_type = typename TestType::handle_type;
+	const std::array<std::string, 4> values{ "a", "b", "c", "d" };
+	TestType map;
+	( void )map.insert( "existing" );
+
+	std::array<handle_type, 4> handles;
+	map.insert_n( values.begin(), handles );
+
+	CHECK( map.size() == 5 );
+	for ( std::size_t index = 0; index < values.size(); ++index )
+	{
+		REQUIRE( map.lookup( handles[ index ] ) );
+		CHECK( *map.lookup( handles[ index ] ) == values[ index ] );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "dense_slot_map erase_many, valid handles erased invalid skipped", "[slot_map]", test_types )
+{
+	using handle_type = typename TestType::handle_type;
+	TestType map;
+	const handle_type first = map.insert( "first" );
+	const handle_type second = map.insert( "second" );
+	const handle_type third = map.insert( "third" );
+	map.erase( second );
+
+	const std::array<handle_type, 4> to_erase{ first, second, third, first };
+	const auto num_erased = map.erase_many( to_erase );
+
+	CHECK( num_erased == 2 );
+	check_empty( map );
+}
+
+TEMPLATE_LIST_TEST_CASE( "dense_slot_map lookup_many, same results as lookup", "[slot_map]", test_types )
+{
+	using handle_type = typename TestType::handle_type;
+	TestType map;
+	const handle_type first = map.insert( "first" );
+	const handle_type second = map.insert( "second" );
+	const handle_type third = map.insert( "third" );
+	map.erase( first );
+
+	const std::array<handle_type, 4> handles{ first, second, third, handle_type{} };
+	std::array<typename TestType::pointer, 4> found;
+	const auto num_found = map.lookup_many( handles, found );
+
+	CHECK( num_found == 2 );
+	for ( std::size_t index = 0; index < handles.size(); ++index )
+	{
+		CHECK( found[ index ] == map.lookup( handles[ index ] ) );
+	}
+}
+
+TEMPLATE_LIST_TEST_CASE( "dense_slot_map lookup_many across groups, same results as lookup", "[slot_map]", test_types )
+{
+	using handle_type = typename TestType::handle_type;
+	TestType map;
+	std::vector<handle_type> handles;
+	for ( int index = 0; index < 50; ++index )
+	{
+		handles.push_back( map.insert( std::to_string( index ) ) );
+	}
+	for ( std::size_t index = 0; index < handles.size(); index += 3 )
+	{
+		map.erase( handles[ index ] );
+	}
+	handles.push_back( handle_type{} );
+
+	std::vector<typename TestType::const_pointer> found( handles.size() );
+	const auto num_found = std::as_const( map ).lookup_many( handles, found );
+
+	CHECK( num_found == map.size() );
+	for ( std::size_t index = 0; index < handles.size(); ++index )
+	{
+		CHECK( found[ index ] == map.lookup( handles[ index ] ) );
+	}
+}
@@ -2,10 +2,14 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
 
+#include "mclo/allocator/arena_allocator.hpp"
 #include "mclo/container/small_vector.hpp"
 #include "mclo/container/span.hpp"
+#include "mclo/memory/intrusive_ptr.hpp"
+#include "mclo/memory/intrusive_ref_counter.hpp"
 
 #include <array>
+#include <string>
 
 using namespace Catch::Matchers;
 
@@ -907,3 +911,191 @@ TEST_CASE( "SmallVector_StdEraseIfOverload_IsCorrect", "[small_vector]" )
 	CHECK( countRemoved == 3 );
 	CHECK_THAT( vec, RangeEquals( { 9, 16, 32 } ) );
 }
+
+namespace
+{
+	struct ref_counted : mclo::intrusive_ref_counter<ref_counted>
+	{
+		explicit ref_counted( const int value ) noexcept
+			: m_value( value )
+		{
+		}
+
+		int m_value;
+	};
+
+	using ref_ptr = mclo::intrusive_ptr<ref_counted>;
+
+	struct destroy_counter
+	{
+		explicit destroy_counter( int& destroyed ) noexcept
+			: m_destroyed( &destroyed )
+		{
+		}
+		destroy_counter( const destroy_counter& ) = default;
+		destroy_counter& operator=( const destroy_counter& ) = default;
+		~destroy_counter()
+		{
+			++*m_destroyed;
+		}
+
+		int* m_destroyed;
+	};
+}
+
+static_assert( mclo::is_trivially_relocatable_v<int> );
+static_assert( mclo::is_trivially_relocatable_v<ref_ptr> );
+static_assert( !mclo::is_trivially_relocatable_v<std::string> );
+static_assert( !mclo::is_trivially_relocatable_v<mclo::small_vector<int>> );
+
+static_assert( sizeof( mclo::small_vector<int> ) <= std::hardware_destructive_interference_size );
+using arena_small_vector = mclo::small_vector<int,
+											  mclo::small_vector_cache_line_capacity<int, mclo::arena_allocator<int>>,
+											  mclo::arena_allocator<int>>;
+static_assert( sizeof( arena_small_vector ) <= std::hardware_destructive_interference_size );
+
+TEST_CASE( "SmallVector_TriviallyRelocatable_GrowInsertErase_KeepsRefCounts", "[small_vector]" )
+{
+	std::vector<ref_ptr> owners;
+	for ( int value = 0; value < 20; ++value )
+	{
+		owners.emplace_back( new ref_counted( value ) );
+	}
+
+	{
+		mclo::small_vector<ref_ptr, 2> vec;
+		for ( const ref_ptr& ptr : owners )
+		{
+			vec.push_back( ptr );
+		}
+		vec.insert( vec.begin() + 1, owners[ 0 ] );
+		vec.insert( vec.begin(), 3, owners[ 1 ] );
+		vec.erase( vec.begin() + 2, vec.begin() + 5 );
+		vec.erase( vec.begin() );
+		vec.emplace( vec.begin() + 3, owners[ 2 ] );
+
+		std::vector<int> values;
+		for ( const ref_ptr& ptr : vec )
+		{
+			values.push_back( ptr->m_value );
+		}
+		const std::array expected{ 1, 1, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+		CHECK_THAT( values, RangeEquals( expected ) );
+		CHECK( owners[ 1 ]->use_count() == 3 );
+		CHECK( owners[ 2 ]->use_count() == 3 );
+		CHECK( owners[ 0 ]->use_count() == 1 );
+	}
+
+	for ( const ref_ptr& ptr : owners )
+	{
+		CHECK( ptr->use_count() == 1 );
+	}
+}
+
+TEST_CASE( "SmallVector_Erase_DestroysRemovedValue", "[small_vector]" )
+{
+	int destroyed = 0;
+	{
+		mclo::small_vector<destroy_counter, 4> vec( 3, destroy_counter( destroyed ) );
+		destroyed = 0;
+
+		vec.erase( vec.begin() );
+
+		CHECK( vec.size() == 2 );
+		CHECK( destroyed == 1 );
+	}
+	CHECK( destroyed == 3 );
+}
+
+TEST_CASE( "SmallVector_ExactGrowth_GrowsToSize", "[small_vector]" )
+{
+	mclo::small_vector<int, 2, std::allocator<int>, mclo::exact_growth> vec;
+	for ( int value = 0; value < 5; ++value )
+	{
+		vec.push_back( value );
+		CHECK( vec.capacity() == std::max<std::uint32_t>( 2, vec.size() ) );
+	}
+}
+
+TEST_CASE( "SmallVector_DoublingGrowth_DoublesCapacity", "[small_vector]" )
+{
+	mclo::small_vector<int, 2, std::allocator<int>, mclo::geometric_growth<2>> vec{ 1, 2 };
+
+	vec.push_back( 3 );
+	CHECK( vec.capacity() == 4 );
+	vec.push_back( 4 );
+	vec.push_back( 5 );
+	CHECK( vec.capacity() == 8 );
+	CHECK_THAT( vec, RangeEquals( { 1, 2, 3, 4, 5 } ) );
+}
+
+TEST_CASE( "GeometricGrowth_IncreasePastMax_ClampsToMax", "[small_vector]" )
+{
+	STATIC_CHECK( mclo::geometric_growth<4>::next_capacity( 8, 9, 20 ) == 20 );
+	STATIC_CHECK( mclo::geometric_growth<3, 2>::next_capacity( 8, 9, 20 ) == 12 );
+}
+
+TEST_CASE( "SmallVector_ArenaAllocator_GrowsInPlace", "[small_vector]" )
+{
+	mclo::memory_arena arena( 4096 );
+	mclo::small_vector<int, 2, mclo::arena_allocator<int>> vec( arena );
+
+	vec.push_back( 0 );
+	vec.push_back( 1 );
+	vec.push_back( 2 );
+	const int* const heap_data = vec.data();
+
+	for ( int value = 3; value < 100; ++value )
+	{
+		vec.push_back( value );
+	}
+	vec.insert( vec.begin(), -1 );
+
+	CHECK( vec.data() == heap_data );
+	CHECK( vec.size() == 101 );
+	CHECK( vec.front() == -1 );
+	CHECK( vec.back() == 99 );
+	CHECK( vec.get_allocator() == arena );
+}
+
+TEST_CASE( "SmallVector_ArenaAllocator_GrowInPlaceWithAliasingArgument_UsesOriginalValue", "[small_vector]" )
+{
+	mclo::memory_arena arena( 4096 );
+	mclo::small_vector<int, 2, mclo::arena_allocator<int>> vec( { 0, 1, 2, 3 }, arena );
+	vec.shrink_to_fit();
+	REQUIRE( vec.size() == vec.capacity() );
+	const int* const heap_data = vec.data();
+
+	vec.emplace( vec.begin(), vec.back() );
+	vec.insert( vec.begin() + 1, vec[ 3 ] );
+
+	CHECK( vec.data() == heap_data );
+	CHECK_THAT( vec, RangeEquals( { 3, 2, 0, 1, 2, 3 } ) );
+}
+
+TEST_CASE( "SmallVector_ArenaAllocator_OtherAllocationAfter_Reallocates", "[small_vector]" )
+{
+	mclo::memory_arena arena( 4096 );
+	mclo::small_vector<int, 2, mclo::arena_allocator<int>> vec( { 0, 1, 2 }, arena );
+	const int* const heap_data = vec.data();
+
+	[[maybe_unused]] void* const other = arena.allocate( 16 );
+	vec.resize( 50 );
+
+	CHECK( vec.data() != heap_data );
+	CHECK_THAT( mclo::span<const int>( vec.data(), 3 ), RangeEquals( { 0, 1, 2 } ) );
+}
+
+TEST_CASE( "SmallVector_MoveWithUnequalAllocators_MovesValues", "[small_vector]" )
+{
+	mclo::memory_arena first_arena( 4096 );
+	mclo::memory_arena second_arena( 4096 );
+	mclo::small_vector<int, 2, mclo::arena_allocator<int>> first( { 1, 2, 3, 4 }, first_arena );
+	mclo::small_vector<int, 2, mclo::arena_allocator<int>> second( second_arena );
+
+	second = std::move( first );
+
+	CHECK_THAT( second, RangeEquals( { 1, 2, 3, 4 } ) );
+	CHECK( second.get_allocator() == second_arena );
+	CHECK( first.empty() );
+}
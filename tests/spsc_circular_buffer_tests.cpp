@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+
+#include "mclo/container/spsc_circular_buffer.hpp"
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace Catch::Matchers;
+
+TEST_CASE( "spsc_circular_buffer construct, is empty with power of two capacity", "[spsc_circular_buffer]" )
+{
+	const mclo::spsc_circular_buffer<int> buffer( 5 );
+
+	CHECK( buffer.capacity() == 8 );
+	CHECK( buffer.size() == 0 );
+	CHECK( buffer.empty() );
+}
+
+TEST_CASE( "spsc_circular_buffer try push back when full, fails", "[spsc_circular_buffer]" )
+{
+	mclo::spsc_circular_buffer<int> buffer( 2 );
+
+	CHECK( buffer.try_push_back( 1 ) );
+	CHECK( buffer.try_push_back( 2 ) );
+	CHECK_FALSE( buffer.try_push_back( 3 ) );
+
+	CHECK( buffer.try_pop_front() == 1 );
+	CHECK( buffer.try_push_back( 3 ) );
+	CHECK( buffer.try_pop_front() == 2 );
+	CHECK( buffer.try_pop_front() == 3 );
+	CHECK( buffer.try_pop_front() == std::nullopt );
+}
+
+TEST_CASE( "spsc_circular_buffer push back n wrapping around, pops in order", "[spsc_circular_buffer]" )
+{
+	mclo::spsc_circular_buffer<std::string> buffer( 4 );
+	const std::array<std::string, 3> first{ "a", "b", "c" };
+	CHECK( buffer.push_back_n( first ) == 3 );
+	CHECK( buffer.try_pop_front() == "a" );
+	CHECK( buffer.try_pop_front() == "b" );
+
+	const std::array<std::string, 4> second{ "d", "e", "f", "g" };
+	CHECK( buffer.push_back_n( second ) == 3 );
+	CHECK( buffer.size() == 4 );
+
+	const auto [ readable_first, readable_second ] = buffer.readable_spans();
+	CHECK_THAT( readable_first, RangeEquals( std::array<std::string, 2>{ "c", "d" } ) );
+	CHECK_THAT( readable_second, RangeEquals( std::array<std::string, 2>{ "e", "f" } ) );
+
+	std::array<std::string, 5> popped;
+	CHECK( buffer.pop_front_n( popped ) == 4 );
+	CHECK_THAT( popped, RangeEquals( std::array<std::string, 5>{ "c", "d", "e", "f", "" } ) );
+	CHECK( buffer.empty() );
+}
+
+TEST_CASE( "spsc_circular_buffer write and read in place, round trips", "[spsc_circular_buffer]" )
+{
+	mclo::spsc_circular_buffer<char> buffer( 8 );
+	std::array<char, 6> filler{};
+	CHECK( buffer.push_back_n( filler ) == 6 );
+	CHECK( buffer.pop_front_n( filler ) == 6 );
+
+	auto [ first, second ] = buffer.writable_spans();
+	CHECK( first.size() == 2 );
+	CHECK( second.size() == 6 );
+	std::memcpy( first.data(), "ab", 2 );
+	std::memcpy( second.data(), "cd", 2 );
+	buffer.commit_write( 4 );
+
+	const auto [ readable_first, readable_second ] = buffer.readable_spans();
+	CHECK( std::string_view( readable_first.data(), readable_first.size() ) == "ab" );
+	CHECK( std::string_view( readable_second.data(), readable_second.size() ) == "cd" );
+	buffer.commit_read( 3 );
+	CHECK( buffer.try_pop_front() == 'd' );
+}
+
+TEST_CASE( "spsc_circular_buffer destroy with values, destroys them", "[spsc_circular_buffer]" )
+{
+	const auto value = std::make_shared<int>( 1 );
+	{
+		mclo::spsc_circular_buffer<std::shared_ptr<int>> buffer( 4 );
+		buffer.try_push_back( value );
+		buffer.try_push_back( value );
+		CHECK( value.use_count() == 3 );
+	}
+	CHECK( value.use_count() == 1 );
+}
+
+TEST_CASE( "spsc_circular_buffer producer and consumer threads, receives every value in order",
+		   "[spsc_circular_buffer]" )
+{
+	static constexpr int value_count = 100'000;
+	mclo::spsc_circular_buffer<int> buffer( 64 );
+
+	std::thread producer( [ &buffer ] {
+		std::array<int, 37> batch;
+		int next = 0;
+		while ( next < value_count )
+		{
+			if ( next % 2 )
+			{
+				next += buffer.try_push_back( next );
+				continue;
+			}
+			const int batch_size = std::min<int>( static_cast<int>( batch.size() ), value_count - next );
+			std::iota( batch.begin(), batch.begin() + batch_size, next );
+			next += static_cast<int>(
+				buffer.push_back_n( mclo::span<const int>( batch.data(), static_cast<std::size_t>( batch_size ) ) ) );
+		}
+	} );
+
+	std::vector<int> received;
+	received.reserve( value_count );
+	std::array<int, 23> batch;
+	while ( received.size() < value_count )
+	{
+		if ( received.size() % 3 == 0 )
+		{
+			if ( const std::optional<int> value = buffer.try_pop_front() )
+			{
+				received.push_back( *value );
+			}
+			continue;
+		}
+		const std::size_t count = buffer.pop_front_n( batch );
+		received.insert( received.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>( count ) );
+	}
+	producer.join();
+
+	std::vector<int> expected( value_count );
+	std::iota( expected.begin(), expected.end(), 0 );
+	CHECK( received == expected );
+	CHECK( buffer.empty() );
+}
@@ -0,0 +1,225 @@
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "reverse_inline_executor.hpp"
+
+#include "mclo/algorithm/parallel_top_k_scored.hpp"
+#include "mclo/algorithm/top_k_scored.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// Few distinct values so ties are common and the earlier elements must win them
+	template <typename T>
+	std::vector<T> make_values( const std::size_t size )
+	{
+		std::mt19937_64 rng( size );
+		std::vector<T> result( size );
+		for ( T& value : result )
+		{
+			value = static_cast<T>( rng() % 997 );
+		}
+		return result;
+	}
+
+	// Stable sort of the offsets best first, the first k are the expected result
+	template <typename T, typename Scorer, typename Compare = std::less<>>
+	std::vector<std::size_t> expected_top_k( const std::vector<T>& values,
+											 const std::size_t k,
+											 Scorer score,
+											 Compare compare = {} )
+	{
+		std::vector<std::size_t> offsets( values.size() );
+		std::iota( offsets.begin(), offsets.end(), std::size_t{ 0 } );
+		std::stable_sort( offsets.begin(), offsets.end(), [ & ]( const std::size_t lhs, const std::size_t rhs ) {
+			return compare( score( values[ rhs ] ), score( values[ lhs ] ) );
+		} );
+		offsets.resize( std::min( k, offsets.size() ) );
+		return offsets;
+	}
+
+	template <typename Container, typename It>
+	std::vector<std::size_t> to_offsets( const Container& container, const std::vector<It>& its )
+	{
+		std::vector<std::size_t> result;
+		for ( const It it : its )
+		{
+			result.push_back( static_cast<std::size_t>( std::distance( container.begin(), it ) ) );
+		}
+		return result;
+	}
+
+	template <typename T, typename Scorer, typename Compare = std::less<>>
+	std::vector<std::size_t> top_k_offsets( const std::vector<T>& values,
+											const std::size_t k,
+											Scorer score,
+											Compare compare = {} )
+	{
+		std::vector<typename std::vector<T>::const_iterator> result;
+		mclo::top_k_scored( values.begin(), values.end(), k, std::back_inserter( result ), score, compare );
+		return to_offsets( values, result );
+	}
+
+	// Encodes the three best values as digits followed by the offset of the best, which must be the first 9
+	constexpr int constant_top_k()
+	{
+		constexpr std::array<int, 6> values{ 4, 9, 2, 9, 7, 1 };
+		std::array<const int*, 3> result{};
+		mclo::top_k_scored( values.begin(), values.end(), result.size(), result.begin(), std::identity{} );
+		const auto best_offset = static_cast<int>( result[ 0 ] - values.data() );
+		return *result[ 0 ] * 1000 + *result[ 1 ] * 100 + *result[ 2 ] * 10 + best_offset;
+	}
+}
+
+TEST_CASE( "top_k_scored on empty writes nothing", "[top_k_scored]" )
+{
+	const std::vector<int> values;
+	std::vector<std::vector<int>::const_iterator> result;
+
+	mclo::top_k_scored( values.begin(), values.end(), 3, std::back_inserter( result ), std::identity{} );
+
+	CHECK( result.empty() );
+}
+
+TEST_CASE( "top_k_scored with k of zero writes nothing", "[top_k_scored]" )
+{
+	const std::vector<int> values{ 5, 3, 8, 1, 4 };
+	std::vector<std::vector<int>::const_iterator> result;
+
+	mclo::top_k_scored( values.begin(), values.end(), 0, std::back_inserter( result ), std::identity{} );
+
+	CHECK( result.empty() );
+}
+
+TEST_CASE( "top_k_scored finds highest scoring best first", "[top_k_scored]" )
+{
+	const std::vector<int> values{ 5, 3, 8, 1, 4 };
+
+	CHECK( top_k_offsets( values, 3, std::identity{} ) == std::vector<std::size_t>{ 2, 0, 4 } );
+}
+
+TEST_CASE( "top_k_scored with k past the size finds every element", "[top_k_scored]" )
+{
+	const std::vector<int> values{ 5, 3, 8, 1, 4 };
+
+	CHECK( top_k_offsets( values, 100, std::identity{} ) == std::vector<std::size_t>{ 2, 0, 4, 1, 3 } );
+}
+
+TEST_CASE( "top_k_scored prefers earlier elements on ties", "[top_k_scored]" )
+{
+	const std::vector<int> values{ 3, 1, 3, 2, 3, 3 };
+
+	CHECK( top_k_offsets( values, 2, std::identity{} ) == std::vector<std::size_t>{ 0, 2 } );
+	CHECK( top_k_offsets( values, 5, std::identity{} ) == std::vector<std::size_t>{ 0, 2, 4, 5, 3 } );
+}
+
+TEST_CASE( "top_k_scored with custom scorer and compare", "[top_k_scored]" )
+{
+	using pair_t = std::pair<int, int>;
+	const std::vector<pair_t> values{
+		{1, 5},
+		{2, 3},
+		{3, 8},
+		{4, 1},
+		{5, 4}
+	};
+	std::vector<std::vector<pair_t>::const_iterator> result;
+
+	// Compare with greater to find the lowest scores
+	mclo::top_k_scored(
+		values.begin(), values.end(), 2, std::back_inserter( result ), &pair_t::second, std::greater<>{} );
+
+	REQUIRE( result.size() == 2 );
+	CHECK( result[ 0 ]->first == 4 );
+	CHECK( result[ 1 ]->first == 2 );
+}
+
+TEST_CASE( "top_k_scored calls scorer once per element", "[top_k_scored]" )
+{
+	const std::vector<int> values = make_values<int>( 1000 );
+	std::size_t calls = 0;
+	const auto counted_score = [ & ]( const int value ) {
+		++calls;
+		return value;
+	};
+
+	const std::vector<std::size_t> result = top_k_offsets( values, 10, counted_score );
+
+	CHECK( result == expected_top_k( values, 10, std::identity{} ) );
+	CHECK( calls == values.size() );
+}
+
+TEST_CASE( "top_k_scored on forward iterators", "[top_k_scored]" )
+{
+	const std::vector<int> values = make_values<int>( 500 );
+	const std::list<int> list( values.begin(), values.end() );
+	std::vector<std::list<int>::const_iterator> result;
+
+	mclo::top_k_scored( list.begin(), list.end(), 20, std::back_inserter( result ), std::identity{} );
+
+	CHECK( to_offsets( list, result ) == expected_top_k( values, 20, std::identity{} ) );
+}
+
+TEST_CASE( "top_k_scored in a constant expression", "[top_k_scored]" )
+{
+	static_assert( constant_top_k() == 9971 );
+}
+
+TEMPLATE_TEST_CASE( "top_k_scored matches a stable sort",
+					"[top_k_scored]",
+					std::int32_t,
+					std::uint32_t,
+					std::int64_t,
+					std::uint64_t,
+					float,
+					double )
+{
+	const std::size_t size = GENERATE( 1, 7, 255, 256, 257, 10000 );
+	const std::size_t k = GENERATE( 1, 10, 100, 300 );
+	const std::vector<TestType> values = make_values<TestType>( size );
+
+	SECTION( "identity" )
+	{
+		CHECK( top_k_offsets( values, k, std::identity{} ) == expected_top_k( values, k, std::identity{} ) );
+	}
+	SECTION( "scorer" )
+	{
+		const auto score = []( const TestType value ) { return static_cast<TestType>( 1000 - value ); };
+		CHECK( top_k_offsets( values, k, score ) == expected_top_k( values, k, score ) );
+	}
+	SECTION( "greater" )
+	{
+		CHECK( top_k_offsets( values, k, std::identity{}, std::greater<>{} ) ==
+			   expected_top_k( values, k, std::identity{}, std::greater<>{} ) );
+	}
+}
+
+TEMPLATE_TEST_CASE( "parallel_top_k_scored matches serial", "[top_k_scored]", std::int32_t, double )
+{
+	const std::size_t size = GENERATE( std::size_t{ 1000 }, ( std::size_t{ 1 } << 17 ) + 3 );
+	const std::size_t k = GENERATE( 1, 100, 1000 );
+	const std::vector<TestType> values = make_values<TestType>( size );
+	const std::vector<std::size_t> expected = expected_top_k( values, k, std::identity{} );
+
+	const auto check_executor = [ & ]( const auto& executor ) {
+		std::vector<typename std::vector<TestType>::const_iterator> result;
+		mclo::parallel_top_k_scored(
+			values.begin(), values.end(), k, std::back_inserter( result ), std::identity{}, std::less<>{}, executor );
+		CHECK( to_offsets( values, result ) == expected );
+	};
+
+	check_executor( reverse_inline_executor{ 3 } );
+	check_executor( mclo::thread_executor{ 4 } );
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "mclo/container/type_id_map.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace
+{
+	template <int N>
+	struct test_type;
+
+	template <int... Ns>
+	void insert_types( mclo::type_id_map<int>& map, std::integer_sequence<int, Ns...> )
+	{
+		( map.try_emplace<test_type<Ns>>( Ns ), ... );
+	}
+}
+
+TEST_CASE( "default constructed type_id_map, is empty", "[type_id_map]" )
+{
+	const mclo::type_id_map<int> map;
+
+	CHECK( map.empty() );
+	CHECK( map.size() == 0 );
+	CHECK( map.find<test_type<0>>() == nullptr );
+	CHECK_FALSE( map.contains<test_type<0>>() );
+	CHECK( map.keys().empty() );
+}
+
+TEST_CASE( "type_id_map try_emplace, finds value by type", "[type_id_map]" )
+{
+	mclo::type_id_map<std::string> map;
+
+	const auto [ value, inserted ] = map.try_emplace<test_type<0>>( "zero" );
+	CHECK( inserted );
+	CHECK( value == "zero" );
+	map.try_emplace<test_type<1>>( "one" );
+
+	CHECK( map.size() == 2 );
+	CHECK( map.get<test_type<0>>() == "zero" );
+	CHECK( *map.find( mclo::meta::type_id<test_type<1>> ) == "one" );
+	CHECK( map.contains<test_type<0>, test_type<1>>() );
+	CHECK_FALSE( map.contains<test_type<0>, test_type<2>>() );
+}
+
+TEST_CASE( "type_id_map try_emplace present type, keeps existing value", "[type_id_map]" )
+{
+	mclo::type_id_map<std::string> map;
+	map.try_emplace<test_type<0>>( "first" );
+
+	const auto [ value, inserted ] = map.try_emplace<test_type<0>>( "second" );
+
+	CHECK_FALSE( inserted );
+	CHECK( value == "first" );
+	CHECK( map.size() == 1 );
+}
+
+TEST_CASE( "type_id_map insert_or_assign, assigns present type", "[type_id_map]" )
+{
+	mclo::type_id_map<int> map;
+
+	CHECK( map.insert_or_assign<test_type<0>>( 1 ) );
+	CHECK_FALSE( map.insert_or_assign<test_type<0>>( 2 ) );
+
+	CHECK( map.get<test_type<0>>() == 2 );
+}
+
+TEST_CASE( "type_id_map with many types, grows and finds all", "[type_id_map]" )
+{
+	mclo::type_id_map<int> map;
+
+	insert_types( map, std::make_integer_sequence<int, 100>() );
+
+	CHECK( map.size() == 100 );
+	CHECK( map.get<test_type<0>>() == 0 );
+	CHECK( map.get<test_type<42>>() == 42 );
+	CHECK( map.get<test_type<99>>() == 99 );
+	CHECK( map.keys().size() == map.values().size() );
+	for ( std::size_t index = 0; index < map.size(); ++index )
+	{
+		CHECK( *map.find( map.keys()[ index ] ) == map.values()[ index ] );
+	}
+}
+
+TEST_CASE( "type_id_map erase, keeps other values findable", "[type_id_map]" )
+{
+	mclo::type_id_map<int> map;
+	insert_types( map, std::make_integer_sequence<int, 40>() );
+
+	for ( int i = 0; i < 40; i += 3 )
+	{
+		CHECK( map.erase( map.keys()[ 0 ] ) );
+	}
+	CHECK_FALSE( map.erase<int>() );
+
+	CHECK( map.size() == 26 );
+	for ( std::size_t index = 0; index < map.size(); ++index )
+	{
+		CHECK( *map.find( map.keys()[ index ] ) == map.values()[ index ] );
+	}
+}
+
+TEST_CASE( "type_id_map erase by type, type no longer present", "[type_id_map]" )
+{
+	mclo::type_id_map<std::unique_ptr<int>> map;
+	map.try_emplace<test_type<0>>( std::make_unique<int>( 0 ) );
+	map.try_emplace<test_type<1>>( std::make_unique<int>( 1 ) );
+	map.try_emplace<test_type<2>>( std::make_unique<int>( 2 ) );
+
+	CHECK( map.erase<test_type<0>>() );
+
+	CHECK_FALSE( map.contains<test_type<0>>() );
+	CHECK( *map.get<test_type<1>>() == 1 );
+	CHECK( *map.get<test_type<2>>() == 2 );
+}
+
+TEST_CASE( "type_id_map clear, is empty and reusable", "[type_id_map]" )
+{
+	mclo::type_id_map<int> map;
+	insert_types( map, std::make_integer_sequence<int, 10>() );
+
+	map.clear();
+
+	CHECK( map.empty() );
+	CHECK_FALSE( map.contains<test_type<3>>() );
+	map.try_emplace<test_type<3>>( 3 );
+	CHECK( map.get<test_type<3>>() == 3 );
+}
+
+TEST_CASE( "type_id_map swap, maps are swapped", "[type_id_map]" )
+{
+	mclo::type_id_map<int> lhs;
+	lhs.try_emplace<test_type<0>>( 0 );
+	mclo::type_id_map<int> rhs;
+	insert_types( rhs, std::make_integer_sequence<int, 20>() );
+
+	swap( lhs, rhs );
+
+	CHECK( lhs.size() == 20 );
+	CHECK( lhs.get<test_type<19>>() == 19 );
+	CHECK( rhs.size() == 1 );
+	CHECK( rhs.get<test_type<0>>() == 0 );
+}
@@ -1,13 +1,25 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include "mclo/container/flat_type_id_set.hpp"
 #include "mclo/container/type_id_set.hpp"
 
+#include <utility>
+
 namespace
 {
 	struct test_type_1;
 	struct test_type_2;
 	struct test_type_3;
 
+	template <int N>
+	struct many_type;
+
+	template <int... Ns>
+	void insert_many( mclo::flat_type_id_set& type_set, std::integer_sequence<int, Ns...> )
+	{
+		( type_set.insert<many_type<Ns>>(), ... );
+	}
+
 	void check_empty( const mclo::type_id_set<>& type_set )
 	{
 		CHECK( type_set.empty() );
@@ -190,3 +202,76 @@ TEST_CASE( "type_id_set, move assign, new contains same types and original empty
 	check_empty( source );
 	check_contains_types<test_type_1, test_type_3>( type_set );
 }
+
+TEST_CASE( "flat_type_id_set, insert types, iterates in insertion order and contains all", "[type_id_set]" )
+{
+	mclo::flat_type_id_set type_set;
+
+	CHECK( type_set.insert<test_type_3>() );
+	CHECK( type_set.insert<test_type_1>() );
+	CHECK( type_set.insert<test_type_2>() );
+	CHECK_FALSE( type_set.insert<test_type_1>() );
+
+	CHECK( type_set.size() == 3 );
+	CHECK( *type_set.begin() == mclo::meta::type_id<test_type_3> );
+	CHECK( type_set.contains<test_type_1>() );
+	CHECK( type_set.contains<test_type_3, test_type_1, test_type_2>() );
+}
+
+TEST_CASE( "flat_type_id_set, contains multiple types with one missing, is false", "[type_id_set]" )
+{
+	mclo::flat_type_id_set type_set;
+	type_set.insert<test_type_1>();
+	type_set.insert<test_type_3>();
+
+	CHECK( type_set.contains<test_type_3, test_type_1>() );
+	CHECK_FALSE( type_set.contains<test_type_1, test_type_2>() );
+	CHECK_FALSE( type_set.contains<test_type_2, test_type_3>() );
+}
+
+TEST_CASE( "flat_type_id_set, erase, keeps remaining types", "[type_id_set]" )
+{
+	mclo::flat_type_id_set type_set;
+	type_set.insert<test_type_1>();
+	type_set.insert<test_type_2>();
+	type_set.insert<test_type_3>();
+
+	CHECK( type_set.erase<test_type_2>() );
+	CHECK_FALSE( type_set.erase<test_type_2>() );
+
+	CHECK( type_set.size() == 2 );
+	CHECK( type_set.contains<test_type_1, test_type_3>() );
+	CHECK_FALSE( type_set.contains<test_type_2>() );
+}
+
+TEST_CASE( "flat_type_id_set, equality, ignores insertion order", "[type_id_set]" )
+{
+	mclo::flat_type_id_set lhs;
+	lhs.insert<test_type_1>();
+	lhs.insert<test_type_2>();
+	mclo::flat_type_id_set rhs;
+	rhs.insert<test_type_2>();
+	rhs.insert<test_type_1>();
+
+	CHECK( lhs == rhs );
+	rhs.erase<test_type_1>();
+	CHECK( lhs != rhs );
+}
+
+TEST_CASE( "flat_type_id_set, many types erased, remaining types still present", "[type_id_set]" )
+{
+	mclo::flat_type_id_set type_set;
+	insert_many( type_set, std::make_integer_sequence<int, 100>() );
+
+	type_set.erase<many_type<0>>();
+	type_set.erase<many_type<50>>();
+	type_set.erase<many_type<99>>();
+
+	CHECK( type_set.size() == 97 );
+	CHECK_FALSE( type_set.contains<many_type<50>>() );
+	CHECK( type_set.contains<many_type<1>, many_type<49>, many_type<51>, many_type<98>>() );
+	for ( const mclo::meta::type_id_t id : type_set )
+	{
+		CHECK( id != mclo::meta::type_id<many_type<0>> );
+	}
+}
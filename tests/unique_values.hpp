@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+// Distinct pseudo random values, deterministic for a given seed
+inline std::vector<std::uint64_t> make_unique_values( const std::size_t count, const std::uint64_t seed )
+{
+	std::mt19937_64 rng( seed );
+	std::unordered_set<std::uint64_t> seen;
+	std::vector<std::uint64_t> result;
+	result.reserve( count );
+	while ( result.size() < count )
+	{
+		const std::uint64_t value = rng();
+		if ( seen.insert( value ).second )
+		{
+			result.push_back( value );
+		}
+	}
+	return result;
+}